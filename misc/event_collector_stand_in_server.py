@@ -0,0 +1,314 @@
+#!/usr/bin/env python3
+#==============================================================================
+#
+#  OvenMediaEngine
+#
+#  Event collector stand-in server for testing the event forwarder (EventForwarder)
+#
+#==============================================================================
+"""
+A local sink for the event logs forwarded by OME, so batching, compression and
+the reconnection of the event forwarder can be tested without a collector:
+
+- http://: HTTP/1.1 keep-alive POST of NDJSON, gzip bodies are decompressed
+- tcp://: '\\n' delimited lines (--tcp-port)
+- Every line is parsed as JSON, and the report shows events/s, the bytes on the
+  wire and after decompression, and how many requests each connection carried
+- Fault injection: error status codes, delayed responses, dropped connections,
+  and responses that cannot be reused (HTTP/1.0, Connection: close, chunked)
+
+    $ python3 misc/event_collector_stand_in_server.py --port 8080 --tcp-port 21514
+
+    <!-- Server.xml, Analytics -->
+    <Analytics>
+        <Forwarding>
+            <Enable>true</Enable>
+            <Collector>http://127.0.0.1:8080/events</Collector>
+            <BatchCount>1000</BatchCount>
+            <BatchInterval>1000</BatchInterval>
+            <Compression>gzip</Compression>
+        </Forwarding>
+    </Analytics>
+
+To test the resending from the checkpoint, run the server with --fail-rate 0.3
+or --close-rate 0.1, or stop it for a while; --output keeps the received
+events, so duplicated or missing events can be checked afterwards.
+"""
+
+import argparse
+import asyncio
+import gzip
+import json
+import random
+import time
+import zlib
+
+
+class Statistics:
+	connections = 0
+	total_connections = 0
+	requests = 0
+	events = 0
+	invalid_events = 0
+	wire_bytes = 0
+	decompressed_bytes = 0
+	failures = 0
+
+	last_report_time = time.monotonic()
+	last_report_events = 0
+
+
+class Sink:
+	def __init__(self, options):
+		self.options = options
+		self.output = open(options.output, "ab") if options.output else None
+
+	def consume(self, body):
+		count = 0
+
+		for line in body.split(b"\n"):
+			if not line.strip():
+				continue
+
+			try:
+				json.loads(line)
+				count += 1
+			except ValueError:
+				Statistics.invalid_events += 1
+				if self.options.verbose:
+					print("Invalid event: %r" % line[:200], flush=True)
+
+			if self.output:
+				self.output.write(line + b"\n")
+
+		Statistics.events += count
+		return count
+
+
+class HttpConnection:
+	def __init__(self, server, reader, writer):
+		self.server = server
+		self.options = server.options
+		self.reader = reader
+		self.writer = writer
+		self.peer = writer.get_extra_info("peername")
+		self.requests = 0
+
+	def log(self, message):
+		if self.options.verbose:
+			print("[%s:%d] %s" % (self.peer[0], self.peer[1], message), flush=True)
+
+	async def run(self):
+		Statistics.connections += 1
+		Statistics.total_connections += 1
+		self.log("Connected")
+
+		try:
+			while await self.handle_request():
+				pass
+		except (ConnectionError, asyncio.IncompleteReadError, ValueError) as error:
+			self.log("Error: %s" % error)
+		finally:
+			Statistics.connections -= 1
+			self.writer.close()
+			self.log("Disconnected after %d requests" % self.requests)
+
+	async def read_body(self, headers):
+		if headers.get("transfer-encoding", "").lower() == "chunked":
+			body = b""
+			while True:
+				size = int((await self.reader.readline()).split(b";")[0], 16)
+				if size == 0:
+					await self.reader.readline()
+					return body
+				body += await self.reader.readexactly(size)
+				await self.reader.readline()
+
+		return await self.reader.readexactly(int(headers.get("content-length", "0")))
+
+	async def respond(self, status, reason, headers=None, body=b"", version="HTTP/1.1"):
+		lines = ["%s %d %s" % (version, status, reason)]
+		for name, value in (headers or {}).items():
+			lines.append("%s: %s" % (name, value))
+
+		if self.options.response_delay_ms > 0:
+			await asyncio.sleep(self.options.response_delay_ms / 1000)
+
+		self.writer.write(("\r\n".join(lines) + "\r\n\r\n").encode() + body)
+		await self.writer.drain()
+
+	# Returns whether the connection can be reused
+	async def handle_request(self):
+		request_line = await self.reader.readline()
+		if not request_line:
+			return False
+
+		header_bytes = len(request_line)
+		method, path, version = request_line.decode().strip().split(" ", 2)
+		headers = {}
+
+		while True:
+			line = await self.reader.readline()
+			header_bytes += len(line)
+			if line in (b"\r\n", b"\n", b""):
+				break
+			name, _, value = line.decode().partition(":")
+			headers[name.strip().lower()] = value.strip()
+
+		body = await self.read_body(headers)
+
+		self.requests += 1
+		Statistics.requests += 1
+		Statistics.wire_bytes += header_bytes + len(body)
+
+		if random.random() < self.options.close_rate:
+			self.log("%s %s: closing without a response" % (method, path))
+			Statistics.failures += 1
+			return False
+
+		if (self.options.user_key is not None) and (headers.get("authorization") != "Bearer " + self.options.user_key):
+			await self.respond(401, "Unauthorized", {"Content-Length": "0"})
+			return True
+
+		if method != "POST":
+			await self.respond(405, "Method Not Allowed", {"Content-Length": "0", "Allow": "POST"})
+			return True
+
+		if random.random() < self.options.fail_rate:
+			self.log("%s %s: responding %d" % (method, path, self.options.fail_status))
+			Statistics.failures += 1
+			await self.respond(self.options.fail_status, "Injected Failure", {"Content-Length": "0"})
+			return True
+
+		if headers.get("content-encoding", "").lower() == "gzip":
+			try:
+				body = gzip.decompress(body)
+			except (OSError, EOFError, zlib.error) as error:
+				await self.respond(400, "Bad Request", {"Content-Length": "0"})
+				self.log("Could not decompress the body: %s" % error)
+				return True
+
+		Statistics.decompressed_bytes += len(body)
+		count = self.server.sink.consume(body)
+		self.log("%s %s: %d events, %d bytes (%s)" % (method, path, count, len(body), headers.get("content-encoding", "identity")))
+
+		keep_alive = (version == "HTTP/1.1") and (headers.get("connection", "").lower() != "close")
+
+		if self.options.response_mode == "http10":
+			await self.respond(200, "OK", {"Content-Length": "0"}, version="HTTP/1.0")
+			return False
+		if self.options.response_mode == "close":
+			await self.respond(200, "OK", {"Content-Length": "0", "Connection": "close"})
+			return False
+		if self.options.response_mode == "chunked":
+			# The end of the body is not known by the forwarder, so it must not reuse the connection
+			await self.respond(200, "OK", {"Transfer-Encoding": "chunked"}, b"2\r\nok\r\n0\r\n\r\n")
+			return keep_alive
+
+		await self.respond(200, "OK", {"Content-Type": "application/json", "Content-Length": "11"}, b'{"ok":true}')
+		return keep_alive
+
+
+class TcpConnection:
+	def __init__(self, server, reader, writer):
+		self.server = server
+		self.reader = reader
+		self.writer = writer
+
+	async def run(self):
+		Statistics.connections += 1
+		Statistics.total_connections += 1
+
+		try:
+			while True:
+				line = await self.reader.readline()
+				if not line:
+					break
+
+				Statistics.wire_bytes += len(line)
+				Statistics.decompressed_bytes += len(line)
+
+				if random.random() < self.server.options.close_rate:
+					Statistics.failures += 1
+					break
+
+				self.server.sink.consume(line)
+		except (ConnectionError, ValueError):
+			pass
+		finally:
+			Statistics.connections -= 1
+			self.writer.close()
+
+
+class CollectorServer:
+	def __init__(self, options):
+		self.options = options
+		self.sink = Sink(options)
+
+	async def on_http_connected(self, reader, writer):
+		await HttpConnection(self, reader, writer).run()
+
+	async def on_tcp_connected(self, reader, writer):
+		await TcpConnection(self, reader, writer).run()
+
+	async def report(self):
+		while True:
+			await asyncio.sleep(self.options.report_interval)
+
+			now = time.monotonic()
+			events_per_second = (Statistics.events - Statistics.last_report_events) / (now - Statistics.last_report_time)
+			Statistics.last_report_time = now
+			Statistics.last_report_events = Statistics.events
+
+			ratio = (Statistics.decompressed_bytes / Statistics.wire_bytes) if Statistics.wire_bytes > 0 else 0
+			requests_per_connection = (Statistics.requests / Statistics.total_connections) if Statistics.total_connections > 0 else 0
+
+			print("connections: %d (total %d, %.1f requests each), requests: %d, events: %d (%.0f/s, invalid %d), "
+				  "wire: %d bytes, decompressed: %d bytes (x%.1f), injected failures: %d"
+				  % (Statistics.connections, Statistics.total_connections, requests_per_connection, Statistics.requests,
+					 Statistics.events, events_per_second, Statistics.invalid_events,
+					 Statistics.wire_bytes, Statistics.decompressed_bytes, ratio, Statistics.failures), flush=True)
+
+			if self.sink.output:
+				self.sink.output.flush()
+
+	async def run(self):
+		servers = [await asyncio.start_server(self.on_http_connected, self.options.host, self.options.port, backlog=1024)]
+		print("Event collector stand-in server is listening on http://%s:%d/<any path>" % (self.options.host, self.options.port), flush=True)
+
+		if self.options.tcp_port:
+			servers.append(await asyncio.start_server(self.on_tcp_connected, self.options.host, self.options.tcp_port, backlog=1024))
+			print("Event collector stand-in server is listening on tcp://%s:%d" % (self.options.host, self.options.tcp_port), flush=True)
+
+		asyncio.ensure_future(self.report())
+		await asyncio.gather(*(server.serve_forever() for server in servers))
+
+
+def main():
+	parser = argparse.ArgumentParser(description="Event collector stand-in server for testing the event forwarder")
+	parser.add_argument("--host", default="127.0.0.1")
+	parser.add_argument("--port", type=int, default=8080)
+	parser.add_argument("--tcp-port", type=int, default=0, help="Also accept tcp:// collectors on this port")
+	parser.add_argument("--user-key", default=None, help="Require 'Authorization: Bearer <user key>' (Analytics > UserKey)")
+	parser.add_argument("--output", default=None, help="Append the received events to this file")
+	parser.add_argument("--fail-rate", type=float, default=0, help="Ratio of the requests answered with --fail-status")
+	parser.add_argument("--fail-status", type=int, default=503)
+	parser.add_argument("--close-rate", type=float, default=0, help="Ratio of the requests (or lines) whose connection is closed without a response")
+	parser.add_argument("--response-delay-ms", type=int, default=0, help="Delay every response")
+	parser.add_argument("--response-mode", choices=["keep-alive", "close", "http10", "chunked"], default="keep-alive",
+						help="How the successful responses are sent")
+	parser.add_argument("--report-interval", type=float, default=5)
+	parser.add_argument("--seed", type=int, default=None)
+	parser.add_argument("--verbose", action="store_true")
+	options = parser.parse_args()
+
+	random.seed(options.seed)
+
+	try:
+		asyncio.run(CollectorServer(options).run())
+	except KeyboardInterrupt:
+		pass
+
+
+if __name__ == "__main__":
+	main()
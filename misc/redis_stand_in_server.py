@@ -0,0 +1,465 @@
+#!/usr/bin/env python3
+#==============================================================================
+#
+#  OvenMediaEngine
+#
+#  Redis stand-in server for testing the origin map client (OriginMapClient)
+#
+#==============================================================================
+"""
+A local in-memory server speaking RESP2, with the subset of Redis used by
+OriginMapClient, so origin/edge clustering can be tested without a Redis server:
+
+- AUTH, PING, ECHO, SELECT, QUIT
+- SET (EX/PX, NX/XX), GET, DEL, EXISTS, EXPIRE, TTL, KEYS, DBSIZE, FLUSHALL
+- PUBLISH, SUBSCRIBE, UNSUBSCRIBE
+- Pipelining: the commands received in one read are answered in one write, and
+  the report shows how many commands arrived per read (the pipeline depth)
+- Fault injection: delayed replies, unanswered commands, dropped connections
+
+    $ python3 misc/redis_stand_in_server.py --port 6379 --password ome
+
+    <!-- Server.xml, VirtualHost > OriginMapStore -->
+    <OriginMapStore>
+        <RedisServer>
+            <Host>127.0.0.1:6379</Host>
+            <Auth>ome</Auth>
+        </RedisServer>
+        <OriginHostName>origin1.example.com</OriginHostName>
+    </OriginMapStore>
+
+To test the command timeout (REDIS_COMMAND_TIMEOUT_MS) and the reconnection,
+run the server with --reply-delay-ms 1500, --ignore-command GET or
+--close-after-commands 100.
+"""
+
+import argparse
+import asyncio
+import fnmatch
+import time
+
+
+class Statistics:
+	connections = 0
+	subscribers = 0
+	commands = 0
+	# Number of reads that contained at least one command
+	batches = 0
+	max_batch_size = 0
+	published = 0
+	delivered = 0
+
+
+class ProtocolError(Exception):
+	pass
+
+
+#------------------------------------------------------------------------------
+# RESP2
+#------------------------------------------------------------------------------
+def encode(value):
+	if value is None:
+		return b"$-1\r\n"
+	if isinstance(value, bool):
+		return b":%d\r\n" % int(value)
+	if isinstance(value, int):
+		return b":%d\r\n" % value
+	if isinstance(value, Status):
+		return b"+%s\r\n" % value.text.encode()
+	if isinstance(value, Error):
+		return b"-%s\r\n" % value.text.encode()
+	if isinstance(value, str):
+		value = value.encode()
+	if isinstance(value, bytes):
+		return b"$%d\r\n%s\r\n" % (len(value), value)
+	if isinstance(value, (list, tuple)):
+		return b"*%d\r\n" % len(value) + b"".join(encode(item) for item in value)
+	raise TypeError("Cannot encode %r" % (value,))
+
+
+class Status:
+	def __init__(self, text):
+		self.text = text
+
+
+class Error:
+	def __init__(self, text):
+		self.text = text
+
+
+OK = Status("OK")
+# Returned by the command handlers that don't reply (e.g. SUBSCRIBE pushes its own replies)
+NO_REPLY = object()
+
+
+def parse_command(buffer, offset):
+	"""Returns (arguments, next offset), or (None, offset) if the command is not complete"""
+	if offset >= len(buffer):
+		return None, offset
+
+	if buffer[offset:offset + 1] != b"*":
+		# Inline command (e.g. typed in telnet)
+		end = buffer.find(b"\r\n", offset)
+		if end < 0:
+			return None, offset
+		return buffer[offset:end].split(), end + 2
+
+	end = buffer.find(b"\r\n", offset)
+	if end < 0:
+		return None, offset
+
+	count = int(buffer[offset + 1:end])
+	position = end + 2
+	arguments = []
+
+	for _ in range(count):
+		end = buffer.find(b"\r\n", position)
+		if end < 0:
+			return None, offset
+		if buffer[position:position + 1] != b"$":
+			raise ProtocolError("expected '$', got '%s'" % buffer[position:position + 1].decode(errors="replace"))
+
+		length = int(buffer[position + 1:end])
+		start = end + 2
+		if len(buffer) < start + length + 2:
+			return None, offset
+
+		arguments.append(bytes(buffer[start:start + length]))
+		position = start + length + 2
+
+	return arguments, position
+
+
+#------------------------------------------------------------------------------
+# Server
+#------------------------------------------------------------------------------
+class Store:
+	def __init__(self):
+		# key: (value, expire time in monotonic seconds or None)
+		self.items = {}
+
+	def get(self, key):
+		item = self.items.get(key)
+		if item is None:
+			return None
+		if (item[1] is not None) and (item[1] <= time.monotonic()):
+			del self.items[key]
+			return None
+		return item[0]
+
+	def exists(self, key):
+		return self.get(key) is not None
+
+	def set(self, key, value, expire_at):
+		self.items[key] = (value, expire_at)
+
+	def delete(self, key):
+		return self.items.pop(key, None) is not None
+
+	def expire(self, key, expire_at):
+		if self.exists(key) is False:
+			return False
+		self.items[key] = (self.items[key][0], expire_at)
+		return True
+
+	def ttl(self, key):
+		if self.exists(key) is False:
+			return -2
+		expire_at = self.items[key][1]
+		return -1 if expire_at is None else max(0, round(expire_at - time.monotonic()))
+
+	def keys(self, pattern):
+		return [key for key in list(self.items) if self.exists(key) and fnmatch.fnmatchcase(key.decode(errors="replace"), pattern)]
+
+	def sweep(self):
+		for key in list(self.items):
+			self.get(key)
+
+
+class Connection:
+	def __init__(self, server, reader, writer):
+		self.server = server
+		self.options = server.options
+		self.reader = reader
+		self.writer = writer
+		self.peer = writer.get_extra_info("peername")
+		self.authenticated = not self.options.password
+		self.channels = set()
+		self.handled_commands = 0
+		self.closing = False
+		# Replies and pushed messages in order, written at once after a batch of commands
+		self.pending = []
+		self.in_batch = False
+
+	def log(self, message):
+		if self.options.verbose:
+			print("[%s:%d] %s" % (self.peer[0], self.peer[1], message), flush=True)
+
+	async def run(self):
+		Statistics.connections += 1
+		self.log("Connected")
+
+		buffer = bytearray()
+
+		try:
+			while self.closing is False:
+				data = await self.reader.read(65536)
+				if not data:
+					break
+
+				buffer += data
+				offset = 0
+				batch_size = 0
+				self.in_batch = True
+
+				while self.closing is False:
+					arguments, offset = parse_command(buffer, offset)
+					if arguments is None:
+						break
+					if not arguments:
+						continue
+
+					batch_size += 1
+					reply = self.handle(arguments)
+					if reply is not NO_REPLY:
+						self.pending.append(encode(reply))
+
+				del buffer[:offset]
+
+				if batch_size > 0:
+					Statistics.batches += 1
+					Statistics.max_batch_size = max(Statistics.max_batch_size, batch_size)
+
+				if self.pending and (self.options.reply_delay_ms > 0):
+					await asyncio.sleep(self.options.reply_delay_ms / 1000)
+
+				self.in_batch = False
+				self.flush()
+				await self.writer.drain()
+		except ProtocolError as error:
+			self.writer.write(encode(Error("ERR Protocol error: %s" % error)))
+		except (ConnectionError, asyncio.IncompleteReadError):
+			pass
+		finally:
+			Statistics.connections -= 1
+			self.unsubscribe_all()
+			self.writer.close()
+			self.log("Disconnected")
+
+	def handle(self, arguments):
+		name = arguments[0].decode(errors="replace").upper()
+		arguments = arguments[1:]
+
+		Statistics.commands += 1
+		self.handled_commands += 1
+		self.log("%s %s" % (name, " ".join(argument.decode(errors="replace") for argument in arguments)))
+
+		if (self.options.close_after_commands > 0) and (self.handled_commands > self.options.close_after_commands):
+			self.log("Closing the connection after %d commands" % self.options.close_after_commands)
+			self.closing = True
+			return NO_REPLY
+
+		if name in self.options.ignore_command:
+			return NO_REPLY
+
+		if (self.authenticated is False) and (name not in ("AUTH", "QUIT")):
+			return Error("NOAUTH Authentication required.")
+
+		if self.channels and (name not in ("SUBSCRIBE", "UNSUBSCRIBE", "PING", "QUIT")):
+			return Error("ERR Can't execute '%s': only (P)SUBSCRIBE / (P)UNSUBSCRIBE / PING / QUIT are allowed in this context" % name.lower())
+
+		handler = getattr(self, "command_" + name.lower(), None)
+		if handler is None:
+			return Error("ERR unknown command '%s'" % name.lower())
+
+		try:
+			return handler(arguments)
+		except (IndexError, ValueError):
+			return Error("ERR wrong number of arguments or syntax error for '%s' command" % name.lower())
+
+	#--------------------------------------------------------------------------
+	# Connection
+	#--------------------------------------------------------------------------
+	def command_auth(self, arguments):
+		# AUTH <password> or AUTH <user> <password>
+		if not self.options.password:
+			return Error("ERR AUTH <password> called without any password configured for the default user.")
+		if arguments[-1].decode() != self.options.password:
+			return Error("WRONGPASS invalid username-password pair or user is disabled.")
+		self.authenticated = True
+		return OK
+
+	def command_ping(self, arguments):
+		if self.channels:
+			return [b"pong", arguments[0] if arguments else b""]
+		return arguments[0] if arguments else Status("PONG")
+
+	def command_echo(self, arguments):
+		return arguments[0]
+
+	def command_select(self, arguments):
+		int(arguments[0])
+		return OK
+
+	def command_quit(self, arguments):
+		self.closing = True
+		return OK
+
+	#--------------------------------------------------------------------------
+	# Keys
+	#--------------------------------------------------------------------------
+	def command_set(self, arguments):
+		key, value = arguments[0], arguments[1]
+		expire_at = None
+		condition = None
+		index = 2
+
+		while index < len(arguments):
+			option = arguments[index].decode().upper()
+			if option == "EX":
+				expire_at = time.monotonic() + int(arguments[index + 1])
+				index += 2
+			elif option == "PX":
+				expire_at = time.monotonic() + int(arguments[index + 1]) / 1000
+				index += 2
+			elif option in ("NX", "XX"):
+				condition = option
+				index += 1
+			else:
+				return Error("ERR syntax error")
+
+		exists = self.server.store.exists(key)
+		if ((condition == "NX") and exists) or ((condition == "XX") and (exists is False)):
+			return None
+
+		self.server.store.set(key, value, expire_at)
+		return OK
+
+	def command_get(self, arguments):
+		return self.server.store.get(arguments[0])
+
+	def command_del(self, arguments):
+		return sum(1 for key in arguments if self.server.store.delete(key))
+
+	def command_exists(self, arguments):
+		return sum(1 for key in arguments if self.server.store.exists(key))
+
+	def command_expire(self, arguments):
+		return self.server.store.expire(arguments[0], time.monotonic() + int(arguments[1]))
+
+	def command_ttl(self, arguments):
+		return self.server.store.ttl(arguments[0])
+
+	def command_keys(self, arguments):
+		return self.server.store.keys(arguments[0].decode())
+
+	def command_dbsize(self, arguments):
+		self.server.store.sweep()
+		return len(self.server.store.items)
+
+	def command_flushall(self, arguments):
+		self.server.store.items.clear()
+		return OK
+
+	#--------------------------------------------------------------------------
+	# Pub/Sub
+	#--------------------------------------------------------------------------
+	def command_publish(self, arguments):
+		channel, message = arguments[0], arguments[1]
+		Statistics.published += 1
+		return self.server.publish(channel, message)
+
+	def command_subscribe(self, arguments):
+		# Each channel has its own reply
+		for channel in arguments:
+			if channel not in self.channels:
+				if not self.channels:
+					Statistics.subscribers += 1
+				self.channels.add(channel)
+				self.server.subscribers.setdefault(channel, set()).add(self)
+			self.push([b"subscribe", channel, len(self.channels)])
+		return NO_REPLY
+
+	def command_unsubscribe(self, arguments):
+		for channel in (arguments or list(self.channels)):
+			self.remove_channel(channel)
+			self.push([b"unsubscribe", channel, len(self.channels)])
+		return NO_REPLY
+
+	def remove_channel(self, channel):
+		if channel not in self.channels:
+			return
+		self.channels.discard(channel)
+		self.server.subscribers.get(channel, set()).discard(self)
+		if not self.channels:
+			Statistics.subscribers -= 1
+
+	def unsubscribe_all(self):
+		for channel in list(self.channels):
+			self.remove_channel(channel)
+
+	def push(self, message):
+		self.pending.append(encode(message))
+		if self.in_batch is False:
+			self.flush()
+
+	def flush(self):
+		if self.pending and (self.writer.is_closing() is False):
+			self.writer.write(b"".join(self.pending))
+		self.pending.clear()
+
+
+class RedisServer:
+	def __init__(self, options):
+		self.options = options
+		self.store = Store()
+		# channel: set of Connection
+		self.subscribers = {}
+
+	def publish(self, channel, message):
+		receivers = list(self.subscribers.get(channel, ()))
+		for connection in receivers:
+			connection.push([b"message", channel, message])
+		Statistics.delivered += len(receivers)
+		return len(receivers)
+
+	async def on_connected(self, reader, writer):
+		await Connection(self, reader, writer).run()
+
+	async def report(self):
+		while True:
+			await asyncio.sleep(self.options.report_interval)
+			self.store.sweep()
+			average = (Statistics.commands / Statistics.batches) if Statistics.batches > 0 else 0
+			print("connections: %d, subscribers: %d, keys: %d, commands: %d (%.1f per read, max %d), published: %d, delivered: %d"
+				  % (Statistics.connections, Statistics.subscribers, len(self.store.items), Statistics.commands,
+					 average, Statistics.max_batch_size, Statistics.published, Statistics.delivered), flush=True)
+
+	async def run(self):
+		server = await asyncio.start_server(self.on_connected, self.options.host, self.options.port, backlog=4096)
+		print("Redis stand-in server is listening on %s:%d" % (self.options.host, self.options.port), flush=True)
+		asyncio.ensure_future(self.report())
+		async with server:
+			await server.serve_forever()
+
+
+def main():
+	parser = argparse.ArgumentParser(description="Redis stand-in server for testing the origin map client")
+	parser.add_argument("--host", default="127.0.0.1")
+	parser.add_argument("--port", type=int, default=6379)
+	parser.add_argument("--password", default=None, help="Require AUTH with this password")
+	parser.add_argument("--reply-delay-ms", type=int, default=0, help="Delay every reply")
+	parser.add_argument("--ignore-command", action="append", default=[], type=str.upper, help="Never answer the command (e.g. GET)")
+	parser.add_argument("--close-after-commands", type=int, default=0, help="Close each connection after this many commands")
+	parser.add_argument("--report-interval", type=float, default=5)
+	parser.add_argument("--verbose", action="store_true")
+	options = parser.parse_args()
+
+	try:
+		asyncio.run(RedisServer(options).run())
+	except KeyboardInterrupt:
+		pass
+
+
+if __name__ == "__main__":
+	main()
@@ -0,0 +1,537 @@
+#!/usr/bin/env python3
+#==============================================================================
+#
+#  OvenMediaEngine
+#
+#  RTSP stand-in server for testing the RTSP pull provider (rtspc)
+#
+#==============================================================================
+"""
+A local RTSP server that serves a synthetic camera stream on every path, so the
+RTSP pull provider can be tested without real cameras:
+
+- H.264 video (64x64, I_PCM keyframes and skipped P frames, no encoder needed)
+  and optionally AAC-LC audio (silent frames), sent as RTP/AVP/TCP interleaved
+- OPTIONS, DESCRIBE, SETUP (pipelined), PLAY, GET_PARAMETER, TEARDOWN
+- Basic/Digest authentication
+- Fault injection: delayed responses, unanswered methods, dropped connections
+
+Thousands of cameras can be emulated by pulling different paths of one server:
+
+    $ python3 misc/rtsp_stand_in_server.py --port 8554 --audio
+
+    <!-- Server.xml, application > Origins -->
+    <Origin>
+        <Location>/app/cam</Location>
+        <Pass>
+            <Scheme>rtsp</Scheme>
+            <Urls><Url>127.0.0.1:8554/cam</Url></Urls>
+        </Pass>
+    </Origin>
+
+    Playing /app/cam1 ... /app/cam2000 makes OME pull rtsp://127.0.0.1:8554/cam1 ... /cam2000.
+
+To test the reconnection after a network flap, run the server with
+--close-after-ms (every connection is dropped while playing), or restart it.
+"""
+
+import argparse
+import asyncio
+import base64
+import hashlib
+import random
+import struct
+import time
+
+RTSP_PUBLIC = "OPTIONS, DESCRIBE, SETUP, PLAY, GET_PARAMETER, SET_PARAMETER, TEARDOWN"
+
+VIDEO_PAYLOAD_TYPE = 96
+VIDEO_CLOCK_RATE = 90000
+AUDIO_PAYLOAD_TYPE = 97
+AUDIO_CLOCK_RATE = 48000
+AUDIO_SAMPLES_PER_FRAME = 1024
+# AAC-LC, 48000 Hz, mono
+AUDIO_SPECIFIC_CONFIG = "1188"
+# Silent AAC-LC mono frame
+AUDIO_SILENT_FRAME = bytes([0x00, 0xC8, 0x00, 0x80, 0x23, 0x80])
+
+MAX_RTP_PAYLOAD_SIZE = 1400
+
+# 64x64 (4x4 macroblocks)
+WIDTH_IN_MBS = 4
+HEIGHT_IN_MBS = 4
+
+
+#------------------------------------------------------------------------------
+# H.264 bitstream
+#------------------------------------------------------------------------------
+class BitWriter:
+	def __init__(self):
+		self.bits = []
+
+	def u(self, count, value):
+		for i in range(count - 1, -1, -1):
+			self.bits.append((value >> i) & 1)
+
+	def ue(self, value):
+		value += 1
+		length = value.bit_length()
+		self.u(length - 1, 0)
+		self.u(length, value)
+
+	def se(self, value):
+		self.ue((2 * value - 1) if value > 0 else (-2 * value))
+
+	def align_zero(self):
+		while len(self.bits) % 8 != 0:
+			self.bits.append(0)
+
+	def trailing(self):
+		self.bits.append(1)
+		self.align_zero()
+
+	def to_bytes(self):
+		data = bytearray()
+		for i in range(0, len(self.bits), 8):
+			byte = 0
+			for bit in self.bits[i:i + 8]:
+				byte = (byte << 1) | bit
+			data.append(byte)
+		return bytes(data)
+
+
+def escape_rbsp(nal_header, rbsp):
+	# Emulation prevention
+	data = bytearray([nal_header])
+	zeros = 0
+	for byte in rbsp:
+		if zeros >= 2 and byte <= 3:
+			data.append(3)
+			zeros = 0
+		data.append(byte)
+		zeros = (zeros + 1) if byte == 0 else 0
+	return bytes(data)
+
+
+def make_sps():
+	w = BitWriter()
+	w.u(8, 66)  # profile_idc: Baseline
+	w.u(8, 0xC0)  # constraint_set0/1
+	w.u(8, 10)  # level_idc
+	w.ue(0)  # seq_parameter_set_id
+	w.ue(0)  # log2_max_frame_num_minus4
+	w.ue(2)  # pic_order_cnt_type
+	w.ue(1)  # max_num_ref_frames
+	w.u(1, 0)  # gaps_in_frame_num_value_allowed_flag
+	w.ue(WIDTH_IN_MBS - 1)
+	w.ue(HEIGHT_IN_MBS - 1)
+	w.u(1, 1)  # frame_mbs_only_flag
+	w.u(1, 1)  # direct_8x8_inference_flag
+	w.u(1, 0)  # frame_cropping_flag
+	w.u(1, 0)  # vui_parameters_present_flag
+	w.trailing()
+	return escape_rbsp(0x67, w.to_bytes())
+
+
+def make_pps():
+	w = BitWriter()
+	w.ue(0)  # pic_parameter_set_id
+	w.ue(0)  # seq_parameter_set_id
+	w.u(1, 0)  # entropy_coding_mode_flag (CAVLC)
+	w.u(1, 0)  # bottom_field_pic_order_in_frame_present_flag
+	w.ue(0)  # num_slice_groups_minus1
+	w.ue(0)  # num_ref_idx_l0_default_active_minus1
+	w.ue(0)  # num_ref_idx_l1_default_active_minus1
+	w.u(1, 0)  # weighted_pred_flag
+	w.u(2, 0)  # weighted_bipred_idc
+	w.se(0)  # pic_init_qp_minus26
+	w.se(0)  # pic_init_qs_minus26
+	w.se(0)  # chroma_qp_index_offset
+	w.u(1, 0)  # deblocking_filter_control_present_flag
+	w.u(1, 0)  # constrained_intra_pred_flag
+	w.u(1, 0)  # redundant_pic_cnt_present_flag
+	w.trailing()
+	return escape_rbsp(0x68, w.to_bytes())
+
+
+def make_idr_slice(idr_pic_id, luma):
+	w = BitWriter()
+	w.ue(0)  # first_mb_in_slice
+	w.ue(7)  # slice_type: I
+	w.ue(0)  # pic_parameter_set_id
+	w.u(4, 0)  # frame_num
+	w.ue(idr_pic_id)
+	w.u(1, 0)  # no_output_of_prior_pics_flag
+	w.u(1, 0)  # long_term_reference_flag
+	w.se(0)  # slice_qp_delta
+	for _ in range(WIDTH_IN_MBS * HEIGHT_IN_MBS):
+		w.ue(25)  # mb_type: I_PCM
+		w.align_zero()
+		# 16x16 luma + 2 x 8x8 chroma samples, the brightness changes every keyframe
+		for _ in range(256):
+			w.u(8, luma)
+		for _ in range(128):
+			w.u(8, 0x80)
+	w.trailing()
+	return escape_rbsp(0x65, w.to_bytes())
+
+
+def make_p_slice(frame_num):
+	w = BitWriter()
+	w.ue(0)  # first_mb_in_slice
+	w.ue(5)  # slice_type: P
+	w.ue(0)  # pic_parameter_set_id
+	w.u(4, frame_num % 16)
+	w.u(1, 0)  # num_ref_idx_active_override_flag
+	w.u(1, 0)  # ref_pic_list_modification_flag_l0
+	w.u(1, 0)  # adaptive_ref_pic_marking_mode_flag
+	w.se(0)  # slice_qp_delta
+	w.ue(WIDTH_IN_MBS * HEIGHT_IN_MBS)  # mb_skip_run: every macroblock is skipped
+	w.trailing()
+	return escape_rbsp(0x41, w.to_bytes())
+
+
+SPS = make_sps()
+PPS = make_pps()
+
+
+#------------------------------------------------------------------------------
+# RTP
+#------------------------------------------------------------------------------
+class RtpSender:
+	def __init__(self, payload_type, clock_rate):
+		self.payload_type = payload_type
+		self.clock_rate = clock_rate
+		self.ssrc = random.getrandbits(32)
+		self.sequence = random.getrandbits(16)
+		self.base_timestamp = random.getrandbits(32)
+		self.channel = None
+
+	def make_packet(self, payload, timestamp, marker):
+		header = struct.pack("!BBHII", 0x80, (0x80 if marker else 0) | self.payload_type, self.sequence, (self.base_timestamp + timestamp) & 0xFFFFFFFF, self.ssrc)
+		self.sequence = (self.sequence + 1) & 0xFFFF
+		packet = header + payload
+		# Interleaved frame
+		return struct.pack("!cBH", b"$", self.channel, len(packet)) + packet
+
+
+def packetize_h264(sender, nal_units, timestamp):
+	packets = []
+	for index, nal in enumerate(nal_units):
+		last = index == len(nal_units) - 1
+		if len(nal) <= MAX_RTP_PAYLOAD_SIZE:
+			packets.append(sender.make_packet(nal, timestamp, last))
+			continue
+
+		# FU-A
+		indicator = (nal[0] & 0xE0) | 28
+		nal_type = nal[0] & 0x1F
+		payload = nal[1:]
+		offset = 0
+		while offset < len(payload):
+			fragment = payload[offset:offset + MAX_RTP_PAYLOAD_SIZE - 2]
+			start = offset == 0
+			offset += len(fragment)
+			end = offset >= len(payload)
+			header = (0x80 if start else 0) | (0x40 if end else 0) | nal_type
+			packets.append(sender.make_packet(bytes([indicator, header]) + fragment, timestamp, last and end))
+	return packets
+
+
+def packetize_aac(sender, frame, timestamp):
+	# AAC-hbr: AU-headers-length (16 bits) + AU-header (13 bits size, 3 bits index)
+	payload = struct.pack("!HH", 16, len(frame) << 3) + frame
+	return [sender.make_packet(payload, timestamp, True)]
+
+
+#------------------------------------------------------------------------------
+# RTSP
+#------------------------------------------------------------------------------
+class Statistics:
+	connections = 0
+	playing = 0
+	handshakes = 0
+	handshake_time_total = 0.0
+
+
+class RtspSession:
+	def __init__(self, server, reader, writer):
+		self.server = server
+		self.options = server.options
+		self.reader = reader
+		self.writer = writer
+		self.session_id = "%016X" % random.getrandbits(64)
+		self.nonce = "%032x" % random.getrandbits(128)
+		self.video = RtpSender(VIDEO_PAYLOAD_TYPE, VIDEO_CLOCK_RATE)
+		self.audio = RtpSender(AUDIO_PAYLOAD_TYPE, AUDIO_CLOCK_RATE) if self.options.audio else None
+		self.play_task = None
+		self.connected_time = time.monotonic()
+		self.peer = writer.get_extra_info("peername")
+
+	def log(self, message):
+		if self.options.verbose:
+			print("[%s:%s] %s" % (self.peer[0], self.peer[1], message), flush=True)
+
+	async def run(self):
+		Statistics.connections += 1
+		self.log("Connected")
+		try:
+			while True:
+				request = await self.read_request()
+				if request is None:
+					break
+				await self.handle_request(*request)
+		except (ConnectionError, asyncio.IncompleteReadError):
+			pass
+		finally:
+			Statistics.connections -= 1
+			if self.play_task is not None:
+				self.play_task.cancel()
+			self.writer.close()
+			self.log("Disconnected")
+
+	async def read_request(self):
+		while True:
+			first = await self.reader.readexactly(1)
+			if first == b"$":
+				# RTCP from the client (receiver reports)
+				header = await self.reader.readexactly(3)
+				await self.reader.readexactly(struct.unpack("!BH", header)[1])
+				continue
+
+			head = first + await self.reader.readuntil(b"\r\n\r\n")
+			lines = head.decode("utf-8", "replace").split("\r\n")
+			method, url, _ = lines[0].split(" ", 2)
+			headers = {}
+			for line in lines[1:]:
+				if ":" in line:
+					name, value = line.split(":", 1)
+					headers[name.strip().lower()] = value.strip()
+
+			length = int(headers.get("content-length", "0"))
+			if length > 0:
+				await self.reader.readexactly(length)
+
+			return method.upper(), url, headers
+
+	async def respond(self, headers, status, extra_headers=None, body=b""):
+		response = "RTSP/1.0 %s\r\nCSeq: %s\r\nServer: OvenMediaEngine RTSP stand-in\r\n" % (status, headers.get("cseq", "0"))
+		for name, value in (extra_headers or {}).items():
+			response += "%s: %s\r\n" % (name, value)
+		if body:
+			response += "Content-Length: %d\r\n" % len(body)
+		response += "\r\n"
+
+		if self.options.response_delay_ms > 0:
+			await asyncio.sleep(self.options.response_delay_ms / 1000.0)
+
+		self.writer.write(response.encode() + body)
+		await self.writer.drain()
+
+	def is_authorized(self, method, headers):
+		if self.options.auth is None:
+			return True
+
+		user, password = self.options.auth.split(":", 1)
+		authorization = headers.get("authorization", "")
+
+		if authorization.startswith("Basic "):
+			return base64.b64decode(authorization[6:]).decode() == self.options.auth
+
+		if authorization.startswith("Digest "):
+			fields = {}
+			for item in authorization[7:].split(","):
+				if "=" in item:
+					name, value = item.split("=", 1)
+					fields[name.strip()] = value.strip().strip('"')
+			ha1 = hashlib.md5(("%s:%s:%s" % (user, self.options.realm, password)).encode()).hexdigest()
+			ha2 = hashlib.md5(("%s:%s" % (method, fields.get("uri", ""))).encode()).hexdigest()
+			expected = hashlib.md5(("%s:%s:%s" % (ha1, self.nonce, ha2)).encode()).hexdigest()
+			return fields.get("username") == user and fields.get("response") == expected
+
+		return False
+
+	def make_sdp(self, url):
+		sdp = [
+			"v=0",
+			"o=- %d 1 IN IP4 127.0.0.1" % random.getrandbits(31),
+			"s=OvenMediaEngine RTSP stand-in",
+			"c=IN IP4 0.0.0.0",
+			"t=0 0",
+			"a=control:*",
+			"m=video 0 RTP/AVP %d" % VIDEO_PAYLOAD_TYPE,
+			"a=rtpmap:%d H264/%d" % (VIDEO_PAYLOAD_TYPE, VIDEO_CLOCK_RATE),
+			"a=fmtp:%d packetization-mode=1;profile-level-id=42C00A;sprop-parameter-sets=%s,%s"
+			% (VIDEO_PAYLOAD_TYPE, base64.b64encode(SPS).decode(), base64.b64encode(PPS).decode()),
+			"a=control:trackID=0",
+		]
+		if self.audio is not None:
+			sdp += [
+				"m=audio 0 RTP/AVP %d" % AUDIO_PAYLOAD_TYPE,
+				"a=rtpmap:%d MPEG4-GENERIC/%d/1" % (AUDIO_PAYLOAD_TYPE, AUDIO_CLOCK_RATE),
+				"a=fmtp:%d streamtype=5;profile-level-id=15;mode=AAC-hbr;config=%s;sizelength=13;indexlength=3;indexdeltalength=3"
+				% (AUDIO_PAYLOAD_TYPE, AUDIO_SPECIFIC_CONFIG),
+				"a=control:trackID=1",
+			]
+		return ("\r\n".join(sdp) + "\r\n").encode()
+
+	async def handle_request(self, method, url, headers):
+		self.log("%s %s" % (method, url))
+
+		if method in self.options.ignore_method:
+			# Never answered, to test the response timeout of the client
+			return
+
+		if method == "OPTIONS":
+			await self.respond(headers, "200 OK", {"Public": RTSP_PUBLIC})
+			return
+
+		if method in ("DESCRIBE", "SETUP", "PLAY") and self.is_authorized(method, headers) is False:
+			if self.options.auth_scheme == "digest":
+				challenge = 'Digest realm="%s", nonce="%s"' % (self.options.realm, self.nonce)
+			else:
+				challenge = 'Basic realm="%s"' % self.options.realm
+			await self.respond(headers, "401 Unauthorized", {"WWW-Authenticate": challenge})
+			return
+
+		if method == "DESCRIBE":
+			content_base = url if url.endswith("/") else url + "/"
+			await self.respond(headers, "200 OK", {"Content-Base": content_base, "Content-Type": "application/sdp"}, self.make_sdp(url))
+
+		elif method == "SETUP":
+			sender = self.audio if url.rstrip("/").endswith("trackID=1") else self.video
+			if sender is None:
+				await self.respond(headers, "404 Not Found")
+				return
+
+			transport = headers.get("transport", "")
+			interleaved = [item for item in transport.split(";") if item.startswith("interleaved=")]
+			if "TCP" not in transport or len(interleaved) == 0:
+				await self.respond(headers, "461 Unsupported Transport")
+				return
+
+			sender.channel = int(interleaved[0].split("=")[1].split("-")[0])
+			await self.respond(headers, "200 OK", {
+				"Transport": "RTP/AVP/TCP;unicast;%s;ssrc=%08X" % (interleaved[0], sender.ssrc),
+				"Session": "%s;timeout=60" % self.session_id
+			})
+
+		elif method == "PLAY":
+			senders = [sender for sender in (self.video, self.audio) if sender is not None and sender.channel is not None]
+			if len(senders) == 0:
+				await self.respond(headers, "455 Method Not Valid in This State")
+				return
+
+			rtp_info = ",".join("url=%strackID=%d;seq=%d;rtptime=%d" % (url if url.endswith("/") else url + "/", 0 if sender is self.video else 1, sender.sequence, sender.base_timestamp) for sender in senders)
+			await self.respond(headers, "200 OK", {"Session": self.session_id, "Range": "npt=0.000-", "RTP-Info": rtp_info})
+
+			Statistics.handshakes += 1
+			Statistics.handshake_time_total += time.monotonic() - self.connected_time
+
+			if self.play_task is None:
+				self.play_task = asyncio.ensure_future(self.play())
+
+		elif method in ("GET_PARAMETER", "SET_PARAMETER"):
+			await self.respond(headers, "200 OK", {"Session": self.session_id})
+
+		elif method == "TEARDOWN":
+			await self.respond(headers, "200 OK", {"Session": self.session_id})
+			self.writer.close()
+
+		else:
+			await self.respond(headers, "405 Method Not Allowed", {"Public": RTSP_PUBLIC})
+
+	async def play(self):
+		Statistics.playing += 1
+		try:
+			start_time = time.monotonic()
+			frame_index = 0
+			audio_index = 0
+			idr_pic_id = 0
+			frame_interval = 1.0 / self.options.fps
+
+			while True:
+				elapsed = time.monotonic() - start_time
+
+				if self.options.close_after_ms > 0 and elapsed * 1000 >= self.options.close_after_ms:
+					self.log("Closing the connection while playing (--close-after-ms)")
+					self.writer.close()
+					return
+
+				packets = []
+
+				while frame_index * frame_interval <= elapsed:
+					timestamp = int(frame_index * frame_interval * VIDEO_CLOCK_RATE)
+					gop_index = frame_index % self.options.gop
+					if gop_index == 0:
+						luma = 16 + (idr_pic_id * 37) % 220
+						nal_units = [SPS, PPS, make_idr_slice(idr_pic_id % 2, luma)]
+						idr_pic_id += 1
+					else:
+						nal_units = [make_p_slice(gop_index)]
+					packets += packetize_h264(self.video, nal_units, timestamp)
+					frame_index += 1
+
+				if self.audio is not None and self.audio.channel is not None:
+					while audio_index * AUDIO_SAMPLES_PER_FRAME <= elapsed * AUDIO_CLOCK_RATE:
+						packets += packetize_aac(self.audio, AUDIO_SILENT_FRAME, audio_index * AUDIO_SAMPLES_PER_FRAME)
+						audio_index += 1
+
+				if packets:
+					self.writer.write(b"".join(packets))
+					await self.writer.drain()
+
+				await asyncio.sleep(0.01)
+		except (ConnectionError, asyncio.CancelledError):
+			pass
+		finally:
+			Statistics.playing -= 1
+
+
+class RtspServer:
+	def __init__(self, options):
+		self.options = options
+
+	async def on_connected(self, reader, writer):
+		await RtspSession(self, reader, writer).run()
+
+	async def report(self):
+		while True:
+			await asyncio.sleep(self.options.report_interval)
+			average = (Statistics.handshake_time_total / Statistics.handshakes * 1000) if Statistics.handshakes > 0 else 0
+			print("connections: %d, playing: %d, handshakes: %d (avg %.1f ms from connect to PLAY)"
+				  % (Statistics.connections, Statistics.playing, Statistics.handshakes, average), flush=True)
+
+	async def run(self):
+		server = await asyncio.start_server(self.on_connected, self.options.host, self.options.port, backlog=4096)
+		print("RTSP stand-in server is listening on rtsp://%s:%d/<any path>" % (self.options.host, self.options.port), flush=True)
+		asyncio.ensure_future(self.report())
+		async with server:
+			await server.serve_forever()
+
+
+def main():
+	parser = argparse.ArgumentParser(description="RTSP stand-in server for testing the RTSP pull provider")
+	parser.add_argument("--host", default="127.0.0.1")
+	parser.add_argument("--port", type=int, default=8554)
+	parser.add_argument("--fps", type=float, default=30)
+	parser.add_argument("--gop", type=int, default=30, help="Keyframe interval in frames")
+	parser.add_argument("--audio", action="store_true", help="Add an AAC track (pipelined SETUPs)")
+	parser.add_argument("--auth", default=None, help="Require authentication, <user>:<password>")
+	parser.add_argument("--auth-scheme", choices=["basic", "digest"], default="digest")
+	parser.add_argument("--realm", default="OvenMediaEngine")
+	parser.add_argument("--response-delay-ms", type=int, default=0, help="Delay every response")
+	parser.add_argument("--ignore-method", action="append", default=[], type=str.upper, help="Never answer the method (e.g. DESCRIBE)")
+	parser.add_argument("--close-after-ms", type=int, default=0, help="Close each connection after playing for this long")
+	parser.add_argument("--report-interval", type=float, default=5)
+	parser.add_argument("--verbose", action="store_true")
+	options = parser.parse_args()
+
+	try:
+		asyncio.run(RtspServer(options).run())
+	except KeyboardInterrupt:
+		pass
+
+
+if __name__ == "__main__":
+	main()
@@ -147,7 +147,8 @@ namespace api
 				   is_port_configured, port_config.GetPort(),
 				   is_tls_port_configured, tls_port_config.GetPort(),
 				   managers_config,
-				   worker_count);
+				   worker_count) &&
+			   _stats_snapshot.Start(api_config.GetStatsSnapshot());
 	}
 
 	std::shared_ptr<http::svr::RequestInterceptor> Server::CreateInterceptor()
@@ -207,6 +208,8 @@ namespace api
 
 		_root_controller = nullptr;
 
+		_stats_snapshot.Stop();
+
 		return http_result && https_result;
 	}
 
@@ -16,6 +16,7 @@
 #include <modules/http/server/http_server_manager.h>
 
 #include "controllers/root_controller.h"
+#include "helpers/stats_snapshot.h"
 
 namespace api
 {
@@ -30,6 +31,11 @@ namespace api
 		MAY_THROWS(http::HttpError)
 		void DeleteVHost(const info::Host &host_info);
 
+		StatsSnapshot &GetStatsSnapshot()
+		{
+			return _stats_snapshot;
+		}
+
 	protected:
 		bool PrepareHttpServers(
 			const std::vector<ov::String> &server_ip_list,
@@ -55,5 +61,7 @@ namespace api
 		ov::String _storage_path;
 
 		http::CorsManager _cors_manager;
+
+		StatsSnapshot _stats_snapshot;
 	};
 }  // namespace api
@@ -61,16 +61,30 @@ namespace api
 		SetResponse(http::StatusCode::InternalServerError, error->what());
 	}
 
+	ApiResponse ApiResponse::FromSerializedJson(const ov::String &serialized_json)
+	{
+		ApiResponse response(http::StatusCode::OK);
+
+		response._has_serialized_response = true;
+		response._serialized_response = serialized_json;
+
+		return response;
+	}
+
 	ApiResponse::ApiResponse(const ApiResponse &response)
 	{
 		_status_code = response._status_code;
 		_json = response._json;
+		_has_serialized_response = response._has_serialized_response;
+		_serialized_response = response._serialized_response;
 	}
 
 	ApiResponse::ApiResponse(ApiResponse &&response)
 	{
 		_status_code = std::move(response._status_code);
 		_json = std::move(response._json);
+		_has_serialized_response = response._has_serialized_response;
+		_serialized_response = std::move(response._serialized_response);
 	}
 
 	void ApiResponse::SetResponse(http::StatusCode status_code)
@@ -100,6 +114,20 @@ namespace api
 		response->SetStatusCode(_status_code);
 		response->SetHeader("Content-Type", "application/json;charset=UTF-8");
 
+		if (_has_serialized_response)
+		{
+			// Same as the output of ov::Json::Stringify() (keys in ascending order)
+			ov::JsonWriter writer(_serialized_response.GetLength() + 64);
+
+			writer.BeginObject();
+			writer.Key("message").String(_json["message"].asCString());
+			writer.Key("response").Raw(_serialized_response);
+			writer.Key("statusCode").Int64(static_cast<int>(_status_code));
+			writer.EndObject();
+
+			return response->AppendString(writer.GetString());
+		}
+
 		return (_json.isNull() == false) ? response->AppendString(ov::Json::Stringify(_json)) : true;
 	}
 }  // namespace api
\ No newline at end of file
@@ -61,6 +61,15 @@ namespace api
 		// }
 		ApiResponse(const std::exception *error);
 
+		// {
+		//     "statusCode": 200,
+		//     "message": "OK",
+		//     "response": <serialized_json>
+		// }
+		//
+		// serialized_json is written as is without parsing (e.g. a cached JSON text)
+		static ApiResponse FromSerializedJson(const ov::String &serialized_json);
+
 		// Copy ctor
 		ApiResponse(const ApiResponse &response);
 		// Move ctor
@@ -81,6 +90,10 @@ namespace api
 
 		http::StatusCode _status_code = http::StatusCode::OK;
 		Json::Value _json = Json::Value::null;
+
+		// Used instead of _json["response"] if set
+		bool _has_serialized_response = false;
+		ov::String _serialized_response;
 	};
 
 	class ControllerInterface
@@ -8,6 +8,7 @@
 //==============================================================================
 #include "current_controller.h"
 
+#include "../../../../api_server.h"
 #include "vhosts/vhosts_controller.h"
 
 namespace api
@@ -19,14 +20,25 @@ namespace api
 			void CurrentController::PrepareHandlers()
 			{
 				RegisterGet(R"()", &CurrentController::OnGetServerMetrics);
+				Register(http::Method::Get, R"(\/metrics)", &CurrentController::OnGetOpenMetrics);
 
 				CreateSubController<VHostsController>(R"(\/vhosts)");
 			}
 
 			ApiResponse CurrentController::OnGetServerMetrics(const std::shared_ptr<http::svr::HttpExchange> &client)
 			{
-				auto serverMetric = MonitorInstance->GetServerMetrics();
-				return ::serdes::JsonFromMetrics(serverMetric);
+				auto snapshot = _server->GetStatsSnapshot().GetSnapshot();
+
+				return ApiResponse::FromSerializedJson(snapshot->server_json);
+			}
+
+			void CurrentController::OnGetOpenMetrics(const std::shared_ptr<http::svr::HttpExchange> &client)
+			{
+				const auto &response = client->GetResponse();
+
+				response->SetStatusCode(http::StatusCode::OK);
+				response->SetHeader("Content-Type", MON_OPEN_METRICS_CONTENT_TYPE);
+				response->AppendString(_open_metrics_exporter.Render());
 			}
 		}  // namespace stats
 	}	   // namespace v1
@@ -8,6 +8,8 @@
 //==============================================================================
 #pragma once
 
+#include <monitoring/open_metrics_exporter.h>
+
 #include "../../../controller.h"
 
 namespace api
@@ -22,6 +24,12 @@ namespace api
 				void PrepareHandlers() override;
 
 				ApiResponse OnGetServerMetrics(const std::shared_ptr<http::svr::HttpExchange> &client);
+
+				// Responds the metrics in the OpenMetrics text format instead of JSON (for Prometheus)
+				void OnGetOpenMetrics(const std::shared_ptr<http::svr::HttpExchange> &client);
+
+			protected:
+				mon::OpenMetricsExporter _open_metrics_exporter;
 			};
 		}  // namespace stats
 	}	   // namespace v1
@@ -8,6 +8,7 @@
 //==============================================================================
 #include "apps_controller.h"
 
+#include "../../../../../../api_server.h"
 #include "streams/streams_controller.h"
 
 namespace api
@@ -23,11 +24,12 @@ namespace api
 				CreateSubController<StreamsController>(R"(\/(?<app_name>[^\/:]*)\/streams)");
 			};
 
-			ApiResponse AppsController::OnGetApp(const std::shared_ptr<http::svr::HttpExchange> &client,
-												 const std::shared_ptr<mon::HostMetrics> &vhost,
-												 const std::shared_ptr<mon::ApplicationMetrics> &app)
+			ApiResponse AppsController::OnGetApp(const std::shared_ptr<http::svr::HttpExchange> &client)
 			{
-				return ::serdes::JsonFromMetrics(app);
+				const StatsSnapshot::Application *app = nullptr;
+				auto snapshot = GetMetricsSnapshot(client->GetRequest()->GetMatchResult(), _server->GetStatsSnapshot(), nullptr, &app, nullptr);
+
+				return ApiResponse::FromSerializedJson(app->json);
 			}
 		}  // namespace stats
 	}	   // namespace v1
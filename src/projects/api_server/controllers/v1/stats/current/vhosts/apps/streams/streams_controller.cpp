@@ -8,6 +8,8 @@
 //==============================================================================
 #include "streams_controller.h"
 
+#include "../../../../../../../api_server.h"
+
 namespace api
 {
 	namespace v1
@@ -16,16 +18,44 @@ namespace api
 		{
 			void StreamsController::PrepareHandlers()
 			{
+				RegisterGet(R"()", &StreamsController::OnGetStreamList);
 				RegisterGet(R"(\/(?<stream_name>[^\/]*))", &StreamsController::OnGetStream);
 			};
 
-			ApiResponse StreamsController::OnGetStream(const std::shared_ptr<http::svr::HttpExchange> &client,
-													   const std::shared_ptr<mon::HostMetrics> &vhost,
-													   const std::shared_ptr<mon::ApplicationMetrics> &app,
-													   const std::shared_ptr<mon::StreamMetrics> &stream,
-													   const std::vector<std::shared_ptr<mon::StreamMetrics>> &output_streams)
+			ApiResponse StreamsController::OnGetStreamList(const std::shared_ptr<http::svr::HttpExchange> &client)
+			{
+				ListQuery query(client);
+
+				const StatsSnapshot::Application *app = nullptr;
+				auto snapshot = GetMetricsSnapshot(client->GetRequest()->GetMatchResult(), _server->GetStatsSnapshot(), nullptr, &app, nullptr);
+
+				// [{"name": <stream_name>, "stats": <metrics>}, ...]
+				ov::JsonWriter writer;
+
+				writer.BeginArray();
+				for (const auto &item : app->stream_map)
+				{
+					if (query.Accept(item.first))
+					{
+						writer.BeginObject();
+						writer.Key("name").String(item.first);
+						writer.Key("stats").Raw(item.second);
+						writer.EndObject();
+					}
+				}
+				writer.EndArray();
+
+				query.SetTotalCountHeader(client);
+
+				return ApiResponse::FromSerializedJson(writer.GetString());
+			}
+
+			ApiResponse StreamsController::OnGetStream(const std::shared_ptr<http::svr::HttpExchange> &client)
 			{
-				return ::serdes::JsonFromMetrics(stream);
+				const ov::String *stream_json = nullptr;
+				auto snapshot = GetMetricsSnapshot(client->GetRequest()->GetMatchResult(), _server->GetStatsSnapshot(), nullptr, nullptr, &stream_json);
+
+				return ApiResponse::FromSerializedJson(*stream_json);
 			}
 		}  // namespace stats
 	}	   // namespace v1
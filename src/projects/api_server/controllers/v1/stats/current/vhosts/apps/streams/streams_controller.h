@@ -22,11 +22,9 @@ namespace api
 				void PrepareHandlers() override;
 
 			protected:
-				ApiResponse OnGetStream(const std::shared_ptr<http::svr::HttpExchange> &client,
-										const std::shared_ptr<mon::HostMetrics> &vhost,
-										const std::shared_ptr<mon::ApplicationMetrics> &app,
-										const std::shared_ptr<mon::StreamMetrics> &stream,
-										const std::vector<std::shared_ptr<mon::StreamMetrics>> &output_streams);
+				// Metrics of the streams in the application (supports ListQuery parameters)
+				ApiResponse OnGetStreamList(const std::shared_ptr<http::svr::HttpExchange> &client);
+				ApiResponse OnGetStream(const std::shared_ptr<http::svr::HttpExchange> &client);
 			};
 		}  // namespace stats
 	}	   // namespace v1
@@ -8,6 +8,7 @@
 //==============================================================================
 #include "vhosts_controller.h"
 
+#include "../../../../../api_server.h"
 #include "apps/apps_controller.h"
 
 namespace api
@@ -23,10 +24,12 @@ namespace api
 				CreateSubController<AppsController>(R"(\/(?<vhost_name>[^\/]*)\/apps)");
 			};
 
-			ApiResponse VHostsController::OnGetVhost(const std::shared_ptr<http::svr::HttpExchange> &client,
-													 const std::shared_ptr<mon::HostMetrics> &vhost)
+			ApiResponse VHostsController::OnGetVhost(const std::shared_ptr<http::svr::HttpExchange> &client)
 			{
-				return ::serdes::JsonFromMetrics(vhost);
+				const StatsSnapshot::VirtualHost *vhost = nullptr;
+				auto snapshot = GetMetricsSnapshot(client->GetRequest()->GetMatchResult(), _server->GetStatsSnapshot(), &vhost, nullptr, nullptr);
+
+				return ApiResponse::FromSerializedJson(vhost->json);
 			}
 		}  // namespace stats
 	}	   // namespace v1
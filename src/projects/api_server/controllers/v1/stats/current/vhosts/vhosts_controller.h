@@ -22,8 +22,7 @@ namespace api
 				void PrepareHandlers() override;
 
 			protected:
-				ApiResponse OnGetVhost(const std::shared_ptr<http::svr::HttpExchange> &client,
-									   const std::shared_ptr<mon::HostMetrics> &vhost);
+				ApiResponse OnGetVhost(const std::shared_ptr<http::svr::HttpExchange> &client);
 			};
 		}  // namespace stats
 	}	   // namespace v1
@@ -399,7 +399,7 @@ namespace api
 		{
 			logte("Called OnGetDummyAction. invoke [%s/%s]", vhost->GetName().CStr(), app->GetName().GetAppName());
 
-			return app->GetConfig().ToJson();
+			return app->GetConfig()->ToJson();
 		}
 
 	}  // namespace v1
@@ -105,6 +105,7 @@ namespace api
 		ApiResponse AppsController::OnGetAppList(const std::shared_ptr<http::svr::HttpExchange> &client,
 												 const std::shared_ptr<mon::HostMetrics> &vhost)
 		{
+			ListQuery query(client);
 			Json::Value response(Json::ValueType::arrayValue);
 
 			auto app_list = GetApplicationList(vhost);
@@ -112,10 +113,16 @@ namespace api
 			for (auto &item : app_list)
 			{
 				auto &app = item.second;
+				auto app_name = app->GetName().GetAppName();
 
-				response.append(app->GetName().GetAppName().CStr());
+				if (query.Accept(app_name))
+				{
+					response.append(app_name.CStr());
+				}
 			}
 
+			query.SetTotalCountHeader(client);
+
 			return response;
 		}
 
@@ -167,21 +174,27 @@ namespace api
 			cfg::vhost::app::Application app_config;
 			::serdes::ApplicationFromJson(app_json, &app_config);
 
-			ThrowIfOrchestratorNotSucceeded(
-				ocst::Orchestrator::GetInstance()->DeleteApplication(*app),
-				"delete",
-				"application",
-				ov::String::FormatString("%s/%s", vhost->GetName().CStr(), app->GetName().GetAppName().CStr()));
+			// Only the changed parts are applied, so the streams are kept if possible
+			std::vector<ov::String> affected_stream_list;
 
 			ThrowIfOrchestratorNotSucceeded(
-				ocst::Orchestrator::GetInstance()->CreateApplication(*vhost, app_config),
-				"create",
+				ocst::Orchestrator::GetInstance()->UpdateApplication(*app, app_config, &affected_stream_list),
+				"update",
 				"application",
 				ov::String::FormatString("%s/%s", vhost->GetName().CStr(), app->GetName().GetAppName().CStr()));
 
 			auto app_metrics = GetApplication(vhost, app_config.GetName().CStr());
+			auto response_json = ::serdes::JsonFromApplication(app_metrics);
+
+			// The streams whose sessions are closed to apply the new configuration
+			Json::Value affected_streams_json(Json::ValueType::arrayValue);
+			for (const auto &stream_name : affected_stream_list)
+			{
+				affected_streams_json.append(stream_name.CStr());
+			}
+			response_json["affectedStreams"] = affected_streams_json;
 
-			return ::serdes::JsonFromApplication(app_metrics);
+			return response_json;
 		}
 
 		ApiResponse AppsController::OnDeleteApp(const std::shared_ptr<http::svr::HttpExchange> &client,
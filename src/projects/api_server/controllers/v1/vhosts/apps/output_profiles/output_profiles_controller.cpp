@@ -48,7 +48,7 @@ namespace api
 
 			MultipleStatus status_codes;
 
-			Json::Value app_json = app->GetConfig().ToJson();
+			Json::Value app_json = app->GetConfig()->ToJson();
 			auto &output_profiles = app_json["outputProfiles"]["outputProfile"];
 
 			Json::Value response(Json::ValueType::arrayValue);
@@ -91,7 +91,7 @@ namespace api
 			Json::Value new_app_json;
 
 			new_app = GetApplication(vhost, app->GetName().GetAppName().CStr());
-			new_app_json = new_app->GetConfig().ToJson();
+			new_app_json = new_app->GetConfig()->ToJson();
 
 			for (auto &response_profile : response)
 			{
@@ -134,8 +134,10 @@ namespace api
 																	 const std::shared_ptr<mon::ApplicationMetrics> &app)
 		{
 			Json::Value response = Json::arrayValue;
+			// Hold the config while iterating the list in it
+			auto app_config = app->GetConfig();
 
-			for (auto &item : app->GetConfig().GetOutputProfileList())
+			for (auto &item : app_config->GetOutputProfileList())
 			{
 				response.append(item.GetName().CStr());
 			}
@@ -148,8 +150,9 @@ namespace api
 																 const std::shared_ptr<mon::ApplicationMetrics> &app)
 		{
 			auto profile_name = GetOutputProfileName(client);
+			auto app_config = app->GetConfig();
 
-			for (auto &profile : app->GetConfig().GetOutputProfileList())
+			for (auto &profile : app_config->GetOutputProfileList())
 			{
 				if (profile_name == profile.GetName().CStr())
 				{
@@ -173,7 +176,7 @@ namespace api
 			}
 
 			auto profile_name = GetOutputProfileName(client);
-			Json::Value app_json = app->GetConfig().ToJson();
+			Json::Value app_json = app->GetConfig()->ToJson();
 			Json::Value *output_profile_json;
 
 			off_t index = FindOutputProfile(app_json, profile_name, &output_profile_json);
@@ -230,7 +233,7 @@ namespace api
 				throw CreateNotFoundError(vhost, app, profile_name);
 			}
 
-			Json::Value app_json = app->GetConfig().ToJson();
+			Json::Value app_json = app->GetConfig()->ToJson();
 			auto &output_profiles = app_json["outputProfiles"]["outputProfile"];
 
 			if (output_profiles.removeIndex(index, nullptr) == false)
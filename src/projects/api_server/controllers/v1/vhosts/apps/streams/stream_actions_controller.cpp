@@ -358,7 +358,7 @@ namespace api
 		{
 			logte("Called OnGetDummyAction. invoke [%s/%s/%s]", vhost->GetName().CStr(), app->GetName().GetAppName(), stream->GetName().CStr());
 
-			return app->GetConfig().ToJson();
+			return app->GetConfig()->ToJson();
 		}
 
 		std::shared_ptr<pvd::Stream> StreamActionsController::GetSourceStream(const std::shared_ptr<mon::StreamMetrics> &stream)
@@ -137,6 +137,7 @@ namespace api
 													   const std::shared_ptr<mon::HostMetrics> &vhost,
 													   const std::shared_ptr<mon::ApplicationMetrics> &app)
 		{
+			ListQuery query(client);
 			Json::Value response = Json::arrayValue;
 
 			auto stream_list = app->GetStreamMetricsMap();
@@ -147,10 +148,17 @@ namespace api
 
 				if (stream->GetLinkedInputStream() == nullptr)
 				{
-					response.append(stream->GetName().CStr());
+					auto stream_name = stream->GetName();
+
+					if (query.Accept(stream_name))
+					{
+						response.append(stream_name.CStr());
+					}
 				}
 			}
 
+			query.SetTotalCountHeader(client);
+
 			return response;
 		}
 
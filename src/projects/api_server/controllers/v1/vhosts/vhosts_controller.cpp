@@ -81,14 +81,22 @@ namespace api
 
 		ApiResponse VHostsController::OnGetVHostList(const std::shared_ptr<http::svr::HttpExchange> &client)
 		{
+			ListQuery query(client);
 			auto vhost_list = GetVirtualHostList();
 			Json::Value response(Json::ValueType::arrayValue);
 
 			for (const auto &item : vhost_list)
 			{
-				response.append(item.second->GetName().CStr());
+				auto vhost_name = item.second->GetName();
+
+				if (query.Accept(vhost_name))
+				{
+					response.append(vhost_name.CStr());
+				}
 			}
 
+			query.SetTotalCountHeader(client);
+
 			return response;
 		}
 
@@ -221,6 +221,128 @@ namespace api
 		}
 	}
 
+	MAY_THROWS(http::HttpError)
+	static ov::String GetNamedGroupValue(const ov::MatchResult &match_result, const char *name, const char *description)
+	{
+		auto group = match_result.GetNamedGroup(name);
+
+		if (group.IsValid() == false)
+		{
+			throw http::HttpError(
+				http::StatusCode::InternalServerError,
+				"Could not find the %s regex group", description);
+		}
+
+		return group.GetValue();
+	}
+
+	// Returns false if an item is not found in the snapshot
+	static bool FindMetricsSnapshot(
+		const ov::MatchResult &match_result,
+		const StatsSnapshot::Snapshot &snapshot,
+		const StatsSnapshot::VirtualHost **vhost,
+		const StatsSnapshot::Application **app,
+		const ov::String **stream_json)
+	{
+		auto vhost_name = GetNamedGroupValue(match_result, "vhost_name", "virtual host");
+		auto vhost_item = snapshot.vhost_map.find(vhost_name);
+
+		if (vhost_item == snapshot.vhost_map.end())
+		{
+			return false;
+		}
+
+		if (vhost != nullptr)
+		{
+			*vhost = &(vhost_item->second);
+		}
+
+		if ((app == nullptr) && (stream_json == nullptr))
+		{
+			return true;
+		}
+
+		auto &app_map = vhost_item->second.app_map;
+		auto app_item = app_map.find(GetNamedGroupValue(match_result, "app_name", "application"));
+
+		if (app_item == app_map.end())
+		{
+			return false;
+		}
+
+		if (app != nullptr)
+		{
+			*app = &(app_item->second);
+		}
+
+		if (stream_json == nullptr)
+		{
+			return true;
+		}
+
+		auto &stream_map = app_item->second.stream_map;
+		auto stream_item = stream_map.find(GetNamedGroupValue(match_result, "stream_name", "stream"));
+
+		if (stream_item == stream_map.end())
+		{
+			return false;
+		}
+
+		*stream_json = &(stream_item->second);
+
+		return true;
+	}
+
+	std::shared_ptr<const StatsSnapshot::Snapshot> GetMetricsSnapshot(
+		const ov::MatchResult &match_result,
+		StatsSnapshot &stats_snapshot,
+		const StatsSnapshot::VirtualHost **vhost,
+		const StatsSnapshot::Application **app,
+		const ov::String **stream_json)
+	{
+		auto snapshot = stats_snapshot.GetSnapshot();
+
+		if (FindMetricsSnapshot(match_result, *snapshot, vhost, app, stream_json))
+		{
+			return snapshot;
+		}
+
+		// The item may be created after the snapshot was built - throws 404 if it does not exist at all
+		auto check_metrics = [&]() {
+			std::shared_ptr<mon::HostMetrics> vhost_metrics;
+			std::shared_ptr<mon::ApplicationMetrics> app_metrics;
+
+			GetVirtualHostMetrics(match_result, &vhost_metrics);
+
+			if ((app != nullptr) || (stream_json != nullptr))
+			{
+				GetApplicationMetrics(match_result, vhost_metrics, &app_metrics);
+			}
+
+			if (stream_json != nullptr)
+			{
+				GetStreamMetrics(match_result, vhost_metrics, app_metrics, nullptr, nullptr);
+			}
+		};
+
+		auto checked_msec = ov::Time::GetMonotonicTimestamp();
+		check_metrics();
+
+		snapshot = stats_snapshot.Rebuild(checked_msec);
+
+		if (FindMetricsSnapshot(match_result, *snapshot, vhost, app, stream_json) == false)
+		{
+			// The item was deleted while rebuilding the snapshot
+			check_metrics();
+
+			throw http::HttpError(
+				http::StatusCode::NotFound,
+				"Could not find the metrics: [%s]", match_result.GetSubject().CStr());
+		}
+
+		return snapshot;
+	}
+
 	void FillDefaultAppConfigValues(Json::Value &app_config)
 	{
 		// Setting up the default values
@@ -375,10 +497,10 @@ namespace api
 							const ov::String &output_profile_name,
 							Json::Value *value)
 	{
-		auto &app_config = app->GetConfig();
+		auto app_config = app->GetConfig();
 		off_t offset = 0;
 
-		for (auto &profile : app_config.GetOutputProfileList())
+		for (auto &profile : app_config->GetOutputProfileList())
 		{
 			if (output_profile_name == profile.GetName().CStr())
 			{
@@ -11,7 +11,9 @@
 #include <monitoring/monitoring.h>
 #include <orchestrator/orchestrator.h>
 #include <modules/http/server/http_exchange.h>
+#include "./list_query.h"
 #include "./multiple_status.h"
+#include "./stats_snapshot.h"
 
 namespace api
 {
@@ -48,6 +50,18 @@ namespace api
 		std::shared_ptr<mon::StreamMetrics> *stream_metrics,
 		std::vector<std::shared_ptr<mon::StreamMetrics>> *output_streams);
 
+	// Find the items of the snapshot by the named groups (vhost_name, app_name and stream_name) of match_result.
+	// Only the levels whose output parameter is not nullptr are looked up.
+	// If an item is created after the snapshot was built, the snapshot is rebuilt.
+	// The output pointers are valid while the returned snapshot is alive.
+	MAY_THROWS(http::HttpError)
+	std::shared_ptr<const StatsSnapshot::Snapshot> GetMetricsSnapshot(
+		const ov::MatchResult &match_result,
+		StatsSnapshot &stats_snapshot,
+		const StatsSnapshot::VirtualHost **vhost,
+		const StatsSnapshot::Application **app,
+		const ov::String **stream_json);
+
 	void FillDefaultAppConfigValues(Json::Value &app_config);
 
 	void OverwriteJson(const Json::Value &from, Json::Value &to);
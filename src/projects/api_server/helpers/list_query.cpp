@@ -0,0 +1,82 @@
+//==============================================================================
+//
+//  OvenMediaEngine
+//
+//  Created by Hyunjun Jang
+//  Copyright (c) 2022 AirenSoft. All rights reserved.
+//
+//==============================================================================
+#include "./list_query.h"
+
+#include <modules/http/http.h>
+
+namespace api
+{
+	MAY_THROWS(http::HttpError)
+	static size_t ParseNumber(const std::shared_ptr<const ov::Url> &url, const char *key)
+	{
+		auto value = url->GetQueryValue(key);
+
+		if (value.IsEmpty() || (value.IsNumeric() == false))
+		{
+			throw http::HttpError(http::StatusCode::BadRequest, "Invalid %s: [%s]", key, value.CStr());
+		}
+
+		return static_cast<size_t>(ov::Converter::ToUInt64(value.CStr()));
+	}
+
+	ListQuery::ListQuery(const std::shared_ptr<http::svr::HttpExchange> &client)
+	{
+		auto url = client->GetRequest()->GetParsedUri();
+
+		if ((url == nullptr) || (url->HasQueryString() == false))
+		{
+			return;
+		}
+
+		if (url->HasQueryKey("offset"))
+		{
+			_offset = ParseNumber(url, "offset");
+		}
+
+		if (url->HasQueryKey("limit"))
+		{
+			_limit = ParseNumber(url, "limit");
+		}
+
+		if (url->HasQueryKey("filter"))
+		{
+			auto filter = url->GetQueryValue("filter");
+
+			if (filter.IsEmpty() == false)
+			{
+				_filter = ov::Regex(ov::Regex::WildCardRegex(filter));
+
+				auto error = _filter.Compile();
+				if (error != nullptr)
+				{
+					throw http::HttpError(http::StatusCode::BadRequest, "Invalid filter: [%s] (%s)", filter.CStr(), error->What());
+				}
+
+				_has_filter = true;
+			}
+		}
+	}
+
+	bool ListQuery::Accept(const ov::String &name)
+	{
+		if (_has_filter && (_filter.Matches(name.CStr()).IsMatched() == false))
+		{
+			return false;
+		}
+
+		auto index = _total_count++;
+
+		return (index >= _offset) && ((_limit == 0) || (index < (_offset + _limit)));
+	}
+
+	void ListQuery::SetTotalCountHeader(const std::shared_ptr<http::svr::HttpExchange> &client) const
+	{
+		client->GetResponse()->SetHeader("X-Total-Count", ov::Converter::ToString(_total_count));
+	}
+}  // namespace api
@@ -0,0 +1,51 @@
+//==============================================================================
+//
+//  OvenMediaEngine
+//
+//  Created by Hyunjun Jang
+//  Copyright (c) 2022 AirenSoft. All rights reserved.
+//
+//==============================================================================
+#pragma once
+
+#include <modules/http/server/http_exchange.h>
+
+namespace api
+{
+	// Pagination/filter parameters of the list APIs
+	//
+	//   ?offset=<number>&limit=<number>&filter=<wildcard>
+	//
+	// - offset: Number of the matched items to skip (default: 0)
+	// - limit: Maximum number of items in the response (default: unlimited)
+	// - filter: Wildcard pattern of the name (e.g. "stream_*")
+	//
+	// The number of all matched items is sent in the X-Total-Count header.
+	class ListQuery
+	{
+	public:
+		MAY_THROWS(http::HttpError)
+		ListQuery(const std::shared_ptr<http::svr::HttpExchange> &client);
+
+		// Call this for each item in order, returns true if the item should be in the response
+		bool Accept(const ov::String &name);
+
+		size_t GetTotalCount() const
+		{
+			return _total_count;
+		}
+
+		void SetTotalCountHeader(const std::shared_ptr<http::svr::HttpExchange> &client) const;
+
+	protected:
+		size_t _offset = 0;
+		// 0 means unlimited
+		size_t _limit = 0;
+
+		bool _has_filter = false;
+		ov::Regex _filter;
+
+		// Number of items matched with the filter so far
+		size_t _total_count = 0;
+	};
+}  // namespace api
@@ -0,0 +1,159 @@
+//==============================================================================
+//
+//  OvenMediaEngine
+//
+//  Created by Hyunjun Jang
+//  Copyright (c) 2022 AirenSoft. All rights reserved.
+//
+//==============================================================================
+#include "./stats_snapshot.h"
+
+#include <modules/json_serdes/converters.h>
+#include <monitoring/monitoring.h>
+
+#include "../api_private.h"
+
+namespace api
+{
+	bool StatsSnapshot::Start(const cfg::mgr::api::StatsSnapshot &config)
+	{
+		_refresh_interval_msec = std::max(config.GetRefreshInterval(), 100);
+		// The timer must keep the snapshot fresh between two polls
+		_keep_alive_msec = std::max<int64_t>(config.GetKeepAliveTime(), _refresh_interval_msec);
+		_max_age_msec = std::max<int64_t>(config.GetMaxAge(), _refresh_interval_msec);
+
+		logtd("Stats snapshot: refresh interval: %" PRId64 "ms, keep-alive: %" PRId64 "ms, max age: %" PRId64 "ms",
+			  _refresh_interval_msec, _keep_alive_msec, _max_age_msec);
+
+		_timer.Push(
+			[this](void *parameter) -> ov::DelayQueueAction {
+				// Refresh only while someone is polling the stats
+				if ((ov::Time::GetMonotonicTimestamp() - _last_read_msec) <= _keep_alive_msec)
+				{
+					Refresh(0);
+				}
+
+				return ov::DelayQueueAction::Repeat;
+			},
+			_refresh_interval_msec);
+
+		return _timer.Start();
+	}
+
+	bool StatsSnapshot::Stop()
+	{
+		auto result = _timer.Stop();
+		_timer.Clear();
+
+		std::atomic_store(&_snapshot, std::shared_ptr<const Snapshot>());
+
+		return result;
+	}
+
+	std::shared_ptr<const StatsSnapshot::Snapshot> StatsSnapshot::GetSnapshot()
+	{
+		_last_read_msec = ov::Time::GetMonotonicTimestamp();
+
+		auto snapshot = std::atomic_load(&_snapshot);
+
+		// The timer keeps the snapshot fresh while it is polled, so it gets old only after an idle period
+		if ((snapshot == nullptr) || ((ov::Time::GetMonotonicTimestamp() - snapshot->created_msec) > _max_age_msec))
+		{
+			snapshot = Refresh(_max_age_msec);
+		}
+
+		return snapshot;
+	}
+
+	std::shared_ptr<const StatsSnapshot::Snapshot> StatsSnapshot::Rebuild(int64_t min_created_msec)
+	{
+		std::lock_guard<std::mutex> lock(_refresh_mutex);
+
+		// Another thread may have rebuilt the snapshot while waiting for the lock
+		auto snapshot = std::atomic_load(&_snapshot);
+
+		if ((snapshot != nullptr) && (snapshot->created_msec > min_created_msec))
+		{
+			return snapshot;
+		}
+
+		snapshot = Build();
+		std::atomic_store(&_snapshot, snapshot);
+
+		return snapshot;
+	}
+
+	std::shared_ptr<const StatsSnapshot::Snapshot> StatsSnapshot::Refresh(int64_t max_age_msec)
+	{
+		std::lock_guard<std::mutex> lock(_refresh_mutex);
+
+		// Another thread may have refreshed the snapshot while waiting for the lock
+		auto snapshot = std::atomic_load(&_snapshot);
+
+		if ((snapshot != nullptr) && (max_age_msec > 0) && ((ov::Time::GetMonotonicTimestamp() - snapshot->created_msec) <= max_age_msec))
+		{
+			return snapshot;
+		}
+
+		snapshot = Build();
+		std::atomic_store(&_snapshot, snapshot);
+
+		return snapshot;
+	}
+
+	std::shared_ptr<const StatsSnapshot::Snapshot> StatsSnapshot::Build() const
+	{
+		auto snapshot = std::make_shared<Snapshot>();
+		// Everything created before this time is included in the snapshot
+		snapshot->created_msec = ov::Time::GetMonotonicTimestamp();
+
+		auto monitoring = mon::Monitoring::GetInstance();
+
+		// The writer is reused to avoid reallocating the buffer for each metrics
+		ov::JsonWriter writer(1024);
+
+		auto serialize = [&writer](const std::shared_ptr<const mon::CommonMetrics> &metrics) -> ov::String {
+			writer.Clear();
+			::serdes::WriteMetrics(writer, metrics);
+			return writer.GetString();
+		};
+
+		snapshot->server_json = serialize(monitoring->GetServerMetrics());
+
+		size_t stream_count = 0;
+
+		for (const auto &vhost_item : monitoring->GetHostMetricsList())
+		{
+			const auto &vhost_metrics = vhost_item.second;
+			auto &vhost = snapshot->vhost_map[vhost_metrics->GetName()];
+
+			vhost.json = serialize(vhost_metrics);
+
+			for (const auto &app_item : vhost_metrics->GetApplicationMetricsList())
+			{
+				const auto &app_metrics = app_item.second;
+				auto &app = vhost.app_map[app_metrics->GetName().GetAppName()];
+
+				app.json = serialize(app_metrics);
+
+				for (const auto &stream_item : app_metrics->GetStreamMetricsMap())
+				{
+					const auto &stream_metrics = stream_item.second;
+
+					// Only input streams are provided by the stats API
+					if (stream_metrics->GetLinkedInputStream() != nullptr)
+					{
+						continue;
+					}
+
+					app.stream_map[stream_metrics->GetName()] = serialize(stream_metrics);
+					stream_count++;
+				}
+			}
+		}
+
+		logtd("Stats snapshot is built: %zu vhosts, %zu streams", snapshot->vhost_map.size(), stream_count);
+
+		return snapshot;
+	}
+}  // namespace api
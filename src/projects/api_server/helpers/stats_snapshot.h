@@ -0,0 +1,85 @@
+//==============================================================================
+//
+//  OvenMediaEngine
+//
+//  Created by Hyunjun Jang
+//  Copyright (c) 2022 AirenSoft. All rights reserved.
+//
+//==============================================================================
+#pragma once
+
+#include <base/ovlibrary/ovlibrary.h>
+#include <config/config.h>
+
+#include <map>
+
+#define API_STATS_SNAPSHOT_REFRESH_INTERVAL_MSEC 1000
+#define API_STATS_SNAPSHOT_KEEP_ALIVE_MSEC 60000
+#define API_STATS_SNAPSHOT_MAX_AGE_MSEC 5000
+
+namespace api
+{
+	// Serialized metrics of the server, virtual hosts, applications and (input) streams
+	//
+	// The snapshot is rebuilt periodically by a timer, so the stats APIs never traverse the live metrics
+	// (and never take their locks) while handling a request. Each metrics is serialized once per refresh
+	// regardless of the number of requests.
+	//
+	// To avoid the refresh cost while no one is polling, the timer stops refreshing when the snapshot
+	// was not read for the keep-alive time. A snapshot older than the max age is rebuilt on demand.
+	class StatsSnapshot
+	{
+	public:
+		struct Application
+		{
+			ov::String json;
+			// stream name : json
+			std::map<ov::String, ov::String> stream_map;
+		};
+
+		struct VirtualHost
+		{
+			ov::String json;
+			// app name : application
+			std::map<ov::String, Application> app_map;
+		};
+
+		struct Snapshot
+		{
+			// The time the build was started (monotonic)
+		int64_t created_msec = 0;
+
+			ov::String server_json;
+			// vhost name : virtual host
+			std::map<ov::String, VirtualHost> vhost_map;
+		};
+
+		bool Start(const cfg::mgr::api::StatsSnapshot &config);
+		bool Stop();
+
+		// Returns the latest snapshot (never returns nullptr)
+		std::shared_ptr<const Snapshot> GetSnapshot();
+
+		// Rebuilds the snapshot unless its build was started after min_created_msec (monotonic),
+		// so the items created after the current snapshot can be found
+		std::shared_ptr<const Snapshot> Rebuild(int64_t min_created_msec);
+
+	protected:
+		// Rebuilds the snapshot if it is older than max_age_msec (0: always)
+		std::shared_ptr<const Snapshot> Refresh(int64_t max_age_msec);
+		std::shared_ptr<const Snapshot> Build() const;
+
+		int64_t _refresh_interval_msec = API_STATS_SNAPSHOT_REFRESH_INTERVAL_MSEC;
+		int64_t _keep_alive_msec = API_STATS_SNAPSHOT_KEEP_ALIVE_MSEC;
+		int64_t _max_age_msec = API_STATS_SNAPSHOT_MAX_AGE_MSEC;
+
+		ov::DelayQueue _timer{"APIStats"};
+
+		// Prevents building the snapshot in multiple threads at the same time
+		std::mutex _refresh_mutex;
+		// Must be accessed by std::atomic_load()/std::atomic_store()
+		std::shared_ptr<const Snapshot> _snapshot;
+		// The time the snapshot was last read (monotonic)
+		std::atomic<int64_t> _last_read_msec{0};
+	};
+}  // namespace api
@@ -16,7 +16,7 @@ namespace info
 	Application::Application(const info::Host &host_info, application_id_t app_id, const VHostAppName &name, cfg::vhost::app::Application app_config, bool is_dynamic_app)
 		: _application_id(app_id),
 		  _name(name),
-		  _app_config(std::move(app_config)),
+		  _app_config(std::make_shared<const cfg::vhost::app::Application>(std::move(app_config))),
 		  _is_dynamic_app(is_dynamic_app)
 	{
 		_host_info = std::make_shared<info::Host>(host_info);
@@ -25,6 +25,7 @@ namespace info
 	Application::Application(const info::Host &host_info, application_id_t app_id, const VHostAppName &name, bool is_dynamic_app)
 		: _application_id(app_id),
 		  _name(name),
+		  _app_config(std::make_shared<const cfg::vhost::app::Application>()),
 		  _is_dynamic_app(is_dynamic_app)
 
 	{
@@ -77,14 +78,14 @@ namespace info
 		return *_host_info;
 	}
 
-	const cfg::vhost::app::Application &Application::GetConfig() const
+	std::shared_ptr<const cfg::vhost::app::Application> Application::GetConfig() const
 	{
-		return _app_config;
+		return std::atomic_load(&_app_config);
 	}
 
-	cfg::vhost::app::Application &Application::GetConfig()
+	void Application::SetConfig(const std::shared_ptr<const cfg::vhost::app::Application> &app_config)
 	{
-		return _app_config;
+		std::atomic_store(&_app_config, app_config);
 	}
 
 	bool Application::IsDynamicApp() const
@@ -46,41 +46,49 @@ namespace info
 		const Host &GetHostInfo() const;
 		bool IsDynamicApp() const;
 
+		// The returned publisher configuration shares the ownership of the application configuration,
+		// so it remains valid even if the application configuration is replaced
 		template <typename Tpublisher>
-		const Tpublisher *GetPublisherCfg() const
+		std::shared_ptr<const Tpublisher> GetPublisherCfg() const
 		{
 			Tpublisher temp_publisher;
-			const auto &publishers = _app_config.GetPublishers().GetPublisherList();
+			auto config = GetConfig();
 
-			for (auto &publisher_info : publishers)
+			for (auto &publisher_info : config->GetPublishers().GetPublisherList())
 			{
 				if (temp_publisher.GetType() == publisher_info->GetType())
 				{
-					return dynamic_cast<const Tpublisher *>(publisher_info);
+					auto publisher_cfg = dynamic_cast<const Tpublisher *>(publisher_info);
+					return (publisher_cfg != nullptr) ? std::shared_ptr<const Tpublisher>(config, publisher_cfg) : nullptr;
 				}
 			}
 
 			return nullptr;
 		}
 
+		// The returned provider configuration shares the ownership of the application configuration,
+		// so it remains valid even if the application configuration is replaced
 		template <typename Tprovider>
-		const Tprovider *GetProviderCfg() const
+		std::shared_ptr<const Tprovider> GetProviderCfg() const
 		{
 			Tprovider temp_provider;
-			const auto &providers = _app_config.GetProviders().GetProviderList();
+			auto config = GetConfig();
 
-			for (auto &provider_info : providers)
+			for (auto &provider_info : config->GetProviders().GetProviderList())
 			{
 				if (temp_provider.GetType() == provider_info->GetType())
 				{
-					return dynamic_cast<const Tprovider *>(provider_info);
+					auto provider_cfg = dynamic_cast<const Tprovider *>(provider_info);
+					return (provider_cfg != nullptr) ? std::shared_ptr<const Tprovider>(config, provider_cfg) : nullptr;
 				}
 			}
 
 			return nullptr;
 		}
-		const cfg::vhost::app::Application &GetConfig() const;
-		cfg::vhost::app::Application &GetConfig();
+		// The configuration is immutable. When the application is updated, a new configuration is published
+		// (SetConfig()), and the configuration returned before remains valid while it is held.
+		// Hold the returned pointer while using references into it (e.g. a range-for over GetOutputProfileList()).
+		std::shared_ptr<const cfg::vhost::app::Application> GetConfig() const;
 
 		// Get number of Audio Map Item
 		size_t GetAudioMapItemCount() const;
@@ -100,11 +108,14 @@ namespace info
 		// This function is created to minimize the creation of temporary instances
 		static const Application &GetInvalidApplication();
 
+		void SetConfig(const std::shared_ptr<const cfg::vhost::app::Application> &app_config);
+
 		application_id_t _application_id = InvalidApplicationId;
 		VHostAppName _name;
 		ov::String _app_type_name;
 
-		cfg::vhost::app::Application _app_config;
+		// Accessed with std::atomic_load()/std::atomic_store() since it can be replaced while the API threads read it
+		std::shared_ptr<const cfg::vhost::app::Application> _app_config;
 
 		// This flag determines whether the application was created in config or dynamically generated by PullStream()
 		bool _is_dynamic_app = false;
@@ -12,7 +12,9 @@
 #include <base/common_types.h>
 
 #include <cstdint>
+#include <functional>
 #include <map>
+#include <mutex>
 
 #include "media_type.h"
 
@@ -110,6 +112,22 @@ public:
 		}
 	}
 
+	// The bitstream views are not copied, since the data of the copied packet is usually replaced
+	explicit MediaPacket(const MediaPacket &src)
+		: _msid(src._msid),
+		  _media_type(src._media_type),
+		  _track_id(src._track_id),
+		  _data(src._data),
+		  _pts(src._pts),
+		  _dts(src._dts),
+		  _duration(src._duration),
+		  _flag(src._flag),
+		  _bitstream_format(src._bitstream_format),
+		  _packet_type(src._packet_type),
+		  _frag_hdr(src._frag_hdr)
+	{
+	}
+
 	cmn::MediaType GetMediaType() const noexcept
 	{
 		return _media_type;
@@ -118,6 +136,9 @@ public:
 	void SetData(std::shared_ptr<ov::Data> &data)
 	{
 		_data = data;
+
+		std::lock_guard<std::mutex> lock_guard(_bitstream_view_mutex);
+		_bitstream_views.clear();
 	}
 
 	const std::shared_ptr<const ov::Data> GetData() const noexcept
@@ -248,6 +269,42 @@ public:
 		return packet;
 	}
 
+	using BitstreamConverter = std::function<std::shared_ptr<ov::Data>(const std::shared_ptr<const ov::Data> &data)>;
+
+	// Returns the packet converted to another bitstream format (e.g. H264_ANNEXB -> H264_AVCC).
+	//
+	// A packet from the MediaRouter is shared by all publishers/writers, so the converted packet is cached in this packet
+	// and the conversion is done at most once no matter how many consumers request the same format.
+	// The converter is called while the lock is held, so the other consumers wait for the result instead of converting it again.
+	// The data of this packet MUST NOT be modified after the view is created (SetData() discards the views).
+	//
+	// Returns nullptr if the converter fails.
+	std::shared_ptr<const MediaPacket> GetBitstreamView(cmn::BitstreamFormat bitstream_format, cmn::PacketType packet_type, const BitstreamConverter &converter) const
+	{
+		std::lock_guard<std::mutex> lock_guard(_bitstream_view_mutex);
+
+		auto view_item = _bitstream_views.find(bitstream_format);
+		if (view_item != _bitstream_views.end())
+		{
+			return view_item->second;
+		}
+
+		auto converted_data = converter(_data);
+		if (converted_data == nullptr)
+		{
+			return nullptr;
+		}
+
+		auto view = std::make_shared<MediaPacket>(*this);
+		view->_data = converted_data;
+		view->_bitstream_format = bitstream_format;
+		view->_packet_type = packet_type;
+
+		_bitstream_views.emplace(bitstream_format, view);
+
+		return view;
+	}
+
 	ov::String GetInfoString() {
 		ov::String info;
 
@@ -278,5 +335,9 @@ protected:
 	cmn::BitstreamFormat _bitstream_format = cmn::BitstreamFormat::Unknown;
 	cmn::PacketType _packet_type = cmn::PacketType::Unknown;
 	FragmentationHeader _frag_hdr;
+
+	// Cached packets converted to other bitstream formats
+	mutable std::mutex _bitstream_view_mutex;
+	mutable std::map<cmn::BitstreamFormat, std::shared_ptr<const MediaPacket>> _bitstream_views;
 };
 
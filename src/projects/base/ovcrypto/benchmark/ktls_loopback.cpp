@@ -0,0 +1,547 @@
+//==============================================================================
+//
+//  OvenMediaEngine
+//
+//  Created by Hyunjun Jang
+//  Copyright (c) 2022 AirenSoft. All rights reserved.
+//
+//==============================================================================
+//
+// Standalone loopback test of the kTLS offload of ov::TlsServerData (TX only).
+// It is not a part of the OME build. Build and run it from src/projects:
+//
+//   g++ -std=c++17 -O2 -ffunction-sections -fdata-sections -Wl,--gc-sections -I. -Ithird_party \
+//       base/ovcrypto/benchmark/ktls_loopback.cpp base/ovcrypto/*.cpp base/ovcrypto/openssl/*.cpp base/ovlibrary/*.cpp \
+//       -o /tmp/ktls_loopback -lpthread -lssl -lcrypto -lz -lpcre2-8 && /tmp/ktls_loopback -v 1.3
+//
+// The server side runs the same steps as HttpsServer: PrepareKtls() -> handshake with Decrypt() -> OffloadToKernel().
+// After the handshake, the server sends a known byte pattern, and the client (plain OpenSSL) checks every byte,
+// so a wrong key, IV or record sequence number derived by ov::Tls shows up as a decryption failure.
+//
+// Modes (-m):
+//   - kernel  : installs TCP_ULP "tls" + TLS_TX, and write()s plain data to the socket
+//   - emulate : encrypts the records in the user space with the derived crypto info in the same way as the kernel,
+//               which verifies the derivation on hosts without the "tls" kernel module
+//   - openssl : does not offload (baseline, encrypted by OpenSSL)
+//   - auto    : kernel if the "tls" kernel module is available, otherwise emulate (default)
+//
+#include <base/ovcrypto/ovcrypto.h>
+#include <base/ovcrypto/openssl/tls_server_data.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <openssl/evp.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <chrono>
+#include <thread>
+
+#define KTLS_LOOPBACK_DEFAULT_SIZE_MB 256
+#define KTLS_LOOPBACK_WRITE_SIZE (256 * 1024)
+#define KTLS_LOOPBACK_MAX_RECORD_SIZE (16 * 1024)
+
+#ifndef SOL_TLS
+#	define SOL_TLS 282
+#endif
+
+#ifndef TCP_ULP
+#	define TCP_ULP 31
+#endif
+
+namespace
+{
+	enum class Mode
+	{
+		Auto,
+		Kernel,
+		Emulate,
+		OpenSsl
+	};
+
+	const char *StringFromMode(Mode mode)
+	{
+		switch (mode)
+		{
+			case Mode::Auto:
+				return "auto";
+			case Mode::Kernel:
+				return "kernel";
+			case Mode::Emulate:
+				return "emulate";
+			case Mode::OpenSsl:
+				return "openssl";
+		}
+
+		return "unknown";
+	}
+
+	inline uint8_t PatternAt(uint64_t offset)
+	{
+		return static_cast<uint8_t>(offset % 251);
+	}
+
+	bool SendAll(int fd, const void *data, size_t length)
+	{
+		auto buffer = static_cast<const uint8_t *>(data);
+
+		while (length > 0)
+		{
+			auto sent = ::send(fd, buffer, length, MSG_NOSIGNAL);
+
+			if (sent < 0)
+			{
+				if (errno == EINTR)
+				{
+					continue;
+				}
+
+				printf("send() failed: %s\n", ::strerror(errno));
+				return false;
+			}
+
+			buffer += sent;
+			length -= sent;
+		}
+
+		return true;
+	}
+
+	// Builds TLS records from the crypto info passed to TLS_TX, in the same way as net/tls of the kernel
+	class RecordEncryptor
+	{
+	public:
+		~RecordEncryptor()
+		{
+			::EVP_CIPHER_CTX_free(_context);
+			::OPENSSL_cleanse(&_info, sizeof(_info));
+		}
+
+		void Initialize(const ov::KtlsTxInfo &info)
+		{
+			_info = info;
+			_context = ::EVP_CIPHER_CTX_new();
+		}
+
+		bool Seal(const uint8_t *data, size_t length, std::vector<uint8_t> *record)
+		{
+			auto &info = _info.crypto_info;
+			bool is_tls13 = (info.info.version == TLS_1_3_VERSION);
+			bool is_aes_128 = (info.info.cipher_type == TLS_CIPHER_AES_GCM_128);
+
+			const uint8_t *key = is_aes_128 ? info.aes_gcm_128.key : info.aes_gcm_256.key;
+			uint8_t *salt = is_aes_128 ? info.aes_gcm_128.salt : info.aes_gcm_256.salt;
+			uint8_t *iv = is_aes_128 ? info.aes_gcm_128.iv : info.aes_gcm_256.iv;
+			uint8_t *rec_seq = is_aes_128 ? info.aes_gcm_128.rec_seq : info.aes_gcm_256.rec_seq;
+
+			// TLS 1.2: salt + explicit nonce(iv), TLS 1.3: (salt + iv) XOR sequence number
+			uint8_t nonce[TLS_CIPHER_AES_GCM_128_SALT_SIZE + TLS_CIPHER_AES_GCM_128_IV_SIZE];
+			::memcpy(nonce, salt, TLS_CIPHER_AES_GCM_128_SALT_SIZE);
+			::memcpy(nonce + TLS_CIPHER_AES_GCM_128_SALT_SIZE, iv, TLS_CIPHER_AES_GCM_128_IV_SIZE);
+
+			if (is_tls13)
+			{
+				for (int index = 0; index < TLS_CIPHER_AES_GCM_128_REC_SEQ_SIZE; index++)
+				{
+					nonce[TLS_CIPHER_AES_GCM_128_SALT_SIZE + index] ^= rec_seq[index];
+				}
+			}
+
+			// TLS 1.3 appends the inner content type to the plaintext
+			size_t plain_length = length + (is_tls13 ? 1 : 0);
+			size_t explicit_nonce_length = is_tls13 ? 0 : TLS_CIPHER_AES_GCM_128_IV_SIZE;
+			size_t payload_length = explicit_nonce_length + plain_length + TLS_CIPHER_AES_GCM_128_TAG_SIZE;
+
+			size_t offset = record->size();
+			record->resize(offset + 5 + payload_length);
+			auto header = record->data() + offset;
+
+			header[0] = SSL3_RT_APPLICATION_DATA;
+			header[1] = 0x03;
+			header[2] = 0x03;
+			header[3] = static_cast<uint8_t>(payload_length >> 8);
+			header[4] = static_cast<uint8_t>(payload_length & 0xFF);
+
+			// TLS 1.2: seq_num + type + version + length(plaintext), TLS 1.3: record header
+			uint8_t aad[13];
+			size_t aad_length = 5;
+
+			if (is_tls13)
+			{
+				::memcpy(aad, header, 5);
+			}
+			else
+			{
+				::memcpy(aad, rec_seq, 8);
+				aad[8] = header[0];
+				aad[9] = header[1];
+				aad[10] = header[2];
+				aad[11] = static_cast<uint8_t>(length >> 8);
+				aad[12] = static_cast<uint8_t>(length & 0xFF);
+				aad_length = 13;
+
+				::memcpy(header + 5, iv, TLS_CIPHER_AES_GCM_128_IV_SIZE);
+			}
+
+			auto cipher_text = header + 5 + explicit_nonce_length;
+			int output_length = 0;
+
+			bool result =
+				(::EVP_EncryptInit_ex(_context, is_aes_128 ? ::EVP_aes_128_gcm() : ::EVP_aes_256_gcm(), nullptr, key, nonce) == 1) &&
+				(::EVP_EncryptUpdate(_context, nullptr, &output_length, aad, aad_length) == 1) &&
+				(::EVP_EncryptUpdate(_context, cipher_text, &output_length, data, length) == 1);
+
+			if (result && is_tls13)
+			{
+				uint8_t content_type = SSL3_RT_APPLICATION_DATA;
+				result = (::EVP_EncryptUpdate(_context, cipher_text + length, &output_length, &content_type, 1) == 1);
+			}
+
+			result = result &&
+					 (::EVP_EncryptFinal_ex(_context, cipher_text + plain_length, &output_length) == 1) &&
+					 (::EVP_CIPHER_CTX_ctrl(_context, EVP_CTRL_GCM_GET_TAG, TLS_CIPHER_AES_GCM_128_TAG_SIZE, cipher_text + plain_length) == 1);
+
+			Increase(rec_seq);
+
+			if (is_tls13 == false)
+			{
+				// The kernel advances the explicit nonce with the sequence number
+				Increase(iv);
+			}
+
+			return result;
+		}
+
+	protected:
+		static void Increase(uint8_t *big_endian_number)
+		{
+			for (int index = 7; index >= 0; index--)
+			{
+				if (++big_endian_number[index] != 0)
+				{
+					break;
+				}
+			}
+		}
+
+		ov::KtlsTxInfo _info;
+		EVP_CIPHER_CTX *_context = nullptr;
+	};
+
+	struct Options
+	{
+		Mode mode = Mode::Auto;
+		int tls_version = TLS1_3_VERSION;
+		bool aes_256 = false;
+		uint64_t total_bytes = static_cast<uint64_t>(KTLS_LOOPBACK_DEFAULT_SIZE_MB) * 1024 * 1024;
+	};
+
+	// Plain OpenSSL client: receives and verifies the pattern
+	void RunClient(const Options &options, uint16_t port, bool *succeeded, double *elapsed_seconds)
+	{
+		*succeeded = false;
+
+		int fd = ::socket(AF_INET, SOCK_STREAM, 0);
+		sockaddr_in address{};
+		address.sin_family = AF_INET;
+		address.sin_port = htons(port);
+		address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+
+		if (::connect(fd, reinterpret_cast<sockaddr *>(&address), sizeof(address)) != 0)
+		{
+			printf("[Client] connect() failed: %s\n", ::strerror(errno));
+			::close(fd);
+			return;
+		}
+
+		auto context = ::SSL_CTX_new(::TLS_client_method());
+		::SSL_CTX_set_min_proto_version(context, options.tls_version);
+		::SSL_CTX_set_max_proto_version(context, options.tls_version);
+
+		if (options.tls_version == TLS1_3_VERSION)
+		{
+			::SSL_CTX_set_ciphersuites(context, options.aes_256 ? "TLS_AES_256_GCM_SHA384" : "TLS_AES_128_GCM_SHA256");
+		}
+		else
+		{
+			::SSL_CTX_set_cipher_list(context, options.aes_256 ? "ECDHE-ECDSA-AES256-GCM-SHA384" : "ECDHE-ECDSA-AES128-GCM-SHA256");
+		}
+
+		auto ssl = ::SSL_new(context);
+		::SSL_set_fd(ssl, fd);
+
+		if (::SSL_connect(ssl) != 1)
+		{
+			printf("[Client] SSL_connect() failed: %s\n", ov::OpensslError().What());
+		}
+		else
+		{
+			std::vector<uint8_t> buffer(KTLS_LOOPBACK_MAX_RECORD_SIZE * 4);
+			uint64_t received_bytes = 0;
+			auto start = std::chrono::steady_clock::now();
+
+			while (received_bytes < options.total_bytes)
+			{
+				int read_bytes = ::SSL_read(ssl, buffer.data(), buffer.size());
+
+				if (read_bytes <= 0)
+				{
+					printf("[Client] SSL_read() failed after %" PRIu64 " bytes: %s\n", received_bytes, ov::OpensslError().What());
+					break;
+				}
+
+				for (int index = 0; index < read_bytes; index++)
+				{
+					if (buffer[index] != PatternAt(received_bytes + index))
+					{
+						printf("[Client] Data mismatch at offset %" PRIu64 "\n", received_bytes + index);
+						read_bytes = -1;
+						break;
+					}
+				}
+
+				if (read_bytes < 0)
+				{
+					break;
+				}
+
+				received_bytes += read_bytes;
+			}
+
+			*elapsed_seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+			*succeeded = (received_bytes == options.total_bytes);
+		}
+
+		::SSL_free(ssl);
+		::SSL_CTX_free(context);
+		::close(fd);
+	}
+
+	bool RunServer(const Options &options, int listen_fd, const std::shared_ptr<ov::TlsContext> &tls_context)
+	{
+		int fd = ::accept(listen_fd, nullptr, nullptr);
+
+		if (fd < 0)
+		{
+			printf("[Server] accept() failed: %s\n", ::strerror(errno));
+			return false;
+		}
+
+		auto tls_data = std::make_shared<ov::TlsServerData>(tls_context, false);
+		tls_data->SetWriteCallback([fd](const void *data, int64_t length) -> ssize_t {
+			return SendAll(fd, data, length) ? length : -1L;
+		});
+
+		if (options.mode != Mode::OpenSsl)
+		{
+			tls_data->PrepareKtls();
+		}
+
+		// Handshake
+		std::vector<uint8_t> buffer(KTLS_LOOPBACK_MAX_RECORD_SIZE);
+
+		while (tls_data->GetState() == ov::TlsServerData::State::WaitingForAccept)
+		{
+			auto read_bytes = ::recv(fd, buffer.data(), buffer.size(), 0);
+
+			if ((read_bytes <= 0) || (tls_data->Decrypt(std::make_shared<ov::Data>(buffer.data(), read_bytes), nullptr) == false))
+			{
+				printf("[Server] Handshake failed\n");
+				::close(fd);
+				return false;
+			}
+		}
+
+		auto mode = options.mode;
+		RecordEncryptor encryptor;
+
+		if (mode != Mode::OpenSsl)
+		{
+			tls_data->OffloadToKernel([&](const ov::KtlsTxInfo &info, ov::String *reason) -> bool {
+				if (mode != Mode::Emulate)
+				{
+					if (::setsockopt(fd, IPPROTO_TCP, TCP_ULP, "tls", sizeof("tls")) == 0)
+					{
+						if (::setsockopt(fd, SOL_TLS, TLS_TX, &info.crypto_info, info.length) == 0)
+						{
+							mode = Mode::Kernel;
+							return true;
+						}
+					}
+
+					*reason = ov::Error::CreateErrorFromErrno()->What();
+
+					if ((mode == Mode::Kernel) || (errno != ENOENT))
+					{
+						return false;
+					}
+
+					printf("[Server] The \"tls\" kernel module is not available, the records are encrypted in the user space (%s)\n", reason->CStr());
+				}
+
+				mode = Mode::Emulate;
+				encryptor.Initialize(info);
+
+				return true;
+			});
+
+			if (tls_data->IsKtlsOffloaded() == false)
+			{
+				printf("[Server] Could not offload: %s\n", tls_data->GetKtlsFallbackReason().CStr());
+				::close(fd);
+				return false;
+			}
+		}
+
+		printf("[Server] %s, AES-%d-GCM, mode: %s\n",
+			   (options.tls_version == TLS1_3_VERSION) ? "TLS 1.3" : "TLS 1.2", options.aes_256 ? 256 : 128,
+			   StringFromMode(mode));
+
+		// Send the pattern
+		bool result = true;
+		std::vector<uint8_t> plain(KTLS_LOOPBACK_WRITE_SIZE);
+		std::vector<uint8_t> records;
+		uint64_t sent_bytes = 0;
+
+		while (result && (sent_bytes < options.total_bytes))
+		{
+			auto length = static_cast<size_t>(std::min<uint64_t>(plain.size(), options.total_bytes - sent_bytes));
+
+			for (size_t index = 0; index < length; index++)
+			{
+				plain[index] = PatternAt(sent_bytes + index);
+			}
+
+			std::shared_ptr<const ov::Data> data;
+			result = tls_data->Encrypt(std::make_shared<ov::Data>(plain.data(), length, true), &data);
+
+			if (result == false)
+			{
+				printf("[Server] Could not encrypt the data\n");
+				break;
+			}
+
+			if (mode == Mode::Emulate)
+			{
+				records.clear();
+
+				for (size_t offset = 0; result && (offset < data->GetLength()); offset += KTLS_LOOPBACK_MAX_RECORD_SIZE)
+				{
+					result = encryptor.Seal(data->GetDataAs<uint8_t>() + offset, std::min<size_t>(KTLS_LOOPBACK_MAX_RECORD_SIZE, data->GetLength() - offset), &records);
+				}
+
+				result = result && SendAll(fd, records.data(), records.size());
+			}
+			else
+			{
+				result = SendAll(fd, data->GetData(), data->GetLength());
+			}
+
+			sent_bytes += length;
+		}
+
+		printf("[Server] Offloaded: %" PRIu64 " bytes, encrypted by OpenSSL: %" PRIu64 " bytes\n",
+			   tls_data->GetKtlsSentBytes(), tls_data->GetEncryptedBytes());
+
+		::shutdown(fd, SHUT_WR);
+		// Waits for the client to close the connection, so that the data is not discarded
+		while (::recv(fd, buffer.data(), buffer.size(), 0) > 0)
+		{
+		}
+		::close(fd);
+
+		return result;
+	}
+}  // namespace
+
+int main(int argc, char *argv[])
+{
+	Options options;
+
+	for (int index = 1; index < argc; index++)
+	{
+		ov::String option = argv[index];
+		ov::String value = ((index + 1) < argc) ? argv[index + 1] : "";
+
+		if (option == "-m")
+		{
+			options.mode = (value == "kernel") ? Mode::Kernel : (value == "emulate") ? Mode::Emulate
+															  : (value == "openssl") ? Mode::OpenSsl
+																					 : Mode::Auto;
+		}
+		else if (option == "-v")
+		{
+			options.tls_version = (value == "1.2") ? TLS1_2_VERSION : TLS1_3_VERSION;
+		}
+		else if (option == "-c")
+		{
+			options.aes_256 = (value == "256");
+		}
+		else if (option == "-s")
+		{
+			options.total_bytes = static_cast<uint64_t>(std::max(1, ::atoi(value.CStr()))) * 1024 * 1024;
+		}
+		else
+		{
+			printf("Usage: %s [-m auto|kernel|emulate|openssl] [-v 1.2|1.3] [-c 128|256] [-s <MB>]\n", argv[0]);
+			return 1;
+		}
+
+		index++;
+	}
+
+	ov_log_set_level(OVLogLevelWarning);
+
+	auto certificate = std::make_shared<Certificate>();
+	if (certificate->Generate() != nullptr)
+	{
+		printf("Could not generate a certificate\n");
+		return 1;
+	}
+
+	// TlsContext allows TLS 1.3 only when HTTP/2 is enabled
+	ov::TlsContextCallback tls_context_callback;
+	std::shared_ptr<const ov::Error> error;
+	auto tls_context = ov::TlsContext::CreateServerContext(
+		ov::TlsMethod::Tls, CertificatePair::CreateCertificatePair(certificate),
+		"ECDHE-ECDSA-AES128-GCM-SHA256:ECDHE-ECDSA-AES256-GCM-SHA384", (options.tls_version == TLS1_3_VERSION), &tls_context_callback, &error);
+
+	if (tls_context == nullptr)
+	{
+		printf("Could not create a TLS context: %s\n", (error != nullptr) ? error->What() : "Unknown error");
+		return 1;
+	}
+
+	int listen_fd = ::socket(AF_INET, SOCK_STREAM, 0);
+	sockaddr_in address{};
+	address.sin_family = AF_INET;
+	address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+	socklen_t address_length = sizeof(address);
+
+	if ((::bind(listen_fd, reinterpret_cast<sockaddr *>(&address), sizeof(address)) != 0) ||
+		(::listen(listen_fd, 1) != 0) ||
+		(::getsockname(listen_fd, reinterpret_cast<sockaddr *>(&address), &address_length) != 0))
+	{
+		printf("Could not listen: %s\n", ::strerror(errno));
+		return 1;
+	}
+
+	bool client_succeeded = false;
+	double elapsed_seconds = 0.0;
+	std::thread client_thread(RunClient, std::cref(options), ntohs(address.sin_port), &client_succeeded, &elapsed_seconds);
+
+	bool server_succeeded = RunServer(options, listen_fd, tls_context);
+
+	client_thread.join();
+	::close(listen_fd);
+
+	if ((server_succeeded && client_succeeded) == false)
+	{
+		printf("FAILED\n");
+		return 1;
+	}
+
+	printf("OK: %" PRIu64 " bytes in %.3f seconds (%.1f MB/s)\n",
+		   options.total_bytes, elapsed_seconds, (options.total_bytes / (1024.0 * 1024.0)) / std::max(elapsed_seconds, 0.000001));
+
+	return 0;
+}
@@ -8,6 +8,9 @@
 //==============================================================================
 #include "tls.h"
 
+#include <openssl/core_names.h>
+#include <openssl/kdf.h>
+
 #include <utility>
 
 #include "./openssl_manager.h"
@@ -138,6 +141,7 @@ namespace ov
 		}
 
 		// Setup the session
+		SSL_set_app_data(ssl, this);
 		::SSL_set_bio(ssl, _bio, _bio);
 		::SSL_set_read_ahead(ssl, 1);
 		::SSL_set_mode(ssl, SSL_MODE_ENABLE_PARTIAL_WRITE | SSL_MODE_ACCEPT_MOVING_WRITE_BUFFER);
@@ -475,6 +479,13 @@ namespace ov
 
 		if (written_bytes > 0)
 		{
+			auto tls = static_cast<Tls *>(BIO_get_data(b));
+
+			if ((tls != nullptr) && tls->_ktls_tracker.enabled)
+			{
+				tls->TrackTxRecords(in, static_cast<size_t>(written_bytes));
+			}
+
 			return static_cast<int>(written_bytes);
 		}
 		else if (written_bytes == 0)
@@ -664,4 +675,311 @@ namespace ov
 		return (peer_certificate != nullptr) ? StringFromX509Name(::X509_get_issuer_name(peer_certificate)) : "";
 	}
 
+	void Tls::EnableKtlsTracking()
+	{
+		OV_ASSERT2(_ssl != nullptr);
+
+		_ktls_tracker = {};
+		_ktls_tracker.enabled = true;
+
+		// The kernel cannot follow the key changes caused by renegotiation
+		::SSL_set_options(_ssl, SSL_OP_NO_RENEGOTIATION);
+	}
+
+	void Tls::TrackTxRecords(const void *data, size_t length)
+	{
+		auto &tracker = _ktls_tracker;
+		auto buffer = static_cast<const uint8_t *>(data);
+		size_t position = 0;
+
+		while (position < length)
+		{
+			if (tracker.written_bytes < tracker.next_record_offset)
+			{
+				// Skip the payload of the record
+				auto bytes_to_skip = std::min(static_cast<uint64_t>(length - position), tracker.next_record_offset - tracker.written_bytes);
+
+				position += bytes_to_skip;
+				tracker.written_bytes += bytes_to_skip;
+				continue;
+			}
+
+			// ContentType(1) + ProtocolVersion(2) + Length(2)
+			auto header_position = tracker.written_bytes - tracker.next_record_offset;
+			tracker.header[header_position] = buffer[position];
+			position++;
+			tracker.written_bytes++;
+
+			if (header_position == (OV_COUNTOF(tracker.header) - 1))
+			{
+				tracker.records.emplace_back(tracker.next_record_offset, tracker.header[0]);
+				tracker.next_record_offset += OV_COUNTOF(tracker.header) + ((tracker.header[3] << 8) | tracker.header[4]);
+			}
+		}
+	}
+
+	void Tls::OnKeylog(const SSL *ssl, const char *line)
+	{
+		auto tls = static_cast<Tls *>(SSL_get_app_data(ssl));
+
+		if ((tls == nullptr) || (tls->_ktls_tracker.enabled == false))
+		{
+			return;
+		}
+
+		// <Label> <ClientRandom> <Secret>
+		auto tokens = ov::String(line).Split(" ");
+
+		if ((tokens.size() != 3) || (tokens[0] != "SERVER_TRAFFIC_SECRET_0"))
+		{
+			return;
+		}
+
+		long secret_length = 0;
+		auto secret = ::OPENSSL_hexstr2buf(tokens[2].CStr(), &secret_length);
+
+		if (secret == nullptr)
+		{
+			return;
+		}
+
+		auto &tracker = tls->_ktls_tracker;
+
+		tracker.server_traffic_secret.assign(secret, secret + secret_length);
+		OPENSSL_clear_free(secret, secret_length);
+
+		// The server Finished message may still be in the buffering BIO of OpenSSL.
+		// Records written after it are protected with the application traffic secret.
+		tracker.application_record_offset = tracker.written_bytes + BIO_wpending(::SSL_get_wbio(ssl));
+	}
+
+	// HKDF-Expand-Label(Secret, Label, "", Length) - RFC 8446 7.1
+	static bool HkdfExpandLabel(const EVP_MD *md, const std::vector<uint8_t> &secret, const char *label, uint8_t *output, size_t output_length)
+	{
+		ov::String full_label = ov::String::FormatString("tls13 %s", label);
+
+		std::vector<uint8_t> hkdf_label;
+		hkdf_label.push_back(static_cast<uint8_t>(output_length >> 8));
+		hkdf_label.push_back(static_cast<uint8_t>(output_length & 0xFF));
+		hkdf_label.push_back(static_cast<uint8_t>(full_label.GetLength()));
+		hkdf_label.insert(hkdf_label.end(), full_label.CStr(), full_label.CStr() + full_label.GetLength());
+		// Empty context
+		hkdf_label.push_back(0);
+
+		auto kdf = ::EVP_KDF_fetch(nullptr, OSSL_KDF_NAME_HKDF, nullptr);
+		auto kdf_context = (kdf != nullptr) ? ::EVP_KDF_CTX_new(kdf) : nullptr;
+		::EVP_KDF_free(kdf);
+
+		if (kdf_context == nullptr)
+		{
+			return false;
+		}
+
+		int mode = EVP_KDF_HKDF_MODE_EXPAND_ONLY;
+		OSSL_PARAM params[] = {
+			::OSSL_PARAM_construct_int(OSSL_KDF_PARAM_MODE, &mode),
+			::OSSL_PARAM_construct_utf8_string(OSSL_KDF_PARAM_DIGEST, const_cast<char *>(::EVP_MD_get0_name(md)), 0),
+			::OSSL_PARAM_construct_octet_string(OSSL_KDF_PARAM_KEY, const_cast<uint8_t *>(secret.data()), secret.size()),
+			::OSSL_PARAM_construct_octet_string(OSSL_KDF_PARAM_INFO, hkdf_label.data(), hkdf_label.size()),
+			::OSSL_PARAM_construct_end()};
+
+		bool result = (::EVP_KDF_derive(kdf_context, output, output_length, params) == 1);
+
+		::EVP_KDF_CTX_free(kdf_context);
+
+		return result;
+	}
+
+	// PRF(master_secret, "key expansion", server_random + client_random) - RFC 5246 6.3
+	static bool Tls12KeyExpansion(const EVP_MD *md, const uint8_t *master_secret, size_t master_secret_length, const uint8_t *seed, size_t seed_length, uint8_t *output, size_t output_length)
+	{
+		auto kdf = ::EVP_KDF_fetch(nullptr, OSSL_KDF_NAME_TLS1_PRF, nullptr);
+		auto kdf_context = (kdf != nullptr) ? ::EVP_KDF_CTX_new(kdf) : nullptr;
+		::EVP_KDF_free(kdf);
+
+		if (kdf_context == nullptr)
+		{
+			return false;
+		}
+
+		OSSL_PARAM params[] = {
+			::OSSL_PARAM_construct_utf8_string(OSSL_KDF_PARAM_DIGEST, const_cast<char *>(::EVP_MD_get0_name(md)), 0),
+			::OSSL_PARAM_construct_octet_string(OSSL_KDF_PARAM_SECRET, const_cast<uint8_t *>(master_secret), master_secret_length),
+			::OSSL_PARAM_construct_octet_string(OSSL_KDF_PARAM_SEED, const_cast<uint8_t *>(seed), seed_length),
+			::OSSL_PARAM_construct_end()};
+
+		bool result = (::EVP_KDF_derive(kdf_context, output, output_length, params) == 1);
+
+		::EVP_KDF_CTX_free(kdf_context);
+
+		return result;
+	}
+
+	bool Tls::GetKtlsTxInfo(KtlsTxInfo *info, ov::String *reason)
+	{
+		std::lock_guard lock(_ssl_lock);
+
+		auto fail = [&](const ov::String &message) -> bool {
+			if (reason != nullptr)
+			{
+				*reason = message;
+			}
+
+			// The handshake is completed, so there is nothing to track anymore
+			_ktls_tracker = {};
+
+			return false;
+		};
+
+		if ((_ssl == nullptr) || (_ktls_tracker.enabled == false))
+		{
+			return fail("kTLS tracking is not enabled");
+		}
+
+		auto cipher = ::SSL_get_current_cipher(_ssl);
+
+		if (cipher == nullptr)
+		{
+			return fail("Cipher is not negotiated");
+		}
+
+		size_t key_length = 0;
+
+		switch (::SSL_CIPHER_get_cipher_nid(cipher))
+		{
+			case NID_aes_128_gcm:
+				key_length = TLS_CIPHER_AES_GCM_128_KEY_SIZE;
+				break;
+
+			case NID_aes_256_gcm:
+				key_length = TLS_CIPHER_AES_GCM_256_KEY_SIZE;
+				break;
+
+			default:
+				return fail(ov::String::FormatString("Unsupported cipher: %s", ::SSL_CIPHER_get_name(cipher)));
+		}
+
+		auto md = ::SSL_CIPHER_get_handshake_digest(cipher);
+		auto version = ::SSL_version(_ssl);
+
+		// Both AES-GCM-128 and AES-GCM-256 use 4 bytes salt + 8 bytes IV
+		uint8_t key[TLS_CIPHER_AES_GCM_256_KEY_SIZE];
+		uint8_t salt[TLS_CIPHER_AES_GCM_128_SALT_SIZE];
+		uint8_t iv[TLS_CIPHER_AES_GCM_128_IV_SIZE];
+		uint64_t sequence_number = 0;
+
+		if (version == TLS1_3_VERSION)
+		{
+			if ((_ktls_tracker.server_traffic_secret.empty()) || (_ktls_tracker.application_record_offset < 0))
+			{
+				return fail("Could not obtain the server traffic secret");
+			}
+
+			uint8_t write_iv[sizeof(salt) + sizeof(iv)];
+
+			if ((HkdfExpandLabel(md, _ktls_tracker.server_traffic_secret, "key", key, key_length) == false) ||
+				(HkdfExpandLabel(md, _ktls_tracker.server_traffic_secret, "iv", write_iv, sizeof(write_iv)) == false))
+			{
+				return fail(ov::String::FormatString("Could not derive the traffic key: %s", OpensslError().What()));
+			}
+
+			::memcpy(salt, write_iv, sizeof(salt));
+			::memcpy(iv, write_iv + sizeof(salt), sizeof(iv));
+			::OPENSSL_cleanse(write_iv, sizeof(write_iv));
+
+			// NewSessionTicket, ...
+			for (auto &record : _ktls_tracker.records)
+			{
+				if (static_cast<int64_t>(record.first) >= _ktls_tracker.application_record_offset)
+				{
+					sequence_number++;
+				}
+			}
+		}
+		else if (version == TLS1_2_VERSION)
+		{
+			uint8_t master_secret[SSL_MAX_MASTER_KEY_LENGTH];
+			auto master_secret_length = ::SSL_SESSION_get_master_key(::SSL_get_session(_ssl), master_secret, sizeof(master_secret));
+
+			// "key expansion" + server_random + client_random
+			uint8_t seed[13 + SSL3_RANDOM_SIZE * 2];
+			::memcpy(seed, "key expansion", 13);
+			::SSL_get_server_random(_ssl, seed + 13, SSL3_RANDOM_SIZE);
+			::SSL_get_client_random(_ssl, seed + 13 + SSL3_RANDOM_SIZE, SSL3_RANDOM_SIZE);
+
+			// client_write_key + server_write_key + client_write_IV + server_write_IV (AEAD ciphers have no MAC key)
+			uint8_t key_block[(TLS_CIPHER_AES_GCM_256_KEY_SIZE + TLS_CIPHER_AES_GCM_128_SALT_SIZE) * 2];
+			auto key_block_length = (key_length + sizeof(salt)) * 2;
+
+			bool result = Tls12KeyExpansion(md, master_secret, master_secret_length, seed, sizeof(seed), key_block, key_block_length);
+			::OPENSSL_cleanse(master_secret, sizeof(master_secret));
+
+			if (result == false)
+			{
+				return fail(ov::String::FormatString("Could not derive the key block: %s", OpensslError().What()));
+			}
+
+			::memcpy(key, key_block + key_length, key_length);
+			::memcpy(salt, key_block + (key_length * 2) + sizeof(salt), sizeof(salt));
+			::OPENSSL_cleanse(key_block, sizeof(key_block));
+
+			// Records after ChangeCipherSpec are protected with the new key (Finished)
+			bool ccs_found = false;
+			for (auto &record : _ktls_tracker.records)
+			{
+				if (record.second == SSL3_RT_CHANGE_CIPHER_SPEC)
+				{
+					ccs_found = true;
+					sequence_number = 0;
+				}
+				else if (ccs_found)
+				{
+					sequence_number++;
+				}
+			}
+
+			if (ccs_found == false)
+			{
+				return fail("Could not find ChangeCipherSpec record");
+			}
+
+			// The sequence number is used as the explicit nonce
+			auto explicit_nonce = ov::HostToBE64(sequence_number);
+			::memcpy(iv, &explicit_nonce, sizeof(iv));
+		}
+		else
+		{
+			return fail(ov::String::FormatString("Unsupported TLS version: %s", ::SSL_get_version(_ssl)));
+		}
+
+		auto &crypto_info = info->crypto_info;
+		::memset(&crypto_info, 0, sizeof(crypto_info));
+
+		auto record_sequence = ov::HostToBE64(sequence_number);
+
+		auto fill_crypto_info = [&](auto &target, uint16_t cipher_type) {
+			target.info.version = (version == TLS1_3_VERSION) ? TLS_1_3_VERSION : TLS_1_2_VERSION;
+			target.info.cipher_type = cipher_type;
+			::memcpy(target.key, key, sizeof(target.key));
+			::memcpy(target.salt, salt, sizeof(target.salt));
+			::memcpy(target.iv, iv, sizeof(target.iv));
+			::memcpy(target.rec_seq, &record_sequence, sizeof(target.rec_seq));
+			info->length = sizeof(target);
+		};
+
+		if (key_length == TLS_CIPHER_AES_GCM_128_KEY_SIZE)
+		{
+			fill_crypto_info(crypto_info.aes_gcm_128, TLS_CIPHER_AES_GCM_128);
+		}
+		else
+		{
+			fill_crypto_info(crypto_info.aes_gcm_256, TLS_CIPHER_AES_GCM_256);
+		}
+
+		::OPENSSL_cleanse(key, sizeof(key));
+
+		_ktls_tracker = {};
+
+		return true;
+	}
 };	// namespace ov
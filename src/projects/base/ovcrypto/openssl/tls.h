@@ -8,11 +8,26 @@
 //==============================================================================
 #pragma once
 
+#include <linux/tls.h>
+
 #include "./tls_bio_callback.h"
 #include "./tls_context.h"
 
 namespace ov
 {
+	// Parameters to pass to setsockopt(SOL_TLS, TLS_TX)
+	struct KtlsTxInfo
+	{
+		union
+		{
+			tls_crypto_info info;
+			tls12_crypto_info_aes_gcm_128 aes_gcm_128;
+			tls12_crypto_info_aes_gcm_256 aes_gcm_256;
+		} crypto_info;
+
+		socklen_t length = 0;
+	};
+
 	class Tls
 	{
 	public:
@@ -64,6 +79,16 @@ namespace ov
 		ov::String GetSubjectName() const;
 		ov::String GetIssuerName() const;
 
+		// Starts tracking the records written during the handshake to get the sequence number for kTLS.
+		// Must be called before the handshake.
+		void EnableKtlsTracking();
+		// Derives the transmit key/IV/sequence number of the server after the handshake is completed.
+		// Only TLS 1.2/1.3 with AES-GCM is supported.
+		bool GetKtlsTxInfo(KtlsTxInfo *info, ov::String *reason);
+
+		// Called by OpenSSL when a secret is generated (registered to the server contexts)
+		static void OnKeylog(const SSL *ssl, const char *line);
+
 	protected:
 		static BIO_METHOD *PrepareBioMethod();
 		bool PrepareBio(const TlsBioCallback &callback);
@@ -98,6 +123,26 @@ namespace ov
 
 		int GetError(int code);
 
+		void TrackTxRecords(const void *data, size_t length);
+
+	protected:
+		struct KtlsTracker
+		{
+			bool enabled = false;
+
+			// Total bytes written by OpenSSL
+			uint64_t written_bytes = 0;
+			// Offset of the next record header
+			uint64_t next_record_offset = 0;
+			uint8_t header[5]{};
+			// Offset : Content type
+			std::vector<std::pair<uint64_t, uint8_t>> records;
+
+			// TLS 1.3 only - records at or after this offset are protected with the application traffic secret
+			int64_t application_record_offset = -1;
+			std::vector<uint8_t> server_traffic_secret;
+		};
+
 	protected:
 		bool _is_nonblocking = false;
 
@@ -109,5 +154,7 @@ namespace ov
 		TlsBioCallback _callback;
 
 		std::mutex _ssl_lock;
+
+		KtlsTracker _ktls_tracker;
 	};
 }  // namespace ov
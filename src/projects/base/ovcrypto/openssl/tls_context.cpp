@@ -177,6 +177,9 @@ namespace ov
 			// Use ALPN
 			SSL_CTX_set_alpn_select_cb(_ssl_ctx, OnALPNSelectCallback, this);
 
+			// To obtain the traffic secret for kTLS (ignored unless Tls::EnableKtlsTracking() is called)
+			::SSL_CTX_set_keylog_callback(_ssl_ctx, Tls::OnKeylog);
+
 		} while (false);
 	}
 
@@ -138,6 +138,12 @@ namespace ov
 			}
 		}
 
+		if (_ktls_desynchronized)
+		{
+			logtw("OpenSSL tried to send a record after kTLS is enabled (alert, KeyUpdate, ...), which cannot be sent");
+			return false;
+		}
+
 		if (plain_data != nullptr)
 		{
 			*plain_data = decrypted;
@@ -155,12 +161,22 @@ namespace ov
 			return false;
 		}
 
+		if (_ktls_state == KtlsState::Offloaded)
+		{
+			// The kernel will encrypt the data
+			*cipher_data = plain_data;
+			_ktls_sent_bytes += plain_data->GetLength();
+			return true;
+		}
+
 		logtd("Trying to encrypt the data for TLS\n%s", plain_data->Dump(32).CStr());
 
 		size_t written_bytes = 0;
 		auto result = _tls.Write(plain_data, &written_bytes);
 		if (result == SSL_ERROR_NONE)
 		{
+			_encrypted_bytes += plain_data->GetLength();
+
 			std::lock_guard lock_guard(_plain_data_mutex);
 			*cipher_data = std::move(_plain_data);
 			return true;
@@ -206,6 +222,68 @@ namespace ov
 		return _tls.GetSelectedAlpnName();
 	}
 
+	void TlsServerData::PrepareKtls()
+	{
+		if (_state != State::WaitingForAccept)
+		{
+			OV_ASSERT2(_state == State::WaitingForAccept);
+			return;
+		}
+
+		_tls.EnableKtlsTracking();
+
+		_ktls_state = KtlsState::Fallback;
+		_ktls_fallback_reason = "Handshake is not completed";
+	}
+
+	TlsServerData::KtlsState TlsServerData::OffloadToKernel(const std::function<bool(const KtlsTxInfo &info, ov::String *reason)> &installer)
+	{
+		if (_ktls_state != KtlsState::Fallback)
+		{
+			// kTLS is not requested, or already offloaded
+			return _ktls_state;
+		}
+
+		if (_state != State::Accepted)
+		{
+			return _ktls_state;
+		}
+
+		KtlsTxInfo info;
+		ov::String reason;
+
+		if (_tls.GetKtlsTxInfo(&info, &reason) && installer(info, &reason))
+		{
+			_ktls_state = KtlsState::Offloaded;
+			_ktls_fallback_reason.Clear();
+		}
+		else
+		{
+			_ktls_fallback_reason = reason;
+		}
+
+		::OPENSSL_cleanse(&info, sizeof(info));
+
+		return _ktls_state;
+	}
+
+	const char *TlsServerData::StringFromKtlsState(KtlsState state)
+	{
+		switch (state)
+		{
+			case KtlsState::Disabled:
+				return "Disabled";
+
+			case KtlsState::Offloaded:
+				return "Offloaded";
+
+			case KtlsState::Fallback:
+				return "Fallback";
+		}
+
+		return "Unknown";
+	}
+
 	ssize_t TlsServerData::OnTlsRead(Tls *tls, void *buffer, size_t length)
 	{
 		std::lock_guard lock_guard(_cipher_data_mutex);
@@ -239,6 +317,10 @@ namespace ov
 			OV_ASSERT2(false);
 			return -1LL;
 		}
+		else if (_ktls_state == KtlsState::Offloaded)
+		{
+			_ktls_desynchronized = true;
+		}
 		else
 		{
 			std::lock_guard lock_guard(_plain_data_mutex);
@@ -25,6 +25,16 @@ namespace ov
 			Accepted,
 		};
 
+		enum class KtlsState
+		{
+			// kTLS is not requested
+			Disabled,
+			// Records are encrypted by the kernel
+			Offloaded,
+			// kTLS is requested, but records are encrypted in the user space
+			Fallback,
+		};
+
 		enum class AlpnProtocol : uint8_t
 		{
 			None,
@@ -76,6 +86,49 @@ namespace ov
 		size_t GetDataLength() const;
 		std::shared_ptr<const Data> GetData() const;
 
+		//--------------------------------------------------------------------
+		// Kernel TLS (TX only)
+		//--------------------------------------------------------------------
+		// Must be called before the handshake
+		void PrepareKtls();
+		// Called after the handshake is completed.
+		// The installer passes the crypto info to the socket and returns whether it succeeded
+		KtlsState OffloadToKernel(const std::function<bool(const KtlsTxInfo &info, ov::String *reason)> &installer);
+
+		KtlsState GetKtlsState() const
+		{
+			return _ktls_state;
+		}
+
+		bool IsKtlsOffloaded() const
+		{
+			return _ktls_state == KtlsState::Offloaded;
+		}
+
+		ov::String GetKtlsFallbackReason() const
+		{
+			return _ktls_fallback_reason;
+		}
+
+		// Bytes handed over to the kernel to encrypt
+		void AddKtlsSentBytes(size_t bytes)
+		{
+			_ktls_sent_bytes += bytes;
+		}
+
+		uint64_t GetKtlsSentBytes() const
+		{
+			return _ktls_sent_bytes;
+		}
+
+		// Bytes encrypted in the user space
+		uint64_t GetEncryptedBytes() const
+		{
+			return _encrypted_bytes;
+		}
+
+		static const char *StringFromKtlsState(KtlsState state);
+
 	protected:
 		//--------------------------------------------------------------------
 		// Called by TLS module
@@ -102,5 +155,14 @@ namespace ov
 		std::shared_ptr<Data> _plain_data;
 
 		AlpnProtocol _selected_alpn_protocol = AlpnProtocol::Http11;
+
+		KtlsState _ktls_state = KtlsState::Disabled;
+		ov::String _ktls_fallback_reason;
+		// Set when OpenSSL writes a record by itself (alert, KeyUpdate, ...) after offloading,
+		// which cannot be sent since the kernel owns the sequence number
+		bool _ktls_desynchronized = false;
+
+		std::atomic<uint64_t> _ktls_sent_bytes{0};
+		std::atomic<uint64_t> _encrypted_bytes{0};
 	};
 }  // namespace ov
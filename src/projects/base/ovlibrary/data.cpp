@@ -47,9 +47,16 @@ namespace ov
 		}
 	}
 
+	Data::Data(const void *data, size_t length, const std::shared_ptr<const void> &reference_owner)
+		: Data(data, length, true)
+	{
+		_reference_owner = reference_owner;
+	}
+
 	Data::Data(const Data &data)
 	{
 		_reference_data = data._reference_data;
+		_reference_owner = data._reference_owner;
 		if (data._allocated_data != nullptr)
 		{
 			_allocated_data = std::make_shared<std::vector<uint8_t>>();
@@ -62,6 +69,7 @@ namespace ov
 	Data::Data(Data &&data) noexcept
 	{
 		std::swap(_reference_data, data._reference_data);
+		std::swap(_reference_owner, data._reference_owner);
 		std::swap(_allocated_data, data._allocated_data);
 		std::swap(_offset, data._offset);
 		std::swap(_length, data._length);
@@ -105,6 +113,7 @@ namespace ov
 		{
 			// Refer _reference_data
 			instance->_reference_data = _reference_data;
+			instance->_reference_owner = _reference_owner;
 		}
 		else
 		{
@@ -153,6 +162,7 @@ namespace ov
 
 		// ov::Data supports COW (Copy-on-write), so we just assign the variables of data to member variables.
 		_reference_data = data._reference_data;
+		_reference_owner = data._reference_owner;
 		_allocated_data = data._allocated_data;
 		_offset = data._offset;
 		_length = data._length;
@@ -224,6 +234,9 @@ namespace ov
 			off_t offset = _offset;
 			size_t length = _length;
 
+			// Keep the owner until the data is copied
+			auto original_owner = std::move(_reference_owner);
+
 			_reference_data = nullptr;
 			_offset = 0;
 			_length = 0;
@@ -288,6 +301,7 @@ namespace ov
 	{
 		// Reallocate the buffer (this method is faster than Detach() & clear());
 		_reference_data = nullptr;
+		_reference_owner = nullptr;
 		_allocated_data = std::make_shared<std::vector<uint8_t>>();
 		_offset = 0;
 		_length = 0;
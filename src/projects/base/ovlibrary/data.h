@@ -41,6 +41,16 @@ namespace ov
 		/// If reference_only is false, it will not be affected if the data changes because it allocates a new memory and copies it there.
 		Data(const void *data, size_t length, bool reference_only = false);
 
+		/// Constructs a instance that references the data without copying
+		///
+		/// @param data data to reference
+		/// @param length length of data
+		/// @param reference_owner an object that keeps the data valid (e.g. a memory mapping)
+		///
+		/// @remarks
+		/// The owner is shared by the copies/subdata of this instance, so the data remains valid while any of them exists.
+		Data(const void *data, size_t length, const std::shared_ptr<const void> &reference_owner);
+
 		// Copy constructor
 		Data(const Data &data);
 
@@ -215,6 +225,8 @@ namespace ov
 		bool Detach();
 
 		const void *_reference_data = nullptr;
+		// Keeps _reference_data valid (optional)
+		std::shared_ptr<const void> _reference_owner = nullptr;
 
 		// Allocated data. If this data is subdata, _current_data and _data can be different.
 		std::shared_ptr<std::vector<uint8_t>> _allocated_data = nullptr;
@@ -0,0 +1,126 @@
+//==============================================================================
+//
+//  OvenMediaEngine
+//
+//  Created by Hyunjun Jang
+//  Copyright (c) 2022 AirenSoft. All rights reserved.
+//
+//==============================================================================
+#include "file_range.h"
+
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "./assert.h"
+
+namespace ov
+{
+	std::shared_ptr<FileRange> FileRange::Open(const String &file_path, off_t offset, size_t length)
+	{
+		int fd = ::open(file_path.CStr(), O_RDONLY | O_CLOEXEC);
+
+		if (fd < 0)
+		{
+			return nullptr;
+		}
+
+		auto shared_fd = std::shared_ptr<const int>(new int(fd), [](const int *fd) {
+			::close(*fd);
+			delete fd;
+		});
+
+		struct stat file_stat;
+		if (::fstat(fd, &file_stat) != 0)
+		{
+			return nullptr;
+		}
+
+		if (offset < 0 || offset > file_stat.st_size)
+		{
+			return nullptr;
+		}
+
+		size_t available = file_stat.st_size - offset;
+
+		if (length == 0)
+		{
+			length = available;
+		}
+		else if (length > available)
+		{
+			return nullptr;
+		}
+
+		return std::make_shared<FileRange>(shared_fd, offset, length);
+	}
+
+	std::shared_ptr<FileRange> FileRange::Open(const String &file_path)
+	{
+		return Open(file_path, 0, 0);
+	}
+
+	FileRange::FileRange(const std::shared_ptr<const int> &fd, off_t offset, size_t length)
+		: _fd(fd),
+		  _offset(offset),
+		  _length(length)
+	{
+	}
+
+	std::shared_ptr<FileRange> FileRange::Subrange(size_t offset) const
+	{
+		OV_ASSERT2(offset <= _length);
+
+		return Subrange(offset, _length - offset);
+	}
+
+	std::shared_ptr<FileRange> FileRange::Subrange(size_t offset, size_t length) const
+	{
+		if ((offset + length) > _length)
+		{
+			OV_ASSERT(false, "offset + length (%zu) must be smaller than %zu", (offset + length), _length);
+			return nullptr;
+		}
+
+		return std::make_shared<FileRange>(_fd, _offset + offset, length);
+	}
+
+	std::shared_ptr<Data> FileRange::Read() const
+	{
+		auto data = std::make_shared<Data>(_length);
+		data->SetLength(_length);
+
+		auto buffer = data->GetWritableDataAs<uint8_t>();
+		size_t total_read = 0;
+
+		while (total_read < _length)
+		{
+			auto read_bytes = ::pread(*_fd, buffer + total_read, _length - total_read, _offset + total_read);
+
+			if (read_bytes < 0)
+			{
+				if (errno == EINTR)
+				{
+					continue;
+				}
+
+				return nullptr;
+			}
+
+			if (read_bytes == 0)
+			{
+				// Unexpected EOF
+				return nullptr;
+			}
+
+			total_read += read_bytes;
+		}
+
+		return data;
+	}
+
+	String FileRange::ToString() const
+	{
+		return String::FormatString("<FileRange: %p, fd: %d, offset: %jd, length: %zu>", this, *_fd, static_cast<intmax_t>(_offset), _length);
+	}
+}  // namespace ov
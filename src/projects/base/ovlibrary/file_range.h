@@ -0,0 +1,58 @@
+//==============================================================================
+//
+//  OvenMediaEngine
+//
+//  Created by Hyunjun Jang
+//  Copyright (c) 2022 AirenSoft. All rights reserved.
+//
+//==============================================================================
+#pragma once
+
+#include "./data.h"
+#include "./string.h"
+
+namespace ov
+{
+	// A range of a file which can be sent to a socket without copying it into the user space (sendfile())
+	//
+	// The file descriptor is shared between the subranges, so the range stays readable
+	// even if the file is unlinked after opening.
+	class FileRange
+	{
+	public:
+		static std::shared_ptr<FileRange> Open(const String &file_path, off_t offset, size_t length);
+		// length == 0: until the end of the file
+		static std::shared_ptr<FileRange> Open(const String &file_path);
+
+		FileRange(const std::shared_ptr<const int> &fd, off_t offset, size_t length);
+
+		int GetNativeHandle() const
+		{
+			return *_fd;
+		}
+
+		off_t GetOffset() const
+		{
+			return _offset;
+		}
+
+		size_t GetLength() const
+		{
+			return _length;
+		}
+
+		// Creates a new range that skips <offset> bytes from the beginning of this range
+		std::shared_ptr<FileRange> Subrange(size_t offset) const;
+		std::shared_ptr<FileRange> Subrange(size_t offset, size_t length) const;
+
+		// Reads the range into memory (for connections that cannot use sendfile(), e.g. TLS)
+		std::shared_ptr<Data> Read() const;
+
+		String ToString() const;
+
+	protected:
+		std::shared_ptr<const int> _fd;
+		off_t _offset = 0;
+		size_t _length = 0;
+	};
+}  // namespace ov
@@ -0,0 +1,267 @@
+//==============================================================================
+//
+//  OvenMediaEngine
+//
+//  Created by Hyunjun Jang
+//  Copyright (c) 2022 AirenSoft. All rights reserved.
+//
+//==============================================================================
+#include "./json_writer.h"
+
+#include <charconv>
+
+#include "./assert.h"
+
+namespace ov
+{
+	JsonWriter::JsonWriter(size_t capacity)
+	{
+		_buffer.SetCapacity(capacity);
+	}
+
+	JsonWriter &JsonWriter::BeginObject()
+	{
+		PrepareValue();
+
+		_buffer.Append('{');
+		_first_stack.push_back(true);
+
+		return *this;
+	}
+
+	JsonWriter &JsonWriter::EndObject()
+	{
+		OV_ASSERT2((_first_stack.empty() == false) && (_is_key_written == false));
+
+		_buffer.Append('}');
+		_first_stack.pop_back();
+
+		return *this;
+	}
+
+	JsonWriter &JsonWriter::BeginArray()
+	{
+		PrepareValue();
+
+		_buffer.Append('[');
+		_first_stack.push_back(true);
+
+		return *this;
+	}
+
+	JsonWriter &JsonWriter::EndArray()
+	{
+		OV_ASSERT2(_first_stack.empty() == false);
+
+		_buffer.Append(']');
+		_first_stack.pop_back();
+
+		return *this;
+	}
+
+	JsonWriter &JsonWriter::Key(const char *key)
+	{
+		OV_ASSERT2((_first_stack.empty() == false) && (_is_key_written == false));
+
+		PrepareValue();
+
+		_buffer.Append('"');
+		AppendEscaped(key, ::strlen(key));
+		_buffer.Append("\":", 2);
+
+		_is_key_written = true;
+
+		return *this;
+	}
+
+	JsonWriter &JsonWriter::Key(const ov::String &key)
+	{
+		OV_ASSERT2((_first_stack.empty() == false) && (_is_key_written == false));
+
+		PrepareValue();
+
+		_buffer.Append('"');
+		AppendEscaped(key.CStr(), key.GetLength());
+		_buffer.Append("\":", 2);
+
+		_is_key_written = true;
+
+		return *this;
+	}
+
+	JsonWriter &JsonWriter::String(const char *value)
+	{
+		return String(value, ::strlen(value));
+	}
+
+	JsonWriter &JsonWriter::String(const char *value, size_t length)
+	{
+		PrepareValue();
+
+		_buffer.Append('"');
+		AppendEscaped(value, length);
+		_buffer.Append('"');
+
+		return *this;
+	}
+
+	JsonWriter &JsonWriter::String(const ov::String &value)
+	{
+		return String(value.CStr(), value.GetLength());
+	}
+
+	JsonWriter &JsonWriter::Int64(int64_t value)
+	{
+		PrepareValue();
+
+		char buffer[24];
+		auto result = std::to_chars(buffer, buffer + sizeof(buffer), value);
+		_buffer.Append(buffer, result.ptr - buffer);
+
+		return *this;
+	}
+
+	JsonWriter &JsonWriter::UInt64(uint64_t value)
+	{
+		PrepareValue();
+
+		char buffer[24];
+		auto result = std::to_chars(buffer, buffer + sizeof(buffer), value);
+		_buffer.Append(buffer, result.ptr - buffer);
+
+		return *this;
+	}
+
+	JsonWriter &JsonWriter::Bool(bool value)
+	{
+		PrepareValue();
+
+		if (value)
+		{
+			_buffer.Append("true", 4);
+		}
+		else
+		{
+			_buffer.Append("false", 5);
+		}
+
+		return *this;
+	}
+
+	JsonWriter &JsonWriter::Null()
+	{
+		PrepareValue();
+
+		_buffer.Append("null", 4);
+
+		return *this;
+	}
+
+	JsonWriter &JsonWriter::Raw(const char *json, size_t length)
+	{
+		PrepareValue();
+
+		_buffer.Append(json, length);
+
+		return *this;
+	}
+
+	JsonWriter &JsonWriter::Raw(const ov::String &json)
+	{
+		return Raw(json.CStr(), json.GetLength());
+	}
+
+	void JsonWriter::Clear()
+	{
+		// Keep the buffer to reuse it
+		_buffer.SetLength(0);
+		_first_stack.clear();
+		_is_key_written = false;
+	}
+
+	void JsonWriter::PrepareValue()
+	{
+		if (_is_key_written)
+		{
+			// The value of the key
+			_is_key_written = false;
+			return;
+		}
+
+		if (_first_stack.empty())
+		{
+			// Root value
+			return;
+		}
+
+		if (_first_stack.back())
+		{
+			_first_stack.back() = false;
+		}
+		else
+		{
+			_buffer.Append(',');
+		}
+	}
+
+	void JsonWriter::AppendEscaped(const char *value, size_t length)
+	{
+		static const char HEX[] = "0123456789abcdef";
+
+		// Append the characters that do not need to be escaped at once
+		size_t start = 0;
+
+		for (size_t index = 0; index < length; index++)
+		{
+			auto c = static_cast<uint8_t>(value[index]);
+			const char *escaped = nullptr;
+
+			switch (c)
+			{
+				case '"':
+					escaped = "\\\"";
+					break;
+				case '\\':
+					escaped = "\\\\";
+					break;
+				case '\b':
+					escaped = "\\b";
+					break;
+				case '\f':
+					escaped = "\\f";
+					break;
+				case '\n':
+					escaped = "\\n";
+					break;
+				case '\r':
+					escaped = "\\r";
+					break;
+				case '\t':
+					escaped = "\\t";
+					break;
+				default:
+					if (c >= 0x20)
+					{
+						// UTF-8 sequences are written as is
+						continue;
+					}
+					break;
+			}
+
+			_buffer.Append(value + start, index - start);
+			start = index + 1;
+
+			if (escaped != nullptr)
+			{
+				_buffer.Append(escaped, 2);
+			}
+			else
+			{
+				char unicode[6] = {'\\', 'u', '0', '0', HEX[c >> 4], HEX[c & 0x0F]};
+				_buffer.Append(unicode, sizeof(unicode));
+			}
+		}
+
+		_buffer.Append(value + start, length - start);
+	}
+}  // namespace ov
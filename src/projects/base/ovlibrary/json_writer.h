@@ -0,0 +1,81 @@
+//==============================================================================
+//
+//  OvenMediaEngine
+//
+//  Created by Hyunjun Jang
+//  Copyright (c) 2022 AirenSoft. All rights reserved.
+//
+//==============================================================================
+#pragma once
+
+#include <vector>
+
+#include "./string.h"
+
+namespace ov
+{
+	// Writes JSON text directly into a string without building a ::Json::Value tree
+	//
+	// - Separators are inserted automatically, the caller only writes keys and values in order
+	// - The output is compact (no whitespace), same as ov::Json::Stringify()
+	// - Keys are written in the order of the calls. To produce the same output as ov::Json::Stringify(),
+	//   the caller must write the keys in ascending order
+	//
+	// Usage:
+	//   ov::JsonWriter writer;
+	//   writer.BeginObject().Key("name").String("stream").Key("totalBytesIn").Int64(100).EndObject();
+	//   writer.GetString();  // {"name":"stream","totalBytesIn":100}
+	class JsonWriter
+	{
+	public:
+		JsonWriter() = default;
+		JsonWriter(size_t capacity);
+
+		JsonWriter &BeginObject();
+		JsonWriter &EndObject();
+
+		JsonWriter &BeginArray();
+		JsonWriter &EndArray();
+
+		JsonWriter &Key(const char *key);
+		JsonWriter &Key(const ov::String &key);
+
+		JsonWriter &String(const char *value);
+		JsonWriter &String(const char *value, size_t length);
+		JsonWriter &String(const ov::String &value);
+		JsonWriter &Int64(int64_t value);
+		JsonWriter &UInt64(uint64_t value);
+		JsonWriter &Bool(bool value);
+		JsonWriter &Null();
+
+		// Writes a value that is already serialized (e.g. a cached JSON text) as is
+		JsonWriter &Raw(const char *json, size_t length);
+		JsonWriter &Raw(const ov::String &json);
+
+		// Returns true if all objects/arrays are closed
+		bool IsCompleted() const
+		{
+			return _first_stack.empty();
+		}
+
+		const ov::String &GetString() const
+		{
+			return _buffer;
+		}
+
+		// Resets the writer, the allocated buffer is kept
+		void Clear();
+
+	protected:
+		// Writes a separator if needed
+		void PrepareValue();
+		void AppendEscaped(const char *value, size_t length);
+
+		ov::String _buffer;
+
+		// Whether no element is written yet in each level of the nested objects/arrays
+		std::vector<bool> _first_stack;
+		// A key is written and the value is not written yet
+		bool _is_key_written = false;
+	};
+}  // namespace ov
@@ -7,6 +7,9 @@
 //
 //==============================================================================
 #include "log.h"
+
+#include <time.h>
+
 #include "log_internal.h"
 
 //TODO(Getroot): This is temporary code for testing. This will change to more elegant code in the future.
@@ -26,21 +29,35 @@ static ov::LogInternal g_stat_hrs_log_internal(OV_STAT_HRS_LOG_FILE);
 static ov::LogInternal g_stat_hrr_log_internal(OV_STAT_HRR_LOG_FILE);
 static ov::LogInternal g_stat_hrv_log_internal(OV_STAT_HRV_LOG_FILE);
 
+// Starts from 1 since 0 means "not cached" in OVLogEnabledCache
+uint64_t g_ov_log_generation = 1;
+
+// Invalidates the cache of all call sites
+static void IncreaseLogGeneration()
+{
+	__atomic_add_fetch(&g_ov_log_generation, 1, __ATOMIC_RELEASE);
+}
+
 // log level 지정
 void ov_log_set_level(OVLogLevel level)
 {
 	g_log_internal.SetLogLevel(level);
+	IncreaseLogGeneration();
 }
 
 void ov_log_reset_enable()
 {
 	g_log_internal.ResetEnable();
+	IncreaseLogGeneration();
 }
 
 // tag는 정규식 사용 가능, 정규식에 대해서는 http://www.cplusplus.com/reference/regex/ECMAScript 참고
 bool ov_log_set_enable(const char *tag_regex, OVLogLevel level, bool is_enabled)
 {
-	return g_log_internal.SetEnable(tag_regex, level, is_enabled);
+	auto result = g_log_internal.SetEnable(tag_regex, level, is_enabled);
+	IncreaseLogGeneration();
+
+	return result;
 }
 
 bool ov_log_get_enabled(const char *tag, OVLogLevel level)
@@ -48,6 +65,39 @@ bool ov_log_get_enabled(const char *tag, OVLogLevel level)
 	return g_log_internal.IsEnabled(tag, level);
 }
 
+bool ov_log_update_enabled_cache(OVLogEnabledCache *cache, const char *tag, OVLogLevel level)
+{
+	// The generation must be obtained before checking the settings,
+	// so the cache is checked again if the settings are changed while checking
+	auto generation = __atomic_load_n(&g_ov_log_generation, __ATOMIC_ACQUIRE);
+	auto is_enabled = g_log_internal.IsLevelEnabled(level) && g_log_internal.IsEnabled((tag == nullptr) ? "" : tag, level);
+
+	__atomic_store_n(cache, (generation << 1) | (is_enabled ? 1 : 0), __ATOMIC_RELAXED);
+
+	return is_enabled;
+}
+
+bool ov_log_check_rate_limit(OVLogRateLimit *limit, int interval_msec, uint64_t *suppressed_count)
+{
+	timespec now{};
+	::clock_gettime(CLOCK_MONOTONIC_COARSE, &now);
+	uint64_t now_msec = (static_cast<uint64_t>(now.tv_sec) * 1000ULL) + (now.tv_nsec / 1000000);
+
+	auto next_msec = __atomic_load_n(&limit->next_msec, __ATOMIC_RELAXED);
+
+	// Only one of the threads that reached here at the same time can write the log
+	if ((now_msec < next_msec) ||
+		(__atomic_compare_exchange_n(&limit->next_msec, &next_msec, now_msec + interval_msec, false, __ATOMIC_RELAXED, __ATOMIC_RELAXED) == false))
+	{
+		__atomic_add_fetch(&limit->suppressed_count, 1, __ATOMIC_RELAXED);
+		return false;
+	}
+
+	*suppressed_count = __atomic_exchange_n(&limit->suppressed_count, 0, __ATOMIC_RELAXED);
+
+	return true;
+}
+
 void ov_log_internal(OVLogLevel level, const char *tag, const char *file, int line, const char *method, const char *format, ...)
 {
 	va_list arg_list;
@@ -58,6 +108,16 @@ void ov_log_internal(OVLogLevel level, const char *tag, const char *file, int li
 	va_end(arg_list);
 }
 
+void ov_log_write(OVLogLevel level, const char *tag, const char *file, int line, const char *method, const char *format, ...)
+{
+	va_list arg_list;
+	va_start(arg_list, format);
+
+	g_log_internal.Write(true, level, tag, file, line, method, format, arg_list);
+
+	va_end(arg_list);
+}
+
 void ov_log_set_path(const char *log_path)
 {
     g_log_internal.SetLogPath(log_path);
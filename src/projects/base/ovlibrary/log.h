@@ -8,6 +8,8 @@
 //==============================================================================
 #pragma once
 
+#include <stdint.h>
+
 #ifdef __cplusplus
 extern "C"
 {
@@ -61,28 +63,82 @@ typedef enum StatLogType
 	STAT_LOG_HLS_EDGE_VIEWERS
 } StatLogType;
 
-#if DEBUG
-#	define logd(tag, format, ...)                                                                                     \
-		do                                                                                                             \
-		{                                                                                                              \
-			if (ov_log_get_enabled(tag, OVLogLevelDebug))                                                              \
-			{                                                                                                          \
-				ov_log_internal(OVLogLevelDebug, tag, __FILE__, __LINE__, __PRETTY_FUNCTION__, format, ##__VA_ARGS__); \
-			}                                                                                                          \
-		} while (false)
-
-#	define logp(tag, format, ...)                     logd(tag ".Packet", format, ##__VA_ARGS__)
-#else
-#	define logd(...)                                  do {} while(false)
-#	define logp                                       logd
-#endif // DEBUG
+// Enabled state of a log call site, cached until the log settings are changed
+// ((generation of the settings << 1) | is_enabled, 0 means not cached)
+typedef uint64_t OVLogEnabledCache;
+
+// Rate limit of a log call site
+typedef struct OVLogRateLimit
+{
+	// Monotonic time in milliseconds when the next log is allowed
+	uint64_t next_msec;
+	uint64_t suppressed_count;
+} OVLogRateLimit;
+
+// Incremented whenever the log settings are changed
+extern uint64_t g_ov_log_generation;
+
+// Checks the settings and updates the cache of the call site
+bool ov_log_update_enabled_cache(OVLogEnabledCache *cache, const char *tag, OVLogLevel level);
+
+// Checks the cache of the call site first, so the settings (regex of the tags) are not looked up for every log
+static inline bool ov_log_is_enabled(OVLogEnabledCache *cache, const char *tag, OVLogLevel level)
+{
+	uint64_t cached = __atomic_load_n(cache, __ATOMIC_RELAXED);
+
+	if ((cached >> 1) == __atomic_load_n(&g_ov_log_generation, __ATOMIC_ACQUIRE))
+	{
+		return (cached & 1) != 0;
+	}
+
+	return ov_log_update_enabled_cache(cache, tag, level);
+}
+
+/// @returns Whether the log can be written, the number of logs suppressed since the last log is stored in suppressed_count
+bool ov_log_check_rate_limit(OVLogRateLimit *limit, int interval_msec, uint64_t *suppressed_count);
+
+#define OV_LOG_WRITE(level, tag, format, ...)                                                               \
+	do                                                                                                      \
+	{                                                                                                       \
+		static OVLogEnabledCache ov_log_enabled_cache = 0;                                                  \
+		if (ov_log_is_enabled(&ov_log_enabled_cache, tag, level))                                           \
+		{                                                                                                   \
+			ov_log_write(level, tag, __FILE__, __LINE__, __PRETTY_FUNCTION__, format, ##__VA_ARGS__);       \
+		}                                                                                                   \
+	} while (false)
+
+// Writes at most one log every interval_msec for each call site
+#define OV_LOG_WRITE_LIMITED(level, tag, interval_msec, format, ...)                                                                          \
+	do                                                                                                                                        \
+	{                                                                                                                                         \
+		static OVLogEnabledCache ov_log_enabled_cache = 0;                                                                                    \
+		static OVLogRateLimit ov_log_rate_limit = {0, 0};                                                                                     \
+		uint64_t ov_log_suppressed_count = 0;                                                                                                 \
+		if (ov_log_is_enabled(&ov_log_enabled_cache, tag, level) && ov_log_check_rate_limit(&ov_log_rate_limit, interval_msec, &ov_log_suppressed_count)) \
+		{                                                                                                                                     \
+			if (ov_log_suppressed_count == 0)                                                                                                 \
+			{                                                                                                                                 \
+				ov_log_write(level, tag, __FILE__, __LINE__, __PRETTY_FUNCTION__, format, ##__VA_ARGS__);                                     \
+			}                                                                                                                                 \
+			else                                                                                                                              \
+			{                                                                                                                                 \
+				ov_log_write(level, tag, __FILE__, __LINE__, __PRETTY_FUNCTION__, format " (%llu suppressed)", ##__VA_ARGS__,                  \
+							 (unsigned long long)ov_log_suppressed_count);                                                                    \
+			}                                                                                                                                 \
+		}                                                                                                                                     \
+	} while (false)
+
+// Debug logs are compiled in release builds too, so they can be enabled with Logger.xml (and SIGHUP) when needed.
+// A disabled call site costs only the cache check above.
+#define logd(tag, format, ...)                        OV_LOG_WRITE(OVLogLevelDebug,          tag, format, ## __VA_ARGS__)
+#define logp(tag, format, ...)                        logd(tag ".Packet", format, ## __VA_ARGS__)
 //--------------------------------------------------------------------
 // Logging APIs
 //--------------------------------------------------------------------
-#define logi(tag, format, ...)                        ov_log_internal(OVLogLevelInformation,    tag, __FILE__, __LINE__, __PRETTY_FUNCTION__, format, ## __VA_ARGS__)
-#define logw(tag, format, ...)                        ov_log_internal(OVLogLevelWarning,        tag, __FILE__, __LINE__, __PRETTY_FUNCTION__, format, ## __VA_ARGS__)
-#define loge(tag, format, ...)                        ov_log_internal(OVLogLevelError,          tag, __FILE__, __LINE__, __PRETTY_FUNCTION__, format, ## __VA_ARGS__)
-#define logc(tag, format, ...)                        ov_log_internal(OVLogLevelCritical,       tag, __FILE__, __LINE__, __PRETTY_FUNCTION__, format, ## __VA_ARGS__)
+#define logi(tag, format, ...)                        OV_LOG_WRITE(OVLogLevelInformation,    tag, format, ## __VA_ARGS__)
+#define logw(tag, format, ...)                        OV_LOG_WRITE(OVLogLevelWarning,        tag, format, ## __VA_ARGS__)
+#define loge(tag, format, ...)                        OV_LOG_WRITE(OVLogLevelError,          tag, format, ## __VA_ARGS__)
+#define logc(tag, format, ...)                        OV_LOG_WRITE(OVLogLevelCritical,       tag, format, ## __VA_ARGS__)
 
 //--------------------------------------------------------------------
 // Logging APIs with tag
@@ -97,6 +153,12 @@ typedef enum StatLogType
 #define logte(format, ...)                            loge(OV_LOG_TAG, format, ## __VA_ARGS__)
 #define logtc(format, ...)                            logc(OV_LOG_TAG, format, ## __VA_ARGS__)
 
+// Rate-limited logging APIs (at most one log every interval_msec for each call site)
+#define logtd_limited(interval_msec, format, ...)     OV_LOG_WRITE_LIMITED(OVLogLevelDebug,       OV_LOG_TAG, interval_msec, format, ## __VA_ARGS__)
+#define logti_limited(interval_msec, format, ...)     OV_LOG_WRITE_LIMITED(OVLogLevelInformation, OV_LOG_TAG, interval_msec, format, ## __VA_ARGS__)
+#define logtw_limited(interval_msec, format, ...)     OV_LOG_WRITE_LIMITED(OVLogLevelWarning,     OV_LOG_TAG, interval_msec, format, ## __VA_ARGS__)
+#define logte_limited(interval_msec, format, ...)     OV_LOG_WRITE_LIMITED(OVLogLevelError,       OV_LOG_TAG, interval_msec, format, ## __VA_ARGS__)
+
 #define stat_log(type, format, ...)                         ov_stat_log_internal(type, OVLogLevelInformation,    "STAT", __FILE__, __LINE__, __PRETTY_FUNCTION__, format, ## __VA_ARGS__)
 
 /// 모든 log에 1차적으로 적용되는 filter 규칙
@@ -124,6 +186,8 @@ bool ov_log_set_enable(const char *tag_regex, OVLogLevel level, bool is_enabled)
 bool ov_log_get_enabled(const char *tag, OVLogLevel level);
 
 void ov_log_internal(OVLogLevel level, const char *tag, const char *file, int line, const char *method, const char *format, ...);
+// Same as ov_log_internal(), but the caller has already checked whether the log is enabled (by ov_log_is_enabled())
+void ov_log_write(OVLogLevel level, const char *tag, const char *file, int line, const char *method, const char *format, ...);
 void ov_log_set_path(const char *log_path);
 
 void ov_stat_log_internal(StatLogType type, OVLogLevel level, const char *tag, const char *file, int line, const char *method, const char *format, ...);
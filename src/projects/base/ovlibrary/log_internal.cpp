@@ -8,6 +8,10 @@
 //==============================================================================
 #include "log_internal.h"
 
+#include <inttypes.h>
+#include <string.h>
+
+#include <algorithm>
 #include <thread>
 
 #include "platform.h"
@@ -52,14 +56,92 @@
 
 namespace ov
 {
+	// Incremented in the child process after fork() to start the writer thread again
+	static std::atomic<int64_t> g_fork_generation{0};
+
+	// The consumer of the rings (the writer thread or a thread writing a critical log).
+	// It is shared by all instances to hold it while fork() is called, so the child process doesn't inherit
+	// the lock held by a writer thread, or the pending logs of the parent process.
+	// (These are never released, since logs may be written while terminating)
+	static std::mutex *GetDrainMutex()
+	{
+		static auto drain_mutex = new std::mutex();
+		return drain_mutex;
+	}
+
+	// Guarded by the drain mutex
+	static std::vector<LogInternal *> *GetInstanceList()
+	{
+		static auto instance_list = new std::vector<LogInternal *>();
+		return instance_list;
+	}
+
+	struct LogWriterState
+	{
+		std::mutex mutex;
+		std::condition_variable condition;
+		bool wakeup = false;
+
+		// The writer sleeps without the timeout until a log is written
+		std::atomic<bool> is_idle{false};
+
+		// The writer is started again in the child process after fork() (the thread is not inherited)
+		std::atomic<int64_t> fork_generation{-1};
+	};
+
+	// The writer thread keeps running while the static instances are destroyed, so this is never released
+	static LogWriterState *GetWriterState()
+	{
+		static auto writer_state = new LogWriterState();
+		return writer_state;
+	}
+
+	static void OnForkPrepare()
+	{
+		GetDrainMutex()->lock();
+
+		for (auto instance : *GetInstanceList())
+		{
+			instance->DrainRings();
+		}
+	}
+
+	static void OnForkParent()
+	{
+		GetDrainMutex()->unlock();
+	}
+
+	static void OnForkChild()
+	{
+		g_fork_generation++;
+
+		GetDrainMutex()->unlock();
+	}
+
 	LogInternal::LogInternal(std::string log_file_name) noexcept
 		: _level(OVLogLevelDebug),
 		  _log_file(log_file_name)
 	{
+		static std::once_flag once_flag;
+
+		std::call_once(once_flag, []() {
+			::pthread_atfork(OnForkPrepare, OnForkParent, OnForkChild);
+		});
+
+		std::lock_guard<std::mutex> lock(*GetDrainMutex());
+		GetInstanceList()->push_back(this);
 	}
 
 	LogInternal::~LogInternal()
 	{
+		std::lock_guard<std::mutex> lock(*GetDrainMutex());
+
+		// Drain the rings for the last time, the writer thread doesn't access this instance after this
+		DrainRings();
+
+		auto instance_list = GetInstanceList();
+		instance_list->erase(std::remove(instance_list->begin(), instance_list->end(), this), instance_list->end());
+
 		_released = true;
 	}
 
@@ -191,17 +273,388 @@ namespace ov
 			return;
 		}
 
-		if (tag == nullptr)
+		if (IsEnabled((tag == nullptr) ? "" : tag, level) == false)
 		{
-			tag = "";
+			// Disabled log level for the tag
+			return;
 		}
 
-		if (IsEnabled(tag, level) == false)
+		Write(show_format, level, tag, file, line, method, format, arg_list);
+	}
+
+	void LogInternal::Write(bool show_format, OVLogLevel level, const char *tag, const char *file, int line, const char *method, const char *format, va_list &arg_list)
+	{
+		if (_released)
 		{
-			// Disabled log level for the tag
 			return;
 		}
 
+		// Critical logs are written immediately since the process may be terminated right after (e.g. crash)
+		auto ring = (level < OVLogLevelCritical) ? GetRing() : nullptr;
+
+		if (ring == nullptr)
+		{
+			LogRecord record;
+			FillRecord(&record, show_format, level, tag, file, line, method, format, arg_list);
+
+			// Write the pending logs first to keep the order.
+			// The lock may be held by the thread interrupted by a signal handler, so it doesn't wait forever.
+			std::unique_lock<std::mutex> lock(*GetDrainMutex(), std::defer_lock);
+			for (int wait_count = 0; wait_count < OV_LOG_CRITICAL_WAIT_MSEC; wait_count++)
+			{
+				if (lock.try_lock())
+				{
+					DrainRings();
+					break;
+				}
+
+				std::this_thread::sleep_for(std::chrono::milliseconds(1));
+			}
+
+			ov::String log;
+			Output(record, log);
+			FlushOutput();
+
+			return;
+		}
+
+		auto tail = ring->tail.load(std::memory_order_relaxed);
+
+		while ((tail - ring->head.load(std::memory_order_acquire)) >= OV_LOG_RING_SIZE)
+		{
+			if (level == OVLogLevelDebug)
+			{
+				// Debug logs can be dropped rather than blocking the thread
+				_dropped_count++;
+				WakeUpWriter();
+				return;
+			}
+
+			// Wait for the writer to make a room
+			WakeUpWriter();
+			std::this_thread::sleep_for(std::chrono::milliseconds(1));
+
+			if (_released)
+			{
+				return;
+			}
+		}
+
+		auto record = &(ring->records[tail % OV_LOG_RING_SIZE]);
+		FillRecord(record, show_format, level, tag, file, line, method, format, arg_list);
+
+		ring->tail.store(tail + 1, std::memory_order_release);
+
+		if ((tail - ring->head.load(std::memory_order_relaxed)) >= (OV_LOG_RING_SIZE / 2))
+		{
+			// Drain the ring before it gets full
+			WakeUpWriter();
+		}
+		else
+		{
+			WakeUpIdleWriter();
+		}
+	}
+
+	void LogInternal::FillRecord(LogRecord *record, bool show_format, OVLogLevel level, const char *tag, const char *file, int line, const char *method, const char *format, va_list &arg_list)
+	{
+		record->time = std::chrono::system_clock::now();
+		record->level = level;
+		record->show_format = show_format;
+
+		record->thread_id = ov::Platform::GetThreadId();
+		::strncpy(record->thread_name, ov::Platform::GetThreadName(), sizeof(record->thread_name) - 1);
+		record->thread_name[sizeof(record->thread_name) - 1] = '\0';
+
+		::strncpy(record->tag, (tag == nullptr) ? "" : tag, sizeof(record->tag) - 1);
+		record->tag[sizeof(record->tag) - 1] = '\0';
+
+		const char *file_name = (file == nullptr) ? "" : file;
+		{
+			const char *position = ::strrchr(file_name, '/');
+
+			if (position != nullptr)
+			{
+				file_name = position + 1;
+			}
+		}
+		::strncpy(record->file, file_name, sizeof(record->file) - 1);
+		record->file[sizeof(record->file) - 1] = '\0';
+		record->line = line;
+
+#if OV_LOG_SHOW_FUNCTION_NAME
+		::strncpy(record->method, (method == nullptr) ? "" : method, sizeof(record->method) - 1);
+		record->method[sizeof(record->method) - 1] = '\0';
+#endif	// OV_LOG_SHOW_FUNCTION_NAME
+
+		record->long_message = nullptr;
+
+		va_list arg_list_copy;
+		va_copy(arg_list_copy, arg_list);
+		auto length = ::vsnprintf(record->message, sizeof(record->message), format, arg_list_copy);
+		va_end(arg_list_copy);
+
+		if (length < 0)
+		{
+			record->message[0] = '\0';
+		}
+		else if (static_cast<size_t>(length) >= sizeof(record->message))
+		{
+			record->long_message = static_cast<char *>(::malloc(length + 1));
+
+			if (record->long_message != nullptr)
+			{
+				::vsnprintf(record->long_message, length + 1, format, arg_list);
+			}
+		}
+	}
+
+	LogInternal::ThreadRings::~ThreadRings()
+	{
+		for (auto &item : ring_list)
+		{
+			item.second->is_owner_exited = true;
+		}
+	}
+
+	std::shared_ptr<LogInternal::LogRing> LogInternal::GetRing()
+	{
+		static thread_local ThreadRings thread_rings;
+
+		StartWriterIfNeeded();
+
+		for (auto &item : thread_rings.ring_list)
+		{
+			if (item.first == this)
+			{
+				return item.second;
+			}
+		}
+
+		// The first log of this thread
+		std::shared_ptr<LogRing> ring;
+
+		try
+		{
+			ring = std::make_shared<LogRing>();
+		}
+		catch (const std::bad_alloc &)
+		{
+			return nullptr;
+		}
+
+		{
+			std::lock_guard<std::mutex> lock(_ring_list_mutex);
+			_ring_list.push_back(ring);
+		}
+
+		thread_rings.ring_list.emplace_back(this, ring);
+
+		return ring;
+	}
+
+	void LogInternal::StartWriterIfNeeded()
+	{
+		auto writer_state = GetWriterState();
+		auto fork_generation = g_fork_generation.load(std::memory_order_relaxed);
+
+		if (writer_state->fork_generation.load(std::memory_order_relaxed) == fork_generation)
+		{
+			return;
+		}
+
+		std::lock_guard<std::mutex> lock(writer_state->mutex);
+
+		if (writer_state->fork_generation == fork_generation)
+		{
+			// Started by another thread
+			return;
+		}
+
+		// If this is a child process, the thread of the parent process is not valid here, so it is just abandoned
+		// (The thread is never joined since logs may be written while terminating)
+		writer_state->wakeup = false;
+		writer_state->is_idle = false;
+
+		auto writer_thread = new std::thread(&LogInternal::WriterThread);
+		::pthread_setname_np(writer_thread->native_handle(), "Logger");
+		writer_thread->detach();
+		delete writer_thread;
+
+		writer_state->fork_generation = fork_generation;
+	}
+
+	void LogInternal::WakeUpWriter()
+	{
+		auto writer_state = GetWriterState();
+
+		{
+			std::lock_guard<std::mutex> lock(writer_state->mutex);
+			writer_state->wakeup = true;
+		}
+
+		writer_state->condition.notify_one();
+	}
+
+	void LogInternal::WakeUpIdleWriter()
+	{
+		auto writer_state = GetWriterState();
+
+		// Pairs with the fence in WriterThread() so that either the writer sees the new record, or this sees the idle flag
+		std::atomic_thread_fence(std::memory_order_seq_cst);
+
+		if (writer_state->is_idle.load(std::memory_order_relaxed) && writer_state->is_idle.exchange(false))
+		{
+			WakeUpWriter();
+		}
+	}
+
+	void LogInternal::WriterThread()
+	{
+		auto writer_state = GetWriterState();
+		auto drain_mutex = GetDrainMutex();
+
+		while (true)
+		{
+			{
+				std::unique_lock<std::mutex> lock(writer_state->mutex);
+
+				if (writer_state->is_idle)
+				{
+					writer_state->condition.wait(lock, [writer_state]() -> bool {
+						return writer_state->wakeup;
+					});
+				}
+				else
+				{
+					// Collect the logs written in the interval to write them in a batch
+					writer_state->condition.wait_for(lock, std::chrono::milliseconds(OV_LOG_WRITER_INTERVAL_MSEC), [writer_state]() -> bool {
+						return writer_state->wakeup;
+					});
+				}
+
+				writer_state->wakeup = false;
+			}
+
+			std::lock_guard<std::mutex> lock(*drain_mutex);
+
+			for (auto instance : *GetInstanceList())
+			{
+				instance->DrainRings();
+			}
+
+			// Go idle, and check the rings again for the logs written while draining
+			writer_state->is_idle = true;
+			std::atomic_thread_fence(std::memory_order_seq_cst);
+
+			for (auto instance : *GetInstanceList())
+			{
+				if (instance->HasPendingRecords())
+				{
+					writer_state->is_idle = false;
+					break;
+				}
+			}
+		}
+	}
+
+	bool LogInternal::HasPendingRecords()
+	{
+		std::lock_guard<std::mutex> lock(_ring_list_mutex);
+
+		for (const auto &ring : _ring_list)
+		{
+			if (ring->head.load(std::memory_order_relaxed) != ring->tail.load(std::memory_order_relaxed))
+			{
+				return true;
+			}
+		}
+
+		return false;
+	}
+
+	void LogInternal::DrainRings()
+	{
+		{
+			std::lock_guard<std::mutex> lock(_ring_list_mutex);
+
+			_drain_ring_list = _ring_list;
+
+			// Remove the rings of the terminated threads (they will be drained below for the last time)
+			_ring_list.erase(
+				std::remove_if(_ring_list.begin(), _ring_list.end(), [](const std::shared_ptr<LogRing> &ring) -> bool {
+					return ring->is_owner_exited;
+				}),
+				_ring_list.end());
+		}
+
+		_drain_record_list.clear();
+
+		std::vector<uint64_t> tail_list;
+		tail_list.reserve(_drain_ring_list.size());
+
+		for (const auto &ring : _drain_ring_list)
+		{
+			auto head = ring->head.load(std::memory_order_relaxed);
+			auto tail = ring->tail.load(std::memory_order_acquire);
+
+			for (auto index = head; index < tail; index++)
+			{
+				_drain_record_list.push_back(&(ring->records[index % OV_LOG_RING_SIZE]));
+			}
+
+			tail_list.push_back(tail);
+		}
+
+		auto dropped_count = _dropped_count.exchange(0);
+
+		if ((_drain_record_list.empty() == false) || (dropped_count > 0))
+		{
+			// Merge the logs of the threads in chronological order
+			std::stable_sort(_drain_record_list.begin(), _drain_record_list.end(), [](const LogRecord *record1, const LogRecord *record2) -> bool {
+				return record1->time < record2->time;
+			});
+
+			for (auto record : _drain_record_list)
+			{
+				Output(*record, _output_buffer);
+
+				if (record->long_message != nullptr)
+				{
+					::free(record->long_message);
+				}
+			}
+
+			if (dropped_count > 0)
+			{
+				LogRecord record{};
+				record.time = std::chrono::system_clock::now();
+				record.level = OVLogLevelWarning;
+				record.show_format = true;
+				::strncpy(record.thread_name, ov::Platform::GetThreadName(), sizeof(record.thread_name) - 1);
+				record.thread_id = ov::Platform::GetThreadId();
+				::strncpy(record.tag, "Logger", sizeof(record.tag) - 1);
+				::strncpy(record.file, "log_internal.cpp", sizeof(record.file) - 1);
+				record.line = __LINE__;
+				::snprintf(record.message, sizeof(record.message), "%" PRIu64 " debug logs were dropped because the log buffer was full", dropped_count);
+
+				Output(record, _output_buffer);
+			}
+
+			FlushOutput();
+		}
+
+		// Give the records back to the producers
+		for (size_t index = 0; index < _drain_ring_list.size(); index++)
+		{
+			_drain_ring_list[index]->head.store(tail_list[index], std::memory_order_release);
+		}
+
+		_drain_ring_list.clear();
+	}
+
+	void LogInternal::Output(const LogRecord &record, ov::String &log)
+	{
 		constexpr const char *log_level[] = {
 			"D",
 			"I",
@@ -223,32 +676,26 @@ namespace ov
 			OV_LOG_COLOR_RESET,
 			OV_LOG_COLOR_RESET};
 
-		// Obtain current time in milliseconds
-		auto current = std::chrono::system_clock::now();
-		auto mseconds = std::chrono::duration_cast<std::chrono::milliseconds>(current.time_since_epoch()).count() % 1000;
+		auto level = record.level;
+		const char *tag = record.tag;
 
-		// Obtain current hours/minutes/seconds
-		std::time_t time = std::time(nullptr);
+		// Obtain the time of the log in milliseconds
+		auto mseconds = std::chrono::duration_cast<std::chrono::milliseconds>(record.time.time_since_epoch()).count() % 1000;
+
+		// Obtain hours/minutes/seconds
+		std::time_t time = std::chrono::system_clock::to_time_t(record.time);
 		std::tm local_time{};
 		::localtime_r(&time, &local_time);
 
-		ov::String log;
+		log.SetLength(0);
 
 #if OV_LOG_SHOW_FILE_NAME
-		ov::String fileName = file;
-
-		{
-			ssize_t position = fileName.IndexOfRev('/');
-
-			if (position >= 0)
-			{
-				fileName = fileName.Substring(position + 1);
-			}
-		}
+		// The directory is removed in FillRecord()
+		const char *fileName = record.file;
 #endif	// OV_LOG_SHOW_FILE_NAME
 
 #if OV_LOG_SHOW_FUNCTION_NAME
-		ov::String func = method;
+		ov::String func = record.method;
 
 		{
 			int position = func.IndexOf('(');
@@ -267,14 +714,11 @@ namespace ov
 		}
 #endif	// OV_LOG_SHOW_FUNCTION_NAME
 
-		if (show_format)
+		if (record.show_format)
 		{
-			auto tid = ov::Platform::GetThreadId();
-			auto name = ov::Platform::GetThreadName();
-
 			// log format
 			//  [<date> <time>] <tag> <log level> <thread id> | <message>
-			log.Format(
+			log.AppendFormat(
 				""
 				// color
 				"%s"
@@ -313,15 +757,15 @@ namespace ov
 #else	// DEBUG
 				1900 + local_time.tm_year, local_time.tm_mon + 1, local_time.tm_mday,
 #endif	// DEBUG
-				local_time.tm_hour, local_time.tm_min, local_time.tm_sec, mseconds,
+				local_time.tm_hour, local_time.tm_min, local_time.tm_sec, static_cast<int>(mseconds),
 				log_level[level],
-				name,
-				tid,
+				record.thread_name,
+				record.thread_id,
 				(tag[0] == '\0') ? "" : " ", tag
 
 #if OV_LOG_SHOW_FILE_NAME
 				,
-				fileName.CStr(), line
+				fileName, record.line
 #endif	// OV_LOG_SHOW_FILE_NAME
 #if OV_LOG_SHOW_FUNCTION_NAME
 				,
@@ -331,22 +775,22 @@ namespace ov
 		}
 
 		// Append messages
-		log.AppendVFormat(format, arg_list);
-		if (show_format)
+		log.Append(record.GetMessage());
+
+		if (record.show_format)
 		{
-			if (level < OVLogLevelWarning)
-			{
-				fprintf(stdout, "%s%s%s\n", color_prefix[level], log.CStr(), color_suffix[level]);
-				fflush(stdout);
-			}
-			else
-			{
-				fprintf(stderr, "%s%s%s\n", color_prefix[level], log.CStr(), color_suffix[level]);
-				fflush(stderr);
-			}
+			::fprintf((level < OVLogLevelWarning) ? stdout : stderr, "%s%s%s\n", color_prefix[level], log.CStr(), color_suffix[level]);
 		}
 
-		_log_file.Write(log.CStr());
+		_log_file.Write(log.CStr(), time, false);
+	}
+
+	void LogInternal::FlushOutput()
+	{
+		::fflush(stdout);
+		::fflush(stderr);
+
+		_log_file.Flush();
 	}
 
 	void LogInternal::SetLogPath(const char *log_path)
@@ -12,11 +12,15 @@
 #include <sys/types.h>
 #include <unistd.h>
 
+#include <array>
+#include <atomic>
 #include <chrono>
+#include <condition_variable>
 #include <cstdio>
 #include <ctime>
 #include <mutex>
 #include <regex>
+#include <thread>
 #include <unordered_map>
 
 #include "./assert.h"
@@ -32,6 +36,21 @@
 #	define OV_LOG_SHOW_FUNCTION_NAME 0
 #endif	// DEBUG
 
+// Number of records in the ring of each thread (about 28 KB per thread that writes to the LogInternal)
+#define OV_LOG_RING_SIZE 64
+// Messages longer than this are allocated separately
+#define OV_LOG_RECORD_MESSAGE_SIZE 256
+#define OV_LOG_RECORD_TAG_SIZE 64
+// File name (without the directory) and method are copied, since they are not always string literals
+// (e.g. the logs of the third party libraries)
+#define OV_LOG_RECORD_FILE_SIZE 48
+#define OV_LOG_RECORD_METHOD_SIZE 128
+// While there are pending logs, the writer thread drains the rings every this interval
+// (it sleeps until a log is written while the rings are empty)
+#define OV_LOG_WRITER_INTERVAL_MSEC 10
+// How long a critical log waits for the writer thread to finish writing
+#define OV_LOG_CRITICAL_WAIT_MSEC 100
+
 namespace ov
 {
 	class LogInternal
@@ -44,6 +63,10 @@ namespace ov
 		///
 		/// @param level Log level to display
 		void SetLogLevel(OVLogLevel level);
+		bool IsLevelEnabled(OVLogLevel level) const
+		{
+			return (_released == false) && (level >= _level);
+		}
 		void ResetEnable();
 		bool IsEnabled(const char *tag, OVLogLevel level);
 
@@ -64,10 +87,78 @@ namespace ov
 		bool SetEnable(const char *tag_regex, OVLogLevel level, bool is_enabled);
 
 		void Log(bool show_format, OVLogLevel level, const char *tag, const char *file, int line, const char *method, const char *format, va_list &arg_list);
+		// Same as Log(), but the caller has already checked whether the log is enabled
+		void Write(bool show_format, OVLogLevel level, const char *tag, const char *file, int line, const char *method, const char *format, va_list &arg_list);
 
 		void SetLogPath(const char *log_path);
 
+		// Writes the pending logs of all threads. This function MUST be called while the drain mutex is locked
+		void DrainRings();
+		bool HasPendingRecords();
+
 	protected:
+		struct LogRecord
+		{
+			std::chrono::system_clock::time_point time;
+			OVLogLevel level;
+			bool show_format;
+
+			uint64_t thread_id;
+			char thread_name[16];
+			char tag[OV_LOG_RECORD_TAG_SIZE];
+
+			char file[OV_LOG_RECORD_FILE_SIZE];
+			int line;
+#if OV_LOG_SHOW_FUNCTION_NAME
+			char method[OV_LOG_RECORD_METHOD_SIZE];
+#endif	// OV_LOG_SHOW_FUNCTION_NAME
+
+			// Allocated if the message does not fit in the message buffer (freed by the writer)
+			char *long_message;
+			char message[OV_LOG_RECORD_MESSAGE_SIZE];
+
+			const char *GetMessage() const
+			{
+				return (long_message != nullptr) ? long_message : message;
+			}
+		};
+
+		// Single producer (the owner thread), single consumer (the thread holding the drain mutex)
+		struct LogRing
+		{
+			std::array<LogRecord, OV_LOG_RING_SIZE> records;
+
+			// Written by the consumer
+			alignas(64) std::atomic<uint64_t> head{0};
+			// Written by the producer
+			alignas(64) std::atomic<uint64_t> tail{0};
+
+			// The owner thread is terminated, so the ring is removed after it is drained
+			std::atomic<bool> is_owner_exited{false};
+		};
+
+		// Rings of the current thread (a thread may log to several LogInternal instances)
+		struct ThreadRings
+		{
+			~ThreadRings();
+
+			std::vector<std::pair<const LogInternal *, std::shared_ptr<LogRing>>> ring_list;
+		};
+
+		void FillRecord(LogRecord *record, bool show_format, OVLogLevel level, const char *tag, const char *file, int line, const char *method, const char *format, va_list &arg_list);
+
+		std::shared_ptr<LogRing> GetRing();
+
+		// A writer thread is shared by all instances
+		static void StartWriterIfNeeded();
+		static void WakeUpWriter();
+		// Wakes up the writer only if it is sleeping without the timeout
+		static void WakeUpIdleWriter();
+		static void WriterThread();
+
+		void Output(const LogRecord &record, ov::String &log);
+		void FlushOutput();
+
 		// This variable is used to avoid the problem of referencing incorrect heap if the log is written after LogInternal instance is released.
 		// This situation occurs when the LogInternal instance declared static is disabled just before the OME is terminated and then logs are written by another module.
 		bool _released = false;
@@ -92,5 +183,17 @@ namespace ov
 		// key: tag
 		// value: is_enabled
 		std::unordered_map<ov::String, EnableItem> _enable_map;
+
+		// Async logging
+		std::mutex _ring_list_mutex;
+		std::vector<std::shared_ptr<LogRing>> _ring_list;
+
+		// Used by the consumer of the rings
+		std::vector<std::shared_ptr<LogRing>> _drain_ring_list;
+		std::vector<const LogRecord *> _drain_record_list;
+		ov::String _output_buffer;
+
+		// Number of debug logs dropped because the ring was full
+		std::atomic<uint64_t> _dropped_count{0};
 	};
 }  // namespace ov
\ No newline at end of file
@@ -21,7 +21,9 @@
 #include "./dump_utilities.h"
 #include "./enable_shared_from_this.h"
 #include "./error.h"
+#include "./file_range.h"
 #include "./json.h"
+#include "./json_writer.h"
 #include "./log.h"
 #include "./memory_utilities.h"
 #include "./ovdata_structure.h"
@@ -31,12 +33,15 @@
 #include "./queue.h"
 #include "./random.h"
 #include "./regex.h"
+#include "./runnable_queue.h"
 #include "./semaphore.h"
+#include "./sharded_map.h"
 #include "./singleton.h"
 #include "./stack_trace.h"
 #include "./stop_watch.h"
 #include "./string.h"
 #include "./time.h"
+#include "./timing_wheel.h"
 #include "./type.h"
 #include "./unique.h"
 #include "./url.h"
\ No newline at end of file
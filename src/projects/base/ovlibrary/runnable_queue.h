@@ -0,0 +1,213 @@
+//==============================================================================
+//
+//  OvenMediaEngine
+//
+//  Created by Getroot
+//  Copyright (c) 2022 AirenSoft. All rights reserved.
+//
+//==============================================================================
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <deque>
+#include <mutex>
+#include <vector>
+
+namespace ov
+{
+	// Items of an owner (e.g. a stream) that are processed by a worker thread in quanta
+	//
+	// The owner is enqueued to the run queue of its worker only when it becomes runnable (an item is pushed while
+	// the owner is not scheduled), not for every item. The worker takes a batch of items with PopBatch(), processes
+	// them, and then calls CompleteQuantum(): if items remain, the owner is enqueued to the tail of the run queue
+	// again (round-robin), otherwise it becomes idle until the next Push().
+	//
+	// The time each item has waited in the queue is measured when it is taken.
+	template <typename T>
+	class RunnableQueue
+	{
+	public:
+		struct Item
+		{
+			T value;
+			size_t bytes;
+			std::chrono::steady_clock::time_point enqueued_time;
+		};
+
+		struct DelayStatistics
+		{
+			int64_t average_usec = 0;
+			int64_t max_usec = 0;
+		};
+
+		// Returns true if the owner has become runnable and must be enqueued to the run queue of its worker.
+		// The item is discarded if PushLast() has been called.
+		bool Push(T value, size_t bytes = 0, size_t *queue_size = nullptr)
+		{
+			std::lock_guard<std::mutex> lock_guard(_mutex);
+
+			auto runnable = PushInternal(std::move(value), bytes);
+
+			if (queue_size != nullptr)
+			{
+				*queue_size = _items.size();
+			}
+
+			return runnable;
+		}
+
+		// Same as Push(), but the items pushed after this are discarded (e.g. end of stream)
+		bool PushLast(T value)
+		{
+			std::lock_guard<std::mutex> lock_guard(_mutex);
+
+			auto runnable = PushInternal(std::move(value), 0);
+			_is_closed = true;
+
+			return runnable;
+		}
+
+		// Moves up to max_count items to values in the order pushed.
+		// observe_delay(int64_t delay_usec) is called for each item.
+		template <typename Tobserver>
+		size_t PopBatch(size_t max_count, std::vector<T> &values, Tobserver observe_delay)
+		{
+			auto now = std::chrono::steady_clock::now();
+			size_t count = 0;
+
+			std::lock_guard<std::mutex> lock_guard(_mutex);
+
+			while ((count < max_count) && (_items.empty() == false))
+			{
+				auto &item = _items.front();
+				auto delay_usec = std::chrono::duration_cast<std::chrono::microseconds>(now - item.enqueued_time).count();
+
+				observe_delay(delay_usec);
+
+				_delay_max_usec = std::max(_delay_max_usec, delay_usec);
+				_delay_sum_usec += delay_usec;
+				_delay_count++;
+
+				_bytes -= item.bytes;
+				values.push_back(std::move(item.value));
+
+				_items.pop_front();
+				count++;
+			}
+
+			return count;
+		}
+
+		size_t PopBatch(size_t max_count, std::vector<T> &values)
+		{
+			return PopBatch(max_count, values, [](int64_t delay_usec) {});
+		}
+
+		// Returns true if there are more items to process (the owner must be enqueued to the run queue again)
+		bool CompleteQuantum()
+		{
+			std::lock_guard<std::mutex> lock_guard(_mutex);
+
+			if (_items.empty())
+			{
+				_is_scheduled = false;
+				return false;
+			}
+
+			return true;
+		}
+
+		void Clear()
+		{
+			std::lock_guard<std::mutex> lock_guard(_mutex);
+
+			_items.clear();
+			_bytes = 0;
+		}
+
+		// Calls function(std::deque<Item> &items) while holding the lock (e.g. to drop some of the items)
+		template <typename Tfunction>
+		void Modify(Tfunction function)
+		{
+			std::lock_guard<std::mutex> lock_guard(_mutex);
+
+			function(_items);
+
+			_bytes = 0;
+			for (const auto &item : _items)
+			{
+				_bytes += item.bytes;
+			}
+		}
+
+		size_t GetSize() const
+		{
+			std::lock_guard<std::mutex> lock_guard(_mutex);
+			return _items.size();
+		}
+
+		size_t GetPeakSize() const
+		{
+			std::lock_guard<std::mutex> lock_guard(_mutex);
+			return _peak_size;
+		}
+
+		size_t GetBytes() const
+		{
+			std::lock_guard<std::mutex> lock_guard(_mutex);
+			return _bytes;
+		}
+
+		// Returns the queue delay of the items taken since the last call
+		DelayStatistics TakeDelayStatistics()
+		{
+			std::lock_guard<std::mutex> lock_guard(_mutex);
+
+			DelayStatistics statistics;
+			statistics.average_usec = (_delay_count > 0) ? (_delay_sum_usec / _delay_count) : 0;
+			statistics.max_usec = _delay_max_usec;
+
+			_delay_max_usec = 0;
+			_delay_sum_usec = 0;
+			_delay_count = 0;
+
+			return statistics;
+		}
+
+	private:
+		bool PushInternal(T value, size_t bytes)
+		{
+			if (_is_closed)
+			{
+				return false;
+			}
+
+			_items.push_back(Item{std::move(value), bytes, std::chrono::steady_clock::now()});
+			_bytes += bytes;
+			_peak_size = std::max(_peak_size, _items.size());
+
+			if (_is_scheduled)
+			{
+				// A worker will pick up the item in the current (or next) quantum
+				return false;
+			}
+
+			_is_scheduled = true;
+			return true;
+		}
+
+		mutable std::mutex _mutex;
+		std::deque<Item> _items;
+		size_t _bytes = 0;
+		size_t _peak_size = 0;
+
+		// Whether the owner is in the run queue or being processed by a worker
+		bool _is_scheduled = false;
+		bool _is_closed = false;
+
+		int64_t _delay_max_usec = 0;
+		int64_t _delay_sum_usec = 0;
+		int64_t _delay_count = 0;
+	};
+}  // namespace ov
@@ -0,0 +1,273 @@
+//==============================================================================
+//
+//  OvenMediaEngine
+//
+//  Created by Hyunjun Jang
+//  Copyright (c) 2022 AirenSoft. All rights reserved.
+//
+//==============================================================================
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+
+namespace ov
+{
+	// Hash map split into shards, each of which is published as an immutable snapshot
+	//
+	// - Find() reads the current snapshot of a shard without taking any mutex or touching a reference count.
+	//   A reader only increments/decrements the reader counter of the current epoch of the shard (lock-free).
+	// - Set()/Erase() copy the shard under the mutex of the shard and publish the new snapshot by exchanging an
+	//   atomic pointer (RCU-like). Before the replaced snapshot is deleted, the writer flips the epoch of the shard
+	//   twice and waits until the reader counters of both epochs drain, so no reader can still be using it.
+	//
+	// This is suitable for tables that are read for every packet but rarely modified (e.g. per session).
+	template <typename Tkey, typename Tvalue, typename Thash = std::hash<Tkey>, typename Tequal = std::equal_to<Tkey>, size_t Tshard_count = 16>
+	class ShardedMap
+	{
+	public:
+		using Map = std::unordered_map<Tkey, Tvalue, Thash, Tequal>;
+
+		ShardedMap()
+		{
+			for (auto &shard : _shards)
+			{
+				shard.map.store(new Map());
+			}
+		}
+
+		~ShardedMap()
+		{
+			for (auto &shard : _shards)
+			{
+				delete shard.map.load();
+			}
+		}
+
+		ShardedMap(const ShardedMap &) = delete;
+		ShardedMap &operator=(const ShardedMap &) = delete;
+
+		bool Find(const Tkey &key, Tvalue *value) const
+		{
+			return Read(GetShard(key), [&](const Map &map) -> bool {
+				auto item = map.find(key);
+				if (item == map.end())
+				{
+					return false;
+				}
+
+				if (value != nullptr)
+				{
+					*value = item->second;
+				}
+
+				return true;
+			});
+		}
+
+		bool Contains(const Tkey &key) const
+		{
+			return Find(key, nullptr);
+		}
+
+		// Inserts or replaces
+		void Set(const Tkey &key, const Tvalue &value)
+		{
+			auto &shard = GetShard(key);
+			std::lock_guard<std::mutex> lock(shard.mutex);
+
+			auto map = new Map(*shard.map.load());
+			(*map)[key] = value;
+
+			Publish(shard, map);
+		}
+
+		// Returns false if the key already exists
+		bool Insert(const Tkey &key, const Tvalue &value)
+		{
+			auto &shard = GetShard(key);
+			std::lock_guard<std::mutex> lock(shard.mutex);
+
+			auto current_map = shard.map.load();
+
+			if (current_map->find(key) != current_map->end())
+			{
+				return false;
+			}
+
+			auto map = new Map(*current_map);
+			map->emplace(key, value);
+
+			Publish(shard, map);
+
+			return true;
+		}
+
+		bool Erase(const Tkey &key)
+		{
+			auto &shard = GetShard(key);
+			std::lock_guard<std::mutex> lock(shard.mutex);
+
+			auto current_map = shard.map.load();
+
+			if (current_map->find(key) == current_map->end())
+			{
+				return false;
+			}
+
+			auto map = new Map(*current_map);
+			map->erase(key);
+
+			Publish(shard, map);
+
+			return true;
+		}
+
+		// Erases the item only if the value is the same
+		bool Erase(const Tkey &key, const Tvalue &value)
+		{
+			auto &shard = GetShard(key);
+			std::lock_guard<std::mutex> lock(shard.mutex);
+
+			auto current_map = shard.map.load();
+
+			auto item = current_map->find(key);
+			if ((item == current_map->end()) || (item->second != value))
+			{
+				return false;
+			}
+
+			auto map = new Map(*current_map);
+			map->erase(key);
+
+			Publish(shard, map);
+
+			return true;
+		}
+
+		// Iterates the snapshots of the shards, stops if the function returns false
+		//
+		// The function must not modify this map (the writer would wait for the function to return).
+		void Iterate(const std::function<bool(const Tkey &key, const Tvalue &value)> &function) const
+		{
+			for (const auto &shard : _shards)
+			{
+				auto next = Read(shard, [&](const Map &map) -> bool {
+					for (const auto &item : map)
+					{
+						if (function(item.first, item.second) == false)
+						{
+							return false;
+						}
+					}
+
+					return true;
+				});
+
+				if (next == false)
+				{
+					return;
+				}
+			}
+		}
+
+		size_t GetCount() const
+		{
+			size_t count = 0;
+
+			for (const auto &shard : _shards)
+			{
+				count += Read(shard, [](const Map &map) -> size_t {
+					return map.size();
+				});
+			}
+
+			return count;
+		}
+
+		void Clear()
+		{
+			for (auto &shard : _shards)
+			{
+				std::lock_guard<std::mutex> lock(shard.mutex);
+				Publish(shard, new Map());
+			}
+		}
+
+	protected:
+		// Each shard is placed in its own cache line to avoid false sharing between shards
+		struct alignas(64) Shard
+		{
+			// Serializes the writers of the shard
+			std::mutex mutex;
+			// Current snapshot (immutable once published)
+			std::atomic<const Map *> map{nullptr};
+			// The readers register to the counter of the current epoch (0 or 1)
+			std::atomic<uint32_t> epoch{0};
+			mutable std::atomic<uint32_t> reader_counts[2]{{0}, {0}};
+		};
+
+		size_t GetShardIndex(const Tkey &key) const
+		{
+			auto hash = Thash{}(key);
+
+			// Mix the upper bits since the lower bits of some hashes (e.g. integers) are not distributed
+			return (hash ^ (hash >> 16)) % Tshard_count;
+		}
+
+		Shard &GetShard(const Tkey &key)
+		{
+			return _shards[GetShardIndex(key)];
+		}
+
+		const Shard &GetShard(const Tkey &key) const
+		{
+			return _shards[GetShardIndex(key)];
+		}
+
+		// Calls function(const Map &map) with the current snapshot of the shard
+		template <typename Tfunction>
+		auto Read(const Shard &shard, Tfunction function) const
+		{
+			// The snapshot must be loaded after registering as a reader (both are seq_cst), so that the writer that
+			// replaces the snapshot after this load observes the registration
+			auto &reader_count = shard.reader_counts[shard.epoch.load() & 1];
+			reader_count.fetch_add(1);
+
+			auto result = function(*shard.map.load());
+
+			reader_count.fetch_sub(1, std::memory_order_release);
+
+			return result;
+		}
+
+		// Must be called while holding shard.mutex
+		void Publish(Shard &shard, const Map *map)
+		{
+			auto old_map = shard.map.exchange(map);
+
+			// A reader that loaded old_map has registered to one of the counters before the exchange above.
+			// A reader may have registered to the counter of the previous epoch (it read the epoch before the flip),
+			// so wait for both counters. The new readers register to the other counter, so each counter drains.
+			for (int phase = 0; phase < 2; phase++)
+			{
+				auto epoch = shard.epoch.load(std::memory_order_relaxed);
+				shard.epoch.store(epoch ^ 1);
+
+				while (shard.reader_counts[epoch & 1].load(std::memory_order_acquire) != 0)
+				{
+					std::this_thread::yield();
+				}
+			}
+
+			delete old_map;
+		}
+
+		std::array<Shard, Tshard_count> _shards;
+	};
+}  // namespace ov
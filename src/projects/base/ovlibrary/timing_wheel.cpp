@@ -0,0 +1,425 @@
+//==============================================================================
+//
+//  OvenMediaEngine
+//
+//  Created by Hyunjun Jang
+//  Copyright (c) 2022 AirenSoft. All rights reserved.
+//
+//==============================================================================
+#include "./timing_wheel.h"
+
+#include <pthread.h>
+
+#include "./log.h"
+#include "./ovlibrary_private.h"
+
+namespace ov
+{
+	TimingWheel::TimingWheel(const char *name, int tick_msec)
+		: _name(name),
+		  _tick_msec(std::max(tick_msec, 1)),
+		  _start_time(std::chrono::steady_clock::now())
+	{
+	}
+
+	TimingWheel::~TimingWheel()
+	{
+		Stop();
+
+		// Release the timers that are still scheduled
+		std::vector<std::shared_ptr<Timer>> timer_list;
+
+		{
+			std::lock_guard<std::mutex> lock(_mutex);
+
+			for (auto &wheel : _wheels)
+			{
+				for (auto &head : wheel)
+				{
+					while (head != nullptr)
+					{
+						auto timer = head;
+						Unlink(timer);
+						timer_list.push_back(std::move(timer->_self));
+					}
+				}
+			}
+		}
+	}
+
+	int64_t TimingWheel::GetElapsedUsec() const
+	{
+		return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - _start_time).count();
+	}
+
+	uint64_t TimingWheel::GetCurrentTick() const
+	{
+		return static_cast<uint64_t>(GetElapsedUsec()) / (_tick_msec * 1000ULL);
+	}
+
+	uint64_t TimingWheel::GetExpireTick(int after_msec) const
+	{
+		// Round up so that the timer never expires earlier than after_msec
+		auto expire_usec = static_cast<uint64_t>(GetElapsedUsec()) + static_cast<uint64_t>(std::max(after_msec, 0)) * 1000ULL;
+		auto tick_usec = _tick_msec * 1000ULL;
+
+		return (expire_usec + tick_usec - 1) / tick_usec;
+	}
+
+	void TimingWheel::Link(Timer *timer)
+	{
+		auto expire_tick = std::max(timer->_expire_tick, _current_tick);
+		auto delta = expire_tick - _current_tick;
+
+		int wheel_index = 0;
+
+		// Find the finest wheel that can hold the timer
+		while ((wheel_index < (WheelCount - 1)) && (delta >= (1ULL << (WheelBits * (wheel_index + 1)))))
+		{
+			wheel_index++;
+		}
+
+		if (delta >= (1ULL << (WheelBits * WheelCount)))
+		{
+			// Longer than the whole wheels can hold
+			expire_tick = _current_tick + (1ULL << (WheelBits * WheelCount)) - 1;
+		}
+
+		timer->_expire_tick = expire_tick;
+
+		auto &head = _wheels[wheel_index][(expire_tick >> (WheelBits * wheel_index)) & WheelMask];
+
+		timer->_slot_head = &head;
+		timer->_prev = nullptr;
+		timer->_next = head;
+
+		if (head != nullptr)
+		{
+			head->_prev = timer;
+		}
+
+		head = timer;
+
+		timer->_scheduled = true;
+		_count++;
+	}
+
+	void TimingWheel::Unlink(Timer *timer)
+	{
+		if (timer->_prev != nullptr)
+		{
+			timer->_prev->_next = timer->_next;
+		}
+		else
+		{
+			*(timer->_slot_head) = timer->_next;
+		}
+
+		if (timer->_next != nullptr)
+		{
+			timer->_next->_prev = timer->_prev;
+		}
+
+		timer->_slot_head = nullptr;
+		timer->_prev = nullptr;
+		timer->_next = nullptr;
+
+		timer->_scheduled = false;
+		_count--;
+	}
+
+	void TimingWheel::Cascade(int wheel_index, int slot_index)
+	{
+		auto timer = _wheels[wheel_index][slot_index];
+
+		while (timer != nullptr)
+		{
+			auto next = timer->_next;
+
+			Unlink(timer);
+			// Since _current_tick has advanced, the timer goes into a finer wheel
+			Link(timer);
+
+			timer = next;
+		}
+	}
+
+	void TimingWheel::CollectExpired(uint64_t now_tick, std::vector<std::shared_ptr<Timer>> *expired_list)
+	{
+		while (_current_tick <= now_tick)
+		{
+			if (_count == 0)
+			{
+				// Nothing to process
+				_current_tick = now_tick + 1;
+				break;
+			}
+
+			auto slot_index = _current_tick & WheelMask;
+
+			if (slot_index == 0)
+			{
+				// The finest wheel wrapped around, move the timers of the next slot of the coarser wheels down
+				for (int wheel_index = 1; wheel_index < WheelCount; wheel_index++)
+				{
+					auto index = (_current_tick >> (WheelBits * wheel_index)) & WheelMask;
+
+					Cascade(wheel_index, index);
+
+					if (index != 0)
+					{
+						break;
+					}
+				}
+			}
+
+			auto &head = _wheels[0][slot_index];
+
+			while (head != nullptr)
+			{
+				auto timer = head;
+				Unlink(timer);
+				expired_list->push_back(std::move(timer->_self));
+			}
+
+			_current_tick++;
+		}
+	}
+
+	TimingWheel::TimerHandle TimingWheel::Schedule(std::function<DelayQueueAction()> function, int after_msec)
+	{
+		auto timer = std::make_shared<Timer>();
+
+		timer->_function = std::move(function);
+		timer->_interval_msec = after_msec;
+
+		auto expire_tick = GetExpireTick(after_msec);
+
+		{
+			std::lock_guard<std::mutex> lock(_mutex);
+
+			timer->_expire_tick = expire_tick;
+			timer->_self = timer;
+			Link(timer.get());
+		}
+
+		if ((_stop == false) && (expire_tick < _wakeup_tick))
+		{
+			// The thread is sleeping longer than the timer
+			_event.SetEvent();
+		}
+
+		return timer;
+	}
+
+	bool TimingWheel::Reschedule(const TimerHandle &timer, int after_msec)
+	{
+		if ((timer == nullptr) || timer->_cancelled)
+		{
+			return false;
+		}
+
+		auto expire_tick = GetExpireTick(after_msec);
+
+		{
+			std::lock_guard<std::mutex> lock(_mutex);
+
+			if (timer->_scheduled)
+			{
+				Unlink(timer.get());
+			}
+
+			timer->_interval_msec = after_msec;
+			timer->_expire_tick = expire_tick;
+			timer->_self = timer;
+			Link(timer.get());
+		}
+
+		if ((_stop == false) && (expire_tick < _wakeup_tick))
+		{
+			_event.SetEvent();
+		}
+
+		return true;
+	}
+
+	bool TimingWheel::Cancel(const TimerHandle &timer)
+	{
+		if (timer == nullptr)
+		{
+			return false;
+		}
+
+		// If the function of the timer is being called, it will not be scheduled again
+		timer->_cancelled = true;
+
+		// Release the function outside of the lock since it may hold the last reference of other objects
+		std::shared_ptr<Timer> self;
+
+		{
+			std::lock_guard<std::mutex> lock(_mutex);
+
+			if (timer->_scheduled == false)
+			{
+				return false;
+			}
+
+			Unlink(timer.get());
+			self = std::move(timer->_self);
+		}
+
+		return true;
+	}
+
+	size_t TimingWheel::Advance()
+	{
+		std::vector<std::shared_ptr<Timer>> expired_list;
+
+		{
+			std::lock_guard<std::mutex> lock(_mutex);
+
+			CollectExpired(GetCurrentTick(), &expired_list);
+		}
+
+		if (expired_list.empty())
+		{
+			return 0;
+		}
+
+		std::vector<std::shared_ptr<Timer>> repeat_list;
+
+		for (auto &timer : expired_list)
+		{
+			if (timer->_cancelled)
+			{
+				continue;
+			}
+
+			if (timer->_function() == DelayQueueAction::Repeat)
+			{
+				repeat_list.push_back(timer);
+			}
+		}
+
+		if (repeat_list.empty() == false)
+		{
+			std::lock_guard<std::mutex> lock(_mutex);
+
+			for (auto &timer : repeat_list)
+			{
+				// Cancel() or Reschedule() may be called while the function is being called
+				if (timer->_cancelled || timer->_scheduled)
+				{
+					continue;
+				}
+
+				timer->_expire_tick = GetExpireTick(timer->_interval_msec);
+				timer->_self = timer;
+				Link(timer.get());
+			}
+		}
+
+		return expired_list.size();
+	}
+
+	int TimingWheel::GetNextTimeoutMsec(int max_msec) const
+	{
+		uint64_t next_tick;
+
+		{
+			std::lock_guard<std::mutex> lock(_mutex);
+
+			if (_count == 0)
+			{
+				return max_msec;
+			}
+
+			// Look for the first timer in the finest wheel before it wraps around.
+			// If there is none, the wheel needs to be advanced to the wrap-around point for cascading.
+			auto slot_index = _current_tick & WheelMask;
+			next_tick = _current_tick + (WheelSize - slot_index);
+
+			for (auto index = slot_index; index < WheelSize; index++)
+			{
+				if (_wheels[0][index] != nullptr)
+				{
+					next_tick = _current_tick + (index - slot_index);
+					break;
+				}
+			}
+		}
+
+		auto timeout = (static_cast<int64_t>(next_tick * _tick_msec * 1000ULL) - GetElapsedUsec() + 999) / 1000;
+
+		return static_cast<int>(std::clamp<int64_t>(timeout, 0, max_msec));
+	}
+
+	size_t TimingWheel::GetCount() const
+	{
+		std::lock_guard<std::mutex> lock(_mutex);
+
+		return _count;
+	}
+
+	bool TimingWheel::Start()
+	{
+		if (_stop == false)
+		{
+			// Already running
+			return false;
+		}
+
+		_stop = false;
+		_thread = std::thread(&TimingWheel::ThreadProc, this);
+
+		String name;
+
+		if (_name.IsEmpty())
+		{
+			name = "TW";
+		}
+		else
+		{
+			name.Format("TW%s", _name.CStr());
+		}
+
+		::pthread_setname_np(_thread.native_handle(), name.CStr());
+
+		return true;
+	}
+
+	bool TimingWheel::Stop()
+	{
+		if (_stop)
+		{
+			// Already stopped
+			return false;
+		}
+
+		_stop = true;
+		_event.SetEvent();
+
+		if (_thread.joinable())
+		{
+			_thread.join();
+		}
+
+		return true;
+	}
+
+	void TimingWheel::ThreadProc()
+	{
+		while (_stop == false)
+		{
+			// While the thread is awake, every new timer wakes it up again to recalculate the timeout
+			_wakeup_tick = UINT64_MAX;
+
+			Advance();
+
+			auto timeout = GetNextTimeoutMsec(1000);
+			_wakeup_tick = GetExpireTick(timeout);
+
+			_event.Wait(timeout);
+		}
+	}
+}  // namespace ov
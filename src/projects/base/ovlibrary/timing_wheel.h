@@ -0,0 +1,125 @@
+//==============================================================================
+//
+//  OvenMediaEngine
+//
+//  Created by Hyunjun Jang
+//  Copyright (c) 2022 AirenSoft. All rights reserved.
+//
+//==============================================================================
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "./delay_queue.h"
+#include "./event.h"
+#include "./string.h"
+
+#define OV_TIMING_WHEEL_DEFAULT_TICK_MSEC 10
+
+namespace ov
+{
+	// Hierarchical timing wheel
+	//
+	// - Schedule()/Cancel()/Reschedule() are O(1), a timer is linked into a slot of one of the wheels
+	// - Time is measured with a monotonic clock in ticks (OV_TIMING_WHEEL_DEFAULT_TICK_MSEC by default)
+	// - Advance() collects all expired timers under the lock and calls them at once without the lock
+	//
+	// There are 4 wheels of 256 slots. A timer is placed in the finest wheel that can hold it,
+	// and moved down to a finer wheel (cascading) when the finer wheel wraps around.
+	//
+	// The wheel is driven by the owner calling Advance() (e.g. SocketPoolWorker after epoll_wait()),
+	// or by its own thread after Start().
+	class TimingWheel
+	{
+	public:
+		class Timer
+		{
+		public:
+			bool IsScheduled() const
+			{
+				return _scheduled;
+			}
+
+		protected:
+			friend class TimingWheel;
+
+			std::function<DelayQueueAction()> _function;
+			int _interval_msec = 0;
+			uint64_t _expire_tick = 0;
+
+			// Links of the slot list (guarded by TimingWheel::_mutex)
+			Timer **_slot_head = nullptr;
+			Timer *_prev = nullptr;
+			Timer *_next = nullptr;
+			// The wheel keeps the timer alive while it is scheduled even if the handle is released
+			std::shared_ptr<Timer> _self;
+
+			std::atomic<bool> _scheduled{false};
+			std::atomic<bool> _cancelled{false};
+		};
+
+		using TimerHandle = std::shared_ptr<Timer>;
+
+		TimingWheel(const char *name, int tick_msec = OV_TIMING_WHEEL_DEFAULT_TICK_MSEC);
+		~TimingWheel();
+
+		// If the function returns DelayQueueAction::Repeat, the timer is scheduled again after after_msec
+		TimerHandle Schedule(std::function<DelayQueueAction()> function, int after_msec);
+		// Moves the timer to expire after after_msec from now (the repeat interval is also changed)
+		bool Reschedule(const TimerHandle &timer, int after_msec);
+		bool Cancel(const TimerHandle &timer);
+
+		// Calls the functions of the expired timers, returns the number of timers called
+		size_t Advance();
+
+		// Milliseconds until the next timer may expire (up to max_msec), used as a timeout for epoll_wait()
+		int GetNextTimeoutMsec(int max_msec) const;
+
+		size_t GetCount() const;
+
+		// Drives the wheel with its own thread
+		bool Start();
+		bool Stop();
+
+	protected:
+		static constexpr int WheelBits = 8;
+		static constexpr int WheelSize = (1 << WheelBits);
+		static constexpr uint64_t WheelMask = (WheelSize - 1);
+		static constexpr int WheelCount = 4;
+
+		int64_t GetElapsedUsec() const;
+		uint64_t GetCurrentTick() const;
+		uint64_t GetExpireTick(int after_msec) const;
+
+		// These functions MUST be called while _mutex is locked
+		void Link(Timer *timer);
+		void Unlink(Timer *timer);
+		void Cascade(int wheel_index, int slot_index);
+		void CollectExpired(uint64_t now_tick, std::vector<std::shared_ptr<Timer>> *expired_list);
+
+		void ThreadProc();
+
+		String _name;
+		int _tick_msec;
+		std::chrono::steady_clock::time_point _start_time;
+
+		mutable std::mutex _mutex;
+		// Head of the timer list of each slot
+		Timer *_wheels[WheelCount][WheelSize] = {};
+		// The next tick to process
+		uint64_t _current_tick = 0;
+		size_t _count = 0;
+
+		std::thread _thread;
+		std::atomic<bool> _stop{true};
+		Event _event;
+		// The tick at which the thread will wake up
+		std::atomic<uint64_t> _wakeup_tick{0};
+	};
+}  // namespace ov
@@ -18,22 +18,34 @@ namespace ov
 	public:
 		static std::shared_ptr<ov::Data> CompressGzip(const std::shared_ptr<ov::Data> &input)
 		{
-			auto output = std::make_shared<ov::Data>(input->GetLength());
-			output->SetLength(input->GetLength());
-
 			z_stream zs;
 			zs.zalloc = Z_NULL;
 			zs.zfree = Z_NULL;
 			zs.opaque = Z_NULL;
+
+			if (deflateInit2(&zs, Z_DEFAULT_COMPRESSION, Z_DEFLATED, 15 | 16, 8, Z_DEFAULT_STRATEGY) != Z_OK)
+			{
+				return nullptr;
+			}
+
+			// The output can be larger than the input if the input is not compressible
+			auto output_length = deflateBound(&zs, input->GetLength());
+			auto output = std::make_shared<ov::Data>(output_length);
+			output->SetLength(output_length);
+
 			zs.avail_in = (uInt)input->GetLength();
 			zs.next_in = (Bytef *)input->GetDataAs<Bytef>();
 			zs.avail_out = (uInt)output->GetLength();
-			zs.next_out = (Bytef *)output->GetWritableDataAs<Bytef>();;
+			zs.next_out = (Bytef *)output->GetWritableDataAs<Bytef>();
 
-			deflateInit2(&zs, Z_DEFAULT_COMPRESSION, Z_DEFLATED, 15 | 16, 8, Z_DEFAULT_STRATEGY);
-			deflate(&zs, Z_FINISH);
+			auto result = deflate(&zs, Z_FINISH);
 			deflateEnd(&zs);
 
+			if (result != Z_STREAM_END)
+			{
+				return nullptr;
+			}
+
 			output->SetLength(zs.total_out);
 			return output;
 		}
@@ -8,6 +8,7 @@
 //==============================================================================
 #include "server_socket.h"
 
+#include <linux/filter.h>
 #include <netinet/tcp.h>
 
 #include "client_socket.h"
@@ -92,7 +93,10 @@ namespace ov
 
 			logad("Trying to allocate a socket for client: %s", remote_address.ToString(false).CStr());
 
-			auto client = _pool->AllocSocket<ClientSocket>(remote_address.GetFamily(), GetSharedPtrAs<ServerSocket>(), client_socket, remote_address);
+			auto client = _reuse_port
+							  // Keep the client on the same thread as the listener
+							  ? _pool->AllocSocketOnWorker<ClientSocket>(GetSocketPoolWorker(), remote_address.GetFamily(), GetSharedPtrAs<ServerSocket>(), client_socket, remote_address)
+							  : _pool->AllocSocket<ClientSocket>(remote_address.GetFamily(), GetSharedPtrAs<ServerSocket>(), client_socket, remote_address);
 
 			if (client != nullptr)
 			{
@@ -120,6 +124,36 @@ namespace ov
 		}
 	}
 
+	bool ServerSocket::AttachCpuSteeringProgram(int group_size)
+	{
+		if ((_reuse_port == false) || (GetType() != SocketType::Tcp) || (group_size <= 0))
+		{
+			return false;
+		}
+
+		sock_filter code[] = {
+			// A = <The CPU that is processing the packet>
+			{BPF_LD | BPF_W | BPF_ABS, 0, 0, static_cast<uint32_t>(SKF_AD_OFF + SKF_AD_CPU)},
+			// A = A % group_size
+			{BPF_ALU | BPF_MOD | BPF_K, 0, 0, static_cast<uint32_t>(group_size)},
+			// Returns the index of the listener in the group
+			{BPF_RET | BPF_A, 0, 0, 0}};
+
+		sock_fprog program = {
+			.len = OV_COUNTOF(code),
+			.filter = code};
+
+		if (SetSockOpt(SOL_SOCKET, SO_ATTACH_REUSEPORT_CBPF, &program, sizeof(program)) == false)
+		{
+			logaw("Could not attach CPU steering program (group size: %d)", group_size);
+			return false;
+		}
+
+		logad("CPU steering program is attached (group size: %d)", group_size);
+
+		return true;
+	}
+
 	bool ServerSocket::OnClientDisconnected(const std::shared_ptr<ClientSocket> &client)
 	{
 		std::lock_guard lock_guard(_client_list_mutex);
@@ -180,6 +214,12 @@ namespace ov
 			case SocketType::Tcp: {
 				result &= SetSockOpt<int>(SO_REUSEADDR, 1);
 
+				if (_reuse_port)
+				{
+					// Each worker binds its own listener to the same address
+					result &= SetSockOpt<int>(SO_REUSEPORT, 1);
+				}
+
 				// Disable Nagle's algorithm
 				result &= SetSockOpt<int>(IPPROTO_TCP, TCP_NODELAY, 1);
 
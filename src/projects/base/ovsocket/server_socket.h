@@ -48,6 +48,24 @@ namespace ov
 
 		std::shared_ptr<ClientSocket> Accept();
 
+		// Binds with SO_REUSEPORT, so each worker can have its own listener for the same address.
+		// Accepted clients are processed on the worker of this listener without cross-thread handoff.
+		// Must be called before Prepare()
+		void SetReusePort(bool reuse_port)
+		{
+			_reuse_port = reuse_port;
+		}
+
+		bool IsReusePort() const
+		{
+			return _reuse_port;
+		}
+
+		// Attaches a classic BPF program to the SO_REUSEPORT group that selects the listener by the CPU
+		// which received the connection (<CPU> % group_size).
+		// The listeners are indexed in the order they called listen(), so this must be called after all listeners are prepared
+		bool AttachCpuSteeringProgram(int group_size);
+
 		String ToString() const override;
 
 	protected:
@@ -95,5 +113,7 @@ namespace ov
 
 		ClientConnectionCallback _connection_callback = nullptr;
 		ClientDataCallback _data_callback = nullptr;
+
+		bool _reuse_port = false;
 	};
 }  // namespace ov
@@ -10,8 +10,10 @@
 
 #include <arpa/inet.h>
 #include <errno.h>
+#include <linux/tls.h>
 #include <sys/fcntl.h>
 #include <sys/ioctl.h>
+#include <sys/sendfile.h>
 #include <unistd.h>
 
 #include <algorithm>
@@ -875,6 +877,10 @@ namespace ov
 				sent_bytes = SendToInternal(command.address, data);
 				break;
 
+			case DispatchCommand::Type::SendFile:
+				sent_bytes = SendFileInternal(command.file_range);
+				break;
+
 			case DispatchCommand::Type::HalfClose:
 				return HalfClose();
 
@@ -900,7 +906,10 @@ namespace ov
 			}
 		}
 
-		if (sent_bytes == static_cast<ssize_t>(command.data->GetLength()))
+		auto &file_range = command.file_range;
+		size_t length_to_send = (file_range != nullptr) ? file_range->GetLength() : data->GetLength();
+
+		if (sent_bytes == static_cast<ssize_t>(length_to_send))
 		{
 			return DispatchResult::Dispatched;
 		}
@@ -914,9 +923,17 @@ namespace ov
 		{
 			// Since some data has been sent, the time needs to be updated.
 			command.UpdateTime();
-			data = data->Subdata(sent_bytes);
 
-			logad("Part of the data has been sent: %ld bytes, left: %ld bytes (%s)", sent_bytes, data->GetLength(), command.ToString().CStr());
+			if (file_range != nullptr)
+			{
+				file_range = file_range->Subrange(sent_bytes);
+			}
+			else
+			{
+				data = data->Subdata(sent_bytes);
+			}
+
+			logad("Part of the data has been sent: %ld bytes, left: %ld bytes (%s)", sent_bytes, length_to_send - sent_bytes, command.ToString().CStr());
 		}
 		else
 		{
@@ -1169,6 +1186,89 @@ namespace ov
 		return total_sent;
 	}
 
+	ssize_t Socket::SendFileInternal(const std::shared_ptr<const FileRange> &file_range)
+	{
+		if (GetState() == SocketState::Closed)
+		{
+			return -1L;
+		}
+
+		if (GetType() != SocketType::Tcp)
+		{
+			logac("Could not send file - sendfile() is only available for TCP socket");
+			OV_ASSERT2(false);
+			return -1L;
+		}
+
+		off_t offset = file_range->GetOffset();
+		size_t remained = file_range->GetLength();
+		size_t total_sent = 0L;
+
+		logap("Trying to send file %zu bytes...", remained);
+
+		while ((remained > 0L) && (_force_stop == false))
+		{
+			// sendfile() updates the offset
+			ssize_t sent = ::sendfile(GetNativeHandle(), file_range->GetNativeHandle(), &offset, remained);
+
+			if (sent < 0L)
+			{
+				auto error = Error::CreateErrorFromErrno();
+
+				switch (error->GetCode())
+				{
+					case EAGAIN:
+						// Socket buffer is full - retry later
+						STATS_COUNTER_INCREASE_RETRY();
+						return total_sent;
+
+					case EINTR:
+						continue;
+
+					case EBADF:
+						// Socket is closed somewhere in OME
+						break;
+
+					case EPIPE:
+						// Broken pipe - maybe peer is disconnected
+						break;
+
+					case ECONNRESET:
+						// Connection reset - maybe peer is disconnected
+						break;
+
+					default:
+						logaw("Could not send file: %zd (%s), %s", sent, error->What(), ToString().CStr());
+						break;
+				}
+
+				STATS_COUNTER_INCREASE_ERROR();
+
+				return sent;
+			}
+
+			if (sent == 0L)
+			{
+				// The file is truncated
+				logaw("Could not send file: unexpected end of file (%s), %s", file_range->ToString().CStr(), ToString().CStr());
+				STATS_COUNTER_INCREASE_ERROR();
+				return -1L;
+			}
+
+			OV_ASSERT2(static_cast<ssize_t>(remained) >= sent);
+
+			STATS_COUNTER_INCREASE_PPS();
+
+			remained -= sent;
+			total_sent += sent;
+
+			UpdateLastSentTime();
+		}
+
+		logap("%zu bytes sent (sendfile)", total_sent);
+		return total_sent;
+	}
+
 	ssize_t Socket::SendToInternal(const SocketAddress &address, const std::shared_ptr<const Data> &data)
 	{
 		if (GetState() == SocketState::Closed)
@@ -1368,6 +1468,103 @@ namespace ov
 		return Send((data == nullptr) ? nullptr : std::make_shared<Data>(data, length));
 	}
 
+	bool Socket::SendFile(const std::shared_ptr<const FileRange> &file_range)
+	{
+		switch (GetState())
+		{
+			case SocketState::Closed:
+				[[fallthrough]];
+			case SocketState::Disconnected:
+				[[fallthrough]];
+			case SocketState::Error:
+				return false;
+
+			default:
+				break;
+		}
+
+		if (file_range == nullptr)
+		{
+			OV_ASSERT2(file_range != nullptr);
+			return false;
+		}
+
+		if (GetType() != SocketType::Tcp)
+		{
+			logae("Could not send file - sendfile() is only available for TCP socket: %s", ToString().CStr());
+			return false;
+		}
+
+		switch (_blocking_mode)
+		{
+			case BlockingMode::Blocking:
+				return (SendFileInternal(file_range) == static_cast<ssize_t>(file_range->GetLength()));
+
+			case BlockingMode::NonBlocking:
+				CHECK_STATE(== SocketState::Connected, false);
+
+				// Keep the order with the data that is already queued
+				if (AppendCommand({file_range}))
+				{
+					switch (DispatchEvents())
+					{
+						case DispatchResult::Dispatched:
+							break;
+
+						case DispatchResult::PartialDispatched:
+							_worker->EnqueueToDispatchLater(GetSharedPtr());
+							break;
+
+						case DispatchResult::Error:
+							return false;
+					}
+
+					return true;
+				}
+
+				return false;
+		}
+
+		return false;
+	}
+
+	std::shared_ptr<const SocketError> Socket::EnableKernelTlsTx(const void *crypto_info, socklen_t crypto_info_length)
+	{
+		CHECK_STATE(== SocketState::Connected, SocketError::CreateError("Invalid state: %s", StringFromSocketState(GetState())));
+
+		if (GetType() != SocketType::Tcp)
+		{
+			return SocketError::CreateError("kTLS is only available for TCP socket");
+		}
+
+		// Prevents other threads from queueing data while the TX state is being changed
+		std::lock_guard lock_guard(_dispatch_queue_lock);
+
+		if (_dispatch_queue.empty() == false)
+		{
+			// The queued data is already encrypted in the user space, so the kernel must not encrypt it again
+			return SocketError::CreateError("There are %zu commands that are not sent yet", _dispatch_queue.size());
+		}
+
+		if (::setsockopt(GetNativeHandle(), IPPROTO_TCP, TCP_ULP, "tls", sizeof("tls")) != 0)
+		{
+			// ENOENT: The "tls" kernel module is not loaded
+			return SocketError::CreateError(Error::CreateErrorFromErrno());
+		}
+
+		if (::setsockopt(GetNativeHandle(), SOL_TLS, TLS_TX, crypto_info, crypto_info_length) != 0)
+		{
+			// Until TLS_TX is set, the ULP passes the data through as it is
+			return SocketError::CreateError(Error::CreateErrorFromErrno());
+		}
+
+		_kernel_tls_tx_enabled = true;
+
+		logad("kTLS TX is enabled");
+
+		return nullptr;
+	}
+
 	bool Socket::SendTo(const SocketAddress &address, const std::shared_ptr<const Data> &data)
 	{
 		switch (GetState())
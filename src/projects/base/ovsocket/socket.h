@@ -177,6 +177,18 @@ namespace ov
 		bool SendTo(const SocketAddress &address, const std::shared_ptr<const Data> &data);
 		bool SendTo(const SocketAddress &address, const void *data, size_t length);
 
+		// Sends a range of a file using sendfile() without copying it into the user space (TCP only)
+		bool SendFile(const std::shared_ptr<const FileRange> &file_range);
+
+		// Installs the kernel TLS (kTLS) transmit state (struct tls12_crypto_info_*) to the socket.
+		// After this call, data passed to Send()/SendFile() is encrypted by the kernel.
+		// Fails if there is any data that is not yet handed over to the kernel (TCP only)
+		std::shared_ptr<const SocketError> EnableKernelTlsTx(const void *crypto_info, socklen_t crypto_info_length);
+		bool IsKernelTlsTxEnabled() const
+		{
+			return _kernel_tls_tx_enabled;
+		}
+
 		// When Recv is called in non-blocking mode,
 		//
 		// 1. return != nullptr: An error occurred (Include disconnecting the client)
@@ -256,6 +268,8 @@ namespace ov
 				Send = 0x01,
 				// Need to send data using sendto()
 				SendTo = 0x02,
+				// Need to send a range of a file using sendfile()
+				SendFile = 0x03,
 
 				// Need to call shutdown(SHUT_WR) (TCP only)
 				HalfClose = CLOSE_TYPE_MASK | 0x01,
@@ -278,6 +292,9 @@ namespace ov
 					case Type::SendTo:
 						return "SendTo";
 
+					case Type::SendFile:
+						return "SendFile";
+
 					case Type::HalfClose:
 						return "HalfClose";
 
@@ -306,6 +323,13 @@ namespace ov
 			{
 			}
 
+			DispatchCommand(const std::shared_ptr<const FileRange> &file_range)
+				: type(Type::SendFile),
+				  file_range(file_range),
+				  enqueued_time(std::chrono::system_clock::now())
+			{
+			}
+
 			DispatchCommand(Type type)
 				: type(type),
 				  enqueued_time(std::chrono::system_clock::now())
@@ -325,6 +349,7 @@ namespace ov
 				  new_state(another_command.new_state),
 				  address(another_command.address),
 				  data(another_command.data),
+				  file_range(another_command.file_range),
 				  enqueued_time(another_command.enqueued_time)
 			{
 			}
@@ -336,6 +361,7 @@ namespace ov
 				std::swap(new_state, another_command.new_state);
 				std::swap(address, another_command.address);
 				std::swap(data, another_command.data);
+				std::swap(file_range, another_command.file_range);
 				std::swap(enqueued_time, another_command.enqueued_time);
 			}
 
@@ -374,6 +400,11 @@ namespace ov
 					description.AppendFormat(", data: %zu bytes", data->GetLength());
 				}
 
+				if (file_range != nullptr)
+				{
+					description.AppendFormat(", file: %zu bytes", file_range->GetLength());
+				}
+
 				description.Append('>');
 
 				return description;
@@ -383,6 +414,7 @@ namespace ov
 			SocketState new_state = SocketState::Closed;
 			SocketAddress address;
 			std::shared_ptr<const Data> data;
+			std::shared_ptr<const FileRange> file_range;
 			std::chrono::time_point<std::chrono::system_clock> enqueued_time;
 		};
 
@@ -407,6 +439,7 @@ namespace ov
 
 		ssize_t SendInternal(const std::shared_ptr<const Data> &data);
 		ssize_t SendToInternal(const SocketAddress &address, const std::shared_ptr<const Data> &data);
+		ssize_t SendFileInternal(const std::shared_ptr<const FileRange> &file_range);
 
 		std::shared_ptr<SocketError> RecvInternal(void *data, size_t length, size_t *received_length);
 
@@ -488,6 +521,8 @@ namespace ov
 
 		mutable std::recursive_mutex _dispatch_queue_lock;
 		std::deque<DispatchCommand> _dispatch_queue;
+
+		bool _kernel_tls_tx_enabled = false;
 		bool _has_close_command = false;
 
 		std::atomic<bool> _connection_event_fired{false};
@@ -500,6 +500,37 @@ namespace ov
 		return ::memcmp(&_address_storage, &(address._address_storage), sizeof(_address_storage)) > 0;
 	}
 
+	size_t SocketAddress::StorageHash::operator()(const SocketAddress &address) const noexcept
+	{
+		const auto &storage = address._address_storage;
+		size_t hash = storage.ss_family;
+
+		switch (storage.ss_family)
+		{
+			case AF_INET:
+			{
+				auto sin = reinterpret_cast<const sockaddr_in *>(&storage);
+				hash = (hash * 31) + sin->sin_port;
+				hash = (hash * 31) + sin->sin_addr.s_addr;
+				break;
+			}
+
+			case AF_INET6:
+			{
+				auto sin6 = reinterpret_cast<const sockaddr_in6 *>(&storage);
+				hash = (hash * 31) + sin6->sin6_port;
+				hash = (hash * 31) + std::hash<std::string_view>{}(std::string_view(reinterpret_cast<const char *>(&(sin6->sin6_addr)), sizeof(sin6->sin6_addr)));
+				break;
+			}
+
+			default:
+				break;
+		}
+
+		// Spread the bits since the address and port are not distributed well
+		return std::hash<size_t>{}(hash * 0x9E3779B97F4A7C15ULL);
+	}
+
 	void SocketAddress::UpdateFromStorage()
 	{
 		if (IsValid())
@@ -179,6 +179,20 @@ namespace ov
 		bool operator<(const SocketAddress &address) const;
 		bool operator>(const SocketAddress &address) const;
 
+		// Compare only sockaddr (the same criteria as operator<()), used as the key of unordered containers
+		struct StorageHash
+		{
+			size_t operator()(const SocketAddress &address) const noexcept;
+		};
+
+		struct StorageEqual
+		{
+			bool operator()(const SocketAddress &address1, const SocketAddress &address2) const noexcept
+			{
+				return ::memcmp(&(address1._address_storage), &(address2._address_storage), sizeof(address1._address_storage)) == 0;
+			}
+		};
+
 		void SetFamily(SocketFamily family)
 		{
 			_address_storage.ss_family = static_cast<sa_family_t>(family);
@@ -110,6 +110,41 @@ namespace ov
 			return nullptr;
 		}
 
+		// Allocates a socket on the specified worker, so the socket is processed on the same thread as the other sockets of the worker
+		template <typename Tsocket = ov::Socket, typename... Targuments>
+		std::shared_ptr<Tsocket> AllocSocketOnWorker(const std::shared_ptr<SocketPoolWorker> &worker, const SocketFamily family, Targuments... args)
+		{
+			if (worker == nullptr)
+			{
+				OV_ASSERT2(worker != nullptr);
+				return nullptr;
+			}
+
+			worker->IncreaseSocketCount();
+
+			auto socket = worker->AllocSocket<Tsocket>(family, args...);
+
+			if (socket == nullptr)
+			{
+				// Rollback
+				worker->DecreaseSocketCount();
+			}
+
+			return socket;
+		}
+
+		std::shared_ptr<SocketPoolWorker> GetWorker(int index) const
+		{
+			std::lock_guard lock_guard(_worker_list_mutex);
+
+			if ((index < 0) || (index >= static_cast<int>(_worker_list.size())))
+			{
+				return nullptr;
+			}
+
+			return _worker_list[index];
+		}
+
 		bool ReleaseSocket(const std::shared_ptr<Socket> &socket)
 		{
 			return socket->GetSocketPoolWorker()->ReleaseSocket(socket);
@@ -73,8 +73,6 @@ namespace ov
 			return false;
 		}
 
-		_connection_callback_queue.Clear();
-
 		_stop_epoll_thread = true;
 
 		if (_epoll_thread.joinable())
@@ -96,8 +94,6 @@ namespace ov
 			_sockets_to_dispatch.clear();
 		}
 
-		_connection_timed_out_queue.clear();
-
 		_gc_candidates.clear();
 
 		OV_SAFE_FUNC(_epoll, InvalidSocket, ::close, );
@@ -235,37 +231,14 @@ namespace ov
 		}
 	}
 
-	void SocketPoolWorker::CallbackTimedOutConnections()
-	{
-		if (_connection_timed_out_queue.size() <= 0)
-		{
-			return;
-		}
-
-		_connection_timed_out_queue_mutex.lock();
-		auto timed_out_queue = std::move(_connection_timed_out_queue);
-		_connection_timed_out_queue_mutex.unlock();
-
-		auto socket_error = SocketError::CreateError("Connection timed out (by worker)");
-
-		for (auto socket : timed_out_queue)
-		{
-			if (socket->GetState() == SocketState::Connecting)
-			{
-				socket->OnConnectedEvent(socket_error);
-			}
-		}
-	}
-
 	void SocketPoolWorker::ThreadProc()
 	{
-		_connection_callback_queue.Start();
-
 		_gc_interval.Start();
 
 		while (_stop_epoll_thread == false)
 		{
-			int count = EpollWait(100);
+			// Wake up for the next timer, but timers scheduled from other threads may be delayed up to 100ms
+			int count = EpollWait(_timing_wheel.GetNextTimeoutMsec(100));
 
 			if (count < 0)
 			{
@@ -273,7 +246,8 @@ namespace ov
 			}
 			else
 			{
-				CallbackTimedOutConnections();
+				// Expired timers are called in a batch
+				_timing_wheel.Advance();
 
 				for (int index = 0; index < count; index++)
 				{
@@ -501,8 +475,6 @@ namespace ov
 			MergeSocketList();
 		}
 
-		_connection_callback_queue.Stop();
-
 		// Clean up all sockets
 		for (auto &socket_item : _socket_map)
 		{
@@ -735,13 +707,20 @@ namespace ov
 
 	void SocketPoolWorker::EnqueueToCheckConnectionTimeOut(const std::shared_ptr<Socket> &socket, int timeout_msec)
 	{
-		_connection_callback_queue.Push(
-			[=](void *parameter) -> DelayQueueAction {
-				std::lock_guard lock_guard(_connection_timed_out_queue_mutex);
-				_connection_timed_out_queue.push_back(socket);
+		std::weak_ptr<Socket> socket_ref = socket;
+
+		// Called in the epoll thread
+		_timing_wheel.Schedule(
+			[socket_ref]() -> DelayQueueAction {
+				auto socket = socket_ref.lock();
+
+				if ((socket != nullptr) && (socket->GetState() == SocketState::Connecting))
+				{
+					socket->OnConnectedEvent(SocketError::CreateError("Connection timed out (by worker)"));
+				}
+
 				return DelayQueueAction::Stop;
 			},
-			nullptr,
 			timeout_msec);
 	}
 
@@ -830,10 +809,10 @@ namespace ov
 		String description;
 
 		description.AppendFormat(
-			"<SocketPoolWorker: %p, socket_map: %zu, insert queue: %zu, delete queue: %zu, connection queue: %zu>",
+			"<SocketPoolWorker: %p, socket_map: %zu, insert queue: %zu, delete queue: %zu, timers: %zu>",
 			this, _socket_map.size(),
 			_sockets_to_insert.size(), _sockets_to_delete.size(),
-			_connection_timed_out_queue.size());
+			_timing_wheel.GetCount());
 
 		return description;
 	}
@@ -48,6 +48,12 @@ namespace ov
 
 		bool ReleaseSocket(const std::shared_ptr<Socket> &socket);
 
+		// The functions of the timers are called in the epoll thread of this worker
+		TimingWheel &GetTimingWheel()
+		{
+			return _timing_wheel;
+		}
+
 		String ToString() const;
 
 	protected:
@@ -78,8 +84,6 @@ namespace ov
 
 		void GarbageCollection();
 
-		void CallbackTimedOutConnections();
-
 		void ThreadProc();
 
 		bool AddToEpoll(const std::shared_ptr<Socket> &socket);
@@ -115,10 +119,8 @@ namespace ov
 		StopWatch _gc_interval;
 		std::map<int, std::shared_ptr<Socket>> _gc_candidates;
 
-		// A queue for handling errors such as connection timeout in nonblocking mode.
-		inline static DelayQueue _connection_callback_queue{"ConnectionCB"};
-		std::mutex _connection_timed_out_queue_mutex;
-		std::deque<std::shared_ptr<Socket>> _connection_timed_out_queue;
+		// Timers called in the epoll thread, such as connection timeout in nonblocking mode
+		TimingWheel _timing_wheel{"SocketPoolWorker"};
 
 		// Common variables
 		std::thread _epoll_thread;
@@ -144,7 +144,7 @@ namespace pvd
 		// To reduce transcoding cost when using Persistent Stream
 		if (_provider->GetProviderType() == ProviderType::Rtmp)
 		{
-			if(GetConfig().GetProviders().GetRtmpProvider().IsPassthroughOutputProfile() == true)
+			if(GetConfig()->GetProviders().GetRtmpProvider().IsPassthroughOutputProfile() == true)
 			{
 				stream->SetRepresentationType(StreamRepresentationType::Relay);
 			}
@@ -78,7 +78,8 @@ namespace pvd
 		// Check configuration
 		if(app_info.IsDynamicApp() == false)
 		{
-			auto cfg_provider_list = app_info.GetConfig().GetProviders().GetProviderList();
+			auto app_config = app_info.GetConfig();
+			auto cfg_provider_list = app_config->GetProviders().GetProviderList();
 			for(const auto &cfg_provider : cfg_provider_list)
 			{
 				if(cfg_provider->GetType() == GetProviderType())
@@ -139,7 +140,8 @@ namespace pvd
 			// Check the reason the app is not created is because it is disabled in the configuration
 			if(app_info.IsDynamicApp() == false)
 			{
-				auto cfg_provider_list = app_info.GetConfig().GetProviders().GetProviderList();
+				auto app_config = app_info.GetConfig();
+				auto cfg_provider_list = app_config->GetProviders().GetProviderList();
 				for(const auto &cfg_provider : cfg_provider_list)
 				{
 					if(cfg_provider->GetType() == GetProviderType())
@@ -70,10 +70,15 @@ namespace pvd
 			{
 				auto stream = std::dynamic_pointer_cast<PullStream>(x.second);
 
-				if (stream->GetState() == Stream::State::STOPPED || stream->GetState() == Stream::State::ERROR)
+				if (stream->GetResumeState() != PullStream::ResumeState::Idle)
 				{
-					// Retry
-					ResumeStream(stream);
+					// The handshake with the origin is in progress or has been finished
+					ResumeStreamAsync(stream);
+				}
+				else if (stream->GetState() == Stream::State::STOPPED || stream->GetState() == Stream::State::ERROR)
+				{
+					// Retry without waiting for the handshake, so that the other streams can be reconnected concurrently
+					ResumeStreamAsync(stream);
 				}
 				else if (stream->GetState() == Stream::State::TERMINATED)
 				{
@@ -288,6 +293,29 @@ namespace pvd
 			return false;
 		}
 
+		return OnStreamResumed(pull_stream);
+	}
+
+	void PullApplication::ResumeStreamAsync(const std::shared_ptr<PullStream> &stream)
+	{
+		if (stream->GetResumeState() == PullStream::ResumeState::Idle)
+		{
+			// Returns false until the backoff is elapsed
+			stream->ResumeAsync();
+		}
+
+		auto resume_state = stream->GetResumeState();
+		if ((resume_state == PullStream::ResumeState::Resumed) || (resume_state == PullStream::ResumeState::Failed))
+		{
+			if (stream->CompleteResume())
+			{
+				OnStreamResumed(stream);
+			}
+		}
+	}
+
+	bool PullApplication::OnStreamResumed(const std::shared_ptr<PullStream> &pull_stream)
+	{
 		auto motor = GetStreamMotorInternal(pull_stream);
 		if(motor == nullptr)
 		{
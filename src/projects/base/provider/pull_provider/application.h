@@ -50,6 +50,9 @@ namespace pvd
 
 		// Try restarting the stream for failover
 		bool ResumeStream(const std::shared_ptr<Stream> &stream);
+		// Try restarting the stream without waiting for the handshake, the result is applied in the next call
+		void ResumeStreamAsync(const std::shared_ptr<PullStream> &stream);
+		bool OnStreamResumed(const std::shared_ptr<PullStream> &pull_stream);
 		
 		bool _stop_collector_thread_flag;
 		std::thread _collector_thread;
@@ -84,13 +84,97 @@ namespace pvd
 				SetState(Stream::State::TERMINATED);
 			}
 
+			UpdateResumeBackoff(false);
+
 			return false;
 		}
 
 		_restart_count = 0;
+		UpdateResumeBackoff(true);
 		return Stream::Start();
 	}
 
+	bool PullStream::ResumeAsync()
+	{
+		if (std::chrono::steady_clock::now() < _next_resume_time)
+		{
+			return false;
+		}
+
+		auto expected = ResumeState::Idle;
+		if (_resume_state.compare_exchange_strong(expected, ResumeState::Resuming) == false)
+		{
+			return false;
+		}
+
+		auto started = RestartStreamAsync(GetNextURL(), [this](bool succeeded) {
+			_resume_state = succeeded ? ResumeState::Resumed : ResumeState::Failed;
+		});
+
+		if (started == false)
+		{
+			_resume_state = ResumeState::Failed;
+		}
+
+		return true;
+	}
+
+	PullStream::ResumeState PullStream::GetResumeState() const
+	{
+		return _resume_state;
+	}
+
+	bool PullStream::CompleteResume()
+	{
+		auto state = _resume_state.load();
+		if ((state != ResumeState::Resumed) && (state != ResumeState::Failed))
+		{
+			return false;
+		}
+
+		_resume_state = ResumeState::Idle;
+
+		if (state == ResumeState::Failed)
+		{
+			Stop();
+			_restart_count++;
+			if (_restart_count > _url_list.size() * _properties->GetRetryConnectCount())
+			{
+				SetState(Stream::State::TERMINATED);
+			}
+
+			UpdateResumeBackoff(false);
+
+			return false;
+		}
+
+		_restart_count = 0;
+		UpdateResumeBackoff(true);
+		return Stream::Start();
+	}
+
+	bool PullStream::RestartStreamAsync(const std::shared_ptr<const ov::Url> &url, std::function<void(bool succeeded)> on_completed)
+	{
+		on_completed(RestartStream(url));
+		return true;
+	}
+
+	void PullStream::UpdateResumeBackoff(bool succeeded)
+	{
+		if (succeeded)
+		{
+			_resume_backoff_ms = 0;
+			_next_resume_time = std::chrono::steady_clock::time_point();
+			return;
+		}
+
+		_resume_backoff_ms = (_resume_backoff_ms == 0) ? PULL_STREAM_RESUME_INITIAL_BACKOFF_MS : std::min<int64_t>(_resume_backoff_ms * 2, PULL_STREAM_RESUME_MAX_BACKOFF_MS);
+
+		// Spread the retries of the streams that failed at the same time (e.g. the cameras behind a switch that has been restarted)
+		auto backoff_ms = ov::Random::GenerateInt32(_resume_backoff_ms / 2, _resume_backoff_ms);
+		_next_resume_time = std::chrono::steady_clock::now() + std::chrono::milliseconds(backoff_ms);
+	}
+
 	const std::shared_ptr<const ov::Url> PullStream::GetNextURL()
 	{
 		if (_url_list.size() == 0)
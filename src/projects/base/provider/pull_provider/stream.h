@@ -13,6 +13,10 @@
 #include "base/provider/stream.h"
 #include "monitoring/monitoring.h"
 
+// Backoff of the reconnection to the origin, it is doubled on every failure up to the max
+#define PULL_STREAM_RESUME_INITIAL_BACKOFF_MS 1000
+#define PULL_STREAM_RESUME_MAX_BACKOFF_MS (30 * 1000)
+
 namespace pvd
 {
 	class Application;
@@ -34,6 +38,22 @@ namespace pvd
 		bool Stop() override;
 		bool Resume(); // Resume with another URL
 
+		enum class ResumeState : uint8_t
+		{
+			Idle,
+			// The handshake with the origin is in progress
+			Resuming,
+			Resumed,
+			Failed
+		};
+
+		// Resume with another URL without blocking the caller.
+		// Returns false if the backoff has not elapsed yet or the stream is already resuming.
+		bool ResumeAsync();
+		ResumeState GetResumeState() const;
+		// Applies the result of ResumeAsync(), returns true if the stream has been resumed
+		bool CompleteResume();
+
 		// Defines the event detection method to process media packets in Pull Stream. 
 		// There are EPOLL event method by socket and INTERVAL event method called at regular time.	
 		enum class ProcessMediaEventTrigger {
@@ -58,7 +78,13 @@ namespace pvd
 		virtual bool RestartStream(const std::shared_ptr<const ov::Url> &url) = 0; // Failover
 		virtual bool StopStream() = 0; // Stop
 
+		// Failover without blocking the caller, on_completed may be called from another thread.
+		// The default implementation calls RestartStream() synchronously.
+		virtual bool RestartStreamAsync(const std::shared_ptr<const ov::Url> &url, std::function<void(bool succeeded)> on_completed);
+
 	private:
+		void UpdateResumeBackoff(bool succeeded);
+
 		uint32_t	_restart_count = 0;
 		std::vector<std::shared_ptr<const ov::Url>> _url_list;
 		int _curr_url_index = 0;
@@ -68,6 +94,10 @@ namespace pvd
 		// It can be called by multiple thread
 		std::mutex _start_stop_stream_lock;
 
+		std::atomic<ResumeState> _resume_state{ResumeState::Idle};
+		int64_t _resume_backoff_ms = 0;
+		std::chrono::steady_clock::time_point _next_resume_time;
+
 	public:
 		const std::shared_ptr<const ov::Url> GetNextURL();
 		const std::shared_ptr<const ov::Url> GetPrimaryURL();
@@ -73,14 +73,30 @@ namespace pvd
 			return false;
 		}
 
+		if (_ingest_run_queues.empty() == false)
+		{
+			// Only append the data here, so that a heavy parser does not block the other sockets of the socket pool worker
+			if (channel->PushIngestData(data))
+			{
+				_ingest_run_queues[channel->GetChannelId() % _ingest_run_queues.size()]->Enqueue(channel);
+			}
+
+			return true;
+		}
+
+		ParseReceivedData(channel, data);
+
+		return true;
+	}
+
+	void PushProvider::ParseReceivedData(const std::shared_ptr<PushStream> &channel, const std::shared_ptr<const ov::Data> &data)
+	{
 		// In the future, 
 		// it may be necessary to send data to an application rather than sending it directly to a stream.
 		if(channel->OnDataReceived(data) == true)
 		{
 			channel->UpdateLastReceivedTime();
 		}
-
-		return true;
 	}
 
 	bool PushProvider::OnChannelDeleted(const std::shared_ptr<pvd::PushStream> &channel)
@@ -104,6 +120,23 @@ namespace pvd
 
 		lock.unlock();
 
+		if (_ingest_run_queues.empty() == false)
+		{
+			// The ingest worker may be parsing the channel now, so the stream is deleted by the worker
+			// after the data received so far (see IngestWorkerThread())
+			if (channel->PushIngestEnd())
+			{
+				_ingest_run_queues[channel->GetChannelId() % _ingest_run_queues.size()]->Enqueue(channel);
+			}
+
+			return true;
+		}
+
+		return DeleteChannelFromApplication(channel);
+	}
+
+	bool PushProvider::DeleteChannelFromApplication(const std::shared_ptr<PushStream> &channel)
+	{
 		// Delete from Application
 		if(channel->DoesBelongApplication())
 		{
@@ -174,6 +207,121 @@ namespace pvd
 		return true;
 	}
 
+	bool PushProvider::StartIngestWorkers()
+	{
+		auto &ingest_worker_config = GetServerConfig().GetModules().GetIngestWorker();
+		if (ingest_worker_config.IsEnabled() == false)
+		{
+			return true;
+		}
+
+		auto worker_count = std::max(ingest_worker_config.GetWorkerCount(), 1);
+
+		_stop_ingest_worker_flag = false;
+
+		for (int worker_id = 0; worker_id < worker_count; worker_id++)
+		{
+			auto queue_name = ov::String::FormatString("%s IngestQueue #%d", GetProviderName(), worker_id);
+			_ingest_run_queues.push_back(std::make_shared<ov::Queue<std::shared_ptr<PushStream>>>(queue_name.CStr()));
+		}
+
+		for (int worker_id = 0; worker_id < worker_count; worker_id++)
+		{
+			auto thread = std::thread(&PushProvider::IngestWorkerThread, this, worker_id);
+			pthread_setname_np(thread.native_handle(), ov::String::FormatString("Ingest%d", worker_id).CStr());
+			_ingest_worker_threads.push_back(std::move(thread));
+		}
+
+		logti("%s parses the received data with %d ingest worker(s)", GetProviderName(), worker_count);
+
+		return true;
+	}
+
+	bool PushProvider::StopIngestWorkers()
+	{
+		_stop_ingest_worker_flag = true;
+
+		for (auto &run_queue : _ingest_run_queues)
+		{
+			run_queue->Stop();
+		}
+
+		for (auto &thread : _ingest_worker_threads)
+		{
+			if (thread.joinable())
+			{
+				thread.join();
+			}
+		}
+
+		_ingest_worker_threads.clear();
+		_ingest_run_queues.clear();
+
+		return true;
+	}
+
+	void PushProvider::IngestWorkerThread(uint32_t worker_id)
+	{
+		auto run_queue = _ingest_run_queues[worker_id];
+		std::vector<std::shared_ptr<const ov::Data>> data_list;
+		data_list.reserve(PUSH_PROVIDER_INGEST_BATCH_COUNT);
+
+		while (_stop_ingest_worker_flag == false)
+		{
+			auto msg = run_queue->Dequeue(ov::Infinite);
+			if (msg.has_value() == false)
+			{
+				// It may be called due to a normal stop signal.
+				continue;
+			}
+
+			auto channel = msg.value();
+			if (channel == nullptr)
+			{
+				continue;
+			}
+
+			// Parse the channel in batches until the time slice is used up
+			ov::StopWatch time_slice;
+			time_slice.Start();
+
+			while (channel->PopIngestData(PUSH_PROVIDER_INGEST_BATCH_COUNT, data_list) > 0)
+			{
+				for (const auto &data : data_list)
+				{
+					if (data == nullptr)
+					{
+						// End marker pushed by OnChannelDeleted()
+						DeleteChannelFromApplication(channel);
+						continue;
+					}
+
+					ParseReceivedData(channel, data);
+				}
+
+				data_list.clear();
+
+				if (time_slice.IsElapsed(PUSH_PROVIDER_INGEST_TIME_SLICE_MS))
+				{
+					break;
+				}
+			}
+
+			if (channel->TakeIngestQueueOverflow())
+			{
+				// The parser cannot keep up with the input. Stopping the channel closes the connection,
+				// and then OnChannelDeleted() pushes the end marker.
+				channel->Stop();
+			}
+
+			if (channel->CompleteIngestQuantum())
+			{
+				// Round-robin: the other runnable channels are parsed before the rest of this channel
+				run_queue->Enqueue(channel);
+			}
+		}
+	}
+
 	void PushProvider::OnTimer(const std::shared_ptr<PushStream> &channel)
 	{
 		// For child function
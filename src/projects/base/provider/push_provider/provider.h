@@ -16,6 +16,11 @@
 #include "application.h"
 #include "stream.h"
 
+// Number of the received data an ingest worker takes at once
+#define PUSH_PROVIDER_INGEST_BATCH_COUNT 16
+// An ingest worker parses a stream for up to this time before moving on to the next runnable stream
+#define PUSH_PROVIDER_INGEST_TIME_SLICE_MS 5
+
 namespace pvd
 {
     class PushProvider : public Provider
@@ -53,6 +58,11 @@ namespace pvd
 
 		bool StartTimer();
 		bool StopTimer();
+
+		// If IngestWorker module is enabled, the received data is parsed by the ingest workers instead of the socket pool threads.
+		// A channel is always parsed by the same worker, so the data of a channel is parsed in order.
+		bool StartIngestWorkers();
+		bool StopIngestWorkers();
 		virtual void OnTimer(const std::shared_ptr<PushStream> &channel);
 
 		// Timer is updated when OnDataReceived is called
@@ -61,6 +71,9 @@ namespace pvd
 
     private:
 		void TimerThread();
+		void IngestWorkerThread(uint32_t worker_id);
+		void ParseReceivedData(const std::shared_ptr<PushStream> &channel, const std::shared_ptr<const ov::Data> &data);
+		bool DeleteChannelFromApplication(const std::shared_ptr<PushStream> &channel);
 
 		bool _stop_timer_thread_flag;
 		std::thread _timer_thread;
@@ -69,5 +82,10 @@ namespace pvd
 		std::shared_mutex _channels_lock;
 		// channel_id : stream
 		std::map<uint32_t, std::shared_ptr<PushStream>>	_channels;
+
+		// Ingest workers: runnable channels of each worker
+		bool _stop_ingest_worker_flag = true;
+		std::vector<std::shared_ptr<ov::Queue<std::shared_ptr<PushStream>>>> _ingest_run_queues;
+		std::vector<std::thread> _ingest_worker_threads;
     };
 }
\ No newline at end of file
@@ -13,6 +13,9 @@
 #include "stream.h"
 #include "provider_private.h"
 
+#include <monitoring/histogram.h>
+#include <monitoring/monitoring.h>
+
 namespace pvd
 {
 	PushStream::PushStream(StreamSourceType source_type, ov::String channel_name, uint32_t channel_id, const std::shared_ptr<PushProvider> &provider)
@@ -111,6 +114,84 @@ namespace pvd
 		return _is_published;
 	}
 
+	bool PushStream::PushIngestData(const std::shared_ptr<const ov::Data> &data)
+	{
+		auto queue_bytes = _ingest_queue.GetBytes();
+
+		if (queue_bytes > PUSH_STREAM_INGEST_QUEUE_LIMIT_BYTES)
+		{
+			int expected = 0;
+			if (_ingest_queue_overflow_state.compare_exchange_strong(expected, 1))
+			{
+				logte("[%s(%u)] The ingest queue is full: %zu bytes are waiting to be parsed (limit: %d), the channel will be stopped",
+					  GetName().CStr(), GetChannelId(), queue_bytes, PUSH_STREAM_INGEST_QUEUE_LIMIT_BYTES);
+			}
+
+			return false;
+		}
+
+		if (queue_bytes > PUSH_STREAM_INGEST_QUEUE_THRESHOLD_BYTES)
+		{
+			if (_is_ingest_queue_exceeded.exchange(true) == false)
+			{
+				logtw("[%s(%u)] The ingest queue is growing: %zu bytes are waiting to be parsed (threshold: %d)",
+					  GetName().CStr(), GetChannelId(), queue_bytes, PUSH_STREAM_INGEST_QUEUE_THRESHOLD_BYTES);
+			}
+		}
+		else
+		{
+			_is_ingest_queue_exceeded = false;
+		}
+
+		return _ingest_queue.Push(data, data->GetLength());
+	}
+
+	bool PushStream::PushIngestEnd()
+	{
+		return _ingest_queue.PushLast(nullptr);
+	}
+
+	size_t PushStream::PopIngestData(size_t max_count, std::vector<std::shared_ptr<const ov::Data>> &data_list)
+	{
+		auto count = _ingest_queue.PopBatch(max_count, data_list, [](int64_t parse_lag_usec) {
+			mon::GetHistogram(mon::HistogramType::IngestParseLag).ObserveUsec(parse_lag_usec);
+		});
+
+		if (_parse_lag_stop_watch.IsStart() == false)
+		{
+			_parse_lag_stop_watch.Start();
+		}
+		else if (_parse_lag_stop_watch.IsElapsed(PUSH_STREAM_INGEST_PARSE_LAG_INTERVAL_MS) && _parse_lag_stop_watch.Update())
+		{
+			UpdateIngestParseLagMetrics();
+		}
+
+		return count;
+	}
+
+	bool PushStream::CompleteIngestQuantum()
+	{
+		return _ingest_queue.CompleteQuantum();
+	}
+
+	bool PushStream::TakeIngestQueueOverflow()
+	{
+		int expected = 1;
+		return _ingest_queue_overflow_state.compare_exchange_strong(expected, 2);
+	}
+
+	void PushStream::UpdateIngestParseLagMetrics()
+	{
+		auto parse_lag = _ingest_queue.TakeDelayStatistics();
+
+		// The stream metrics exist after the stream is published
+		auto stream_metrics = StreamMetrics(*this);
+		if (stream_metrics != nullptr)
+		{
+			stream_metrics->SetIngestParseLag(parse_lag.average_usec, parse_lag.max_usec);
+		}
+	}
+
 	bool PushStream::DoesBelongApplication()
 	{
 		return GetApplication() != nullptr;
@@ -12,6 +12,15 @@
 #include <base/ovlibrary/stop_watch.h>
 #include "base/provider/stream.h"
 
+#include <atomic>
+
+// Warn if the received data waiting for the ingest worker exceeds this size (the parser cannot keep up with the input)
+#define PUSH_STREAM_INGEST_QUEUE_THRESHOLD_BYTES (8 * 1024 * 1024)
+// If the received data waiting for the ingest worker exceeds this size, the data is dropped and the channel is stopped
+#define PUSH_STREAM_INGEST_QUEUE_LIMIT_BYTES (32 * 1024 * 1024)
+// Interval to update the parse lag of StreamMetrics
+#define PUSH_STREAM_INGEST_PARSE_LAG_INTERVAL_MS 1000
+
 namespace pvd
 {
 	class PushProvider;
@@ -50,6 +59,19 @@ namespace pvd
 			return _attemps_publish_count;
 		}
 
+		// Ingest queue: the socket pool thread appends the received data, and the ingest worker of the stream parses it.
+		// Returns true if the stream becomes runnable (the caller has to schedule it to the ingest worker)
+		bool PushIngestData(const std::shared_ptr<const ov::Data> &data);
+		// Appends the end marker (nullptr) after the data received so far. The data received after this is discarded.
+		// Returns true if the stream becomes runnable
+		bool PushIngestEnd();
+		// Takes up to max_count data in the order received
+		size_t PopIngestData(size_t max_count, std::vector<std::shared_ptr<const ov::Data>> &data_list);
+		// Returns true if there is more data to be parsed (the stream remains scheduled)
+		bool CompleteIngestQuantum();
+		// Returns true only once after the received data is dropped due to PUSH_STREAM_INGEST_QUEUE_LIMIT_BYTES
+		bool TakeIngestQueueOverflow();
+
 	protected:
 		PushStream(StreamSourceType source_type, ov::String channel_name, uint32_t channel_id, const std::shared_ptr<PushProvider> &provider);
 		PushStream(StreamSourceType source_type, ov::String channel_name, const std::shared_ptr<PushProvider> &provider);
@@ -78,6 +100,16 @@ namespace pvd
 
 		uint32_t		_attemps_publish_count = 0;
 
+		void UpdateIngestParseLagMetrics();
+
+		ov::RunnableQueue<std::shared_ptr<const ov::Data>> _ingest_queue;
+		std::atomic<bool> 		_is_ingest_queue_exceeded{false};
+		// 0: not overflowed, 1: overflowed, 2: reported to the ingest worker
+		std::atomic<int> 		_ingest_queue_overflow_state{0};
+
+		// Accessed only by the ingest worker
+		ov::StopWatch 			_parse_lag_stop_watch;
+
 		// Push Provider
 		std::shared_ptr<PushProvider>	_provider;
 	};
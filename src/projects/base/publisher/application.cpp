@@ -1,6 +1,7 @@
 #include "application.h"
 
 #include <algorithm>
+#include <monitoring/histogram.h>
 
 #include "publisher.h"
 #include "publisher_private.h"
@@ -88,6 +89,8 @@ namespace pub
 			auto stream_data = PopStreamData();
 			if ((stream_data != nullptr) && (stream_data->_stream != nullptr) && (stream_data->_media_packet != nullptr))
 			{
+				mon::ObserveHistogram(mon::HistogramType::PacketQueueDelay, std::chrono::steady_clock::now() - stream_data->_enqueued_time);
+
 				if (stream_data->_media_packet->GetMediaType() == cmn::MediaType::Video)
 				{
 					stream_data->_stream->SendVideoFrame(stream_data->_media_packet);
@@ -136,7 +139,7 @@ namespace pub
 
 	bool Application::Start()
 	{
-		_application_worker_count = GetConfig().GetAppWorkerCount();
+		_application_worker_count = GetConfig()->GetAppWorkerCount();
 		if (_application_worker_count < MIN_APPLICATION_WORKER_COUNT)
 		{
 			_application_worker_count = MIN_APPLICATION_WORKER_COUNT;
@@ -204,7 +207,14 @@ namespace pub
 	// Called by MediaRouteApplicationObserver
 	bool Application::OnStreamCreated(const std::shared_ptr<info::Stream> &info)
 	{
-		auto stream_worker_count = GetConfig().GetStreamWorkerCount();
+		if (GetStream(info->GetId()) != nullptr)
+		{
+			// The stream can be notified twice if it is created while this application is being registered to the router
+			logtd("The stream already exists : %s/%u", info->GetName().CStr(), info->GetId());
+			return true;
+		}
+
+		auto stream_worker_count = GetConfig()->GetStreamWorkerCount();
 
 		auto stream = CreateStream(info, stream_worker_count);
 		if (!stream)
@@ -322,6 +332,12 @@ namespace pub
 		return _streams.size();
 	}
 
+	std::map<uint32_t, std::shared_ptr<Stream>> Application::GetStreamMap()
+	{
+		std::shared_lock<std::shared_mutex> lock(_stream_map_mutex);
+		return _streams;
+	}
+
 	std::shared_ptr<Stream> Application::GetStream(uint32_t stream_id)
 	{
 		std::shared_lock<std::shared_mutex> lock(_stream_map_mutex);
@@ -50,10 +50,13 @@ namespace pub
 			{
 				_stream = stream;
 				_media_packet = media_packet;
+				_enqueued_time = std::chrono::steady_clock::now();
 			}
 
 			std::shared_ptr<Stream> _stream;
 			std::shared_ptr<MediaPacket> _media_packet;
+			// To measure the queue delay
+			std::chrono::steady_clock::time_point _enqueued_time;
 		};
 		std::shared_ptr<ApplicationWorker::StreamData> PopStreamData();
 
@@ -83,6 +86,7 @@ namespace pub
 							  const std::shared_ptr<MediaPacket> &media_packet) override;
 
 		uint32_t GetStreamCount();
+		std::map<uint32_t, std::shared_ptr<Stream>> GetStreamMap();
 		std::shared_ptr<Stream> GetStream(uint32_t stream_id);
 		std::shared_ptr<Stream> GetStream(ov::String stream_name);
 
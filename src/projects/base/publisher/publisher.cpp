@@ -55,7 +55,8 @@ namespace pub
 		// Check configuration
 		if(app_info.IsDynamicApp() == false)
 		{
-			auto cfg_publisher_list = app_info.GetConfig().GetPublishers().GetPublisherList();
+			auto app_config = app_info.GetConfig();
+			auto cfg_publisher_list = app_config->GetPublishers().GetPublisherList();
 			for(const auto &cfg_publisher : cfg_publisher_list)
 			{
 				if(cfg_publisher->GetType() == GetPublisherType())
@@ -116,7 +117,8 @@ namespace pub
 			// Check the reason the app is not created is because it is disabled in the configuration
 			if(app_info.IsDynamicApp() == false)
 			{
-				auto cfg_publisher_list = app_info.GetConfig().GetPublishers().GetPublisherList();
+				auto app_config = app_info.GetConfig();
+				auto cfg_publisher_list = app_config->GetPublishers().GetPublisherList();
 				for(const auto &cfg_publisher : cfg_publisher_list)
 				{
 					if(cfg_publisher->GetType() == GetPublisherType())
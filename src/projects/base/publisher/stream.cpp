@@ -2,6 +2,8 @@
 #include "application.h"
 #include "publisher_private.h"
 
+#include <monitoring/histogram.h>
+
 namespace pub
 {
 	StreamWorker::StreamWorker(const std::shared_ptr<Stream> &parent_stream)
@@ -171,10 +173,16 @@ namespace pub
 			if (packet.has_value())
 			{		
 				session_lock.lock();
+				auto send_start_time = std::chrono::steady_clock::now();
 				for (auto const &x : _sessions)
 				{
 					auto session = x.second;
 					session->SendOutgoingData(packet.value());
+
+					// The end time of a session is the start time of the next session to read the clock only once per session
+					auto send_end_time = std::chrono::steady_clock::now();
+					mon::ObserveHistogram(mon::HistogramType::SessionSendLatency, send_end_time - send_start_time);
+					send_start_time = send_end_time;
 				}
 				session_lock.unlock();
 			}
@@ -416,10 +424,15 @@ namespace pub
 		else
 		{
 			std::shared_lock<std::shared_mutex> session_lock(_session_map_mutex);
+			auto send_start_time = std::chrono::steady_clock::now();
 			for (auto const &x : _sessions)
 			{
 				auto session = std::static_pointer_cast<Session>(x.second);
 				session->SendOutgoingData(packet);
+
+				auto send_end_time = std::chrono::steady_clock::now();
+				mon::ObserveHistogram(mon::HistogramType::SessionSendLatency, send_end_time - send_start_time);
+				send_start_time = send_end_time;
 			}
 		}
 	
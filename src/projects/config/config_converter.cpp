@@ -52,7 +52,7 @@ namespace cfg
 
 		Json::Value GetApplicationFromMetrics(const std::shared_ptr<const mon::ApplicationMetrics> &app_metrics)
 		{
-			auto app = app_metrics->GetConfig().ToJson();
+			auto app = app_metrics->GetConfig()->ToJson();
 
 			auto reserved_stream_list = app_metrics->GetReservedStreamMetricsMap();
 
@@ -164,7 +164,7 @@ namespace cfg
 
 		void GetApplicationFromMetrics(pugi::xml_node app_node, const std::shared_ptr<const mon::ApplicationMetrics> &app_metrics)
 		{
-			app_metrics->GetConfig().ToXml(app_node);
+			app_metrics->GetConfig()->ToXml(app_node);
 
 			auto reserved_stream_list = app_metrics->GetReservedStreamMetricsMap();
 
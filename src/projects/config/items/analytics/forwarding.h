@@ -17,17 +17,32 @@ namespace cfg
 		protected:
 			bool _enable = false;
 			// Default OvenConsole URL
+			// tcp://<host>:<port> - Events are sent as '\n' delimited lines
+			// http://<host>:<port>/<path> - Events are sent as the body of POST requests (NDJSON) with keep-alive
 			ov::String _collector = "tcp://collector.ovenconsole.io:21514";
 
+			// Maximum number of events sent at once
+			int _batch_count = 1000;
+			// Interval to check new events in milliseconds (maximum delay of the events in a batch)
+			int _batch_interval = 1000;
+			// "gzip" or "none" (Only for http collector)
+			ov::String _compression = "none";
+
 		public:
 			CFG_DECLARE_CONST_REF_GETTER_OF(IsEnabled, _enable)
 			CFG_DECLARE_CONST_REF_GETTER_OF(GetCollector, _collector)
+			CFG_DECLARE_CONST_REF_GETTER_OF(GetBatchCount, _batch_count)
+			CFG_DECLARE_CONST_REF_GETTER_OF(GetBatchInterval, _batch_interval)
+			CFG_DECLARE_CONST_REF_GETTER_OF(GetCompression, _compression)
 
 		protected:
 			void MakeList() override
 			{
 				Register<Optional>("Enable", &_enable);
 				Register<Optional>("Collector", &_collector);
+				Register<Optional>("BatchCount", &_batch_count);
+				Register<Optional>("BatchInterval", &_batch_interval);
+				Register<Optional>("Compression", &_compression);
 			}
 		};
 	}  // namespace an
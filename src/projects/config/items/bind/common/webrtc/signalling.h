@@ -22,6 +22,9 @@ namespace cfg
 
 				int _worker_count{};
 
+				// Accepts permessage-deflate of WebSocket if the client offers it
+				bool _per_message_deflate = false;
+
 			public:
 				explicit Signalling(const char *port)
 					: _port(port)
@@ -38,6 +41,7 @@ namespace cfg
 				CFG_DECLARE_CONST_REF_GETTER_OF(GetTlsPort, _tls_port);
 
 				CFG_DECLARE_CONST_REF_GETTER_OF(GetWorkerCount, _worker_count);
+				CFG_DECLARE_CONST_REF_GETTER_OF(IsPerMessageDeflateEnabled, _per_message_deflate);
 
 			protected:
 				void MakeList() override
@@ -46,6 +50,7 @@ namespace cfg
 					Register<Optional>({"TLSPort", "tlsPort"}, &_tls_port);
 
 					Register<Optional>("WorkerCount", &_worker_count);
+					Register<Optional>("PerMessageDeflate", &_per_message_deflate);
 				}
 			};
 		}  // namespace cmm
@@ -9,6 +9,7 @@
 #pragma once
 
 #include "../../common/cross_domain_support.h"
+#include "stats_snapshot/stats_snapshot.h"
 #include "storage/storage.h"
 
 namespace cfg
@@ -23,11 +24,13 @@ namespace cfg
 				ov::String _access_token;
 
 				Storage _storage;
+				StatsSnapshot _stats_snapshot;
 
 			public:
 				CFG_DECLARE_CONST_REF_GETTER_OF(GetAccessToken, _access_token)
 
 				CFG_DECLARE_CONST_REF_GETTER_OF(GetStorage, _storage)
+				CFG_DECLARE_CONST_REF_GETTER_OF(GetStatsSnapshot, _stats_snapshot)
 
 			protected:
 				void MakeList() override
@@ -35,6 +38,7 @@ namespace cfg
 					Register("AccessToken", &_access_token);
 
 					Register<Optional>("Storage", &_storage);
+					Register<Optional>("StatsSnapshot", &_stats_snapshot);
 
 					Register<Optional>("CrossDomains", &_cross_domains);
 				}
@@ -0,0 +1,42 @@
+//==============================================================================
+//
+//  OvenMediaEngine
+//
+//  Created by Hyunjun Jang
+//  Copyright (c) 2022 AirenSoft. All rights reserved.
+//
+//==============================================================================
+#pragma once
+
+namespace cfg
+{
+	namespace mgr
+	{
+		namespace api
+		{
+			struct StatsSnapshot : public Item
+			{
+			protected:
+				// Interval to rebuild the snapshot of the stats APIs
+				int _refresh_interval = 1000;
+				// The snapshot keeps being refreshed for this time after the last read
+				int _keep_alive_time = 60000;
+				// A snapshot older than this is rebuilt while handling a request
+				int _max_age = 5000;
+
+			public:
+				CFG_DECLARE_CONST_REF_GETTER_OF(GetRefreshInterval, _refresh_interval)
+				CFG_DECLARE_CONST_REF_GETTER_OF(GetKeepAliveTime, _keep_alive_time)
+				CFG_DECLARE_CONST_REF_GETTER_OF(GetMaxAge, _max_age)
+
+			protected:
+				void MakeList() override
+				{
+					Register<Optional>("RefreshInterval", &_refresh_interval);
+					Register<Optional>("KeepAliveTime", &_keep_alive_time);
+					Register<Optional>("MaxAge", &_max_age);
+				}
+			};
+		}  // namespace api
+	}	   // namespace mgr
+}  // namespace cfg
@@ -0,0 +1,39 @@
+//==============================================================================
+//
+//  OvenMediaEngine
+//
+//  Created by Getroot
+//  Copyright (c) 2022 AirenSoft. All rights reserved.
+//
+//==============================================================================
+#pragma once
+
+#include "module_template.h"
+
+namespace cfg
+{
+	namespace modules
+	{
+		// Push providers (RTMP, MPEG-TS, SRT) parse the received data on their own worker threads
+		// instead of the socket pool threads
+		struct IngestWorker : public ModuleTemplate
+		{
+		protected:
+			int _worker_count = 4;
+
+		public:
+			CFG_DECLARE_CONST_REF_GETTER_OF(GetWorkerCount, _worker_count)
+
+		protected:
+			void MakeList() override
+			{
+				// Disabled by default
+				SetEnable(false);
+
+				ModuleTemplate::MakeList();
+
+				Register<Optional>("WorkerCount", &_worker_count);
+			}
+		};
+	} // namespace modules
+} // namespace cfg
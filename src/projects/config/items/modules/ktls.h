@@ -0,0 +1,34 @@
+//==============================================================================
+//
+//  OvenMediaEngine
+//
+//  Created by Hyunjun Jang
+//  Copyright (c) 2022 AirenSoft. All rights reserved.
+//
+//==============================================================================
+#pragma once
+
+#include "module_template.h"
+
+namespace cfg
+{
+	namespace modules
+	{
+		// Kernel TLS offload for HTTPS/WSS (requires the "tls" kernel module)
+		struct KTLS : public ModuleTemplate
+		{
+		protected:
+
+		public:
+
+		protected:
+			void MakeList() override
+			{
+				// Disabled by default
+				SetEnable(false);
+
+				ModuleTemplate::MakeList();
+			}
+		};
+	} // namespace modules
+} // namespace cfg
@@ -9,8 +9,12 @@
 #pragma once
 
 #include "http2.h"
+#include "ingest_worker.h"
+#include "ktls.h"
 #include "ll_hls.h"
 #include "p2p.h"
+#include "reuse_port.h"
+#include "segment_cache.h"
 
 namespace cfg
 {
@@ -22,11 +26,19 @@ namespace cfg
 			HTTP2 _http2;
 			LLHls _ll_hls;
 			P2P _p2p;
+			KTLS _ktls;
+			ReusePort _reuse_port;
+			IngestWorker _ingest_worker;
+			SegmentCache _segment_cache;
 
 		public:
 			CFG_DECLARE_CONST_REF_GETTER_OF(GetHttp2, _http2)
 			CFG_DECLARE_CONST_REF_GETTER_OF(GetLLHls, _ll_hls)
 			CFG_DECLARE_CONST_REF_GETTER_OF(GetP2P, _p2p)
+			CFG_DECLARE_CONST_REF_GETTER_OF(GetKtls, _ktls)
+			CFG_DECLARE_CONST_REF_GETTER_OF(GetReusePort, _reuse_port)
+			CFG_DECLARE_CONST_REF_GETTER_OF(GetIngestWorker, _ingest_worker)
+			CFG_DECLARE_CONST_REF_GETTER_OF(GetSegmentCache, _segment_cache)
 
 		protected:
 			void MakeList() override
@@ -34,6 +46,10 @@ namespace cfg
 				Register<Optional>("HTTP2", &_http2);
 				Register<Optional>("LLHLS", &_ll_hls);
 				Register<Optional>({"P2P", "p2p"}, &_p2p);
+				Register<Optional>("KTLS", &_ktls);
+				Register<Optional>("ReusePort", &_reuse_port);
+				Register<Optional>("IngestWorker", &_ingest_worker);
+				Register<Optional>("SegmentCache", &_segment_cache);
 			}
 		};
 	}  // namespace bind
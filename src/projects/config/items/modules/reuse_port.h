@@ -0,0 +1,38 @@
+//==============================================================================
+//
+//  OvenMediaEngine
+//
+//  Created by Hyunjun Jang
+//  Copyright (c) 2022 AirenSoft. All rights reserved.
+//
+//==============================================================================
+#pragma once
+
+#include "module_template.h"
+
+namespace cfg
+{
+	namespace modules
+	{
+		// Each socket pool worker of a TCP port owns its own SO_REUSEPORT listener
+		struct ReusePort : public ModuleTemplate
+		{
+		protected:
+			bool _cpu_steering = false;
+
+		public:
+			CFG_DECLARE_CONST_REF_GETTER_OF(IsCpuSteeringEnabled, _cpu_steering)
+
+		protected:
+			void MakeList() override
+			{
+				// Disabled by default
+				SetEnable(false);
+
+				ModuleTemplate::MakeList();
+
+				Register<Optional>("CpuSteering", &_cpu_steering);
+			}
+		};
+	} // namespace modules
+} // namespace cfg
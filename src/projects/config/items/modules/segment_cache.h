@@ -0,0 +1,43 @@
+//==============================================================================
+//
+//  OvenMediaEngine
+//
+//  Created by Getroot
+//  Copyright (c) 2022 AirenSoft. All rights reserved.
+//
+//==============================================================================
+#pragma once
+
+#include "module_template.h"
+
+namespace cfg
+{
+	namespace modules
+	{
+		// The segment publishers (HLS, DASH, LL-DASH) keep the requested segments in a cache
+		// and serve the cached segments on the threads of the HTTP connections
+		struct SegmentCache : public ModuleTemplate
+		{
+		protected:
+			// Memory budget of the cache of each publisher
+			int _max_memory_mb = 256;
+			int _ttl_sec = 60;
+
+		public:
+			CFG_DECLARE_CONST_REF_GETTER_OF(GetMaxMemoryMB, _max_memory_mb)
+			CFG_DECLARE_CONST_REF_GETTER_OF(GetTtlSec, _ttl_sec)
+
+		protected:
+			void MakeList() override
+			{
+				// Disabled by default
+				SetEnable(false);
+
+				ModuleTemplate::MakeList();
+
+				Register<Optional>("MaxMemoryMB", &_max_memory_mb);
+				Register<Optional>("TTL", &_ttl_sec);
+			}
+		};
+	} // namespace modules
+} // namespace cfg
@@ -48,6 +48,7 @@ namespace cfg
 
 					CFG_DECLARE_CONST_REF_GETTER_OF(GetAppWorkerCount, _app_worker_count)
 					CFG_DECLARE_CONST_REF_GETTER_OF(GetStreamWorkerCount, _stream_worker_count)
+					CFG_DECLARE_CONST_REF_GETTER_OF(IsPacketDurationPredictionEnabled, _predict_packet_duration)
 					CFG_DECLARE_CONST_REF_GETTER_OF(GetMpegtsPushPublisher, _mpegtspush_publisher)
 					CFG_DECLARE_CONST_REF_GETTER_OF(GetHlsPublisher, _hls_publisher)
 					CFG_DECLARE_CONST_REF_GETTER_OF(GetDashPublisher, _dash_publisher)
@@ -64,6 +65,7 @@ namespace cfg
 					{
 						Register<Optional>("AppWorkerCount", &_app_worker_count);
 						Register<Optional>("StreamWorkerCount", &_stream_worker_count);
+						Register<Optional>("PredictPacketDuration", &_predict_packet_duration);
 
 						Register<Optional>("MPEGTSPush", &_mpegtspush_publisher);
 						Register<Optional>({"HLS", "hls"}, &_hls_publisher);
@@ -79,6 +81,9 @@ namespace cfg
 
 					int _app_worker_count = 1;
 					int _stream_worker_count = 8;
+					// Emit the packets of the output streams immediately with a predicted duration,
+					// instead of holding each packet until the next packet of the track arrives
+					bool _predict_packet_duration = false;
 
 					MpegtsPushPublisher _mpegtspush_publisher;
 					RtmpPushPublisher _rtmppush_publisher;
@@ -49,6 +49,7 @@ namespace cfg
 					CFG_DECLARE_CONST_REF_GETTER_OF(IsJitterBufferEnabled, _jitter_buffer)
 					CFG_DECLARE_CONST_REF_GETTER_OF(GetPlayoutDelay, _playout_delay)
 					CFG_DECLARE_CONST_REF_GETTER_OF(GetBandwidthEstimationType, _bandwidth_estimation_type)
+					CFG_DECLARE_CONST_REF_GETTER_OF(IsPacingEnabled, _pacing)
 
 				protected:
 					void MakeList() override
@@ -60,6 +61,7 @@ namespace cfg
 						Register<Optional>("Rtx", &_rtx);
 						Register<Optional>("Ulpfec", &_ulpfec);
 						Register<Optional>("PlayoutDelay", &_playout_delay);
+						Register<Optional>("Pacing", &_pacing);
 						Register<Optional>("BandwidthEstimation", &_bwe,	
 							[=]() -> std::shared_ptr<ConfigError> {
 								return nullptr;
@@ -69,12 +71,10 @@ namespace cfg
 								{
 									_bandwidth_estimation_type = WebRtcBandwidthEstimationType::REMB;
 								}
-								// Not yet supported
-								// else if (_bwe.UpperCaseString() == "TRANSPORTCC")
-								// {
-								// 	_bandwidth_estimation_type = BandwidthEstimationType::TransportCc;
-									
-								// }
+								else if (_bwe.UpperCaseString() == "TRANSPORTCC")
+								{
+									_bandwidth_estimation_type = WebRtcBandwidthEstimationType::TransportCc;
+								}
 								else
 								{
 									return CreateConfigErrorPtr("Invalid value for BWE. Valid values are 'TransportCC' or 'REMB'");
@@ -88,6 +88,7 @@ namespace cfg
 					bool _rtx = false;
 					bool _ulpfec = false;
 					bool _jitter_buffer = false;
+					bool _pacing = true;
 					ov::String _bwe;
 
 					WebRtcBandwidthEstimationType _bandwidth_estimation_type = WebRtcBandwidthEstimationType::REMB;
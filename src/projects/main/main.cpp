@@ -16,7 +16,6 @@
 #include <config/config_manager.h>
 #include <mediarouter/mediarouter.h>
 #include <modules/address/address_utilities.h>
-#include <modules/sdp/sdp_regex_pattern.h>
 #include <monitoring/monitoring.h>
 #include <orchestrator/orchestrator.h>
 #include <providers/providers.h>
@@ -87,13 +86,6 @@ int main(int argc, char *argv[])
 		}
 	}
 
-	// Precompile SDP patterns for better performance.
-	if (SDPRegexPattern::GetInstance()->Compile() == false)
-	{
-		OV_ASSERT(false, "SDPRegexPattern compile failed");
-		return false;
-	}
-
 	logti("This host supports %s", ov::ipv6::Checker::GetInstance()->ToString().CStr());
 
 	bool succeeded = true;
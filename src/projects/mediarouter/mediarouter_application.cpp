@@ -16,6 +16,9 @@
 #define MIN_APPLICATION_WORKER_COUNT 1
 #define MAX_APPLICATION_WORKER_COUNT 64
 
+// Maximum number of packets a worker processes from a stream before moving on to the next runnable stream
+#define MEDIAROUTE_WORKER_QUANTUM_PACKETS 32
+
 #define CONNECTOR(var) MediaRouteApplicationConnector::ConnectorType::var
 #define OBSERVER(var) MediaRouteApplicationObserver::ObserverType::var
 
@@ -45,19 +48,18 @@ std::shared_ptr<MediaRouteApplication> MediaRouteApplication::Create(const info:
 MediaRouteApplication::MediaRouteApplication(const info::Application &application_info)
 	: _application_info(application_info)
 {
-	_max_worker_thread_count = std::min(std::max((uint32_t)_application_info.GetConfig().GetPublishers().GetAppWorkerCount(), (uint32_t)MIN_APPLICATION_WORKER_COUNT), (uint32_t)MAX_APPLICATION_WORKER_COUNT);
+	_max_worker_thread_count = std::min(std::max((uint32_t)_application_info.GetConfig()->GetPublishers().GetAppWorkerCount(), (uint32_t)MIN_APPLICATION_WORKER_COUNT), (uint32_t)MAX_APPLICATION_WORKER_COUNT);
 
 	logti("[%s(%u)] Created Mediarouter application. worker(%d)", _application_info.GetName().CStr(), _application_info.GetId(), _max_worker_thread_count);
 
 	for (uint32_t worker_id = 0; worker_id < _max_worker_thread_count; worker_id++)
 	{
-		_inbound_stream_indicator.push_back(std::make_shared<ov::Queue<std::shared_ptr<MediaRouteStream>>>(
-			ov::String::FormatString("%s - Mediarouter inbound indicator (%d/%d)", _application_info.GetName().CStr(), worker_id, _max_worker_thread_count),
-			500));
+		// A stream appears in the run queue at most once, so the size is bounded by the number of streams
+		_inbound_run_queues.push_back(std::make_shared<ov::Queue<std::shared_ptr<MediaRouteStream>>>(
+			ov::String::FormatString("%s - Mediarouter inbound run queue (%d/%d)", _application_info.GetName().CStr(), worker_id, _max_worker_thread_count)));
 
-		_outbound_stream_indicator.push_back(std::make_shared<ov::Queue<std::shared_ptr<MediaRouteStream>>>(
-			ov::String::FormatString("%s - Mediarouter outbound indicator (%d/%d)", _application_info.GetName().CStr(), worker_id, _max_worker_thread_count),
-			500));
+		_outbound_run_queues.push_back(std::make_shared<ov::Queue<std::shared_ptr<MediaRouteStream>>>(
+			ov::String::FormatString("%s - Mediarouter outbound run queue (%d/%d)", _application_info.GetName().CStr(), worker_id, _max_worker_thread_count)));
 	}
 }
 
@@ -112,16 +114,16 @@ bool MediaRouteApplication::Stop()
 {
 	_kill_flag = true;
 
-	for (auto &indicator : _inbound_stream_indicator)
+	for (auto &run_queue : _inbound_run_queues)
 	{
-		indicator->Stop();
-		indicator->Clear();
+		run_queue->Stop();
+		run_queue->Clear();
 	}
 
-	for (auto &indicator : _outbound_stream_indicator)
+	for (auto &run_queue : _outbound_run_queues)
 	{
-		indicator->Stop();
-		indicator->Clear();
+		run_queue->Stop();
+		run_queue->Clear();
 	}
 
 	for (auto &worker : _inbound_threads)
@@ -140,8 +142,8 @@ bool MediaRouteApplication::Stop()
 		}
 	}
 
-	_inbound_stream_indicator.clear();
-	_outbound_stream_indicator.clear();
+	_inbound_run_queues.clear();
+	_outbound_run_queues.clear();
 	_inbound_threads.clear();
 	_outbound_threads.clear();
 
@@ -208,6 +210,35 @@ bool MediaRouteApplication::RegisterObserverApp(std::shared_ptr<MediaRouteApplic
 
 	logtd("Registered observer. app(%s) type(%d)", _application_info.GetName().CStr(), observer->GetObserverType());
 
+	// A publisher registered while the application is running (e.g. the publisher configuration was changed)
+	// has to be notified of the streams that already exist. This is done while holding _observers_lock
+	// so that the publisher does not receive frames of a stream before the stream is created.
+	if (IS_OBSERVER_PUBLISHER(observer->GetObserverType()))
+	{
+		std::vector<std::shared_ptr<MediaRouteStream>> outbound_streams;
+		{
+			std::shared_lock<std::shared_mutex> streams_lock(_streams_lock);
+			for (const auto &item : _outbound_streams)
+			{
+				outbound_streams.push_back(item.second);
+			}
+		}
+
+		for (const auto &stream : outbound_streams)
+		{
+			auto stream_info = stream->GetStream();
+
+			logti("[%s/%s(%u)] Notify the existing stream to the newly registered publisher", _application_info.GetName().CStr(), stream_info->GetName().CStr(), stream_info->GetId());
+
+			observer->OnStreamCreated(stream_info);
+
+			if (stream->IsStreamPrepared())
+			{
+				observer->OnStreamPrepared(stream_info);
+			}
+		}
+	}
+
 	return true;
 }
 
@@ -331,6 +362,8 @@ std::shared_ptr<MediaRouteStream> MediaRouteApplication::CreateOutboundStream(co
 		return nullptr;
 	}
 
+	new_stream->SetPacketDurationPrediction(_application_info.GetConfig()->GetPublishers().IsPacketDurationPredictionEnabled());
+
 	_outbound_streams.insert(std::make_pair(stream_info->GetId(), new_stream));
 
 	return new_stream;
@@ -632,9 +665,10 @@ bool MediaRouteApplication::OnPacketReceived(const std::shared_ptr<MediaRouteApp
 			return false;
 		}
 
-		stream->Push(packet);
-
-		_inbound_stream_indicator[GetWorkerIDByStreamID(stream_info->GetId())]->Enqueue(stream);
+		if (stream->Push(packet))
+		{
+			_inbound_run_queues[GetWorkerIDByStreamID(stream_info->GetId())]->Enqueue(stream);
+		}
 	}
 	// Provider(relay), Transcoder => Outbound Stream
 	else if ((IS_CONNECTOR_PROVIDER(connector_type) && IS_REPRENT_RELAY(representation_type)) ||
@@ -646,9 +680,10 @@ bool MediaRouteApplication::OnPacketReceived(const std::shared_ptr<MediaRouteApp
 			return false;
 		}
 
-		stream->Push(packet);
-
-		_outbound_stream_indicator[GetWorkerIDByStreamID(stream_info->GetId())]->Enqueue(stream);
+		if (stream->Push(packet))
+		{
+			_outbound_run_queues[GetWorkerIDByStreamID(stream_info->GetId())]->Enqueue(stream);
+		}
 	}
 	else
 	{
@@ -738,18 +773,19 @@ uint32_t MediaRouteApplication::GetWorkerIDByStreamID(info::stream_id_t stream_i
 	return stream_id % _max_worker_thread_count;
 }
 
-void MediaRouteApplication::InboundWorkerThread(uint32_t worker_id)
+std::shared_ptr<MediaRouteStream> MediaRouteApplication::DequeueRunnableStream(ov::Queue<std::shared_ptr<MediaRouteStream>> &run_queue, std::vector<std::shared_ptr<MediaPacket>> &packets)
 {
-	logtd("Created Inbound worker thread #%d", worker_id);
+	packets.clear();
 
-	while (!_kill_flag)
+	while (_kill_flag == false)
 	{
-		auto msg = _inbound_stream_indicator[worker_id]->Dequeue(ov::Infinite);
+		auto msg = run_queue.Dequeue(ov::Infinite);
 		if (msg.has_value() == false)
 		{
 			// It may be called due to a normal stop signal.
 			continue;
 		}
+
 		auto stream = msg.value();
 		if (stream == nullptr)
 		{
@@ -757,34 +793,78 @@ void MediaRouteApplication::InboundWorkerThread(uint32_t worker_id)
 			continue;
 		}
 
-		// StreamDeliver media packet to Publisher(observer) of Transcoder(observer)
-		auto media_packet = stream->Pop();
-		if (media_packet == nullptr)
+		if (stream->PopBatch(MEDIAROUTE_WORKER_QUANTUM_PACKETS, packets) == 0)
 		{
+			// The queue was flushed after the stream was scheduled
+			CompleteQuantum(run_queue, stream);
 			continue;
 		}
 
-		// When the inbound stream is finished parsing track information,
-		// Notify the Observer that the stream is parsed
-		if (stream->IsStreamPrepared() == false && stream->AreAllTracksReady() == true)
+		return stream;
+	}
+
+	return nullptr;
+}
+
+void MediaRouteApplication::CompleteQuantum(ov::Queue<std::shared_ptr<MediaRouteStream>> &run_queue, const std::shared_ptr<MediaRouteStream> &stream)
+{
+	if (stream->CompleteQuantum())
+	{
+		// Round-robin: the other runnable streams are processed before the rest of this stream
+		run_queue.Enqueue(stream);
+	}
+}
+
+void MediaRouteApplication::InboundWorkerThread(uint32_t worker_id)
+{
+	logtd("Created Inbound worker thread #%d", worker_id);
+
+	auto run_queue = _inbound_run_queues[worker_id];
+	std::vector<std::shared_ptr<MediaPacket>> packets;
+	packets.reserve(MEDIAROUTE_WORKER_QUANTUM_PACKETS);
+
+	while (!_kill_flag)
+	{
+		auto stream = DequeueRunnableStream(*run_queue, packets);
+		if (stream == nullptr)
 		{
-			NotifyStreamPrepared(stream);
+			continue;
 		}
 
-		std::shared_lock<std::shared_mutex> lock(_observers_lock);
-		for (const auto &observer : _observers)
+		auto stream_info = stream->GetStream();
+
+		for (auto &packet : packets)
 		{
-			auto observer_type = observer->GetObserverType();
+			// StreamDeliver media packet to Publisher(observer) of Transcoder(observer)
+			auto media_packet = stream->Pop(std::move(packet));
+			if (media_packet == nullptr)
+			{
+				continue;
+			}
 
-			if (observer_type == MediaRouteApplicationObserver::ObserverType::Transcoder)
+			// When the inbound stream is finished parsing track information,
+			// Notify the Observer that the stream is parsed
+			if (stream->IsStreamPrepared() == false && stream->AreAllTracksReady() == true)
 			{
-				// Get Stream Info
-				auto stream_info = stream->GetStream();
+				NotifyStreamPrepared(stream);
+			}
+
+			std::shared_lock<std::shared_mutex> lock(_observers_lock);
+			for (const auto &observer : _observers)
+			{
+				auto observer_type = observer->GetObserverType();
 
-				// observer->OnSendFrame(stream_info, std::move(media_packet->ClonePacket()));
-				observer->OnSendFrame(stream_info, media_packet);
+				if (observer_type == MediaRouteApplicationObserver::ObserverType::Transcoder)
+				{
+					// observer->OnSendFrame(stream_info, std::move(media_packet->ClonePacket()));
+					observer->OnSendFrame(stream_info, media_packet);
+				}
 			}
 		}
+
+		packets.clear();
+
+		CompleteQuantum(*run_queue, stream);
 	}
 
 	logtd("Inbound worker thread #%d has been stopped", worker_id);
@@ -794,46 +874,49 @@ void MediaRouteApplication::OutboundWorkerThread(uint32_t worker_id)
 {
 	logtd("Created outbound worker thread #%d", worker_id);
 
+	auto run_queue = _outbound_run_queues[worker_id];
+	std::vector<std::shared_ptr<MediaPacket>> packets;
+	packets.reserve(MEDIAROUTE_WORKER_QUANTUM_PACKETS);
+
 	while (!_kill_flag)
 	{
-		auto msg = _outbound_stream_indicator[worker_id]->Dequeue(ov::Infinite);
-		if (msg.has_value() == false)
-		{
-			// It may be called due to a normal stop signal.
-			continue;
-		}
-		auto stream = msg.value();
+		auto stream = DequeueRunnableStream(*run_queue, packets);
 		if (stream == nullptr)
 		{
-			logtw("Not found stream info");
 			continue;
 		}
 
-		// StreamDeliver media packet to Publisher(observer) of Transcoder(observer)
-		auto media_packet = stream->Pop();
-		if (media_packet == nullptr)
-		{
-			continue;
-		}
+		auto stream_info = stream->GetStream();
 
-		if (stream->IsStreamPrepared() == false && stream->AreAllTracksReady() == true)
+		for (auto &packet : packets)
 		{
-			NotifyStreamPrepared(stream);
-		}
+			// StreamDeliver media packet to Publisher(observer) of Transcoder(observer)
+			auto media_packet = stream->Pop(std::move(packet));
+			if (media_packet == nullptr)
+			{
+				continue;
+			}
 
-		std::shared_lock<std::shared_mutex> lock(_observers_lock);
-		for (const auto &observer : _observers)
-		{
-			auto observer_type = observer->GetObserverType();
+			if (stream->IsStreamPrepared() == false && stream->AreAllTracksReady() == true)
+			{
+				NotifyStreamPrepared(stream);
+			}
 
-			if (observer_type == MediaRouteApplicationObserver::ObserverType::Publisher)
+			std::shared_lock<std::shared_mutex> lock(_observers_lock);
+			for (const auto &observer : _observers)
 			{
-				// Get Stream Info
-				auto stream_info = stream->GetStream();
+				auto observer_type = observer->GetObserverType();
 
-				observer->OnSendFrame(stream_info, media_packet);
+				if (observer_type == MediaRouteApplicationObserver::ObserverType::Publisher)
+				{
+					observer->OnSendFrame(stream_info, media_packet);
+				}
 			}
 		}
+
+		packets.clear();
+
+		CompleteQuantum(*run_queue, stream);
 	}
 
 	logtd("Outbound worker thread #%d has been stopped", worker_id);
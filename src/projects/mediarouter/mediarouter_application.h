@@ -141,6 +141,12 @@ private:
 	void InboundWorkerThread(uint32_t worker_id);
 	void OutboundWorkerThread(uint32_t worker_id);
 
+	// Takes a runnable stream from the run queue, and pops a batch of packets from it.
+	// Returns nullptr if the run queue is stopped.
+	std::shared_ptr<MediaRouteStream> DequeueRunnableStream(ov::Queue<std::shared_ptr<MediaRouteStream>> &run_queue, std::vector<std::shared_ptr<MediaPacket>> &packets);
+	// Enqueues the stream to the tail of the run queue if it still has packets after the quantum
+	void CompleteQuantum(ov::Queue<std::shared_ptr<MediaRouteStream>> &run_queue, const std::shared_ptr<MediaRouteStream> &stream);
+
 	volatile bool _kill_flag;
 	std::vector<std::thread> _inbound_threads;
 	std::vector<std::thread> _outbound_threads;
@@ -148,6 +154,8 @@ private:
 	uint32_t _max_worker_thread_count;
 
 private:
-	std::vector<std::shared_ptr<ov::Queue<std::shared_ptr<MediaRouteStream>>>> _inbound_stream_indicator;
-	std::vector<std::shared_ptr<ov::Queue<std::shared_ptr<MediaRouteStream>>>> _outbound_stream_indicator;
+	// Run queues of the workers. A stream is enqueued only when it becomes runnable (see MediaRouteStream::Push()),
+	// not for every packet.
+	std::vector<std::shared_ptr<ov::Queue<std::shared_ptr<MediaRouteStream>>>> _inbound_run_queues;
+	std::vector<std::shared_ptr<ov::Queue<std::shared_ptr<MediaRouteStream>>>> _outbound_run_queues;
 };
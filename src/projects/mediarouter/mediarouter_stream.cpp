@@ -41,15 +41,21 @@
 #include <modules/bitstream/opus/opus.h>
 #include <modules/bitstream/vp8/vp8.h>
 
+#include <monitoring/histogram.h>
+#include <monitoring/monitoring.h>
+
 #include "mediarouter_private.h"
 
 #define PTS_CORRECT_THRESHOLD_MS 3000
+// A warning is logged if the packets are queued more than this
+#define MEDIAROUTE_STREAM_QUEUE_THRESHOLD 100
+// Interval to update the queue delay of the stream metrics
+#define MEDIAROUTE_STREAM_QUEUE_DELAY_INTERVAL_MS 1000
 
 using namespace cmn;
 
 MediaRouteStream::MediaRouteStream(const std::shared_ptr<info::Stream> &stream)
-	: _stream(stream),
-	  _packets_queue(nullptr, 100)
+	: _stream(stream)
 {
 	_inout_type = MediaRouterStreamType::UNKNOWN;
 
@@ -58,6 +64,7 @@ MediaRouteStream::MediaRouteStream(const std::shared_ptr<info::Stream> &stream)
 
 	_stat_start_time = std::chrono::system_clock::now();
 	_stop_watch.Start();
+	_queue_delay_stop_watch.Start();
 }
 
 MediaRouteStream::MediaRouteStream(const std::shared_ptr<info::Stream> &stream, MediaRouterStreamType inout_type)
@@ -86,8 +93,6 @@ std::shared_ptr<info::Stream> MediaRouteStream::GetStream()
 void MediaRouteStream::SetInoutType(MediaRouterStreamType inout_type)
 {
 	_inout_type = inout_type;
-
-	_packets_queue.SetAlias(ov::String::FormatString("%s/%s-MR-%s", _stream->GetApplicationInfo().GetName().CStr(), _stream->GetName().CStr(), (_inout_type == MediaRouterStreamType::INBOUND) ? "Inbound" : "Outbound"));
 }
 
 MediaRouterStreamType MediaRouteStream::GetInoutType()
@@ -95,6 +100,11 @@ MediaRouterStreamType MediaRouteStream::GetInoutType()
 	return _inout_type;
 }
 
+void MediaRouteStream::SetPacketDurationPrediction(bool enabled)
+{
+	_predict_packet_duration = enabled;
+}
+
 void MediaRouteStream::OnStreamPrepared(bool completed)
 {
 	_is_stream_prepared = completed;
@@ -111,6 +121,7 @@ void MediaRouteStream::Flush()
 	_packets_queue.Clear();
 	// Clear stahsed Packets
 	_media_packet_stash.clear();
+	_duration_predictions.clear();
 
 	_are_all_tracks_parsed = false;
 
@@ -866,17 +877,25 @@ void MediaRouteStream::UpdateStatistics(std::shared_ptr<MediaTrack> &media_track
 			max_pts = std::max(max_pts, rescaled_last_pts);										
 		}
 
+		auto queue_size = _packets_queue.GetSize();
+
 		ov::String stat_stream_str = "";
 
-		stat_stream_str.AppendFormat("\n - MediaRouter Stream | id: %u, type: %s, name: %s/%s, uptime: %lldms, queue: %d, sync: %lldms",
+		stat_stream_str.AppendFormat("\n - MediaRouter Stream | id: %u, type: %s, name: %s/%s, uptime: %lldms, queue: %zu, qdly: %lldus, sync: %lldms",
 									 _stream->GetId(),
 									 _inout_type == MediaRouterStreamType::INBOUND ? "Inbound" : "Outbound",
 									 _stream->GetApplicationInfo().GetName().CStr(),
 									 _stream->GetName().CStr(),
 									 (int64_t)uptime,
-									 _packets_queue.Size(),
+									 queue_size,
+									 _last_queue_delay_max_usec,
 									 max_pts - min_pts);
 
+		if (_predict_packet_duration)
+		{
+			stat_stream_str.AppendFormat(", mispredicted_dur: %llu", _mispredicted_duration_count);
+		}
+
 		stat_track_str = stat_stream_str + stat_track_str;
 
 		logts("%s", stat_track_str.CStr());
@@ -889,112 +908,147 @@ void MediaRouteStream::DropNonDecodingPackets()
 	////////////////////////////////////////////////////////////////////////////////////
 	// 1. Discover to the highest PTS value in the keyframe against packets on all tracks.
 
-	std::vector<std::shared_ptr<MediaPacket>> tmp_packets_queue;
-	int64_t base_pts = -1LL;
-
-	while (true)
-	{
-		if (_packets_queue.IsEmpty())
-			break;
+	_packets_queue.Modify([](std::deque<ov::RunnableQueue<std::shared_ptr<MediaPacket>>::Item> &packets_queue) {
+		std::vector<ov::RunnableQueue<std::shared_ptr<MediaPacket>>::Item> tmp_packets_queue(std::make_move_iterator(packets_queue.begin()), std::make_move_iterator(packets_queue.end()));
+		packets_queue.clear();
 
-		auto media_packet_ref = _packets_queue.Dequeue();
-		if (media_packet_ref.has_value() == false)
-			continue;
+		int64_t base_pts = -1LL;
 
-		auto &media_packet = media_packet_ref.value();
-
-		if (media_packet->GetFlag() == MediaPacketFlag::Key)
+		for (const auto &queued_packet : tmp_packets_queue)
 		{
-			if (base_pts < media_packet->GetPts())
+			auto &media_packet = queued_packet.value;
+
+			if (media_packet->GetFlag() == MediaPacketFlag::Key)
 			{
-				base_pts = media_packet->GetPts();
-				logtw("Discovered base PTS value track_id:%d, flags:%d, size:%d,  pts:%lld", (int32_t)media_packet->GetTrackId(), media_packet->GetFlag(), media_packet->GetDataLength(), base_pts);
+				if (base_pts < media_packet->GetPts())
+				{
+					base_pts = media_packet->GetPts();
+					logtw("Discovered base PTS value track_id:%d, flags:%d, size:%d,  pts:%lld", (int32_t)media_packet->GetTrackId(), media_packet->GetFlag(), media_packet->GetDataLength(), base_pts);
+				}
 			}
 		}
 
-		tmp_packets_queue.push_back(std::move(media_packet));
-	}
-
-	////////////////////////////////////////////////////////////////////////////////////
-	// 2. Obtain the PTS values for all tracks close to the reference PTS.
-
-	// <TrackId, <diff, Pts>>
-	std::map<MediaTrackId, std::pair<int64_t, int64_t>> map_near_pts;
+		////////////////////////////////////////////////////////////////////////////////////
+		// 2. Obtain the PTS values for all tracks close to the reference PTS.
 
-	for (auto it = tmp_packets_queue.begin(); it != tmp_packets_queue.end(); it++)
-	{
-		auto &media_packet = *it;
+		// <TrackId, <diff, Pts>>
+		std::map<MediaTrackId, std::pair<int64_t, int64_t>> map_near_pts;
 
-		if (media_packet->GetFlag() == MediaPacketFlag::Key)
+		for (auto it = tmp_packets_queue.begin(); it != tmp_packets_queue.end(); it++)
 		{
-			MediaTrackId track_id = media_packet->GetTrackId();
+			auto &media_packet = it->value;
 
-			int64_t pts_diff = std::abs(media_packet->GetPts() - base_pts);
+			if (media_packet->GetFlag() == MediaPacketFlag::Key)
+			{
+				MediaTrackId track_id = media_packet->GetTrackId();
 
-			auto it_near_pts = map_near_pts.find(track_id);
+				int64_t pts_diff = std::abs(media_packet->GetPts() - base_pts);
 
-			if (it_near_pts == map_near_pts.end())
-			{
-				map_near_pts[track_id] = std::make_pair(pts_diff, media_packet->GetPts());
-			}
-			else
-			{
-				auto pair_value = it_near_pts->second;
-				int64_t prev_pts_diff = pair_value.first;
+				auto it_near_pts = map_near_pts.find(track_id);
 
-				if (prev_pts_diff > pts_diff)
+				if (it_near_pts == map_near_pts.end())
 				{
 					map_near_pts[track_id] = std::make_pair(pts_diff, media_packet->GetPts());
 				}
+				else
+				{
+					auto pair_value = it_near_pts->second;
+					int64_t prev_pts_diff = pair_value.first;
+
+					if (prev_pts_diff > pts_diff)
+					{
+						map_near_pts[track_id] = std::make_pair(pts_diff, media_packet->GetPts());
+					}
+				}
 			}
 		}
-	}
 
-	////////////////////////////////////////////////////////////////////////////////////
-	// 3. Drop all packets below PTS by all tracks
+		////////////////////////////////////////////////////////////////////////////////////
+		// 3. Drop all packets below PTS by all tracks
 
-	uint32_t dropeed_packets = 0;
-	for (auto it = tmp_packets_queue.begin(); it != tmp_packets_queue.end(); it++)
-	{
-		auto &media_packet = *it;
+		uint32_t dropeed_packets = 0;
+		for (auto it = tmp_packets_queue.begin(); it != tmp_packets_queue.end(); it++)
+		{
+			auto &media_packet = it->value;
+
+			if (media_packet->GetPts() < map_near_pts[media_packet->GetTrackId()].second)
+			{
+				dropeed_packets++;
+				continue;
+			}
+
+			packets_queue.push_back(std::move(*it));
+		}
+		tmp_packets_queue.clear();
 
-		if (media_packet->GetPts() < map_near_pts[media_packet->GetTrackId()].second)
+		if (dropeed_packets > 0)
 		{
-			dropeed_packets++;
-			continue;
+			logtw("Number of dropped packets : %d", dropeed_packets);
 		}
+	});
+}
+
+bool MediaRouteStream::Push(std::shared_ptr<MediaPacket> media_packet)
+{
+	size_t queue_size = 0;
+	auto runnable = _packets_queue.Push(std::move(media_packet), 0, &queue_size);
 
-		_packets_queue.Enqueue(std::move(media_packet));
+	if (queue_size >= MEDIAROUTE_STREAM_QUEUE_THRESHOLD)
+	{
+		auto now_msec = ov::Clock::NowMSec();
+		auto last_log_msec = _last_queue_threshold_log_msec.load();
+
+		if (((now_msec - last_log_msec) >= 5000) && _last_queue_threshold_log_msec.compare_exchange_strong(last_log_msec, now_msec))
+		{
+			logtw("[%s/%s] %s queue size has exceeded the threshold: queue: %zu, threshold: %d, peak: %zu",
+				  _stream->GetApplicationName(), _stream->GetName().CStr(),
+				  (_inout_type == MediaRouterStreamType::INBOUND) ? "Inbound" : "Outbound",
+				  queue_size, MEDIAROUTE_STREAM_QUEUE_THRESHOLD, _packets_queue.GetPeakSize());
+		}
 	}
-	tmp_packets_queue.clear();
 
-	if (dropeed_packets > 0)
+	return runnable;
+}
+
+size_t MediaRouteStream::PopBatch(size_t max_count, std::vector<std::shared_ptr<MediaPacket>> &packets)
+{
+	auto count = _packets_queue.PopBatch(max_count, packets, [](int64_t queue_delay_usec) {
+		mon::GetHistogram(mon::HistogramType::MediaRouterQueueDelay).ObserveUsec(queue_delay_usec);
+	});
+
+	if (_queue_delay_stop_watch.IsElapsed(MEDIAROUTE_STREAM_QUEUE_DELAY_INTERVAL_MS) && _queue_delay_stop_watch.Update())
 	{
-		logtw("Number of dropped packets : %d", dropeed_packets);
+		UpdateQueueDelayMetrics();
 	}
+
+	return count;
 }
 
-void MediaRouteStream::Push(std::shared_ptr<MediaPacket> media_packet)
+bool MediaRouteStream::CompleteQuantum()
 {
-	_packets_queue.Enqueue(std::move(media_packet));
+	return _packets_queue.CompleteQuantum();
 }
 
-std::shared_ptr<MediaPacket> MediaRouteStream::Pop()
+void MediaRouteStream::UpdateQueueDelayMetrics()
 {
-	// Get Media Packet
-	if (_packets_queue.IsEmpty())
+	auto statistics = _packets_queue.TakeDelayStatistics();
+
+	_last_queue_delay_max_usec = statistics.max_usec;
+
+	auto stream_metrics = StreamMetrics(*_stream);
+	if (stream_metrics != nullptr)
 	{
-		return nullptr;
+		stream_metrics->SetMediaRouterQueueDelay(statistics.average_usec, statistics.max_usec);
 	}
+}
 
-	auto media_packet_ref = _packets_queue.Dequeue();
-	if (media_packet_ref.has_value() == false)
+std::shared_ptr<MediaPacket> MediaRouteStream::Pop(std::shared_ptr<MediaPacket> media_packet)
+{
+	if (media_packet == nullptr)
 	{
 		return nullptr;
 	}
 
-	auto &media_packet = media_packet_ref.value();
-
 	////////////////////////////////////////////////////////////////////////////////////
 	// [ Calculating Packet Timestamp, Duration]
 
@@ -1016,6 +1070,16 @@ std::shared_ptr<MediaPacket> MediaRouteStream::Pop()
 	std::shared_ptr<MediaPacket> pop_media_packet = nullptr;
 
 	if ( (GetInoutType() == MediaRouterStreamType::OUTBOUND) && 
+		// The packet duration recalculation applies only to video and audio types.
+		 (media_packet->GetMediaType() == MediaType::Video || media_packet->GetMediaType() == MediaType::Audio) &&
+		 _predict_packet_duration )
+	{
+		// Emit the packet now instead of waiting for the next packet (it takes a frame interval)
+		pop_media_packet = std::move(media_packet);
+
+		PredictPacketDuration(pop_media_packet);
+	}
+	else if ( (GetInoutType() == MediaRouterStreamType::OUTBOUND) && 
 		// The packet duration recalculation applies only to video and audio types.
 		 (media_packet->GetMediaType() == MediaType::Video || media_packet->GetMediaType() == MediaType::Audio) )
 	{
@@ -1158,6 +1222,114 @@ std::shared_ptr<MediaPacket> MediaRouteStream::Pop()
 	return pop_media_packet;
 }
 
+void MediaRouteStream::PredictPacketDuration(std::shared_ptr<MediaPacket> &media_packet)
+{
+	auto track_id = media_packet->GetTrackId();
+	auto &prediction = _duration_predictions[track_id];
+
+	if (prediction.last_dts != -1LL)
+	{
+		// The same measure as the stash mode for non-monotonically increasing DTS (#743)
+		if (prediction.last_dts >= media_packet->GetDts())
+		{
+			if (_warning_count_out_of_order++ < 10)
+			{
+				logtw("[%s/%s] Detected out of order DTS of packet. track_id:%d dts:%lld->%lld",
+					  _stream->GetApplicationName(), _stream->GetName().CStr(), track_id, prediction.last_dts, media_packet->GetDts());
+			}
+
+			media_packet->SetPts(prediction.last_pts + 1);
+			media_packet->SetDts(prediction.last_dts + 1);
+		}
+
+		prediction.last_interval = media_packet->GetDts() - prediction.last_dts;
+
+		// The previous packet has already been sent with the predicted duration. The consumers that need an exact timeline
+		// (e.g. fMP4 packager) correct it with the DTS of this packet.
+		if (prediction.predicted_duration != prediction.last_interval)
+		{
+			_mispredicted_duration_count++;
+		}
+	}
+
+	int64_t duration = prediction.last_interval;
+
+	if (duration < 0LL)
+	{
+		duration = GetDefaultPacketDuration(_stream->GetTrack(track_id));
+	}
+
+	media_packet->SetDuration(duration);
+
+	prediction.last_pts = media_packet->GetPts();
+	prediction.last_dts = media_packet->GetDts();
+	prediction.predicted_duration = duration;
+}
+
+int64_t MediaRouteStream::GetDefaultPacketDuration(const std::shared_ptr<MediaTrack> &media_track) const
+{
+	if (media_track == nullptr)
+	{
+		return 0LL;
+	}
+
+	// Seconds per a tick of the timebase
+	auto expr = media_track->GetTimeBase().GetExpr();
+	if (expr <= 0.0)
+	{
+		return 0LL;
+	}
+
+	double duration_seconds = 0.0;
+
+	switch (media_track->GetMediaType())
+	{
+		case MediaType::Video: {
+			auto framerate = (media_track->GetFrameRate() > 0.0) ? media_track->GetFrameRate() : media_track->GetEstimateFrameRate();
+
+			if (framerate > 0.0)
+			{
+				duration_seconds = 1.0 / framerate;
+			}
+		}
+		break;
+
+		case MediaType::Audio: {
+			int samples_per_frame = media_track->GetAudioSamplesPerFrame();
+
+			if (samples_per_frame <= 0)
+			{
+				switch (media_track->GetCodecId())
+				{
+					case MediaCodecId::Aac:
+						samples_per_frame = 1024;
+						break;
+					case MediaCodecId::Mp3:
+						samples_per_frame = 1152;
+						break;
+					case MediaCodecId::Opus:
+						// 20ms
+						samples_per_frame = 960;
+						break;
+					default:
+						break;
+				}
+			}
+
+			if ((samples_per_frame > 0) && (media_track->GetSampleRate() > 0))
+			{
+				duration_seconds = static_cast<double>(samples_per_frame) / media_track->GetSampleRate();
+			}
+		}
+		break;
+
+		default:
+			break;
+	}
+
+	return static_cast<int64_t>(duration_seconds / expr);
+}
+
 void MediaRouteStream::DumpPacket(
 	std::shared_ptr<MediaPacket> &media_packet,
 	bool dump)
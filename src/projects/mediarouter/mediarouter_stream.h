@@ -10,7 +10,9 @@
 
 #include <stdint.h>
 
+#include <deque>
 #include <memory>
+#include <mutex>
 #include <queue>
 #include <vector>
 
@@ -38,12 +40,30 @@ public:
 	void SetInoutType(MediaRouterStreamType inout_type);
 	MediaRouterStreamType GetInoutType();
 
+	// If enabled, the outbound packets are emitted without waiting for the next packet of the track.
+	// The duration is predicted from the last interval of DTS or the frame rate/samples per frame of the track.
+	void SetPacketDurationPrediction(bool enabled);
+
 	// Queue interfaces
-	void Push(std::shared_ptr<MediaPacket> media_packet);
+	//
+	// The stream is scheduled on the run queue of a worker only when it becomes runnable (the queue goes from empty
+	// to non-empty while the stream is not scheduled). The worker drains a batch of packets with PopBatch(),
+	// processes them with Pop(), and then calls CompleteQuantum() to decide whether to re-queue the stream.
+
+	// Returns true if the stream has become runnable and must be enqueued to the run queue
+	bool Push(std::shared_ptr<MediaPacket> media_packet);
+	// Moves up to max_count packets from the queue to packets (the queue delay of the packets is measured here)
+	size_t PopBatch(size_t max_count, std::vector<std::shared_ptr<MediaPacket>> &packets);
+	// Returns true if there are more packets to process (the stream must be enqueued to the run queue again),
+	// otherwise the stream becomes idle until the next Push()
+	bool CompleteQuantum();
+
 	bool ProcessInboundStream(std::shared_ptr<MediaTrack> &media_track, std::shared_ptr<MediaPacket> &media_packet);
 	bool ProcessOutboundStream(std::shared_ptr<MediaTrack> &media_track,std::shared_ptr<MediaPacket> &media_packet);
 
-	std::shared_ptr<MediaPacket> Pop();
+	// Calculates the duration and converts the bitstream of a packet taken by PopBatch().
+	// Returns nullptr if the packet is stashed or dropped.
+	std::shared_ptr<MediaPacket> Pop(std::shared_ptr<MediaPacket> media_packet);
 
 	// Query original stream information
 	std::shared_ptr<info::Stream> GetStream();
@@ -66,6 +86,9 @@ private:
 	bool ProcessOPUSStream(std::shared_ptr<MediaTrack> &media_track, std::shared_ptr<MediaPacket> &media_packet);
 
 	void UpdateStatistics(std::shared_ptr<MediaTrack> &media_track,  std::shared_ptr<MediaPacket> &media_packet);
+	void PredictPacketDuration(std::shared_ptr<MediaPacket> &media_packet);
+	int64_t GetDefaultPacketDuration(const std::shared_ptr<MediaTrack> &media_track) const;
+	void UpdateQueueDelayMetrics();
 
 	bool _is_stream_prepared = false;
 	bool _are_all_tracks_parsed = false;
@@ -82,8 +105,28 @@ private:
 	// Temporary packet store. for calculating packet duration
 	std::map<MediaTrackId, std::shared_ptr<MediaPacket>> _media_packet_stash;
 
+	// Duration prediction (instead of _media_packet_stash)
+	struct DurationPrediction
+	{
+		int64_t last_pts = -1LL;
+		int64_t last_dts = -1LL;
+		// Interval of DTS between the last two packets, -1 if unknown
+		int64_t last_interval = -1LL;
+		// Duration predicted for the last packet
+		int64_t predicted_duration = -1LL;
+	};
+	bool _predict_packet_duration = false;
+	std::map<MediaTrackId, DurationPrediction> _duration_predictions;
+	// Number of packets whose predicted duration differed from the actual interval
+	uint64_t _mispredicted_duration_count = 0;
+
 	// Packets queue
-	ov::Queue<std::shared_ptr<MediaPacket>> _packets_queue;
+	ov::RunnableQueue<std::shared_ptr<MediaPacket>> _packets_queue;
+	std::atomic<int64_t> _last_queue_threshold_log_msec{0};
+
+	// Maximum queue delay of the last interval
+	int64_t _last_queue_delay_max_usec = 0;
+	ov::StopWatch _queue_delay_stop_watch;
 
 	// TODO(Soulk) : Modified to use by tying statistical information into a class and creating a map with MediaTrackId as a key
 
@@ -135,6 +135,23 @@ std::shared_ptr<ov::Data> AacConverter::ConvertRawToAdts(const std::shared_ptr<c
 	return adts_data;
 }
 
+std::shared_ptr<const MediaPacket> AacConverter::GetRawView(const std::shared_ptr<const MediaPacket> &media_packet)
+{
+	if (media_packet->GetBitstreamFormat() == cmn::BitstreamFormat::AAC_RAW)
+	{
+		return media_packet;
+	}
+
+	if (media_packet->GetBitstreamFormat() != cmn::BitstreamFormat::AAC_ADTS)
+	{
+		return nullptr;
+	}
+
+	return media_packet->GetBitstreamView(cmn::BitstreamFormat::AAC_RAW, cmn::PacketType::RAW, [](const std::shared_ptr<const ov::Data> &data) {
+		return ConvertAdtsToRaw(data, nullptr);
+	});
+}
+
 std::shared_ptr<ov::Data> AacConverter::ConvertAdtsToRaw(const std::shared_ptr<const ov::Data> &data, std::vector<size_t> *length_list)
 {
 	auto raw_data = std::make_shared<ov::Data>(data->GetLength());
@@ -16,6 +16,10 @@ public:
 	static std::shared_ptr<ov::Data> ConvertRawToAdts(const std::shared_ptr<const ov::Data> &data, const std::shared_ptr<AACSpecificConfig> &aac_config);
 	static std::shared_ptr<ov::Data> ConvertAdtsToRaw(const std::shared_ptr<const ov::Data> &data, std::vector<size_t> *length_list);
 
+	// Returns the packet in the AAC_RAW format. The converted packet is cached in the media_packet,
+	// so a packet shared by many publishers is converted only once.
+	static std::shared_ptr<const MediaPacket> GetRawView(const std::shared_ptr<const MediaPacket> &media_packet);
+
 	static ov::String GetProfileString(const std::shared_ptr<AACSpecificConfig> &aac_config);
 	static ov::String GetProfileString(const std::vector<uint8_t> &codec_extradata);
 
@@ -269,6 +269,23 @@ static bool ExtractSpsPpsOffset(const std::shared_ptr<const ov::Data> &data, con
 }
 #endif
 
+std::shared_ptr<const MediaPacket> H264Converter::GetAvccView(const std::shared_ptr<const MediaPacket> &media_packet)
+{
+	if (media_packet->GetBitstreamFormat() == cmn::BitstreamFormat::H264_AVCC)
+	{
+		return media_packet;
+	}
+
+	if (media_packet->GetBitstreamFormat() != cmn::BitstreamFormat::H264_ANNEXB)
+	{
+		return nullptr;
+	}
+
+	return media_packet->GetBitstreamView(cmn::BitstreamFormat::H264_AVCC, cmn::PacketType::NALU, [](const std::shared_ptr<const ov::Data> &data) {
+		return ConvertAnnexbToAvcc(data);
+	});
+}
+
 std::shared_ptr<ov::Data> H264Converter::ConvertAnnexbToAvcc(const std::shared_ptr<const ov::Data> &data)
 {
 	// size_t total_pattern_length = 0;
@@ -19,4 +19,8 @@ public:
 
 	static std::shared_ptr<ov::Data> ConvertAvccToAnnexb(const std::shared_ptr<const ov::Data> &data);
 	static std::shared_ptr<ov::Data> ConvertAnnexbToAvcc(const std::shared_ptr<const ov::Data> &data);
+
+	// Returns the packet in the H264_AVCC format. The converted packet is cached in the media_packet,
+	// so a packet shared by many publishers is converted only once.
+	static std::shared_ptr<const MediaPacket> GetAvccView(const std::shared_ptr<const MediaPacket> &media_packet);
 };
@@ -1657,10 +1657,12 @@ namespace bmff
 		// It will be updated after writing the whole Moof box.
 		stream.WriteBE32(0); 
 		
-		for (const auto &sample : samples->GetList())
+		for (size_t index = 0; index < samples->GetList().size(); index++)
 		{
+			const auto &sample = samples->GetAt(index);
+
 			// unsigned int(32) sample_duration;
-			stream.WriteBE32(sample->GetDuration());
+			stream.WriteBE32(samples->GetDurationAt(index));
 
 			if (GetMediaTrack()->GetMediaType() == cmn::MediaType::Video)
 			{
@@ -37,10 +37,24 @@ namespace bmff
 						_independent = true;
 					}
 				}
+				else
+				{
+					// The duration of the previous sample may have been predicted (MediaRouter emits the packet before the next one arrives).
+					// Now that the DTS of the next sample is known, correct it so that the samples are contiguous in the fragment.
+					auto actual_duration = media_packet->GetDts() - _list.back()->GetDts();
+					auto &last_duration = _durations.back();
+
+					if ((actual_duration > 0) && (actual_duration != last_duration))
+					{
+						_total_duration += (actual_duration - last_duration);
+						last_duration = actual_duration;
+					}
+				}
 
 				_end_timestamp = media_packet->GetDts() + media_packet->GetDuration();
 
 				_list.push_back(media_packet);
+				_durations.push_back(media_packet->GetDuration());
 
 				_total_duration += media_packet->GetDuration();
 				_total_size += media_packet->GetData()->GetLength();
@@ -61,9 +75,16 @@ namespace bmff
 				return _list.at(index);
 			}
 
+			// Get Duration At (corrected with the DTS of the next sample)
+			int64_t GetDurationAt(size_t index) const
+			{
+				return _durations.at(index);
+			}
+
 			void PopFront()
 			{
 				_list.erase(_list.begin());
+				_durations.erase(_durations.begin());
 			}
 
 			// Get Start Timestamp
@@ -110,6 +131,7 @@ namespace bmff
 
 		private:
 			std::vector<std::shared_ptr<const MediaPacket>> _list;
+			std::vector<int64_t> _durations;
 			int64_t _start_timestamp = 0;
 			int64_t _end_timestamp = 0;
 			double _total_duration = 0.0;
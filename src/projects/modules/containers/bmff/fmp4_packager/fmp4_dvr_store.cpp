@@ -0,0 +1,672 @@
+//==============================================================================
+//
+//  OvenMediaEngine
+//
+//  Created by Getroot
+//  Copyright (c) 2022 AirenSoft. All rights reserved.
+//
+//==============================================================================
+#include "fmp4_dvr_store.h"
+
+#include <base/ovlibrary/directory.h>
+#include <base/ovlibrary/dump_utilities.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "fmp4_private.h"
+
+namespace bmff
+{
+	FMP4DvrStore::FMP4DvrStore(const ov::String &directory, size_t volume_size)
+	{
+		_directory = directory;
+		_volume_size = volume_size;
+
+		LoadIndex();
+	}
+
+	FMP4DvrStore::~FMP4DvrStore()
+	{
+		std::lock_guard<std::shared_mutex> lock(_lock);
+
+		for (auto &[volume_id, volume] : _volumes)
+		{
+			CloseVolume(volume, true);
+		}
+		_volumes.clear();
+		_current_volume = nullptr;
+
+		if (_index_fd >= 0)
+		{
+			::close(_index_fd);
+			_index_fd = -1;
+		}
+	}
+
+	FMP4DvrStore::Mapping::~Mapping()
+	{
+		::munmap(address, length);
+	}
+
+	std::shared_ptr<FMP4DvrStore::Volume> FMP4DvrStore::CreateVolume(size_t capacity)
+	{
+		if (ov::CreateDirectories(_directory) == false)
+		{
+			logte("Could not create directory for DVR: %s", _directory.CStr());
+			return nullptr;
+		}
+
+		auto volume = std::make_shared<Volume>();
+		volume->id = _next_volume_id++;
+		volume->file_path = ov::String::FormatString("%s/%u.dvr", _directory.CStr(), volume->id);
+		volume->capacity = capacity;
+
+		volume->fd = ::open(volume->file_path.CStr(), O_RDWR | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+		if (volume->fd < 0)
+		{
+			logte("Could not create DVR volume: %s (%s)", volume->file_path.CStr(), ov::Error::CreateErrorFromErrno()->What());
+			return nullptr;
+		}
+
+		volume->shared_fd = std::shared_ptr<const int>(new int(volume->fd), [](const int *fd) {
+			::close(*fd);
+			delete fd;
+		});
+
+		// Only the first step is allocated here, the rest is allocated as segments are appended
+		if ((AllocateVolume(volume, std::min(capacity, static_cast<size_t>(FMP4_DVR_VOLUME_ALLOCATION_STEP))) == false) ||
+			(MapVolume(volume) == false))
+		{
+			CloseVolume(volume, true);
+			return nullptr;
+		}
+
+		_volumes.emplace(volume->id, volume);
+
+		logtd("DVR volume is created: %s (%zu bytes)", volume->file_path.CStr(), capacity);
+
+		return volume;
+	}
+
+	std::shared_ptr<FMP4DvrStore::Volume> FMP4DvrStore::OpenVolume(uint32_t volume_id)
+	{
+		auto volume = std::make_shared<Volume>();
+		volume->id = volume_id;
+		volume->file_path = ov::String::FormatString("%s/%u.dvr", _directory.CStr(), volume->id);
+
+		volume->fd = ::open(volume->file_path.CStr(), O_RDWR | O_CLOEXEC);
+		if (volume->fd < 0)
+		{
+			// The volume was deleted after all of its segments were evicted
+			logtd("Could not open DVR volume: %s (%s)", volume->file_path.CStr(), ov::Error::CreateErrorFromErrno()->What());
+			return nullptr;
+		}
+
+		volume->shared_fd = std::shared_ptr<const int>(new int(volume->fd), [](const int *fd) {
+			::close(*fd);
+			delete fd;
+		});
+
+		struct stat file_stat;
+		if (::fstat(volume->fd, &file_stat) != 0)
+		{
+			logte("Could not get the size of DVR volume: %s (%s)", volume->file_path.CStr(), ov::Error::CreateErrorFromErrno()->What());
+			CloseVolume(volume, false);
+			return nullptr;
+		}
+
+		volume->allocated_size = file_stat.st_size;
+		volume->capacity = std::max(_volume_size, volume->allocated_size);
+
+		if (MapVolume(volume) == false)
+		{
+			CloseVolume(volume, false);
+			return nullptr;
+		}
+
+		_volumes.emplace(volume->id, volume);
+
+		return volume;
+	}
+
+	bool FMP4DvrStore::MapVolume(const std::shared_ptr<Volume> &volume)
+	{
+		// The whole capacity is mapped once, only the allocated part of it is accessed
+		auto mapped = ::mmap(nullptr, volume->capacity, PROT_READ, MAP_SHARED, volume->fd, 0);
+		if (mapped == MAP_FAILED)
+		{
+			logte("Could not map DVR volume: %s (%s)", volume->file_path.CStr(), ov::Error::CreateErrorFromErrno()->What());
+			return false;
+		}
+		volume->mapping = std::make_shared<const Mapping>(static_cast<uint8_t *>(mapped), volume->capacity);
+
+		return true;
+	}
+
+	bool FMP4DvrStore::AllocateVolume(const std::shared_ptr<Volume> &volume, size_t size)
+	{
+		if (size <= volume->allocated_size)
+		{
+			return true;
+		}
+
+		// Allocate blocks in steps so that appending a segment doesn't allocate blocks (and inodes) one by one,
+		// without reserving the whole volume for a stream that may be short
+		auto step = static_cast<size_t>(FMP4_DVR_VOLUME_ALLOCATION_STEP);
+		auto new_size = std::min(volume->capacity, ((size + step - 1) / step) * step);
+
+		auto result = ::posix_fallocate(volume->fd, volume->allocated_size, new_size - volume->allocated_size);
+		if (result != 0)
+		{
+			logte("Could not allocate DVR volume: %s (%zu bytes, error: %d)", volume->file_path.CStr(), new_size, result);
+			return false;
+		}
+
+		volume->allocated_size = new_size;
+
+		return true;
+	}
+
+	void FMP4DvrStore::CloseVolume(const std::shared_ptr<Volume> &volume, bool delete_file)
+	{
+		// The volume is unmapped when no segment data refers to it
+		volume->mapping = nullptr;
+
+		// The file is closed when no FileRange refers to it
+		volume->shared_fd = nullptr;
+		volume->fd = -1;
+
+		if (delete_file && (::unlink(volume->file_path.CStr()) != 0))
+		{
+			logte("Could not delete DVR volume: %s", volume->file_path.CStr());
+		}
+	}
+
+	ov::String FMP4DvrStore::GetIndexPath() const
+	{
+		return ov::String::FormatString("%s/index.dat", _directory.CStr());
+	}
+
+	void FMP4DvrStore::LoadIndex()
+	{
+		auto index_path = GetIndexPath();
+		if (::access(index_path.CStr(), F_OK) != 0)
+		{
+			return;
+		}
+
+		auto index = ov::LoadFromFile(index_path.CStr());
+		if (index == nullptr)
+		{
+			logte("Could not read DVR index: %s", index_path.CStr());
+			return;
+		}
+
+		auto buffer = index->GetDataAs<uint8_t>();
+		size_t remained = index->GetLength();
+
+		while (remained >= sizeof(IndexRecord))
+		{
+			IndexRecord index_record;
+			::memcpy(&index_record, buffer, sizeof(index_record));
+
+			auto record_size = sizeof(IndexRecord) + (sizeof(ChunkRecord) * index_record.chunk_count);
+			if (remained < record_size)
+			{
+				// The last record was not written completely
+				logtw("DVR index is truncated: %s (%zu bytes remained)", index_path.CStr(), remained);
+				break;
+			}
+
+			SegmentInfo info;
+			info.segment_number = index_record.segment_number;
+			info.volume_id = index_record.volume_id;
+			info.offset = index_record.offset;
+			info.size = index_record.size;
+			info.start_timestamp = index_record.start_timestamp;
+			info.duration_ms = index_record.duration_ms;
+			info.independent = index_record.independent != 0;
+
+			info.chunks.reserve(index_record.chunk_count);
+			for (uint32_t i = 0; i < index_record.chunk_count; i++)
+			{
+				ChunkRecord chunk_record;
+				::memcpy(&chunk_record, buffer + sizeof(IndexRecord) + (sizeof(ChunkRecord) * i), sizeof(chunk_record));
+
+				ChunkInfo chunk_info;
+				chunk_info.offset = chunk_record.offset;
+				chunk_info.size = chunk_record.size;
+				chunk_info.start_timestamp = chunk_record.start_timestamp;
+				chunk_info.duration_ms = chunk_record.duration_ms;
+				chunk_info.independent = chunk_record.independent != 0;
+				info.chunks.push_back(chunk_info);
+			}
+
+			buffer += record_size;
+			remained -= record_size;
+
+			if (_segments.empty() == false && _segments.back().segment_number >= info.segment_number)
+			{
+				logtw("DVR index has an out of order segment: %u -> %u", _segments.back().segment_number, info.segment_number);
+				continue;
+			}
+
+			// The volume is deleted when all of its segments are evicted
+			auto volume_it = _volumes.find(info.volume_id);
+			auto volume = (volume_it != _volumes.end()) ? volume_it->second : OpenVolume(info.volume_id);
+			if (volume == nullptr || (info.offset + info.size > volume->allocated_size))
+			{
+				continue;
+			}
+
+			volume->write_offset = std::max(volume->write_offset, static_cast<size_t>(info.offset + info.size));
+			volume->segment_count++;
+
+			_next_volume_id = std::max(_next_volume_id, info.volume_id + 1);
+			_total_duration_ms += info.duration_ms;
+			_segments.push_back(std::move(info));
+		}
+
+		for (auto it = _volumes.begin(); it != _volumes.end();)
+		{
+			if (it->second->segment_count == 0)
+			{
+				CloseVolume(it->second, true);
+				it = _volumes.erase(it);
+			}
+			else
+			{
+				++it;
+			}
+		}
+
+		if (_segments.empty() == false)
+		{
+			// Continue appending to the last volume
+			_current_volume = _volumes[_segments.back().volume_id];
+		}
+
+		logti("DVR store is re-indexed: %s (%zu segments, %zu volumes, %.0f ms)", _directory.CStr(), _segments.size(), _volumes.size(), _total_duration_ms);
+
+		// Drop the records of evicted segments and a partially written record
+		CompactIndex();
+	}
+
+	bool FMP4DvrStore::OpenIndex()
+	{
+		if (_index_fd >= 0)
+		{
+			return true;
+		}
+
+		auto index_path = GetIndexPath();
+		_index_fd = ::open(index_path.CStr(), O_WRONLY | O_CREAT | O_APPEND | O_CLOEXEC, 0644);
+		if (_index_fd < 0)
+		{
+			logte("Could not open DVR index: %s (%s)", index_path.CStr(), ov::Error::CreateErrorFromErrno()->What());
+			return false;
+		}
+
+		return true;
+	}
+
+	void FMP4DvrStore::MakeIndexRecord(const SegmentInfo &info, ov::Data &record)
+	{
+		IndexRecord index_record;
+		index_record.segment_number = info.segment_number;
+		index_record.volume_id = info.volume_id;
+		index_record.offset = info.offset;
+		index_record.size = info.size;
+		index_record.start_timestamp = info.start_timestamp;
+		index_record.duration_ms = info.duration_ms;
+		index_record.independent = info.independent ? 1 : 0;
+		index_record.chunk_count = info.chunks.size();
+		record.Append(&index_record, sizeof(index_record));
+
+		for (const auto &chunk : info.chunks)
+		{
+			ChunkRecord chunk_record;
+			chunk_record.offset = chunk.offset;
+			chunk_record.size = chunk.size;
+			chunk_record.start_timestamp = chunk.start_timestamp;
+			chunk_record.duration_ms = chunk.duration_ms;
+			chunk_record.independent = chunk.independent ? 1 : 0;
+			record.Append(&chunk_record, sizeof(chunk_record));
+		}
+	}
+
+	bool FMP4DvrStore::WriteIndex(const SegmentInfo &info)
+	{
+		if (OpenIndex() == false)
+		{
+			return false;
+		}
+
+		ov::Data record(sizeof(IndexRecord) + (sizeof(ChunkRecord) * info.chunks.size()));
+		MakeIndexRecord(info, record);
+
+		if (::write(_index_fd, record.GetData(), record.GetLength()) != static_cast<ssize_t>(record.GetLength()))
+		{
+			logte("Could not write DVR index: %s", ov::Error::CreateErrorFromErrno()->What());
+			return false;
+		}
+
+		return true;
+	}
+
+	bool FMP4DvrStore::CompactIndex()
+	{
+		if (ov::CreateDirectories(_directory) == false)
+		{
+			logte("Could not create directory for DVR: %s", _directory.CStr());
+			return false;
+		}
+
+		ov::Data records;
+		for (const auto &info : _segments)
+		{
+			MakeIndexRecord(info, records);
+		}
+
+		// Written to a temporary file and renamed, so that the index is never left half-written
+		auto index_path = GetIndexPath();
+		auto temp_path = index_path + ".tmp";
+
+		auto temp_fd = ::open(temp_path.CStr(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+		if (temp_fd < 0)
+		{
+			logte("Could not create DVR index: %s (%s)", temp_path.CStr(), ov::Error::CreateErrorFromErrno()->What());
+			return false;
+		}
+
+		auto written = ::write(temp_fd, records.GetData(), records.GetLength());
+		::close(temp_fd);
+
+		if ((written != static_cast<ssize_t>(records.GetLength())) || (::rename(temp_path.CStr(), index_path.CStr()) != 0))
+		{
+			logte("Could not write DVR index: %s (%s)", index_path.CStr(), ov::Error::CreateErrorFromErrno()->What());
+			::unlink(temp_path.CStr());
+			return false;
+		}
+
+		// Appended records go to the new file
+		if (_index_fd >= 0)
+		{
+			::close(_index_fd);
+			_index_fd = -1;
+		}
+
+		return OpenIndex();
+	}
+
+	bool FMP4DvrStore::AppendSegment(const std::shared_ptr<FMP4Segment> &segment)
+	{
+		auto data = segment->GetData();
+		if (data == nullptr || data->IsEmpty())
+		{
+			return false;
+		}
+
+		auto size = data->GetLength();
+
+		std::lock_guard<std::shared_mutex> lock(_lock);
+
+		if (_current_volume == nullptr || (_current_volume->write_offset + size > _current_volume->capacity))
+		{
+			// The previous volume is deleted when all of its segments are evicted
+			if (_current_volume != nullptr && _current_volume->segment_count == 0)
+			{
+				CloseVolume(_current_volume, true);
+				_volumes.erase(_current_volume->id);
+			}
+
+			// A segment larger than the volume size gets its own volume
+			_current_volume = CreateVolume(std::max(_volume_size, size));
+			if (_current_volume == nullptr)
+			{
+				return false;
+			}
+		}
+
+		auto volume = _current_volume;
+
+		if (AllocateVolume(volume, volume->write_offset + size) == false)
+		{
+			return false;
+		}
+
+		auto written = ::pwrite(volume->fd, data->GetData(), size, volume->write_offset);
+		if (written != static_cast<ssize_t>(size))
+		{
+			logte("Could not write segment %u to DVR volume: %s (%s)", segment->GetNumber(), volume->file_path.CStr(), ov::Error::CreateErrorFromErrno()->What());
+			return false;
+		}
+
+		SegmentInfo info;
+		info.segment_number = segment->GetNumber();
+		info.volume_id = volume->id;
+		info.offset = volume->write_offset;
+		info.size = size;
+		info.start_timestamp = segment->GetStartTimestamp();
+		info.duration_ms = segment->GetDuration();
+
+		uint64_t chunk_offset = 0;
+		auto chunk_count = segment->GetChunkCount();
+		info.chunks.reserve(chunk_count);
+		for (uint64_t i = 0; i < chunk_count; i++)
+		{
+			auto chunk = segment->GetChunk(i);
+			if (chunk == nullptr)
+			{
+				break;
+			}
+
+			ChunkInfo chunk_info;
+			chunk_info.offset = chunk_offset;
+			chunk_info.size = chunk->GetSize();
+			chunk_info.start_timestamp = chunk->GetStartTimestamp();
+			chunk_info.duration_ms = chunk->GetDuration();
+			chunk_info.independent = chunk->IsIndependent();
+			info.chunks.push_back(chunk_info);
+
+			chunk_offset += chunk_info.size;
+		}
+		info.independent = (info.chunks.empty() == false) && info.chunks.front().independent;
+
+		// The record is appended after the data, so a record in the index always refers to written data.
+		// The segment is still served if the index could not be written, it is just not re-indexed after a restart.
+		WriteIndex(info);
+
+		volume->write_offset += size;
+		volume->segment_count++;
+
+		if (_segments.empty() == false && _segments.back().segment_number + 1 != info.segment_number)
+		{
+			logtw("DVR segment number is not continuous: %u -> %u", _segments.back().segment_number, info.segment_number);
+		}
+
+		_total_duration_ms += info.duration_ms;
+		_segments.push_back(std::move(info));
+
+		return true;
+	}
+
+	bool FMP4DvrStore::PopOldestSegment(SegmentInfo &segment_info)
+	{
+		std::lock_guard<std::shared_mutex> lock(_lock);
+
+		if (_segments.empty())
+		{
+			return false;
+		}
+
+		segment_info = std::move(_segments.front());
+		_segments.pop_front();
+		_total_duration_ms -= segment_info.duration_ms;
+
+		auto volume_it = _volumes.find(segment_info.volume_id);
+		if (volume_it != _volumes.end())
+		{
+			auto volume = volume_it->second;
+			volume->segment_count--;
+
+			// Reclaim the volume once all segments in it are evicted and it is no longer written
+			if (volume->segment_count == 0 && volume != _current_volume)
+			{
+				CloseVolume(volume, true);
+				_volumes.erase(volume_it);
+
+				// Records of the evicted segments are removed along with the volume
+				CompactIndex();
+			}
+		}
+
+		return true;
+	}
+
+	const FMP4DvrStore::SegmentInfo *FMP4DvrStore::GetSegmentInfo(uint32_t segment_number) const
+	{
+		if (_segments.empty())
+		{
+			return nullptr;
+		}
+
+		auto first_segment_number = _segments.front().segment_number;
+		if (segment_number < first_segment_number)
+		{
+			return nullptr;
+		}
+
+		auto index = segment_number - first_segment_number;
+		if (index < _segments.size() && _segments[index].segment_number == segment_number)
+		{
+			return &_segments[index];
+		}
+
+		// Segment numbers are not continuous
+		auto it = std::lower_bound(_segments.begin(), _segments.end(), segment_number, [](const SegmentInfo &info, uint32_t number) {
+			return info.segment_number < number;
+		});
+
+		if (it == _segments.end() || it->segment_number != segment_number)
+		{
+			return nullptr;
+		}
+
+		return &(*it);
+	}
+
+	std::shared_ptr<FMP4Segment> FMP4DvrStore::LoadSegment(uint32_t segment_number) const
+	{
+		std::shared_lock<std::shared_mutex> lock(_lock);
+
+		auto info = GetSegmentInfo(segment_number);
+		if (info == nullptr)
+		{
+			return nullptr;
+		}
+
+		auto volume_it = _volumes.find(info->volume_id);
+		if (volume_it == _volumes.end() || volume_it->second->mapping == nullptr)
+		{
+			logte("Could not find DVR volume %u of segment %u", info->volume_id, segment_number);
+			return nullptr;
+		}
+
+		// Not copied: the data (and the subdata of the chunks) keeps the mapping alive
+		auto &mapping = volume_it->second->mapping;
+		auto data = std::make_shared<ov::Data>(mapping->address + info->offset, info->size, mapping);
+
+		std::deque<std::shared_ptr<FMP4Chunk>> chunks;
+		for (size_t i = 0; i < info->chunks.size(); i++)
+		{
+			const auto &chunk = info->chunks[i];
+			chunks.emplace_back(std::make_shared<FMP4Chunk>(data->Subdata(chunk.offset, chunk.size), i, chunk.start_timestamp, chunk.duration_ms, chunk.independent));
+		}
+
+		return std::make_shared<FMP4Segment>(info->segment_number, info->start_timestamp, info->duration_ms, data, chunks);
+	}
+
+	int64_t FMP4DvrStore::FindSegmentNumber(int64_t timestamp) const
+	{
+		std::shared_lock<std::shared_mutex> lock(_lock);
+
+		// First segment starting after the timestamp
+		auto it = std::upper_bound(_segments.begin(), _segments.end(), timestamp, [](int64_t timestamp, const SegmentInfo &info) {
+			return timestamp < info.start_timestamp;
+		});
+
+		if (it == _segments.begin())
+		{
+			return -1;
+		}
+
+		return std::prev(it)->segment_number;
+	}
+
+	int64_t FMP4DvrStore::FindIndependentSegmentNumber(int64_t timestamp) const
+	{
+		std::shared_lock<std::shared_mutex> lock(_lock);
+
+		auto it = std::upper_bound(_segments.begin(), _segments.end(), timestamp, [](int64_t timestamp, const SegmentInfo &info) {
+			return timestamp < info.start_timestamp;
+		});
+
+		// Segments normally start with a keyframe, so this loop rarely goes back more than once
+		while (it != _segments.begin())
+		{
+			--it;
+			if (it->independent)
+			{
+				return it->segment_number;
+			}
+		}
+
+		return -1;
+	}
+
+	std::shared_ptr<ov::FileRange> FMP4DvrStore::GetSegmentFileRange(uint32_t segment_number) const
+	{
+		std::shared_lock<std::shared_mutex> lock(_lock);
+
+		auto info = GetSegmentInfo(segment_number);
+		if (info == nullptr)
+		{
+			return nullptr;
+		}
+
+		auto volume_it = _volumes.find(info->volume_id);
+		if (volume_it == _volumes.end() || volume_it->second->shared_fd == nullptr)
+		{
+			return nullptr;
+		}
+
+		return std::make_shared<ov::FileRange>(volume_it->second->shared_fd, info->offset, info->size);
+	}
+
+	uint64_t FMP4DvrStore::GetTotalDurationMs() const
+	{
+		std::shared_lock<std::shared_mutex> lock(_lock);
+		return _total_duration_ms;
+	}
+
+	uint32_t FMP4DvrStore::GetSegmentCount() const
+	{
+		std::shared_lock<std::shared_mutex> lock(_lock);
+		return _segments.size();
+	}
+
+	int64_t FMP4DvrStore::GetLastSegmentNumber() const
+	{
+		std::shared_lock<std::shared_mutex> lock(_lock);
+
+		if (_segments.empty())
+		{
+			return -1;
+		}
+
+		return _segments.back().segment_number;
+	}
+}  // namespace bmff
@@ -0,0 +1,174 @@
+//==============================================================================
+//
+//  OvenMediaEngine
+//
+//  Created by Getroot
+//  Copyright (c) 2022 AirenSoft. All rights reserved.
+//
+//==============================================================================
+#pragma once
+
+#include "fmp4_structure.h"
+
+// Default size of a volume file (<DVR><VolumeSizeMB> of LLHLS), which is filled with segments in order
+#define FMP4_DVR_DEFAULT_VOLUME_SIZE (256 * 1024 * 1024)
+// Volume files are preallocated in steps of this size as segments are appended, up to the volume size
+#define FMP4_DVR_VOLUME_ALLOCATION_STEP (16 * 1024 * 1024)
+
+namespace bmff
+{
+	// Append-only DVR segment store
+	//
+	// Segments are written sequentially into large preallocated volume files instead of one file per segment,
+	// and read back through a memory mapping of the volume without copying. Segment and chunk offsets are
+	// appended to an index file (index.dat) after the data of each segment is written, and mirrored in memory
+	// for O(log n) lookups. If the directory already has an index (e.g. left by an unclean shutdown),
+	// the store is re-indexed from it when it is opened.
+	//
+	// <directory>/
+	//     0.dvr, 1.dvr, ... : volumes
+	//     index.dat         : [IndexRecord][ChunkRecord * chunk_count] per segment
+	class FMP4DvrStore
+	{
+	public:
+		struct ChunkInfo
+		{
+			// Offset from the beginning of the segment
+			uint64_t offset = 0;
+			uint64_t size = 0;
+			int64_t start_timestamp = 0;
+			double duration_ms = 0;
+			bool independent = false;
+		};
+
+		struct SegmentInfo
+		{
+			uint32_t segment_number = 0;
+			uint32_t volume_id = 0;
+			// Offset from the beginning of the volume
+			uint64_t offset = 0;
+			uint64_t size = 0;
+			int64_t start_timestamp = 0;
+			double duration_ms = 0;
+			// Whether the segment starts with a keyframe
+			bool independent = false;
+
+			std::vector<ChunkInfo> chunks;
+		};
+
+		FMP4DvrStore(const ov::String &directory, size_t volume_size = FMP4_DVR_DEFAULT_VOLUME_SIZE);
+		~FMP4DvrStore();
+
+		bool AppendSegment(const std::shared_ptr<FMP4Segment> &segment);
+
+		// Pop the oldest segment, returns false if there is no segment
+		bool PopOldestSegment(SegmentInfo &segment_info);
+
+		// The data of the segment refers to the mapping of the volume, and keeps the mapping alive
+		// even if the segment is evicted while the data is being sent.
+		std::shared_ptr<FMP4Segment> LoadSegment(uint32_t segment_number) const;
+
+		// Returns the number of the segment containing the timestamp, -1 if not found
+		int64_t FindSegmentNumber(int64_t timestamp) const;
+		// Returns the number of the nearest segment starting with a keyframe at or before the timestamp, -1 if not found
+		int64_t FindIndependentSegmentNumber(int64_t timestamp) const;
+
+		// Range of the segment in the volume file, which can be sent with sendfile().
+		// The range keeps the volume file open even if the segment is evicted.
+		std::shared_ptr<ov::FileRange> GetSegmentFileRange(uint32_t segment_number) const;
+
+		uint64_t GetTotalDurationMs() const;
+		uint32_t GetSegmentCount() const;
+		// Returns the number of the last stored segment (including the re-indexed ones), -1 if there is no segment
+		int64_t GetLastSegmentNumber() const;
+
+	private:
+		// Read-only mapping of the whole volume, unmapped when the last segment data referring to it is released
+		struct Mapping
+		{
+			Mapping(uint8_t *address, size_t length)
+				: address(address), length(length)
+			{
+			}
+
+			~Mapping();
+
+			uint8_t *address = nullptr;
+			size_t length = 0;
+		};
+
+		struct Volume
+		{
+			uint32_t id = 0;
+			ov::String file_path;
+			int fd = -1;
+			// Shared with FileRanges, the file is closed when the last FileRange is released
+			std::shared_ptr<const int> shared_fd;
+			size_t capacity = 0;
+			// Size of the file allocated so far, which grows by FMP4_DVR_VOLUME_ALLOCATION_STEP up to the capacity
+			size_t allocated_size = 0;
+			// Next write position
+			size_t write_offset = 0;
+			std::shared_ptr<const Mapping> mapping;
+			// Number of segments stored in this volume that are not evicted yet
+			size_t segment_count = 0;
+		};
+
+#pragma pack(push, 1)
+		struct IndexRecord
+		{
+			uint32_t segment_number;
+			uint32_t volume_id;
+			uint64_t offset;
+			uint64_t size;
+			int64_t start_timestamp;
+			double duration_ms;
+			uint8_t independent;
+			uint32_t chunk_count;
+		};
+
+		struct ChunkRecord
+		{
+			uint64_t offset;
+			uint64_t size;
+			int64_t start_timestamp;
+			double duration_ms;
+			uint8_t independent;
+		};
+#pragma pack(pop)
+
+		std::shared_ptr<Volume> CreateVolume(size_t capacity);
+		// Open a volume that is left in the directory to re-index it
+		std::shared_ptr<Volume> OpenVolume(uint32_t volume_id);
+		bool MapVolume(const std::shared_ptr<Volume> &volume);
+		bool AllocateVolume(const std::shared_ptr<Volume> &volume, size_t size);
+		void CloseVolume(const std::shared_ptr<Volume> &volume, bool delete_file);
+
+		ov::String GetIndexPath() const;
+		// Re-index the segments from the index file left in the directory
+		void LoadIndex();
+		bool OpenIndex();
+		static void MakeIndexRecord(const SegmentInfo &info, ov::Data &record);
+		bool WriteIndex(const SegmentInfo &info);
+		// Rewrite the index with the segments that are not evicted yet
+		bool CompactIndex();
+
+		const SegmentInfo *GetSegmentInfo(uint32_t segment_number) const;
+
+		ov::String _directory;
+		size_t _volume_size = FMP4_DVR_DEFAULT_VOLUME_SIZE;
+
+		int _index_fd = -1;
+
+		uint32_t _next_volume_id = 0;
+		// Volume ID : Volume
+		std::map<uint32_t, std::shared_ptr<Volume>> _volumes;
+		std::shared_ptr<Volume> _current_volume;
+
+		// Ordered by segment number (and timestamp)
+		std::deque<SegmentInfo> _segments;
+		double _total_duration_ms = 0;
+
+		mutable std::shared_mutex _lock;
+	};
+}
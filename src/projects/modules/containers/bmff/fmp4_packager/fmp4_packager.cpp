@@ -15,6 +15,7 @@
 
 #include <modules/id3v2/id3v2.h>
 #include <modules/id3v2/frames/id3v2_text_frame.h>
+#include <monitoring/histogram.h>
 
 namespace bmff
 {
@@ -210,6 +211,8 @@ namespace bmff
 					reserve_buffer_size = (_target_chunk_duration_ms / 1000.0) * ((0.5 * 1000.0 * 1000.0) / 8.0);
 				}
 
+				auto packaging_start_time = std::chrono::steady_clock::now();
+
 				ov::ByteStream chunk_stream(reserve_buffer_size);
 				
 				auto data_samples = GetDataSamples(_samples_buffer->GetStartTimestamp(), _samples_buffer->GetEndTimestamp());
@@ -244,6 +247,9 @@ namespace bmff
 					return false;
 				}
 
+				mon::ObserveHistogram(mon::HistogramType::SegmentPackagingTime, std::chrono::steady_clock::now() - packaging_start_time);
+				mon::ObserveHistogram(mon::HistogramType::SegmentChunkSize, chunk->GetLength());
+
 				_samples_buffer.reset();
 
 				// Set the average chunk duration to config.chunk_duration_ms
@@ -298,23 +304,11 @@ namespace bmff
 		}
 		else if (media_packet->GetBitstreamFormat() == cmn::BitstreamFormat::H264_ANNEXB)
 		{
-			auto converted_data = H264Converter::ConvertAnnexbToAvcc(media_packet->GetData());
-			auto new_packet = std::make_shared<MediaPacket>(*media_packet);
-			new_packet->SetData(converted_data);
-			new_packet->SetBitstreamFormat(cmn::BitstreamFormat::H264_AVCC);
-			new_packet->SetPacketType(cmn::PacketType::NALU);
-
-			converted_packet = new_packet;
+			converted_packet = H264Converter::GetAvccView(media_packet);
 		}
 		else if (media_packet->GetBitstreamFormat() == cmn::BitstreamFormat::AAC_ADTS)
 		{
-			auto raw_data = AacConverter::ConvertAdtsToRaw(media_packet->GetData(), nullptr);
-			auto new_packet = std::make_shared<MediaPacket>(*media_packet);
-			new_packet->SetData(raw_data);
-			new_packet->SetBitstreamFormat(cmn::BitstreamFormat::AAC_RAW);
-			new_packet->SetPacketType(cmn::PacketType::RAW);
-
-			converted_packet = new_packet;
+			converted_packet = AacConverter::GetRawView(media_packet);
 		}
 		else if (media_packet->GetBitstreamFormat() == cmn::BitstreamFormat::AAC_RAW)
 		{
@@ -24,10 +24,26 @@ namespace bmff
 		// Keep one more to prevent download failure due to timing issue
 		_target_segment_duration_ms = static_cast<int64_t>(_config.segment_duration_ms);
 		_stream_tag = stream_tag;
+
+		if (_config.dvr_enabled)
+		{
+			_dvr_store = std::make_shared<FMP4DvrStore>(GetDVRDirectory(), _config.dvr_volume_size);
+
+			// Segments re-indexed from the DVR directory are served as they are, so new segments are numbered after them
+			auto last_dvr_segment_number = _dvr_store->GetLastSegmentNumber();
+			if (last_dvr_segment_number >= 0)
+			{
+				_last_segment_number = last_dvr_segment_number;
+				_number_of_deleted_segments = last_dvr_segment_number + 1;
+			}
+		}
 	}
 
 	FMP4Storage::~FMP4Storage()
 	{
+		// Close volumes before deleting the directory
+		_dvr_store.reset();
+
 		// Delete all dvr directory and files
 		ov::DeleteDirectories(GetDVRDirectory());
 	}
@@ -142,53 +158,28 @@ namespace bmff
 		return ov::String::FormatString("%s/%s/%d", _config.dvr_storage_path.CStr(), _stream_tag.CStr(), _track->GetId());
 	}
 
-	ov::String FMP4Storage::GetSegmentFilePath(uint32_t segment_number) const
-	{
-		return ov::String::FormatString("%s/%d.m4s", GetDVRDirectory().CStr(), segment_number);
-	}
-
 	bool FMP4Storage::SaveMediaSegmentToFile(const std::shared_ptr<FMP4Segment> &segment)
 	{
-		if (_config.dvr_enabled == false)
-		{
-			return false;
-		}
-
-		// Save to file
-		auto file_path = GetSegmentFilePath(segment->GetNumber());
-		auto dir = GetDVRDirectory();
-
-		// Create directory
-		if (ov::CreateDirectories(dir) == false)
+		if (_dvr_store == nullptr)
 		{
-			logte("Could not create directory for DVR: %s", dir.CStr());
 			return false;
 		}
 
-		// Save to file
-		if (ov::DumpToFile(file_path, segment->GetData()) == nullptr)
+		if (_dvr_store->AppendSegment(segment) == false)
 		{
-			logte("Could not save segment to file: %s", file_path.CStr());
+			logte("Could not save segment %u to DVR store: %s", segment->GetNumber(), GetDVRDirectory().CStr());
 			return false;
 		}
 
-		_dvr_info.AppendSegment(segment->GetNumber(), segment->GetDuration(), segment->GetData()->GetLength());
-
 		// Delete old segments until the total duration is less than the maximum DVR duration
-		while (_dvr_info.GetTotalDurationMs() > (_config.dvr_duration_sec * 1000.0))
+		FMP4DvrStore::SegmentInfo segment_to_delete;
+		while (_dvr_store->GetTotalDurationMs() > (_config.dvr_duration_sec * 1000.0))
 		{
-			auto segment_to_delete = _dvr_info.PopOldestSegmentInfo();
-			if (segment_to_delete.IsAvailable() == false)
+			if (_dvr_store->PopOldestSegment(segment_to_delete) == false)
 			{
 				break;
 			}
 
-			auto file_path = GetSegmentFilePath(segment_to_delete.segment_number);
-			if (std::remove(file_path) != 0)
-			{
-				logte("Could not delete DVR segment file: %s", file_path.CStr());
-			}
-
 			if (_observer != nullptr)
 			{
 				_observer->OnMediaSegmentDeleted(_track->GetId(), segment_to_delete.segment_number);
@@ -200,35 +191,94 @@ namespace bmff
 
 	std::shared_ptr<FMP4Segment> FMP4Storage::LoadMediaSegmentFromFile(uint32_t segment_number) const
 	{
-		if (_config.dvr_enabled == false)
+		if (_dvr_store == nullptr)
 		{
 			return nullptr;
 		}
 
-		auto info = _dvr_info.GetSegmentInfo(segment_number);
-		if (info.IsAvailable() == false)
+		auto segment = _dvr_store->LoadSegment(segment_number);
+		if (segment == nullptr)
 		{
-			logte("Could not find segment info: %u", segment_number);
+			logte("Could not find segment in DVR store: %u", segment_number);
 			return nullptr;
 		}
 
-		auto file_path = GetSegmentFilePath(segment_number);
+		return segment;
+	}
 
-		auto data = ov::LoadFromFile(file_path);
-		if (data == nullptr)
+	std::shared_ptr<ov::FileRange> FMP4Storage::GetDvrSegmentFileRange(uint32_t segment_number) const
+	{
+		if (_dvr_store == nullptr)
 		{
-			logte("Could not load segment from file: %s", file_path.CStr());
 			return nullptr;
 		}
 
-		auto segment = std::make_shared<FMP4Segment>(segment_number, info.duration_ms, data);
-		if (segment == nullptr)
 		{
-			logte("Could not create segment: %u", segment_number);
-			return nullptr;
+			std::shared_lock<std::shared_mutex> lock(_segments_lock);
+			auto index = segment_number - _number_of_deleted_segments;
+
+			if (index < _segments.size())
+			{
+				// The segment is still in memory
+				return nullptr;
+			}
 		}
 
-		return segment;
+		return _dvr_store->GetSegmentFileRange(segment_number);
+	}
+
+	int64_t FMP4Storage::FindSegmentNumber(int64_t timestamp) const
+	{
+		{
+			std::shared_lock<std::shared_mutex> lock(_segments_lock);
+
+			if (_segments.empty() == false && static_cast<int64_t>(_segments.front()->GetStartTimestamp()) <= timestamp)
+			{
+				auto it = std::upper_bound(_segments.begin(), _segments.end(), timestamp, [](int64_t timestamp, const std::shared_ptr<FMP4Segment> &segment) {
+					return timestamp < static_cast<int64_t>(segment->GetStartTimestamp());
+				});
+
+				return (*std::prev(it))->GetNumber();
+			}
+		}
+
+		if (_dvr_store == nullptr)
+		{
+			return -1;
+		}
+
+		return _dvr_store->FindSegmentNumber(timestamp);
+	}
+
+	int64_t FMP4Storage::FindIndependentSegmentNumber(int64_t timestamp) const
+	{
+		{
+			std::shared_lock<std::shared_mutex> lock(_segments_lock);
+
+			if (_segments.empty() == false && static_cast<int64_t>(_segments.front()->GetStartTimestamp()) <= timestamp)
+			{
+				auto it = std::upper_bound(_segments.begin(), _segments.end(), timestamp, [](int64_t timestamp, const std::shared_ptr<FMP4Segment> &segment) {
+					return timestamp < static_cast<int64_t>(segment->GetStartTimestamp());
+				});
+
+				while (it != _segments.begin())
+				{
+					--it;
+					auto first_chunk = (*it)->GetChunk(0);
+					if (first_chunk != nullptr && first_chunk->IsIndependent())
+					{
+						return (*it)->GetNumber();
+					}
+				}
+			}
+		}
+
+		if (_dvr_store == nullptr)
+		{
+			return -1;
+		}
+
+		return _dvr_store->FindIndependentSegmentNumber(timestamp);
 	}
 
 	bool FMP4Storage::AppendMediaChunk(const std::shared_ptr<ov::Data> &chunk, int64_t start_timestamp, double duration_ms, bool independent, bool last_chunk)
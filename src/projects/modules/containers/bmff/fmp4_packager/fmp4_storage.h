@@ -9,6 +9,7 @@
 #pragma once
 
 #include "fmp4_structure.h"
+#include "fmp4_dvr_store.h"
 
 namespace bmff
 {
@@ -31,6 +32,8 @@ namespace bmff
 			bool dvr_enabled = false;
 			ov::String dvr_storage_path;
 			uint64_t dvr_duration_sec = 0;
+			// Size of each DVR volume file
+			uint64_t dvr_volume_size = FMP4_DVR_DEFAULT_VOLUME_SIZE;
 		};
 
 		FMP4Storage(const std::shared_ptr<FMp4StorageObserver> &observer, const std::shared_ptr<const MediaTrack> &track, const Config &config, const ov::String &stream_tag);
@@ -53,110 +56,20 @@ namespace bmff
 
 		int64_t GetTargetSegmentDuration() const;
 
+		// Returns the file range of the segment if it has been moved to the DVR store, nullptr otherwise
+		std::shared_ptr<ov::FileRange> GetDvrSegmentFileRange(uint32_t segment_number) const;
+
+		// Returns the number of the segment containing the timestamp (including DVR segments), -1 if not found
+		int64_t FindSegmentNumber(int64_t timestamp) const;
+		// Returns the number of the nearest segment starting with a keyframe at or before the timestamp (including DVR segments), -1 if not found
+		int64_t FindIndependentSegmentNumber(int64_t timestamp) const;
+
 	private:
 
 		// For DVR
-		class DvrInfo
-		{
-		public:
-			struct SegmentInfo
-			{
-				uint32_t segment_number = 0;
-				double duration_ms = 0;
-				size_t segment_size = 0;
-
-				bool IsAvailable() const
-				{
-					return segment_size != 0;
-				}
-			}; 
-
-			// Get total duration of all segments
-			uint64_t GetTotalDurationMs() const
-			{
-				return _total_dvr_segment_duration_ms;
-			}
-
-			// Get total number of segments
-			uint32_t GetTotalSegmentCount() const
-			{
-				return _segments.size();
-			}
-
-			void AppendSegment(uint32_t segment_number, double duration_ms, size_t segment_size)
-			{
-				//lock
-				std::lock_guard<std::shared_mutex> lock(_segments_lock);
-				
-				if (_segments.empty())
-				{
-					_first_segment_number = segment_number;
-				}
-				else
-				{
-					if (_segments.back().segment_number + 1 != segment_number)
-					{
-						logw("DVR", "Segment number is not continuous: %u -> %u", _segments.front().segment_number, segment_number);
-					}
-				}
-
-				_segments.push_back({segment_number, duration_ms, segment_size});
-				_total_dvr_segment_duration_ms += duration_ms;
-			}
-
-			// Pop oldest segment info
-			SegmentInfo PopOldestSegmentInfo()
-			{
-				//lock
-				std::lock_guard<std::shared_mutex> lock(_segments_lock);
-
-				if(_segments.empty())
-				{
-					return {0, 0, 0};
-				}
-
-				auto segment_info = _segments.front();
-				_segments.pop_front();
-				_total_dvr_segment_duration_ms -= segment_info.duration_ms;
-
-				// update first segment number
-				_first_segment_number += 1;
-
-				return segment_info;
-			}
-
-			// Get segment info
-			SegmentInfo GetSegmentInfo(uint32_t segment_number) const
-			{
-				//lock
-				std::shared_lock<std::shared_mutex> lock(_segments_lock);
-
-				if(_segments.empty())
-				{
-					return {0, 0, 0};
-				}
-
-				// Check if the segment number is valid
-				if (_first_segment_number > segment_number)
-				{
-					return {0, 0, 0};
-				}
-
-				return _segments[segment_number - _first_segment_number];
-			}
-
-		private:
-			std::deque<SegmentInfo> _segments;
-			// segments lock
-			mutable std::shared_mutex _segments_lock;
-			uint32_t _first_segment_number = 0;
-			double _total_dvr_segment_duration_ms = 0;
-		};
-
-		DvrInfo _dvr_info;
+		std::shared_ptr<FMP4DvrStore> _dvr_store;
 
 		ov::String GetDVRDirectory() const;
-		ov::String GetSegmentFilePath(uint32_t segment_number) const;
 		bool SaveMediaSegmentToFile(const std::shared_ptr<FMP4Segment> &segment);
 		std::shared_ptr<FMP4Segment> LoadMediaSegmentFromFile(uint32_t segment_number) const;
 
@@ -83,6 +83,19 @@ namespace bmff
 			SetCompleted();
 		}
 
+		// Completed segment restored from the DVR store
+		FMP4Segment(uint64_t number, int64_t start_timestamp, double duration_ms, const std::shared_ptr<ov::Data> &data, const std::deque<std::shared_ptr<FMP4Chunk>> &chunks)
+		{
+			_number = number;
+			_start_timestamp = start_timestamp;
+			_duration_ms = duration_ms;
+			_data = data;
+			_chunks = chunks;
+			_last_chunk_number = static_cast<int64_t>(_chunks.size()) - 1;
+
+			SetCompleted();
+		}
+
 		void SetCompleted()
 		{
 			_is_completed = true;
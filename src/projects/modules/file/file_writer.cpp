@@ -287,8 +287,15 @@ bool FileWriter::AddTrack(cmn::MediaType media_type, int32_t track_id, std::shar
 //	- H264 : AnnexB bitstream
 // 	- AAC : ASC(Audio Specific Config) bitstream
 
-bool FileWriter::PutData(int32_t track_id, int64_t pts, int64_t dts, MediaPacketFlag flag, cmn::BitstreamFormat format, std::shared_ptr<ov::Data> &data)
+bool FileWriter::PutData(const std::shared_ptr<const MediaPacket> &media_packet)
 {
+	auto track_id = media_packet->GetTrackId();
+	auto pts = media_packet->GetPts();
+	auto dts = media_packet->GetDts();
+	auto flag = media_packet->GetFlag();
+	auto format = media_packet->GetBitstreamFormat();
+	auto data = media_packet->GetData();
+
 	std::lock_guard<std::shared_mutex> mlock(_lock);
 
 	if (_format_context == nullptr)
@@ -363,7 +370,7 @@ bool FileWriter::PutData(int32_t track_id, int64_t pts, int64_t dts, MediaPacket
 		switch (format)
 		{
 			case cmn::BitstreamFormat::H264_ANNEXB:
-				cdata = H264Converter::ConvertAnnexbToAvcc(data);
+				cdata = H264Converter::GetAvccView(media_packet)->GetData();
 				av_packet.size = cdata->GetLength();
 				av_packet.data = (uint8_t *)cdata->GetDataAs<uint8_t>();
 				break;
@@ -312,10 +312,16 @@ namespace http
 
 			if (h == 1)
 			{
-				auto encoded_data = std::make_shared<ov::Data>(reader->CurrentPosition(), length);
-				reader->SkipBytes(length);
+				if (reader->BytesReamined() < length)
+				{
+					return false;
+				}
+
 				// Decode Huffman Encoded String
-				if (HuffmanCodec::GetInstance()->Decode(encoded_data, value) == false)
+				auto encoded_data = reader->CurrentPosition();
+				reader->SkipBytes(length);
+
+				if (HuffmanCodec::GetInstance()->Decode(encoded_data, length, value) == false)
 				{
 					return false;
 				}
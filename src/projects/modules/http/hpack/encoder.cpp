@@ -25,6 +25,27 @@ namespace http
 			return true;
 		}
 
+		std::shared_ptr<ov::Data> Encoder::EncodePendingTableSizeUpdate()
+		{
+			if (_need_signal_table_size_update == false)
+			{
+				return nullptr;
+			}
+
+			std::shared_ptr<ov::Data> encoded_data = std::make_shared<ov::Data>(8);
+			ov::ByteStream stream(encoded_data.get());
+
+			if (EncodeDynamicTableSizeUpdate(stream, _table_connector.GetDynamicTableSize()) == false)
+			{
+				logte("Failed to encode DynamicTableSizeUpdate (%u) field", _table_connector.GetDynamicTableSize());
+				return nullptr;
+			}
+
+			_need_signal_table_size_update = false;
+
+			return encoded_data;
+		}
+
 		std::shared_ptr<ov::Data> Encoder::Encode(const HeaderField &header_fields, EncodingType type)
 		{
 			std::shared_ptr<ov::Data> encoded_data = std::make_shared<ov::Data>(header_fields.GetSize());
@@ -224,29 +245,30 @@ namespace http
 
 		bool Encoder::WriteString(ov::ByteStream &stream, const ov::String &value, bool huffman_encoding)
 		{
-			std::shared_ptr<ov::Data> data = nullptr;
-
 			if (huffman_encoding == true)
 			{
-				data = HuffmanCodec::GetInstance()->Encode(value);
-				if (data == nullptr)
+				auto huffman_codec = HuffmanCodec::GetInstance();
+				auto encoded_length = huffman_codec->GetEncodedLength(value);
+
+				// Huffman encoding is used only if it makes the string shorter
+				if (encoded_length < value.GetLength())
 				{
-					logte("Failed to encode string");
-					return false;
+					// Write the length - 0x80 mask means string is Huffman Encoded
+					WriteInteger(stream, 0x80, 7, encoded_length);
+
+					if (huffman_codec->Encode(value, stream) == false)
+					{
+						logte("Failed to encode string");
+						return false;
+					}
+
+					return true;
 				}
 			}
-			else
-			{
-				data = value.ToData(false);
-			}
 
-			// Write the length - 0x80 mask means string is Huffman Encoded
-			WriteInteger(stream, 0x80, 7, data->GetLength());
-			
-			// Write encoded string
-			stream.Write(data);
+			WriteInteger(stream, 0x00, 7, value.GetLength());
 
-			return true;
+			return stream.Write(value.CStr(), value.GetLength());
 		}
 
 	} // namespace hpack
@@ -29,6 +29,10 @@ namespace http
 
 			bool UpdateDynamicTableSize(size_t size);
 
+			// Returns the Dynamic Table Size Update that has not been signaled yet (nullptr if there is none)
+			// It MUST be placed at the beginning of the next header block (RFC 7541 4.2)
+			std::shared_ptr<ov::Data> EncodePendingTableSizeUpdate();
+
 			std::shared_ptr<ov::Data> Encode(const HeaderField &header_fields, EncodingType type);
 
 		private:
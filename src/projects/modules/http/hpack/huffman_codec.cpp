@@ -7,7 +7,6 @@
 //
 //==============================================================================
 
-#include <base/ovlibrary/bit_reader.h>
 #include "huffman_codec.h"
 
 namespace http
@@ -274,142 +273,245 @@ namespace http
 			Build(0x7fffff0, 27, 254);
 			Build(0x3ffffee, 26, 255);
 			Build(0x3fffffff, 30, 256); //EOS
+
+			BuildDecodeTable();
+
+			_tree.clear();
+			_tree.shrink_to_fit();
+		}
+
+		void HuffmanCodec::Build(uint32_t code, uint8_t length, uint16_t symbol)
+		{
+			_encode_table[symbol].code = code;
+			_encode_table[symbol].length = length;
+
+			if (_tree.empty())
+			{
+				// Root
+				_tree.emplace_back();
+				_tree[0].accept = true;
+			}
+
+			uint16_t node = 0;
+
+			for (uint8_t i = 0; i < length; i++)
+			{
+				auto bit = (code >> (length - i - 1)) & 0x1;
+
+				if (_tree[node].children[bit] == 0)
+				{
+					TreeNode child;
+					// The padding is the most significant bits of EOS (all 1s), up to 7 bits
+					child.accept = _tree[node].accept && (bit == 1) && (i < 7);
+
+					_tree[node].children[bit] = static_cast<uint16_t>(_tree.size());
+					_tree.push_back(child);
+				}
+
+				node = _tree[node].children[bit];
+			}
+
+			_tree[node].symbol = symbol;
+		}
+
+		void HuffmanCodec::BuildDecodeTable()
+		{
+			// Number the internal nodes
+			int state = 0;
+
+			for (auto &node : _tree)
+			{
+				if (node.symbol < 0)
+				{
+					OV_ASSERT2(state < StateCount);
+					node.state = static_cast<uint8_t>(state++);
+				}
+			}
+
+			for (const auto &from : _tree)
+			{
+				if (from.symbol >= 0)
+				{
+					continue;
+				}
+
+				for (int nibble = 0; nibble < (1 << DecodeBits); nibble++)
+				{
+					auto &entry = _decode_table[from.state][nibble];
+					const TreeNode *node = &from;
+
+					for (int i = DecodeBits - 1; i >= 0; i--)
+					{
+						auto child = node->children[(nibble >> i) & 0x1];
+
+						if (child == 0)
+						{
+							entry.flags = DecodeFlag::Fail;
+							break;
+						}
+
+						node = &_tree[child];
+
+						if (node->symbol >= 0)
+						{
+							if (node->symbol == EOS)
+							{
+								// https://www.rfc-editor.org/rfc/rfc7541.html#section-5.2
+								// A Huffman-encoded string literal containing the EOS symbol MUST be treated as a decoding error.
+								entry.flags = DecodeFlag::Fail;
+								break;
+							}
+
+							// The shortest code is 5 bits, so at most one symbol is decoded in a nibble
+							entry.flags |= DecodeFlag::Emit;
+							entry.symbol = static_cast<uint8_t>(node->symbol);
+							node = &_tree[0];
+						}
+					}
+
+					if (entry.flags & DecodeFlag::Fail)
+					{
+						continue;
+					}
+
+					entry.state = node->state;
+
+					if (node->accept)
+					{
+						entry.flags |= DecodeFlag::Accept;
+					}
+				}
+			}
 		}
 
-		std::shared_ptr<ov::Data> HuffmanCodec::Encode(const ov::String &str)
+		size_t HuffmanCodec::GetEncodedLength(const ov::String &str) const
 		{
-			uint8_t out_data[str.GetLength() * 2];
+			size_t bit_length = 0;
+			auto data = reinterpret_cast<const uint8_t *>(str.CStr());
+			auto length = str.GetLength();
+
+			for (size_t i = 0; i < length; i++)
+			{
+				bit_length += _encode_table[data[i]].length;
+			}
+
+			return (bit_length + 7) / 8;
+		}
+
+		bool HuffmanCodec::Encode(const ov::String &str, ov::ByteStream &stream) const
+		{
+			uint8_t out_data[256];
 			size_t out_data_size = 0;
 
 			uint64_t bit_buffer = 0;
 			size_t bit_buffer_length = 0;
-			size_t length = str.GetLength();
+
+			auto data = reinterpret_cast<const uint8_t *>(str.CStr());
+			auto length = str.GetLength();
+
 			for (size_t i = 0; i < length; i++)
 			{
-				uint8_t c = str[i];
-				auto [code, code_bit_length] = _map[c];
-				
-				// Append the code to the bit buffer
-				bit_buffer <<= code_bit_length;
-				bit_buffer |= code;
-				bit_buffer_length += code_bit_length;
-
-				// If the bit buffer is over 8 bits, flush it to the output buffer
-				while (bit_buffer_length >= 8)
+				const auto &code = _encode_table[data[i]];
+
+				// Append the code to the bit buffer (the longest code is 30 bits, so it never overflows)
+				bit_buffer = (bit_buffer << code.length) | code.code;
+				bit_buffer_length += code.length;
+
+				// If the bit buffer is over 32 bits, flush 4 bytes at once
+				if (bit_buffer_length >= 32)
 				{
-					uint8_t byte = static_cast<uint8_t>(bit_buffer >> (bit_buffer_length - 8));
-					bit_buffer_length -= 8;
-					out_data[out_data_size] = byte;
-					out_data_size ++;
+					bit_buffer_length -= 32;
+					auto bits = static_cast<uint32_t>(bit_buffer >> bit_buffer_length);
+
+					out_data[out_data_size++] = static_cast<uint8_t>(bits >> 24);
+					out_data[out_data_size++] = static_cast<uint8_t>(bits >> 16);
+					out_data[out_data_size++] = static_cast<uint8_t>(bits >> 8);
+					out_data[out_data_size++] = static_cast<uint8_t>(bits);
+
+					if (out_data_size > (sizeof(out_data) - 4))
+					{
+						if (stream.Write(out_data, out_data_size) == false)
+						{
+							return false;
+						}
+
+						out_data_size = 0;
+					}
 				}
 			}
-			
+
+			while (bit_buffer_length >= 8)
+			{
+				bit_buffer_length -= 8;
+				out_data[out_data_size++] = static_cast<uint8_t>(bit_buffer >> bit_buffer_length);
+			}
+
 			// https://www.rfc-editor.org/rfc/rfc7541.html#section-5.2
 			// As the Huffman-encoded data doesn't always end at an octet boundary,
 			// some padding is inserted after it, up to the next octet boundary.  To
 			// prevent this padding from being misinterpreted as part of the string
 			// literal, the most significant bits of the code corresponding to the
 			// EOS (end-of-string) symbol are used.
-
-			// Append EOS
 			if (bit_buffer_length > 0)
 			{
-				auto byte = bit_buffer << (8 - bit_buffer_length);
 				// Append EOS(0xFF) to the end of the bit buffer
-				// bit_buffer is always less than 8 bits
+				auto byte = static_cast<uint8_t>(bit_buffer << (8 - bit_buffer_length));
 				byte |= 0xFF >> bit_buffer_length;
 
-				out_data[out_data_size] = byte;
-				out_data_size ++;
+				out_data[out_data_size++] = byte;
 			}
-			
-			return std::make_shared<ov::Data>(&out_data[0], out_data_size);
+
+			return (out_data_size == 0) || stream.Write(out_data, out_data_size);
 		}
 
-		bool HuffmanCodec::Decode(const std::shared_ptr<const ov::Data> &data, ov::String &str)
+		bool HuffmanCodec::Decode(const uint8_t *data, size_t length, ov::String &str) const
 		{
-			auto reader = std::make_shared<BitReader>(data->GetDataAs<uint8_t>(), data->GetLength());
-			auto node = _tree;
+			char out_data[256];
+			size_t out_data_size = 0;
+
+			uint8_t state = 0;
+			// An empty string is valid
+			bool accept = true;
 
-			while (reader->BytesReamined() > 0)
+			for (size_t i = 0; i < length; i++)
 			{
-				auto b = reader->ReadBit();
-				if (b == 1)
-				{
-					node = node->GetRight();
-					if (node == nullptr)
-					{
-						return false;
-					}
-				}
-				else
+				auto byte = data[i];
+
+				for (auto nibble : {byte >> 4, byte & 0x0F})
 				{
-					node = node->GetLeft();
-					if (node == nullptr)
+					const auto &entry = _decode_table[state][nibble];
+
+					if (entry.flags & DecodeFlag::Fail)
 					{
 						return false;
 					}
-				}
 
-				if (node->IsLeaf())
-				{
-					if (node->GetValue() == 256)
+					if (entry.flags & DecodeFlag::Emit)
 					{
-						// EOS
-						return false;
+						out_data[out_data_size++] = static_cast<char>(entry.symbol);
 					}
 
-					str.Append(static_cast<uint8_t>(node->GetValue()));
-					node = _tree;
-
-					// https://www.rfc-editor.org/rfc/rfc7541.html#section-5.2
-					// As the Huffman-encoded data doesn't always end at an octet boundary,
-					// some padding is inserted after it, up to the next octet boundary.  To
-					// prevent this padding from being misinterpreted as part of the string
-					// literal, the most significant bits of the code corresponding to the
-					// EOS (end-of-string) symbol are used.
-
-					// So, the symbol (1111111) corresponding to EOS may be included in the 
-					// last 7 bits or less. In this case, no processing is done because it will 
-					// terminate without reaching the leaf naturally.
+					state = entry.state;
+					accept = (entry.flags & DecodeFlag::Accept);
 				}
-			}
-
-			return true;
-		}
-
-		void HuffmanCodec::BuildTree(uint32_t code, uint8_t length, uint16_t symbol)
-		{
-			//TODO(Getroot): If needed, apply faster algorithm
-			auto node = _tree;
-
-			for (uint16_t i = 0; i < length; i++)
-			{
-				auto bit = (code >> (length - i - 1)) & 0x1;
 
-				if (bit == 0)
-				{
-					node = node->GetLeft(true);
-				}
-				else
+				// Up to 2 symbols are decoded per byte
+				if (out_data_size > (sizeof(out_data) - 2))
 				{
-					node = node->GetRight(true);
+					str.Append(out_data, out_data_size);
+					out_data_size = 0;
 				}
 			}
 
-			node->SetValue(symbol);
-		}
-
-		void HuffmanCodec::BuildMap(uint32_t code, uint8_t length, uint16_t symbol)
-		{
-			_map[symbol] = std::make_pair(code, length);
-		}
+			if (out_data_size > 0)
+			{
+				str.Append(out_data, out_data_size);
+			}
 
-		// Build Tree and Map
-		void HuffmanCodec::Build(uint32_t code, uint8_t length, uint16_t symbol)
-		{
-			BuildMap(code, length, symbol);
-			BuildTree(code, length, symbol);
+			// https://www.rfc-editor.org/rfc/rfc7541.html#section-5.2
+			// A padding strictly longer than 7 bits or not corresponding to the most significant bits
+			// of the code for the EOS symbol MUST be treated as a decoding error.
+			return accept;
 		}
 	} // namespace hpack
 } // namespace http
\ No newline at end of file
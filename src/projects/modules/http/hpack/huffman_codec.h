@@ -19,66 +19,69 @@ namespace http
 		{
 		public:
 			HuffmanCodec();
-			std::shared_ptr<ov::Data> Encode(const ov::String &str);
-			bool Decode(const std::shared_ptr<const ov::Data> &data, ov::String &str);
-			
+
+			// Returns the length of the Huffman encoded string in bytes
+			size_t GetEncodedLength(const ov::String &str) const;
+			// Appends the Huffman encoded string to the stream
+			bool Encode(const ov::String &str, ov::ByteStream &stream) const;
+
+			bool Decode(const uint8_t *data, size_t length, ov::String &str) const;
+
 		private:
-			// Build Tree and Map
-			void Build(uint32_t code, uint8_t length, uint16_t symbol);
-			// Build Map for encoding from symbol to code
-			void BuildMap(uint32_t code, uint8_t length, uint16_t symbol);
-			// Build Tree for decoding from code to symbol
-			void BuildTree(uint32_t code, uint8_t length, uint16_t symbol);
+			static constexpr uint16_t EOS = 256;
+			static constexpr uint16_t SymbolCount = 257;
 
-			class Node
+			// Decoding is done 4 bits at a time. The state is an internal node of the Huffman tree (the root is 0),
+			// so the result of every (state, nibble) pair is precomputed.
+			static constexpr int DecodeBits = 4;
+			static constexpr int StateCount = 256;
+
+			enum DecodeFlag : uint8_t
 			{
-			public:
-				Node* GetLeft(bool create = false)
-				{
-					if (_left == nullptr && create == true)
-					{
-						_left = new Node();
-					}
+				// A symbol is decoded in the nibble
+				Emit = 0x01,
+				// The bits consumed since the last symbol are a valid padding (up to 7 bits of the EOS prefix)
+				Accept = 0x02,
+				// Invalid code or EOS
+				Fail = 0x04
+			};
 
-					return _left;
-				}
+			struct Code
+			{
+				uint32_t code = 0;
+				uint8_t length = 0;
+			};
 
-				Node* GetRight(bool create = false)
-				{
-					if (_right == nullptr && create == true)
-					{
-						_right = new Node();
-					}
+			struct DecodeEntry
+			{
+				uint8_t state = 0;
+				uint8_t flags = 0;
+				uint8_t symbol = 0;
+			};
 
-					return _right;
-				}
+			struct TreeNode
+			{
+				// Index of the child node for bit 0/1 (0 means none since the root cannot be a child)
+				uint16_t children[2] = {0, 0};
+				int16_t symbol = -1;
+				// Index in the decode table if the node is an internal node
+				uint8_t state = 0;
+				// Whether the path from the root consists of 1s only and is shorter than 8 bits
+				bool accept = false;
+			};
 
-				void SetValue(uint16_t value)
-				{
-					_value = value;
-					_is_leaf = true;
-				}
-				
-				uint16_t GetValue()
-				{
-					return _value;
-				}
+			// Build the encode table and the tree
+			void Build(uint32_t code, uint8_t length, uint16_t symbol);
+			// Build the decode table from the tree
+			void BuildDecodeTable();
 
-				bool IsLeaf()
-				{
-					return _is_leaf;
-				}
-				
-			private:
-				Node* _left = nullptr;
-				Node* _right = nullptr;
-				uint16_t _value = 0;
-				bool _is_leaf = false;
-			};
+			// symbol -> code
+			Code _encode_table[SymbolCount];
+			// [state][nibble] -> next state
+			DecodeEntry _decode_table[StateCount][1 << DecodeBits];
 
-			// 
-			Node* _tree = new Node();
-			std::unordered_map<uint8_t, std::pair<uint32_t, uint8_t>> _map;
+			// Only used while building the tables
+			std::vector<TreeNode> _tree;
 		};
-	}
-}
\ No newline at end of file
+	}  // namespace hpack
+}  // namespace http
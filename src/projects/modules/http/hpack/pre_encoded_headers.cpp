@@ -0,0 +1,111 @@
+//==============================================================================
+//
+//  OvenMediaEngine
+//
+//  Created by Getroot
+//  Copyright (c) 2022 AirenSoft. All rights reserved.
+//
+//==============================================================================
+#include "pre_encoded_headers.h"
+
+#include "hpack_private.h"
+
+namespace http
+{
+	namespace hpack
+	{
+		PreEncodedHeaders::PreEncodedHeaders()
+		{
+			_cacheable_name_set = {
+				"content-type",
+				"content-encoding",
+				"cache-control",
+				"pragma",
+				"vary",
+				"server",
+				"access-control-allow-credentials",
+				"access-control-allow-headers",
+				"access-control-allow-methods",
+				"access-control-allow-private-network",
+				"access-control-expose-headers"};
+
+			// :status values in the static table
+			for (auto status : {"200", "204", "206", "304", "400", "404", "500"})
+			{
+				Add(":status", status);
+			}
+
+			// Segments/playlists of HLS, LL-HLS and DASH
+			Add("content-type", "video/mp4");
+			Add("content-type", "audio/mp4");
+			Add("content-type", "application/vnd.apple.mpegurl");
+			Add("content-type", "application/dash+xml");
+			Add("content-type", "video/MP2T");
+			Add("content-encoding", "gzip");
+			Add("cache-control", "no-cache, no-store");
+			Add("cache-control", "no-cache, no-store, must-revalidate");
+
+			// CORS
+			Add("access-control-allow-origin", "*");
+			Add("access-control-allow-credentials", "true");
+			Add("access-control-allow-methods", "GET, OPTIONS");
+			Add("access-control-allow-headers", "*");
+			Add("vary", "Origin");
+		}
+
+		std::shared_ptr<const ov::Data> PreEncodedHeaders::Get(const ov::String &name, const ov::String &value)
+		{
+			{
+				std::shared_lock<std::shared_mutex> lock(_header_map_lock);
+
+				auto name_item = _header_map.find(name);
+				if (name_item != _header_map.end())
+				{
+					auto value_item = name_item->second.find(value);
+					if (value_item != name_item->second.end())
+					{
+						return value_item->second;
+					}
+				}
+			}
+
+			if (_cacheable_name_set.find(name) == _cacheable_name_set.end())
+			{
+				return nullptr;
+			}
+
+			return Add(name, value);
+		}
+
+		std::shared_ptr<const ov::Data> PreEncodedHeaders::Add(const ov::String &name, const ov::String &value)
+		{
+			std::lock_guard<std::shared_mutex> lock(_header_map_lock);
+
+			auto &value_map = _header_map[name];
+
+			auto value_item = value_map.find(value);
+			if (value_item != value_map.end())
+			{
+				// Added by another thread
+				return value_item->second;
+			}
+
+			if (_count >= HPACK_PRE_ENCODED_HEADERS_MAX_COUNT)
+			{
+				return nullptr;
+			}
+
+			std::shared_ptr<const ov::Data> encoded = _encoder.Encode({name, value}, Encoder::EncodingType::LiteralWithoutIndexing);
+			if (encoded == nullptr)
+			{
+				logte("Could not pre-encode the header field: %s: %s", name.CStr(), value.CStr());
+				return nullptr;
+			}
+
+			value_map.emplace(value, encoded);
+			_count++;
+
+			return encoded;
+		}
+	}  // namespace hpack
+}  // namespace http
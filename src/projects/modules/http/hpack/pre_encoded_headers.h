@@ -0,0 +1,52 @@
+//==============================================================================
+//
+//  OvenMediaEngine
+//
+//  Created by Getroot
+//  Copyright (c) 2022 AirenSoft. All rights reserved.
+//
+//==============================================================================
+#pragma once
+
+#include <base/ovlibrary/ovlibrary.h>
+#include <set>
+
+#include "encoder.h"
+
+// Maximum number of header fields cached on demand
+#define HPACK_PRE_ENCODED_HEADERS_MAX_COUNT 1024
+
+namespace http
+{
+	namespace hpack
+	{
+		// Header field representations that do not depend on the state of a connection,
+		// so they can be encoded once and shared by all HTTP/2 responses.
+		//
+		// A header field is encoded as an Indexed Header Field if it is in the static table,
+		// otherwise as a Literal Header Field without Indexing (the name is indexed only in the static table).
+		// The dynamic table of the connection is not changed by them.
+		class PreEncodedHeaders : public ov::Singleton<PreEncodedHeaders>
+		{
+		public:
+			PreEncodedHeaders();
+
+			// name must be lowercase. Returns nullptr if the header field is not cacheable.
+			std::shared_ptr<const ov::Data> Get(const ov::String &name, const ov::String &value);
+
+		private:
+			std::shared_ptr<const ov::Data> Add(const ov::String &name, const ov::String &value);
+
+			// Header names whose values are cached on demand (values of these headers are expected to be repeated)
+			std::set<ov::String> _cacheable_name_set;
+
+			std::shared_mutex _header_map_lock;
+			// name : (value : encoded)
+			std::map<ov::String, std::map<ov::String, std::shared_ptr<const ov::Data>>> _header_map;
+			size_t _count = 0;
+
+			// Encoder that never indexes anything in its dynamic table
+			Encoder _encoder;
+		};
+	}  // namespace hpack
+}  // namespace http
@@ -0,0 +1,268 @@
+//==============================================================================
+//
+//  OvenMediaEngine
+//
+//  Created by Hyunjun Jang
+//  Copyright (c) 2022 AirenSoft. All rights reserved.
+//
+//==============================================================================
+#include "web_socket_deflate.h"
+
+#include <base/ovlibrary/converter.h>
+
+#include "./web_socket_private.h"
+
+namespace http
+{
+	namespace prot
+	{
+		namespace ws
+		{
+			// RFC7692 - 7.2.1. Compression
+			// The trailing 4 octets of the block flushed with Z_SYNC_FLUSH are removed from the payload,
+			// and appended again before decompression
+			static const uint8_t DEFLATE_TRAILER[] = {0x00, 0x00, 0xFF, 0xFF};
+
+			std::shared_ptr<PerMessageDeflate> PerMessageDeflate::Create(const ov::String &offers)
+			{
+				// Sec-WebSocket-Extensions: permessage-deflate; client_max_window_bits, permessage-deflate
+				for (const auto &offer : offers.Split(","))
+				{
+					auto params = offer.Split(";");
+
+					if (params.empty() || (params[0].Trim().LowerCaseString() != ExtensionName))
+					{
+						continue;
+					}
+
+					bool server_no_context_takeover = false;
+					int server_max_window_bits = WEBSOCKET_DEFLATE_WINDOW_BITS;
+					bool is_server_max_window_bits_offered = false;
+					bool is_acceptable = true;
+
+					for (size_t index = 1; index < params.size(); index++)
+					{
+						auto key_value = params[index].Split("=", 2);
+						auto key = key_value[0].Trim().LowerCaseString();
+						auto value = (key_value.size() > 1) ? key_value[1].Trim() : "";
+
+						if ((value.GetLength() >= 2) && value.HasPrefix('"') && (value.Get(value.GetLength() - 1) == '"'))
+						{
+							value = value.Substring(1, value.GetLength() - 2);
+						}
+
+						if (key == "server_no_context_takeover")
+						{
+							server_no_context_takeover = true;
+						}
+						else if (key == "server_max_window_bits")
+						{
+							auto window_bits = ov::Converter::ToInt32(value.CStr());
+
+							// zlib does not support the window of 256 bytes for raw deflate
+							if ((window_bits < 9) || (window_bits > 15))
+							{
+								is_acceptable = false;
+								break;
+							}
+
+							server_max_window_bits = std::min(window_bits, WEBSOCKET_DEFLATE_WINDOW_BITS);
+							is_server_max_window_bits_offered = true;
+						}
+						else if ((key == "client_no_context_takeover") || (key == "client_max_window_bits"))
+						{
+							// Incoming messages are always decompressed with the maximum window
+						}
+						else
+						{
+							logtd("Unknown parameter of %s: %s", ExtensionName, params[index].CStr());
+							is_acceptable = false;
+							break;
+						}
+					}
+
+					if (is_acceptable)
+					{
+						return std::make_shared<PerMessageDeflate>(server_no_context_takeover, server_max_window_bits, is_server_max_window_bits_offered);
+					}
+				}
+
+				return nullptr;
+			}
+
+			PerMessageDeflate::PerMessageDeflate(bool server_no_context_takeover, int server_max_window_bits, bool is_server_max_window_bits_offered)
+				: _server_no_context_takeover(server_no_context_takeover),
+				  _server_max_window_bits(server_max_window_bits),
+				  _is_server_max_window_bits_offered(is_server_max_window_bits_offered)
+			{
+			}
+
+			PerMessageDeflate::~PerMessageDeflate()
+			{
+				if (_is_compressor_initialized)
+				{
+					deflateEnd(&_compressor);
+				}
+			}
+
+			ov::String PerMessageDeflate::GetResponseHeaderValue() const
+			{
+				ov::String value = ExtensionName;
+
+				value.Append("; client_no_context_takeover");
+
+				if (_server_no_context_takeover)
+				{
+					value.Append("; server_no_context_takeover");
+				}
+
+				if (_is_server_max_window_bits_offered)
+				{
+					value.AppendFormat("; server_max_window_bits=%d", _server_max_window_bits);
+				}
+
+				return value;
+			}
+
+			bool PerMessageDeflate::IsCompressible(const std::shared_ptr<const ov::Data> &payload) const
+			{
+				return (payload != nullptr) && (payload->GetLength() >= WEBSOCKET_DEFLATE_MIN_PAYLOAD_SIZE);
+			}
+
+			bool PerMessageDeflate::InitializeCompressor()
+			{
+				if (_is_compressor_initialized)
+				{
+					return true;
+				}
+
+				// Negative window bits means raw deflate (without zlib header and checksum)
+				if (deflateInit2(&_compressor, Z_DEFAULT_COMPRESSION, Z_DEFLATED, -_server_max_window_bits, WEBSOCKET_DEFLATE_MEM_LEVEL, Z_DEFAULT_STRATEGY) != Z_OK)
+				{
+					logte("Could not initialize the compressor of %s", ExtensionName);
+					return false;
+				}
+
+				_is_compressor_initialized = true;
+				return true;
+			}
+
+			std::shared_ptr<ov::Data> PerMessageDeflate::Compress(const std::shared_ptr<const ov::Data> &payload)
+			{
+				if (InitializeCompressor() == false)
+				{
+					return nullptr;
+				}
+
+				// Reserve room for the flushed block, so deflate() is usually called only once
+				auto output = std::make_shared<ov::Data>(deflateBound(&_compressor, payload->GetLength()) + 16);
+
+				_compressor.next_in = const_cast<Bytef *>(payload->GetDataAs<Bytef>());
+				_compressor.avail_in = static_cast<uInt>(payload->GetLength());
+
+				do
+				{
+					if (output->GetLength() == output->GetCapacity())
+					{
+						output->Reserve(output->GetCapacity() * 2);
+					}
+
+					auto offset = output->GetLength();
+					auto available = output->GetCapacity() - offset;
+
+					output->SetLength(output->GetCapacity());
+					_compressor.next_out = output->GetWritableDataAs<Bytef>() + offset;
+					_compressor.avail_out = static_cast<uInt>(available);
+
+					auto result = deflate(&_compressor, Z_SYNC_FLUSH);
+
+					output->SetLength(offset + available - _compressor.avail_out);
+
+					if ((result != Z_OK) && (result != Z_BUF_ERROR))
+					{
+						logte("Could not compress the message: %d", result);
+						return nullptr;
+					}
+				} while (_compressor.avail_out == 0);
+
+				if (_server_no_context_takeover)
+				{
+					deflateReset(&_compressor);
+				}
+
+				if ((output->GetLength() >= sizeof(DEFLATE_TRAILER)) &&
+					(::memcmp(output->GetDataAs<uint8_t>() + output->GetLength() - sizeof(DEFLATE_TRAILER), DEFLATE_TRAILER, sizeof(DEFLATE_TRAILER)) == 0))
+				{
+					output->SetLength(output->GetLength() - sizeof(DEFLATE_TRAILER));
+				}
+
+				return output;
+			}
+
+			std::shared_ptr<ov::Data> PerMessageDeflate::Decompress(const std::shared_ptr<const ov::Data> &payload) const
+			{
+				// Since the client does not take over the context, a decompressor is created for each message
+				z_stream decompressor{};
+
+				if (inflateInit2(&decompressor, -MAX_WBITS) != Z_OK)
+				{
+					logte("Could not initialize the decompressor of %s", ExtensionName);
+					return nullptr;
+				}
+
+				auto input = payload->Clone();
+				input->Append(DEFLATE_TRAILER, sizeof(DEFLATE_TRAILER));
+
+				decompressor.next_in = input->GetWritableDataAs<Bytef>();
+				decompressor.avail_in = static_cast<uInt>(input->GetLength());
+
+				auto output = std::make_shared<ov::Data>(std::max<size_t>(payload->GetLength() * 4, 1024));
+				bool succeeded = true;
+
+				do
+				{
+					if (output->GetLength() == output->GetCapacity())
+					{
+						if (output->GetCapacity() >= WEBSOCKET_DEFLATE_MAX_MESSAGE_SIZE)
+						{
+							logte("The decompressed message is too large (> %lld bytes)", WEBSOCKET_DEFLATE_MAX_MESSAGE_SIZE);
+							succeeded = false;
+							break;
+						}
+
+						output->Reserve(std::min<size_t>(output->GetCapacity() * 2, WEBSOCKET_DEFLATE_MAX_MESSAGE_SIZE));
+					}
+
+					auto offset = output->GetLength();
+					auto available = output->GetCapacity() - offset;
+
+					output->SetLength(output->GetCapacity());
+					decompressor.next_out = output->GetWritableDataAs<Bytef>() + offset;
+					decompressor.avail_out = static_cast<uInt>(available);
+
+					auto result = inflate(&decompressor, Z_SYNC_FLUSH);
+
+					output->SetLength(offset + available - decompressor.avail_out);
+
+					if ((result != Z_OK) && (result != Z_BUF_ERROR) && (result != Z_STREAM_END))
+					{
+						logte("Could not decompress the message: %d", result);
+						succeeded = false;
+						break;
+					}
+
+					if ((result == Z_STREAM_END) || ((result == Z_BUF_ERROR) && (decompressor.avail_out > 0)))
+					{
+						// The final block, or no progress is possible
+						break;
+					}
+					// Continue if the output is full since inflate() may have more output pending
+				} while ((decompressor.avail_in > 0) || (decompressor.avail_out == 0));
+
+				inflateEnd(&decompressor);
+
+				return succeeded ? output : nullptr;
+			}
+		}  // namespace ws
+	}  // namespace prot
+}  // namespace http
@@ -0,0 +1,69 @@
+//==============================================================================
+//
+//  OvenMediaEngine
+//
+//  Created by Hyunjun Jang
+//  Copyright (c) 2022 AirenSoft. All rights reserved.
+//
+//==============================================================================
+#pragma once
+
+#include <base/ovlibrary/ovlibrary.h>
+#include <zlib.h>
+
+// Messages smaller than this are sent without compression (RSV1 = 0)
+#define WEBSOCKET_DEFLATE_MIN_PAYLOAD_SIZE 128
+// The window of the compressor is smaller than the default (15) to reduce the memory per connection.
+// A stream compressed with a smaller window can be decompressed with any larger window.
+#define WEBSOCKET_DEFLATE_WINDOW_BITS 11
+#define WEBSOCKET_DEFLATE_MEM_LEVEL 4
+// Same as the maximum frame size
+#define WEBSOCKET_DEFLATE_MAX_MESSAGE_SIZE (1024LL * 1024LL)
+
+namespace http
+{
+	namespace prot
+	{
+		namespace ws
+		{
+			// RFC7692 - Compression Extensions for WebSocket (permessage-deflate)
+			//
+			// - Server to client: the compressor keeps its sliding window across the messages (context takeover),
+			//   so repeated keys/values of the signalling messages are encoded as back-references of the previous messages.
+			// - Client to server: "client_no_context_takeover" is always requested, so each message is decompressed
+			//   with a temporary decompressor and no window is kept for the client (incoming messages are rare).
+			class PerMessageDeflate
+			{
+			public:
+				static constexpr const char *ExtensionName = "permessage-deflate";
+
+				// Parses the Sec-WebSocket-Extensions header of the request,
+				// and returns nullptr if there is no offer that can be accepted
+				static std::shared_ptr<PerMessageDeflate> Create(const ov::String &offers);
+
+				PerMessageDeflate(bool server_no_context_takeover, int server_max_window_bits, bool is_server_max_window_bits_offered);
+				~PerMessageDeflate();
+
+				// The value of the Sec-WebSocket-Extensions header of the response
+				ov::String GetResponseHeaderValue() const;
+
+				bool IsCompressible(const std::shared_ptr<const ov::Data> &payload) const;
+
+				// The messages MUST be compressed in the order they are sent
+				std::shared_ptr<ov::Data> Compress(const std::shared_ptr<const ov::Data> &payload);
+				std::shared_ptr<ov::Data> Decompress(const std::shared_ptr<const ov::Data> &payload) const;
+
+			private:
+				bool InitializeCompressor();
+
+				bool _server_no_context_takeover = false;
+				int _server_max_window_bits = WEBSOCKET_DEFLATE_WINDOW_BITS;
+				bool _is_server_max_window_bits_offered = false;
+
+				// Initialized when the first message is compressed
+				bool _is_compressor_initialized = false;
+				z_stream _compressor{};
+			};
+		}  // namespace ws
+	}  // namespace prot
+}  // namespace http
@@ -43,7 +43,8 @@ namespace http
 	{
 		namespace ws
 		{
-			Frame::Frame()
+			Frame::Frame(uint8_t reserved_mask)
+				: _reserved_mask(reserved_mask)
 			{
 				_previous_data = std::make_shared<ov::Data>(sizeof(_header) + sizeof(uint64_t) + sizeof(_frame_masking_key));
 			}
@@ -172,13 +173,11 @@ namespace http
 				if (ParseData(data, &_header, sizeof(_header), &consumed_bytes))
 				{
 					// Handle extensions flag
-					// TODO(dimiden) - Extensions are now considered unused (need to be implemented later)
-					bool extensions = false;
-
-					if ((extensions == false) && (_header.reserved != 0x00))
+					// The meaning of the RSV bits of the negotiated extensions is handled by the session
+					if ((_header.reserved & ~_reserved_mask) != 0x00)
 					{
 						consumed_bytes = -1;
-						logte("Invalid reserved value: %d (expected: %d)", _header.reserved, 0x00);
+						logte("Invalid reserved value: %d (allowed: %d)", _header.reserved, _reserved_mask);
 					}
 					else
 					{
@@ -34,6 +34,11 @@ namespace http
 				// *  %xB-F are reserved for further control frames
 			};
 
+			// Bits of FrameHeader::reserved
+			constexpr uint8_t FrameReservedRsv1 = 0x04;
+			constexpr uint8_t FrameReservedRsv2 = 0x02;
+			constexpr uint8_t FrameReservedRsv3 = 0x01;
+
 #pragma pack(push, 1)
 			// RFC6455 - 5.2. Base Framing Protocol
 			//  0                   1                   2                   3
@@ -120,7 +125,8 @@ namespace http
 			class Frame
 			{
 			public:
-				Frame();
+				// reserved_mask: RSV bits that are defined by the negotiated extensions (e.g. RSV1 for permessage-deflate)
+				explicit Frame(uint8_t reserved_mask = 0x00);
 
 				const std::shared_ptr<const ov::Data> GetPayload() const noexcept
 				{
@@ -151,6 +157,7 @@ namespace http
 
 				FrameHeader _header;
 				int _header_read_bytes = 0;
+				uint8_t _reserved_mask = 0x00;
 
 				uint64_t _remained_payload_length = 0UL;
 				uint64_t _payload_length = 0UL;
@@ -44,6 +44,25 @@ namespace http
 				return result;
 			}
 
+			bool Http1Response::SendChunkedFile(const std::shared_ptr<const ov::FileRange> &file_range)
+			{
+				if ((file_range == nullptr) || (file_range->GetLength() == 0))
+				{
+					// Send a empty chunk
+					return Send("0\r\n\r\n", 5);
+				}
+
+				bool result =
+					// Send the chunk header
+					Send(ov::String::FormatString("%x\r\n", file_range->GetLength()).ToData(false)) &&
+					// Send the chunk payload
+					SendFile(file_range) &&
+					// Send a last data of chunk
+					Send("\r\n", 2);
+
+				return result;
+			}
+
 			void Http1Response::SetChunkedTransfer()
 			{
 				SetHeader("Transfer-Encoding", "chunked");
@@ -106,23 +125,20 @@ namespace http
 				logtd("Trying to send datas...");
 
 				uint32_t sent_bytes = 0;
-				for (const auto &data : GetResponseDataList())
+				for (const auto &body : GetResponseDataList())
 				{
 					if (_chunked_transfer)
 					{
-						sent &= SendChunkedData(data);
-						if (sent == true)
-						{
-							sent_bytes += data->GetLength();
-						}
+						sent &= (body.file_range != nullptr) ? SendChunkedFile(body.file_range) : SendChunkedData(body.data);
 					}
 					else
 					{
-						sent &= Send(data);
-						if (sent == true)
-						{
-							sent_bytes += data->GetLength();
-						}
+						sent &= (body.file_range != nullptr) ? SendFile(body.file_range) : Send(body.data);
+					}
+
+					if (sent == true)
+					{
+						sent_bytes += body.GetLength();
 					}
 				}
 
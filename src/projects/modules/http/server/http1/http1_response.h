@@ -27,6 +27,7 @@ namespace http
 
 				bool SendChunkedData(const void *data, size_t length);
 				bool SendChunkedData(const std::shared_ptr<const ov::Data> &data);
+				bool SendChunkedFile(const std::shared_ptr<const ov::FileRange> &file_range);
 				bool IsChunkedTransfer() const;
 
 			private:
@@ -7,6 +7,8 @@
 //
 //==============================================================================
 #include "http2_response.h"
+
+#include "../../hpack/pre_encoded_headers.h"
 #include "../../http_private.h"
 
 namespace http
@@ -50,17 +52,38 @@ namespace http
 				std::shared_ptr<ov::Data> header_block = std::make_shared<ov::Data>(65535);
 				size_t sent_size = 0;
 
+				auto pre_encoded_headers = hpack::PreEncodedHeaders::GetInstance();
+
+				// A pending Dynamic Table Size Update must precede all the header fields including the pre-encoded ones
+				auto table_size_update = _hpack_encoder->EncodePendingTableSizeUpdate();
+				if (table_size_update != nullptr)
+				{
+					header_block->Append(table_size_update);
+				}
+
 				// :status header field is must on top
-				auto header_field = _hpack_encoder->Encode({":status", ov::Converter::ToString(static_cast<uint16_t>(GetStatusCode()))}, hpack::Encoder::EncodingType::LiteralWithIndexing);
+				auto status_code = ov::Converter::ToString(static_cast<uint16_t>(GetStatusCode()));
+				auto header_field = pre_encoded_headers->Get(":status", status_code);
+				if (header_field == nullptr)
+				{
+					header_field = _hpack_encoder->Encode({":status", status_code}, hpack::Encoder::EncodingType::LiteralWithIndexing);
+				}
 				header_block->Append(header_field);
 
 				for (const auto &[name, values] : GetResponseHeaderList())
 				{
+					// https://httpwg.org/http2-spec/draft-ietf-httpbis-http2bis.html#section-8.2
+					// Field names MUST be converted to lowercase when constructing an HTTP/2 message.
+					auto lower_name = name.LowerCaseString();
+
 					for (const auto &value : values)
 					{
-						// https://httpwg.org/http2-spec/draft-ietf-httpbis-http2bis.html#section-8.2
-						// Field names MUST be converted to lowercase when constructing an HTTP/2 message.
-						auto header_field = _hpack_encoder->Encode({name.LowerCaseString(), value}, hpack::Encoder::EncodingType::LiteralWithIndexing);
+						// Well-known header fields are encoded once and shared by all responses
+						auto header_field = pre_encoded_headers->Get(lower_name, value);
+						if (header_field == nullptr)
+						{
+							header_field = _hpack_encoder->Encode({lower_name, value}, hpack::Encoder::EncodingType::LiteralWithIndexing);
+						}
 						header_block->Append(header_field);
 					}
 				}
@@ -142,8 +165,17 @@ namespace http
 
 				uint32_t sent_bytes = 0;
 
-				for (const auto &data : GetResponseDataList())
+				for (const auto &body : GetResponseDataList())
 				{
+					// DATA frames are framed in the user space, so a file range is read into memory here
+					auto data = body.GetData();
+					if (data == nullptr)
+					{
+						logte("Failed to read payload");
+						ResetResponseData();
+						return -1;
+					}
+
 					size_t offset = 0;
 					auto data_fragment = data;
 					while (offset + MAX_HTTP2_DATA_SIZE < data->GetLength())
@@ -169,7 +201,7 @@ namespace http
 					payload_frame->SetData(data_fragment);
 
 					// End Stream
-					if (_keep_stream == false && (&data == &GetResponseDataList().back()))
+					if (_keep_stream == false && (&body == &GetResponseDataList().back()))
 					{
 						payload_frame->SetEndStream();
 					}
@@ -1,4 +1,5 @@
 #include <base/ovcrypto/openssl/tls_server_data.h>
+#include <base/ovsocket/socket_pool/socket_pool_worker.h>
 
 #include "http_server.h"
 #include "http_connection.h"
@@ -59,14 +60,55 @@ namespace http
 		ov::String HttpConnection::ToString() const
 		{
 			// Print connection type, client address, client port, use of tls
-			return ov::String::FormatString("HttpConnection(%p) : %s %s TLS(%s)",
+			auto description = ov::String::FormatString("HttpConnection(%p) : %s %s TLS(%s)",
 				this,
 				StringFromConnectionType(_connection_type).CStr(),
 				_client_socket->ToString().CStr(),
 				_tls_data ? "Enabled" : "Disabled");
+
+			if (_tls_data != nullptr)
+			{
+				// Offload state and the bytes encrypted by the kernel/OpenSSL
+				description.AppendFormat(" kTLS(%s, kernel: %" PRIu64 " bytes, user: %" PRIu64 " bytes)",
+					ov::TlsServerData::StringFromKtlsState(_tls_data->GetKtlsState()),
+					_tls_data->GetKtlsSentBytes(),
+					_tls_data->GetEncryptedBytes());
+			}
+
+			return description;
 		}
 		
-		// Called every 5 seconds
+		void HttpConnection::StartRepeatTask()
+		{
+			std::lock_guard<std::recursive_mutex> lock(_close_mutex);
+			if ((_closed == true) || (_repeat_timer != nullptr))
+			{
+				return;
+			}
+
+			_timer_worker = _client_socket->GetSocketPoolWorker();
+			if (_timer_worker == nullptr)
+			{
+				return;
+			}
+
+			std::weak_ptr<HttpConnection> weak_connection = GetSharedPtr();
+
+			_repeat_timer = _timer_worker->GetTimingWheel().Schedule(
+				[weak_connection]() -> ov::DelayQueueAction {
+					auto connection = weak_connection.lock();
+
+					if ((connection != nullptr) && connection->OnRepeatTask())
+					{
+						return ov::DelayQueueAction::Repeat;
+					}
+
+					return ov::DelayQueueAction::Stop;
+				},
+				HTTP_CONNECTION_REPEAT_TASK_INTERVAL_MS);
+		}
+
+		// Called every HTTP_CONNECTION_REPEAT_TASK_INTERVAL_MS
 		bool HttpConnection::OnRepeatTask()
 		{
 			if (_connection_type == ConnectionType::WebSocket)
@@ -79,7 +121,7 @@ namespace http
 
 			CheckTimeout();
 
-			return true;
+			return (_closed == false);
 		}
 
 		void HttpConnection::CheckTimeout()
@@ -144,8 +186,8 @@ namespace http
 
 		void HttpConnection::OnTlsAccepted()
 		{
-			logti("TLS connection accepted : Server Name(%s) Alpn Protocol(%s) Client (%s)", 
-					_tls_data->GetServerName().CStr(), _tls_data->GetSelectedAlpnProtocolStr().CStr(), _client_socket->ToString().CStr());
+			logti("TLS connection accepted : Server Name(%s) Alpn Protocol(%s) kTLS(%s) Client (%s)", 
+					_tls_data->GetServerName().CStr(), _tls_data->GetSelectedAlpnProtocolStr().CStr(), ov::TlsServerData::StringFromKtlsState(_tls_data->GetKtlsState()), _client_socket->ToString().CStr());
 
 			if (_tls_data->GetSelectedAlpnProtocol() == ov::TlsServerData::AlpnProtocol::Http20)
 			{
@@ -174,6 +216,11 @@ namespace http
 			return _interceptor;
 		}
 
+		std::shared_ptr<HttpServer> HttpConnection::GetServer() const
+		{
+			return _server;
+		}
+
 		std::shared_ptr<ov::TlsServerData> HttpConnection::GetTlsData() const
 		{
 			return _tls_data;
@@ -252,6 +299,8 @@ namespace http
 
 			if (_websocket_session != nullptr)
 			{
+				// Send the messages that are still in the write buffer (e.g. an error message before closing)
+				_websocket_session->GetWebSocketResponse()->Flush();
 				_websocket_session.reset();
 			}
 			
@@ -266,6 +315,13 @@ namespace http
 
 			_user_data_map.clear();
 
+			if (_repeat_timer != nullptr)
+			{
+				_timer_worker->GetTimingWheel().Cancel(_repeat_timer);
+				_repeat_timer = nullptr;
+				_timer_worker = nullptr;
+			}
+
 			_closed = true;
 		}
 
@@ -379,7 +435,7 @@ namespace http
 
 			if (_websocket_frame == nullptr)
 			{
-				_websocket_frame = std::make_shared<prot::ws::Frame>();
+				_websocket_frame = std::make_shared<prot::ws::Frame>(_websocket_session->GetReservedMask());
 			}
 		
 			ssize_t read_bytes = 0;
@@ -22,6 +22,7 @@
 //TODO(Getroot) : Move to Server.xml
 #define HTTP_CONNECTION_TIMEOUT_MS		10 * 1000
 #define WEBSOCKET_CONNECTION_TIMEOUT_MS	WEBSOCKET_PING_INTERVAL_MS * 3
+#define HTTP_CONNECTION_REPEAT_TASK_INTERVAL_MS	5 * 1000
 
 namespace http
 {
@@ -40,11 +41,14 @@ namespace http
 
 			void OnExchangeCompleted(const std::shared_ptr<HttpExchange> &exchange);
 
+			// Schedules OnRepeatTask() on the timing wheel of the socket pool worker that owns the socket
+			void StartRepeatTask();
 			bool OnRepeatTask();
 
 			void SetTlsData(const std::shared_ptr<ov::TlsServerData> &tls_data);
 			void OnTlsAccepted();
 
+			std::shared_ptr<HttpServer> GetServer() const;
 			std::shared_ptr<ov::TlsServerData> GetTlsData() const;
 			std::shared_ptr<ov::ClientSocket> GetSocket() const;
 			ConnectionType GetConnectionType() const;
@@ -132,6 +136,10 @@ namespace http
 
 			std::shared_ptr<RequestInterceptor> _interceptor = nullptr;
 
+			// Timer for OnRepeatTask()
+			std::shared_ptr<ov::SocketPoolWorker> _timer_worker = nullptr;
+			ov::TimingWheel::TimerHandle _repeat_timer = nullptr;
+
 			std::recursive_mutex _close_mutex;
 			bool _closed = false;
 		};
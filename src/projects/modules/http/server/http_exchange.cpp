@@ -9,7 +9,9 @@
 #include "http_exchange.h"
 
 #include "../http_private.h"
+#include "../protocol/web_socket/web_socket_deflate.h"
 #include "http_connection.h"
+#include "http_server.h"
 
 namespace http
 {
@@ -27,6 +29,7 @@ namespace http
 			_connection = exchange->_connection;
 			_extra = exchange->_extra;
 			_keep_alive = exchange->_keep_alive;
+			_websocket_deflate = exchange->_websocket_deflate;
 		}
 
 		HttpExchange::~HttpExchange()
@@ -185,6 +188,17 @@ namespace http
 
 			GetResponse()->SetHeader("Sec-WebSocket-Accept", base64);
 
+			// RFC7692 - 5. Extension Negotiation
+			if (GetConnection()->GetServer()->IsWebSocketCompressionEnabled())
+			{
+				_websocket_deflate = prot::ws::PerMessageDeflate::Create(GetRequest()->GetHeader("SEC-WEBSOCKET-EXTENSIONS"));
+
+				if (_websocket_deflate != nullptr)
+				{
+					GetResponse()->SetHeader("Sec-WebSocket-Extensions", _websocket_deflate->GetResponseHeaderValue());
+				}
+			}
+
 			// Send headers to client
 			if (GetResponse()->Response() <= 0)
 			{
@@ -194,6 +208,11 @@ namespace http
 			return true;
 		}
 
+		std::shared_ptr<prot::ws::PerMessageDeflate> HttpExchange::GetWebSocketDeflate() const
+		{
+			return _websocket_deflate;
+		}
+
 		// Get Connection Policy
 		bool HttpExchange::IsKeepAlive() const
 		{
@@ -15,6 +15,14 @@
 
 namespace http
 {
+	namespace prot
+	{
+		namespace ws
+		{
+			class PerMessageDeflate;
+		}  // namespace ws
+	}  // namespace prot
+
 	namespace svr
 	{
 		class HttpConnection;
@@ -85,6 +93,8 @@ namespace http
 
 		protected:
 			bool AcceptWebSocketUpgrade();
+			// Returns the permessage-deflate extension negotiated by AcceptWebSocketUpgrade(), nullptr if not negotiated
+			std::shared_ptr<prot::ws::PerMessageDeflate> GetWebSocketDeflate() const;
 			void SetConnectionPolicyByRequest();
 			void SetStatus(Status status);
 			void SetKeepAlive(bool keep_alive);
@@ -98,6 +108,7 @@ namespace http
 			Status _status = Status::None;
 			bool _keep_alive = true; // HTTP/1.1 default
 			std::any _extra;
+			std::shared_ptr<prot::ws::PerMessageDeflate> _websocket_deflate;
 		};
 	}  // namespace svr
 }  // namespace http
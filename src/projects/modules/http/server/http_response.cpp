@@ -157,12 +157,27 @@ namespace http
 
 			auto cloned_data = data->Clone();
 
-			_response_data_list.push_back(cloned_data);
+			_response_data_list.push_back({cloned_data, nullptr});
 			_response_data_size += cloned_data->GetLength();
 
 			return true;
 		}
 
+		bool HttpResponse::AppendSharedData(const std::shared_ptr<const ov::Data> &data)
+		{
+			if (data == nullptr)
+			{
+				return false;
+			}
+
+			std::lock_guard<decltype(_response_mutex)> lock(_response_mutex);
+
+			_response_data_list.push_back({data, nullptr});
+			_response_data_size += data->GetLength();
+
+			return true;
+		}
+
 		bool HttpResponse::AppendString(const ov::String &string)
 		{
 			return AppendData(string.ToData(false));
@@ -170,8 +185,30 @@ namespace http
 
 		bool HttpResponse::AppendFile(const ov::String &filename)
 		{
-			OV_ASSERT(false, "Not implemented");
-			return false;
+			auto file_range = ov::FileRange::Open(filename);
+
+			if (file_range == nullptr)
+			{
+				logte("Could not open file: %s", filename.CStr());
+				return false;
+			}
+
+			return AppendFileRange(file_range);
+		}
+
+		bool HttpResponse::AppendFileRange(const std::shared_ptr<const ov::FileRange> &file_range)
+		{
+			if (file_range == nullptr)
+			{
+				return false;
+			}
+
+			std::lock_guard<decltype(_response_mutex)> lock(_response_mutex);
+
+			_response_data_list.push_back({nullptr, file_range});
+			_response_data_size += file_range->GetLength();
+
+			return true;
 		}
 
 		bool HttpResponse::IsHeaderSent() const
@@ -186,7 +223,7 @@ namespace http
 		}
 
 		// Get Response Data List
-		const std::vector<std::shared_ptr<const ov::Data>> &HttpResponse::GetResponseDataList() const
+		const std::vector<HttpResponse::ResponseBody> &HttpResponse::GetResponseDataList() const
 		{
 			return _response_data_list;
 		}
@@ -303,6 +340,37 @@ namespace http
 			return _client_socket->Send(send_data);
 		}
 
+		bool HttpResponse::SendFile(const std::shared_ptr<const ov::FileRange> &file_range)
+		{
+			if (file_range == nullptr)
+			{
+				OV_ASSERT2(file_range != nullptr);
+				return false;
+			}
+
+			if (_tls_data == nullptr)
+			{
+				return _client_socket->SendFile(file_range);
+			}
+
+			if (_tls_data->IsKtlsOffloaded())
+			{
+				// The kernel encrypts the file data as it is sent
+				_tls_data->AddKtlsSentBytes(file_range->GetLength());
+				return _client_socket->SendFile(file_range);
+			}
+
+			// Without kTLS, the TLS record must be encrypted in the user space
+			auto data = file_range->Read();
+			if (data == nullptr)
+			{
+				logte("Could not read file: %s, %s", file_range->ToString().CStr(), _client_socket->ToString().CStr());
+				return false;
+			}
+
+			return Send(data);
+		}
+
 		bool HttpResponse::Close()
 		{
 			OV_ASSERT2(_client_socket != nullptr);
@@ -49,8 +49,12 @@ namespace http
 			// Enqueue the data into the queue (This data will be sent when SendResponse() is called)
 			// Can be used for response with content-length
 			bool AppendData(const std::shared_ptr<const ov::Data> &data);
+			// Enqueue the data without copying it, so the data must not be modified after this (e.g. a segment shared by the connections)
+			bool AppendSharedData(const std::shared_ptr<const ov::Data> &data);
 			bool AppendString(const ov::String &string);
 			bool AppendFile(const ov::String &filename);
+			// The range is sent with sendfile() if possible, without copying it into the user space
+			bool AppendFileRange(const std::shared_ptr<const ov::FileRange> &file_range);
 
 			uint32_t Response();
 
@@ -65,13 +69,31 @@ namespace http
 
 			virtual ov::String ToString() const;
 
-			bool Close();
+			virtual bool Close();
 
 		protected:
+			// A part of the response body, either in-memory data or a range of a file
+			struct ResponseBody
+			{
+				std::shared_ptr<const ov::Data> data;
+				std::shared_ptr<const ov::FileRange> file_range;
+
+				size_t GetLength() const
+				{
+					return (file_range != nullptr) ? file_range->GetLength() : data->GetLength();
+				}
+
+				// Reads the file range into memory if needed
+				std::shared_ptr<const ov::Data> GetData() const
+				{
+					return (file_range != nullptr) ? file_range->Read() : data;
+				}
+			};
+
 			bool IsHeaderSent() const;
 			
 			// Get Response Data List
-			const std::vector<std::shared_ptr<const ov::Data>> &GetResponseDataList() const;
+			const std::vector<ResponseBody> &GetResponseDataList() const;
 			// Get Response Header
 			const std::unordered_map<ov::String, std::vector<ov::String>, ov::CaseInsensitiveHash, ov::CaseInsensitiveEqual> &GetResponseHeaderList() const;
 			void ResetResponseData();
@@ -84,6 +106,8 @@ namespace http
 			}
 			virtual bool Send(const void *data, size_t length);
 			virtual bool Send(const std::shared_ptr<const ov::Data> &data);
+			// Uses sendfile() for plain connections, and falls back to Send() for TLS connections
+			virtual bool SendFile(const std::shared_ptr<const ov::FileRange> &file_range);
 			
 		private:
 			virtual uint32_t SendHeader();
@@ -113,7 +137,7 @@ namespace http
 
 			// So _response_header is a map of case insentitive header key and value
 			std::unordered_map<ov::String, std::vector<ov::String>, ov::CaseInsensitiveHash, ov::CaseInsensitiveEqual> _response_header;
-			std::vector<std::shared_ptr<const ov::Data>> _response_data_list;
+			std::vector<ResponseBody> _response_data_list;
 			size_t _response_data_size = 0;
 
 			std::vector<ov::String> _default_value{};
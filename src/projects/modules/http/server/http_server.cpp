@@ -17,8 +17,6 @@ namespace http
 {
 	namespace svr
 	{
-		ov::DelayQueue HttpServer::_repeater{"HTTPTimer"};
-
 		HttpServer::HttpServer(const char *server_name, const char *server_short_name)
 			: _server_name(server_name),
 			  _server_short_name(server_short_name)
@@ -53,9 +51,6 @@ namespace http
 				{
 					_physical_port = physical_port;
 
-					_repeater.Push(std::bind(&HttpServer::Repeater, this, std::placeholders::_1), 5 * 1000);
-					_repeater.Start();
-
 					return true;
 				}
 			}
@@ -99,25 +94,9 @@ namespace http
 
 			_interceptor_list.clear();
 
-			_repeater.Stop();
-
 			return true;
 		}
 
-		ov::DelayQueueAction HttpServer::Repeater(void *parameter)
-		{
-			std::shared_lock<std::shared_mutex> guard(_client_list_mutex);
-			auto client_list = _connection_list;
-			guard.unlock();
-
-			for (const auto &item : client_list)
-			{
-				item.second->OnRepeatTask();
-			}
-
-			return ov::DelayQueueAction::Repeat;
-		}
-
 		bool HttpServer::IsRunning() const
 		{
 			auto lock_guard = std::lock_guard(_physical_port_mutex);
@@ -130,6 +109,16 @@ namespace http
 			return _http2_enabled;
 		}
 
+		void HttpServer::SetWebSocketCompressionEnabled(bool enabled)
+		{
+			_websocket_compression_enabled = enabled;
+		}
+
+		bool HttpServer::IsWebSocketCompressionEnabled() const
+		{
+			return _websocket_compression_enabled;
+		}
+
 		std::shared_ptr<HttpConnection> HttpServer::FindClient(const std::shared_ptr<ov::Socket> &remote)
 		{
 			std::shared_lock<std::shared_mutex> guard(_client_list_mutex);
@@ -160,6 +149,8 @@ namespace http
 			auto http_connection = std::make_shared<HttpConnection>(GetSharedPtr(), client_socket);
 			_connection_list[remote.get()] = http_connection;
 
+			http_connection->StartRepeatTask();
+
 			return http_connection;
 		}
 
@@ -51,6 +51,10 @@ namespace http
 			bool IsRunning() const;
 			bool IsHttp2Enabled() const;
 
+			// Accepts permessage-deflate (RFC7692) if the WebSocket client offers it (disabled by default)
+			void SetWebSocketCompressionEnabled(bool enabled);
+			bool IsWebSocketCompressionEnabled() const;
+
 			bool AddInterceptor(const std::shared_ptr<RequestInterceptor> &interceptor);
 			std::shared_ptr<RequestInterceptor> FindInterceptor(const std::shared_ptr<HttpExchange> &exchange);
 			bool RemoveInterceptor(const std::shared_ptr<RequestInterceptor> &interceptor);
@@ -91,11 +95,8 @@ namespace http
 			std::vector<std::shared_ptr<ocst::VirtualHost>> _virtual_host_list;
 
 		private:
-			ov::DelayQueueAction Repeater(void *parameter);
-
-			static ov::DelayQueue _repeater;
-
 			bool _http2_enabled = true;
+			bool _websocket_compression_enabled = false;
 		};
 
 	}  // namespace svr
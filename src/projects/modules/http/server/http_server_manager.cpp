@@ -154,6 +154,7 @@ namespace http
 			{
 				// Create a new HTTP server
 				https_server = std::make_shared<HttpsServer>(server_name, server_short_name);
+				https_server->SetKtlsEnabled(module_config.GetKtls().IsEnabled());
 
 				if (https_server->Start(address, worker_count, http2_enabled))
 				{
@@ -20,6 +20,8 @@
 #define HTTP_BACKWARD_COMPATIBILITY "ECDHE-ECDSA-CHACHA20-POLY1305:ECDHE-RSA-CHACHA20-POLY1305:ECDHE-RSA-AES128-GCM-SHA256:ECDHE-ECDSA-AES128-GCM-SHA256:ECDHE-RSA-AES256-GCM-SHA384:ECDHE-ECDSA-AES256-GCM-SHA384:DHE-RSA-AES128-GCM-SHA256:DHE-DSS-AES128-GCM-SHA256:kEDH+AESGCM:ECDHE-RSA-AES128-SHA256:ECDHE-ECDSA-AES128-SHA256:ECDHE-RSA-AES128-SHA:ECDHE-ECDSA-AES128-SHA:ECDHE-RSA-AES256-SHA384:ECDHE-ECDSA-AES256-SHA384:ECDHE-RSA-AES256-SHA:ECDHE-ECDSA-AES256-SHA:DHE-RSA-AES128-SHA256:DHE-RSA-AES128-SHA:DHE-DSS-AES128-SHA256:DHE-RSA-AES256-SHA256:DHE-DSS-AES256-SHA:DHE-RSA-AES256-SHA:ECDHE-RSA-DES-CBC3-SHA:ECDHE-ECDSA-DES-CBC3-SHA:EDH-RSA-DES-CBC3-SHA:AES128-GCM-SHA256:AES256-GCM-SHA384:AES128-SHA256:AES256-SHA256:AES128-SHA:AES256-SHA:AES:DES-CBC3-SHA:HIGH:SEED:!aNULL:!eNULL:!EXPORT:!DES:!RC4:!MD5:!PSK:!RSAPSK:!aDH:!aECDH:!EDH-DSS-DES-CBC3-SHA:!KRB5-DES-CBC3-SHA:!SRP"
 // Fastest suite only, which is still considered `secure`.
 #define HTTP_FAST_NOT_VERY_SECURE "AES128-SHA"
+// AES-GCM suites that the kernel can encrypt (TLS 1.2), and the fastest suite for the clients that don't support them
+#define HTTP_KTLS_COMPATIBLE "ECDHE-ECDSA-AES128-GCM-SHA256:ECDHE-RSA-AES128-GCM-SHA256:ECDHE-ECDSA-AES256-GCM-SHA384:ECDHE-RSA-AES256-GCM-SHA384:AES128-GCM-SHA256:AES256-GCM-SHA384:" HTTP_FAST_NOT_VERY_SECURE
 
 namespace http
 {
@@ -40,7 +42,7 @@ namespace http
 			std::shared_ptr<const ov::Error> error;
 			auto tls_context = ov::TlsContext::CreateServerContext(
 				ov::TlsMethod::Tls, certificate->GetCertificatePair(),
-				HTTP_FAST_NOT_VERY_SECURE, IsHttp2Enabled(), &tls_context_callback,
+				_ktls_enabled ? HTTP_KTLS_COMPATIBLE : HTTP_FAST_NOT_VERY_SECURE, IsHttp2Enabled(), &tls_context_callback,
 				&error);
 
 			if (tls_context == nullptr)
@@ -117,6 +119,11 @@ namespace http
 				return remote->Send(data, length) ? length : -1L;
 			});
 
+			if (_ktls_enabled)
+			{
+				tls_data->PrepareKtls();
+			}
+
 			client->SetTlsData(tls_data);
 		}
 
@@ -142,6 +149,9 @@ namespace http
 					if (prev_tls_state == ov::TlsServerData::State::WaitingForAccept && 
 						tls_data->GetState() == ov::TlsServerData::State::Accepted)
 					{
+						// The response must not be sent before the kernel takes over the encryption
+						OffloadToKernel(remote, tls_data);
+
 						// The client has accepted the connection
 						connection->OnTlsAccepted();
 					}
@@ -169,6 +179,35 @@ namespace http
 			}
 		}
 
+		void HttpsServer::OffloadToKernel(const std::shared_ptr<ov::Socket> &remote, const std::shared_ptr<ov::TlsServerData> &tls_data)
+		{
+			if (_ktls_enabled == false)
+			{
+				return;
+			}
+
+			auto ktls_state = tls_data->OffloadToKernel([remote](const ov::KtlsTxInfo &info, ov::String *reason) -> bool {
+				auto error = remote->EnableKernelTlsTx(&info.crypto_info, info.length);
+
+				if (error != nullptr)
+				{
+					*reason = error->What();
+					return false;
+				}
+
+				return true;
+			});
+
+			if (ktls_state == ov::TlsServerData::KtlsState::Offloaded)
+			{
+				logtd("kTLS is enabled: %s", remote->ToString().CStr());
+			}
+			else
+			{
+				logtd("kTLS is not available, records will be encrypted by OpenSSL: %s (%s)", tls_data->GetKtlsFallbackReason().CStr(), remote->ToString().CStr());
+			}
+		}
+
 		bool HttpsServer::HandleSniCallback(ov::TlsContext *tls_context, SSL *ssl, const ov::String &server_name)
 		{
 			std::shared_ptr<HttpsCertificate> https_certificate;
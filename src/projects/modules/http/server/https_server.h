@@ -27,6 +27,17 @@ namespace http
 			std::shared_ptr<const ov::Error> AppendCertificate(const std::shared_ptr<const info::Certificate> &certificate);
 			std::shared_ptr<const ov::Error> RemoveCertificate(const std::shared_ptr<const info::Certificate> &certificate);
 
+			// Must be called before appending certificates
+			void SetKtlsEnabled(bool enabled)
+			{
+				_ktls_enabled = enabled;
+			}
+
+			bool IsKtlsEnabled() const
+			{
+				return _ktls_enabled;
+			}
+
 			// Deprecated
 			std::shared_ptr<const ov::Error> AppendCertificateList(const std::vector<std::shared_ptr<const info::Certificate>> &certificate_list);
 
@@ -54,11 +65,15 @@ namespace http
 		protected:
 			bool HandleSniCallback(ov::TlsContext *tls_context, SSL *ssl, const ov::String &server_name);
 
+			void OffloadToKernel(const std::shared_ptr<ov::Socket> &remote, const std::shared_ptr<ov::TlsServerData> &tls_data);
+
 		protected:
 			std::mutex _https_certificate_map_mutex;
 
 			// Certificate Name : HttpsCertificate
 			std::map<ov::String, std::shared_ptr<HttpsCertificate>> _https_certificate_map;
+
+			bool _ktls_enabled = false;
 		};
 	}  // namespace svr
 }  // namespace http
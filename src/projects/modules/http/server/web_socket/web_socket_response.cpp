@@ -20,6 +20,19 @@ namespace http
 	{
 		namespace ws
 		{
+			// The timing wheel is shared by all WebSocket connections, and is never released
+			// since the flush timers may be scheduled until the process exits
+			static ov::TimingWheel *GetFlushTimingWheel()
+			{
+				static auto timing_wheel = []() {
+					auto timing_wheel = new ov::TimingWheel("WSFlush", WEBSOCKET_FLUSH_INTERVAL_MS);
+					timing_wheel->Start();
+					return timing_wheel;
+				}();
+
+				return timing_wheel;
+			}
+
 			WebSocketResponse::WebSocketResponse(const std::shared_ptr<HttpResponse> &http_respose)
 				: HttpResponse(http_respose)
 			{
@@ -29,21 +42,27 @@ namespace http
 			{
 			}
 
-			ssize_t WebSocketResponse::Send(const std::shared_ptr<const ov::Data> &data, prot::ws::FrameOpcode opcode)
+			void WebSocketResponse::SetPerMessageDeflate(const std::shared_ptr<prot::ws::PerMessageDeflate> &deflate)
+			{
+				_deflate = deflate;
+			}
+
+			void WebSocketResponse::AppendFrame(const std::shared_ptr<const ov::Data> &payload, prot::ws::FrameOpcode opcode, uint8_t reserved)
 			{
 				// RFC6455 - 5.2.  Base Framing Protocol
 				//
 				//
 				prot::ws::FrameHeader header{
 					.opcode = static_cast<uint8_t>(opcode),
-					.reserved = 0x00,
+					.reserved = reserved,
 					.fin = true,
 					.payload_length = 0,
 					.mask = false};
 
-				size_t length = (data == nullptr) ? 0LL : data->GetLength();
+				size_t length = (payload == nullptr) ? 0LL : payload->GetLength();
+				size_t header_length = sizeof(header);
 
-				if (length < 0x7D)
+				if (length <= 0x7D)
 				{
 					// frame-payload-length    = ( %x00-7D )
 					//                         / ( %x7E frame-payload-length-16 )
@@ -52,40 +71,114 @@ namespace http
 					//                         ; respectively
 					header.payload_length = static_cast<uint8_t>(length);
 				}
-				else if (length < 0xFFFF)
+				else if (length <= 0xFFFF)
 				{
 					// frame-payload-length-16 = %x0000-FFFF ; 16 bits in length
 					header.payload_length = 126;
+					header_length += sizeof(uint16_t);
 				}
 				else
 				{
 					// frame-payload-length-63 = %x0000000000000000-7FFFFFFFFFFFFFFF
 					//                         ; 64 bits in length
 					header.payload_length = 127;
+					header_length += sizeof(uint64_t);
 				}
 
-				auto response_data = std::make_shared<ov::Data>(65535);
+				if (_write_buffer == nullptr)
+				{
+					_write_buffer = std::make_shared<ov::Data>(std::max<size_t>(header_length + length, 4096));
+				}
 
-				response_data->Append(&header, sizeof(header));
+				_write_buffer->Append(&header, sizeof(header));
 
 				if (header.payload_length == 126)
 				{
 					auto payload_length = ov::HostToNetwork16(static_cast<uint16_t>(length));
-					response_data->Append(&payload_length, sizeof(payload_length));
+					_write_buffer->Append(&payload_length, sizeof(payload_length));
 				}
 				else if (header.payload_length == 127)
 				{
 					auto payload_length = ov::HostToNetwork64(static_cast<uint64_t>(length));
-					response_data->Append(&payload_length, sizeof(payload_length));
+					_write_buffer->Append(&payload_length, sizeof(payload_length));
 				}
 
 				if (length > 0LL)
 				{
-					logtd("Trying to send data\n%s", data->Dump(32).CStr());
-					response_data->Append(data);
+					logtd("Trying to send data\n%s", payload->Dump(32).CStr());
+					_write_buffer->Append(payload);
+				}
+			}
+
+			void WebSocketResponse::ScheduleFlush()
+			{
+				std::weak_ptr<WebSocketResponse> response_weak = GetSharedPtrAs<WebSocketResponse>();
+
+				GetFlushTimingWheel()->Schedule(
+					[response_weak]() -> ov::DelayQueueAction {
+						auto response = response_weak.lock();
+
+						if (response != nullptr)
+						{
+							response->Flush();
+						}
+
+						return ov::DelayQueueAction::Stop;
+					},
+					WEBSOCKET_FLUSH_INTERVAL_MS);
+			}
+
+			ssize_t WebSocketResponse::Send(const std::shared_ptr<const ov::Data> &data, prot::ws::FrameOpcode opcode)
+			{
+				auto remote = GetRemote();
+
+				if ((remote == nullptr) || (remote->GetState() != ov::SocketState::Connected))
+				{
+					return -1LL;
+				}
+
+				size_t length = (data == nullptr) ? 0LL : data->GetLength();
+				bool need_to_flush = false;
+
+				{
+					std::lock_guard<std::mutex> lock_guard(_write_buffer_mutex);
+
+					// RFC7692 - 6.1. Compression: control frames are never compressed
+					if ((_deflate != nullptr) &&
+						((opcode == prot::ws::FrameOpcode::Text) || (opcode == prot::ws::FrameOpcode::Binary)) &&
+						_deflate->IsCompressible(data))
+					{
+						auto compressed = _deflate->Compress(data);
+
+						if (compressed == nullptr)
+						{
+							return -1LL;
+						}
+
+						AppendFrame(compressed, opcode, prot::ws::FrameReservedRsv1);
+					}
+					else
+					{
+						AppendFrame(data, opcode, 0x00);
+					}
+
+					if (_write_buffer->GetLength() >= WEBSOCKET_WRITE_BUFFER_FLUSH_SIZE)
+					{
+						need_to_flush = true;
+					}
+					else if (_is_flush_scheduled == false)
+					{
+						ScheduleFlush();
+						_is_flush_scheduled = true;
+					}
 				}
 
-				return HttpResponse::Send(response_data) ? length : -1LL;
+				if (need_to_flush && (Flush() == false))
+				{
+					return -1LL;
+				}
+
+				return length;
 			}
 
 			ssize_t WebSocketResponse::Send(const ov::String &string)
@@ -97,6 +190,35 @@ namespace http
 			{
 				return Send(ov::Json::Stringify(value));
 			}
+
+			bool WebSocketResponse::Flush()
+			{
+				std::lock_guard<std::mutex> flush_lock_guard(_flush_mutex);
+
+				std::shared_ptr<ov::Data> write_buffer;
+
+				{
+					std::lock_guard<std::mutex> lock_guard(_write_buffer_mutex);
+
+					// The timer that is already scheduled will find the empty buffer
+					_is_flush_scheduled = false;
+					write_buffer = std::move(_write_buffer);
+				}
+
+				if ((write_buffer == nullptr) || write_buffer->IsEmpty())
+				{
+					return true;
+				}
+
+				return HttpResponse::Send(write_buffer);
+			}
+
+			bool WebSocketResponse::Close()
+			{
+				Flush();
+
+				return HttpResponse::Close();
+			}
 		}  // namespace ws
 	}	   // namespace svr
 }  // namespace http
@@ -15,9 +15,15 @@
 
 #include "../http_response.h"
 #include "web_socket_datastructure.h"
+#include "../../protocol/web_socket/web_socket_deflate.h"
 #include "../../protocol/web_socket/web_socket_frame.h"
 #include <variant>
 
+// The frames are sent at most this long after Send() is called
+#define WEBSOCKET_FLUSH_INTERVAL_MS 1
+// If the write buffer is larger than this, it is sent immediately
+#define WEBSOCKET_WRITE_BUFFER_FLUSH_SIZE (64 * 1024)
+
 namespace http
 {
 	namespace svr
@@ -31,9 +37,33 @@ namespace http
 				WebSocketResponse(const std::shared_ptr<HttpResponse> &http_respose);
 				virtual ~WebSocketResponse();
 
+				void SetPerMessageDeflate(const std::shared_ptr<prot::ws::PerMessageDeflate> &deflate);
+
+				// The frame is appended to the write buffer of the connection, and the frames sent in the same tick
+				// are sent with one write (and one TLS record) by the flush timer.
+				// Returns the length of the payload, or -1 if the connection is not available.
 				ssize_t Send(const std::shared_ptr<const ov::Data> &data, prot::ws::FrameOpcode opcode);
 				ssize_t Send(const ov::String &string);
 				ssize_t Send(const Json::Value &value);
+
+				// Sends the frames in the write buffer immediately
+				bool Flush();
+
+				bool Close() override;
+
+			private:
+				void AppendFrame(const std::shared_ptr<const ov::Data> &payload, prot::ws::FrameOpcode opcode, uint8_t reserved);
+				void ScheduleFlush();
+
+				std::shared_ptr<prot::ws::PerMessageDeflate> _deflate;
+
+				// Guards the frames so that they are compressed and appended in the same order
+				std::mutex _write_buffer_mutex;
+				std::shared_ptr<ov::Data> _write_buffer;
+				bool _is_flush_scheduled = false;
+
+				// Serializes Flush() so that the write buffers are sent in the order they are taken
+				std::mutex _flush_mutex;
 			};
 		}  // namespace ws
 	} // namespace svr
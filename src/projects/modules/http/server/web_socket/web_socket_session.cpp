@@ -31,6 +31,9 @@ namespace http
 				_request->SetConnectionType(ConnectionType::WebSocket);
 
 				_ws_response = std::make_shared<WebSocketResponse>(exchange->GetResponse());
+
+				_deflate = GetWebSocketDeflate();
+				_ws_response->SetPerMessageDeflate(_deflate);
 			}
 
 			void WebSocketSession::AddUserData(ov::String key, std::variant<bool, uint64_t, ov::String> value)
@@ -76,6 +79,11 @@ namespace http
 				return _ws_response;
 			}
 
+			uint8_t WebSocketSession::GetReservedMask() const
+			{
+				return (_deflate != nullptr) ? FrameReservedRsv1 : 0x00;
+			}
+
 			// Implement HttpExchange
 			std::shared_ptr<HttpRequest> WebSocketSession::GetRequest() const
 			{
@@ -107,7 +115,30 @@ namespace http
 					SetStatus(Status::Error);
 					return false;
 				}
-				const std::shared_ptr<const ov::Data> payload = frame->GetPayload();
+				std::shared_ptr<const ov::Data> payload = frame->GetPayload();
+				const auto &header = frame->GetHeader();
+
+				if (header.reserved & FrameReservedRsv1)
+				{
+					// RFC7692 - 6.1. Compression: RSV1 is set only on the first frame of a compressed data message.
+					// Since the frames are not reassembled, a fragmented compressed message cannot be decompressed.
+					auto opcode = static_cast<FrameOpcode>(header.opcode);
+
+					if (((opcode != FrameOpcode::Text) && (opcode != FrameOpcode::Binary)) || (header.fin == false))
+					{
+						logte("Unsupported compressed frame: %s", frame->ToString().CStr());
+						SetStatus(Status::Error);
+						return false;
+					}
+
+					payload = _deflate->Decompress(payload);
+
+					if (payload == nullptr)
+					{
+						SetStatus(Status::Error);
+						return false;
+					}
+				}
 
 				switch (static_cast<FrameOpcode>(frame->GetHeader().opcode))
 				{
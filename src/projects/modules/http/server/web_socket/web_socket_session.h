@@ -40,6 +40,9 @@ namespace http
 				bool OnFrameReceived(const std::shared_ptr<const prot::ws::Frame> &frame);
 
 				std::shared_ptr<WebSocketResponse> GetWebSocketResponse() const;
+
+				// RSV bits of the frames allowed by the negotiated extensions
+				uint8_t GetReservedMask() const;
 								
 				// Implement HttpExchange
 				std::shared_ptr<HttpRequest> GetRequest() const override;
@@ -58,6 +61,9 @@ namespace http
 
 				std::shared_ptr<HttpRequest> _request;
 				std::shared_ptr<WebSocketResponse> _ws_response;
+
+				// permessage-deflate, nullptr if not negotiated
+				std::shared_ptr<prot::ws::PerMessageDeflate> _deflate;
 			};
 		}  // namespace ws
 	} // namespace svr
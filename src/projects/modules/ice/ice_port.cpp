@@ -25,8 +25,8 @@
 
 IcePort::IcePort()
 {
-	_timer.Push(
-		[this](void *paramter) -> ov::DelayQueueAction {
+	_timer.Schedule(
+		[this]() -> ov::DelayQueueAction {
 			CheckTimedoutItem();
 			return ov::DelayQueueAction::Repeat;
 		},
@@ -245,7 +245,7 @@ ov::String IcePort::GenerateUfrag()
 	{
 		ov::String ufrag = ov::Random::GenerateString(6);
 
-		if (_user_port_table.find(ufrag) == _user_port_table.end())
+		if (_user_port_table.Contains(ufrag) == false)
 		{
 			logtd("Generated ufrag: %s", ufrag.CStr());
 
@@ -256,29 +256,24 @@ ov::String IcePort::GenerateUfrag()
 
 std::shared_ptr<IcePort::IcePortInfo> IcePort::FindIcePortInfo(uint32_t session_id)
 {
+	std::shared_ptr<IcePortInfo> ice_port_info;
+
+	if (_session_port_table.Find(session_id, &ice_port_info))
 	{
-		std::lock_guard<std::mutex> lock_guard(_port_table_lock);
-		auto item = _session_port_table.find(session_id);
-		if (item != _session_port_table.end())
-		{
-			return item->second;
-		}
+		return ice_port_info;
 	}
 
-	{
-		std::lock_guard<std::mutex> lock_guard(_user_port_table_lock);
-		for (auto &item : _user_port_table)
+	_user_port_table.Iterate([&](const ov::String &ufrag, const std::shared_ptr<IcePortInfo> &info) -> bool {
+		if (info->session_id == session_id)
 		{
-			auto ice_port_info = item.second;
-
-			if (ice_port_info->session_id == session_id)
-			{
-				return ice_port_info;
-			}
+			ice_port_info = info;
+			return false;
 		}
-	}
 
-	return nullptr;
+		return true;
+	});
+
+	return ice_port_info;
 }
 
 void IcePort::AddSession(const std::shared_ptr<IcePortObserver> &observer, uint32_t session_id,
@@ -288,18 +283,20 @@ void IcePort::AddSession(const std::shared_ptr<IcePortObserver> &observer, uint3
 	const ov::String &local_ufrag = local_sdp->GetIceUfrag();
 	const ov::String &remote_ufrag = peer_sdp->GetIceUfrag();
 
+	std::shared_ptr<IcePortInfo> info;
+
 	{
 		std::lock_guard<std::mutex> lock_guard(_user_port_table_lock);
 
-		auto item = _user_port_table.find(local_ufrag);
-		if (item != _user_port_table.end())
+		std::shared_ptr<IcePortInfo> old_info;
+		if (_user_port_table.Find(local_ufrag, &old_info))
 		{
-			OV_ASSERT(false, "Duplicated ufrag: %s:%s, session_id: %d (old session_id: %d)", local_ufrag.CStr(), remote_ufrag.CStr(), session_id, item->second->session_id);
+			OV_ASSERT(false, "Duplicated ufrag: %s:%s, session_id: %d (old session_id: %d)", local_ufrag.CStr(), remote_ufrag.CStr(), session_id, old_info->session_id);
 		}
 
 		logtd("Trying to add session: %d (ufrag: %s:%s)...", session_id, local_ufrag.CStr(), remote_ufrag.CStr());
 
-		std::shared_ptr<IcePortInfo> info = std::make_shared<IcePortInfo>(expired_ms, life_time_epoch_ms);
+		info = std::make_shared<IcePortInfo>(expired_ms, life_time_epoch_ms);
 
 		info->observer = observer;
 		info->user_data = user_data;
@@ -312,12 +309,27 @@ void IcePort::AddSession(const std::shared_ptr<IcePortObserver> &observer, uint3
 
 		info->UpdateBindingTime();
 
-		_user_port_table[local_ufrag] = info;
+		// Instead of sweeping all sessions periodically, each session checks itself when it may have expired
+		std::weak_ptr<IcePortInfo> weak_info = info;
+		info->expire_timer = _timer.Schedule(
+			[this, weak_info]() -> ov::DelayQueueAction {
+				auto ice_port_info = weak_info.lock();
+
+				if (ice_port_info != nullptr)
+				{
+					CheckSessionExpired(ice_port_info);
+				}
+
+				return ov::DelayQueueAction::Stop;
+			},
+			info->GetRemainingMsec());
+
+		_user_port_table.Set(local_ufrag, info);
 
 		logti("Added session: %d (ufrag: %s:%s)", session_id, local_ufrag.CStr(), remote_ufrag.CStr());
 	}
 
-	SetIceState(_user_port_table[local_ufrag], IcePortConnectionState::New);
+	SetIceState(info, IcePortConnectionState::New);
 }
 
 bool IcePort::TerminateSession(uint32_t session_id)
@@ -329,8 +341,9 @@ bool IcePort::TerminateSession(uint32_t session_id)
 		return false;
 	}
 
-	// It will be deleted in the next timer (for thread safety)
+	// It will be deleted in the timer thread (for thread safety)
 	ice_port_info->Terminate();
+	_timer.Reschedule(ice_port_info->expire_timer, 0);
 
 	return true;
 }
@@ -342,8 +355,7 @@ bool IcePort::RemoveSession(uint32_t session_id)
 	{
 		std::lock_guard<std::mutex> lock_guard(_port_table_lock);
 
-		auto item = _session_port_table.find(session_id);
-		if (item == _session_port_table.end())
+		if (_session_port_table.Find(session_id, &ice_port_info) == false)
 		{
 			/*
 			The case of reaching here is as follows.
@@ -359,44 +371,46 @@ bool IcePort::RemoveSession(uint32_t session_id)
 				// TODO(Dimiden): In this case, apply a more efficient method of deletion.
 				std::lock_guard<std::mutex> lock_guard(_user_port_table_lock);
 
-				auto it = _user_port_table.begin();
-				while (it != _user_port_table.end())
-				{
-					auto ice_port_info = it->second;
-					if (ice_port_info->session_id == session_id)
+				_user_port_table.Iterate([&](const ov::String &ufrag, const std::shared_ptr<IcePortInfo> &info) -> bool {
+					if (info->session_id == session_id)
 					{
-						_user_port_table.erase(it++);
-						logtd("This is because the stun request was not received from this session.");
+						ice_port_info = info;
+						return false;
+					}
 
-						// Close only TCP (TURN)
-						auto remote = ice_port_info->remote;
+					return true;
+				});
 
-						if (remote != nullptr)
-						{
-							if (remote->GetSocket().GetType() == ov::SocketType::Tcp)
-							{
-								remote->CloseIfNeeded();
-							}
-						}
+				if (ice_port_info == nullptr)
+				{
+					return false;
+				}
 
-						return true;
-					}
-					else
+				_timer.Cancel(ice_port_info->expire_timer);
+				_user_port_table.Erase(ice_port_info->local_sdp->GetIceUfrag());
+				logtd("This is because the stun request was not received from this session.");
+
+				// Close only TCP (TURN)
+				auto remote = ice_port_info->remote;
+
+				if (remote != nullptr)
+				{
+					if (remote->GetSocket().GetType() == ov::SocketType::Tcp)
 					{
-						it++;
+						remote->CloseIfNeeded();
 					}
 				}
-			}
 
-			return false;
+				return true;
+			}
 		}
 
-		ice_port_info = item->second;
+		_timer.Cancel(ice_port_info->expire_timer);
 
-		_session_port_table.erase(item);
+		_session_port_table.Erase(session_id);
 		for (const auto &item : ice_port_info->address_map)
 		{
-			_address_port_table.erase(item.first);
+			_address_port_table.Erase(item.first);
 		}
 
 		// Close only TCP (TURN)
@@ -413,7 +427,7 @@ bool IcePort::RemoveSession(uint32_t session_id)
 
 	{
 		std::lock_guard<std::mutex> lock_guard(_user_port_table_lock);
-		_user_port_table.erase(ice_port_info->local_sdp->GetIceUfrag());
+		_user_port_table.Erase(ice_port_info->local_sdp->GetIceUfrag());
 	}
 
 	return true;
@@ -437,63 +451,60 @@ void IcePort::CheckTimedoutItem()
 			}
 		}
 	}
+}
+
+void IcePort::CheckSessionExpired(const std::shared_ptr<IcePortInfo> &ice_port_info)
+{
+	if ((ice_port_info->IsExpired() == false) && (ice_port_info->IsTerminated() == false))
+	{
+		// The binding time has been refreshed by STUN binding requests
+		_timer.Reschedule(ice_port_info->expire_timer, ice_port_info->GetRemainingMsec());
+		return;
+	}
 
-	std::vector<std::shared_ptr<IcePortInfo>> delete_list;
 	{
 		std::lock_guard<std::mutex> lock_guard(_user_port_table_lock);
 
-		for (auto item = _user_port_table.begin(); item != _user_port_table.end();)
+		if (_user_port_table.Erase(ice_port_info->local_sdp->GetIceUfrag(), ice_port_info) == false)
 		{
-			if (item->second->IsExpired() || item->second->IsTerminated())
-			{
-				delete_list.push_back(item->second);
-				item = _user_port_table.erase(item);
-			}
-			else
-			{
-				++item;
-			}
+			// Already removed by RemoveSession()
+			return;
 		}
 	}
 
 	{
 		std::lock_guard<std::mutex> lock_guard(_port_table_lock);
 
-		for (auto &deleted_ice_port : delete_list)
+		_session_port_table.Erase(ice_port_info->session_id);
+		for (const auto &item : ice_port_info->address_map)
 		{
-			_session_port_table.erase(deleted_ice_port->session_id);
-			for (const auto &item : deleted_ice_port->address_map)
-			{
-				_address_port_table.erase(item.first);
-			}
+			_address_port_table.Erase(item.first);
 		}
 	}
 
 	// Notify to observer
-	for (auto &deleted_ice_port : delete_list)
+	IcePortConnectionState state;
+	if (ice_port_info->IsExpired())
 	{
-		IcePortConnectionState state;
-		if (deleted_ice_port->IsExpired())
-		{
-			state = IcePortConnectionState::Disconnected;
-
-			logtw("Client %s(session id: %d) has expired", deleted_ice_port->address.ToString(false).CStr(), deleted_ice_port->session_id);
-		}
-		else
-		{
-			state = IcePortConnectionState::Closed;
+		state = IcePortConnectionState::Disconnected;
 
-			logti("Client %s(session id: %d) has terminated", deleted_ice_port->address.ToString(false).CStr(), deleted_ice_port->session_id);
-		}
+		logtw("Client %s(session id: %d) has expired", ice_port_info->address.ToString(false).CStr(), ice_port_info->session_id);
+	}
+	else
+	{
+		state = IcePortConnectionState::Closed;
 
-		// Close only TCP (TURN)
-		if (deleted_ice_port->remote != nullptr && deleted_ice_port->remote->GetSocket().GetType() == ov::SocketType::Tcp)
-		{
-			deleted_ice_port->remote->CloseIfNeeded();
-		}
+		logti("Client %s(session id: %d) has terminated", ice_port_info->address.ToString(false).CStr(), ice_port_info->session_id);
+	}
 
-		SetIceState(deleted_ice_port, state);
+	// Close only TCP (TURN)
+	if (ice_port_info->remote != nullptr && ice_port_info->remote->GetSocket().GetType() == ov::SocketType::Tcp)
+	{
+		ice_port_info->remote->CloseIfNeeded();
 	}
+
+	auto info = ice_port_info;
+	SetIceState(info, state);
 }
 
 bool IcePort::Send(uint32_t session_id, std::shared_ptr<RtpPacket> packet)
@@ -509,30 +520,42 @@ bool IcePort::Send(uint32_t session_id, std::shared_ptr<RtcpPacket> packet)
 bool IcePort::Send(uint32_t session_id, const std::shared_ptr<const ov::Data> &data)
 {
 	std::shared_ptr<IcePortInfo> ice_port_info;
+	if (_session_port_table.Find(session_id, &ice_port_info) == false)
 	{
-		std::lock_guard<std::mutex> lock_guard(_port_table_lock);
-
-		auto item = _session_port_table.find(session_id);
-		if (item == _session_port_table.end())
-		{
-			logtd("ClientSocket not found for session #%d", session_id);
-			return false;
-		}
-
-		ice_port_info = item->second;
+		logtd("ClientSocket not found for session #%d", session_id);
+		return false;
 	}
 
 	std::shared_ptr<const ov::Data> send_data = nullptr;
 
-	// Send throutgh TURN data channel
-	if (ice_port_info->is_turn_client == true && ice_port_info->is_data_channel_enabled == true)
+	if (ice_port_info->is_turn_client == true)
 	{
-		send_data = CreateChannelDataMessage(ice_port_info->data_channle_number, data);
-	}
-	// Send thourgh DATA indication
-	else if (ice_port_info->is_turn_client == true && ice_port_info->is_data_channel_enabled == false)
-	{
-		send_data = CreateDataIndication(ice_port_info->peer_address, data);
+		bool is_data_channel_enabled;
+		uint16_t data_channel_number;
+		ov::SocketAddress peer_address;
+
+		{
+			std::lock_guard<std::mutex> lock_guard(ice_port_info->turn_lock);
+
+			is_data_channel_enabled = ice_port_info->is_data_channel_enabled;
+			data_channel_number = ice_port_info->data_channle_number;
+
+			if (is_data_channel_enabled == false)
+			{
+				peer_address = ice_port_info->peer_address;
+			}
+		}
+
+		// Send throutgh TURN data channel
+		if (is_data_channel_enabled == true)
+		{
+			send_data = CreateChannelDataMessage(data_channel_number, data);
+		}
+		// Send thourgh DATA indication
+		else
+		{
+			send_data = CreateDataIndication(peer_address, data);
+		}
 	}
 	// Send direct
 	else
@@ -644,26 +667,24 @@ void IcePort::OnApplicationPacketReceived(const std::shared_ptr<ov::Socket> &rem
 										  GateInfo &gate_info, const std::shared_ptr<const ov::Data> &data)
 {
 	std::shared_ptr<IcePortInfo> ice_port_info;
+	if (_address_port_table.Find(address, &ice_port_info) == false)
 	{
-		std::lock_guard<std::mutex> lock_guard(_port_table_lock);
-		auto item = _address_port_table.find(address);
-		if (item != _address_port_table.end())
-		{
-			ice_port_info = item->second;
-			// When the candidate pair is determined, the peer starts sending DTLS messages. This can be seen as a true connected.
-			if (ice_port_info->state != IcePortConnectionState::Connected)
-			{
-				SetIceState(ice_port_info, IcePortConnectionState::Connected);
-				// It communicates with the candidate address that sends application data first.
-				ice_port_info->address = address;
-			}
-		}
+		logtd("Could not find client(%s) information. Dropping...", address.ToString(false).CStr());
+		return;
 	}
 
-	if (ice_port_info == nullptr)
+	// When the candidate pair is determined, the peer starts sending DTLS messages. This can be seen as a true connected.
+	if (ice_port_info->state != IcePortConnectionState::Connected)
 	{
-		logtd("Could not find client(%s) information. Dropping...", address.ToString(false).CStr());
-		return;
+		std::lock_guard<std::mutex> lock_guard(_port_table_lock);
+
+		// Check again since another thread may have changed the state
+		if (ice_port_info->state != IcePortConnectionState::Connected)
+		{
+			SetIceState(ice_port_info, IcePortConnectionState::Connected);
+			// It communicates with the candidate address that sends application data first.
+			ice_port_info->address = address;
+		}
 	}
 
 	if (ice_port_info->observer != nullptr)
@@ -692,16 +713,13 @@ void IcePort::OnChannelDataPacketReceived(const std::shared_ptr<ov::Socket> &rem
 	// Update GateInfo
 	// If a request comes from a send indication or channel, this is through a turn. When transmitting a packet to the player, it must be sent through a data indication or channel, so it stores related information.
 	std::shared_ptr<IcePortInfo> ice_port_info;
+	if (_address_port_table.Find(address, &ice_port_info))
 	{
-		std::lock_guard<std::mutex> lock_guard(_port_table_lock);
-		auto item = _address_port_table.find(address);
-		if (item != _address_port_table.end())
-		{
-			ice_port_info = item->second;
-			ice_port_info->is_turn_client = true;
-			ice_port_info->is_data_channel_enabled = true;
-			ice_port_info->data_channle_number = application_gate_info.channel_number;
-		}
+		std::lock_guard<std::mutex> lock_guard(ice_port_info->turn_lock);
+
+		ice_port_info->is_data_channel_enabled = true;
+		ice_port_info->data_channle_number = application_gate_info.channel_number;
+		ice_port_info->is_turn_client = true;
 	}
 
 	// Decapsulate and process the packet again.
@@ -813,20 +831,14 @@ bool IcePort::ProcessStunBindingRequest(const std::shared_ptr<ov::Socket> &remot
 
 	logtd("[From %s To %s] Received STUN binding request: %s:%s", address.ToString(false).CStr(), remote->GetLocalAddress()->ToString().CStr(), local_ufrag.CStr(), remote_ufrag.CStr());
 
+	// WebRTC Publisher registers ufrag with session information
+	// through IcePort::AddSession function after signaling with player
 	std::shared_ptr<IcePortInfo> ice_port_info;
+	if (_user_port_table.Find(local_ufrag, &ice_port_info) == false)
 	{
-		// WebRTC Publisher registers ufrag with session information
-		// through IcePort::AddSession function after signaling with player
-		std::unique_lock<std::mutex> lock_guard(_user_port_table_lock);
-		auto info = _user_port_table.find(local_ufrag);
-		if (info == _user_port_table.end())
-		{
-			// Stun may arrive first before AddSession, it is not an error
-			logtd("User not found: %s", local_ufrag.CStr());
-			return false;
-		}
-
-		ice_port_info = info->second;
+		// Stun may arrive first before AddSession, it is not an error
+		logtd("User not found: %s", local_ufrag.CStr());
+		return false;
 	}
 
 	if (ice_port_info->peer_sdp->GetIceUfrag() != remote_ufrag)
@@ -842,7 +854,7 @@ bool IcePort::ProcessStunBindingRequest(const std::shared_ptr<ov::Socket> &remot
 		{
 			std::lock_guard<std::mutex> lock_guard(_user_port_table_lock);
 
-			_user_port_table.erase(local_ufrag);
+			_user_port_table.Erase(local_ufrag);
 		}
 
 		{
@@ -850,9 +862,9 @@ bool IcePort::ProcessStunBindingRequest(const std::shared_ptr<ov::Socket> &remot
 
 			for (const auto &item : ice_port_info->address_map)
 			{
-				_address_port_table.erase(item.first);
+				_address_port_table.Erase(item.first);
 			}
-			_session_port_table.erase(ice_port_info->session_id);
+			_session_port_table.Erase(ice_port_info->session_id);
 		}
 
 		return false;
@@ -876,8 +888,8 @@ bool IcePort::ProcessStunBindingRequest(const std::shared_ptr<ov::Socket> &remot
 		ice_port_info->address = address;
 		ice_port_info->address_map[address] = true;
 
-		_address_port_table[address] = ice_port_info;
-		_session_port_table[ice_port_info->session_id] = ice_port_info;
+		_address_port_table.Set(address, ice_port_info);
+		_session_port_table.Set(ice_port_info->session_id, ice_port_info);
 
 		SetIceState(ice_port_info, IcePortConnectionState::Checking);
 	}
@@ -1179,16 +1191,13 @@ bool IcePort::ProcessTurnSendIndication(const std::shared_ptr<ov::Socket> &remot
 	gate_info.peer_address = xor_peer_attribute->GetAddress();
 
 	std::shared_ptr<IcePortInfo> ice_port_info;
+	if (_address_port_table.Find(address, &ice_port_info))
 	{
-		std::lock_guard<std::mutex> lock_guard(_port_table_lock);
-		auto item = _address_port_table.find(address);
-		if (item != _address_port_table.end())
-		{
-			ice_port_info = item->second;
-			ice_port_info->is_turn_client = true;
-			ice_port_info->is_data_channel_enabled = false;
-			ice_port_info->peer_address = gate_info.peer_address;
-		}
+		std::lock_guard<std::mutex> lock_guard(ice_port_info->turn_lock);
+
+		ice_port_info->is_data_channel_enabled = false;
+		ice_port_info->peer_address = gate_info.peer_address;
+		ice_port_info->is_turn_client = true;
 	}
 
 	OnPacketReceived(remote, address, gate_info, data);
@@ -1224,16 +1233,13 @@ bool IcePort::ProcessTurnChannelBindRequest(const std::shared_ptr<ov::Socket> &r
 	SendStunMessage(remote, address, gate_info, response_message, _hmac_key);
 
 	std::shared_ptr<IcePortInfo> ice_port_info;
+	if (_address_port_table.Find(address, &ice_port_info))
 	{
-		std::lock_guard<std::mutex> lock_guard(_port_table_lock);
-		auto item = _address_port_table.find(address);
-		if (item != _address_port_table.end())
-		{
-			ice_port_info = item->second;
-			ice_port_info->is_turn_client = true;
-			ice_port_info->is_data_channel_enabled = true;
-			ice_port_info->data_channle_number = channel_number_attribute->GetChannelNumber();
-		}
+		std::lock_guard<std::mutex> lock_guard(ice_port_info->turn_lock);
+
+		ice_port_info->is_data_channel_enabled = true;
+		ice_port_info->data_channle_number = channel_number_attribute->GetChannelNumber();
+		ice_port_info->is_turn_client = true;
 	}
 
 	return true;
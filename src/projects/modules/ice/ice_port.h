@@ -89,18 +89,24 @@ protected:
 		ov::SocketAddress address;
 		std::map<ov::SocketAddress, bool> address_map;
 
-		IcePortConnectionState state;
+		std::atomic<IcePortConnectionState> state;
 
 		std::chrono::time_point<std::chrono::system_clock> expire_time;
 
 		// Information related TURN
-		bool is_turn_client = false;
+		// is_turn_client is checked without a lock for every packet sent, so the direct clients never take turn_lock.
+		// The others are protected by turn_lock since they are updated while the packets are being sent.
+		std::atomic<bool> is_turn_client{false};
+		std::mutex turn_lock;
 		bool is_data_channel_enabled = false;
 		ov::SocketAddress peer_address;
 		uint16_t data_channle_number = 0;
 
 		bool terminated = false;
 
+		// Fires when the session may have expired (scheduled on IcePort::_timer)
+		ov::TimingWheel::TimerHandle expire_timer;
+
 		// expire_after_ms is refreshed when stun binding request arrived
 		// lifetime is generated by SingedPolicy and is not refreshed, If 0, it will live forever until the client disconnects or causes a problem.
 		IcePortInfo(int expire_after_ms, uint64_t lifetime_epoch_ms)
@@ -123,6 +129,20 @@ protected:
 			return (std::chrono::system_clock::now() > expire_time);
 		}
 
+		// Milliseconds until IsExpired() becomes true unless the binding time is refreshed
+		int GetRemainingMsec() const
+		{
+			int64_t remaining = std::chrono::duration_cast<std::chrono::milliseconds>(expire_time - std::chrono::system_clock::now()).count();
+
+			if (_lifetime_epoch_ms != 0)
+			{
+				remaining = std::min(remaining, static_cast<int64_t>(_lifetime_epoch_ms) - static_cast<int64_t>(ov::Clock::NowMSec()));
+			}
+
+			// IsExpired() compares with '>', so check again 1 ms later
+			return static_cast<int>(std::max<int64_t>(remaining + 1, 0));
+		}
+
 		void Terminate()
 		{
 			terminated = true;
@@ -173,14 +193,14 @@ public:
 
 	IcePortConnectionState GetState(uint32_t session_id) const
 	{
-		auto item = _session_port_table.find(session_id);
-		if(item == _session_port_table.end())
+		std::shared_ptr<IcePortInfo> ice_port_info;
+		if(_session_port_table.Find(session_id, &ice_port_info) == false)
 		{
 			OV_ASSERT(false, "Invalid session_id: %d", session_id);
 			return IcePortConnectionState::Failed;
 		}
 
-		return item->second->state;
+		return ice_port_info->state;
 	}
 
 	ov::String GenerateUfrag();
@@ -217,6 +237,8 @@ private:
 	std::shared_ptr<IcePortInfo> FindIcePortInfo(uint32_t session_id);
 
 	void CheckTimedoutItem();
+	// Called when the expire_timer of the session fires
+	void CheckSessionExpired(const std::shared_ptr<IcePortInfo> &ice_port_info);
 
 	void OnPacketReceived(const std::shared_ptr<ov::Socket> &remote, const ov::SocketAddress &address, 
 						GateInfo &packet_info, const std::shared_ptr<const ov::Data> &data);
@@ -265,19 +287,22 @@ private:
 	std::vector<std::shared_ptr<PhysicalPort>> _physical_port_list;
 	std::recursive_mutex _physical_port_list_mutex;
 
+	// Lookups of the following tables are lock-free since they are done for every packet.
+	// The locks only serialize the modifications that span multiple tables.
+
 	// Mapping table containing related information until STUN binding.
 	// Once binding is complete, there is no need because it can be found by destination ip & port.
 	// key: offer ufrag
 	// value: IcePortInfo
 	std::mutex _user_port_table_lock;
-	std::map<const ov::String, std::shared_ptr<IcePortInfo>> _user_port_table;
+	ov::ShardedMap<ov::String, std::shared_ptr<IcePortInfo>> _user_port_table;
 	
 	// Find IcePortInfo with peer's ip:port
 	// key: SocketAddress value: IcePortInfo
 	std::mutex _port_table_lock;
-	std::map<ov::SocketAddress, std::shared_ptr<IcePortInfo>> _address_port_table;
+	ov::ShardedMap<ov::SocketAddress, std::shared_ptr<IcePortInfo>, ov::SocketAddress::StorageHash, ov::SocketAddress::StorageEqual> _address_port_table;
 	// Find IcePortInfo with peer's session id
-	std::map<session_id_t, std::shared_ptr<IcePortInfo>> _session_port_table;
+	ov::ShardedMap<session_id_t, std::shared_ptr<IcePortInfo>> _session_port_table;
 
 	// Insert item when send stun binding request
 	// Remove item when receive stun binding response or timed out
@@ -291,5 +316,6 @@ private:
 	std::shared_mutex _demultiplexers_lock;
 	std::map<int, std::shared_ptr<IceTcpDemultiplexer>>	_demultiplexers;
 
-	ov::DelayQueue _timer{"ICETmout"};
+	// Drives the expire timer of each session and the cleanup of the binding requests
+	ov::TimingWheel _timer{"ICETmout"};
 };
@@ -60,4 +60,73 @@ namespace serdes
 
 		return value;
 	}
-}  // namespace serdes
\ No newline at end of file
+
+	// Keys must be written in ascending order to be the same as the output of ov::Json::Stringify()
+	static void WriteMetricsMembers(ov::JsonWriter &writer, const mon::CommonMetrics *metrics, const mon::StreamMetrics *stream_metrics)
+	{
+		static const PublisherType connection_types[] = {
+			PublisherType::Dash,
+			PublisherType::File,
+			PublisherType::Hls,
+			PublisherType::LLDash,
+			PublisherType::LLHls,
+			PublisherType::MpegtsPush,
+			PublisherType::Ovt,
+			PublisherType::RtmpPush,
+			PublisherType::Thumbnail,
+			PublisherType::Webrtc};
+
+		writer.Key("avgBitrateIn").Int64(metrics->GetAvgBitrateIn());
+		writer.Key("avgBitrateOut").Int64(metrics->GetAvgBitrateOut());
+
+		writer.Key("connections").BeginObject();
+		for (auto type : connection_types)
+		{
+			writer.Key(StringFromPublisherType(type).LowerCaseString()).Int64(metrics->GetConnections(type));
+		}
+		writer.EndObject();
+
+		writer.Key("createdTime").String(ov::Converter::ToISO8601String(metrics->GetCreatedTime()));
+		writer.Key("lastRecvTime").String(ov::Converter::ToISO8601String(metrics->GetLastRecvTime()));
+		writer.Key("lastSentTime").String(ov::Converter::ToISO8601String(metrics->GetLastSentTime()));
+		writer.Key("lastUpdatedTime").String(ov::Converter::ToISO8601String(metrics->GetLastUpdatedTime()));
+		writer.Key("maxTotalConnectionTime").String(ov::Converter::ToISO8601String(metrics->GetMaxTotalConnectionsTime()));
+		writer.Key("maxTotalConnections").Int64(metrics->GetMaxTotalConnections());
+
+		if (stream_metrics != nullptr)
+		{
+			writer.Key("requestTimeToOrigin").Int64(stream_metrics->GetOriginConnectionTimeMSec());
+			writer.Key("responseTimeFromOrigin").Int64(stream_metrics->GetOriginSubscribeTimeMSec());
+		}
+
+		writer.Key("totalBytesIn").Int64(metrics->GetTotalBytesIn());
+		writer.Key("totalBytesOut").Int64(metrics->GetTotalBytesOut());
+		writer.Key("totalConnections").Int64(metrics->GetTotalConnections());
+	}
+
+	void WriteMetrics(ov::JsonWriter &writer, const std::shared_ptr<const mon::CommonMetrics> &metrics)
+	{
+		if (metrics == nullptr)
+		{
+			writer.Null();
+			return;
+		}
+
+		writer.BeginObject();
+		WriteMetricsMembers(writer, metrics.get(), nullptr);
+		writer.EndObject();
+	}
+
+	void WriteStreamMetrics(ov::JsonWriter &writer, const std::shared_ptr<const mon::StreamMetrics> &metrics)
+	{
+		if (metrics == nullptr)
+		{
+			writer.Null();
+			return;
+		}
+
+		writer.BeginObject();
+		WriteMetricsMembers(writer, metrics.get(), metrics.get());
+		writer.EndObject();
+	}
+}  // namespace serdes
@@ -14,4 +14,8 @@ namespace serdes
 {
 	Json::Value JsonFromMetrics(const std::shared_ptr<const mon::CommonMetrics> &metrics);
 	Json::Value JsonFromStreamMetrics(const std::shared_ptr<const mon::StreamMetrics> &metrics);
+
+	// Write the same JSON as JsonFromMetrics()/JsonFromStreamMetrics() without building a Json::Value
+	void WriteMetrics(ov::JsonWriter &writer, const std::shared_ptr<const mon::CommonMetrics> &metrics);
+	void WriteStreamMetrics(ov::JsonWriter &writer, const std::shared_ptr<const mon::StreamMetrics> &metrics);
 }  // namespace serdes
\ No newline at end of file
@@ -276,8 +276,15 @@ bool MpegtsWriter::AddTrack(cmn::MediaType media_type, int32_t track_id, std::sh
 //	- H264 : AnnexB bitstream
 // 	- AAC : ASC(Audio Specific Config) bitstream
 
-bool MpegtsWriter::PutData(int32_t track_id, int64_t pts, int64_t dts, MediaPacketFlag flag, cmn::BitstreamFormat format, std::shared_ptr<ov::Data> &data)
+bool MpegtsWriter::PutData(const std::shared_ptr<const MediaPacket> &media_packet)
 {
+	auto track_id = media_packet->GetTrackId();
+	auto pts = media_packet->GetPts();
+	auto dts = media_packet->GetDts();
+	auto flag = media_packet->GetFlag();
+	auto format = media_packet->GetBitstreamFormat();
+	auto data = media_packet->GetData();
+
 	std::unique_lock<std::mutex> mlock(_lock);
 
 	if (_format_context == nullptr)
@@ -313,7 +320,6 @@ bool MpegtsWriter::PutData(int32_t track_id, int64_t pts, int64_t dts, MediaPack
 	av_packet.dts = av_rescale_q(dts, AVRational{track_info->GetTimeBase().GetNum(), track_info->GetTimeBase().GetDen()}, stream->time_base);
 
 	std::shared_ptr<const ov::Data> cdata = data;
-	std::vector<size_t> length_list;
 
 	if (strcmp(_format_context->oformat->name, "flv") == 0)
 	{
@@ -325,7 +331,7 @@ bool MpegtsWriter::PutData(int32_t track_id, int64_t pts, int64_t dts, MediaPack
 			break;
 
 		case cmn::BitstreamFormat::H264_ANNEXB:
-			cdata = H264Converter::ConvertAnnexbToAvcc(cdata);
+			cdata = H264Converter::GetAvccView(media_packet)->GetData();
 			av_packet.size = cdata->GetLength();
 			av_packet.data = (uint8_t *)cdata->GetDataAs<uint8_t>();
 			break;
@@ -336,7 +342,7 @@ bool MpegtsWriter::PutData(int32_t track_id, int64_t pts, int64_t dts, MediaPack
 			break;
 
 		case cmn::BitstreamFormat::AAC_ADTS:
-			cdata = AacConverter::ConvertAdtsToRaw(cdata, &length_list);
+			cdata = AacConverter::GetRawView(media_packet)->GetData();
 			av_packet.size = cdata->GetLength();
 			av_packet.data = (uint8_t *)cdata->GetDataAs<uint8_t>();
 			break;
@@ -356,7 +362,7 @@ bool MpegtsWriter::PutData(int32_t track_id, int64_t pts, int64_t dts, MediaPack
 			break;
 
 		case cmn::BitstreamFormat::AAC_ADTS:
-			cdata = AacConverter::ConvertAdtsToRaw(cdata, &length_list);
+			cdata = AacConverter::GetRawView(media_packet)->GetData();
 			av_packet.size = cdata->GetLength();
 			av_packet.data = (uint8_t *)cdata->GetDataAs<uint8_t>();
 			break;
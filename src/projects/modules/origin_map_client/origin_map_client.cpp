@@ -17,6 +17,7 @@ OriginMapClient::OriginMapClient(const ov::String &redis_host, const ov::String
 	auto ip_port = redis_host.Split(":");
 	if (ip_port.size() != 2)
 	{
+		logte("Invalid redis server host: %s", redis_host.CStr());
 		return;
 	}
 
@@ -24,43 +25,146 @@ OriginMapClient::OriginMapClient(const ov::String &redis_host, const ov::String
 	_redis_port = ov::Converter::ToUInt16(ip_port[1]);
 	_redis_password = redis_password;
 
+	// The connections are connected when they are used first
+	for (int index = 0; index < ORIGIN_MAP_CLIENT_CONNECTION_POOL_SIZE; index++)
+	{
+		_idle_connections.push_back(std::make_shared<RedisConnection>(_redis_ip, _redis_port, _redis_password));
+	}
+
+	_is_running = true;
+
+	_subscriber = std::make_shared<RedisConnection>(_redis_ip, _redis_port, _redis_password);
+	_subscriber_thread = std::thread(&OriginMapClient::SubscriberThread, this);
+	pthread_setname_np(_subscriber_thread.native_handle(), "OriginMapSub");
+
 	_update_timer.Push(
 		[this](void *paramter) -> ov::DelayQueueAction {
 			NofifyStreamsAlive();
 			return ov::DelayQueueAction::Repeat;
 		},
-		2500);
+		ORIGIN_MAP_CLIENT_UPDATE_INTERVAL_MS);
 	_update_timer.Start();
 }
 
-bool OriginMapClient::NofifyStreamsAlive()
+OriginMapClient::~OriginMapClient()
 {
-	std::lock_guard<std::mutex> lock(_origin_map_mutex);
-	for (auto &[key, value] : _origin_map)
+	_update_timer.Stop();
+
+	_is_running = false;
+
+	if (_subscriber != nullptr)
 	{
-		Update(key, value);
+		_subscriber->Shutdown();
 	}
 
-	return true;
+	if (_subscriber_thread.joinable())
+	{
+		_subscriber_thread.join();
+	}
 }
 
-bool OriginMapClient::Register(const ov::String &app_stream_name, const ov::String &origin_host)
+bool OriginMapClient::Execute(const std::vector<RedisCommand> &commands, std::vector<RedisReply> *replies)
 {
-	if (ConnectRedis() == false)
+	if (_redis_ip.IsEmpty())
 	{
-		logte("Failed to connect redis server : %s:%d (err:%s)", _redis_ip.CStr(), _redis_port, _redis_context!=nullptr?_redis_context->errstr:"nil");
 		return false;
 	}
 
-	std::lock_guard<std::mutex> lock(_redis_context_mutex);
+	std::shared_ptr<RedisConnection> connection;
+
+	{
+		std::unique_lock<std::mutex> lock(_connection_pool_mutex);
+
+		_connection_pool_condition.wait(lock, [this]() -> bool {
+			return (_idle_connections.empty() == false);
+		});
+
+		connection = _idle_connections.back();
+		_idle_connections.pop_back();
+	}
+
+	auto result = connection->Pipeline(commands, replies);
+
+	if (result == false)
+	{
+		logte("Failed to send %zu commands to redis server : %s:%d (err:%s)", commands.size(), _redis_ip.CStr(), _redis_port, connection->GetError().CStr());
+	}
+
+	{
+		std::lock_guard<std::mutex> lock(_connection_pool_mutex);
+		_idle_connections.push_back(connection);
+	}
+
+	_connection_pool_condition.notify_one();
+
+	return result;
+}
+
+bool OriginMapClient::NofifyStreamsAlive()
+{
+	std::vector<RedisCommand> commands;
+
+	{
+		std::lock_guard<std::mutex> lock(_origin_map_mutex);
+
+		commands.reserve(_origin_map.size());
+
+		for (auto &[key, value] : _origin_map)
+		{
+			// XX option or EXPIRE cmd are not used because if redis server is restarted, update() can restore the origin stream info.
+			commands.push_back({"SET", key, value, "EX", ov::Converter::ToString(ORIGIN_MAP_CLIENT_EXPIRE_SEC)});
+		}
+	}
+
+	bool result = true;
+
+	// All the streams are refreshed in a few round trips instead of a round trip per stream
+	for (size_t offset = 0; offset < commands.size(); offset += ORIGIN_MAP_CLIENT_MAX_PIPELINE_COMMANDS)
+	{
+		auto end = std::min(offset + ORIGIN_MAP_CLIENT_MAX_PIPELINE_COMMANDS, commands.size());
+
+		std::vector<RedisCommand> batch(commands.begin() + offset, commands.begin() + end);
+		std::vector<RedisReply> replies;
+
+		if (Execute(batch, &replies) == false)
+		{
+			result = false;
+			continue;
+		}
+
+		for (size_t index = 0; index < replies.size(); index++)
+		{
+			if (replies[index]->type == REDIS_REPLY_ERROR)
+			{
+				logte("Failed to update origin host of <%s> : %s", batch[index][1].CStr(), replies[index]->str);
+				result = false;
+			}
+		}
+	}
+
+	return result;
+}
+
+bool OriginMapClient::Register(const ov::String &app_stream_name, const ov::String &origin_host)
+{
+	std::vector<RedisReply> replies;
 
 	// Set origin host to redis
 	// The EXPIRE option is to prevent locking the app/stream when OvenMediaEngine unexpectedly stops.
-	// So _update_timer updates the expire time once every 2.5 seconds.
-	redisReply *reply = (redisReply *)redisCommand(_redis_context, "SET %s %s EX 10 NX", app_stream_name.CStr(), origin_host.CStr());
-	if (reply == nullptr || reply->type == REDIS_REPLY_ERROR)
+	// So _update_timer updates the expire time periodically.
+	// The caches of the other servers are invalidated in the same round trip.
+	if (Execute({{"SET", app_stream_name, origin_host, "EX", ov::Converter::ToString(ORIGIN_MAP_CLIENT_EXPIRE_SEC), "NX"},
+				 {"PUBLISH", ORIGIN_MAP_CLIENT_CHANNEL, app_stream_name}},
+				&replies) == false)
 	{
-		logte("Failed to set origin host to redis : %s:%d (err:%s)", _redis_ip.CStr(), _redis_port, reply!=nullptr?reply->str:"nil");
+		return false;
+	}
+
+	auto &reply = replies[0];
+
+	if (reply->type == REDIS_REPLY_ERROR)
+	{
+		logte("Failed to set origin host to redis : %s:%d (err:%s)", _redis_ip.CStr(), _redis_port, reply->str);
 		return false;
 	}
 	else if (reply->type == REDIS_REPLY_NIL)
@@ -69,30 +173,32 @@ bool OriginMapClient::Register(const ov::String &app_stream_name, const ov::Stri
 		return false;
 	}
 
-	freeReplyObject(reply);
+	{
+		std::lock_guard<std::mutex> origin_map_lock(_origin_map_mutex);
+		_origin_map[app_stream_name] = origin_host;
+	}
 
-	std::lock_guard<std::mutex> origin_map_lock(_origin_map_mutex);
-	_origin_map[app_stream_name] = origin_host;
+	InvalidateCache(app_stream_name);
 
 	return true;
 }
 
 bool OriginMapClient::Update(const ov::String &app_stream_name, const ov::String &origin_host)
 {
-	if (ConnectRedis() == false)
+	// Set origin host to redis
+	// XX option or EXPIRE cmd are not used because if redis server is restarted, update() can restore the origin stream info.
+	auto replies = std::vector<RedisReply>();
+
+	if (Execute({{"SET", app_stream_name, origin_host, "EX", ov::Converter::ToString(ORIGIN_MAP_CLIENT_EXPIRE_SEC)}}, &replies) == false)
 	{
-		logte("Failed to connect redis server : %s:%d (err:%s)", _redis_ip.CStr(), _redis_port, _redis_context!=nullptr?_redis_context->errstr:"nil");
 		return false;
 	}
 
-	std::lock_guard<std::mutex> lock(_redis_context_mutex);
+	auto &reply = replies[0];
 
-	// Set origin host to redis
-	// XX option or EXPIRE cmd are not used because if redis server is restarted, update() can restore the origin stream info.
-	redisReply *reply = (redisReply *)redisCommand(_redis_context, "SET %s %s EX 10", app_stream_name.CStr(), origin_host.CStr());
-	if (reply == nullptr || reply->type == REDIS_REPLY_ERROR)
+	if (reply->type == REDIS_REPLY_ERROR)
 	{
-		logte("Failed to set origin host to redis : %s:%d (err:%s)", _redis_ip.CStr(), _redis_port, reply!=nullptr?reply->str:"nil");
+		logte("Failed to set origin host to redis : %s:%d (err:%s)", _redis_ip.CStr(), _redis_port, reply->str);
 		return false;
 	}
 	else if (reply->type == REDIS_REPLY_NIL)
@@ -101,113 +207,136 @@ bool OriginMapClient::Update(const ov::String &app_stream_name, const ov::String
 		return false;
 	}
 
-	freeReplyObject(reply);
-
 	return true;
 }
 
 bool OriginMapClient::Unregister(const ov::String &app_stream_name)
 {
-	if (ConnectRedis() == false)
 	{
-		logte("Failed to connect redis server : %s:%d (err:%s)", _redis_ip.CStr(), _redis_port, _redis_context!=nullptr?_redis_context->errstr:"nil");
-		return false;
+		std::lock_guard<std::mutex> origin_map_lock(_origin_map_mutex);
+		_origin_map.erase(app_stream_name);
 	}
 
-	std::lock_guard<std::mutex> lock(_redis_context_mutex);
+	InvalidateCache(app_stream_name);
 
-	redisReply *reply = (redisReply *)redisCommand(_redis_context, "DEL %s", app_stream_name.CStr());
-	freeReplyObject(reply);
+	std::vector<RedisReply> replies;
 
-	std::lock_guard<std::mutex> origin_map_lock(_origin_map_mutex);
-	_origin_map.erase(app_stream_name);
-
-	return true;
+	return Execute({{"DEL", app_stream_name},
+					{"PUBLISH", ORIGIN_MAP_CLIENT_CHANNEL, app_stream_name}},
+				   &replies);
 }
 
 CommonErrorCode OriginMapClient::GetOrigin(const ov::String &app_stream_name, ov::String &origin_host)
 {
-	if (ConnectRedis() == false)
+	auto now_ms = ov::Time::GetMonotonicTimestamp();
+
+	{
+		std::lock_guard<std::mutex> lock(_cache_mutex);
+
+		auto item = _cache.find(app_stream_name);
+		if ((item != _cache.end()) && (now_ms < item->second.expire_time_ms))
+		{
+			origin_host = item->second.origin_host;
+			return item->second.result;
+		}
+	}
+
+	std::vector<RedisReply> replies;
+
+	if (Execute({{"GET", app_stream_name}}, &replies) == false)
 	{
-		logte("Failed to connect redis server : %s:%d (err:%s)", _redis_ip.CStr(), _redis_port, _redis_context!=nullptr?_redis_context->errstr:"nil");
 		return CommonErrorCode::ERROR;
 	}
 
-	std::lock_guard<std::mutex> lock(_redis_context_mutex);
+	auto &reply = replies[0];
+	CacheItem cache_item{CommonErrorCode::SUCCESS, "", now_ms + ORIGIN_MAP_CLIENT_CACHE_TTL_MS};
 
-	redisReply *reply = (redisReply *)redisCommand(_redis_context, "GET %s", app_stream_name.CStr());
-	if (reply == nullptr || reply->type == REDIS_REPLY_ERROR)
+	if (reply->type == REDIS_REPLY_ERROR)
 	{
-		logte("Failed to get origin host from redis : %s:%d (err:%s)", _redis_ip.CStr(), _redis_port, reply!=nullptr?reply->str:"nil");
+		logte("Failed to get origin host from redis : %s:%d (err:%s)", _redis_ip.CStr(), _redis_port, reply->str);
 		return CommonErrorCode::ERROR;
 	}
 	else if (reply->type == REDIS_REPLY_NIL)
 	{
-		return CommonErrorCode::NOT_FOUND;
+		cache_item.result = CommonErrorCode::NOT_FOUND;
 	}
-
-	origin_host = reply->str;
-	freeReplyObject(reply);
-
-	return CommonErrorCode::SUCCESS;
-}
-
-bool OriginMapClient::ConnectRedis()
-{
-	std::lock_guard<std::mutex> lock(_redis_context_mutex);
-
-	if (CheckConnection() == true)
+	else
 	{
-		return true;
+		cache_item.origin_host = ov::String(reply->str, reply->len);
+		origin_host = cache_item.origin_host;
 	}
 
-	// connect to redis server
-	_redis_context = redisConnect(_redis_ip.CStr(), _redis_port);
-	if (_redis_context == nullptr || _redis_context->err)
 	{
-		if (_redis_context == nullptr)
+		std::lock_guard<std::mutex> lock(_cache_mutex);
+
+		if (_cache.size() >= ORIGIN_MAP_CLIENT_MAX_CACHE_ENTRIES)
 		{
-			redisFree(_redis_context);
-			_redis_context = nullptr;
+			// Remove the expired entries, and all the entries if there are too many valid entries
+			for (auto item = _cache.begin(); item != _cache.end();)
+			{
+				item = (now_ms >= item->second.expire_time_ms) ? _cache.erase(item) : std::next(item);
+			}
+
+			if (_cache.size() >= ORIGIN_MAP_CLIENT_MAX_CACHE_ENTRIES)
+			{
+				_cache.clear();
+			}
 		}
 
-		logte("Failed to connect to redis server. ip: %s, port: %d, err: %s", _redis_ip.CStr(), _redis_port, _redis_context->errstr);
-		return false;
+		_cache[app_stream_name] = cache_item;
 	}
 
-	// Auth
-	if (_redis_password.IsEmpty() == false)
+	return cache_item.result;
+}
+
+void OriginMapClient::InvalidateCache(const ov::String &app_stream_name)
+{
+	std::lock_guard<std::mutex> lock(_cache_mutex);
+	_cache.erase(app_stream_name);
+}
+
+void OriginMapClient::SubscriberThread()
+{
+	while (_is_running)
 	{
-		redisReply *reply = (redisReply *)redisCommand(_redis_context, "AUTH %s", _redis_password.CStr());
-		if (reply == nullptr || reply->type == REDIS_REPLY_ERROR)
+		if ((_subscriber->Connect(false) == false) ||
+			(_subscriber->Command({"SUBSCRIBE", ORIGIN_MAP_CLIENT_CHANNEL}) == nullptr))
 		{
-			logte("Failed to auth to redis server. ip: %s, port: %d, err: %s", _redis_ip.CStr(), _redis_port, reply!=nullptr?reply->str:"nil");
+			_subscriber->Disconnect();
 
-			if (reply != nullptr)
+			// Retry after a while
+			for (int count = 0; (count < 10) && _is_running; count++)
 			{
-				freeReplyObject(reply);
+				std::this_thread::sleep_for(std::chrono::milliseconds(100));
 			}
-			
-			return false;
+
+			continue;
 		}
-	}
 
-	return true;
-}
+		{
+			// The notifications might have been missed while disconnected
+			std::lock_guard<std::mutex> lock(_cache_mutex);
+			_cache.clear();
+		}
 
-bool OriginMapClient::CheckConnection()
-{
-	if (_redis_context == nullptr)
-	{
-		return false;
-	}
+		while (_is_running)
+		{
+			// ["message", <channel>, <app/stream>]
+			auto reply = _subscriber->Receive();
+			if (reply == nullptr)
+			{
+				// Disconnected (or shut down)
+				break;
+			}
 
-	// Test with PING command
-	redisReply *reply = (redisReply *)redisCommand(_redis_context, "PING");
-	if (reply == nullptr)
-	{
-		return false;
+			if ((reply->type == REDIS_REPLY_ARRAY) && (reply->elements == 3) &&
+				(reply->element[0]->type == REDIS_REPLY_STRING) && (::strcmp(reply->element[0]->str, "message") == 0) &&
+				(reply->element[2]->type == REDIS_REPLY_STRING))
+			{
+				InvalidateCache(ov::String(reply->element[2]->str, reply->element[2]->len));
+			}
+		}
 	}
 
-	return true;
+	_subscriber->Disconnect();
 }
@@ -11,7 +11,26 @@
 #include <base/common_types.h>
 #include <base/ovlibrary/ovlibrary.h>
 #include <base/ovlibrary/delay_queue.h>
-#include <hiredis/hiredis.h>
+
+#include <condition_variable>
+
+#include "redis_connection.h"
+
+// Number of the connections to the redis server (the requests of the different threads are sent in parallel)
+#define ORIGIN_MAP_CLIENT_CONNECTION_POOL_SIZE 4
+
+// The entries expire after this time unless they are refreshed (to release app/stream when OvenMediaEngine unexpectedly stops)
+#define ORIGIN_MAP_CLIENT_EXPIRE_SEC 10
+#define ORIGIN_MAP_CLIENT_UPDATE_INTERVAL_MS 2500
+// Maximum number of the commands sent in a pipeline
+#define ORIGIN_MAP_CLIENT_MAX_PIPELINE_COMMANDS 1000
+
+// The results of GetOrigin() are cached for this time. The cached entries are invalidated by the notifications of
+// Register()/Unregister(), so this only bounds the staleness when there is no notification (ex: an origin stopped unexpectedly).
+#define ORIGIN_MAP_CLIENT_CACHE_TTL_MS 2000
+#define ORIGIN_MAP_CLIENT_MAX_CACHE_ENTRIES 10000
+// The channel notifying the changed app/stream names
+#define ORIGIN_MAP_CLIENT_CHANNEL "ome:origin_map"
 
 // If Origins-Edges cluster uses OriginMapStore, app/stream must be unique in the cluster.
 class OriginMapClient
@@ -20,6 +39,7 @@ public:
 	// redis_host: redis server host (ex: 192.168.0.160:6379)
 	// redis_password: redis server password (ex: password!@#)
 	OriginMapClient(const ov::String &redis_host, const ov::String &redis_password);
+	~OriginMapClient();
 
 	// if return false, it means that the app_stream_name is already registered from other origin server
 	// app_stream_name : app/stream name (ex: app/stream)
@@ -31,20 +51,43 @@ public:
 	CommonErrorCode GetOrigin(const ov::String &app_stream_name, ov::String &origin_host);
 
 private:
-	bool CheckConnection();
-	bool ConnectRedis();
+	struct CacheItem
+	{
+		// NOT_FOUND is also cached
+		CommonErrorCode result;
+		ov::String origin_host;
+		int64_t expire_time_ms;
+	};
 
+	// Sends the commands using a connection of the pool
+	bool Execute(const std::vector<RedisCommand> &commands, std::vector<RedisReply> *replies);
+
+	// Refreshes the expiration of all the registered streams (in a round trip per ORIGIN_MAP_CLIENT_MAX_PIPELINE_COMMANDS)
 	bool NofifyStreamsAlive();
 
+	void InvalidateCache(const ov::String &app_stream_name);
+	void SubscriberThread();
+
 	ov::String _redis_ip;
-	uint16_t _redis_port;
+	uint16_t _redis_port = 0;
 	ov::String _redis_password;
 
 	ov::DelayQueue _update_timer{"OriginMapClient"};
 
+	// Streams registered by this server
 	std::map<ov::String, ov::String> _origin_map;
 	std::mutex _origin_map_mutex;
 
-	redisContext *_redis_context = nullptr;
-	std::mutex _redis_context_mutex;
-};
\ No newline at end of file
+	std::vector<std::shared_ptr<RedisConnection>> _idle_connections;
+	std::mutex _connection_pool_mutex;
+	std::condition_variable _connection_pool_condition;
+
+	// Results of GetOrigin()
+	std::unordered_map<ov::String, CacheItem> _cache;
+	std::mutex _cache_mutex;
+
+	// Receives the notifications of the other servers to invalidate _cache
+	std::shared_ptr<RedisConnection> _subscriber;
+	std::thread _subscriber_thread;
+	std::atomic<bool> _is_running{false};
+};
@@ -0,0 +1,203 @@
+//==============================================================================
+//
+//  OvenMediaEngine
+//
+//  Created by Getroot
+//  Copyright (c) 2022 AirenSoft. All rights reserved.
+//
+//==============================================================================
+#include "redis_connection.h"
+
+#include <sys/socket.h>
+
+#define OV_LOG_TAG "OriginMapClient"
+
+static struct timeval MillisecondsToTimeval(int64_t msec)
+{
+	return {static_cast<time_t>(msec / 1000), static_cast<suseconds_t>((msec % 1000) * 1000)};
+}
+
+RedisConnection::RedisConnection(const ov::String &ip, uint16_t port, const ov::String &password)
+	: _ip(ip),
+	  _port(port),
+	  _password(password)
+{
+}
+
+RedisConnection::~RedisConnection()
+{
+	Disconnect();
+}
+
+bool RedisConnection::Connect(bool use_command_timeout)
+{
+	if ((_context != nullptr) && (_context->err == 0))
+	{
+		return true;
+	}
+
+	Disconnect();
+
+	auto context = redisConnectWithTimeout(_ip.CStr(), _port, MillisecondsToTimeval(REDIS_CONNECT_TIMEOUT_MS));
+	if ((context == nullptr) || (context->err != 0))
+	{
+		_last_error = (context != nullptr) ? context->errstr : "Could not allocate redis context";
+		logte("Failed to connect to redis server. ip: %s, port: %d, err: %s", _ip.CStr(), _port, _last_error.CStr());
+
+		if (context != nullptr)
+		{
+			redisFree(context);
+		}
+
+		return false;
+	}
+
+	if (use_command_timeout)
+	{
+		redisSetTimeout(context, MillisecondsToTimeval(REDIS_COMMAND_TIMEOUT_MS));
+	}
+
+	{
+		std::lock_guard<std::mutex> lock(_context_mutex);
+
+		if (_is_shutdown)
+		{
+			redisFree(context);
+			_last_error = "The connection is shut down";
+			return false;
+		}
+
+		_context = context;
+	}
+
+	// Auth
+	if (_password.IsEmpty() == false)
+	{
+		auto reply = Command({"AUTH", _password});
+		if ((reply == nullptr) || (reply->type == REDIS_REPLY_ERROR))
+		{
+			logte("Failed to auth to redis server. ip: %s, port: %d, err: %s", _ip.CStr(), _port, (reply != nullptr) ? reply->str : _last_error.CStr());
+
+			Disconnect();
+			return false;
+		}
+	}
+
+	return true;
+}
+
+void RedisConnection::Disconnect()
+{
+	std::lock_guard<std::mutex> lock(_context_mutex);
+
+	if (_context != nullptr)
+	{
+		redisFree(_context);
+		_context = nullptr;
+	}
+}
+
+void RedisConnection::Shutdown()
+{
+	std::lock_guard<std::mutex> lock(_context_mutex);
+
+	_is_shutdown = true;
+
+	if (_context != nullptr)
+	{
+		::shutdown(_context->fd, SHUT_RDWR);
+	}
+}
+
+const ov::String &RedisConnection::GetError() const
+{
+	return _last_error;
+}
+
+bool RedisConnection::AppendCommand(const RedisCommand &command)
+{
+	std::vector<const char *> argv;
+	std::vector<size_t> argv_length;
+
+	argv.reserve(command.size());
+	argv_length.reserve(command.size());
+
+	for (const auto &argument : command)
+	{
+		argv.push_back(argument.CStr());
+		argv_length.push_back(argument.GetLength());
+	}
+
+	if (redisAppendCommandArgv(_context, static_cast<int>(argv.size()), argv.data(), argv_length.data()) != REDIS_OK)
+	{
+		_last_error = _context->errstr;
+		return false;
+	}
+
+	return true;
+}
+
+bool RedisConnection::Pipeline(const std::vector<RedisCommand> &commands, std::vector<RedisReply> *replies)
+{
+	if (Connect() == false)
+	{
+		return false;
+	}
+
+	for (const auto &command : commands)
+	{
+		if (AppendCommand(command) == false)
+		{
+			Disconnect();
+			return false;
+		}
+	}
+
+	// The commands are flushed by the first redisGetReply()
+	replies->reserve(replies->size() + commands.size());
+
+	for (size_t index = 0; index < commands.size(); index++)
+	{
+		auto reply = Receive();
+		if (reply == nullptr)
+		{
+			return false;
+		}
+
+		replies->push_back(reply);
+	}
+
+	return true;
+}
+
+RedisReply RedisConnection::Command(const RedisCommand &command)
+{
+	std::vector<RedisReply> replies;
+
+	if (Pipeline({command}, &replies) == false)
+	{
+		return nullptr;
+	}
+
+	return replies[0];
+}
+
+RedisReply RedisConnection::Receive()
+{
+	if (_context == nullptr)
+	{
+		return nullptr;
+	}
+
+	void *reply = nullptr;
+
+	if (redisGetReply(_context, &reply) != REDIS_OK)
+	{
+		// The connection cannot be used after an error (including a timeout)
+		_last_error = _context->errstr;
+		Disconnect();
+		return nullptr;
+	}
+
+	return RedisReply(static_cast<redisReply *>(reply), freeReplyObject);
+}
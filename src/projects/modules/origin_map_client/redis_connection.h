@@ -0,0 +1,55 @@
+//==============================================================================
+//
+//  OvenMediaEngine
+//
+//  Created by Getroot
+//  Copyright (c) 2022 AirenSoft. All rights reserved.
+//
+//==============================================================================
+#pragma once
+
+#include <base/ovlibrary/ovlibrary.h>
+#include <hiredis/hiredis.h>
+
+#define REDIS_CONNECT_TIMEOUT_MS 1000
+#define REDIS_COMMAND_TIMEOUT_MS 1000
+
+// Arguments of a command (ex: {"SET", "app/stream", "ovt://..."}), so the arguments don't need to be escaped
+using RedisCommand = std::vector<ov::String>;
+using RedisReply = std::shared_ptr<redisReply>;
+
+// A blocking connection to the redis server, which is reconnected on the next request after an error
+class RedisConnection
+{
+public:
+	RedisConnection(const ov::String &ip, uint16_t port, const ov::String &password);
+	~RedisConnection();
+
+	// Sends all the commands at once and receives the replies in one round trip (pipelining)
+	bool Pipeline(const std::vector<RedisCommand> &commands, std::vector<RedisReply> *replies);
+	RedisReply Command(const RedisCommand &command);
+
+	// Waits for a reply (ex: a message of the subscribed channel)
+	RedisReply Receive();
+
+	// use_command_timeout: false for the connection waiting for the messages (ex: SUBSCRIBE)
+	bool Connect(bool use_command_timeout = true);
+	void Disconnect();
+	// Wakes up the thread waiting for a reply, and the connection is not connected anymore (can be called by another thread)
+	void Shutdown();
+
+	const ov::String &GetError() const;
+
+private:
+	bool AppendCommand(const RedisCommand &command);
+
+	ov::String _ip;
+	uint16_t _port;
+	ov::String _password;
+
+	// Only the thread using the connection connects/disconnects it, and this guards _context against Shutdown()
+	std::mutex _context_mutex;
+	redisContext *_context = nullptr;
+	bool _is_shutdown = false;
+	ov::String _last_error;
+};
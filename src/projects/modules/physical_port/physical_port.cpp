@@ -75,7 +75,9 @@ bool PhysicalPort::Create(const char *name,
 						  const ov::SocketAddress &address,
 						  int worker_count,
 						  int send_buffer_size,
-						  int recv_buffer_size)
+						  int recv_buffer_size,
+						  bool reuse_port,
+						  bool cpu_steering)
 {
 	if ((_server_socket != nullptr) || (_datagram_socket != nullptr))
 	{
@@ -83,18 +85,22 @@ bool PhysicalPort::Create(const char *name,
 		OV_ASSERT2((_server_socket == nullptr) && (_datagram_socket == nullptr));
 	}
 
-	logtd("Trying to start physical port [%s] on %s/%s (worker: %d, send_buffer_size: %d, recv_buffer_size: %d)...",
+	logtd("Trying to start physical port [%s] on %s/%s (worker: %d, send_buffer_size: %d, recv_buffer_size: %d, reuse_port: %s, cpu_steering: %s)...",
 		  name,
 		  address.ToString().CStr(), ov::StringFromSocketType(type),
-		  worker_count, send_buffer_size, recv_buffer_size);
+		  worker_count, send_buffer_size, recv_buffer_size,
+		  reuse_port ? "true" : "false", cpu_steering ? "true" : "false");
 
 	bool result = false;
 
 	switch (type)
 	{
 		case ov::SocketType::Srt:
+			result = CreateServerSocket(name, type, address, worker_count, send_buffer_size, recv_buffer_size, false, false);
+			break;
+
 		case ov::SocketType::Tcp:
-			result = CreateServerSocket(name, type, address, worker_count, send_buffer_size, recv_buffer_size);
+			result = CreateServerSocket(name, type, address, worker_count, send_buffer_size, recv_buffer_size, reuse_port, cpu_steering);
 			break;
 
 		case ov::SocketType::Udp:
@@ -115,7 +121,9 @@ bool PhysicalPort::CreateServerSocket(
 	const ov::SocketAddress &address,
 	int worker_count,
 	int send_buffer_size,
-	int recv_buffer_size)
+	int recv_buffer_size,
+	bool reuse_port,
+	bool cpu_steering)
 {
 	_socket_pool = ov::SocketPool::Create(GetSocketPoolName(type, name, address), type);
 
@@ -123,26 +131,24 @@ bool PhysicalPort::CreateServerSocket(
 	{
 		if (_socket_pool->Initialize(worker_count))
 		{
-			auto socket = _socket_pool->AllocSocket<ov::ServerSocket>(address.GetFamily(), _socket_pool);
+			_type = type;
+			_address = address;
 
-			if (socket != nullptr)
+			if (reuse_port)
 			{
-				if (socket->Prepare(
-						address,
-						std::bind(&PhysicalPort::OnClientConnectionStateChanged, this,
-								  std::placeholders::_1, std::placeholders::_2, std::placeholders::_3),
-						std::bind(&PhysicalPort::OnClientData, this,
-								  std::placeholders::_1, std::placeholders::_2),
-						send_buffer_size, recv_buffer_size, 4096))
+				if (CreateReusePortServerSockets(address, send_buffer_size, recv_buffer_size, cpu_steering))
 				{
-					_type = type;
-					_server_socket = socket;
-					_address = address;
-
 					return true;
 				}
 
-				_socket_pool->ReleaseSocket(socket);
+				logtw("Could not create SO_REUSEPORT listeners for %s, a single listener will be used", address.ToString().CStr());
+			}
+
+			_server_socket = PrepareServerSocket(nullptr, address, send_buffer_size, recv_buffer_size, false);
+
+			if (_server_socket != nullptr)
+			{
+				return true;
 			}
 
 			OV_SAFE_RESET(_socket_pool, nullptr, _socket_pool->Uninitialize(), _socket_pool);
@@ -156,6 +162,78 @@ bool PhysicalPort::CreateServerSocket(
 	return false;
 }
 
+std::shared_ptr<ov::ServerSocket> PhysicalPort::PrepareServerSocket(const std::shared_ptr<ov::SocketPoolWorker> &worker,
+																	 const ov::SocketAddress &address,
+																	 int send_buffer_size,
+																	 int recv_buffer_size,
+																	 bool reuse_port)
+{
+	auto socket = (worker != nullptr)
+					  ? _socket_pool->AllocSocketOnWorker<ov::ServerSocket>(worker, address.GetFamily(), _socket_pool)
+					  : _socket_pool->AllocSocket<ov::ServerSocket>(address.GetFamily(), _socket_pool);
+
+	if (socket != nullptr)
+	{
+		socket->SetReusePort(reuse_port);
+
+		if (socket->Prepare(
+				address,
+				std::bind(&PhysicalPort::OnClientConnectionStateChanged, this,
+						  std::placeholders::_1, std::placeholders::_2, std::placeholders::_3),
+				std::bind(&PhysicalPort::OnClientData, this,
+						  std::placeholders::_1, std::placeholders::_2),
+				send_buffer_size, recv_buffer_size, 4096))
+		{
+			return socket;
+		}
+
+		_socket_pool->ReleaseSocket(socket);
+	}
+
+	return nullptr;
+}
+
+bool PhysicalPort::CreateReusePortServerSockets(const ov::SocketAddress &address,
+												int send_buffer_size,
+												int recv_buffer_size,
+												bool cpu_steering)
+{
+	auto worker_count = _socket_pool->GetWorkerCount();
+
+	for (int index = 0; index < worker_count; index++)
+	{
+		auto socket = PrepareServerSocket(_socket_pool->GetWorker(index), address, send_buffer_size, recv_buffer_size, true);
+
+		if (socket == nullptr)
+		{
+			// Rollback
+			for (auto &server_socket : _server_socket_list)
+			{
+				_socket_pool->ReleaseSocket(server_socket);
+			}
+
+			_server_socket_list.clear();
+
+			return false;
+		}
+
+		_server_socket_list.push_back(socket);
+	}
+
+	_server_socket = _server_socket_list.front();
+
+	// The listener[N] is placed at the index N of the SO_REUSEPORT group, since they are listened in order
+	if (cpu_steering && (_server_socket->AttachCpuSteeringProgram(worker_count) == false))
+	{
+		// Use the default (hash of the 4-tuple)
+		logtw("Could not attach CPU steering program to %s, connections will be distributed by hash", address.ToString().CStr());
+	}
+
+	logtd("%d SO_REUSEPORT listeners are created for %s", worker_count, address.ToString().CStr());
+
+	return true;
+}
+
 bool PhysicalPort::CreateDatagramSocket(
 	const char *name,
 	ov::SocketType type,
@@ -277,14 +355,28 @@ void PhysicalPort::OnDatagram(const std::shared_ptr<ov::DatagramSocket> &client,
 
 bool PhysicalPort::Close()
 {
-	auto socket = GetSocket();
-
-	if (socket != nullptr)
+	if (_server_socket_list.empty() == false)
 	{
-		_socket_pool->ReleaseSocket(socket);
+		for (auto &server_socket : _server_socket_list)
+		{
+			_socket_pool->ReleaseSocket(server_socket);
+		}
+
+		_server_socket_list.clear();
 
 		_server_socket = nullptr;
-		_datagram_socket = nullptr;
+	}
+	else
+	{
+		auto socket = GetSocket();
+
+		if (socket != nullptr)
+		{
+			_socket_pool->ReleaseSocket(socket);
+
+			_server_socket = nullptr;
+			_datagram_socket = nullptr;
+		}
 	}
 
 	_socket_pool->Uninitialize();
@@ -373,6 +465,11 @@ ov::String PhysicalPort::ToString() const
 		description.AppendFormat(", socket: %s", _server_socket->ToString().CStr());
 	}
 
+	if (_server_socket_list.empty() == false)
+	{
+		description.AppendFormat(", reuse_port: %zu listeners", _server_socket_list.size());
+	}
+
 	description.Append('>');
 
 	return description;
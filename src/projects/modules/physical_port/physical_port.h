@@ -32,12 +32,16 @@ public:
 
 	virtual ~PhysicalPort();
 
+	// reuse_port: (TCP only) Each worker accepts connections with its own SO_REUSEPORT listener
+	// cpu_steering: Selects the listener by the CPU that received the connection (requires reuse_port)
 	bool Create(const char *name,
 				ov::SocketType type,
 				const ov::SocketAddress &address,
 				int worker_count,
 				int send_buffer_size,
-				int recv_buffer_size);
+				int recv_buffer_size,
+				bool reuse_port = false,
+				bool cpu_steering = false);
 
 	bool Close();
 
@@ -76,6 +80,11 @@ public:
 		return _socket_pool->GetWorkerCount();
 	}
 
+	bool IsReusePortEnabled() const
+	{
+		return _server_socket_list.empty() == false;
+	}
+
 	bool AddObserver(PhysicalPortObserver *observer);
 
 	bool RemoveObserver(PhysicalPortObserver *observer);
@@ -88,7 +97,20 @@ protected:
 							const ov::SocketAddress &address,
 							int worker_count,
 							int send_buffer_size,
-							int recv_buffer_size);
+							int recv_buffer_size,
+							bool reuse_port,
+							bool cpu_steering);
+
+	std::shared_ptr<ov::ServerSocket> PrepareServerSocket(const std::shared_ptr<ov::SocketPoolWorker> &worker,
+														  const ov::SocketAddress &address,
+														  int send_buffer_size,
+														  int recv_buffer_size,
+														  bool reuse_port);
+	// Creates a SO_REUSEPORT listener for each worker
+	bool CreateReusePortServerSockets(const ov::SocketAddress &address,
+									  int send_buffer_size,
+									  int recv_buffer_size,
+									  bool cpu_steering);
 
 	bool CreateDatagramSocket(const char *name,
 							  ov::SocketType type,
@@ -107,7 +129,10 @@ protected:
 	ov::SocketType _type = ov::SocketType::Unknown;
 	ov::SocketAddress _address;
 
+	// The first listener if SO_REUSEPORT is used
 	std::shared_ptr<ov::ServerSocket> _server_socket;
+	// Listeners for each worker (SO_REUSEPORT)
+	std::vector<std::shared_ptr<ov::ServerSocket>> _server_socket_list;
 	std::shared_ptr<ov::DatagramSocket> _datagram_socket;
 
 	std::atomic<int> _ref_count{0};
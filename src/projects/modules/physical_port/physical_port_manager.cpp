@@ -8,6 +8,8 @@
 //==============================================================================
 #include "physical_port_manager.h"
 
+#include <config/config_manager.h>
+
 #include "physical_port_private.h"
 
 PhysicalPortManager::PhysicalPortManager()
@@ -40,7 +42,19 @@ std::shared_ptr<PhysicalPort> PhysicalPortManager::CreatePort(const char *name,
 	{
 		port = std::make_shared<PhysicalPort>(PhysicalPort::PrivateToken{nullptr});
 
-		if (port->Create(name, type, address, worker_count, send_buffer_size, recv_buffer_size))
+		bool reuse_port = false;
+		bool cpu_steering = false;
+
+		auto server_config = cfg::ConfigManager::GetInstance()->GetServer();
+		if (server_config != nullptr)
+		{
+			auto &reuse_port_config = server_config->GetModules().GetReusePort();
+
+			reuse_port = reuse_port_config.IsEnabled();
+			cpu_steering = reuse_port_config.IsCpuSteeringEnabled();
+		}
+
+		if (port->Create(name, type, address, worker_count, send_buffer_size, recv_buffer_size, reuse_port, cpu_steering))
 		{
 			_port_list[key] = port;
 		}
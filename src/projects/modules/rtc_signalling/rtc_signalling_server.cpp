@@ -213,6 +213,7 @@ bool RtcSignallingServer::Start(
 	}
 
 	auto http_server_manager = http::svr::HttpServerManager::GetInstance();
+	auto per_message_deflate = _webrtc_bind_cfg.GetSignalling().IsPerMessageDeflateEnabled();
 
 	std::vector<std::shared_ptr<http::svr::HttpServer>> http_server_list;
 	std::vector<std::shared_ptr<http::svr::HttpsServer>> https_server_list;
@@ -226,6 +227,7 @@ bool RtcSignallingServer::Start(
 			nullptr, false,
 			[&](const ov::SocketAddress &address, bool is_https, const std::shared_ptr<http::svr::HttpServer> &http_server) {
 				http_server->AddInterceptor(interceptor);
+				http_server->SetWebSocketCompressionEnabled(per_message_deflate);
 			},
 			worker_count))
 	{
@@ -283,8 +283,15 @@ bool RtmpWriter::AddTrack(cmn::MediaType media_type, int32_t track_id, std::shar
 //	- H264 : AnnexB bitstream
 // 	- AAC : ASC(Audio Specific Config) bitstream
 
-bool RtmpWriter::PutData(int32_t track_id, int64_t pts, int64_t dts, MediaPacketFlag flag, cmn::BitstreamFormat format, std::shared_ptr<ov::Data> &data)
+bool RtmpWriter::PutData(const std::shared_ptr<const MediaPacket> &media_packet)
 {
+	auto track_id = media_packet->GetTrackId();
+	auto pts = media_packet->GetPts();
+	auto dts = media_packet->GetDts();
+	auto flag = media_packet->GetFlag();
+	auto format = media_packet->GetBitstreamFormat();
+	auto data = media_packet->GetData();
+
 	std::unique_lock<std::mutex> mlock(_lock);
 
 	if (_format_context == nullptr)
@@ -320,7 +327,6 @@ bool RtmpWriter::PutData(int32_t track_id, int64_t pts, int64_t dts, MediaPacket
 	av_packet.dts = av_rescale_q(dts, AVRational{track_info->GetTimeBase().GetNum(), track_info->GetTimeBase().GetDen()}, stream->time_base);
 
 	std::shared_ptr<const ov::Data> cdata = data;
-	std::vector<size_t> length_list;
 
 	if (strcmp(_format_context->oformat->name, "flv") == 0)
 	{
@@ -332,7 +338,7 @@ bool RtmpWriter::PutData(int32_t track_id, int64_t pts, int64_t dts, MediaPacket
 				break;
 
 			case cmn::BitstreamFormat::H264_ANNEXB:
-				cdata = H264Converter::ConvertAnnexbToAvcc(cdata);
+				cdata = H264Converter::GetAvccView(media_packet)->GetData();
 				av_packet.size = cdata->GetLength();
 				av_packet.data = (uint8_t *)cdata->GetDataAs<uint8_t>();
 				break;
@@ -343,7 +349,7 @@ bool RtmpWriter::PutData(int32_t track_id, int64_t pts, int64_t dts, MediaPacket
 				break;
 
 			case cmn::BitstreamFormat::AAC_ADTS:
-				cdata = AacConverter::ConvertAdtsToRaw(cdata, &length_list);
+				cdata = AacConverter::GetRawView(media_packet)->GetData();
 				av_packet.size = cdata->GetLength();
 				av_packet.data = (uint8_t *)cdata->GetDataAs<uint8_t>();
 				break;
@@ -363,7 +369,7 @@ bool RtmpWriter::PutData(int32_t track_id, int64_t pts, int64_t dts, MediaPacket
 				break;
 
 			case cmn::BitstreamFormat::AAC_ADTS:
-				cdata = AacConverter::ConvertAdtsToRaw(cdata, &length_list);
+				cdata = AacConverter::GetRawView(media_packet)->GetData();
 				av_packet.size = cdata->GetLength();
 				av_packet.data = (uint8_t *)cdata->GetDataAs<uint8_t>();
 				break;
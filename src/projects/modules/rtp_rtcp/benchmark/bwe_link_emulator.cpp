@@ -0,0 +1,567 @@
+//==============================================================================
+//
+//  OvenMediaEngine
+//
+//  Created by Getroot
+//  Copyright (c) 2022 AirenSoft. All rights reserved.
+//
+//==============================================================================
+//
+// Standalone bottleneck-link emulator that drives RtpPacer and SendSideBandwidthEstimator in simulated time,
+// in the same way as RtcSession does. It is not a part of the OME build. Build and run it from src/projects:
+//
+//   g++ -std=c++17 -O2 -ffunction-sections -fdata-sections -Wl,--gc-sections -I. -Ithird_party \
+//       modules/rtp_rtcp/benchmark/bwe_link_emulator.cpp modules/rtp_rtcp/rtp_pacer.cpp \
+//       modules/rtp_rtcp/send_side_bandwidth_estimator.cpp modules/rtp_rtcp/rtp_packet.cpp base/ovlibrary/*.cpp \
+//       -o /tmp/bwe_link_emulator -lpthread -lssl -lcrypto -lz -lpcre2-8 && /tmp/bwe_link_emulator
+//
+// Sender (like RtcSession):
+//   - 30 fps video of the selected rendition (a keyframe every 2 seconds) and 50 pps audio go through the pacer
+//   - The pacing bitrate is RTC_PACING_FACTOR x the estimate (at least RTC_MIN_PACING_BITRATE)
+//   - The rendition is changed every second in the same way as RtcSession::ChangeRenditionIfNeeded()
+//   - The lost video packets reported by the feedback are retransmitted with the retransmission priority (as NACK)
+// Link:
+//   - A drop-tail bottleneck queue (-q) served at the capacity of the schedule (-c), random loss (-l),
+//     and one-way propagation delay (-d) for both the media and the feedback
+// Receiver:
+//   - Sends a transport-wide feedback every 100 ms
+//
+// The default reproduces a 3 Mbps link dropping to 1 Mbps and recovering, with 40 ms delay and 1% loss.
+//
+#include <base/ovlibrary/ovlibrary.h>
+#include <modules/rtp_rtcp/rtp_pacer.h>
+#include <modules/rtp_rtcp/send_side_bandwidth_estimator.h>
+#include <publishers/webrtc/rtc_common_types.h>
+
+#include <random>
+
+#define BWE_EMULATOR_FPS 30
+#define BWE_EMULATOR_GOP_FRAMES 60
+// Size of a keyframe compared to the other frames
+#define BWE_EMULATOR_KEYFRAME_RATIO 5
+#define BWE_EMULATOR_MAX_PAYLOAD_SIZE 1200
+#define BWE_EMULATOR_AUDIO_INTERVAL_MS 20
+#define BWE_EMULATOR_AUDIO_PAYLOAD_SIZE 160
+#define BWE_EMULATOR_FEEDBACK_INTERVAL_MS 100
+#define BWE_EMULATOR_ABR_INTERVAL_MS 1000
+
+namespace
+{
+	struct Options
+	{
+		// (time in ms, capacity in bps)
+		std::vector<std::pair<int64_t, int64_t>> capacity_schedule{{0, 3000 * 1000}, {20000, 1000 * 1000}, {40000, 3000 * 1000}};
+		int64_t delay_ms = 40;
+		double loss_rate = 0.01;
+		int64_t queue_limit_ms = 300;
+		int64_t duration_ms = 60000;
+		int64_t report_interval_ms = 1000;
+		std::vector<uint32_t> renditions_bps{500 * 1000, 1500 * 1000, 2500 * 1000};
+		uint32_t seed = 1;
+	};
+
+	struct SentPacket
+	{
+		int64_t send_time_us = 0;
+		// -1 if the packet is lost
+		int64_t arrival_time_us = -1;
+		size_t size = 0;
+		bool is_video = false;
+		bool is_retransmission = false;
+	};
+
+	struct Feedback
+	{
+		int64_t delivery_time_ms = 0;
+		std::vector<SendSideBandwidthEstimator::PacketResult> results;
+		size_t lost_video_packet_count = 0;
+	};
+
+	class Emulator
+	{
+	public:
+		explicit Emulator(const Options &options)
+			: _options(options),
+			  _random(options.seed),
+			  _bwe(options.renditions_bps.front()),
+			  _pacer(RTC_MIN_PACING_BITRATE)
+		{
+			_rendition_records.resize(options.renditions_bps.size());
+			_estimated_bitrate = _bwe.GetTargetBitrate();
+
+			UpdatePacingBitrate();
+		}
+
+		void Run()
+		{
+			printf("%8s %9s %9s %9s %9s %9s %9s %7s %9s %9s %s\n",
+				   "time(ms)", "link", "target", "acked", "rendition", "sent", "pacing", "loss", "linkq(ms)", "pacerq(ms)", "usage");
+
+			for (int64_t now_ms = 0; now_ms < _options.duration_ms; now_ms++)
+			{
+				GenerateMedia(now_ms);
+				DeliverFeedbacks(now_ms);
+				ProcessPacer(now_ms);
+				SendFeedback(now_ms);
+
+				if ((now_ms % BWE_EMULATOR_ABR_INTERVAL_MS) == (BWE_EMULATOR_ABR_INTERVAL_MS - 1))
+				{
+					ChangeRenditionIfNeeded(now_ms);
+				}
+
+				AccumulateStats(now_ms);
+
+				if ((now_ms % _options.report_interval_ms) == (_options.report_interval_ms - 1))
+				{
+					Report(now_ms);
+				}
+			}
+
+			PrintSummary();
+		}
+
+	private:
+		int64_t GetCapacityBps(int64_t now_ms) const
+		{
+			int64_t capacity_bps = _options.capacity_schedule.front().second;
+
+			for (auto &item : _options.capacity_schedule)
+			{
+				if (item.first <= now_ms)
+				{
+					capacity_bps = item.second;
+				}
+			}
+
+			return capacity_bps;
+		}
+
+		void EnqueueVideo(size_t bytes, int64_t now_ms)
+		{
+			while (bytes > 0)
+			{
+				auto payload_size = std::min<size_t>(bytes, BWE_EMULATOR_MAX_PAYLOAD_SIZE);
+				bytes -= payload_size;
+
+				auto packet = std::make_shared<RtpPacket>();
+				packet->SetSequenceNumber(_video_sequence_number++);
+				packet->AllocatePayload(payload_size);
+
+				_pacer.Enqueue(packet, packet->SequenceNumber(), RtpPacer::Priority::Video, now_ms);
+			}
+		}
+
+		void GenerateMedia(int64_t now_ms)
+		{
+			// Frame boundaries of 30 fps in ms
+			if (((now_ms * BWE_EMULATOR_FPS) / 1000) != (((now_ms - 1) * BWE_EMULATOR_FPS) / 1000) || (now_ms == 0))
+			{
+				auto bitrate = static_cast<double>(_options.renditions_bps[_rendition_index]);
+				auto gop_bytes = (bitrate / 8.0) * BWE_EMULATOR_GOP_FRAMES / BWE_EMULATOR_FPS;
+				auto frame_bytes = gop_bytes / (BWE_EMULATOR_GOP_FRAMES - 1 + BWE_EMULATOR_KEYFRAME_RATIO);
+				bool is_keyframe = ((_frame_count % BWE_EMULATOR_GOP_FRAMES) == 0);
+
+				EnqueueVideo(static_cast<size_t>(frame_bytes * (is_keyframe ? BWE_EMULATOR_KEYFRAME_RATIO : 1)), now_ms);
+				_frame_count++;
+			}
+
+			if ((now_ms % BWE_EMULATOR_AUDIO_INTERVAL_MS) == 0)
+			{
+				auto packet = std::make_shared<RtpPacket>();
+				packet->AllocatePayload(BWE_EMULATOR_AUDIO_PAYLOAD_SIZE);
+
+				_pacer.Enqueue(packet, 0, RtpPacer::Priority::Audio, now_ms);
+			}
+		}
+
+		// Sends a packet to the bottleneck link
+		void SendToLink(const RtpPacer::Item &item, int64_t now_ms)
+		{
+			auto now_us = now_ms * 1000;
+			auto size = item.packet->GetData()->GetLength();
+
+			SentPacket sent;
+			sent.send_time_us = now_us;
+			sent.size = size;
+			sent.is_video = (item.priority != RtpPacer::Priority::Audio);
+			sent.is_retransmission = (item.priority == RtpPacer::Priority::Retransmission);
+
+			_sent_bytes_in_interval += size;
+
+			auto queue_delay_us = std::max<int64_t>(0, _link_busy_until_us - now_us);
+
+			if ((queue_delay_us / 1000) > _options.queue_limit_ms)
+			{
+				// Drop-tail
+				_queue_drop_count++;
+			}
+			else if (std::uniform_real_distribution<double>(0.0, 1.0)(_random) < _options.loss_rate)
+			{
+				_random_drop_count++;
+			}
+			else
+			{
+				auto transmission_us = static_cast<int64_t>(size * 8 * 1000000 / GetCapacityBps(now_ms));
+				_link_busy_until_us = std::max(_link_busy_until_us, now_us) + transmission_us;
+
+				sent.arrival_time_us = _link_busy_until_us + (_options.delay_ms * 1000);
+
+				_max_queue_delay_us_in_interval = std::max(_max_queue_delay_us_in_interval, queue_delay_us);
+				_queue_delay_sum_us += queue_delay_us;
+				_delivered_bytes += size;
+				_delivered_packet_count++;
+			}
+
+			_sent_packets.push_back(sent);
+			_sent_packet_count++;
+		}
+
+		void ProcessPacer(int64_t now_ms)
+		{
+			RtpPacer::Item item;
+
+			while (_pacer.Pop(now_ms, &item))
+			{
+				SendToLink(item, now_ms);
+			}
+		}
+
+		// Receiver: reports every packet up to the last received one
+		void SendFeedback(int64_t now_ms)
+		{
+			if ((now_ms % BWE_EMULATOR_FEEDBACK_INTERVAL_MS) != 0)
+			{
+				return;
+			}
+
+			auto now_us = now_ms * 1000;
+
+			// The link is FIFO, so the packets arrive in the order of the transport-wide sequence number
+			size_t last_index = _sent_packets.size();
+			for (size_t index = 0; index < _sent_packets.size(); index++)
+			{
+				auto &packet = _sent_packets[index];
+
+				if (packet.arrival_time_us > now_us)
+				{
+					break;
+				}
+
+				if (packet.arrival_time_us >= 0)
+				{
+					last_index = index;
+				}
+			}
+
+			if (last_index == _sent_packets.size())
+			{
+				return;
+			}
+
+			Feedback feedback;
+			feedback.delivery_time_ms = now_ms + _options.delay_ms;
+
+			for (size_t index = 0; index <= last_index; index++)
+			{
+				auto &packet = _sent_packets[index];
+
+				SendSideBandwidthEstimator::PacketResult result;
+				result.send_time_us = packet.send_time_us;
+				result.receive_time_us = packet.arrival_time_us;
+				result.size = packet.size;
+				feedback.results.push_back(result);
+
+				if ((packet.arrival_time_us < 0) && packet.is_video && (packet.is_retransmission == false))
+				{
+					feedback.lost_video_packet_count++;
+				}
+			}
+
+			_sent_packets.erase(_sent_packets.begin(), _sent_packets.begin() + last_index + 1);
+			_feedbacks.push_back(std::move(feedback));
+		}
+
+		void DeliverFeedbacks(int64_t now_ms)
+		{
+			while ((_feedbacks.empty() == false) && (_feedbacks.front().delivery_time_ms <= now_ms))
+			{
+				auto &feedback = _feedbacks.front();
+
+				_bwe.OnTransportFeedback(feedback.results, now_ms);
+
+				_previous_estimated_bitrate = _estimated_bitrate;
+				_estimated_bitrate = _bwe.GetTargetBitrate();
+
+				UpdatePacingBitrate();
+
+				// NACK
+				for (size_t index = 0; index < feedback.lost_video_packet_count; index++)
+				{
+					auto packet = std::make_shared<RtpPacket>();
+					packet->AllocatePayload(BWE_EMULATOR_MAX_PAYLOAD_SIZE + 2);
+
+					_pacer.Enqueue(packet, 0, RtpPacer::Priority::Retransmission, now_ms);
+					_retransmission_count++;
+				}
+
+				_feedbacks.pop_front();
+			}
+		}
+
+		void UpdatePacingBitrate()
+		{
+			double pacing_bitrate = std::max<double>(_bwe.GetTargetBitrate() * RTC_PACING_FACTOR, RTC_MIN_PACING_BITRATE);
+			_pacer.SetPacingBitrate(static_cast<uint32_t>(std::min<double>(pacing_bitrate, UINT32_MAX)));
+		}
+
+		// Same as RtcSession::IsNextRenditionGoodChoice()
+		bool IsNextRenditionGoodChoice(size_t next_index, int64_t now_ms) const
+		{
+			if (next_index < _rendition_index)
+			{
+				if (_previous_estimated_bitrate < _estimated_bitrate)
+				{
+					// The bandwidth is getting higher, so let's wait
+					return false;
+				}
+
+				// We have switched to a higher rendition recently, so let's wait
+				return (_switched_to_higher_time_ms < 0) || ((now_ms - _switched_to_higher_time_ms) >= 10 * 1000);
+			}
+
+			auto &record = _rendition_records[next_index];
+
+			return (record.selected_count == 0) || ((now_ms - record.last_selected_time_ms) > (10 * 1000 * static_cast<int64_t>(record.selected_count)));
+		}
+
+		void SelectRendition(size_t index, int64_t now_ms)
+		{
+			bool is_higher = (index > _rendition_index);
+
+			_rendition_index = index;
+			_rendition_change_count++;
+
+			auto &record = _rendition_records[index];
+			record.selected_count++;
+			record.last_selected_time_ms = now_ms;
+
+			_switched_to_higher_time_ms = is_higher ? now_ms : -1;
+		}
+
+		// Same thresholds as RtcSession::ChangeRenditionIfNeeded()
+		void ChangeRenditionIfNeeded(int64_t now_ms)
+		{
+			auto current_bitrate = _options.renditions_bps[_rendition_index];
+
+			if ((1.1 * _estimated_bitrate <= current_bitrate) && (_rendition_index > 0))
+			{
+				if (IsNextRenditionGoodChoice(_rendition_index - 1, now_ms))
+				{
+					SelectRendition(_rendition_index - 1, now_ms);
+				}
+			}
+			else if ((0.75 * _estimated_bitrate > current_bitrate) && ((_rendition_index + 1) < _options.renditions_bps.size()))
+			{
+				if (IsNextRenditionGoodChoice(_rendition_index + 1, now_ms))
+				{
+					SelectRendition(_rendition_index + 1, now_ms);
+				}
+			}
+		}
+
+		void AccumulateStats(int64_t now_ms)
+		{
+			auto capacity_bps = GetCapacityBps(now_ms);
+			_capacity_bits += capacity_bps / 1000.0;
+
+			// Time to adapt: from a capacity drop until the estimate goes below the new capacity
+			if (capacity_bps < _last_capacity_bps)
+			{
+				_capacity_drop_time_ms = now_ms;
+			}
+
+			if ((_capacity_drop_time_ms >= 0) && (_bwe.GetTargetBitrate() <= capacity_bps))
+			{
+				printf("-- The estimate went below the capacity %.0f ms after the drop\n", static_cast<double>(now_ms - _capacity_drop_time_ms));
+				_capacity_drop_time_ms = -1;
+			}
+
+			_last_capacity_bps = capacity_bps;
+		}
+
+		void Report(int64_t now_ms)
+		{
+			auto interval_seconds = _options.report_interval_ms / 1000.0;
+			const char *usage = "normal";
+
+			switch (_bwe.GetBandwidthUsage())
+			{
+				case SendSideBandwidthEstimator::BandwidthUsage::Normal:
+					break;
+
+				case SendSideBandwidthEstimator::BandwidthUsage::Underusing:
+					usage = "underusing";
+					break;
+
+				case SendSideBandwidthEstimator::BandwidthUsage::Overusing:
+					usage = "overusing";
+					break;
+			}
+
+			printf("%8" PRId64 " %9" PRId64 " %9u %9u %9u %9.0f %9u %6.1f%% %9.1f %9" PRId64 " %s\n",
+				   now_ms + 1,
+				   GetCapacityBps(now_ms) / 1000,
+				   _bwe.GetTargetBitrate() / 1000,
+				   _bwe.GetAckedBitrate() / 1000,
+				   _options.renditions_bps[_rendition_index] / 1000,
+				   (_sent_bytes_in_interval * 8 / 1000.0) / interval_seconds,
+				   _pacer.GetPacingBitrate() / 1000,
+				   _bwe.GetLossRate() * 100.0,
+				   _max_queue_delay_us_in_interval / 1000.0,
+				   _pacer.GetQueueTimeMs(now_ms),
+				   usage);
+
+			_sent_bytes_in_interval = 0;
+			_max_queue_delay_us_in_interval = 0;
+		}
+
+		void PrintSummary() const
+		{
+			printf("\n");
+			printf("Link utilization      : %.1f%%\n", (_capacity_bits > 0.0) ? (_delivered_bytes * 8 * 100.0 / _capacity_bits) : 0.0);
+			printf("Mean queueing delay   : %.1f ms\n", (_delivered_packet_count > 0) ? (_queue_delay_sum_us / 1000.0 / _delivered_packet_count) : 0.0);
+			printf("Sent packets          : %" PRIu64 " (retransmissions: %" PRIu64 ")\n", _sent_packet_count, _retransmission_count);
+			printf("Dropped by the queue  : %" PRIu64 "\n", _queue_drop_count);
+			printf("Dropped randomly      : %" PRIu64 "\n", _random_drop_count);
+			printf("Rendition changes     : %" PRIu64 "\n", _rendition_change_count);
+		}
+
+		Options _options;
+		std::mt19937 _random;
+
+		SendSideBandwidthEstimator _bwe;
+		RtpPacer _pacer;
+
+		struct RenditionRecord
+		{
+			uint32_t selected_count = 0;
+			int64_t last_selected_time_ms = 0;
+		};
+
+		size_t _rendition_index = 0;
+		std::vector<RenditionRecord> _rendition_records;
+		int64_t _switched_to_higher_time_ms = -1;
+		double _estimated_bitrate = 0.0;
+		double _previous_estimated_bitrate = 0.0;
+		uint64_t _frame_count = 0;
+		uint16_t _video_sequence_number = 0;
+
+		// Link
+		int64_t _link_busy_until_us = 0;
+		std::deque<SentPacket> _sent_packets;
+		std::deque<Feedback> _feedbacks;
+
+		// Stats
+		uint64_t _sent_bytes_in_interval = 0;
+		int64_t _max_queue_delay_us_in_interval = 0;
+		double _capacity_bits = 0.0;
+		uint64_t _delivered_bytes = 0;
+		uint64_t _delivered_packet_count = 0;
+		double _queue_delay_sum_us = 0.0;
+		uint64_t _sent_packet_count = 0;
+		uint64_t _retransmission_count = 0;
+		uint64_t _queue_drop_count = 0;
+		uint64_t _random_drop_count = 0;
+		uint64_t _rendition_change_count = 0;
+		int64_t _last_capacity_bps = 0;
+		int64_t _capacity_drop_time_ms = -1;
+	};
+
+	// "0:3000,20000:1000" -> {{0, 3000000}, {20000, 1000000}}
+	bool ParseSchedule(const ov::String &value, std::vector<std::pair<int64_t, int64_t>> *schedule)
+	{
+		schedule->clear();
+
+		for (auto &item : value.Split(","))
+		{
+			auto tokens = item.Split(":");
+			if ((tokens.size() != 2) || (ov::Converter::ToInt64(tokens[1]) <= 0))
+			{
+				return false;
+			}
+
+			schedule->emplace_back(ov::Converter::ToInt64(tokens[0]), ov::Converter::ToInt64(tokens[1]) * 1000);
+		}
+
+		return (schedule->empty() == false);
+	}
+}  // namespace
+
+int main(int argc, char *argv[])
+{
+	Options options;
+
+	for (int index = 1; index < argc; index += 2)
+	{
+		ov::String option = argv[index];
+		ov::String value = ((index + 1) < argc) ? argv[index + 1] : "";
+		bool is_valid = (value.IsEmpty() == false);
+
+		if (option == "-c")
+		{
+			is_valid = is_valid && ParseSchedule(value, &options.capacity_schedule);
+		}
+		else if (option == "-d")
+		{
+			options.delay_ms = std::max<int64_t>(0, ov::Converter::ToInt64(value));
+		}
+		else if (option == "-l")
+		{
+			options.loss_rate = std::clamp(ov::Converter::ToDouble(value) / 100.0, 0.0, 1.0);
+		}
+		else if (option == "-q")
+		{
+			options.queue_limit_ms = std::max<int64_t>(1, ov::Converter::ToInt64(value));
+		}
+		else if (option == "-t")
+		{
+			options.duration_ms = std::max<int64_t>(1, ov::Converter::ToInt64(value));
+		}
+		else if (option == "-i")
+		{
+			options.report_interval_ms = std::max<int64_t>(1, ov::Converter::ToInt64(value));
+		}
+		else if (option == "-r")
+		{
+			options.renditions_bps.clear();
+			for (auto &item : value.Split(","))
+			{
+				options.renditions_bps.push_back(static_cast<uint32_t>(std::max<int64_t>(1, ov::Converter::ToInt64(item)) * 1000));
+			}
+			std::sort(options.renditions_bps.begin(), options.renditions_bps.end());
+		}
+		else if (option == "-s")
+		{
+			options.seed = static_cast<uint32_t>(ov::Converter::ToInt64(value));
+		}
+		else
+		{
+			is_valid = false;
+		}
+
+		if (is_valid == false)
+		{
+			printf("Usage: %s [-c <ms>:<kbps>,...] [-d <delay ms>] [-l <loss %%>] [-q <queue limit ms>] [-t <duration ms>]\n"
+				   "          [-i <report interval ms>] [-r <rendition kbps>,...] [-s <seed>]\n",
+				   argv[0]);
+			return 1;
+		}
+	}
+
+	ov_log_set_level(OVLogLevelWarning);
+
+	Emulator emulator(options);
+	emulator.Run();
+
+	return 0;
+}
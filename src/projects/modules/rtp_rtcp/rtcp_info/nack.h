@@ -62,6 +62,7 @@ public:
 	uint32_t GetMediaSsrc(){return _media_ssrc;}
 	void SetMediaSsrc(uint32_t ssrc){_media_ssrc = ssrc;}
 
+	void AddLostId(uint16_t id){_lost_ids.push_back(id);}
 	size_t GetLostIdCount(){return _lost_ids.size();}
 	uint16_t GetLostId(size_t index)
 	{
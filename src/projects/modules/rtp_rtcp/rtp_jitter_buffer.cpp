@@ -0,0 +1,502 @@
+//==============================================================================
+//
+//  OvenMediaEngine
+//
+//  Created by Getroot
+//  Copyright (c) 2022 AirenSoft. All rights reserved.
+//
+//==============================================================================
+#include "rtp_jitter_buffer.h"
+
+#define OV_LOG_TAG "RtpJitterBuffer"
+
+static_assert((RTP_JITTER_BUFFER_RING_SIZE & (RTP_JITTER_BUFFER_RING_SIZE - 1)) == 0, "RTP_JITTER_BUFFER_RING_SIZE must be a power of two");
+static_assert(RTP_JITTER_BUFFER_RING_SIZE * 2 < 0x8000, "RTP_JITTER_BUFFER_RING_SIZE is too large for the 16-bit sequence number");
+
+RtpJitterBuffer::RtpJitterBuffer(Mode mode, uint32_t clock_rate)
+	: _mode(mode),
+	  _clock_rate(clock_rate),
+	  _slots(RTP_JITTER_BUFFER_RING_SIZE)
+{
+}
+
+void RtpJitterBuffer::Reset(uint16_t head_sequence_number)
+{
+	for (auto &slot : _slots)
+	{
+		slot = Slot();
+	}
+
+	_head_sequence_number = head_sequence_number;
+	_window_size = 0;
+	_missing_count = 0;
+	_consecutive_old_packet_count = 0;
+
+	_is_gap_skipped = false;
+	_gap_size = 0;
+	_has_last_packet = false;
+	_is_discarding = false;
+}
+
+bool RtpJitterBuffer::InsertPacket(const std::shared_ptr<RtpPacket> &packet, int64_t now_ms)
+{
+	if (packet == nullptr)
+	{
+		return false;
+	}
+
+	auto sequence_number = packet->SequenceNumber();
+
+	if (_is_initialized == false)
+	{
+		Reset(sequence_number);
+		_is_initialized = true;
+	}
+
+	if ((_last_decay_time_ms >= 0) && (now_ms > _last_decay_time_ms))
+	{
+		_reorder_delay_ms = std::max(0.0, _reorder_delay_ms - ((now_ms - _last_decay_time_ms) * RTP_JITTER_BUFFER_REORDER_DELAY_DECAY_MS_PER_SECOND / 1000.0));
+	}
+	_last_decay_time_ms = now_ms;
+
+	uint16_t offset = sequence_number - _head_sequence_number;
+
+	if (offset >= 0x8000)
+	{
+		// Behind the window
+		auto &slot = GetSlot(sequence_number);
+
+		if (slot.sequence_number == sequence_number)
+		{
+			if (slot.state == SlotState::Lost)
+			{
+				// The packet was determined to be lost too early, so wait longer from now on
+				_late_packet_count++;
+				ObserveReorderDelay(now_ms - slot.time_ms);
+
+				logtd("Late packet: seq(%u) delay(%lld ms) target delay(%u ms)", sequence_number, now_ms - slot.time_ms, GetTargetDelayMs());
+
+				slot.state = SlotState::Released;
+				_consecutive_old_packet_count = 0;
+				return false;
+			}
+
+			if (slot.state == SlotState::Released)
+			{
+				_duplicated_packet_count++;
+				_consecutive_old_packet_count = 0;
+				return false;
+			}
+		}
+
+		_consecutive_old_packet_count++;
+		if (_consecutive_old_packet_count < RTP_JITTER_BUFFER_MAX_CONSECUTIVE_OLD_PACKETS)
+		{
+			return false;
+		}
+
+		logtw("The sequence number has jumped back (%u -> %u), the jitter buffer is reset", _head_sequence_number, sequence_number);
+		Reset(sequence_number);
+		offset = 0;
+	}
+	else
+	{
+		_consecutive_old_packet_count = 0;
+
+		if (offset >= RTP_JITTER_BUFFER_RING_SIZE * 2)
+		{
+			logtw("The sequence number has jumped (%u -> %u), the jitter buffer is reset", _head_sequence_number, sequence_number);
+			Reset(sequence_number);
+			offset = 0;
+		}
+		else if (offset >= RTP_JITTER_BUFFER_RING_SIZE)
+		{
+			// The packets at the head are too old to wait for
+			while (static_cast<uint16_t>(sequence_number - _head_sequence_number) >= RTP_JITTER_BUFFER_RING_SIZE)
+			{
+				DropHead();
+			}
+
+			offset = sequence_number - _head_sequence_number;
+		}
+	}
+
+	if (offset >= _window_size)
+	{
+		// The sequence numbers between the last packet and this packet are missing
+		for (uint16_t index = _window_size; index < offset; index++)
+		{
+			uint16_t missing_sequence_number = _head_sequence_number + index;
+			auto &missing_slot = GetSlot(missing_sequence_number);
+
+			missing_slot = Slot();
+			missing_slot.sequence_number = missing_sequence_number;
+			missing_slot.state = SlotState::Missing;
+			missing_slot.time_ms = now_ms;
+
+			_missing_count++;
+		}
+
+		_window_size = offset + 1;
+
+		// Retransmitted packets are not used to estimate the jitter
+		UpdateJitter(packet, now_ms);
+	}
+	else
+	{
+		auto &slot = GetSlot(sequence_number);
+
+		if (slot.state == SlotState::Received)
+		{
+			_duplicated_packet_count++;
+			return false;
+		}
+
+		// Reordered or retransmitted packet
+		ObserveReorderDelay(now_ms - slot.time_ms);
+		_missing_count--;
+	}
+
+	auto &slot = GetSlot(sequence_number);
+
+	slot = Slot();
+	slot.packet = packet;
+	slot.sequence_number = sequence_number;
+	slot.state = SlotState::Received;
+	slot.time_ms = now_ms;
+
+	return true;
+}
+
+bool RtpJitterBuffer::PopFrame(int64_t now_ms, std::vector<std::shared_ptr<RtpPacket>> &frame)
+{
+	frame.clear();
+
+	while (_window_size > 0)
+	{
+		auto &head = GetSlot(_head_sequence_number);
+
+		if (head.state == SlotState::Missing)
+		{
+			if (IsLossDetermined(head, now_ms) == false)
+			{
+				return false;
+			}
+
+			logtd("Packet lost: seq(%u) target delay(%u ms)", head.sequence_number, GetTargetDelayMs());
+			AdvanceHead();
+			continue;
+		}
+
+		// Padding only packet (e.g. probing of the sender's bandwidth estimator)
+		if (head.packet->PayloadSize() == 0)
+		{
+			AdvanceHead();
+			continue;
+		}
+
+		if (_mode == Mode::Packet)
+		{
+			frame.push_back(AdvanceHead());
+			return true;
+		}
+
+		auto timestamp = head.packet->Timestamp();
+
+		if (_is_gap_skipped)
+		{
+			_is_gap_skipped = false;
+
+			// If only the marker of the previous frame is lost, this packet is the first packet of a complete frame.
+			// Otherwise, the lost packets might be the first packets of this frame.
+			auto is_only_marker_lost = (_gap_size == 1) && _has_last_packet && (_is_last_packet_marker == false) && (_last_packet_timestamp != timestamp);
+
+			if (is_only_marker_lost == false)
+			{
+				_is_discarding = true;
+				_discarding_timestamp = timestamp;
+
+				if ((_has_last_packet == false) || (_last_packet_timestamp != timestamp))
+				{
+					// Otherwise, the frame has already been counted when its first packets were discarded
+					_discarded_frame_count++;
+				}
+			}
+		}
+
+		if (_is_discarding)
+		{
+			if (timestamp == _discarding_timestamp)
+			{
+				auto marker = head.packet->Marker();
+
+				AdvanceHead();
+
+				if (marker)
+				{
+					_is_discarding = false;
+				}
+
+				continue;
+			}
+
+			_is_discarding = false;
+		}
+
+		// Find the last packet of the frame
+		uint16_t frame_size = 0;
+		bool is_lost = false;
+
+		for (uint16_t offset = 0; offset < _window_size; offset++)
+		{
+			auto &slot = GetSlot(_head_sequence_number + offset);
+
+			if (slot.state == SlotState::Missing)
+			{
+				if (IsLossDetermined(slot, now_ms) == false)
+				{
+					return false;
+				}
+
+				is_lost = true;
+				frame_size = offset;
+				break;
+			}
+
+			if (slot.packet->Timestamp() != timestamp)
+			{
+				// The next frame has started without the marker bit
+				frame_size = offset;
+				break;
+			}
+
+			if (slot.packet->Marker())
+			{
+				frame_size = offset + 1;
+				break;
+			}
+		}
+
+		if (frame_size == 0)
+		{
+			// Waiting for the rest of the frame
+			return false;
+		}
+
+		if (is_lost)
+		{
+			// The packets of this frame after the lost packet are discarded by _is_gap_skipped
+			logtd("Frame discarded: timestamp(%u) packets(%u) - a packet is lost", timestamp, frame_size);
+			_discarded_frame_count++;
+
+			for (uint16_t index = 0; index < frame_size; index++)
+			{
+				AdvanceHead();
+			}
+
+			continue;
+		}
+
+		frame.reserve(frame_size);
+		for (uint16_t index = 0; index < frame_size; index++)
+		{
+			frame.push_back(AdvanceHead());
+		}
+
+		return true;
+	}
+
+	return false;
+}
+
+int64_t RtpJitterBuffer::GetNextReleaseDelayMs(int64_t now_ms) const
+{
+	if (_missing_count == 0)
+	{
+		return -1;
+	}
+
+	// The first missing slot is found to be missing earliest
+	for (uint16_t offset = 0; offset < _window_size; offset++)
+	{
+		auto &slot = GetSlot(_head_sequence_number + offset);
+
+		if (slot.state == SlotState::Missing)
+		{
+			return std::max<int64_t>(GetTargetDelayMs() - (now_ms - slot.time_ms), 0);
+		}
+	}
+
+	return -1;
+}
+
+void RtpJitterBuffer::GetNackList(int64_t now_ms, std::vector<uint16_t> &nack_list)
+{
+	if ((_missing_count == 0) || (now_ms < _next_nack_time_ms))
+	{
+		return;
+	}
+
+	_next_nack_time_ms = now_ms + RTP_JITTER_BUFFER_NACK_REORDER_MS;
+
+	for (uint16_t offset = 0; offset < _window_size; offset++)
+	{
+		auto &slot = GetSlot(_head_sequence_number + offset);
+
+		if ((slot.state != SlotState::Missing) || (slot.nack_count >= RTP_JITTER_BUFFER_NACK_MAX_RETRIES))
+		{
+			continue;
+		}
+
+		auto missing_time_ms = now_ms - slot.time_ms;
+
+		if ((missing_time_ms < RTP_JITTER_BUFFER_NACK_REORDER_MS) || (missing_time_ms >= RTP_JITTER_BUFFER_MAX_DELAY_MS))
+		{
+			// Too early to request (it may be reordered), or too late to be released
+			continue;
+		}
+
+		if ((slot.nack_sent_time_ms >= 0) && ((now_ms - slot.nack_sent_time_ms) < RTP_JITTER_BUFFER_NACK_RETRY_INTERVAL_MS))
+		{
+			continue;
+		}
+
+		slot.nack_sent_time_ms = now_ms;
+		slot.nack_count++;
+
+		nack_list.push_back(slot.sequence_number);
+
+		if (nack_list.size() >= RTP_JITTER_BUFFER_NACK_MAX_COUNT)
+		{
+			break;
+		}
+	}
+}
+
+uint32_t RtpJitterBuffer::GetTargetDelayMs() const
+{
+	auto delay_ms = std::max(GetJitterMs() * RTP_JITTER_BUFFER_JITTER_MULTIPLIER, _reorder_delay_ms);
+
+	return static_cast<uint32_t>(std::clamp<double>(delay_ms, RTP_JITTER_BUFFER_MIN_DELAY_MS, RTP_JITTER_BUFFER_MAX_DELAY_MS));
+}
+
+double RtpJitterBuffer::GetJitterMs() const
+{
+	if (_clock_rate == 0)
+	{
+		return 0.0;
+	}
+
+	return (_jitter * 1000.0) / _clock_rate;
+}
+
+uint64_t RtpJitterBuffer::GetLostPacketCount() const
+{
+	return _lost_packet_count;
+}
+
+uint64_t RtpJitterBuffer::GetLatePacketCount() const
+{
+	return _late_packet_count;
+}
+
+uint64_t RtpJitterBuffer::GetDiscardedFrameCount() const
+{
+	return _discarded_frame_count;
+}
+
+ov::String RtpJitterBuffer::ToString() const
+{
+	return ov::String::FormatString(
+		"window: %u, missing: %zu, jitter: %.2f ms, target delay: %u ms, lost: %llu, late: %llu, duplicated: %llu, discarded frames: %llu",
+		_window_size, _missing_count, GetJitterMs(), GetTargetDelayMs(),
+		_lost_packet_count, _late_packet_count, _duplicated_packet_count, _discarded_frame_count);
+}
+
+std::shared_ptr<RtpPacket> RtpJitterBuffer::AdvanceHead()
+{
+	auto &slot = GetSlot(_head_sequence_number);
+	std::shared_ptr<RtpPacket> packet;
+
+	if (slot.state == SlotState::Received)
+	{
+		packet = std::move(slot.packet);
+		slot.state = SlotState::Released;
+
+		// Padding only packets do not belong to a frame
+		if (packet->PayloadSize() > 0)
+		{
+			_gap_size = 0;
+			_has_last_packet = true;
+			_is_last_packet_marker = packet->Marker();
+			_last_packet_timestamp = packet->Timestamp();
+		}
+	}
+	else if (slot.state == SlotState::Missing)
+	{
+		slot.state = SlotState::Lost;
+
+		_lost_packet_count++;
+		_missing_count--;
+
+		if (_mode == Mode::Frame)
+		{
+			_is_gap_skipped = true;
+			_gap_size++;
+		}
+	}
+
+	_head_sequence_number++;
+	_window_size--;
+
+	return packet;
+}
+
+void RtpJitterBuffer::DropHead()
+{
+	if (_window_size == 0)
+	{
+		_head_sequence_number++;
+		return;
+	}
+
+	auto packet = AdvanceHead();
+
+	if ((packet != nullptr) && (_mode == Mode::Frame) && (_is_discarding == false))
+	{
+		_is_discarding = true;
+		_discarding_timestamp = packet->Timestamp();
+		_discarded_frame_count++;
+	}
+}
+
+bool RtpJitterBuffer::IsLossDetermined(const Slot &slot, int64_t now_ms) const
+{
+	return (now_ms - slot.time_ms) >= GetTargetDelayMs();
+}
+
+void RtpJitterBuffer::UpdateJitter(const std::shared_ptr<RtpPacket> &packet, int64_t now_ms)
+{
+	if (_clock_rate == 0)
+	{
+		return;
+	}
+
+	// RFC 3550 A.8 - Estimating the Interarrival Jitter
+	auto arrival = static_cast<uint32_t>((now_ms * static_cast<int64_t>(_clock_rate)) / 1000);
+	int64_t transit = static_cast<uint32_t>(arrival - packet->Timestamp());
+
+	if (_has_transit)
+	{
+		auto d = std::abs(static_cast<int32_t>(static_cast<uint32_t>(transit - _last_transit)));
+		_jitter += (d - _jitter) / 16.0;
+	}
+
+	_last_transit = transit;
+	_has_transit = true;
+}
+
+void RtpJitterBuffer::ObserveReorderDelay(int64_t delay_ms)
+{
+	_reorder_delay_ms = std::max(_reorder_delay_ms, static_cast<double>(delay_ms));
+}
@@ -0,0 +1,163 @@
+//==============================================================================
+//
+//  OvenMediaEngine
+//
+//  Created by Getroot
+//  Copyright (c) 2022 AirenSoft. All rights reserved.
+//
+//==============================================================================
+#pragma once
+
+#include <base/ovlibrary/ovlibrary.h>
+
+#include "rtp_packet.h"
+
+// Number of the sequence numbers that can be buffered (must be a power of two)
+#define RTP_JITTER_BUFFER_RING_SIZE 2048
+
+// Bounds of the time to wait for a missing packet before it is determined to be lost
+#define RTP_JITTER_BUFFER_MIN_DELAY_MS 10
+#define RTP_JITTER_BUFFER_MAX_DELAY_MS 500
+// The target delay covers this multiple of the inter-arrival jitter (RFC 3550)
+#define RTP_JITTER_BUFFER_JITTER_MULTIPLIER 4.0
+// The observed arrival delay of the reordered/retransmitted packets is decreased by this value per second
+#define RTP_JITTER_BUFFER_REORDER_DELAY_DECAY_MS_PER_SECOND 20.0
+
+// A missing packet is requested by NACK after it has been missing for this time (most reorderings are resolved by then)
+#define RTP_JITTER_BUFFER_NACK_REORDER_MS 5
+#define RTP_JITTER_BUFFER_NACK_RETRY_INTERVAL_MS 100
+#define RTP_JITTER_BUFFER_NACK_MAX_RETRIES 3
+// Maximum number of the sequence numbers requested at once (a NACK packet must fit in an RTCP packet)
+#define RTP_JITTER_BUFFER_NACK_MAX_COUNT 128
+
+// The buffer is reset if this number of packets far behind the window are received in a row (e.g. the sender restarted)
+#define RTP_JITTER_BUFFER_MAX_CONSECUTIVE_OLD_PACKETS 100
+
+// A jitter buffer that reorders the RTP packets in a ring indexed by the sequence number
+//
+// - Frame mode: the packets are released by frame (the packets of a frame have the same timestamp,
+//   and the rtp marker bit indicates the last packet of the frame)
+// - Packet mode: each packet is released as a frame (e.g. Opus, RFC 3551)
+//
+// Complete frames are released as soon as all the previous packets are released. A missing packet is
+// waited for the target delay, which adapts to the inter-arrival jitter and to the delay of the
+// reordered/retransmitted packets, and then it is determined to be lost. Since a missing packet is not
+// released by the arrival of the next packet, the owner calls PopFrame() again after GetNextReleaseDelayMs().
+//
+// All times are given by the caller, so that it can be driven by a network emulator.
+class RtpJitterBuffer
+{
+public:
+	enum class Mode : uint8_t
+	{
+		Frame,
+		Packet
+	};
+
+	RtpJitterBuffer(Mode mode, uint32_t clock_rate);
+
+	bool InsertPacket(const std::shared_ptr<RtpPacket> &packet, int64_t now_ms);
+
+	// Pops the next frame that can be released at now_ms, returns false if there is no such frame
+	bool PopFrame(int64_t now_ms, std::vector<std::shared_ptr<RtpPacket>> &frame);
+
+	// Milliseconds until a missing packet is determined to be lost, -1 if no packet is missing
+	int64_t GetNextReleaseDelayMs(int64_t now_ms) const;
+
+	// Sequence numbers of the missing packets to be requested by NACK at now_ms
+	void GetNackList(int64_t now_ms, std::vector<uint16_t> &nack_list);
+
+	uint32_t GetTargetDelayMs() const;
+	double GetJitterMs() const;
+
+	uint64_t GetLostPacketCount() const;
+	uint64_t GetLatePacketCount() const;
+	uint64_t GetDiscardedFrameCount() const;
+
+	ov::String ToString() const;
+
+private:
+	enum class SlotState : uint8_t
+	{
+		Empty,
+		// In the window
+		Missing,
+		Received,
+		// Behind the window (used to find the late packets)
+		Released,
+		Lost
+	};
+
+	struct Slot
+	{
+		std::shared_ptr<RtpPacket> packet;
+		uint16_t sequence_number = 0;
+		SlotState state = SlotState::Empty;
+
+		// Received: the time the packet is received, Missing/Lost: the time the packet is found to be missing
+		int64_t time_ms = 0;
+
+		int64_t nack_sent_time_ms = -1;
+		uint8_t nack_count = 0;
+	};
+
+	Slot &GetSlot(uint16_t sequence_number)
+	{
+		return _slots[sequence_number & (RTP_JITTER_BUFFER_RING_SIZE - 1)];
+	}
+
+	const Slot &GetSlot(uint16_t sequence_number) const
+	{
+		return _slots[sequence_number & (RTP_JITTER_BUFFER_RING_SIZE - 1)];
+	}
+
+	void Reset(uint16_t head_sequence_number);
+
+	// Releases the head of the window, and returns the released packet (nullptr if it was missing)
+	std::shared_ptr<RtpPacket> AdvanceHead();
+	// Drops the head of the window regardless of the state (the packets are too old to wait for)
+	void DropHead();
+	bool IsLossDetermined(const Slot &slot, int64_t now_ms) const;
+
+	void UpdateJitter(const std::shared_ptr<RtpPacket> &packet, int64_t now_ms);
+	void ObserveReorderDelay(int64_t delay_ms);
+
+	Mode _mode;
+	uint32_t _clock_rate;
+
+	std::vector<Slot> _slots;
+
+	bool _is_initialized = false;
+	// The window: [_head_sequence_number, _head_sequence_number + _window_size)
+	uint16_t _head_sequence_number = 0;
+	uint16_t _window_size = 0;
+	size_t _missing_count = 0;
+	uint32_t _consecutive_old_packet_count = 0;
+	int64_t _next_nack_time_ms = 0;
+
+	// The frame following a lost packet might have lost its first packets
+	bool _is_gap_skipped = false;
+	// Number of the packets lost in a row before the head
+	uint16_t _gap_size = 0;
+	// The last media packet that was advanced from the head, to find out which frame has lost packets
+	bool _has_last_packet = false;
+	bool _is_last_packet_marker = false;
+	uint32_t _last_packet_timestamp = 0;
+	// The packets with this timestamp are discarded since the frame has lost its packets
+	bool _is_discarding = false;
+	uint32_t _discarding_timestamp = 0;
+
+	// RFC 3550 A.8 inter-arrival jitter (in timestamp units)
+	bool _has_transit = false;
+	int64_t _last_transit = 0;
+	double _jitter = 0.0;
+
+	// Peak arrival delay of the reordered/retransmitted packets
+	double _reorder_delay_ms = 0.0;
+	int64_t _last_decay_time_ms = -1;
+
+	uint64_t _lost_packet_count = 0;
+	uint64_t _late_packet_count = 0;
+	uint64_t _duplicated_packet_count = 0;
+	uint64_t _discarded_frame_count = 0;
+};
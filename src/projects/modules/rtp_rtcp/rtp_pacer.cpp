@@ -0,0 +1,185 @@
+//==============================================================================
+//
+//  OvenMediaEngine
+//
+//  Created by Getroot
+//  Copyright (c) 2022 AirenSoft. All rights reserved.
+//
+//==============================================================================
+#include "rtp_pacer.h"
+
+#define OV_LOG_TAG "RtpPacer"
+
+RtpPacer::RtpPacer(uint32_t pacing_bitrate_bps)
+	: _pacing_bitrate_bps(pacing_bitrate_bps)
+{
+}
+
+void RtpPacer::SetPacingBitrate(uint32_t pacing_bitrate_bps)
+{
+	_pacing_bitrate_bps = pacing_bitrate_bps;
+}
+
+uint32_t RtpPacer::GetPacingBitrate() const
+{
+	return _pacing_bitrate_bps;
+}
+
+bool RtpPacer::Enqueue(const std::shared_ptr<RtpPacket> &packet, uint16_t origin_sequence_number, Priority priority, int64_t now_ms)
+{
+	if (packet == nullptr)
+	{
+		return false;
+	}
+
+	if (_queued_packet_count >= RTP_PACER_MAX_QUEUE_PACKETS)
+	{
+		logtw("The pacer queue is full (%zu packets, %zu bytes), the packet is dropped", _queued_packet_count, _queued_bytes);
+		return false;
+	}
+
+	if (IsEmpty())
+	{
+		// Accumulate the budget from now, not from the time the queue was drained last
+		UpdateBudget(now_ms);
+	}
+
+	GetQueue(priority).push_back(Item{packet, origin_sequence_number, priority, now_ms});
+
+	_queued_packet_count++;
+	_queued_bytes += packet->GetData()->GetLength();
+
+	return true;
+}
+
+bool RtpPacer::Pop(int64_t now_ms, Item *item)
+{
+	if (IsEmpty())
+	{
+		return false;
+	}
+
+	UpdateBudget(now_ms);
+
+	for (auto &queue : _queues)
+	{
+		if (queue.empty())
+		{
+			continue;
+		}
+
+		auto &front = queue.front();
+
+		if ((front.priority != Priority::Audio) && (_budget_bytes <= 0))
+		{
+			// The remaining queues are lower priority
+			return false;
+		}
+
+		auto length = front.packet->GetData()->GetLength();
+
+		*item = std::move(front);
+		queue.pop_front();
+
+		_queued_packet_count--;
+		_queued_bytes -= length;
+		_budget_bytes -= length;
+
+		return true;
+	}
+
+	return false;
+}
+
+int64_t RtpPacer::GetNextSendDelayMs(int64_t now_ms) const
+{
+	if (IsEmpty())
+	{
+		return -1;
+	}
+
+	if ((GetQueue(Priority::Audio).empty() == false) || (_budget_bytes > 0))
+	{
+		return 0;
+	}
+
+	auto bitrate = GetEffectiveBitrate();
+	if (bitrate <= 0.0)
+	{
+		return RTP_PACER_MAX_BURST_MS;
+	}
+
+	auto elapsed_ms = (_last_update_time_ms < 0) ? 0 : (now_ms - _last_update_time_ms);
+	// Time to refill the budget above zero
+	auto delay_ms = static_cast<int64_t>(((1 - _budget_bytes) * 8.0 * 1000.0) / bitrate) + 1 - elapsed_ms;
+
+	return std::max<int64_t>(delay_ms, 0);
+}
+
+bool RtpPacer::IsEmpty() const
+{
+	return _queued_packet_count == 0;
+}
+
+size_t RtpPacer::GetQueuedPacketCount() const
+{
+	return _queued_packet_count;
+}
+
+size_t RtpPacer::GetQueuedBytes() const
+{
+	return _queued_bytes;
+}
+
+int64_t RtpPacer::GetQueueTimeMs(int64_t now_ms) const
+{
+	int64_t oldest_time_ms = now_ms;
+
+	for (const auto &queue : _queues)
+	{
+		if (queue.empty() == false)
+		{
+			oldest_time_ms = std::min(oldest_time_ms, queue.front().enqueued_time_ms);
+		}
+	}
+
+	return now_ms - oldest_time_ms;
+}
+
+void RtpPacer::UpdateBudget(int64_t now_ms)
+{
+	if (_last_update_time_ms < 0)
+	{
+		_last_update_time_ms = now_ms;
+		_budget_bytes = GetMaxBudget();
+		return;
+	}
+
+	auto elapsed_ms = now_ms - _last_update_time_ms;
+	if (elapsed_ms <= 0)
+	{
+		return;
+	}
+
+	_budget_bytes += static_cast<int64_t>((GetEffectiveBitrate() * elapsed_ms) / 8000.0);
+	_budget_bytes = std::min(_budget_bytes, GetMaxBudget());
+
+	_last_update_time_ms = now_ms;
+}
+
+double RtpPacer::GetEffectiveBitrate() const
+{
+	// Raise the bitrate so that the queue is drained within RTP_PACER_MAX_QUEUE_TIME_MS,
+	// otherwise the packets would be too late to be played
+	double drain_bitrate = (_queued_bytes * 8.0 * 1000.0) / RTP_PACER_MAX_QUEUE_TIME_MS;
+
+	return std::max<double>(_pacing_bitrate_bps, drain_bitrate);
+}
+
+int64_t RtpPacer::GetMaxBudget() const
+{
+	auto max_budget = static_cast<int64_t>((GetEffectiveBitrate() * RTP_PACER_MAX_BURST_MS) / 8000.0);
+
+	// At least one packet can be sent at once
+	return std::max<int64_t>(max_budget, RTP_DEFAULT_MAX_PACKET_SIZE);
+}
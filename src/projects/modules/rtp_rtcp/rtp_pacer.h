@@ -0,0 +1,94 @@
+//==============================================================================
+//
+//  OvenMediaEngine
+//
+//  Created by Getroot
+//  Copyright (c) 2022 AirenSoft. All rights reserved.
+//
+//==============================================================================
+#pragma once
+
+#include <base/ovlibrary/ovlibrary.h>
+
+#include <deque>
+
+#include "rtp_packet.h"
+
+// Bytes that can be sent at once after the pacer has been idle (= pacing bitrate * this duration)
+#define RTP_PACER_MAX_BURST_MS 10
+// If the packets are queued longer than this, the pacing bitrate is raised to drain the queue within this time
+#define RTP_PACER_MAX_QUEUE_TIME_MS 500
+// Packets are dropped if the queue grows over this size (e.g. the sender is stalled)
+#define RTP_PACER_MAX_QUEUE_PACKETS 10000
+
+// A token bucket pacer that spreads the packets (e.g. the burst of a keyframe) within the frame intervals
+//
+// - Audio packets are sent immediately (they are small and delay-sensitive), but consume the budget
+// - Retransmissions are sent before the video packets
+//
+// All times are given by the caller, so the pacer can be driven by a network emulator.
+class RtpPacer
+{
+public:
+	enum class Priority : uint8_t
+	{
+		Audio = 0,
+		Retransmission,
+		Video,
+
+		Count
+	};
+
+	struct Item
+	{
+		std::shared_ptr<RtpPacket> packet;
+		// Sequence number of the packet from the stream (used to trace the sent packet for NACK)
+		uint16_t origin_sequence_number = 0;
+		Priority priority = Priority::Video;
+		int64_t enqueued_time_ms = 0;
+	};
+
+	explicit RtpPacer(uint32_t pacing_bitrate_bps);
+
+	void SetPacingBitrate(uint32_t pacing_bitrate_bps);
+	uint32_t GetPacingBitrate() const;
+
+	bool Enqueue(const std::shared_ptr<RtpPacket> &packet, uint16_t origin_sequence_number, Priority priority, int64_t now_ms);
+
+	// Pops the next packet that can be sent at now_ms, returns false if there is no packet or the budget is exhausted
+	bool Pop(int64_t now_ms, Item *item);
+
+	// Milliseconds until the next packet can be sent, -1 if the queue is empty
+	int64_t GetNextSendDelayMs(int64_t now_ms) const;
+
+	bool IsEmpty() const;
+	size_t GetQueuedPacketCount() const;
+	size_t GetQueuedBytes() const;
+	// Time the oldest packet has been waiting
+	int64_t GetQueueTimeMs(int64_t now_ms) const;
+
+private:
+	void UpdateBudget(int64_t now_ms);
+	double GetEffectiveBitrate() const;
+	int64_t GetMaxBudget() const;
+
+	std::deque<Item> &GetQueue(Priority priority)
+	{
+		return _queues[static_cast<size_t>(priority)];
+	}
+
+	const std::deque<Item> &GetQueue(Priority priority) const
+	{
+		return _queues[static_cast<size_t>(priority)];
+	}
+
+	uint32_t _pacing_bitrate_bps;
+
+	std::deque<Item> _queues[static_cast<size_t>(Priority::Count)];
+	size_t _queued_packet_count = 0;
+	size_t _queued_bytes = 0;
+
+	// Bytes that can be sent now (can be negative after audio packets are sent)
+	int64_t _budget_bytes = 0;
+	int64_t _last_update_time_ms = -1;
+};
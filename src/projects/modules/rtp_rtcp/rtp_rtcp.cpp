@@ -5,12 +5,26 @@
 #include "publishers/webrtc/rtc_stream.h"
 #include "rtcp_receiver.h"
 #include "rtcp_info/fir.h"
+#include "rtcp_info/nack.h"
 #include "rtcp_info/pli.h"
 
 #include "modules/rtsp/rtsp_data.h"
 
 #define OV_LOG_TAG "RtpRtcp"
 
+// The timing wheel is shared by all RtpRtcp nodes, and is never released
+// since the timers may be scheduled until the process exits
+static ov::TimingWheel *GetJitterBufferTimingWheel()
+{
+	static auto timing_wheel = []() {
+		auto timing_wheel = new ov::TimingWheel("RtpJitter", JITTER_BUFFER_TIMER_TICK_MS);
+		timing_wheel->Start();
+		return timing_wheel;
+	}();
+
+	return timing_wheel;
+}
+
 RtpRtcp::RtpRtcp(const std::shared_ptr<RtpRtcpInterface> &observer)
 	        : ov::Node(NodeType::Rtp)
 {
@@ -57,15 +71,17 @@ bool RtpRtcp::AddRtpReceiver(uint32_t track_id, const std::shared_ptr<MediaTrack
 
 	_tracks[track_id] = track;
 
+	auto clock_rate = static_cast<uint32_t>(track->GetTimeBase().GetDen());
+
 	switch(track->GetOriginBitstream())
 	{
 		case cmn::BitstreamFormat::H264_RTP_RFC_6184:
 		case cmn::BitstreamFormat::VP8_RTP_RFC_7741:
 		case cmn::BitstreamFormat::AAC_MPEG4_GENERIC:
-			_rtp_frame_jitter_buffers[track_id] = std::make_shared<RtpFrameJitterBuffer>();
+			_rtp_jitter_buffers[track_id] = std::make_shared<RtpJitterBuffer>(RtpJitterBuffer::Mode::Frame, clock_rate);
 			break;
 		case cmn::BitstreamFormat::OPUS_RTP_RFC_7587:
-			_rtp_minimal_jitter_buffers[track_id] = std::make_shared<RtpMinimalJitterBuffer>();
+			_rtp_jitter_buffers[track_id] = std::make_shared<RtpJitterBuffer>(RtpJitterBuffer::Mode::Packet, clock_rate);
 			break;
 		default:
 			logte("RTP Receiver cannot support %d input stream format", static_cast<int8_t>(track->GetOriginBitstream()));
@@ -90,6 +106,12 @@ bool RtpRtcp::Stop()
 	std::lock_guard<std::shared_mutex> lock(_state_lock);
 	_observer.reset();
 
+	if (_jitter_buffer_timer != nullptr)
+	{
+		GetJitterBufferTimingWheel()->Cancel(_jitter_buffer_timer);
+		_jitter_buffer_timer.reset();
+	}
+
 	return Node::Stop();
 }
 
@@ -220,6 +242,26 @@ void RtpRtcp::DisableTransportCcFeedback()
 	_transport_cc_feedback_enabled = false;
 }
 
+bool RtpRtcp::EnableNack(uint32_t track_id)
+{
+	std::shared_lock<std::shared_mutex> lock(_state_lock);
+	if(GetNodeState() != ov::Node::NodeState::Ready)
+	{
+		logtd("It can only be called in the ready state.");
+		return false;
+	}
+
+	if(_rtp_jitter_buffers.find(track_id) == _rtp_jitter_buffers.end())
+	{
+		logte("Could not find jitter buffer for track ID %u", track_id);
+		return false;
+	}
+
+	_nack_enabled_track_ids.insert(track_id);
+
+	return true;
+}
+
 // In general, since RTP_RTCP is the first node, there is no previous node. So it will not be called
 bool RtpRtcp::OnDataReceivedFromPrevNode(NodeType from_node, const std::shared_ptr<ov::Data> &data)
 {
@@ -397,92 +439,147 @@ bool RtpRtcp::OnRtpReceived(NodeType from_node, const std::shared_ptr<const ov::
 		}
 	}
 
-	int jitter_buffer_type = 0;
-	switch(track->GetOriginBitstream())
+	auto buffer_it = _rtp_jitter_buffers.find(track_id);
+	if(buffer_it == _rtp_jitter_buffers.end())
 	{
-		case cmn::BitstreamFormat::H264_RTP_RFC_6184:
-		case cmn::BitstreamFormat::VP8_RTP_RFC_7741:
-		case cmn::BitstreamFormat::AAC_MPEG4_GENERIC:
-			jitter_buffer_type = 1;
-			break;
-		case cmn::BitstreamFormat::OPUS_RTP_RFC_7587:
-			jitter_buffer_type = 2;
-			break;
-		default:
-			break;
+		// can not happen
+		logte("Could not find jitter buffer for track ID %u", track_id);
+		return false;
 	}
 
-	if(jitter_buffer_type == 1)
+	auto jitter_buffer = buffer_it->second;
+
+	std::lock_guard<std::mutex> jitter_buffer_lock(_jitter_buffer_lock);
+
+	int64_t now_ms = ov::Clock::NowMSec();
+
+	jitter_buffer->InsertPacket(packet, now_ms);
+
+	if(_nack_enabled_track_ids.find(track_id) != _nack_enabled_track_ids.end())
 	{
-		auto buffer_it = _rtp_frame_jitter_buffers.find(track_id);
-		if(buffer_it == _rtp_frame_jitter_buffers.end())
+		std::vector<uint16_t> lost_ids;
+		jitter_buffer->GetNackList(now_ms, lost_ids);
+
+		if(lost_ids.empty() == false)
 		{
-			// can not happen
-			logte("Could not find jitter buffer for payload type %d", packet->PayloadType());
-			return false;
+			SendNack(stat, packet->Ssrc(), lost_ids);
 		}
+	}
+
+	ReleaseJitterBufferFrames(jitter_buffer, now_ms);
+	ScheduleJitterBufferTimer(now_ms);
 
-		auto jitter_buffer = buffer_it->second;
+	return true;
+}
 
-		jitter_buffer->InsertPacket(packet);
+void RtpRtcp::ReleaseJitterBufferFrames(const std::shared_ptr<RtpJitterBuffer> &jitter_buffer, int64_t now_ms)
+{
+	std::vector<std::shared_ptr<RtpPacket>> rtp_packets;
 
-		auto frame = jitter_buffer->PopAvailableFrame();
-		if(frame != nullptr && _observer != nullptr)
+	// Several frames can be completed at once (e.g. a retransmitted packet fills the gap)
+	while(jitter_buffer->PopFrame(now_ms, rtp_packets))
+	{
+		if(_observer != nullptr)
 		{
-			std::vector<std::shared_ptr<RtpPacket>> rtp_packets;
+			_observer->OnRtpFrameReceived(rtp_packets);
+		}
+	}
+}
 
-			auto packet = frame->GetFirstRtpPacket();
-			if(packet == nullptr)
-			{
-				// can not happen
-				logtw("Could not get first rtp packet from jitter buffer - track(%u)", track_id);
-				return false;
-			}
+void RtpRtcp::ScheduleJitterBufferTimer(int64_t now_ms)
+{
+	int64_t delay_ms = -1;
 
-			rtp_packets.push_back(packet);
+	for(const auto &item : _rtp_jitter_buffers)
+	{
+		auto buffer_delay_ms = item.second->GetNextReleaseDelayMs(now_ms);
+		if((buffer_delay_ms >= 0) && ((delay_ms < 0) || (buffer_delay_ms < delay_ms)))
+		{
+			delay_ms = buffer_delay_ms;
+		}
+	}
 
-			while(true)
-			{
-				packet = frame->GetNextRtpPacket();
-				if(packet == nullptr)
+	if(delay_ms < 0)
+	{
+		// No packet is missing, the frames are released by the received packets
+		return;
+	}
+
+	auto expire_ms = now_ms + delay_ms;
+
+	if(_jitter_buffer_timer == nullptr)
+	{
+		std::weak_ptr<RtpRtcp> rtp_rtcp_weak = GetSharedPtrAs<RtpRtcp>();
+
+		_jitter_buffer_timer = GetJitterBufferTimingWheel()->Schedule(
+			[rtp_rtcp_weak]() -> ov::DelayQueueAction {
+				auto rtp_rtcp = rtp_rtcp_weak.lock();
+
+				if(rtp_rtcp != nullptr)
 				{
-					break;
+					rtp_rtcp->OnJitterBufferTimer();
 				}
 
-				rtp_packets.push_back(packet);
-			}
+				return ov::DelayQueueAction::Stop;
+			},
+			delay_ms);
+	}
+	else if((_jitter_buffer_timer->IsScheduled() == false) || (expire_ms < _jitter_buffer_timer_expire_ms))
+	{
+		// Reschedule() also links the expired timer again
+		GetJitterBufferTimingWheel()->Reschedule(_jitter_buffer_timer, delay_ms);
+	}
+	else
+	{
+		return;
+	}
 
-			_observer->OnRtpFrameReceived(rtp_packets);
-		}
+	_jitter_buffer_timer_expire_ms = expire_ms;
+}
+
+void RtpRtcp::OnJitterBufferTimer()
+{
+	std::shared_lock<std::shared_mutex> lock(_state_lock);
+	if(GetNodeState() != ov::Node::NodeState::Started)
+	{
+		return;
 	}
-	else if(jitter_buffer_type == 2)
+
+	std::lock_guard<std::mutex> jitter_buffer_lock(_jitter_buffer_lock);
+
+	int64_t now_ms = ov::Clock::NowMSec();
+
+	for(const auto &item : _rtp_jitter_buffers)
 	{
-		auto buffer_it = _rtp_minimal_jitter_buffers.find(track_id);
-		if(buffer_it == _rtp_minimal_jitter_buffers.end())
-		{
-			// can not happen
-			logte("Could not find jitter buffer for ssrc %u", packet->Ssrc());
-			return false;
-		}
+		ReleaseJitterBufferFrames(item.second, now_ms);
+	}
 
-		auto jitter_buffer = buffer_it->second;
+	ScheduleJitterBufferTimer(now_ms);
+}
 
-		jitter_buffer->InsertPacket(packet);
+void RtpRtcp::SendNack(const std::shared_ptr<RtpReceiveStatistics> &stat, uint32_t media_ssrc, const std::vector<uint16_t> &lost_ids)
+{
+	auto nack = std::make_shared<NACK>();
 
-		auto pop_packet = jitter_buffer->PopAvailablePacket();
-		if(pop_packet != nullptr)
-		{
-			std::vector<std::shared_ptr<RtpPacket>> rtp_packets;
-			rtp_packets.push_back(pop_packet);
-			_observer->OnRtpFrameReceived(rtp_packets);
-		}
+	nack->SetSrcSsrc(stat->GetReceiverSSRC());
+	nack->SetMediaSsrc(media_ssrc);
+	nack->SetRtpSsrc(media_ssrc);
+
+	for(auto lost_id : lost_ids)
+	{
+		nack->AddLostId(lost_id);
 	}
-	else
+
+	auto rtcp_packet = std::make_shared<RtcpPacket>();
+	if(rtcp_packet->Build(nack) == false)
 	{
-		logte("Could not find jitter buffer for payload type %d", packet->PayloadType());
+		return;
 	}
 
-	return true;
+	logtd("Send NACK - ssrc(%u) lost(%zu)", media_ssrc, lost_ids.size());
+
+	_last_sent_rtcp_packet = rtcp_packet;
+	SendDataToNextNode(NodeType::Rtcp, rtcp_packet->GetData());
 }
 
 bool RtpRtcp::OnRtcpReceived(NodeType from_node, const std::shared_ptr<const ov::Data> &data)
@@ -8,14 +8,17 @@
 #include "rtcp_info/rtcp_transport_cc_feedback_generator.h"
 #include "rtcp_info/sdes.h"
 #include "rtcp_info/receiver_report.h"
-#include "rtp_frame_jitter_buffer.h"
-#include "rtp_minimal_jitter_buffer.h"
+#include "rtp_jitter_buffer.h"
 #include "rtp_receive_statistics.h"
 
+#include <unordered_set>
+
 
 #define RECEIVER_REPORT_CYCLE_MS	500
 #define TRANSPORT_CC_CYCLE_MS		50
 #define SDES_CYCLE_MS 500
+// Resolution of the timer that releases the frames waiting for the missing packets
+#define JITTER_BUFFER_TIMER_TICK_MS	5
 
 class RtpRtcpInterface : public ov::EnableSharedFromThis<RtpRtcpInterface>
 {
@@ -42,6 +45,9 @@ public:
 	bool EnableTransportCcFeedback(uint8_t extension_id);
 	void DisableTransportCcFeedback();
 
+	// Requests the missing packets of the track with Generic NACK (RFC 4585), must be called after AddRtpReceiver()
+	bool EnableNack(uint32_t track_id);
+
 	// These functions help the next node to not have to parse the packet again.
 	// Because next node receives raw data format.
 	std::shared_ptr<RtpPacket> GetLastSentRtpPacket();
@@ -55,10 +61,15 @@ private:
 	bool OnRtpReceived(NodeType from_node, const std::shared_ptr<const ov::Data> &data);
 	bool OnRtcpReceived(NodeType from_node, const std::shared_ptr<const ov::Data> &data);
 
-	std::shared_ptr<RtpFrameJitterBuffer> GetJitterBuffer(uint8_t payload_type);
-
 	std::shared_ptr<RtcpPacket> GenerateTransportCcFeedbackIfNeeded();
 
+	// These must be called with _jitter_buffer_lock
+	void ReleaseJitterBufferFrames(const std::shared_ptr<RtpJitterBuffer> &jitter_buffer, int64_t now_ms);
+	void ScheduleJitterBufferTimer(int64_t now_ms);
+	void SendNack(const std::shared_ptr<RtpReceiveStatistics> &stat, uint32_t media_ssrc, const std::vector<uint16_t> &lost_ids);
+
+	void OnJitterBufferTimer();
+
     time_t _first_receiver_report_time = 0; // 0 - not received RR packet
     time_t _last_sender_report_time = 0;
     uint64_t _send_packet_sequence_number = 0;
@@ -81,9 +92,13 @@ private:
 	std::shared_ptr<RtcpTransportCcFeedbackGenerator> _transport_cc_generator = nullptr;
 
 	// Jitter buffer
-	// payload type : Jitter buffer
-	std::unordered_map<uint8_t, std::shared_ptr<RtpFrameJitterBuffer>> _rtp_frame_jitter_buffers;
-	std::unordered_map<uint8_t, std::shared_ptr<RtpMinimalJitterBuffer>> _rtp_minimal_jitter_buffers;
+	// The frames are released by the receiving thread and the timer, so they are serialized by _jitter_buffer_lock
+	std::mutex _jitter_buffer_lock;
+	// track id : Jitter buffer
+	std::unordered_map<uint32_t, std::shared_ptr<RtpJitterBuffer>> _rtp_jitter_buffers;
+	std::unordered_set<uint32_t> _nack_enabled_track_ids;
+	ov::TimingWheel::TimerHandle _jitter_buffer_timer;
+	int64_t _jitter_buffer_timer_expire_ms = -1;
 
 	// payload type : MediaTrack Info
 	std::unordered_map<uint8_t, std::shared_ptr<MediaTrack>> _tracks;
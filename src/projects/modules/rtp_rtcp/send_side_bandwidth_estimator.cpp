@@ -0,0 +1,377 @@
+//==============================================================================
+//
+//  OvenMediaEngine
+//
+//  Created by Getroot
+//  Copyright (c) 2022 AirenSoft. All rights reserved.
+//
+//==============================================================================
+#include "send_side_bandwidth_estimator.h"
+
+#include <cmath>
+
+#define OV_LOG_TAG "BWE"
+
+SendSideBandwidthEstimator::SendSideBandwidthEstimator(uint32_t start_bitrate_bps, uint32_t min_bitrate_bps, uint32_t max_bitrate_bps)
+	: _min_bitrate_bps(min_bitrate_bps),
+	  _max_bitrate_bps(std::max(min_bitrate_bps, max_bitrate_bps))
+{
+	_target_bitrate_bps = std::clamp(start_bitrate_bps, _min_bitrate_bps, _max_bitrate_bps);
+	_delay_based_bitrate_bps = _target_bitrate_bps;
+	_loss_based_bitrate_bps = _target_bitrate_bps;
+}
+
+void SendSideBandwidthEstimator::OnTransportFeedback(const std::vector<PacketResult> &results, int64_t now_ms)
+{
+	if (results.empty())
+	{
+		return;
+	}
+
+	for (const auto &result : results)
+	{
+		_feedback_packet_count++;
+
+		if (result.IsReceived() == false)
+		{
+			_lost_packet_count++;
+			continue;
+		}
+
+		UpdateAckedBitrate(result);
+		OnPacketReceived(result, now_ms);
+	}
+
+	UpdateDelayBasedBitrate(now_ms);
+	UpdateLossBasedBitrate(now_ms);
+	UpdateTargetBitrate();
+}
+
+void SendSideBandwidthEstimator::OnRemb(uint32_t bitrate_bps)
+{
+	_remb_bitrate_bps = bitrate_bps;
+
+	UpdateTargetBitrate();
+}
+
+uint32_t SendSideBandwidthEstimator::GetTargetBitrate() const
+{
+	return _target_bitrate_bps;
+}
+
+uint32_t SendSideBandwidthEstimator::GetAckedBitrate() const
+{
+	return _acked_bitrate_bps;
+}
+
+double SendSideBandwidthEstimator::GetLossRate() const
+{
+	return _loss_rate;
+}
+
+SendSideBandwidthEstimator::BandwidthUsage SendSideBandwidthEstimator::GetBandwidthUsage() const
+{
+	return _bandwidth_usage;
+}
+
+void SendSideBandwidthEstimator::OnPacketReceived(const PacketResult &result, int64_t now_ms)
+{
+	if (_current_group.IsValid() == false)
+	{
+		_current_group.first_send_time_us = result.send_time_us;
+		_current_group.last_send_time_us = result.send_time_us;
+		_current_group.last_receive_time_us = result.receive_time_us;
+		return;
+	}
+
+	if (result.send_time_us < _current_group.first_send_time_us)
+	{
+		// Reordered
+		return;
+	}
+
+	if ((result.send_time_us - _current_group.first_send_time_us) <= (BWE_BURST_INTERVAL_MS * 1000))
+	{
+		// Belongs to the current group
+		_current_group.last_send_time_us = std::max(_current_group.last_send_time_us, result.send_time_us);
+		_current_group.last_receive_time_us = std::max(_current_group.last_receive_time_us, result.receive_time_us);
+		return;
+	}
+
+	// The current group is completed
+	if (_previous_group.IsValid())
+	{
+		double send_delta_ms = (_current_group.last_send_time_us - _previous_group.last_send_time_us) / 1000.0;
+		double receive_delta_ms = (_current_group.last_receive_time_us - _previous_group.last_receive_time_us) / 1000.0;
+
+		OnGroupDelta(send_delta_ms, receive_delta_ms, _current_group.last_receive_time_us / 1000, now_ms);
+	}
+
+	_previous_group = _current_group;
+
+	_current_group.first_send_time_us = result.send_time_us;
+	_current_group.last_send_time_us = result.send_time_us;
+	_current_group.last_receive_time_us = result.receive_time_us;
+}
+
+void SendSideBandwidthEstimator::OnGroupDelta(double send_delta_ms, double receive_delta_ms, int64_t arrival_time_ms, int64_t now_ms)
+{
+	double delay_delta_ms = receive_delta_ms - send_delta_ms;
+
+	_delta_count = std::min(_delta_count + 1, 1000U);
+
+	if (_first_arrival_time_ms < 0)
+	{
+		_first_arrival_time_ms = arrival_time_ms;
+	}
+
+	_accumulated_delay_ms += delay_delta_ms;
+	_smoothed_delay_ms = (BWE_TRENDLINE_SMOOTHING * _smoothed_delay_ms) + ((1.0 - BWE_TRENDLINE_SMOOTHING) * _accumulated_delay_ms);
+
+	_delay_history.emplace_back(static_cast<double>(arrival_time_ms - _first_arrival_time_ms), _smoothed_delay_ms);
+	if (_delay_history.size() > BWE_TRENDLINE_WINDOW_SIZE)
+	{
+		_delay_history.pop_front();
+	}
+
+	double trend = _previous_trend;
+
+	if (_delay_history.size() == BWE_TRENDLINE_WINDOW_SIZE)
+	{
+		// Slope of the linear regression of (arrival time, smoothed delay)
+		double sum_x = 0.0;
+		double sum_y = 0.0;
+
+		for (const auto &[x, y] : _delay_history)
+		{
+			sum_x += x;
+			sum_y += y;
+		}
+
+		double average_x = sum_x / _delay_history.size();
+		double average_y = sum_y / _delay_history.size();
+		double numerator = 0.0;
+		double denominator = 0.0;
+
+		for (const auto &[x, y] : _delay_history)
+		{
+			numerator += (x - average_x) * (y - average_y);
+			denominator += (x - average_x) * (x - average_x);
+		}
+
+		if (denominator != 0.0)
+		{
+			trend = numerator / denominator;
+		}
+	}
+
+	Detect(trend, send_delta_ms, now_ms);
+}
+
+void SendSideBandwidthEstimator::Detect(double trend, double send_delta_ms, int64_t now_ms)
+{
+	if (_delta_count < 2)
+	{
+		_bandwidth_usage = BandwidthUsage::Normal;
+		return;
+	}
+
+	double modified_trend = std::min(_delta_count, 60U) * trend * BWE_TRENDLINE_THRESHOLD_GAIN;
+
+	if (modified_trend > _threshold_ms)
+	{
+		if (_time_over_using_ms < 0.0)
+		{
+			// Assume that the overuse started in the middle of the group
+			_time_over_using_ms = send_delta_ms / 2.0;
+		}
+		else
+		{
+			_time_over_using_ms += send_delta_ms;
+		}
+
+		_overuse_count++;
+
+		if ((_time_over_using_ms > BWE_OVERUSE_TIME_THRESHOLD_MS) && (_overuse_count > 1) && (trend >= _previous_trend))
+		{
+			_time_over_using_ms = 0.0;
+			_overuse_count = 0;
+			_bandwidth_usage = BandwidthUsage::Overusing;
+		}
+	}
+	else if (modified_trend < -_threshold_ms)
+	{
+		_time_over_using_ms = -1.0;
+		_overuse_count = 0;
+		_bandwidth_usage = BandwidthUsage::Underusing;
+	}
+	else
+	{
+		_time_over_using_ms = -1.0;
+		_overuse_count = 0;
+		_bandwidth_usage = BandwidthUsage::Normal;
+	}
+
+	_previous_trend = trend;
+
+	UpdateThreshold(modified_trend, now_ms);
+}
+
+void SendSideBandwidthEstimator::UpdateThreshold(double modified_trend, int64_t now_ms)
+{
+	if (_last_threshold_update_ms < 0)
+	{
+		_last_threshold_update_ms = now_ms;
+	}
+
+	double abs_trend = std::fabs(modified_trend);
+
+	if (abs_trend > (_threshold_ms + 15.0))
+	{
+		// Avoid adapting the threshold to a spike (e.g. a sudden change of the route)
+		_last_threshold_update_ms = now_ms;
+		return;
+	}
+
+	// The threshold follows the trend slowly if the trend is above it, and quickly if below it
+	double k = (abs_trend < _threshold_ms) ? 0.039 : 0.0087;
+	auto elapsed_ms = std::min<int64_t>(now_ms - _last_threshold_update_ms, 100);
+
+	_threshold_ms += k * (abs_trend - _threshold_ms) * elapsed_ms;
+	_threshold_ms = std::clamp(_threshold_ms, 6.0, 600.0);
+
+	_last_threshold_update_ms = now_ms;
+}
+
+void SendSideBandwidthEstimator::UpdateAckedBitrate(const PacketResult &result)
+{
+	_acked_history.emplace_back(result.receive_time_us, result.size);
+	_acked_bytes += result.size;
+
+	int64_t newest_time_us = result.receive_time_us;
+
+	while ((_acked_history.empty() == false) && ((newest_time_us - _acked_history.front().first) > (BWE_ACKED_BITRATE_WINDOW_MS * 1000)))
+	{
+		_acked_bytes -= _acked_history.front().second;
+		_acked_history.pop_front();
+	}
+
+	auto span_us = newest_time_us - _acked_history.front().first;
+
+	// Wait until the window is half filled to avoid a noisy value
+	if (span_us >= (BWE_ACKED_BITRATE_WINDOW_MS * 1000 / 2))
+	{
+		_acked_bitrate_bps = static_cast<uint32_t>(std::min<double>((_acked_bytes * 8.0 * 1000000.0) / span_us, UINT32_MAX));
+	}
+}
+
+void SendSideBandwidthEstimator::UpdateDelayBasedBitrate(int64_t now_ms)
+{
+	switch (_bandwidth_usage)
+	{
+		case BandwidthUsage::Overusing:
+			_rate_control_state = RateControlState::Decrease;
+			break;
+
+		case BandwidthUsage::Underusing:
+			// The queue of the bottleneck is draining, wait until it is empty
+			_rate_control_state = RateControlState::Hold;
+			break;
+
+		case BandwidthUsage::Normal:
+			if (_rate_control_state == RateControlState::Hold)
+			{
+				_rate_control_state = RateControlState::Increase;
+			}
+			break;
+	}
+
+	if (_last_rate_update_ms < 0)
+	{
+		_last_rate_update_ms = now_ms;
+	}
+
+	auto elapsed_ms = std::min<int64_t>(now_ms - _last_rate_update_ms, 1000);
+
+	switch (_rate_control_state)
+	{
+		case RateControlState::Hold:
+			break;
+
+		case RateControlState::Increase: {
+			// Do not increase if the estimate is far above what is actually sent
+			if ((_acked_bitrate_bps > 0) && (_delay_based_bitrate_bps > (BWE_MAX_ACKED_BITRATE_RATIO * _acked_bitrate_bps + 10000.0)))
+			{
+				break;
+			}
+
+			_delay_based_bitrate_bps *= std::pow(BWE_INCREASE_FACTOR_PER_SECOND, elapsed_ms / 1000.0);
+			break;
+		}
+
+		case RateControlState::Decrease: {
+			double decreased_bitrate_bps = BWE_DECREASE_FACTOR * ((_acked_bitrate_bps > 0) ? _acked_bitrate_bps : _delay_based_bitrate_bps);
+
+			_delay_based_bitrate_bps = std::min(_delay_based_bitrate_bps, decreased_bitrate_bps);
+			_rate_control_state = RateControlState::Hold;
+
+			logtd("Overuse detected, the estimate is decreased to %.0f bps (acked: %u bps)", _delay_based_bitrate_bps, _acked_bitrate_bps);
+			break;
+		}
+	}
+
+	_delay_based_bitrate_bps = std::clamp<double>(_delay_based_bitrate_bps, _min_bitrate_bps, _max_bitrate_bps);
+	_last_rate_update_ms = now_ms;
+}
+
+void SendSideBandwidthEstimator::UpdateLossBasedBitrate(int64_t now_ms)
+{
+	if (_feedback_packet_count < BWE_LOSS_MIN_PACKET_COUNT)
+	{
+		// Not enough packets to calculate the loss rate
+		return;
+	}
+
+	_loss_rate = static_cast<double>(_lost_packet_count) / _feedback_packet_count;
+	_lost_packet_count = 0;
+	_feedback_packet_count = 0;
+
+	if (_loss_rate > BWE_LOSS_HIGH_THRESHOLD)
+	{
+		if ((_last_loss_decrease_ms < 0) || ((now_ms - _last_loss_decrease_ms) >= BWE_LOSS_DECREASE_INTERVAL_MS))
+		{
+			_loss_based_bitrate_bps = _target_bitrate_bps * (1.0 - (0.5 * _loss_rate));
+			_last_loss_decrease_ms = now_ms;
+
+			logtd("High loss rate (%.2f), the estimate is decreased to %.0f bps", _loss_rate, _loss_based_bitrate_bps);
+		}
+	}
+	else if (_loss_rate < BWE_LOSS_LOW_THRESHOLD)
+	{
+		// The loss-based estimate follows the delay-based estimate
+		_loss_based_bitrate_bps = std::max(_loss_based_bitrate_bps, _delay_based_bitrate_bps);
+	}
+
+	_loss_based_bitrate_bps = std::clamp<double>(_loss_based_bitrate_bps, _min_bitrate_bps, _max_bitrate_bps);
+}
+
+void SendSideBandwidthEstimator::UpdateTargetBitrate()
+{
+	double target_bitrate_bps = std::min(_delay_based_bitrate_bps, _loss_based_bitrate_bps);
+
+	if (_remb_bitrate_bps > 0)
+	{
+		target_bitrate_bps = std::min<double>(target_bitrate_bps, _remb_bitrate_bps);
+	}
+
+	_target_bitrate_bps = static_cast<uint32_t>(std::clamp<double>(target_bitrate_bps, _min_bitrate_bps, _max_bitrate_bps));
+}
+
+ov::String SendSideBandwidthEstimator::ToString() const
+{
+	static const char *usage_names[] = {"Normal", "Underusing", "Overusing"};
+
+	return ov::String::FormatString("Target(%u) DelayBased(%.0f) LossBased(%.0f) Acked(%u) Loss(%.2f) Usage(%s) Threshold(%.2f)",
+									_target_bitrate_bps, _delay_based_bitrate_bps, _loss_based_bitrate_bps, _acked_bitrate_bps,
+									_loss_rate, usage_names[static_cast<int>(_bandwidth_usage)], _threshold_ms);
+}
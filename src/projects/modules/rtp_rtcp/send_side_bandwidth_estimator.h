@@ -0,0 +1,163 @@
+//==============================================================================
+//
+//  OvenMediaEngine
+//
+//  Created by Getroot
+//  Copyright (c) 2022 AirenSoft. All rights reserved.
+//
+//==============================================================================
+#pragma once
+
+#include <base/ovlibrary/ovlibrary.h>
+
+#include <deque>
+
+#define BWE_MIN_BITRATE_BPS (100 * 1000)
+#define BWE_MAX_BITRATE_BPS (100 * 1000 * 1000)
+
+// Packets sent within this interval are grouped as one burst (e.g. packets of a frame)
+#define BWE_BURST_INTERVAL_MS 5
+// Number of the delay samples used for the linear regression of the trendline filter
+#define BWE_TRENDLINE_WINDOW_SIZE 20
+#define BWE_TRENDLINE_SMOOTHING 0.9
+#define BWE_TRENDLINE_THRESHOLD_GAIN 4.0
+#define BWE_OVERUSE_TIME_THRESHOLD_MS 10
+#define BWE_INITIAL_DELAY_THRESHOLD_MS 12.5
+
+// The estimate decreases to this ratio of the acked bitrate on overuse
+#define BWE_DECREASE_FACTOR 0.85
+// The estimate increases by 8% per second while the network is not congested
+#define BWE_INCREASE_FACTOR_PER_SECOND 1.08
+// The estimate does not increase above this ratio of the acked bitrate (the sender is application-limited)
+#define BWE_MAX_ACKED_BITRATE_RATIO 1.5
+#define BWE_ACKED_BITRATE_WINDOW_MS 500
+
+// Loss-based control: decrease if the loss rate is higher than the high threshold, increase if lower than the low threshold
+#define BWE_LOSS_LOW_THRESHOLD 0.02
+#define BWE_LOSS_HIGH_THRESHOLD 0.1
+#define BWE_LOSS_MIN_PACKET_COUNT 20
+#define BWE_LOSS_DECREASE_INTERVAL_MS 300
+
+// Send-side bandwidth estimator using the transport-wide congestion control feedback
+// (draft-ietf-rmcat-gcc, draft-holmer-rmcat-transport-wide-cc-extensions)
+//
+// - Delay-based: the packets are grouped into bursts, and the variation of the one-way delay between the groups
+//   is smoothed by a trendline filter. The slope of the trendline is compared with an adaptive threshold
+//   to detect overuse/underuse of the bottleneck, and an AIMD controller adjusts the estimate.
+// - Loss-based: the estimate is decreased if the loss rate reported by the feedback is high.
+//
+// All times are given by the caller (no clock is read inside), so that it can be driven by a network emulator.
+class SendSideBandwidthEstimator
+{
+public:
+	struct PacketResult
+	{
+		int64_t send_time_us = 0;
+		// -1 if the packet is not received
+		int64_t receive_time_us = -1;
+		size_t size = 0;
+
+		bool IsReceived() const
+		{
+			return receive_time_us >= 0;
+		}
+	};
+
+	enum class BandwidthUsage : uint8_t
+	{
+		Normal,
+		Underusing,
+		Overusing
+	};
+
+	SendSideBandwidthEstimator(uint32_t start_bitrate_bps, uint32_t min_bitrate_bps = BWE_MIN_BITRATE_BPS, uint32_t max_bitrate_bps = BWE_MAX_BITRATE_BPS);
+
+	// results: The packets of a feedback in the order of the transport-wide sequence number
+	void OnTransportFeedback(const std::vector<PacketResult> &results, int64_t now_ms);
+	// The estimate never exceeds the bitrate reported by REMB of the receiver
+	void OnRemb(uint32_t bitrate_bps);
+
+	uint32_t GetTargetBitrate() const;
+	// Bitrate received by the receiver, 0 if not known yet
+	uint32_t GetAckedBitrate() const;
+	double GetLossRate() const;
+	BandwidthUsage GetBandwidthUsage() const;
+
+	ov::String ToString() const;
+
+private:
+	enum class RateControlState : uint8_t
+	{
+		Hold,
+		Increase,
+		Decrease
+	};
+
+	struct PacketGroup
+	{
+		int64_t first_send_time_us = -1;
+		int64_t last_send_time_us = -1;
+		int64_t last_receive_time_us = -1;
+
+		bool IsValid() const
+		{
+			return first_send_time_us >= 0;
+		}
+	};
+
+	// Inter-arrival
+	void OnPacketReceived(const PacketResult &result, int64_t now_ms);
+	// Trendline filter
+	void OnGroupDelta(double send_delta_ms, double receive_delta_ms, int64_t arrival_time_ms, int64_t now_ms);
+	// Overuse detector
+	void Detect(double trend, double send_delta_ms, int64_t now_ms);
+	void UpdateThreshold(double modified_trend, int64_t now_ms);
+
+	void UpdateAckedBitrate(const PacketResult &result);
+	void UpdateDelayBasedBitrate(int64_t now_ms);
+	void UpdateLossBasedBitrate(int64_t now_ms);
+	void UpdateTargetBitrate();
+
+	uint32_t _min_bitrate_bps;
+	uint32_t _max_bitrate_bps;
+
+	// Inter-arrival
+	PacketGroup _current_group;
+	PacketGroup _previous_group;
+
+	// Trendline filter
+	int64_t _first_arrival_time_ms = -1;
+	double _accumulated_delay_ms = 0.0;
+	double _smoothed_delay_ms = 0.0;
+	uint32_t _delta_count = 0;
+	// (arrival time, smoothed delay)
+	std::deque<std::pair<double, double>> _delay_history;
+
+	// Overuse detector
+	double _threshold_ms = BWE_INITIAL_DELAY_THRESHOLD_MS;
+	int64_t _last_threshold_update_ms = -1;
+	double _time_over_using_ms = -1.0;
+	int _overuse_count = 0;
+	double _previous_trend = 0.0;
+	BandwidthUsage _bandwidth_usage = BandwidthUsage::Normal;
+
+	// Acked bitrate: (receive time, size)
+	std::deque<std::pair<int64_t, size_t>> _acked_history;
+	size_t _acked_bytes = 0;
+	uint32_t _acked_bitrate_bps = 0;
+
+	// AIMD rate controller
+	RateControlState _rate_control_state = RateControlState::Increase;
+	double _delay_based_bitrate_bps;
+	int64_t _last_rate_update_ms = -1;
+
+	// Loss-based controller
+	double _loss_based_bitrate_bps;
+	size_t _lost_packet_count = 0;
+	size_t _feedback_packet_count = 0;
+	double _loss_rate = 0.0;
+	int64_t _last_loss_decrease_ms = -1;
+
+	uint32_t _remb_bitrate_bps = 0;
+	uint32_t _target_bitrate_bps;
+};
@@ -0,0 +1,146 @@
+//==============================================================================
+//
+//  OvenMediaEngine
+//
+//  Created by Getroot
+//  Copyright (c) 2022 AirenSoft. All rights reserved.
+//
+//==============================================================================
+//
+// Standalone parse/serialize benchmark of the SDP module on real browser SDPs (corpus/*.sdp).
+// It is not a part of the OME build. Build and run it from src/projects:
+//
+//   g++ -std=c++17 -O2 -ffunction-sections -fdata-sections -Wl,--gc-sections -I. -Ithird_party -Ithird_party/jsoncpp-1.9.3/include \
+//       modules/sdp/benchmark/sdp_benchmark.cpp modules/sdp/*.cpp modules/ice/ice_candidate.cpp base/ovcrypto/base_64.cpp \
+//       base/ovsocket/socket_address.cpp base/ovsocket/ipv6_support.cpp base/ovlibrary/*.cpp third_party/jsoncpp-1.9.3/jsoncpp.cpp \
+//       -o /tmp/sdp_benchmark -lpthread -lssl -lcrypto -lz -lpcre2-8 && /tmp/sdp_benchmark modules/sdp/benchmark/corpus/*.sdp
+//
+// For each SDP, it checks that the serialized SDP is parsed back into the same text, and measures:
+//   - parse     : SessionDescription::FromString()
+//   - serialize : SessionDescription::Update() + ToString() (the media sections keep the text of their last Update())
+//   - template  : SessionDescription::CreateFromTemplate() + ToString(), which is done for every WebRTC offer
+//
+#include <base/ovlibrary/ovlibrary.h>
+#include <modules/sdp/session_description.h>
+
+#include <chrono>
+
+#define SDP_BENCHMARK_DEFAULT_ITERATIONS 20000
+
+namespace
+{
+	template <typename Tfunction>
+	double MeasureNsPerOp(int iterations, Tfunction function)
+	{
+		// Warm up
+		for (int i = 0; i < (iterations / 10) + 1; i++)
+		{
+			function(i);
+		}
+
+		auto start = std::chrono::steady_clock::now();
+		for (int i = 0; i < iterations; i++)
+		{
+			function(i);
+		}
+		auto elapsed = std::chrono::steady_clock::now() - start;
+
+		return static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count()) / iterations;
+	}
+
+	std::shared_ptr<SessionDescription> Parse(const ov::String &text)
+	{
+		auto sdp = std::make_shared<SessionDescription>();
+		if (sdp->FromString(text) == false)
+		{
+			return nullptr;
+		}
+
+		return sdp;
+	}
+
+	bool RunBenchmark(const char *file_name, int iterations)
+	{
+		auto data = ov::LoadFromFile(file_name);
+		if (data == nullptr)
+		{
+			printf("%s: Could not read the file\n", file_name);
+			return false;
+		}
+
+		ov::String text(data->GetDataAs<char>(), data->GetLength());
+
+		auto sdp = Parse(text);
+		if (sdp == nullptr)
+		{
+			printf("%s: Could not parse the SDP\n", file_name);
+			return false;
+		}
+
+		// Round trip
+		auto serialized = sdp->ToString();
+		auto reparsed = Parse(serialized);
+		if ((reparsed == nullptr) || (reparsed->ToString() != serialized))
+		{
+			printf("%s: The serialized SDP is not parsed back into the same SDP\n", file_name);
+			printf("----- serialized\n%s\n----- reparsed\n%s\n", serialized.CStr(), (reparsed != nullptr) ? reparsed->ToString().CStr() : "(failed)");
+			return false;
+		}
+
+		auto parse_ns = MeasureNsPerOp(iterations, [&](int) {
+			Parse(text);
+		});
+
+		auto serialize_ns = MeasureNsPerOp(iterations, [&](int) {
+			sdp->Update();
+			sdp->ToString();
+		});
+
+		sdp->Update();
+		auto template_ns = MeasureNsPerOp(iterations, [&](int i) {
+			auto offer = sdp->CreateFromTemplate(i, "ufrag", "password");
+			offer->ToString();
+		});
+
+		auto to_ops = [](double ns) {
+			return (ns > 0.0) ? (1000000000.0 / ns) : 0.0;
+		};
+
+		printf("%-24s %7zu %11.0f %11.0f %11.0f %11.0f %11.0f %11.0f\n",
+			   ov::PathManager::ExtractFileName(file_name).CStr(), static_cast<size_t>(text.GetLength()),
+			   parse_ns / 1000.0, to_ops(parse_ns),
+			   serialize_ns / 1000.0, to_ops(serialize_ns),
+			   template_ns / 1000.0, to_ops(template_ns));
+
+		return true;
+	}
+}  // namespace
+
+int main(int argc, char *argv[])
+{
+	if (argc < 2)
+	{
+		printf("Usage: %s [-n <iterations>] <file.sdp> [<file.sdp> ...]\n", argv[0]);
+		return 1;
+	}
+
+	ov_log_set_level(OVLogLevelWarning);
+
+	int iterations = SDP_BENCHMARK_DEFAULT_ITERATIONS;
+	int index = 1;
+	if ((argc > 2) && (::strcmp(argv[1], "-n") == 0))
+	{
+		iterations = std::max(1, ::atoi(argv[2]));
+		index = 3;
+	}
+
+	printf("%-24s %7s %11s %11s %11s %11s %11s %11s\n", "SDP", "bytes", "parse(us)", "parse/s", "serial(us)", "serial/s", "templ(us)", "templ/s");
+
+	bool succeeded = true;
+	for (; index < argc; index++)
+	{
+		succeeded = RunBenchmark(argv[index], iterations) && succeeded;
+	}
+
+	return succeeded ? 0 : 1;
+}
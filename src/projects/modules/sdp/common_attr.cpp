@@ -9,9 +9,7 @@
 
 #include "common_attr.h"
 
-#include <regex>
-
-#include "sdp_regex_pattern.h"
+#include "sdp_tokenizer.h"
 
 CommonAttr::CommonAttr()
 {
@@ -23,149 +21,125 @@ CommonAttr::~CommonAttr()
 
 bool CommonAttr::SerializeCommonAttr(ov::String &sdp)
 {
-	sdp = "";
+	ov::String before_ice_credentials;
+	ov::String after_ice_credentials;
+
+	if (SerializeCommonAttr(before_ice_credentials, after_ice_credentials) == false)
+	{
+		return false;
+	}
+
+	sdp = before_ice_credentials;
+
+	// ice-ufrag, ice-password
+	sdp.Append(SerializeIceCredentials(_ice_ufrag, _ice_pwd));
+
+	sdp.Append(after_ice_credentials);
+
+	return true;
+}
+
+bool CommonAttr::SerializeCommonAttr(ov::String &before_ice_credentials, ov::String &after_ice_credentials)
+{
+	before_ice_credentials = "";
+	after_ice_credentials = "";
 
 	// FINGERPRINT
 	if (!_fingerprint_algorithm.IsEmpty() && !_fingerprint_value.IsEmpty())
 	{
-		sdp.AppendFormat("a=fingerprint:%s %s\r\n",
-						 _fingerprint_algorithm.CStr(), _fingerprint_value.CStr());
+		before_ice_credentials.AppendFormat("a=fingerprint:%s %s\r\n",
+											_fingerprint_algorithm.CStr(), _fingerprint_value.CStr());
 	}
 
 	// ICE-OPTION
 	if (!_ice_option.IsEmpty())
 	{
-		sdp.AppendFormat("a=ice-options:%s\r\n", _ice_option.CStr());
-	}
-
-	// ice-ufrag, ice-password
-	if (!_ice_ufrag.IsEmpty() && !_ice_pwd.IsEmpty())
-	{
-		sdp.AppendFormat(
-			"a=ice-ufrag:%s\r\n"
-			"a=ice-pwd:%s\r\n",
-			_ice_ufrag.CStr(),
-			_ice_pwd.CStr());
+		before_ice_credentials.AppendFormat("a=ice-options:%s\r\n", _ice_option.CStr());
 	}
 
 	// ICE candidates
 	for (auto &candidate : _ice_candidates)
 	{
-		sdp.AppendFormat("a=%s\r\n", candidate->ToString().CStr());
+		after_ice_credentials.AppendFormat("a=%s\r\n", candidate->ToString().CStr());
 	}
 
 	if (_ice_candidates.empty() == false)
 	{
-		sdp.AppendFormat("a=end-of-candidates\r\n");
+		after_ice_credentials.AppendFormat("a=end-of-candidates\r\n");
 	}
 
 	// control
 	if (!_control.IsEmpty())
 	{
-		sdp.AppendFormat("a=control:%s\r\n", _control.CStr());
+		after_ice_credentials.AppendFormat("a=control:%s\r\n", _control.CStr());
 	}
 
 	return true;
 }
 
-bool CommonAttr::ParsingCommonAttrLine(char type, std::string content)
+ov::String CommonAttr::SerializeIceCredentials(const ov::String &ice_ufrag, const ov::String &ice_pwd)
 {
-	std::smatch matches;
+	if (ice_ufrag.IsEmpty() || ice_pwd.IsEmpty())
+	{
+		return "";
+	}
+
+	ov::String sdp(static_cast<uint32_t>(ice_ufrag.GetLength() + ice_pwd.GetLength() + 32));
+
+	sdp.Append("a=ice-ufrag:");
+	sdp.Append(ice_ufrag);
+	sdp.Append("\r\na=ice-pwd:");
+	sdp.Append(ice_pwd);
+	sdp.Append("\r\n");
+
+	return sdp;
+}
+
+bool CommonAttr::ParsingCommonAttrLine(char type, std::string_view content)
+{
+	SdpTokenizer tokenizer(content);
 
 	// a=fingerprint:sha-256 D7:81:CF:01:46:FB:2D
-	if (content.compare(0, OV_COUNTOF("fi") - 1, "fi") == 0)
+	if (tokenizer.Skip("fingerprint:"))
 	{
-		/*
-		if(std::regex_search(content, matches, std::regex("^fingerprint:(\\S*) (\\S*)")))
-		{
-			_fingerprint_algorithm = std::string(matches[1]).c_str();
-			_fingerprint_value = std::string(matches[2]).c_str();
-		}
-		*/
-		auto match = SDPRegexPattern::GetInstance()->MatchFingerprint(content.c_str());
-		if (match.GetGroupCount() != 2 + 1)
+		// ^fingerprint:(\S*) (\S*)
+		auto algorithm = tokenizer.NextToken();
+		if (tokenizer.Skip(' ') == false)
 		{
 			return false;
 		}
 
-		_fingerprint_algorithm = match.GetGroupAt(1).GetValue();
-		_fingerprint_value = match.GetGroupAt(2).GetValue();
+		_fingerprint_algorithm = SdpTokenizer::ToString(algorithm);
+		_fingerprint_value = SdpTokenizer::ToString(tokenizer.NextToken());
 	}
 	// a=ice-options:trickle
-	else if (content.compare(0, OV_COUNTOF("ice-o") - 1, "ice-o") == 0)
+	else if (tokenizer.Skip("ice-options:"))
 	{
-		/*
-		if(std::regex_search(content, matches, std::regex("^ice-options:(\\S*)")))
-		{
-			_ice_option = std::string(matches[1]).c_str();
-		}
-		*/
-
-		auto match = SDPRegexPattern::GetInstance()->MatchIceOption(content.c_str());
-		if (match.GetGroupCount() != 1 + 1)
-		{
-			return false;
-		}
-
-		_ice_option = match.GetGroupAt(1).GetValue();
+		_ice_option = SdpTokenizer::ToString(tokenizer.NextToken());
 	}
 	// a=ice-ufrag:0dfa46c9
-	else if (content.compare(0, OV_COUNTOF("ice-u") - 1, "ice-u") == 0)
+	else if (tokenizer.Skip("ice-ufrag:"))
 	{
-		/*
-		if(std::regex_search(content, matches, std::regex("^ice-ufrag:(\\S*)")))
-		{
-			_ice_ufrag = std::string(matches[1]).c_str();
-		}
-		*/
-		auto match = SDPRegexPattern::GetInstance()->MatchIceUfrag(content.c_str());
-		if (match.GetGroupCount() != 1 + 1)
-		{
-			return false;
-		}
-
-		_ice_ufrag = match.GetGroupAt(1).GetValue();
+		_ice_ufrag = SdpTokenizer::ToString(tokenizer.NextToken());
 	}
-	else if (content.compare(0, OV_COUNTOF("ice-p") - 1, "ice-p") == 0)
+	// a=ice-pwd:c32d4070c67e9782bea90a9ab46ea838
+	else if (tokenizer.Skip("ice-pwd:"))
 	{
-		/*
-		if(std::regex_search(content, matches, std::regex("^ice-pwd:(\\S*)")))
-		{
-			_ice_pwd = std::string(matches[1]).c_str();
-		}
-		*/
-		auto match = SDPRegexPattern::GetInstance()->MatchIcePwd(content.c_str());
-		if (match.GetGroupCount() != 1 + 1)
-		{
-			return false;
-		}
-
-		_ice_pwd = match.GetGroupAt(1).GetValue();
+		_ice_pwd = SdpTokenizer::ToString(tokenizer.NextToken());
 	}
 	else if (content.compare(0, OV_COUNTOF("cand") - 1, "cand") == 0)
 	{
 		// candidate:1 1 UDP 2130706431 198.51.100.1 39132 typ host
 		auto candidate = std::make_shared<IceCandidate>();
-		if (candidate->ParseFromString(content.c_str()) == true)
+		if (candidate->ParseFromString(SdpTokenizer::ToString(content)) == true)
 		{
 			AddIceCandidate(candidate);
 		}
 	}
-	else if (content.compare(0, OV_COUNTOF("con") - 1, "con") == 0)
+	// a=control:trackID=1
+	else if (tokenizer.Skip("control:"))
 	{
-		/*
-		if(std::regex_search(content, matches, std::regex("^control:(\\S*)")))
-		{
-			_control = std::string(matches[1]).c_str();
-		}
-		*/
-		auto match = SDPRegexPattern::GetInstance()->MatchControl(content.c_str());
-		if (match.GetGroupCount() != 1 + 1)
-		{
-			return false;
-		}
-
-		_control = match.GetGroupAt(1).GetValue();
+		_control = SdpTokenizer::ToString(tokenizer.NextToken());
 	}
 	else
 	{
@@ -8,6 +8,8 @@
 //==============================================================================
 
 #pragma once
+#include <string_view>
+
 #include "modules/ice/ice_candidate.h"
 #include "sdp_base.h"
 
@@ -19,7 +21,10 @@ protected:
 	~CommonAttr();
 
 	bool SerializeCommonAttr(ov::String& sdp);
-	bool ParsingCommonAttrLine(char type, std::string content);
+	// Serializes the attributes except a=ice-ufrag/a=ice-pwd, which are placed between the two parts
+	bool SerializeCommonAttr(ov::String& before_ice_credentials, ov::String& after_ice_credentials);
+	static ov::String SerializeIceCredentials(const ov::String& ice_ufrag, const ov::String& ice_pwd);
+	bool ParsingCommonAttrLine(char type, std::string_view content);
 
 public:
 	// a=fingerprint:sha-256 D7:81:CF:01:46:FB:2D
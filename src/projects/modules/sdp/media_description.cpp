@@ -9,9 +9,7 @@
 
 #include "media_description.h"
 
-#include <regex>
-
-#include "sdp_regex_pattern.h"
+#include "sdp_tokenizer.h"
 #include "session_description.h"
 
 MediaDescription::MediaDescription()
@@ -32,7 +30,8 @@ bool MediaDescription::UpdateData(ov::String &sdp)
 	// Append Payload id
 	for (auto &payload : _payload_list)
 	{
-		if (payload->GetId() == 0)
+		// 0 is PCMU, which is a valid static payload type, so only a payload that has never been set up is rejected
+		if ((payload->GetId() == 0) && payload->GetCodecStr().IsEmpty())
 		{
 			return false;
 		}
@@ -182,22 +181,23 @@ bool MediaDescription::SetMediaType(const ov::String &type)
 
 bool MediaDescription::FromString(const ov::String &desc)
 {
-	std::stringstream sdpstream(desc.CStr());
-	std::string line;
+	SdpTokenizer tokenizer(std::string_view(desc.CStr(), desc.GetLength()));
+	std::string_view line;
 
-	while (std::getline(sdpstream, line, '\n'))
+	while (tokenizer.NextLine(line))
 	{
-		if (line.size() && line[line.length() - 1] == '\r')
+		// ^([a-z])=(.*)
+		if ((line.size() < 2) || (line[0] < 'a') || (line[0] > 'z') || (line[1] != '='))
 		{
-			line.pop_back();
+			continue;
 		}
 
 		char type = line[0];
-		std::string content = line.substr(2);
+		auto content = line.substr(2);
 
 		if (ParsingMediaLine(type, content) == false)
 		{
-			logw("SDP", "Could not parse line: %c: %s (%s)", type, content.c_str(), line.c_str());
+			logw("SDP", "Could not parse line: %c: %.*s", type, static_cast<int>(content.size()), content.data());
 			return false;
 		}
 	}
@@ -233,79 +233,40 @@ bool MediaDescription::SetDirection(const ov::String &dir)
 	return true;
 }
 
-bool MediaDescription::ParsingMediaLine(char type, std::string content)
+bool MediaDescription::ParsingMediaLine(char type, std::string_view content)
 {
 	bool parsing_error = false;
-	std::smatch matches;
+	SdpTokenizer tokenizer(content);
 
 	switch (type)
 	{
 		case 'm':
 			// m=video 9 UDP/TLS/RTP/SAVPF 97
-			/*
-			if(std::regex_search(content, matches, std::regex("^(\\w*) (\\d*) ([\\w\\/]*)(?: (.*))?")))
+			// ^(\w*) (\d*) ([\w\/]*)(?: (.*))?
 			{
-				if(matches.size() < 4 + 1)
-				{
-					parsing_error = true;
-					break;
-				}
-
-				if(!SetMediaType(std::string(matches[1]).c_str()))
-				{
-					parsing_error = true;
-					break;
-				}
-
-				SetPort(std::stoul(matches[2]));
-
-				ov::String protocol = std::string(matches[3]).c_str();
-				if(protocol.UpperCaseString() == "UDP/TLS/RTP/SAVPF")
-				{
-					UseDtls(true);
-				}
-				else if(protocol.UpperCaseString() == "RTP/AVPF" || protocol.UpperCaseString() == "RTP/AVP")
-				{
-					UseDtls(false);
-				}
-				else
+				auto media_type = tokenizer.NextWord();
+				if (tokenizer.Skip(' ') == false)
 				{
-					loge("SDP", "Cannot support %s protocol", protocol.CStr());
 					parsing_error = true;
 					break;
 				}
 
-				std::string payload_number;
-				std::stringstream payload_numbers(matches[4]);
-				while(std::getline(payload_numbers, payload_number, ' '))
-				{
-					auto payload = std::make_shared<PayloadAttr>();
-					payload->SetId(static_cast<uint8_t>(std::stoul(payload_number)));
-					AddPayload(payload);
-				}
-			}
-			else
-			{
-				parsing_error = true;
-			}
-			*/
-			{
-				auto match = SDPRegexPattern::GetInstance()->MatchMedia(content.c_str());
-				if (match.GetGroupCount() != 4 + 1)
+				auto port = tokenizer.NextDigits();
+				if (tokenizer.Skip(' ') == false)
 				{
 					parsing_error = true;
 					break;
 				}
 
-				if (!SetMediaType(match.GetGroupAt(1).GetValue()))
+				if (!SetMediaType(SdpTokenizer::ToString(media_type)))
 				{
 					parsing_error = true;
 					break;
 				}
 
-				SetPort(ov::Converter::ToUInt32(match.GetGroupAt(2).GetValue().CStr()));
+				SetPort(SdpTokenizer::ToUInt32(port));
 
-				ov::String protocol = match.GetGroupAt(3).GetValue();
+				ov::String protocol = SdpTokenizer::ToString(tokenizer.NextToken());
 				if (protocol.UpperCaseString() == "UDP/TLS/RTP/SAVPF")
 				{
 					UseDtls(true);
@@ -321,353 +282,284 @@ bool MediaDescription::ParsingMediaLine(char type, std::string content)
 					break;
 				}
 
-				auto payload_numbers = match.GetGroupAt(4).GetValue();
-				auto items = payload_numbers.Split(" ");
-				for (const auto &item : items)
+				while (tokenizer.Skip(' '))
 				{
+					auto payload_number = tokenizer.NextToken();
+					if (payload_number.empty())
+					{
+						continue;
+					}
+
 					auto payload = std::make_shared<PayloadAttr>();
-					payload->SetId(ov::Converter::ToUInt32(item.CStr()));
+					payload->SetId(SdpTokenizer::ToUInt32(payload_number));
 					AddPayload(payload);
 				}
 			}
 			break;
+
 		case 'c':
 			// c=IN IP4 0.0.0.0
-			/*
-			if(std::regex_search(content, matches, std::regex("^IN IP(\\d) (\\S*)")))
+			// ^IN IP(\d) (\S*)
 			{
-				if(matches.size() != 2 + 1)
+				if (tokenizer.Skip("IN IP") == false)
 				{
-					parsing_error = true;
 					break;
 				}
 
-				SetConnection(std::stoul(matches[1]), std::string(matches[2]).c_str());
-			}
-			else
-			{
-				parsing_error = true;
-			}
-			*/
-
-			{
-				auto match = SDPRegexPattern::GetInstance()->MatchConnection(content.c_str());
-				if (match.GetGroupCount() != 2 + 1)
+				auto ip_version = tokenizer.NextWhile([](char c) { return SdpTokenizer::IsDigit(c); });
+				if ((ip_version.size() != 1) || (tokenizer.Skip(' ') == false))
 				{
 					break;
 				}
 
 				SetConnection(
-					ov::Converter::ToUInt32(match.GetGroupAt(1).GetValue().CStr()),
-					match.GetGroupAt(2).GetValue());
+					SdpTokenizer::ToUInt32(ip_version),
+					SdpTokenizer::ToString(tokenizer.NextToken()));
 			}
 			break;
 
 		case 'a':
-			// For Performance
-			if (content.compare(0, OV_COUNTOF("rtp") - 1, "rtp") == 0)
+			// a=rtpmap:96 VP8/50000/?
+			// rtpmap:(\d*) ([\w\-\.]*)(?:\s*\/(\d*)(?:\s*\/(\S*))?)?
+			if (tokenizer.Skip("rtpmap:"))
 			{
-				// a=rtpmap:96 VP8/50000/?
-				/*
-				if(std::regex_search(content,
-				                     matches,
-				                     std::regex("rtpmap:(\\d*) ([\\w\\-\\.]*)(?:\\s*\\/(\\d*)(?:\\s*\\/(\\S*))?)?")))
+				auto payload_type = tokenizer.NextDigits();
+				if (tokenizer.Skip(' ') == false)
 				{
-					if(matches.size() < 3 + 1)
-					{
-						parsing_error = true;
-						break;
-					}
-
-					AddRtpmap(static_cast<uint8_t>(std::stoul(matches[1])), std::string(matches[2]).c_str(),
-					          static_cast<uint32_t>(std::stoul(matches[3])), std::string(matches[4]).c_str());
+					parsing_error = true;
+					break;
 				}
-				*/
-				auto match = SDPRegexPattern::GetInstance()->MatchRtpmap(content.c_str());
-				if (match.GetGroupCount() < 3 + 1)
+
+				auto codec = tokenizer.NextWhile([](char c) { return SdpTokenizer::IsWord(c) || (c == '-') || (c == '.'); });
+
+				tokenizer.SkipSpaces();
+				if (tokenizer.Skip('/') == false)
 				{
 					parsing_error = true;
 					break;
 				}
 
+				auto rate = tokenizer.NextDigits();
+				std::string_view parameters;
+
+				tokenizer.SkipSpaces();
+				if (tokenizer.Skip('/'))
+				{
+					parameters = tokenizer.NextToken();
+				}
+
 				AddRtpmap(
-					ov::Converter::ToUInt32(match.GetGroupAt(1).GetValue().CStr()),
-					match.GetGroupAt(2).GetValue(),
-					ov::Converter::ToUInt32(match.GetGroupAt(3).GetValue().CStr()),
-					match.GetGroupAt(4).GetValue());
+					SdpTokenizer::ToUInt32(payload_type),
+					SdpTokenizer::ToString(codec),
+					SdpTokenizer::ToUInt32(rate),
+					SdpTokenizer::ToString(parameters));
 			}
 			// a=rtcp-mux
-			else if (content.compare(0, OV_COUNTOF("rtcp-m") - 1, "rtcp-m") == 0)
+			else if (tokenizer.Skip("rtcp-mux"))
 			{
-				/*
-				if(std::regex_search(content, matches, std::regex("^(rtcp-mux)")))
-				{
-					UseRtcpMux(true);
-				}
-				*/
-				auto match = SDPRegexPattern::GetInstance()->MatchRtcpMux(content.c_str());
-				if (match.GetError() == nullptr)
-				{
-					UseRtcpMux(true);
-				}
+				UseRtcpMux(true);
 			}
-			else if (content.compare(0, OV_COUNTOF("rtcp-r") - 1, "rtcp-r") == 0)
+			// a=rtcp-rsize
+			else if (tokenizer.Skip("rtcp-rsize"))
 			{
-				/*
-				if(std::regex_search(content, matches, std::regex("^(rtcp-rsize)")))
-				{
-					UseRtcpRsize(true);
-				}
-				*/
-				auto match = SDPRegexPattern::GetInstance()->MatchRtcpRsize(content.c_str());
-				if (match.GetError() == nullptr)
-				{
-					UseRtcpRsize(true);
-				}
+				UseRtcpRsize(true);
 			}
-			else if (content.compare(0, OV_COUNTOF("rtcp-f") - 1, "rtcp-f") == 0)
+			else if (tokenizer.Skip("rtcp-fb:"))
 			{
 				//TODO(Getroot): Implement full spec
 				//https://datatracker.ietf.org/doc/html/rfc5104#section-7.1
 				// a=rtcp-fb:96 nack pli
-				/*
-				if(std::regex_search(content,
-				                     matches,
-				                     std::regex("rtcp-fb:(\\*|\\d*) (.*)")))
+				// rtcp-fb:(\*|\d*) (.*)
+				uint32_t id = 0;
+				if (tokenizer.Skip('*') == false)
 				{
-					if(matches.size() != 2 + 1)
-					{
-						parsing_error = true;
-						break;
-					}
-
-					EnableRtcpFb(static_cast<uint8_t>(std::stoul(matches[1])), std::string(matches[2]).c_str(), true);
+					id = SdpTokenizer::ToUInt32(tokenizer.NextDigits());
 				}
-				*/
 
-				auto match = SDPRegexPattern::GetInstance()->MatchRtcpFb(content.c_str());
-				if (match.GetGroupCount() != 2 + 1)
+				if (tokenizer.Skip(' ') == false)
 				{
 					parsing_error = true;
 					break;
 				}
 
-				EnableRtcpFb(
-					ov::Converter::ToUInt32(match.GetGroupAt(1).GetValue().CStr()),
-					match.GetGroupAt(2).GetValue(),
-					true);
+				EnableRtcpFb(id, SdpTokenizer::ToString(tokenizer.NextAll()), true);
+			}
+			else if (content.compare(0, OV_COUNTOF("rtcp-f") - 1, "rtcp-f") == 0)
+			{
+				parsing_error = true;
 			}
 			else if (content.compare(0, OV_COUNTOF("mid") - 1, "mid") == 0)
 			{
-				// a=mid:video,
-				/*
-				if(std::regex_search(content, matches, std::regex("^mid:([^\\s]*)")))
-				{
-					if(matches.size() != 1 + 1)
-					{
-						parsing_error = true;
-						break;
-					}
-
-					SetMid(std::string(matches[1]).c_str());
-				}
-				*/
-				auto match = SDPRegexPattern::GetInstance()->MatchMid(content.c_str());
-				if (match.GetGroupCount() != 1 + 1)
+				// a=mid:video
+				// ^mid:([^\s]*)
+				if (tokenizer.Skip("mid:") == false)
 				{
 					parsing_error = true;
 					break;
 				}
 
-				SetMid(match.GetGroupAt(1).GetValue());
+				SetMid(SdpTokenizer::ToString(tokenizer.NextToken()));
 			}
 			else if (content.compare(0, OV_COUNTOF("msid") - 1, "msid") == 0)
 			{
 				// a=msid:0nm3jPz5YtRJ1NF26G9IKrUCBlWavuwbeiSf 6jHsvxRPcpiEVZbA5QegGowmCtOlh8kTaXJ4
-				/*
-				if(std::regex_search(content, matches, std::regex("^msid:(.*) (.*)")))
+				// ^msid:(.*) (.*) - the last space separates msid and appdata
+				if (tokenizer.Skip("msid:") == false)
 				{
-					if(matches.size() != 2 + 1)
-					{
-						parsing_error = true;
-						break;
-					}
-
-					SetMsid(std::string(matches[1]).c_str(), std::string(matches[2]).c_str());
+					parsing_error = true;
+					break;
 				}
-				*/
-				auto match = SDPRegexPattern::GetInstance()->MatchMsid(content.c_str());
-				if (match.GetGroupCount() != 2 + 1)
+
+				auto value = tokenizer.NextAll();
+				auto index = value.rfind(' ');
+				if (index == std::string_view::npos)
 				{
 					parsing_error = true;
 					break;
 				}
 
 				SetMsid(
-					match.GetGroupAt(1).GetValue(),
-					match.GetGroupAt(2).GetValue());
+					SdpTokenizer::ToString(value.substr(0, index)),
+					SdpTokenizer::ToString(value.substr(index + 1)));
 			}
 			else if (content.compare(0, OV_COUNTOF("set") - 1, "set") == 0)
 			{
 				// a=setup:actpass
-				/*
-				if(std::regex_search(content, matches, std::regex("^setup:(\\w*)")))
-				{
-					if(matches.size() != 1 + 1)
-					{
-						parsing_error = true;
-						break;
-					}
-
-					SetSetup(std::string(matches[1]).c_str());
-				}
-				*/
-				auto match = SDPRegexPattern::GetInstance()->MatchSetup(content.c_str());
-				if (match.GetGroupCount() != 1 + 1)
+				// ^setup:(\w*)
+				if (tokenizer.Skip("setup:") == false)
 				{
 					parsing_error = true;
 					break;
 				}
 
-				SetSetup(match.GetGroupAt(1).GetValue());
+				SetSetup(SdpTokenizer::ToString(tokenizer.NextWord()));
 			}
-			else if (content.compare(0, OV_COUNTOF("ss") - 1, "ss") == 0)
+			else if (tokenizer.Skip("ssrc:"))
 			{
 				// a=ssrc:2064629418 cname:{b2266c86-259f-4853-8662-ea94cf0835a3}
-				/*
-				if(std::regex_search(content, matches, std::regex("^ssrc:(\\d*) cname(?::(.*))?")))
+				// ^ssrc:(\d*) cname(?::(.*))?
+				auto ssrc = tokenizer.NextDigits();
+				if (tokenizer.Skip(" cname") == false)
 				{
-					if(matches.size() != 2 + 1)
-					{
-						parsing_error = true;
-						break;
-					}
-					SetSsrc(stoul(matches[1]));
-					SetCname(std::string(matches[2]).c_str());
+					// a=ssrc:<ssrc> msid/mslabel/label is not used
+					break;
 				}
-				else if(std::regex_search(content, matches, std::regex("^ssrc-group:FID ([0-9]*) ([0-9]*)")))
-				{
-					if(matches.size() != 2 + 1)
-					{
-						parsing_error = true;
-						break;
-					}
 
-					SetSsrc(stoul(matches[1]));
-					SetRtxSsrc(stoul(matches[2]));
+				std::string_view cname;
+				if (tokenizer.Skip(':'))
+				{
+					cname = tokenizer.NextAll();
 				}
-				*/
 
-				auto match = SDPRegexPattern::GetInstance()->MatchSsrcCname(content.c_str());
-				if (match.GetError() == nullptr)
+				// a=ssrc-group:FID may come before a=ssrc (Safari), so the RTX SSRC must not replace the primary SSRC
+				auto ssrc_value = SdpTokenizer::ToUInt32(ssrc);
+				if ((_rtx_ssrc == 0) || (ssrc_value != _rtx_ssrc))
 				{
-					if (match.GetGroupCount() != 2 + 1)
-					{
-						parsing_error = true;
-						break;
-					}
-
-					SetSsrc(ov::Converter::ToUInt32(match.GetGroupAt(1).GetValue().CStr()));
-					SetCname(match.GetGroupAt(2).GetValue());
+					SetSsrc(ssrc_value);
 				}
-				else
+				SetCname(SdpTokenizer::ToString(cname));
+			}
+			else if (tokenizer.Skip("ssrc-group:FID "))
+			{
+				// a=ssrc-group:FID 2064629418 2064629419
+				// ^ssrc-group:FID ([0-9]*) ([0-9]*)
+				auto ssrc = tokenizer.NextDigits();
+				if (tokenizer.Skip(' ') == false)
 				{
-					auto match = SDPRegexPattern::GetInstance()->MatchSsrcFid(content.c_str());
-					if (match.GetError() == nullptr)
-					{
-						if (match.GetGroupCount() != 2 + 1)
-						{
-							parsing_error = true;
-							break;
-						}
-
-						SetSsrc(ov::Converter::ToUInt32(match.GetGroupAt(1).GetValue().CStr()));
-						SetRtxSsrc(ov::Converter::ToUInt32(match.GetGroupAt(2).GetValue().CStr()));
-					}
-					else
-					{
-						// unknown pattern
-					}
+					// unknown pattern
+					break;
 				}
+
+				SetSsrc(SdpTokenizer::ToUInt32(ssrc));
+				SetRtxSsrc(SdpTokenizer::ToUInt32(tokenizer.NextDigits()));
+			}
+			else if (content.compare(0, OV_COUNTOF("ss") - 1, "ss") == 0)
+			{
+				// unknown pattern
 			}
 			else if (content.compare(0, OV_COUNTOF("fra") - 1, "fra") == 0)
 			{
 				// a=framerate:29.97
-				/*
-				if(std::regex_search(content, matches, std::regex("^framerate:(\\d+(?:$|\\.\\d+))")))
+				// ^framerate:(\d+(?:$|\.\d+))
+				bool matched = false;
+				std::string_view framerate;
+
+				if (tokenizer.Skip("framerate:"))
 				{
-					if(matches.size() != 1 + 1)
+					auto value = tokenizer.GetRemaining();
+					auto integer = tokenizer.NextDigits();
+
+					if (integer.empty() == false)
 					{
-						parsing_error = true;
-						break;
-					}
+						if (tokenizer.IsEnd())
+						{
+							matched = true;
+						}
+						else if (tokenizer.Skip('.') && (tokenizer.NextDigits().empty() == false))
+						{
+							matched = true;
+						}
 
-					SetFramerate(std::stof(matches[1]));
+						framerate = value.substr(0, value.size() - tokenizer.GetRemaining().size());
+					}
 				}
-				*/
 
-				auto match = SDPRegexPattern::GetInstance()->MatchFramerate(content.c_str());
-				if (match.GetGroupCount() != 1 + 1)
+				if (matched == false)
 				{
 					// Not critical error
 					// parsing_error = true;
-					logw("SDP", "Sdp parsing error : %c=%s", type, content.c_str());
-
+					logw("SDP", "Sdp parsing error : %c=%.*s", type, static_cast<int>(content.size()), content.data());
 					break;
 				}
 
-				SetFramerate(ov::Converter::ToFloat(match.GetGroupAt(1).GetValue().CStr()));
+				SetFramerate(ov::Converter::ToFloat(SdpTokenizer::ToString(framerate).CStr()));
 			}
 			// a=sendonly
 			else if (content.compare(0, OV_COUNTOF("se") - 1, "se") == 0 ||
 					 content.compare(0, OV_COUNTOF("re") - 1, "re") == 0 ||
 					 content.compare(0, OV_COUNTOF("in") - 1, "in") == 0)
 			{
-				/*
-				if(std::regex_search(content, matches, std::regex("^(sendrecv|recvonly|sendonly|inactive)")))
-				{
-					if(matches.size() != 1 + 1)
-					{
-						parsing_error = true;
-						break;
-					}
+				// ^(sendrecv|recvonly|sendonly|inactive)
+				ov::String direction;
 
-					if(!SetDirection(std::string(matches[1]).c_str()))
+				for (auto candidate : {"sendrecv", "recvonly", "sendonly", "inactive"})
+				{
+					if (tokenizer.Skip(candidate))
 					{
-						parsing_error = true;
+						direction = candidate;
 						break;
 					}
 				}
-				*/
 
-				auto match = SDPRegexPattern::GetInstance()->MatchDirection(content.c_str());
-				if (match.GetGroupCount() != 1 + 1)
+				if (direction.IsEmpty())
 				{
 					parsing_error = true;
 					break;
 				}
 
-				SetDirection(match.GetGroupAt(1).GetValue());
+				SetDirection(direction);
 			}
-			else if (content.compare(0, OV_COUNTOF("fmtp") - 1, "fmtp") == 0)
+			else if (tokenizer.Skip("fmtp:"))
 			{
-				/*
-				if(std::regex_search(content, matches, std::regex("fmtp:(\\*|\\d*) (.*)")))
+				// a=fmtp:96 packetization-mode=1;profile-level-id=42e01f;level-asymmetry-allowed=1
+				// fmtp:(\*|\d*) (.*)
+				uint32_t id = 0;
+				if (tokenizer.Skip('*') == false)
 				{
-					SetFmtp(static_cast<uint8_t>(std::stoul(matches[1])), std::string(matches[2]).c_str());
+					id = SdpTokenizer::ToUInt32(tokenizer.NextDigits());
 				}
-				*/
 
-				auto match = SDPRegexPattern::GetInstance()->MatchFmtp(content.c_str());
-				if (match.GetGroupCount() != 2 + 1)
+				if (tokenizer.Skip(' ') == false)
 				{
 					parsing_error = true;
 					break;
 				}
 
-				SetFmtp(
-					ov::Converter::ToUInt32(match.GetGroupAt(1).GetValue().CStr()),
-					match.GetGroupAt(2).GetValue());
+				SetFmtp(id, SdpTokenizer::ToString(tokenizer.NextAll()));
+			}
+			else if (content.compare(0, OV_COUNTOF("fmtp") - 1, "fmtp") == 0)
+			{
+				parsing_error = true;
 			}
 			else if (content.compare(0, OV_COUNTOF("rtcp:") - 1, "rtcp:") == 0)
 			{
@@ -676,41 +568,22 @@ bool MediaDescription::ParsingMediaLine(char type, std::string content)
 			else if (content.compare(0, OV_COUNTOF("ext") - 1, "ext") == 0)
 			{
 				// a=extmap:1[/direction] urn:ietf:params:rtp-hdrext:framemarking
-				/*
-				if(std::regex_search(content,
-				                     matches,
-				                     std::regex("extmap:(\\*|\\d*) (.*)")))
-				{
-					if(matches.size() != 2 + 1)
-					{
-						parsing_error = true;
-						break;
-					}
-
-					AddExtmap(static_cast<uint8_t>(std::stoul(matches[1])), std::string(matches[2]).c_str());
-				}
-				*/
-
-				auto match = SDPRegexPattern::GetInstance()->MatchExtmap(content.c_str());
-				if (match.GetGroupCount() < 2 + 1)
+				// ^extmap:([\w_/]*) (\S*)(?: (\S*))?
+				if (tokenizer.Skip("extmap:") == false)
 				{
 					break;
 				}
 
-				auto value = match.GetGroupAt(1).GetValue();
-				uint8_t id = 0;
-				if (value.IndexOf("/") == -1)
+				auto value = tokenizer.NextWhile([](char c) { return SdpTokenizer::IsWord(c) || (c == '/'); });
+				if (tokenizer.Skip(' ') == false)
 				{
-					id = ov::Converter::ToUInt32(value.CStr());
-				}
-				else
-				{
-					id = ov::Converter::ToUInt32(value.Left(value.IndexOf("/")).CStr());
+					break;
 				}
 
+				// The direction is not used
 				AddExtmap(
-					id,
-					match.GetGroupAt(2).GetValue());
+					SdpTokenizer::ToUInt32(value.substr(0, value.find('/'))),
+					SdpTokenizer::ToString(tokenizer.NextToken()));
 			}
 			else if (ParsingCommonAttrLine(type, content))
 			{
@@ -718,18 +591,18 @@ bool MediaDescription::ParsingMediaLine(char type, std::string content)
 			else
 			{
 				// Other attributes are ignored because they are not required.
-				logd("SDP", "Unknown Attributes : %c=%s", type, content.c_str());
+				logd("SDP", "Unknown Attributes : %c=%.*s", type, static_cast<int>(content.size()), content.data());
 			}
-
 			break;
+
 		default:
-			logd("SDP", "Unknown Attributes : %c=%s", type, content.c_str());
+			logd("SDP", "Unknown Attributes : %c=%.*s", type, static_cast<int>(content.size()), content.data());
 			break;
 	}
 
 	if (parsing_error)
 	{
-		loge("SDP", "Sdp parsing error : %c=%s", type, content.c_str());
+		loge("SDP", "Sdp parsing error : %c=%.*s", type, static_cast<int>(content.size()), content.data());
 		return false;
 	}
 
@@ -129,8 +129,11 @@ public:
 	bool FindExtmapItem(const ov::String &keyword, uint8_t &id, ov::String &uri) const;
 
 private:
+	// SessionDescription feeds the lines of each media section while parsing the whole SDP
+	friend class SessionDescription;
+
 	bool UpdateData(ov::String &sdp) override;
-	bool ParsingMediaLine(char type, std::string content);
+	bool ParsingMediaLine(char type, std::string_view content);
 
 	MediaType _media_type = MediaType::Unknown;
 	ov::String _media_type_str = "UNKNOWN";
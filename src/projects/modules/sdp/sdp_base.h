@@ -29,6 +29,11 @@ public:
 protected:
 	virtual bool UpdateData(ov::String &sdp) = 0;
 
+	void SetSdpText(ov::String sdp_text)
+	{
+		_sdp_text = std::move(sdp_text);
+	}
+
 private:
 	ov::String _sdp_text;
 };
@@ -0,0 +1,180 @@
+//==============================================================================
+//
+//  OvenMediaEngine
+//
+//  Created by Getroot
+//  Copyright (c) 2022 AirenSoft. All rights reserved.
+//
+//==============================================================================
+#pragma once
+
+#include <string_view>
+
+#include "base/ovlibrary/ovlibrary.h"
+
+// Single-pass cursor over SDP text
+//
+// It is used instead of regular expressions to parse SDP lines. Every Next*() function consumes
+// what it returns, so each line is scanned only once.
+class SdpTokenizer
+{
+public:
+	explicit SdpTokenizer(std::string_view text)
+		: _text(text)
+	{
+	}
+
+	bool IsEnd() const
+	{
+		return _position >= _text.size();
+	}
+
+	std::string_view GetRemaining() const
+	{
+		return _text.substr(_position);
+	}
+
+	// Reads the next line without "\r\n" or "\n"
+	bool NextLine(std::string_view &line)
+	{
+		if (IsEnd())
+		{
+			return false;
+		}
+
+		line = NextUntil('\n');
+
+		if ((line.empty() == false) && (line.back() == '\r'))
+		{
+			line.remove_suffix(1);
+		}
+
+		return true;
+	}
+
+	// Consumes the prefix if the remaining text starts with it
+	bool Skip(std::string_view prefix)
+	{
+		if (GetRemaining().compare(0, prefix.size(), prefix) != 0)
+		{
+			return false;
+		}
+
+		_position += prefix.size();
+		return true;
+	}
+
+	bool Skip(char c)
+	{
+		if (IsEnd() || (_text[_position] != c))
+		{
+			return false;
+		}
+
+		_position++;
+		return true;
+	}
+
+	// \s*
+	void SkipSpaces()
+	{
+		NextWhile(IsSpace);
+	}
+
+	// Reads until the delimiter (the delimiter is consumed but not returned)
+	std::string_view NextUntil(char delimiter)
+	{
+		auto remaining = GetRemaining();
+		auto index = remaining.find(delimiter);
+
+		if (index == std::string_view::npos)
+		{
+			_position = _text.size();
+			return remaining;
+		}
+
+		_position += index + 1;
+		return remaining.substr(0, index);
+	}
+
+	template <typename Tpredicate>
+	std::string_view NextWhile(Tpredicate predicate)
+	{
+		auto start = _position;
+
+		while ((_position < _text.size()) && predicate(_text[_position]))
+		{
+			_position++;
+		}
+
+		return _text.substr(start, _position - start);
+	}
+
+	// \S*
+	std::string_view NextToken()
+	{
+		return NextWhile([](char c) { return IsSpace(c) == false; });
+	}
+
+	// \d*
+	std::string_view NextDigits()
+	{
+		return NextWhile(IsDigit);
+	}
+
+	// \w*
+	std::string_view NextWord()
+	{
+		return NextWhile(IsWord);
+	}
+
+	// .*
+	std::string_view NextAll()
+	{
+		auto remaining = GetRemaining();
+		_position = _text.size();
+		return remaining;
+	}
+
+	static bool IsSpace(char c)
+	{
+		return (c == ' ') || (c == '\t') || (c == '\r') || (c == '\n') || (c == '\f') || (c == '\v');
+	}
+
+	static bool IsDigit(char c)
+	{
+		return (c >= '0') && (c <= '9');
+	}
+
+	static bool IsWord(char c)
+	{
+		return IsDigit(c) || ((c >= 'a') && (c <= 'z')) || ((c >= 'A') && (c <= 'Z')) || (c == '_');
+	}
+
+	// Same as ov::Converter::ToUInt32() - returns 0 if there is no digit
+	static uint32_t ToUInt32(std::string_view digits)
+	{
+		uint32_t value = 0;
+
+		for (auto c : digits)
+		{
+			if (IsDigit(c) == false)
+			{
+				break;
+			}
+
+			value = value * 10 + static_cast<uint32_t>(c - '0');
+		}
+
+		return value;
+	}
+
+	static ov::String ToString(std::string_view view)
+	{
+		return ov::String(view.data(), view.size());
+	}
+
+private:
+	std::string_view _text;
+	size_t _position = 0;
+};
@@ -7,10 +7,8 @@
  */
 
 #include "session_description.h"
-#include <sstream>
-#include <regex>
 
-#include "sdp_regex_pattern.h"
+#include "sdp_tokenizer.h"
 
 SessionDescription::SessionDescription()
 {
@@ -25,10 +23,9 @@ void SessionDescription::Release()
 	_media_list.clear();
 }
 
-bool SessionDescription::UpdateData(ov::String &sdp)
+ov::String SessionDescription::SerializeSessionLines() const
 {
-	// Session
-	sdp.Format(
+	return ov::String::FormatString(
 		"v=%d\r\n"
 		"o=%s %u %d %s IP%d %s\r\n"
 		"s=%s\r\n"
@@ -36,15 +33,22 @@ bool SessionDescription::UpdateData(ov::String &sdp)
 		_version,
 		_user_name.CStr(), _session_id, _session_version, _net_type.CStr(), _ip_version, _address.CStr(),
 		_session_name.CStr(),
-		_start_time, _stop_time
-	);
+		_start_time, _stop_time);
+}
+
+bool SessionDescription::UpdateData(ov::String &sdp)
+{
+	_template = nullptr;
+
+	ov::String before_ice_credentials;
+	ov::String after_ice_credentials;
 
 	// Append all media lines to a=group:BUNDLE (Currently, OME only supports BUNDLE only)
-	sdp += "a=group:BUNDLE";
+	before_ice_credentials = "a=group:BUNDLE";
 
 	for(auto &media_description : _media_list)
 	{
-		sdp.AppendFormat(" %s", media_description->GetMid().CStr());
+		before_ice_credentials.AppendFormat(" %s", media_description->GetMid().CStr());
 	}
 
 	/* 
@@ -59,84 +63,115 @@ bool SessionDescription::UpdateData(ov::String &sdp)
 	}
 	*/
 
-	sdp += "\r\n";
+	before_ice_credentials += "\r\n";
 
 	// msid-semantic
 	if(_msid_semantic.IsEmpty() == false)
 	{
-		sdp.AppendFormat("a=msid-semantic:%s %s\r\n", _msid_semantic.CStr(), _msid_token.CStr());
+		before_ice_credentials.AppendFormat("a=msid-semantic:%s %s\r\n", _msid_semantic.CStr(), _msid_token.CStr());
 	}
 
 	// Common Attributes
-	ov::String common_attr_text;
+	ov::String common_attr_before_ice_credentials;
+	ov::String common_attr_after_ice_credentials;
 
-	if(SerializeCommonAttr(common_attr_text) == false)
+	if(SerializeCommonAttr(common_attr_before_ice_credentials, common_attr_after_ice_credentials) == false)
 	{
 		return false;
 	}
 
-	sdp += common_attr_text;
+	before_ice_credentials += common_attr_before_ice_credentials;
+	after_ice_credentials += common_attr_after_ice_credentials;
 
 	// Media
 	for(auto &media_description : _media_list)
 	{
-		sdp += media_description->ToString();
+		after_ice_credentials += media_description->ToString();
 	}
 
+	// Session
+	sdp = SerializeSessionLines();
+	sdp += before_ice_credentials;
+	sdp += SerializeIceCredentials(CommonAttr::GetIceUfrag(), CommonAttr::GetIcePwd());
+	sdp += after_ice_credentials;
+
+	// Keep everything except the per-session values to build the SDP of each session without serializing again
+	auto sdp_template = std::make_shared<Template>();
+	sdp_template->before_ice_credentials = std::move(before_ice_credentials);
+	sdp_template->after_ice_credentials = std::move(after_ice_credentials);
+	_template = sdp_template;
+
 	return true;
 }
 
-bool SessionDescription::FromString(const ov::String &sdp)
+std::shared_ptr<SessionDescription> SessionDescription::CreateFromTemplate(uint32_t session_id, const ov::String &ice_ufrag, const ov::String &ice_pwd) const
 {
-	static const std::regex ValidLineRegex("^([a-z])=(.*)");
-	std::stringstream sdpstream(sdp.CStr());
-	std::string line;
+	auto session_description = std::make_shared<SessionDescription>(*this);
 
-	ov::String media_desc_sdp;
-	bool media_level = false;
+	session_description->_session_id = session_id;
+	session_description->SetIceUfrag(ice_ufrag);
+	session_description->SetIcePwd(ice_pwd);
 
-	while(std::getline(sdpstream, line, '\n'))
+	if(_template == nullptr)
 	{
-		if(line.size() && line[line.length() - 1] == '\r')
-		{
-			line.pop_back();
-		}
+		session_description->Update();
+		return session_description;
+	}
+
+	auto session_lines = session_description->SerializeSessionLines();
+	auto ice_credentials = SerializeIceCredentials(ice_ufrag, ice_pwd);
+
+	ov::String sdp(static_cast<uint32_t>(session_lines.GetLength() +
+										 _template->before_ice_credentials.GetLength() +
+										 ice_credentials.GetLength() +
+										 _template->after_ice_credentials.GetLength() + 1));
 
-		if(!std::regex_search(line, ValidLineRegex))
+	sdp.Append(session_lines);
+	sdp.Append(_template->before_ice_credentials);
+	sdp.Append(ice_credentials);
+	sdp.Append(_template->after_ice_credentials);
+
+	session_description->SetSdpText(std::move(sdp));
+
+	return session_description;
+}
+
+bool SessionDescription::FromString(const ov::String &sdp)
+{
+	SdpTokenizer tokenizer(std::string_view(sdp.CStr(), sdp.GetLength()));
+	std::string_view line;
+
+	// Lines of each media section are passed directly to the MediaDescription being parsed
+	std::shared_ptr<MediaDescription> media_desc;
+
+	while(tokenizer.NextLine(line))
+	{
+		// ^([a-z])=(.*)
+		if((line.size() < 2) || (line[0] < 'a') || (line[0] > 'z') || (line[1] != '='))
 		{
 			continue;
 		}
+
 		char type = line[0];
-		std::string content = line.substr(2);
+		auto content = line.substr(2);
 
 		if(type == 'm')
 		{
-			if(media_level == true)
+			if(media_desc != nullptr)
 			{
-				auto media_desc = std::make_shared<MediaDescription>();
-				if(media_desc->FromString(media_desc_sdp) == false)
-				{
-					return false;
-				}
+				media_desc->Update();
 				AddMedia(media_desc);
 			}
 
-			media_desc_sdp.Clear();
-			media_desc_sdp.AppendFormat("%s\n", line.c_str());
-			media_level = true;
+			media_desc = std::make_shared<MediaDescription>();
 		}
-		else if(media_level == true)
-		{
-			media_desc_sdp.AppendFormat("%s\n", line.c_str());
 
-			if(sdpstream.rdbuf()->in_avail() == 0)
+		if(media_desc != nullptr)
+		{
+			if(media_desc->ParsingMediaLine(type, content) == false)
 			{
-				auto media_desc = std::make_shared<MediaDescription>();
-				if(media_desc->FromString(media_desc_sdp) == false)
-				{
-					return false;
-				}
-				AddMedia(media_desc);
+				logw("SDP", "Could not parse line: %c: %.*s", type, static_cast<int>(content.size()), content.data());
+				return false;
 			}
 		}
 		else
@@ -148,233 +183,171 @@ bool SessionDescription::FromString(const ov::String &sdp)
 		}
 	}
 
+	if(media_desc != nullptr)
+	{
+		media_desc->Update();
+		AddMedia(media_desc);
+	}
+
 	Update();
 
 	return true;
 }
 
-bool SessionDescription::ParsingSessionLine(char type, std::string content)
+bool SessionDescription::ParsingSessionLine(char type, std::string_view content)
 {
 	bool parsing_error = false;
-	std::smatch matches;
+	SdpTokenizer tokenizer(content);
 
 	switch(type)
 	{
 		case 'v':
-			/*
 			// v=0
-			if(std::regex_search(content, matches, std::regex("^(\\d*)$")))
+			// ^(\d*)$
 			{
-				if(matches.size() != 1 + 1)
-				{
-					parsing_error = true;
-					break;
-				}
-				SetVersion(static_cast<uint8_t>(std::stoi(matches[1])));
-			}
-			*/
-			{
-				auto match = SDPRegexPattern::GetInstance()->MatchVersion(content.c_str());
-				if(match.GetGroupCount() != 1 + 1)
+				auto version = tokenizer.NextDigits();
+				if(tokenizer.IsEnd() == false)
 				{
 					parsing_error = true;
 					break;
 				}
 
-				SetVersion(ov::Converter::ToInt32(match.GetGroupAt(1).GetValue().CStr()));
+				SetVersion(SdpTokenizer::ToUInt32(version));
 			}
 			break;
 		case 'o':
 			// o=OvenMediaEngine 1882243660 2 IN IP4 127.0.0.1
-			/*
-			if(std::regex_search(content, matches, std::regex("^(\\S*) (\\d*) (\\d*) (\\S*) IP(\\d) (\\S*)")))
+			// ^(\S*) (\d*) (\d*) (\S*) IP(\d) (\S*)
 			{
-				if(matches.size() != 6 + 1)
+				auto user_name = tokenizer.NextToken();
+				if(tokenizer.Skip(' ') == false)
 				{
 					parsing_error = true;
 					break;
 				}
 
-				SetOrigin(std::string(matches[1]).c_str(),
-				          static_cast<uint32_t>(std::stoul(matches[2])),
-				          static_cast<uint32_t>(std::stoul(matches[3])),
-				          std::string(matches[4]).c_str(),
-				          static_cast<uint8_t>(std::stoul(matches[5])),
-				          std::string(matches[6]).c_str());
-			}
-			*/
-			{
-				auto match = SDPRegexPattern::GetInstance()->MatchOrigin(content.c_str());
-				if(match.GetGroupCount() != 6 + 1)
+				auto session_id = tokenizer.NextDigits();
+				if(tokenizer.Skip(' ') == false)
 				{
 					parsing_error = true;
 					break;
 				}
 
-				SetOrigin(
-						match.GetGroupAt(1).GetValue(), // user name
-						ov::Converter::ToUInt32(match.GetGroupAt(2).GetValue().CStr()), // session id
-						ov::Converter::ToUInt32(match.GetGroupAt(3).GetValue().CStr()), // session version
-						match.GetGroupAt(4).GetValue(), // net_type
-						ov::Converter::ToInt32(match.GetGroupAt(5).GetValue().CStr()), // ip_version
-						match.GetGroupAt(6).GetValue() // address
-						);
-			}
-
-			break;
-		case 's':
-			// s=-
-			/*
-			if(std::regex_search(content, matches, std::regex("^(.*)")))
-			{
-				if(matches.size() != 1 + 1)
+				auto session_version = tokenizer.NextDigits();
+				if(tokenizer.Skip(' ') == false)
 				{
 					parsing_error = true;
 					break;
 				}
 
-				SetSessionName(std::string(matches[1]).c_str());
-			}*/
-			{
-				auto match = SDPRegexPattern::GetInstance()->MatchSessionName(content.c_str());
-				if(match.GetGroupCount() != 1 + 1)
+				auto net_type = tokenizer.NextToken();
+				if(tokenizer.Skip(" IP") == false)
 				{
 					parsing_error = true;
 					break;
 				}
-				
-				SetSessionName(match.GetGroupAt(1).GetValue());
-			}
-			break;
-		case 't':
-			// t=0 0
-			/*
-			if(std::regex_search(content, matches, std::regex("^(\\d*) (\\d*)")))
-			{
-				if(matches.size() != 2 + 1)
+
+				auto ip_version = tokenizer.NextDigits();
+				if((ip_version.size() != 1) || (tokenizer.Skip(' ') == false))
 				{
 					parsing_error = true;
 					break;
 				}
 
-				SetTiming(static_cast<uint32_t>(std::stoul(matches[1])),
-				          static_cast<uint32_t>(std::stoul(matches[2])));
+				SetOrigin(
+						SdpTokenizer::ToString(user_name),
+						SdpTokenizer::ToUInt32(session_id),
+						SdpTokenizer::ToUInt32(session_version),
+						SdpTokenizer::ToString(net_type),
+						SdpTokenizer::ToUInt32(ip_version),
+						SdpTokenizer::ToString(tokenizer.NextToken())
+						);
 			}
-			*/
+
+			break;
+		case 's':
+			// s=-
+			SetSessionName(SdpTokenizer::ToString(content));
+			break;
+		case 't':
+			// t=0 0
+			// ^(\d*) (\d*)
 			{
-				auto match = SDPRegexPattern::GetInstance()->MatchTiming(content.c_str());
-				if(match.GetGroupCount() != 2 + 1)
+				auto start = tokenizer.NextDigits();
+				if(tokenizer.Skip(' ') == false)
 				{
 					parsing_error = true;
 					break;
 				}
-				
+
 				SetTiming(
-					ov::Converter::ToUInt32(match.GetGroupAt(1).GetValue().CStr()),
-					ov::Converter::ToUInt32(match.GetGroupAt(2).GetValue().CStr())
+					SdpTokenizer::ToUInt32(start),
+					SdpTokenizer::ToUInt32(tokenizer.NextDigits())
 				);
 			}
 
 			break;
 		case 'a':
 			// a=group:BUNDLE video audio ...
-			if(content.compare(0, OV_COUNTOF("gr") - 1, "gr") == 0)
+			if(tokenizer.Skip("group:"))
 			{
-				/*
-				if(std::regex_search(content, matches, std::regex("^group:BUNDLE (.*)")))
+				// ^group:BUNDLE (.*)
+				if(tokenizer.Skip("BUNDLE ") == false)
 				{
-					if(matches.size() != 1 + 1)
-					{
-						parsing_error = true;
-						break;
-					}
-
-					std::string bundle;
-					std::stringstream bundles(matches[1]);
-					while(std::getline(bundles, bundle, ' '))
-					{
-						_bundles.emplace_back(bundle.c_str());
-					}
-				}
-				*/
-				
-				auto match = SDPRegexPattern::GetInstance()->MatchGourpBundle(content.c_str());
-				if(match.GetGroupCount() != 1 + 1)
-				{
-					parsing_error = true;
+					// Other semantics (such as LS) are not used
+					logd("SDP", "Unknown Attributes : %c=%.*s", type, static_cast<int>(content.size()), content.data());
 					break;
 				}
-				
-				auto bundles = match.GetGroupAt(1).GetValue();
-				auto items = bundles.Split(" ");
-				for(const auto &item : items)
+
+				while(tokenizer.IsEnd() == false)
 				{
-					_bundles.emplace_back(item);
+					auto bundle = tokenizer.NextUntil(' ');
+					if(bundle.empty() == false)
+					{
+						_bundles.emplace_back(SdpTokenizer::ToString(bundle));
+					}
 				}
 			}
 			// a=msid-semantic:WMS *
 			else if(content.compare(0, OV_COUNTOF("ms") - 1, "ms") == 0)
 			{
-				/*
-				if(std::regex_search(content, matches, std::regex(R"(^msid-semantic:\s?(\w*) (\S*))")))
-				{
-					if(matches.size() != 2 + 1)
-					{
-						parsing_error = true;
-						break;
-					}
-
-					SetMsidSemantic(std::string(matches[1]).c_str(), std::string(matches[2]).c_str());
-				}
-				*/
-
-				auto match = SDPRegexPattern::GetInstance()->MatchMsidSemantic(content.c_str());
-				if(match.GetGroupCount() != 2 + 1)
+				// ^msid-semantic:\s?(\w*) (\S*)
+				if(tokenizer.Skip("msid-semantic:") == false)
 				{
 					parsing_error = true;
 					break;
 				}
 
-				SetMsidSemantic(
-					match.GetGroupAt(1).GetValue(),
-					match.GetGroupAt(2).GetValue()
-				);
-			}
-			else if(content.compare(0, OV_COUNTOF("sdpl") - 1, "sdpl") == 0)
-			{
-				/*
-				if(std::regex_search(content, matches, std::regex("^sdplang:(\\S*)")))
-				{
-					_sdp_lang = std::string(matches[1]).c_str();
-				}
-				*/
+				tokenizer.Skip(' ');
 
-				auto match = SDPRegexPattern::GetInstance()->MatchSdpLang(content.c_str());
-				if(match.GetGroupCount() != 1 + 1)
-				{
-					parsing_error = true;
-					break;
-				}
+				auto semantic = tokenizer.NextWord();
+				std::string_view token;
 
-				_sdp_lang = match.GetGroupAt(1).GetValue();
-			}
-			else if(content.compare(0, OV_COUNTOF("ran") - 1, "ran") == 0)
-			{
-				/*
-				if(std::regex_search(content, matches, std::regex("^range:(\\S*)")))
+				// Some browsers omit the token (a=msid-semantic: WMS)
+				if(tokenizer.Skip(' '))
 				{
-					_range = std::string(matches[1]).c_str();
+					token = tokenizer.NextToken();
 				}
-				*/
-
-				auto match = SDPRegexPattern::GetInstance()->MatchRange(content.c_str());
-				if(match.GetGroupCount() != 1 + 1)
+				else if(tokenizer.IsEnd() == false)
 				{
 					parsing_error = true;
 					break;
 				}
 
-				_range = match.GetGroupAt(1).GetValue();
+				SetMsidSemantic(SdpTokenizer::ToString(semantic), SdpTokenizer::ToString(token));
+			}
+			else if(tokenizer.Skip("sdplang:"))
+			{
+				_sdp_lang = SdpTokenizer::ToString(tokenizer.NextToken());
+			}
+			else if(tokenizer.Skip("range:"))
+			{
+				_range = SdpTokenizer::ToString(tokenizer.NextToken());
+			}
+			else if((content.compare(0, OV_COUNTOF("sdpl") - 1, "sdpl") == 0) ||
+					(content.compare(0, OV_COUNTOF("ran") - 1, "ran") == 0))
+			{
+				parsing_error = true;
 			}
 			else if(ParsingCommonAttrLine(type, content))
 			{
@@ -383,17 +356,17 @@ bool SessionDescription::ParsingSessionLine(char type, std::string content)
 			else
 			{
 				// Other attributes are ignored because they are not required.
-				logd("SDP", "Unknown Attributes : %c=%s", type, content.c_str());
+				logd("SDP", "Unknown Attributes : %c=%.*s", type, static_cast<int>(content.size()), content.data());
 			}
 
 			break;
 		default:
-			logd("SDP", "Unknown Attributes : %c=%s", type, content.c_str());
+			logd("SDP", "Unknown Attributes : %c=%.*s", type, static_cast<int>(content.size()), content.data());
 	}
 
 	if(parsing_error)
 	{
-		loge("SDP", "Sdp parsing error : %c=%s", type, content.c_str());
+		loge("SDP", "Sdp parsing error : %c=%.*s", type, static_cast<int>(content.size()), content.data());
 		return false;
 	}
 
@@ -100,6 +100,11 @@ public:
 	ov::String GetIceUfrag() const override;
 	ov::String GetIcePwd() const override;
 
+	// Creates a copy with the given origin session id and ICE credentials.
+	// The SDP text is spliced from the text serialized by the last Update() of this description,
+	// so that the offer of each session is not serialized from scratch.
+	std::shared_ptr<SessionDescription> CreateFromTemplate(uint32_t session_id, const ov::String &ice_ufrag, const ov::String &ice_pwd) const;
+
 	bool operator ==(const SessionDescription &description) const
 	{
 		return (_session_id == description._session_id);
@@ -107,7 +112,9 @@ public:
 
 private:
 	bool UpdateData(ov::String &sdp) override;
-	bool ParsingSessionLine(char type, std::string content);
+	bool ParsingSessionLine(char type, std::string_view content);
+	// v=, o=, s=, t=
+	ov::String SerializeSessionLines() const;
 
 	// version
 	uint8_t _version = 0;
@@ -142,4 +149,13 @@ private:
 
 	// Media
 	std::vector<std::shared_ptr<const MediaDescription>> _media_list;
+
+	// Offer template (the serialized SDP except v=/o=/s=/t= lines and ICE credentials),
+	// shared with the copies instead of being copied
+	struct Template
+	{
+		ov::String before_ice_credentials;
+		ov::String after_ice_credentials;
+	};
+	std::shared_ptr<const Template> _template;
 };
\ No newline at end of file
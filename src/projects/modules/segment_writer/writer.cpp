@@ -752,8 +752,7 @@ bool Writer::WritePacket(const std::shared_ptr<const MediaPacket> &packet)
 			break;
 
 		case cmn::BitstreamFormat::H264_ANNEXB:
-			data = packet->GetData();
-			data = H264Converter::ConvertAnnexbToAvcc(data);
+			data = H264Converter::GetAvccView(packet)->GetData();
 			length_list.push_back(data->GetLength());
 			break;
 
@@ -38,6 +38,9 @@ namespace mon
 			_streams.clear();
 		}
 
+		// Replaces the configuration when the application is updated (the stream metrics are kept)
+		using info::Application::SetConfig;
+
 		std::shared_ptr<HostMetrics> GetHostMetrics()
 		{
 			return _host_metrics;
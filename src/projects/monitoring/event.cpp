@@ -294,9 +294,10 @@ namespace mon
 		json_app["appID"] = app_metric->GetUUID().CStr();
 		json_app["name"] = app_metric->GetName().CStr();
 		json_app["createdTime"] = ov::Converter::ToISO8601String(app_metric->CommonMetrics::GetCreatedTime()).CStr();
-		json_app["outputProfiles"] = app_metric->GetConfig().GetOutputProfiles().ToJson();
-		json_app["providers"] = app_metric->GetConfig().GetProviders().ToJson();
-		json_app["publishers"] = app_metric->GetConfig().GetPublishers().ToJson();
+		auto app_config = app_metric->GetConfig();
+		json_app["outputProfiles"] = app_config->GetOutputProfiles().ToJson();
+		json_app["providers"] = app_config->GetProviders().ToJson();
+		json_app["publishers"] = app_config->GetPublishers().ToJson();
 
 		json_host["app"] = json_app;
 
@@ -4,6 +4,7 @@
 
 #include <base/ovlibrary/path_manager.h>
 #include <base/ovlibrary/file.h>
+#include <base/ovlibrary/zip.h>
 #include <modules/http/client/http_client.h>
 
 namespace mon
@@ -263,10 +264,15 @@ namespace mon
 		_user_key = _server_config->GetAnalytics().GetUserKey();
 
 		bool is_collector_parsed = false;
-		if(_server_config->GetAnalytics().GetForwarding().IsParsed())
+		const auto &forwarding_config = _server_config->GetAnalytics().GetForwarding();
+		if(forwarding_config.IsParsed())
 		{
-			_enabled = _server_config->GetAnalytics().GetForwarding().IsEnabled();
-			_collector = _server_config->GetAnalytics().GetForwarding().GetCollector(&is_collector_parsed);
+			_enabled = forwarding_config.IsEnabled();
+			_collector = forwarding_config.GetCollector(&is_collector_parsed);
+
+			_batch_count = std::max(forwarding_config.GetBatchCount(), 1);
+			_batch_interval_msec = std::max(forwarding_config.GetBatchInterval(), 10);
+			_use_gzip = (forwarding_config.GetCompression().LowerCaseString() == "gzip");
 		}
 		
 		if(_enabled == false)
@@ -282,7 +288,22 @@ namespace mon
 			return false;
 		}
 
-		if(_collector_url->Scheme().UpperCaseString() != "TCP")
+		auto scheme = _collector_url->Scheme().UpperCaseString();
+		if(scheme == "TCP")
+		{
+			_collector_type = CollectorType::Tcp;
+
+			if(_use_gzip)
+			{
+				logtw("Compression is ignored for the TCP collector: %s", _collector.CStr());
+				_use_gzip = false;
+			}
+		}
+		else if(scheme == "HTTP")
+		{
+			_collector_type = CollectorType::Http;
+		}
+		else
 		{
 			logte("Event forwarder is disabled due to unsupported protocol. : %s", _collector.CStr());
 			return false;
@@ -303,6 +324,9 @@ namespace mon
 		_shipper_thread = std::thread(&EventForwarder::ForwarderThread, this);
 		pthread_setname_np(_shipper_thread.native_handle(), "ForwarderThread");
 
+		logti("Event Forwarder is started: %s (batch count: %zu, batch interval: %d ms, compression: %s)",
+			  _collector.CStr(), _batch_count, _batch_interval_msec, _use_gzip ? "gzip" : "none");
+
 		return true;
 	}
 
@@ -315,9 +339,24 @@ namespace mon
 			_shipper_thread.join();
 		}
 
+		CloseSocket();
+
 		return true;
 	}
 
+	EventForwarder::Statistics EventForwarder::GetStatistics() const
+	{
+		Statistics statistics;
+
+		statistics.forwarded_events = _forwarded_events;
+		statistics.forwarded_bytes = _forwarded_bytes;
+		statistics.sent_bytes = _sent_bytes;
+		statistics.batches = _batches;
+		statistics.failures = _failures;
+
+		return statistics;
+	}
+
 	bool EventForwarder::AuthOvenConsole()
 	{
 		auto client = std::make_shared<http::clnt::HttpClient>();
@@ -368,6 +407,12 @@ namespace mon
 
 		std::ifstream ifs;
 		std::streampos pos = 0;
+
+		// Events are collected into the batch and sent at once
+		ov::String batch;
+		size_t batch_event_count = 0;
+		batch.SetCapacity(EVENT_FORWARDER_MAX_BATCH_BYTES);
+
 		while(_run_thread)
 		{
 			if( ifs.is_open() == false || (event_stream.IsNextAvailable() && ifs.eof()) )
@@ -400,8 +445,8 @@ namespace mon
 			}
 			else
 			{		
-				// Wait for new message in current log file
-				sleep(1);
+				// Wait for new message in current log file (new events are delayed up to the interval)
+				std::this_thread::sleep_for(std::chrono::milliseconds(_batch_interval_msec));
 
 				// Clear error bits to read a growing log file
 				ifs.clear();
@@ -423,70 +468,279 @@ namespace mon
 					pos = ifs.tellg();
 				}
 
-				// Ship the line
-				while(_run_thread)
-				{	
-					if(Forwarding(line.c_str()))
-					{
-						// Store last shipped info
-						StoreLastForwardedInfo(event_stream.GetOpenLogTime(), pos);
-						break;
-					}
-					else
-					{
-						// Keep trying until the transfer is successful.
-						sleep(1);
-					}
+				batch.Append(line.c_str(), line.size());
+				batch_event_count++;
+
+				if ((batch_event_count >= _batch_count) || (batch.GetLength() >= EVENT_FORWARDER_MAX_BATCH_BYTES))
+				{
+					FlushBatch(batch, batch_event_count, event_stream.GetOpenLogTime(), pos);
 				}
 			}
+
+			// All events in the file are read, so send the remaining events before the file can be changed
+			FlushBatch(batch, batch_event_count, event_stream.GetOpenLogTime(), pos);
 		}
 	}
 
-	bool EventForwarder::Forwarding(const ov::String &line)
+	void EventForwarder::FlushBatch(ov::String &batch, size_t &event_count, std::time_t file_time, uint64_t file_offset)
 	{
-		if(ConnectIfNeeded() == true)
+		if(event_count == 0)
 		{
-			return _socket->Send(line.ToData(false));
+			return;
 		}
-		else
+
+		// Keep trying until the transfer is successful.
+		// The position is not stored if the thread is stopped, so the batch will be forwarded again after restart.
+		while(_run_thread)
+		{
+			if(Forwarding(batch))
+			{
+				// Store last shipped info
+				StoreLastForwardedInfo(file_time, file_offset);
+
+				_forwarded_events += event_count;
+				_forwarded_bytes += batch.GetLength();
+				_batches++;
+
+				break;
+			}
+
+			_failures++;
+			CloseSocket();
+			sleep(1);
+		}
+
+		// Keep the buffer for the next batch
+		batch.SetLength(0);
+		event_count = 0;
+	}
+
+	bool EventForwarder::Forwarding(const ov::String &batch)
+	{
+		if(ConnectIfNeeded() == false)
 		{
 			return false;
 		}
 
+		if(_collector_type == CollectorType::Http)
+		{
+			if(_use_gzip)
+			{
+				auto compressed = ov::Zip::CompressGzip(batch.ToData(false));
+				if(compressed == nullptr)
+				{
+					logte("Could not compress the events");
+					return false;
+				}
+
+				return ForwardingHttp(compressed, true);
+			}
+
+			return ForwardingHttp(batch.ToData(false), false);
+		}
+
+		if(_socket->Send(batch.CStr(), batch.GetLength()) == false)
+		{
+			return false;
+		}
+
+		_sent_bytes += batch.GetLength();
+
 		return true;
 	}
 
-	bool EventForwarder::ConnectIfNeeded()
+	bool EventForwarder::ForwardingHttp(const std::shared_ptr<const ov::Data> &body, bool is_compressed)
+	{
+		auto path = _collector_url->Path().IsEmpty() ? "/" : _collector_url->Path();
+		if(_collector_url->HasQueryString())
+		{
+			path.AppendFormat("?%s", _collector_url->Query().CStr());
+		}
+
+		ov::String header;
+		header.AppendFormat("POST %s HTTP/1.1\r\n", path.CStr());
+		header.AppendFormat("Host: %s:%u\r\n", _collector_url->Host().CStr(), _collector_address.Port());
+		header.Append("Content-Type: application/x-ndjson\r\n");
+		header.AppendFormat("Content-Length: %zu\r\n", body->GetLength());
+		if(is_compressed)
+		{
+			header.Append("Content-Encoding: gzip\r\n");
+		}
+		if(_user_key.IsEmpty() == false)
+		{
+			header.AppendFormat("Authorization: Bearer %s\r\n", _user_key.CStr());
+		}
+		header.Append("Connection: keep-alive\r\n\r\n");
+
+		if((_socket->Send(header.CStr(), header.GetLength()) == false) || (_socket->Send(body) == false))
+		{
+			return false;
+		}
+
+		bool keep_alive = true;
+		auto status_code = RecvHttpResponse(&keep_alive);
+
+		if(keep_alive == false)
+		{
+			CloseSocket();
+		}
+
+		if((status_code / 100) != 2)
+		{
+			logtw("Collector responded with status code %d: %s", status_code, _collector.CStr());
+			return false;
+		}
+
+		_sent_bytes += body->GetLength();
+
+		return true;
+	}
+
+	int EventForwarder::RecvHttpResponse(bool *keep_alive)
 	{
-		if(_collector_url->Scheme().UpperCaseString() == "TCP")
+		ov::String response;
+		off_t header_end = -1;
+
+		*keep_alive = false;
+
+		// Receive the header
+		while((header_end = response.IndexOf("\r\n\r\n")) < 0)
 		{
-			auto address = ov::SocketAddress::CreateAndGetFirst(_collector_url->Host().CStr(), _collector_url->Port());
+			char buffer[4096];
+			size_t received_length = 0;
 
-			if(_socket == nullptr)
+			auto error = _socket->Recv(buffer, sizeof(buffer), &received_length);
+			if((error != nullptr) || (received_length == 0) || (response.GetLength() > (64 * 1024)))
 			{
-				_socket = ov::SocketPool::GetTcpPool()->AllocSocket(address.GetFamily());
+				return 0;
 			}
 
-			if(_socket->GetState() == ov::SocketState::Connected)
+			response.Append(buffer, received_length);
+		}
+
+		auto lines = response.Left(header_end).Split("\r\n");
+		auto status_items = lines[0].Split(" ");
+		if((status_items.size() < 2) || (status_items[0].HasPrefix("HTTP/1.") == false))
+		{
+			return 0;
+		}
+
+		int status_code = ov::Converter::ToInt32(status_items[1].CStr());
+		bool has_content_length = false;
+		size_t content_length = 0;
+
+		*keep_alive = (status_items[0] == "HTTP/1.1");
+
+		for(size_t index = 1; index < lines.size(); index++)
+		{
+			auto colon = lines[index].IndexOf(':');
+			if(colon < 0)
 			{
-				return true;
+				continue;
 			}
-			else
+
+			auto name = lines[index].Left(colon).Trim().LowerCaseString();
+			auto value = lines[index].Substring(colon + 1).Trim().LowerCaseString();
+
+			if(name == "content-length")
 			{
-				auto error = _socket->Connect(address);
-				if(error != nullptr)
-				{
-					logtd("Could not connect to collector server : %s", _collector_url->ToUrlString(true).CStr());
-					_socket = nullptr;
+				has_content_length = true;
+				content_length = ov::Converter::ToUInt64(value.CStr());
+			}
+			else if(name == "connection")
+			{
+				*keep_alive = (value == "keep-alive") || ((value != "close") && *keep_alive);
+			}
+		}
 
-					return false;
-				}
+		if(has_content_length == false)
+		{
+			// The end of the body cannot be found (e.g. chunked), the connection cannot be reused
+			*keep_alive = false;
+			return status_code;
+		}
 
-				return true;
+		// Discard the body
+		size_t received_body_length = response.GetLength() - (header_end + 4);
+		while(received_body_length < content_length)
+		{
+			char buffer[4096];
+			size_t received_length = 0;
+
+			auto error = _socket->Recv(buffer, std::min(sizeof(buffer), content_length - received_body_length), &received_length);
+			if((error != nullptr) || (received_length == 0))
+			{
+				*keep_alive = false;
+				break;
 			}
+
+			received_body_length += received_length;
 		}
 
-		return false;
+		return status_code;
+	}
+
+	bool EventForwarder::ConnectIfNeeded()
+	{
+		if((_socket != nullptr) && (_socket->GetState() == ov::SocketState::Connected))
+		{
+			return true;
+		}
+
+		CloseSocket();
+
+		if(_collector_address.IsValid() == false)
+		{
+			auto port = _collector_url->Port();
+			if((port == 0) && (_collector_type == CollectorType::Http))
+			{
+				port = 80;
+			}
+
+			_collector_address = ov::SocketAddress::CreateAndGetFirst(_collector_url->Host().CStr(), port);
+			if(_collector_address.IsValid() == false)
+			{
+				logtd("Could not resolve the address of the collector : %s", _collector_url->ToUrlString(true).CStr());
+				return false;
+			}
+		}
+
+		_socket = ov::SocketPool::GetTcpPool()->AllocSocket(_collector_address.GetFamily());
+		if(_socket == nullptr)
+		{
+			return false;
+		}
+
+		auto error = _socket->Connect(_collector_address, EVENT_FORWARDER_CONNECTION_TIMEOUT_MSEC);
+		if(error != nullptr)
+		{
+			logtd("Could not connect to collector server : %s", _collector_url->ToUrlString(true).CStr());
+
+			CloseSocket();
+			// Resolve the address again next time (the address of the collector may be changed)
+			_collector_address = ov::SocketAddress();
+
+			return false;
+		}
+
+		if(_collector_type == CollectorType::Http)
+		{
+			timeval tv {EVENT_FORWARDER_RECV_TIMEOUT_MSEC / 1000, (EVENT_FORWARDER_RECV_TIMEOUT_MSEC % 1000) * 1000};
+			_socket->SetRecvTimeout(tv);
+		}
+
+		logti("Connected to the collector: %s", _collector_url->ToUrlString(true).CStr());
+
+		return true;
+	}
+
+	void EventForwarder::CloseSocket()
+	{
+		if(_socket != nullptr)
+		{
+			_socket->Close();
+			_socket = nullptr;
+		}
 	}
 
 	ov::String EventForwarder::GetShipperInfoDBFilePath()
@@ -526,8 +780,10 @@ namespace mon
 	bool EventForwarder::StoreLastForwardedInfo(std::time_t file_time, uint64_t file_offset)
 	{
 		auto db_file = GetShipperInfoDBFilePath();
+		// Write to a temporary file and rename it, so the position is not broken if the process is terminated while writing
+		auto temp_db_file = db_file + ".tmp";
 
-		std::ofstream fs(db_file);
+		std::ofstream fs(temp_db_file);
 		if(!fs.is_open())
 		{
 			return false;
@@ -538,6 +794,11 @@ namespace mon
 		fs.write(row.CStr(), row.GetLength());
 		fs.close();
 
+		if(fs.fail() || (::rename(temp_db_file.CStr(), db_file.CStr()) != 0))
+		{
+			return false;
+		}
+
 		return true;
 	}
 }
\ No newline at end of file
@@ -6,27 +6,61 @@
 #define SHIPPER_INFO_DB_FILE "forwarder.db"
 #define OVEN_CONSOLE_AUTH_URL "https://ovenconsole.com/auth"
 
+// A batch is sent when it exceeds this size even if the number of events is less than <BatchCount>
+#define EVENT_FORWARDER_MAX_BATCH_BYTES (4 * 1024 * 1024)
+#define EVENT_FORWARDER_CONNECTION_TIMEOUT_MSEC 3000
+#define EVENT_FORWARDER_RECV_TIMEOUT_MSEC 10000
+
 namespace mon
 {
+	// Forwards the events in the event log files to the collector
+	//
+	// The log files work as a disk buffer: the events are read in batches (up to <BatchCount> events or
+	// EVENT_FORWARDER_MAX_BATCH_BYTES) and the position of the last forwarded event is stored after each batch,
+	// so the events are not lost while the collector is unavailable, and forwarding resumes from there after restart.
 	class EventForwarder
 	{
 	public:
+		struct Statistics
+		{
+			uint64_t forwarded_events = 0;
+			// Bytes of the events before compression
+			uint64_t forwarded_bytes = 0;
+			// Bytes sent to the collector (compressed, without HTTP headers)
+			uint64_t sent_bytes = 0;
+			uint64_t batches = 0;
+			uint64_t failures = 0;
+		};
+
 		void SetLogPath(const ov::String &log_path);
 		bool Start(const std::shared_ptr<const cfg::Server> &server_config);
 		bool Stop();
 
+		Statistics GetStatistics() const;
+
 	private:
+		enum class CollectorType
+		{
+			Tcp,
+			Http
+		};
+
 		bool AuthOvenConsole();
 		void ForwarderThread();
 
-		bool Forwarding(const ov::String &line);
+		// Sends the batch until succeeded (or the thread is stopped), and stores the position after the batch
+		void FlushBatch(ov::String &batch, size_t &event_count, std::time_t file_time, uint64_t file_offset);
+		bool Forwarding(const ov::String &batch);
+		bool ForwardingHttp(const std::shared_ptr<const ov::Data> &body, bool is_compressed);
+		// Returns the status code of the response (0 if failed)
+		int RecvHttpResponse(bool *keep_alive);
 
 		ov::String GetShipperInfoDBFilePath();
 		// [result | file name | file offset]
 		std::tuple<bool, std::time_t, uint64_t> LoadLastShippedInfo();
 		bool StoreLastForwardedInfo(std::time_t, uint64_t file_offset);
 		bool ConnectIfNeeded();
-		bool Send();
+		void CloseSocket();
 
 		class EventLogFileFinder
 		{
@@ -60,6 +94,13 @@ namespace mon
 		bool _enabled = false;
 		ov::String _collector;
 		std::shared_ptr<ov::Url> _collector_url = nullptr;
+		CollectorType _collector_type = CollectorType::Tcp;
+		// Resolved once and reused (resolved again after a connection failure)
+		ov::SocketAddress _collector_address;
+
+		size_t _batch_count = 1000;
+		int _batch_interval_msec = 1000;
+		bool _use_gzip = false;
 		
 		ov::String _log_path;
 
@@ -69,5 +110,11 @@ namespace mon
 		bool _run_thread = false;
 
 		std::shared_ptr<ov::Socket> _socket;
+
+		std::atomic<uint64_t> _forwarded_events{0};
+		std::atomic<uint64_t> _forwarded_bytes{0};
+		std::atomic<uint64_t> _sent_bytes{0};
+		std::atomic<uint64_t> _batches{0};
+		std::atomic<uint64_t> _failures{0};
 	};
 }
\ No newline at end of file
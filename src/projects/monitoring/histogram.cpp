@@ -0,0 +1,111 @@
+//==============================================================================
+//
+//  OvenMediaEngine
+//
+//  Created by Getroot
+//  Copyright (c) 2022 AirenSoft. All rights reserved.
+//
+//==============================================================================
+#include "histogram.h"
+
+#include <base/ovlibrary/ovlibrary.h>
+
+#include <algorithm>
+
+namespace mon
+{
+	Histogram::Histogram(const char *name, const char *help, Unit unit, std::vector<int64_t> upper_bounds)
+		: _name(name),
+		  _help(help),
+		  _unit(unit),
+		  _upper_bounds(std::move(upper_bounds))
+	{
+		OV_ASSERT(_upper_bounds.size() < MaxBucketCount, "Too many buckets: %zu", _upper_bounds.size());
+
+		if (_upper_bounds.size() >= MaxBucketCount)
+		{
+			_upper_bounds.resize(MaxBucketCount - 1);
+		}
+	}
+
+	size_t Histogram::GetStripeIndex()
+	{
+		static std::atomic<size_t> next_index{0};
+		thread_local size_t index = (next_index++ % StripeCount);
+
+		return index;
+	}
+
+	void Histogram::ObserveValue(int64_t value)
+	{
+		value = std::max<int64_t>(value, 0);
+
+		// The number of buckets is small, so a linear search is enough (and cache friendly)
+		size_t bucket_index = 0;
+		auto bound_count = _upper_bounds.size();
+
+		while ((bucket_index < bound_count) && (value > _upper_bounds[bucket_index]))
+		{
+			bucket_index++;
+		}
+
+		auto &stripe = _stripes[GetStripeIndex()];
+
+		stripe.bucket_counts[bucket_index].fetch_add(1, std::memory_order_relaxed);
+		stripe.sum.fetch_add(static_cast<uint64_t>(value), std::memory_order_relaxed);
+	}
+
+	void Histogram::GetSnapshot(Snapshot *snapshot) const
+	{
+		auto bucket_count = _upper_bounds.size() + 1;
+
+		snapshot->bucket_counts.assign(bucket_count, 0);
+		snapshot->count = 0;
+		snapshot->sum = 0;
+
+		for (const auto &stripe : _stripes)
+		{
+			for (size_t index = 0; index < bucket_count; index++)
+			{
+				snapshot->bucket_counts[index] += stripe.bucket_counts[index].load(std::memory_order_relaxed);
+			}
+
+			snapshot->sum += stripe.sum.load(std::memory_order_relaxed);
+		}
+
+		// Make the buckets cumulative. count is derived from the buckets to be consistent with them
+		// even if Observe() is called while reading.
+		for (size_t index = 1; index < bucket_count; index++)
+		{
+			snapshot->bucket_counts[index] += snapshot->bucket_counts[index - 1];
+		}
+
+		snapshot->count = snapshot->bucket_counts[bucket_count - 1];
+	}
+
+	Histogram &GetHistogram(HistogramType type)
+	{
+		// Upper bounds of the Seconds buckets are in microseconds
+		static Histogram histograms[static_cast<size_t>(HistogramType::NumberOfHistograms)] = {
+			{"ome_packet_queue_delay_seconds",
+			 "Time a media packet waits in the queue of the publisher application worker",
+			 Histogram::Unit::Seconds, {100, 500, 1000, 5000, 10000, 50000, 100000, 500000, 1000000, 5000000}},
+			{"ome_session_send_latency_seconds",
+			 "Time to send a media packet to a session",
+			 Histogram::Unit::Seconds, {10, 50, 100, 500, 1000, 5000, 10000, 50000, 100000, 1000000}},
+			{"ome_segment_packaging_seconds",
+			 "Time to package a fMP4 segment (or partial segment) and store it",
+			 Histogram::Unit::Seconds, {100, 500, 1000, 5000, 10000, 50000, 100000, 500000, 1000000, 10000000}},
+			{"ome_mediarouter_queue_delay_seconds",
+			 "Time a media packet waits in the queue of the MediaRouter stream",
+			 Histogram::Unit::Seconds, {100, 500, 1000, 5000, 10000, 50000, 100000, 500000, 1000000, 5000000}},
+			{"ome_ingest_parse_lag_seconds",
+			 "Time the data received by a push provider waits until it is parsed",
+			 Histogram::Unit::Seconds, {100, 500, 1000, 5000, 10000, 50000, 100000, 500000, 1000000, 5000000}},
+			{"ome_segment_chunk_bytes",
+			 "Size of a fMP4 segment (or partial segment) stored by the packager",
+			 Histogram::Unit::Bytes, {16384, 65536, 131072, 262144, 524288, 1048576, 2097152, 4194304, 8388608, 16777216}}};
+
+		return histograms[static_cast<size_t>(type)];
+	}
+}  // namespace mon
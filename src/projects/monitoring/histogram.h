@@ -0,0 +1,132 @@
+//==============================================================================
+//
+//  OvenMediaEngine
+//
+//  Created by Getroot
+//  Copyright (c) 2022 AirenSoft. All rights reserved.
+//
+//==============================================================================
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <vector>
+
+namespace mon
+{
+	// Server-wide histograms. They have no labels, so the number of series does not grow with streams/sessions.
+	enum class HistogramType : uint8_t
+	{
+		// Time a media packet waits in the queue of pub::ApplicationWorker
+		PacketQueueDelay,
+		// Time spent by pub::Session::SendOutgoingData() per session and packet
+		SessionSendLatency,
+		// Time to package a (partial) segment of fMP4 (moof/mdat) and store it
+		SegmentPackagingTime,
+		// Time a media packet waits in the queue of MediaRouteStream until a MediaRouter worker takes it
+		MediaRouterQueueDelay,
+		// Time the data received by a push provider waits until an ingest worker parses it
+		IngestParseLag,
+		// Size of a (partial) segment of fMP4 (moof/mdat) stored by the packager
+		SegmentChunkSize,
+
+		NumberOfHistograms
+	};
+
+	// Histogram of durations (observed in microseconds, exported in seconds) or sizes in bytes
+	//
+	// Observe() only increments relaxed atomics in the stripe of the calling thread, so threads do not
+	// contend on the same cache line. The stripes are summed when the histogram is read (e.g. on scrape).
+	class Histogram
+	{
+	public:
+		enum class Unit : uint8_t
+		{
+			// Values are in microseconds
+			Seconds,
+			Bytes
+		};
+
+		// Cumulative counts of each bucket, the last one is the +Inf bucket
+		struct Snapshot
+		{
+			std::vector<uint64_t> bucket_counts;
+			uint64_t count = 0;
+			uint64_t sum = 0;
+		};
+
+		// upper_bounds must be in ascending order (in the unit of the values) and have at most (MaxBucketCount - 1) items.
+		// The +Inf bucket is added implicitly.
+		Histogram(const char *name, const char *help, Unit unit, std::vector<int64_t> upper_bounds);
+
+		void ObserveValue(int64_t value);
+
+		void ObserveUsec(int64_t value_usec)
+		{
+			ObserveValue(value_usec);
+		}
+
+		void Observe(std::chrono::steady_clock::duration duration)
+		{
+			ObserveValue(std::chrono::duration_cast<std::chrono::microseconds>(duration).count());
+		}
+
+		// snapshot can be reused to avoid allocations
+		void GetSnapshot(Snapshot *snapshot) const;
+
+		const char *GetName() const
+		{
+			return _name;
+		}
+
+		const char *GetHelp() const
+		{
+			return _help;
+		}
+
+		Unit GetUnit() const
+		{
+			return _unit;
+		}
+
+		const std::vector<int64_t> &GetUpperBounds() const
+		{
+			return _upper_bounds;
+		}
+
+		// Including the +Inf bucket. The counters of a stripe fit in two cache lines.
+		static constexpr size_t MaxBucketCount = 15;
+
+	protected:
+		static constexpr size_t StripeCount = 16;
+
+		// The counters are inline, so the stripes of different threads never share a cache line
+		struct alignas(64) Stripe
+		{
+			// Non-cumulative counts of the buckets (including +Inf)
+			std::atomic<uint64_t> bucket_counts[MaxBucketCount]{};
+			std::atomic<uint64_t> sum{0};
+		};
+
+		static size_t GetStripeIndex();
+
+		const char *_name;
+		const char *_help;
+		Unit _unit;
+
+		std::vector<int64_t> _upper_bounds;
+		Stripe _stripes[StripeCount];
+	};
+
+	Histogram &GetHistogram(HistogramType type);
+
+	inline void ObserveHistogram(HistogramType type, std::chrono::steady_clock::duration duration)
+	{
+		GetHistogram(type).Observe(duration);
+	}
+
+	inline void ObserveHistogram(HistogramType type, size_t bytes)
+	{
+		GetHistogram(type).ObserveValue(static_cast<int64_t>(bytes));
+	}
+}  // namespace mon
@@ -69,6 +69,21 @@ namespace mon
 		logti("Delete ApplicationMetrics(%s/%s) for monitoring", app_info.GetName().CStr(), app_info.GetUUID().CStr());
 		return true;
 	}
+	bool HostMetrics::OnApplicationUpdated(const info::Application &app_info)
+	{
+		std::unique_lock<std::shared_mutex> lock(_map_guard);
+		auto item = _applications.find(app_info.GetId());
+		if (item == _applications.end())
+		{
+			return false;
+		}
+
+		// The stream metrics of the application are kept, only the configuration is replaced
+		item->second->SetConfig(app_info.GetConfig());
+
+		logti("Update ApplicationMetrics(%s/%s) for monitoring", app_info.GetName().CStr(), app_info.GetUUID().CStr());
+		return true;
+	}
 
 	std::map<uint32_t, std::shared_ptr<ApplicationMetrics>> HostMetrics::GetApplicationMetricsList()
 	{
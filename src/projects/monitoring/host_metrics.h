@@ -44,6 +44,7 @@ namespace mon
 
 		bool OnApplicationCreated(const info::Application &app_info);
 		bool OnApplicationDeleted(const info::Application &app_info);
+		bool OnApplicationUpdated(const info::Application &app_info);
 
 		std::map<uint32_t, std::shared_ptr<ApplicationMetrics>> GetApplicationMetricsList();
 
@@ -184,6 +184,16 @@ namespace mon
 
 		return true;
 	}
+	bool Monitoring::OnApplicationUpdated(const info::Application &app_info)
+	{
+		auto host_metrics = _server_metric->GetHostMetrics(app_info.GetHostInfo());
+		if (host_metrics == nullptr)
+		{
+			return false;
+		}
+
+		return host_metrics->OnApplicationUpdated(app_info);
+	}
 	bool Monitoring::OnStreamCreated(const info::Stream &stream)
 	{
 		auto app_metrics = GetApplicationMetrics(stream.GetApplicationInfo());
@@ -9,6 +9,7 @@
 #include "server_metrics.h"
 #include "event_logger.h"
 #include "event_forwarder.h"
+#include "segment_cache_metrics.h"
 
 #define MonitorInstance				mon::Monitoring::GetInstance()
 #define HostMetrics(info)			mon::Monitoring::GetInstance()->GetHostMetrics(info);
@@ -41,12 +42,23 @@ namespace mon
         std::shared_ptr<ApplicationMetrics> GetApplicationMetrics(const info::Application &app_info);
         std::shared_ptr<StreamMetrics>  GetStreamMetrics(const info::Stream &stream_info);
 
+		const EventForwarder &GetEventForwarder() const
+		{
+			return _forwarder;
+		}
+
+		SegmentCacheMetrics &GetSegmentCacheMetrics()
+		{
+			return _segment_cache_metrics;
+		}
+
 		// Events
 		void OnServerStarted(const std::shared_ptr<const cfg::Server> &server_config);
 		bool OnHostCreated(const info::Host &host_info);
 		bool OnHostDeleted(const info::Host &host_info);
 		bool OnApplicationCreated(const info::Application &app_info);
 		bool OnApplicationDeleted(const info::Application &app_info);
+		bool OnApplicationUpdated(const info::Application &app_info);
 		bool OnStreamCreated(const info::Stream &stream_info);
 		bool OnStreamDeleted(const info::Stream &stream_info);
 		bool OnStreamUpdated(const info::Stream &stream_info);
@@ -62,6 +74,7 @@ namespace mon
 		std::shared_ptr<ServerMetrics> _server_metric = nullptr;
 		EventLogger	_logger;
 		EventForwarder _forwarder;
+		SegmentCacheMetrics _segment_cache_metrics;
 		bool _is_analytics_on = false;
 
 	};
@@ -0,0 +1,466 @@
+//==============================================================================
+//
+//  OvenMediaEngine
+//
+//  Created by Getroot
+//  Copyright (c) 2022 AirenSoft. All rights reserved.
+//
+//==============================================================================
+#include "open_metrics_exporter.h"
+
+#include <inttypes.h>
+
+#include "monitoring.h"
+#include "monitoring_private.h"
+
+namespace mon
+{
+	struct MetricFamily
+	{
+		const char *name;
+		// "counter" or "gauge"
+		const char *type;
+		const char *help;
+		uint64_t (*getter)(const CommonMetrics &metrics);
+	};
+
+	static const MetricFamily METRIC_FAMILIES[] = {
+		{"bytes_in", "counter", "Total bytes received from the providers",
+		 [](const CommonMetrics &metrics) -> uint64_t { return metrics.GetTotalBytesIn(); }},
+		{"bytes_out", "counter", "Total bytes sent by the publishers",
+		 [](const CommonMetrics &metrics) -> uint64_t { return metrics.GetTotalBytesOut(); }},
+		{"bitrate_in", "gauge", "Average bitrate of the input in bps",
+		 [](const CommonMetrics &metrics) -> uint64_t { return metrics.GetAvgBitrateIn(); }},
+		{"bitrate_out", "gauge", "Average bitrate of the output in bps",
+		 [](const CommonMetrics &metrics) -> uint64_t { return metrics.GetAvgBitrateOut(); }},
+		{"connections", "gauge", "Number of sessions",
+		 [](const CommonMetrics &metrics) -> uint64_t { return metrics.GetTotalConnections(); }},
+		{"max_connections", "gauge", "Maximum number of sessions",
+		 [](const CommonMetrics &metrics) -> uint64_t { return metrics.GetMaxTotalConnections(); }}};
+
+	// Escapes a label value (\, " and newline)
+	static void AppendLabel(ov::String &labels, const char *name, const ov::String &value)
+	{
+		if (labels.IsEmpty() == false)
+		{
+			labels.Append(',');
+		}
+
+		labels.Append(name);
+		labels.Append("=\"", 2);
+
+		auto data = value.CStr();
+		auto length = value.GetLength();
+
+		for (size_t index = 0; index < length; index++)
+		{
+			switch (data[index])
+			{
+				case '\\':
+					labels.Append("\\\\", 2);
+					break;
+				case '"':
+					labels.Append("\\\"", 2);
+					break;
+				case '\n':
+					labels.Append("\\n", 2);
+					break;
+				default:
+					labels.Append(data[index]);
+					break;
+			}
+		}
+
+		labels.Append('"');
+	}
+
+	static void AppendFamilyHeader(ov::String &output, const char *name, const char *type, const char *help)
+	{
+		output.AppendFormat("# TYPE %s %s\n# HELP %s %s\n", name, type, name, help);
+	}
+
+	static void AppendSample(ov::String &output, const char *name, const char *suffix, const ov::String &labels, const char *extra_labels, uint64_t value)
+	{
+		output.Append(name);
+		output.Append(suffix);
+
+		auto has_labels = (labels.IsEmpty() == false);
+		auto has_extra_labels = ((extra_labels != nullptr) && (extra_labels[0] != '\0'));
+
+		if (has_labels || has_extra_labels)
+		{
+			output.Append('{');
+			output.Append(labels.CStr(), labels.GetLength());
+
+			if (has_extra_labels)
+			{
+				if (has_labels)
+				{
+					output.Append(',');
+				}
+
+				output.Append(extra_labels);
+			}
+
+			output.Append('}');
+		}
+
+		output.AppendFormat(" %" PRIu64 "\n", value);
+	}
+
+	// Converts microseconds to seconds without the exponent notation (e.g. 10 => 0.00001)
+	static void AppendSeconds(ov::String &output, uint64_t usec)
+	{
+		auto fraction = usec % 1000000;
+
+		if (fraction == 0)
+		{
+			output.AppendFormat("%" PRIu64 ".0", usec / 1000000);
+			return;
+		}
+
+		char fraction_string[8];
+		::snprintf(fraction_string, sizeof(fraction_string), "%06" PRIu64, fraction);
+
+		// Trim trailing zeros
+		auto fraction_length = ::strlen(fraction_string);
+		while (fraction_string[fraction_length - 1] == '0')
+		{
+			fraction_length--;
+		}
+
+		output.AppendFormat("%" PRIu64 ".", usec / 1000000);
+		output.Append(fraction_string, fraction_length);
+	}
+
+	OpenMetricsExporter::OpenMetricsExporter(size_t max_stream_count)
+		: _max_stream_count(max_stream_count)
+	{
+	}
+
+	ov::String OpenMetricsExporter::Render()
+	{
+		ov::String output;
+		output.SetCapacity(_last_length + (_last_length / 8));
+
+		auto monitoring = Monitoring::GetInstance();
+		auto server_metrics = monitoring->GetServerMetrics();
+
+		std::vector<Series> vhost_series_list;
+		std::vector<Series> app_series_list;
+		std::vector<Series> stream_series_list;
+		size_t omitted_stream_count = 0;
+
+		if (server_metrics != nullptr)
+		{
+			for (const auto &vhost_item : server_metrics->GetHostMetricsList())
+			{
+				const auto &vhost_metrics = vhost_item.second;
+
+				ov::String vhost_labels;
+				AppendLabel(vhost_labels, "vhost", vhost_metrics->GetName());
+				vhost_series_list.push_back({vhost_labels, vhost_metrics});
+
+				for (const auto &app_item : vhost_metrics->GetApplicationMetricsList())
+				{
+					const auto &app_metrics = app_item.second;
+
+					ov::String app_labels = vhost_labels;
+					AppendLabel(app_labels, "app", app_metrics->GetName().GetAppName());
+					app_series_list.push_back({app_labels, app_metrics});
+
+					for (const auto &stream_item : app_metrics->GetStreamMetricsMap())
+					{
+						const auto &stream_metrics = stream_item.second;
+
+						// Output streams are a part of the input stream
+						if (stream_metrics->GetLinkedInputStream() != nullptr)
+						{
+							continue;
+						}
+
+						// Limit the cardinality of the labels
+						if (stream_series_list.size() >= _max_stream_count)
+						{
+							omitted_stream_count++;
+							continue;
+						}
+
+						ov::String stream_labels = app_labels;
+						AppendLabel(stream_labels, "stream", stream_metrics->GetName());
+						stream_series_list.push_back({stream_labels, stream_metrics, stream_metrics});
+					}
+				}
+			}
+
+			WriteLevel(output, "server", {{"", server_metrics}});
+		}
+
+		WriteLevel(output, "vhost", vhost_series_list);
+		WriteLevel(output, "app", app_series_list);
+		WriteLevel(output, "stream", stream_series_list);
+		WriteMediaRouterQueueDelay(output, stream_series_list);
+		WriteIngestParseLag(output, stream_series_list);
+
+		AppendFamilyHeader(output, "ome_omitted_streams", "gauge", "Number of streams not rendered due to the cardinality limit");
+		AppendSample(output, "ome_omitted_streams", "", "", nullptr, omitted_stream_count);
+
+		auto forwarder_statistics = Monitoring::GetInstance()->GetEventForwarder().GetStatistics();
+		AppendFamilyHeader(output, "ome_event_forwarder_events", "counter", "Number of events forwarded to the collector");
+		AppendSample(output, "ome_event_forwarder_events", "_total", "", nullptr, forwarder_statistics.forwarded_events);
+		AppendFamilyHeader(output, "ome_event_forwarder_bytes", "counter", "Bytes of the events forwarded to the collector (before compression)");
+		AppendSample(output, "ome_event_forwarder_bytes", "_total", "", nullptr, forwarder_statistics.forwarded_bytes);
+		AppendFamilyHeader(output, "ome_event_forwarder_sent_bytes", "counter", "Bytes sent to the collector");
+		AppendSample(output, "ome_event_forwarder_sent_bytes", "_total", "", nullptr, forwarder_statistics.sent_bytes);
+		AppendFamilyHeader(output, "ome_event_forwarder_batches", "counter", "Number of batches forwarded to the collector");
+		AppendSample(output, "ome_event_forwarder_batches", "_total", "", nullptr, forwarder_statistics.batches);
+		AppendFamilyHeader(output, "ome_event_forwarder_failures", "counter", "Number of failed attempts to forward a batch");
+		AppendSample(output, "ome_event_forwarder_failures", "_total", "", nullptr, forwarder_statistics.failures);
+
+		WriteSegmentCache(output);
+
+		Histogram::Snapshot snapshot;
+		for (size_t index = 0; index < static_cast<size_t>(HistogramType::NumberOfHistograms); index++)
+		{
+			WriteHistogram(output, GetHistogram(static_cast<HistogramType>(index)), &snapshot);
+		}
+
+		output.Append("# EOF\n");
+
+		_last_length = output.GetLength();
+
+		return output;
+	}
+
+	void OpenMetricsExporter::WriteLevel(ov::String &output, const char *level, const std::vector<Series> &series_list) const
+	{
+		if (series_list.empty())
+		{
+			return;
+		}
+
+		// All samples of a family must be contiguous
+		for (const auto &family : METRIC_FAMILIES)
+		{
+			auto name = ov::String::FormatString("ome_%s_%s", level, family.name);
+			auto suffix = (::strcmp(family.type, "counter") == 0) ? "_total" : "";
+
+			AppendFamilyHeader(output, name.CStr(), family.type, family.help);
+
+			for (const auto &series : series_list)
+			{
+				AppendSample(output, name.CStr(), suffix, series.labels, nullptr, family.getter(*series.metrics));
+			}
+		}
+
+		// Connections per publisher
+		auto name = ov::String::FormatString("ome_%s_publisher_connections", level);
+		AppendFamilyHeader(output, name.CStr(), "gauge", "Number of sessions per publisher");
+
+		for (const auto &series : series_list)
+		{
+			for (int type = static_cast<int>(PublisherType::Unknown) + 1; type < static_cast<int>(PublisherType::NumberOfPublishers); type++)
+			{
+				auto publisher_type = static_cast<PublisherType>(type);
+				auto publisher_label = ov::String::FormatString("publisher=\"%s\"", StringFromPublisherType(publisher_type).LowerCaseString().CStr());
+
+				AppendSample(output, name.CStr(), "", series.labels, publisher_label.CStr(), series.metrics->GetConnections(publisher_type));
+			}
+		}
+	}
+
+	void OpenMetricsExporter::WriteSegmentCache(ov::String &output) const
+	{
+		static const struct
+		{
+			const char *name;
+			const char *type;
+			const char *help;
+			uint64_t SegmentCacheMetrics::Statistics::*value;
+		} families[] = {
+			{"ome_segment_cache_hits", "counter", "Number of segment requests served from the segment cache", &SegmentCacheMetrics::Statistics::hits},
+			{"ome_segment_cache_misses", "counter", "Number of segment requests not found in the segment cache", &SegmentCacheMetrics::Statistics::misses},
+			{"ome_segment_cache_evictions", "counter", "Number of segments evicted from the segment cache", &SegmentCacheMetrics::Statistics::evictions},
+			{"ome_segment_cache_bytes", "gauge", "Bytes of the segments in the segment cache", &SegmentCacheMetrics::Statistics::bytes},
+			{"ome_segment_cache_entries", "gauge", "Number of the segments in the segment cache", &SegmentCacheMetrics::Statistics::entries}};
+
+		auto &metrics = Monitoring::GetInstance()->GetSegmentCacheMetrics();
+
+		// Only the publishers that use the segment cache are rendered
+		std::vector<std::pair<ov::String, SegmentCacheMetrics::Statistics>> statistics_list;
+		for (int type = static_cast<int>(PublisherType::Unknown) + 1; type < static_cast<int>(PublisherType::NumberOfPublishers); type++)
+		{
+			auto publisher_type = static_cast<PublisherType>(type);
+			auto statistics = metrics.GetStatistics(publisher_type);
+
+			if ((statistics.hits == 0) && (statistics.misses == 0) && (statistics.entries == 0))
+			{
+				continue;
+			}
+
+			statistics_list.emplace_back(ov::String::FormatString("publisher=\"%s\"", StringFromPublisherType(publisher_type).LowerCaseString().CStr()), statistics);
+		}
+
+		if (statistics_list.empty())
+		{
+			return;
+		}
+
+		for (const auto &family : families)
+		{
+			AppendFamilyHeader(output, family.name, family.type, family.help);
+
+			for (const auto &item : statistics_list)
+			{
+				AppendSample(output, family.name, (::strcmp(family.type, "counter") == 0) ? "_total" : "", "", item.first.CStr(), item.second.*family.value);
+			}
+		}
+	}
+
+	void OpenMetricsExporter::WriteMediaRouterQueueDelay(ov::String &output, const std::vector<Series> &series_list) const
+	{
+		if (series_list.empty())
+		{
+			return;
+		}
+
+		struct QueueDelayFamily
+		{
+			const char *name;
+			const char *help;
+			int64_t (StreamMetrics::*getter)() const;
+		};
+
+		static const QueueDelayFamily QUEUE_DELAY_FAMILIES[] = {
+			{"ome_stream_mediarouter_queue_delay_seconds", "Average time the packets wait in the queue of MediaRouter",
+			 &StreamMetrics::GetMediaRouterQueueDelayUSec},
+			{"ome_stream_mediarouter_max_queue_delay_seconds", "Maximum time the packets wait in the queue of MediaRouter",
+			 &StreamMetrics::GetMaxMediaRouterQueueDelayUSec}};
+
+		for (const auto &family : QUEUE_DELAY_FAMILIES)
+		{
+			AppendFamilyHeader(output, family.name, "gauge", family.help);
+			output.AppendFormat("# UNIT %s seconds\n", family.name);
+
+			for (const auto &series : series_list)
+			{
+				const auto &stream_metrics = series.stream_metrics;
+
+				if (stream_metrics == nullptr)
+				{
+					continue;
+				}
+
+				// The input stream is routed by the inbound queue, and the output streams (e.g. renditions of the transcoder)
+				// are routed by the outbound queues. The worst output stream is rendered for the outbound.
+				int64_t inbound_usec = (stream_metrics.get()->*family.getter)();
+				int64_t outbound_usec = 0;
+
+				for (const auto &output_stream_metrics : stream_metrics->GetLinkedOutputStreamMetrics())
+				{
+					outbound_usec = std::max(outbound_usec, (output_stream_metrics.get()->*family.getter)());
+				}
+
+				for (const auto &[direction, usec] : {std::make_pair("inbound", inbound_usec), std::make_pair("outbound", outbound_usec)})
+				{
+					output.AppendFormat("%s{%s,direction=\"%s\"} ", family.name, series.labels.CStr(), direction);
+					AppendSeconds(output, static_cast<uint64_t>(std::max<int64_t>(usec, 0)));
+					output.Append('\n');
+				}
+			}
+		}
+	}
+
+	void OpenMetricsExporter::WriteIngestParseLag(ov::String &output, const std::vector<Series> &series_list) const
+	{
+		if (series_list.empty())
+		{
+			return;
+		}
+
+		struct ParseLagFamily
+		{
+			const char *name;
+			const char *help;
+			int64_t (StreamMetrics::*getter)() const;
+		};
+
+		static const ParseLagFamily PARSE_LAG_FAMILIES[] = {
+			{"ome_stream_ingest_parse_lag_seconds", "Average time the received data waits until it is parsed by an ingest worker",
+			 &StreamMetrics::GetIngestParseLagUSec},
+			{"ome_stream_ingest_max_parse_lag_seconds", "Maximum time the received data waits until it is parsed by an ingest worker",
+			 &StreamMetrics::GetMaxIngestParseLagUSec}};
+
+		for (const auto &family : PARSE_LAG_FAMILIES)
+		{
+			AppendFamilyHeader(output, family.name, "gauge", family.help);
+			output.AppendFormat("# UNIT %s seconds\n", family.name);
+
+			for (const auto &series : series_list)
+			{
+				const auto &stream_metrics = series.stream_metrics;
+
+				if (stream_metrics == nullptr)
+				{
+					continue;
+				}
+
+				// Only the streams of the push providers that use the ingest workers
+				auto source_type = stream_metrics->GetSourceType();
+				if ((source_type != StreamSourceType::Rtmp) && (source_type != StreamSourceType::Mpegts) && (source_type != StreamSourceType::Srt))
+				{
+					continue;
+				}
+
+				output.AppendFormat("%s{%s} ", family.name, series.labels.CStr());
+				AppendSeconds(output, static_cast<uint64_t>(std::max<int64_t>((stream_metrics.get()->*family.getter)(), 0)));
+				output.Append('\n');
+			}
+		}
+	}
+
+	void OpenMetricsExporter::WriteHistogram(ov::String &output, const Histogram &histogram, Histogram::Snapshot *snapshot) const
+	{
+		histogram.GetSnapshot(snapshot);
+
+		auto name = histogram.GetName();
+		const auto &upper_bounds = histogram.GetUpperBounds();
+		auto is_seconds = (histogram.GetUnit() == Histogram::Unit::Seconds);
+
+		AppendFamilyHeader(output, name, "histogram", histogram.GetHelp());
+		output.AppendFormat("# UNIT %s %s\n", name, is_seconds ? "seconds" : "bytes");
+
+		for (size_t index = 0; index < snapshot->bucket_counts.size(); index++)
+		{
+			output.Append(name);
+			output.Append("_bucket{le=\"");
+
+			if (index >= upper_bounds.size())
+			{
+				output.Append("+Inf");
+			}
+			else if (is_seconds)
+			{
+				AppendSeconds(output, upper_bounds[index]);
+			}
+			else
+			{
+				output.AppendFormat("%" PRId64 ".0", upper_bounds[index]);
+			}
+
+			output.AppendFormat("\"} %" PRIu64 "\n", snapshot->bucket_counts[index]);
+		}
+
+		output.AppendFormat("%s_count %" PRIu64 "\n%s_sum ", name, snapshot->count, name);
+
+		if (is_seconds)
+		{
+			AppendSeconds(output, snapshot->sum);
+			output.Append('\n');
+		}
+		else
+		{
+			output.AppendFormat("%" PRIu64 "\n", snapshot->sum);
+		}
+	}
+}  // namespace mon
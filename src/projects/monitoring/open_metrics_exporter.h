@@ -0,0 +1,64 @@
+//==============================================================================
+//
+//  OvenMediaEngine
+//
+//  Created by Getroot
+//  Copyright (c) 2022 AirenSoft. All rights reserved.
+//
+//==============================================================================
+#pragma once
+
+#include <base/ovlibrary/ovlibrary.h>
+
+#include "common_metrics.h"
+#include "histogram.h"
+
+// Maximum number of streams rendered with the per-stream series.
+// The remaining streams are still counted in the app/vhost/server series.
+#define MON_OPEN_METRICS_MAX_STREAM_COUNT 1000
+
+#define MON_OPEN_METRICS_CONTENT_TYPE "application/openmetrics-text; version=1.0.0; charset=utf-8"
+
+namespace mon
+{
+	class StreamMetrics;
+
+	// Renders the metrics in the OpenMetrics text format (https://openmetrics.io)
+	//
+	// - ome_server_*, ome_vhost_*, ome_app_* and ome_stream_* families for each level of the metrics
+	//   (labels: vhost, app, stream and publisher)
+	// - ome_stream_mediarouter_*queue_delay_seconds for each input stream (labels: direction)
+	// - ome_stream_ingest_*parse_lag_seconds for each input stream of RTMP, MPEG-TS and SRT
+	// - ome_segment_cache_* families for each publisher that uses the segment cache (labels: publisher)
+	// - Histograms of HistogramType (no labels)
+	//
+	// The values are read from the atomics of the metrics, so rendering never blocks the media threads.
+	class OpenMetricsExporter
+	{
+	public:
+		OpenMetricsExporter(size_t max_stream_count = MON_OPEN_METRICS_MAX_STREAM_COUNT);
+
+		ov::String Render();
+
+	protected:
+		struct Series
+		{
+			// Rendered labels (e.g. vhost="default",app="app")
+			ov::String labels;
+			std::shared_ptr<const CommonMetrics> metrics;
+			// Only for the stream level
+			std::shared_ptr<const StreamMetrics> stream_metrics;
+		};
+
+		void WriteLevel(ov::String &output, const char *level, const std::vector<Series> &series_list) const;
+		void WriteMediaRouterQueueDelay(ov::String &output, const std::vector<Series> &series_list) const;
+		void WriteIngestParseLag(ov::String &output, const std::vector<Series> &series_list) const;
+		void WriteSegmentCache(ov::String &output) const;
+		void WriteHistogram(ov::String &output, const Histogram &histogram, Histogram::Snapshot *snapshot) const;
+
+		size_t _max_stream_count;
+
+		// The output is reserved with the size of the last one, so the buffer does not grow many times on each scrape
+		std::atomic<size_t> _last_length{4096};
+	};
+}  // namespace mon
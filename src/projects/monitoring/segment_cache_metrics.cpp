@@ -0,0 +1,58 @@
+//==============================================================================
+//
+//  OvenMediaEngine
+//
+//  Created by Getroot
+//  Copyright (c) 2022 AirenSoft. All rights reserved.
+//
+//==============================================================================
+#include "segment_cache_metrics.h"
+
+namespace mon
+{
+	void SegmentCacheMetrics::IncreaseHits(PublisherType type)
+	{
+		GetCounters(type).hits++;
+	}
+
+	void SegmentCacheMetrics::IncreaseMisses(PublisherType type)
+	{
+		GetCounters(type).misses++;
+	}
+
+	void SegmentCacheMetrics::OnEntryAdded(PublisherType type, uint64_t bytes)
+	{
+		auto &counters = GetCounters(type);
+
+		counters.bytes += bytes;
+		counters.entries++;
+	}
+
+	void SegmentCacheMetrics::OnEntryRemoved(PublisherType type, uint64_t bytes, bool is_evicted)
+	{
+		auto &counters = GetCounters(type);
+
+		counters.bytes -= bytes;
+		counters.entries--;
+
+		if (is_evicted)
+		{
+			counters.evictions++;
+		}
+	}
+
+	SegmentCacheMetrics::Statistics SegmentCacheMetrics::GetStatistics(PublisherType type) const
+	{
+		auto &counters = GetCounters(type);
+
+		Statistics statistics;
+
+		statistics.hits = counters.hits;
+		statistics.misses = counters.misses;
+		statistics.evictions = counters.evictions;
+		statistics.bytes = counters.bytes;
+		statistics.entries = counters.entries;
+
+		return statistics;
+	}
+}  // namespace mon
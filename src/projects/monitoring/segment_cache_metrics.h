@@ -0,0 +1,59 @@
+//==============================================================================
+//
+//  OvenMediaEngine
+//
+//  Created by Getroot
+//  Copyright (c) 2022 AirenSoft. All rights reserved.
+//
+//==============================================================================
+#pragma once
+
+#include "base/common_types.h"
+
+namespace mon
+{
+	// Counters of the segment caches of the segment stream servers (per publisher)
+	class SegmentCacheMetrics
+	{
+	public:
+		struct Statistics
+		{
+			uint64_t hits = 0;
+			uint64_t misses = 0;
+			uint64_t evictions = 0;
+			// Current size of the cached segments
+			uint64_t bytes = 0;
+			uint64_t entries = 0;
+		};
+
+		void IncreaseHits(PublisherType type);
+		void IncreaseMisses(PublisherType type);
+		void OnEntryAdded(PublisherType type, uint64_t bytes);
+		// is_evicted: false if the entry is replaced by a new one
+		void OnEntryRemoved(PublisherType type, uint64_t bytes, bool is_evicted);
+
+		Statistics GetStatistics(PublisherType type) const;
+
+	private:
+		struct Counters
+		{
+			std::atomic<uint64_t> hits{0};
+			std::atomic<uint64_t> misses{0};
+			std::atomic<uint64_t> evictions{0};
+			std::atomic<uint64_t> bytes{0};
+			std::atomic<uint64_t> entries{0};
+		};
+
+		Counters &GetCounters(PublisherType type)
+		{
+			return _counters[static_cast<size_t>(type)];
+		}
+
+		const Counters &GetCounters(PublisherType type) const
+		{
+			return _counters[static_cast<size_t>(type)];
+		}
+
+		Counters _counters[static_cast<size_t>(PublisherType::NumberOfPublishers)];
+	};
+}  // namespace mon
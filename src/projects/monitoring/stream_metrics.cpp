@@ -63,6 +63,40 @@ namespace mon
 		UpdateDate();
 	}
 
+	int64_t StreamMetrics::GetMediaRouterQueueDelayUSec() const
+	{
+		return _mediarouter_queue_delay_usec.load();
+	}
+
+	int64_t StreamMetrics::GetMaxMediaRouterQueueDelayUSec() const
+	{
+		return _max_mediarouter_queue_delay_usec.load();
+	}
+
+	void StreamMetrics::SetMediaRouterQueueDelay(int64_t average_usec, int64_t max_usec)
+	{
+		// This is updated periodically by MediaRouter, so UpdateDate() is not called
+		_mediarouter_queue_delay_usec = average_usec;
+		_max_mediarouter_queue_delay_usec = max_usec;
+	}
+
+	int64_t StreamMetrics::GetIngestParseLagUSec() const
+	{
+		return _ingest_parse_lag_usec.load();
+	}
+
+	int64_t StreamMetrics::GetMaxIngestParseLagUSec() const
+	{
+		return _max_ingest_parse_lag_usec.load();
+	}
+
+	void StreamMetrics::SetIngestParseLag(int64_t average_usec, int64_t max_usec)
+	{
+		// This is updated periodically by the ingest worker, so UpdateDate() is not called
+		_ingest_parse_lag_usec = average_usec;
+		_max_ingest_parse_lag_usec = max_usec;
+	}
+
 	void StreamMetrics::IncreaseBytesIn(uint64_t value)
 	{
 		CommonMetrics::IncreaseBytesIn(value);
@@ -47,6 +47,16 @@ namespace mon
 		void SetOriginConnectionTimeMSec(int64_t value);
 		void SetOriginSubscribeTimeMSec(int64_t value);
 
+		// Time the packets of this stream wait in the queue of MediaRouter (average/maximum of the last interval)
+		int64_t GetMediaRouterQueueDelayUSec() const;
+		int64_t GetMaxMediaRouterQueueDelayUSec() const;
+		void SetMediaRouterQueueDelay(int64_t average_usec, int64_t max_usec);
+
+		// Time the received data of this stream waits until it is parsed by an ingest worker (average/maximum of the last interval)
+		int64_t GetIngestParseLagUSec() const;
+		int64_t GetMaxIngestParseLagUSec() const;
+		void SetIngestParseLag(int64_t average_usec, int64_t max_usec);
+
 		// Overriding from CommonMetrics 
 		void IncreaseBytesIn(uint64_t value) override;
 		void IncreaseBytesOut(PublisherType type, uint64_t value) override;
@@ -58,6 +68,12 @@ namespace mon
 		std::atomic<int64_t> _connection_time_to_origin_msec = 0;
 		std::atomic<int64_t> _subscribe_time_from_origin_msec = 0;
 
+		std::atomic<int64_t> _mediarouter_queue_delay_usec = 0;
+		std::atomic<int64_t> _max_mediarouter_queue_delay_usec = 0;
+
+		std::atomic<int64_t> _ingest_parse_lag_usec = 0;
+		std::atomic<int64_t> _max_ingest_parse_lag_usec = 0;
+
 		// If this stream is from Provider(input stream) it has multiple output streams
 		std::vector<std::shared_ptr<StreamMetrics>> _output_stream_metrics;
 
@@ -103,6 +103,12 @@ namespace ocst
 		{
 			return ModuleType::Transcoder;
 		}
+
+		/// Called when only the output profiles of the application are changed
+		///
+		/// @param app_info The information of the application with the new configuration
+		/// @param affected_stream_list The names of the input streams whose output streams are recreated
+		virtual bool OnUpdateOutputProfiles(const info::Application &app_info, std::vector<ov::String> *affected_stream_list) = 0;
 	};
 
 	class PublisherModuleInterface : public ModuleInterface
@@ -237,6 +237,34 @@ namespace ocst
 		return result;
 	}
 
+	ocst::Result Orchestrator::UpdateApplication(const info::Application &app_info, const cfg::vhost::app::Application &app_config, std::vector<ov::String> *affected_stream_list)
+	{
+		auto scoped_lock = std::scoped_lock(_module_list_mutex, _virtual_host_map_mutex);
+
+		auto result = OrchestratorInternal::UpdateApplication(app_info, app_config, affected_stream_list);
+		switch (result)
+		{
+			case ocst::Result::Failed:
+				logtc("Failed to update an application: %s", app_info.GetName().CStr());
+				break;
+
+			case ocst::Result::Succeeded:
+				break;
+
+			case ocst::Result::Exists:
+				// This should never happen
+				OV_ASSERT2(false);
+				logtc("Internal error occurred (THIS IS A BUG)");
+				break;
+
+			case ocst::Result::NotExists:
+				logtc("Unable to update application (does not exist): %s", app_info.GetName().CStr());
+				break;
+		}
+
+		return result;
+	}
+
 	const info::Application &Orchestrator::GetApplicationInfo(const ov::String &vhost_name, const ov::String &app_name) const
 	{
 		auto scoped_lock = std::scoped_lock(_virtual_host_map_mutex);
@@ -550,12 +578,24 @@ namespace ocst
 				  vhost_app_name.CStr(), stream_name.CStr(),
 				  GetModuleTypeName(provider_module->GetModuleType()).CStr());
 			
-			auto stream = provider_module->PullStream(request_from, app_info, stream_name, url_list, offset, properties);
+			std::shared_ptr<pvd::Stream> stream;
+			auto pulled = _pull_coalescer.Pull(PullCoalescer::MakeKey(vhost_app_name, stream_name, url_list), [&]() -> bool {
+				stream = provider_module->PullStream(request_from, app_info, stream_name, url_list, offset, properties);
+				return (stream != nullptr);
+			});
 
-			if (stream != nullptr)
+			if (pulled)
 			{
-				logti("The stream was pulled successfully: [%s/%s] (%u)",
-					  vhost_app_name.CStr(), stream_name.CStr(), stream->GetId());
+				if (stream != nullptr)
+				{
+					logti("The stream was pulled successfully: [%s/%s] (%u)",
+						  vhost_app_name.CStr(), stream_name.CStr(), stream->GetId());
+				}
+				else
+				{
+					logti("The stream was pulled successfully by another request: [%s/%s]",
+						  vhost_app_name.CStr(), stream_name.CStr());
+				}
 
 				return true;
 			}
@@ -699,9 +739,11 @@ namespace ocst
 		properties->EnableRelay(matched_origin->relay);
 		properties->EnableFromOriginMapStroe(false);
 		
-		auto stream = provider_module->PullStream(request_from, app_info, stream_name, url_list, offset, properties);
+		auto pulled = _pull_coalescer.Pull(PullCoalescer::MakeKey(vhost_app_name, stream_name, url_list), [&]() -> bool {
+			return (provider_module->PullStream(request_from, app_info, stream_name, url_list, offset, properties) != nullptr);
+		});
 
-		if (stream != nullptr)
+		if (pulled)
 		{
 			return true;
 
@@ -1045,7 +1087,7 @@ namespace ocst
 			return CommonErrorCode::DISABLED;
 		}
 
-		auto persist_streams = app_info.GetConfig().GetPersistentStreams();
+		auto persist_streams = app_info.GetConfig()->GetPersistentStreams();
 		for(auto conf : persist_streams.GetStreams())
 		{
 			auto ovt_scheme = ov::String("ovt");
@@ -9,6 +9,7 @@
 #pragma once
 
 #include "orchestrator_internal.h"
+#include "pull_coalescer.h"
 
 namespace ocst
 {
@@ -75,6 +76,20 @@ namespace ocst
 		///
 		/// @note If an error occurs during deletion, do not recreate the application
 		Result DeleteApplication(const info::Application &app_info);
+		/// Apply the new configuration to the application
+		///
+		/// @param app_info Application information to update
+		/// @param app_config New configuration of the application
+		/// @param affected_stream_list The names of the streams whose sessions are closed by the update (optional)
+		///
+		/// @return Update result
+		///
+		/// @note Only the publishers whose configuration has changed are recreated, so the streams and the sessions
+		///       of the other publishers are kept. If OutputProfiles have changed, the transcoder streams are recreated
+		///       while the input streams keep running. The providers are not reconfigured in place: if the other parts
+		///       (Providers, Decodes, PersistentStreams, ...) have changed or the application was created dynamically,
+		///       the application is deleted and created again, and all streams are affected.
+		Result UpdateApplication(const info::Application &app_info, const cfg::vhost::app::Application &app_config, std::vector<ov::String> *affected_stream_list = nullptr);
 
 		ov::String GetVhostNameFromDomain(const ov::String &domain_name) const;
 
@@ -102,6 +117,9 @@ namespace ocst
 		const info::Application &GetApplicationInfo(const ov::String &vhost_name, const ov::String &app_name) const;
 		const info::Application &GetApplicationInfo(const info::VHostAppName &vhost_app_name) const;
 
+		/// Pull a stream using specified URLs with offset
+		///
+		/// @note The concurrent requests for the same stream share one pull, and the request fails immediately if the pull failed recently
 		bool RequestPullStreamWithUrls(
 			const std::shared_ptr<const ov::Url> &request_from,
 			const info::VHostAppName &vhost_app_name, const ov::String &stream_name,
@@ -194,5 +212,8 @@ namespace ocst
 	protected:
 		std::recursive_mutex _module_list_mutex;
 		mutable std::recursive_mutex _virtual_host_map_mutex;
+
+		// The concurrent requests for the same stream share one pull
+		PullCoalescer _pull_coalescer;
 	};
 }  // namespace ocst
@@ -864,6 +864,269 @@ namespace ocst
 		return DeleteApplication(vhost_app_name.GetVHostName(), app_info.GetId());
 	}
 
+	static bool IsSameConfig(const cfg::Item &item1, const cfg::Item &item2)
+	{
+		if (item1.IsParsed() != item2.IsParsed())
+		{
+			return false;
+		}
+
+		try
+		{
+			return item1.ToJson() == item2.ToJson();
+		}
+		catch (const cfg::ConfigError &error)
+		{
+			logtw("Could not compare the configuration: %s", error.What());
+		}
+
+		// Consider it changed
+		return false;
+	}
+
+	bool OrchestratorInternal::DiffApplicationConfig(const info::Application &app_info, const cfg::vhost::app::Application &app_config, bool *is_output_profiles_changed, std::vector<PublisherType> *changed_publisher_list) const
+	{
+		auto current_config = app_info.GetConfig();
+
+		if (app_info.IsDynamicApp())
+		{
+			// The dynamically created app activates all publishers regardless of the configuration
+			return false;
+		}
+
+		if ((current_config->GetName() != app_config.GetName()) ||
+			(current_config->GetTypeString() != app_config.GetTypeString()))
+		{
+			return false;
+		}
+
+		// The providers and the decoders cannot be reconfigured while the streams are running
+		if ((IsSameConfig(current_config->GetDecodes(), app_config.GetDecodes()) == false) ||
+			(IsSameConfig(current_config->GetProviders(), app_config.GetProviders()) == false) ||
+			(IsSameConfig(current_config->GetPersistentStreams(), app_config.GetPersistentStreams()) == false))
+		{
+			return false;
+		}
+
+		// The output profiles are applied by recreating the transcoder streams, while the input streams keep running
+		*is_output_profiles_changed = (IsSameConfig(current_config->GetOutputProfiles(), app_config.GetOutputProfiles()) == false);
+
+		auto &current_publishers = current_config->GetPublishers();
+		auto &new_publishers = app_config.GetPublishers();
+
+		// PredictPacketDuration is applied by MediaRouter when the outbound stream is created
+		if (current_publishers.IsPacketDurationPredictionEnabled() != new_publishers.IsPacketDurationPredictionEnabled())
+		{
+			return false;
+		}
+
+		// The worker counts are applied to all publisher applications
+		bool is_worker_count_changed = (current_publishers.GetAppWorkerCount() != new_publishers.GetAppWorkerCount()) ||
+									   (current_publishers.GetStreamWorkerCount() != new_publishers.GetStreamWorkerCount());
+
+		auto current_publisher_list = current_publishers.GetPublisherList();
+		auto new_publisher_list = new_publishers.GetPublisherList();
+
+		OV_ASSERT2(current_publisher_list.size() == new_publisher_list.size());
+
+		for (size_t index = 0; index < current_publisher_list.size(); index++)
+		{
+			auto current_publisher = current_publisher_list[index];
+			auto new_publisher = new_publisher_list[index];
+
+			if (is_worker_count_changed || (IsSameConfig(*current_publisher, *new_publisher) == false))
+			{
+				changed_publisher_list->push_back(current_publisher->GetType());
+			}
+		}
+
+		return true;
+	}
+
+	ocst::Result OrchestratorInternal::UpdateApplication(const info::Application &app_info, const cfg::vhost::app::Application &app_config, std::vector<ov::String> *affected_stream_list)
+	{
+		auto &vhost_app_name = app_info.GetName();
+
+		if (vhost_app_name.IsValid() == false)
+		{
+			return Result::Failed;
+		}
+
+		auto &vhost_name = vhost_app_name.GetVHostName();
+		auto vhost = GetVirtualHost(vhost_name);
+
+		if (vhost == nullptr)
+		{
+			return Result::Failed;
+		}
+
+		auto app_item = vhost->app_map.find(app_info.GetId());
+		if (app_item == vhost->app_map.end())
+		{
+			logti("Application %d does not exists", app_info.GetId());
+			return Result::NotExists;
+		}
+
+		auto app = app_item->second;
+		// Keep the current information since app->app_info is updated below
+		auto current_app_info = app->app_info;
+
+		// The stream names (an input stream and its output stream have the same name)
+		std::set<ov::String> affected_stream_names;
+
+		bool is_output_profiles_changed = false;
+		std::vector<PublisherType> changed_publisher_list;
+
+		if (DiffApplicationConfig(current_app_info, app_config, &is_output_profiles_changed, &changed_publisher_list) == false)
+		{
+			auto app_metrics = mon::Monitoring::GetInstance()->GetApplicationMetrics(current_app_info);
+			if (app_metrics != nullptr)
+			{
+				for (const auto &stream_item : app_metrics->GetStreamMetricsMap())
+				{
+					affected_stream_names.insert(stream_item.second->GetName());
+				}
+			}
+
+			if (affected_stream_list != nullptr)
+			{
+				affected_stream_list->assign(affected_stream_names.begin(), affected_stream_names.end());
+			}
+
+			logti("Trying to recreate the application to apply the new configuration: [%s] (all %zu streams are affected)",
+				  vhost_app_name.CStr(), affected_stream_names.size());
+
+			auto result = DeleteApplication(current_app_info);
+			if (result != Result::Succeeded)
+			{
+				return result;
+			}
+
+			info::Application new_app_info(current_app_info.GetHostInfo(), GetNextAppId(), vhost_app_name, app_config, false);
+			return CreateApplication(vhost_name, new_app_info);
+		}
+
+		if ((is_output_profiles_changed == false) && changed_publisher_list.empty())
+		{
+			logti("The configuration of the application has not changed: [%s]", vhost_app_name.CStr());
+			return Result::Succeeded;
+		}
+
+		// The configuration is shared by the orchestrator, the new publisher applications and the monitoring module,
+		// and it is not modified after this
+		auto new_config = std::make_shared<const cfg::vhost::app::Application>(app_config);
+
+		// The ID, UUID and the name are kept, so the modules that are not recreated are not affected
+		info::Application new_app_info = current_app_info;
+		new_app_info.SetConfig(new_config);
+
+		bool succeeded = true;
+
+		if (is_output_profiles_changed)
+		{
+			for (auto &module : _module_list)
+			{
+				auto transcoder = std::dynamic_pointer_cast<TranscoderModuleInterface>(module.module);
+				if ((module.type != ModuleType::Transcoder) || (transcoder == nullptr))
+				{
+					continue;
+				}
+
+				std::vector<ov::String> transcoded_stream_list;
+
+				logti("Trying to recreate the transcoder streams of the application to apply the new output profiles: [%s]", vhost_app_name.CStr());
+
+				if (transcoder->OnUpdateOutputProfiles(new_app_info, &transcoded_stream_list) == false)
+				{
+					logte("The transcoder returns error while updating the output profiles of the application [%s]", vhost_app_name.CStr());
+					succeeded = false;
+				}
+
+				affected_stream_names.insert(transcoded_stream_list.begin(), transcoded_stream_list.end());
+			}
+		}
+
+		for (auto &module : _module_list)
+		{
+			if ((succeeded == false) || (module.type != ModuleType::Publisher))
+			{
+				continue;
+			}
+
+			auto publisher = std::dynamic_pointer_cast<pub::Publisher>(module.module);
+			if ((publisher == nullptr) ||
+				(std::find(changed_publisher_list.begin(), changed_publisher_list.end(), publisher->GetPublisherType()) == changed_publisher_list.end()))
+			{
+				continue;
+			}
+
+			auto publisher_app = publisher->GetApplicationById(current_app_info.GetId());
+			auto stream_count = 0U;
+
+			if (publisher_app != nullptr)
+			{
+				// The sessions of these streams in the publisher are closed
+				for (const auto &stream_item : publisher_app->GetStreamMap())
+				{
+					affected_stream_names.insert(stream_item.second->GetName());
+					stream_count++;
+				}
+			}
+
+			logti("Trying to recreate the %s publisher of the application: [%s] (%u streams are affected)",
+				  ::StringFromPublisherType(publisher->GetPublisherType()).CStr(), vhost_app_name.CStr(), stream_count);
+
+			// Existing streams are notified to the new publisher application by MediaRouter when it is registered
+			publisher->OnDeleteApplication(current_app_info);
+
+			if (publisher->OnCreateApplication(new_app_info) == false)
+			{
+				logte("The %s publisher returns error while updating the application [%s]",
+					  ::StringFromPublisherType(publisher->GetPublisherType()).CStr(), vhost_app_name.CStr());
+				succeeded = false;
+				break;
+			}
+		}
+
+		app->app_info.SetConfig(new_config);
+		mon::Monitoring::GetInstance()->OnApplicationUpdated(new_app_info);
+
+		if (succeeded)
+		{
+			if (affected_stream_list != nullptr)
+			{
+				affected_stream_list->assign(affected_stream_names.begin(), affected_stream_names.end());
+			}
+
+			return Result::Succeeded;
+		}
+
+		logte("Trying to recreate the application [%s] to recover from the error", vhost_app_name.CStr());
+
+		if (affected_stream_list != nullptr)
+		{
+			auto app_metrics = mon::Monitoring::GetInstance()->GetApplicationMetrics(new_app_info);
+			if (app_metrics != nullptr)
+			{
+				for (const auto &stream_item : app_metrics->GetStreamMetricsMap())
+				{
+					affected_stream_names.insert(stream_item.second->GetName());
+				}
+			}
+
+			affected_stream_list->assign(affected_stream_names.begin(), affected_stream_names.end());
+		}
+
+		auto result = DeleteApplication(new_app_info);
+		if (result != Result::Succeeded)
+		{
+			return result;
+		}
+
+		info::Application recreated_app_info(current_app_info.GetHostInfo(), GetNextAppId(), vhost_app_name, app_config, false);
+		return CreateApplication(vhost_name, recreated_app_info);
+	}
+
 	const info::Application &OrchestratorInternal::GetApplicationInfo(const info::VHostAppName &vhost_app_name) const
 	{
 		if (vhost_app_name.IsValid())
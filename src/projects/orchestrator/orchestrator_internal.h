@@ -72,6 +72,16 @@ namespace ocst
 		Result DeleteApplication(const ov::String &vhost_name, info::application_id_t app_id);
 		Result DeleteApplication(const info::Application &app_info);
 
+		/// Compares the configuration of the application with app_config, and collects the publishers that have changed
+		///
+		/// @param app_info The application to compare
+		/// @param app_config New configuration of the application
+		/// @param changed_publisher_list The publishers whose configuration has changed
+		///
+		/// @return Whether the changes can be applied without recreating the application
+		bool DiffApplicationConfig(const info::Application &app_info, const cfg::vhost::app::Application &app_config, bool *is_output_profiles_changed, std::vector<PublisherType> *changed_publisher_list) const;
+		Result UpdateApplication(const info::Application &app_info, const cfg::vhost::app::Application &app_config, std::vector<ov::String> *affected_stream_list);
+
 		const info::Application &GetApplicationInfo(const info::VHostAppName &vhost_app_name) const;
 		const info::Application &GetApplicationInfo(const ov::String &vhost_name, const ov::String &app_name) const;
 		const info::Application &GetApplicationInfo(const ov::String &vhost_name, info::application_id_t app_id) const;
@@ -0,0 +1,93 @@
+//==============================================================================
+//
+//  OvenMediaEngine
+//
+//  Created by Getroot
+//  Copyright (c) 2022 AirenSoft. All rights reserved.
+//
+//==============================================================================
+#include "pull_coalescer.h"
+
+#include "orchestrator_private.h"
+
+namespace ocst
+{
+	ov::String PullCoalescer::MakeKey(const info::VHostAppName &vhost_app_name, const ov::String &stream_name, const std::vector<ov::String> &url_list)
+	{
+		auto key = ov::String::FormatString("%s/%s", vhost_app_name.CStr(), stream_name.CStr());
+
+		for (const auto &url : url_list)
+		{
+			key.Append('\n');
+			key.Append(url);
+		}
+
+		return key;
+	}
+
+	bool PullCoalescer::Pull(const ov::String &key, const PullFunction &pull_function)
+	{
+		std::unique_lock<std::mutex> lock(_mutex);
+
+		auto now_ms = ov::Time::GetMonotonicTimestamp();
+
+		auto failure_item = _failure_map.find(key);
+		if (failure_item != _failure_map.end())
+		{
+			if (now_ms < failure_item->second)
+			{
+				logtd("The pull failed recently, it will not be retried for %" PRId64 " ms: %s", failure_item->second - now_ms, key.CStr());
+				return false;
+			}
+
+			_failure_map.erase(failure_item);
+		}
+
+		auto pulling_item = _pulling_map.find(key);
+		if (pulling_item != _pulling_map.end())
+		{
+			auto future = pulling_item->second;
+			lock.unlock();
+
+			logtd("Wait for the pull requested by another request: %s", key.CStr());
+
+			if (future.wait_for(std::chrono::milliseconds(OCST_PULL_WAIT_TIMEOUT_MS)) != std::future_status::ready)
+			{
+				logtw("Timed out while waiting for the pull requested by another request: %s", key.CStr());
+				return false;
+			}
+
+			return future.get();
+		}
+
+		std::promise<bool> promise;
+		_pulling_map.emplace(key, promise.get_future().share());
+		lock.unlock();
+
+		auto result = pull_function();
+
+		lock.lock();
+
+		_pulling_map.erase(key);
+
+		if (result == false)
+		{
+			now_ms = ov::Time::GetMonotonicTimestamp();
+
+			// Remove the expired failures
+			for (auto item = _failure_map.begin(); item != _failure_map.end();)
+			{
+				item = (now_ms >= item->second) ? _failure_map.erase(item) : std::next(item);
+			}
+
+			_failure_map[key] = now_ms + OCST_PULL_FAILURE_CACHE_MS;
+		}
+
+		lock.unlock();
+
+		// Answer the waiting requests together
+		promise.set_value(result);
+
+		return result;
+	}
+}  // namespace ocst
@@ -0,0 +1,47 @@
+//==============================================================================
+//
+//  OvenMediaEngine
+//
+//  Created by Getroot
+//  Copyright (c) 2022 AirenSoft. All rights reserved.
+//
+//==============================================================================
+#pragma once
+
+#include <base/info/vhost_app_name.h>
+#include <base/ovlibrary/ovlibrary.h>
+
+#include <future>
+
+// A request waits for the pull of the same stream started by another request up to this time
+#define OCST_PULL_WAIT_TIMEOUT_MS 10000
+// A failed pull is not retried for this time (the requests in the meantime fail immediately)
+#define OCST_PULL_FAILURE_CACHE_MS 3000
+
+namespace ocst
+{
+	// Coalesces the concurrent pull requests for the same stream into one pull (single-flight)
+	//
+	// The first request runs the pull, and the following requests wait for its result instead of pulling
+	// the stream again. Since the waiting requests would retry the pull one after another if it failed,
+	// the failure is cached for OCST_PULL_FAILURE_CACHE_MS.
+	class PullCoalescer
+	{
+	public:
+		using PullFunction = std::function<bool()>;
+
+		// Makes a key of a pull ("<vhost#app>/<stream>" with the URLs, since the URLs may contain the credentials of each request)
+		static ov::String MakeKey(const info::VHostAppName &vhost_app_name, const ov::String &stream_name, const std::vector<ov::String> &url_list);
+
+		// Runs pull_function, or waits for the result of the same pull in progress
+		bool Pull(const ov::String &key, const PullFunction &pull_function);
+
+	private:
+		std::mutex _mutex;
+
+		// key: pull key, value: the result of the pull in progress
+		std::unordered_map<ov::String, std::shared_future<bool>> _pulling_map;
+		// key: pull key, value: the time the failure expires
+		std::unordered_map<ov::String, int64_t> _failure_map;
+	};
+}  // namespace ocst
@@ -63,7 +63,7 @@ namespace pvd
 		}
 
 		bool is_parsed = false;
-		app_info.GetConfig().GetProviders().GetFileProvider(&is_parsed);
+		app_info.GetConfig()->GetProviders().GetFileProvider(&is_parsed);
 		if (!is_parsed)
 		{
 			return nullptr;
@@ -86,7 +86,7 @@ namespace pvd
 	{
 		sleep(1);
 
-		auto stream_list = app_info.GetConfig().GetProviders().GetFileProvider().GetStreamMap().GetStreamList();
+		auto stream_list = app_info.GetConfig()->GetProviders().GetFileProvider().GetStreamMap().GetStreamList();
 		for (auto &stream : stream_list)
 		{
 			std::vector<ov::String> url_list;
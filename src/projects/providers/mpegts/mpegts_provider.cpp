@@ -148,8 +148,11 @@ namespace pvd
 			return true;
 		}
 
+		StartIngestWorkers();
+
 		if (BindMpegTSPorts() == false)
 		{
+			StopIngestWorkers();
 			return false;
 		}
 
@@ -175,6 +178,7 @@ namespace pvd
 		}
 
 		StopTimer();
+		StopIngestWorkers();
 
 		return true;
 	}
@@ -196,8 +200,8 @@ namespace pvd
 			return nullptr;
 		}
 
-		auto &app_config = application_info.GetConfig();
-		auto &stream_list = app_config.GetProviders().GetMpegtsProvider().GetStreamMap().GetStreamList();
+		auto app_config = application_info.GetConfig();
+		auto &stream_list = app_config->GetProviders().GetMpegtsProvider().GetStreamMap().GetStreamList();
 		auto app_metrics = ApplicationMetrics(application_info);
 
 		for (auto &stream_item : stream_list)
@@ -250,7 +254,7 @@ namespace pvd
 			return nullptr;
 		}
 
-		auto audio_map = app_config.GetProviders().GetMpegtsProvider().GetAudioMap();
+		auto audio_map = app_config->GetProviders().GetMpegtsProvider().GetAudioMap();
 		application->AddAudioMapItems(audio_map);
 
 		return application;
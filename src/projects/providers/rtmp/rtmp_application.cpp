@@ -37,7 +37,7 @@ namespace pvd
 		if(exist_stream != nullptr)
 		{
 			// Block
-			if(GetConfig().GetProviders().GetRtmpProvider().IsBlockDuplicateStreamName())
+			if(GetConfig()->GetProviders().GetRtmpProvider().IsBlockDuplicateStreamName())
 			{
 				logti("Reject %s/%s stream it is a stream with a duplicate name.", GetName().CStr(), stream->GetName().CStr());		
 				return false;
@@ -108,6 +108,8 @@ namespace pvd
 			return false;
 		}
 
+		StartIngestWorkers();
+
 		auto port_manager = PhysicalPortManager::GetInstance();
 		std::vector<ov::String> rtmp_address_string_list;
 
@@ -126,6 +128,8 @@ namespace pvd
 				}
 				_physical_port_list.clear();
 
+				StopIngestWorkers();
+
 				return false;
 			}
 
@@ -153,6 +157,8 @@ namespace pvd
 		}
 		_physical_port_list.clear();
 
+		StopIngestWorkers();
+
 		return Provider::Stop();
 	}
 
@@ -1666,7 +1666,7 @@ namespace pvd
 			return false;
 		}
 
-		_event_generator = application->GetConfig().GetProviders().GetRtmpProvider().GetEventGenerator();
+		_event_generator = application->GetConfig()->GetProviders().GetRtmpProvider().GetEventGenerator();
 
 		SetName(_publish_url->Stream());
 
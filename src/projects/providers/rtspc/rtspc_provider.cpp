@@ -30,14 +30,18 @@ namespace pvd
 		auto &rtspc_provider_config = server_config.GetBind().GetProviders().GetRtspc();
 
 		bool is_parsed;
-		auto _worker_count = rtspc_provider_config.GetWorkerCount(&is_parsed);
-		_worker_count = is_parsed ? _worker_count : PHYSICAL_PORT_DEFAULT_WORKER_COUNT;
+		auto worker_count = rtspc_provider_config.GetWorkerCount(&is_parsed);
+		_worker_count = is_parsed ? worker_count : PHYSICAL_PORT_DEFAULT_WORKER_COUNT;
+
+		_resolver.Start();
 	}
 
 	RtspcProvider::~RtspcProvider()
 	{
 		Stop();
 
+		_resolver.Stop();
+
 		if (_signalling_socket_pool != nullptr)
 		{
 			_signalling_socket_pool->Uninitialize();
@@ -57,6 +61,41 @@ namespace pvd
 		return _signalling_socket_pool;
 	}
 
+	void RtspcProvider::ResolveAsync(const ov::String &host, uint16_t port, ResolveCallback callback)
+	{
+		auto key = ov::String::FormatString("%s:%u", host.CStr(), port);
+
+		{
+			std::unique_lock<std::mutex> lock(_resolved_address_cache_lock);
+
+			auto item = _resolved_address_cache.find(key);
+			if ((item != _resolved_address_cache.end()) && (std::chrono::steady_clock::now() < item->second.expire_time))
+			{
+				auto address = item->second.address;
+				lock.unlock();
+
+				callback(address);
+				return;
+			}
+		}
+
+		_resolver.Push(
+			[this, host, port, key, callback](void *parameter) -> ov::DelayQueueAction {
+				auto address = ov::SocketAddress::CreateAndGetFirst(host, port);
+
+				if (address.IsValid())
+				{
+					std::lock_guard<std::mutex> lock(_resolved_address_cache_lock);
+					_resolved_address_cache[key] = {address, std::chrono::steady_clock::now() + std::chrono::milliseconds(RTSPC_RESOLVED_ADDRESS_TTL_MS)};
+				}
+
+				callback(address);
+
+				return ov::DelayQueueAction::Stop;
+			},
+			0);
+	}
+
 	bool RtspcProvider::OnCreateHost(const info::Host &host_info)
 	{
 		return true;
@@ -10,6 +10,9 @@
 #include <base/provider/pull_provider/provider.h>
 #include <orchestrator/orchestrator.h>
 
+// Time to reuse the resolved address of an RTSP server, so that reconnections don't wait for DNS
+#define RTSPC_RESOLVED_ADDRESS_TTL_MS (60 * 1000)
+
 /*
  * RtspcProvider
  * 		: Create PhysicalPort, OvtApplication
@@ -53,6 +56,14 @@ namespace pvd
 	    }
 
 		std::shared_ptr<ov::SocketPool> GetSignallingSocketPool();
+
+		// The address is invalid if the host could not be resolved
+		using ResolveCallback = std::function<void(const ov::SocketAddress &address)>;
+
+		// Resolves the host of an RTSP server without blocking the caller (e.g. the stream collector thread).
+		// The callback is called immediately if the address is cached, otherwise it is called from the resolver thread.
+		void ResolveAsync(const ov::String &host, uint16_t port, ResolveCallback callback);
+
 	protected:
 		bool OnCreateHost(const info::Host &host_info) override;
 		bool OnDeleteHost(const info::Host &host_info) override;
@@ -63,5 +74,17 @@ namespace pvd
 		int _worker_count = 1;
 		// Now, rtspc supports only interleaved channel (tcp based)
 		std::shared_ptr<ov::SocketPool> _data_socket_pool;
+
+		struct ResolvedAddress
+		{
+			ov::SocketAddress address;
+			std::chrono::steady_clock::time_point expire_time;
+		};
+
+		// <host>:<port> : ResolvedAddress
+		std::map<ov::String, ResolvedAddress> _resolved_address_cache;
+		std::mutex _resolved_address_cache_lock;
+		// getaddrinfo() blocks, so the hosts are resolved in this thread one by one
+		ov::DelayQueue _resolver{"RtspcResolver"};
 	};
 }  // namespace pvd
\ No newline at end of file
@@ -13,12 +13,27 @@
 #include <base/ovlibrary/byte_io.h>
 #include <modules/rtp_rtcp/rtp_depacketizer_mpeg4_generic_audio.h>
 
+#include <future>
+
 #include "rtspc_provider.h"
 
 #define OV_LOG_TAG "RtspcStream"
 
 namespace pvd
 {
+	// The timing wheel is shared by all RTSP pull streams to detect the timeout of the responses,
+	// and is never released since the timers may be scheduled until the process exits
+	static ov::TimingWheel *GetResponseTimingWheel()
+	{
+		static auto timing_wheel = []() {
+			auto timing_wheel = new ov::TimingWheel("RtspcTimeout");
+			timing_wheel->Start();
+			return timing_wheel;
+		}();
+
+		return timing_wheel;
+	}
+
 	std::shared_ptr<RtspcStream> RtspcStream::Create(const std::shared_ptr<pvd::PullApplication> &application,
 													 const uint32_t stream_id, const ov::String &stream_name,
 													 const std::vector<ov::String> &url_list,
@@ -94,6 +109,17 @@ namespace pvd
 		{
 			_signalling_socket->Close();
 		}
+
+		std::lock_guard<std::mutex> lock(_response_subscriptions_lock);
+		for (const auto &item : _response_subscriptions)
+		{
+			auto timer = item.second->GetTimer();
+			if (timer != nullptr)
+			{
+				GetResponseTimingWheel()->Cancel(timer);
+			}
+		}
+		_response_subscriptions.clear();
 	}
 
 	bool RtspcStream::StartStream(const std::shared_ptr<const ov::Url> &url)
@@ -104,73 +130,268 @@ namespace pvd
 			return true;
 		}
 
+		auto result = std::make_shared<std::promise<bool>>();
+		auto future = result->get_future();
+
+		if (StartHandshake(url, [result](bool succeeded) { result->set_value(succeeded); }) == false)
+		{
+			return false;
+		}
+
+		// Every step of the handshake has a timeout, so it always completes
+		return future.get();
+	}
+
+	bool RtspcStream::RestartStream(const std::shared_ptr<const ov::Url> &url)
+	{
+		logti("[%s/%s(%u)] stream tries to reconnect to %s", GetApplicationTypeName(), GetName().CStr(), GetId(), url->ToUrlString().CStr());
+		return StartStream(url);
+	}
+
+	bool RtspcStream::RestartStreamAsync(const std::shared_ptr<const ov::Url> &url, std::function<void(bool succeeded)> on_completed)
+	{
+		logti("[%s/%s(%u)] stream tries to reconnect to %s", GetApplicationTypeName(), GetName().CStr(), GetId(), url->ToUrlString().CStr());
+		return StartHandshake(url, std::move(on_completed));
+	}
+
+	bool RtspcStream::StopStream()
+	{
+		if (GetState() == State::STOPPED)
+		{
+			return true;
+		}
+
+		{
+			// Abort the handshake in progress
+			std::lock_guard<std::recursive_mutex> lock(_handshake_lock);
+			CompleteHandshake(false);
+		}
+
+		if (!RequestStop())
+		{
+			// Force terminate
+			SetState(State::ERROR);
+		}
+
+		Release();
+
+		ov::Node::Stop();
+
+		return true;
+	}
+
+	bool RtspcStream::StartHandshake(const std::shared_ptr<const ov::Url> &url, HandshakeCallback callback)
+	{
+		std::lock_guard<std::recursive_mutex> lock(_handshake_lock);
+
+		// Only start from IDLE, ERROR, STOPPED
+		if (!(GetState() == State::IDLE || GetState() == State::ERROR || GetState() == State::STOPPED))
+		{
+			return false;
+		}
+
 		_curr_url = url;
 		_sent_sequence_header = false;
 
-		ov::StopWatch stop_watch;
+		_content_base.Clear();
+		_rtsp_session_id.Clear();
+		_authorization_field = nullptr;
+		_depacketizers.clear();
+		_setup_items.clear();
+		_setup_request_count = 0;
+		_setup_response_count = 0;
 
-		stop_watch.Start();
-		if (ConnectTo() == false)
 		{
-			return false;
+			std::lock_guard<std::mutex> receive_lock(_receive_lock);
+			// Discard the remaining data of the previous connection
+			_rtsp_demuxer = RtspDemuxer();
 		}
-		_origin_request_time_msec = stop_watch.Elapsed();
 
-		stop_watch.Update();
+		_handshake_callback = std::move(callback);
+		_handshake_stop_watch.Start();
 
-		if (RequestDescribe() == false)
+		if (ConnectTo() == false)
 		{
+			// The callback is not called if the handshake could not be started
+			_handshake_callback = nullptr;
 			Release();
 			return false;
 		}
 
-		if (RequestSetup() == false)
+		return true;
+	}
+
+	void RtspcStream::CompleteHandshake(bool succeeded)
+	{
+		std::lock_guard<std::recursive_mutex> lock(_handshake_lock);
+
+		auto callback = std::move(_handshake_callback);
+		_handshake_callback = nullptr;
+
+		if (callback == nullptr)
 		{
-			Release();
-			return false;
+			// Already completed
+			return;
 		}
 
-		if (RequestPlay() == false)
+		if (succeeded == false)
 		{
+			SetState(State::ERROR);
 			Release();
-			return false;
 		}
 
-		_origin_response_time_msec = stop_watch.Elapsed();
+		callback(succeeded);
+	}
 
-		// Stream was created completly
-		_stream_metrics = StreamMetrics(*std::static_pointer_cast<info::Stream>(PullStream::GetSharedPtr()));
-		if (_stream_metrics != nullptr)
+	void RtspcStream::SignallingSocketObserver::OnConnected(const std::shared_ptr<const ov::SocketError> &error)
+	{
+		auto stream = _stream.lock();
+		if (stream != nullptr)
 		{
-			_stream_metrics->SetOriginConnectionTimeMSec(_origin_request_time_msec);
-			_stream_metrics->SetOriginSubscribeTimeMSec(_origin_response_time_msec);
+			stream->OnSignallingConnected(_generation, error);
 		}
+	}
 
-		return true;
+	void RtspcStream::SignallingSocketObserver::OnReadable()
+	{
+		auto stream = _stream.lock();
+		if (stream != nullptr)
+		{
+			stream->OnSignallingReadable(_generation);
+		}
 	}
 
-	bool RtspcStream::RestartStream(const std::shared_ptr<const ov::Url> &url)
+	void RtspcStream::SignallingSocketObserver::OnClosed()
 	{
-		logti("[%s/%s(%u)] stream tries to reconnect to %s", GetApplicationTypeName(), GetName().CStr(), GetId(), url->ToUrlString().CStr());
-		return StartStream(url);
+		auto stream = _stream.lock();
+		if (stream != nullptr)
+		{
+			stream->OnSignallingClosed(_generation);
+		}
 	}
 
-	bool RtspcStream::StopStream()
+	void RtspcStream::OnSignallingConnected(uint32_t generation, const std::shared_ptr<const ov::SocketError> &error)
 	{
-		if (GetState() == State::STOPPED)
+		std::lock_guard<std::recursive_mutex> lock(_handshake_lock);
+
+		if ((generation != _signalling_generation) || (_handshake_callback == nullptr))
 		{
-			return true;
+			return;
 		}
 
-		if (!RequestStop())
+		if (error != nullptr)
 		{
-			// Force terminate
 			SetState(State::ERROR);
+			logte("Cannot connect to server (%s) : %s:%d", error->GetMessage().CStr(), _curr_url->Host().CStr(), _curr_url->Port());
+			CompleteHandshake(false);
+			return;
 		}
 
-		Release();
+		_origin_request_time_msec = _handshake_stop_watch.Elapsed();
+		_handshake_stop_watch.Update();
 
-		ov::Node::Stop();
+		SetState(State::CONNECTED);
+
+		if (RequestDescribe() == false)
+		{
+			CompleteHandshake(false);
+		}
+	}
+
+	void RtspcStream::OnSignallingReadable(uint32_t generation)
+	{
+		std::lock_guard<std::recursive_mutex> lock(_handshake_lock);
+
+		if ((generation != _signalling_generation) || (_handshake_callback == nullptr))
+		{
+			// After the handshake, the packets are received by ProcessMediaPacket() from the StreamMotor
+			return;
+		}
+
+		if ((ReceivePacket() == false) || (DispatchHandshakeMessages() == false))
+		{
+			CompleteHandshake(false);
+		}
+	}
+
+	void RtspcStream::OnSignallingClosed(uint32_t generation)
+	{
+		std::lock_guard<std::recursive_mutex> lock(_handshake_lock);
+
+		if (generation != _signalling_generation)
+		{
+			return;
+		}
+
+		if (_handshake_callback != nullptr)
+		{
+			logte("[%s/%s] The connection was closed by the RTSP server(%s) during the handshake", GetApplicationName(), GetName().CStr(), _curr_url->ToUrlString().CStr());
+			CompleteHandshake(false);
+		}
+		else if (GetState() == State::PLAYING)
+		{
+			logtw("[%s/%s] The connection was closed by the RTSP server(%s)", GetApplicationName(), GetName().CStr(), _curr_url->ToUrlString().CStr());
+			SetState(State::ERROR);
+		}
+	}
+
+	void RtspcStream::OnResponseTimedOut(uint32_t cseq)
+	{
+		std::lock_guard<std::recursive_mutex> lock(_handshake_lock);
+
+		auto subscription = PopResponseSubscription(cseq);
+		if (subscription == nullptr)
+		{
+			// Already received
+			return;
+		}
+
+		subscription->OnResponseReceived(nullptr);
+	}
+
+	bool RtspcStream::DispatchHandshakeMessages()
+	{
+		while (_handshake_callback != nullptr)
+		{
+			std::shared_ptr<RtspMessage> rtsp_message;
+
+			{
+				std::lock_guard<std::mutex> lock(_receive_lock);
+				if (_rtsp_demuxer.IsAvailableMessage() == false)
+				{
+					// Interleaved data received with the response of PLAY is processed by ProcessMediaPacket()
+					break;
+				}
+
+				rtsp_message = _rtsp_demuxer.PopMessage();
+			}
+
+			if (rtsp_message->GetMessageType() == RtspMessageType::RESPONSE)
+			{
+				auto subscription = PopResponseSubscription(rtsp_message->GetCSeq());
+				if (subscription == nullptr)
+				{
+					logte("Unexpected CSeq : %u", rtsp_message->GetCSeq());
+					continue;
+				}
+
+				if (subscription->GetTimer() != nullptr)
+				{
+					GetResponseTimingWheel()->Cancel(subscription->GetTimer());
+				}
+
+				subscription->OnResponseReceived(rtsp_message);
+			}
+			else if (rtsp_message->GetMessageType() == RtspMessageType::REQUEST)
+			{
+				logti("%s", rtsp_message->DumpHeader().CStr());
+			}
+			else
+			{
+				logte("%s/%s(%u) - Unknown rtsp message received", GetApplicationInfo().GetName().CStr(), GetName().CStr(), GetId());
+				return false;
+			}
+		}
 
 		return true;
 	}
@@ -200,33 +421,70 @@ namespace pvd
 			return false;
 		}
 
+		_signalling_generation++;
+
+		// The host is resolved by the provider, since getaddrinfo() may block the caller (the stream collector thread)
+		// for seconds. The result is notified by OnSignallingAddressResolved().
+		std::weak_ptr<RtspcStream> weak_stream = std::static_pointer_cast<RtspcStream>(PullStream::GetSharedPtr());
+		auto generation = _signalling_generation;
+
 		// 554 is default port of RTSP
-		auto socket_address = ov::SocketAddress::CreateAndGetFirst(_curr_url->Host(), _curr_url->Port() == 0 ? 554 : _curr_url->Port());
+		GetRtspcProvider()->ResolveAsync(_curr_url->Host(), _curr_url->Port() == 0 ? 554 : _curr_url->Port(), [weak_stream, generation](const ov::SocketAddress &address) {
+			auto stream = weak_stream.lock();
+			if (stream != nullptr)
+			{
+				stream->OnSignallingAddressResolved(generation, address);
+			}
+		});
+
+		return true;
+	}
+
+	void RtspcStream::OnSignallingAddressResolved(uint32_t generation, const ov::SocketAddress &address)
+	{
+		std::lock_guard<std::recursive_mutex> lock(_handshake_lock);
+
+		if ((generation != _signalling_generation) || (_handshake_callback == nullptr))
+		{
+			// The handshake has been aborted while resolving
+			return;
+		}
+
+		if (address.IsValid() == false)
+		{
+			SetState(State::ERROR);
+			logte("Could not resolve the address of the RTSP server : %s", _curr_url->Host().CStr());
+			CompleteHandshake(false);
+			return;
+		}
 
 		// Connect
-		_signalling_socket = signalling_socket_pool->AllocSocket(socket_address.GetFamily());
+		_signalling_socket = GetRtspcProvider()->GetSignallingSocketPool()->AllocSocket(address.GetFamily());
 		if (_signalling_socket == nullptr)
 		{
 			SetState(State::ERROR);
 			logte("To create client socket is failed.");
-
-			_signalling_socket = nullptr;
-			return false;
+			CompleteHandshake(false);
+			return;
 		}
 
-		_signalling_socket->MakeBlocking();
+		auto observer = std::make_shared<SignallingSocketObserver>(std::static_pointer_cast<RtspcStream>(PullStream::GetSharedPtr()), generation);
+		if (_signalling_socket->MakeNonBlocking(observer) == false)
+		{
+			SetState(State::ERROR);
+			logte("Could not make the socket non-blocking");
+			CompleteHandshake(false);
+			return;
+		}
 
-		auto error = _signalling_socket->Connect(socket_address, 3000);
+		// The result is notified by OnSignallingConnected()
+		auto error = _signalling_socket->Connect(address, RTSPC_CONNECTION_TIMEOUT_MS);
 		if (error != nullptr)
 		{
 			SetState(State::ERROR);
 			logte("Cannot connect to server (%s) : %s:%d", error->GetMessage().CStr(), _curr_url->Host().CStr(), _curr_url->Port());
-			return false;
+			CompleteHandshake(false);
 		}
-
-		SetState(State::CONNECTED);
-
-		return true;
 	}
 
 	bool RtspcStream::RequestDescribe()
@@ -240,79 +498,92 @@ namespace pvd
 		describe->AddHeaderField(std::make_shared<RtspHeaderField>(RtspHeaderFieldType::Accept, "application/sdp"));
 		describe->AddHeaderField(std::make_shared<RtspHeaderField>(RtspHeaderFieldType::UserAgent, RTSP_USER_AGENT_NAME));
 
-		std::shared_ptr<RtspMessage> reply = nullptr;
-		for (int i = 0; i < 2; i++)
+		auto sent = SendRequestMessage(describe, [this, describe](const std::shared_ptr<RtspMessage> &reply) {
+			if (OnDescribeResponse(describe, reply) == false)
+			{
+				CompleteHandshake(false);
+			}
+		});
+
+		if (sent == false)
+		{
+			SetState(State::ERROR);
+			logte("Could not request DESCIBE to RTSP server (%s)", _curr_url->ToUrlString().CStr());
+			return false;
+		}
+
+		return true;
+	}
+
+	bool RtspcStream::OnDescribeResponse(const std::shared_ptr<RtspMessage> &describe, const std::shared_ptr<RtspMessage> &reply)
+	{
+		if (reply == nullptr)
 		{
-			if (SendRequestMessage(describe) == false)
+			SetState(State::ERROR);
+			logte("No response(CSeq : %u) was received from the rtsp server(%s)", describe->GetCSeq(), _curr_url->ToUrlString().CStr());
+			return false;
+		}
+		// Unauthorized, try to authenticate
+		else if (reply->GetStatusCode() == 401)
+		{
+			// Authorization has been failed
+			if (_authorization_field != nullptr)
 			{
 				SetState(State::ERROR);
-				logte("Could not request DESCIBE to RTSP server (%s)", _curr_url->ToUrlString().CStr());
+				logte("Rtsp server(%s) rejected the describe request : %d(%s) | ID/Password may be incorrect.", _curr_url->ToUrlString().CStr(), reply->GetStatusCode(), reply->GetReasonPhrase().CStr());
 				return false;
 			}
 
-			reply = ReceiveResponse(describe->GetCSeq(), 3000);
-			if (reply == nullptr)
+			auto authenticate_field = reply->GetHeaderFieldAs<RtspHeaderWWWAuthenticateField>(RtspHeaderField::FieldTypeToString(RtspHeaderFieldType::WWWAuthenticate));
+			if (authenticate_field == nullptr)
 			{
 				SetState(State::ERROR);
-				logte("No response(CSeq : %u) was received from the rtsp server(%s)", describe->GetCSeq(), _curr_url->ToUrlString().CStr());
+				logte("Rtsp server(%s) rejected the describe request : %d(%s)", _curr_url->ToUrlString().CStr(), reply->GetStatusCode(), reply->GetReasonPhrase().CStr());
 				return false;
 			}
-			// Unauthorized, try to authenticate
-			else if (reply->GetStatusCode() == 401)
+
+			// Add authorization field
+			if (authenticate_field->GetScheme() == RtspHeaderWWWAuthenticateField::Scheme::Basic)
+			{
+				_authorization_field = RtspHeaderAuthorizationField::CreateRtspBasicAuthorizationField(_curr_url->Id(), _curr_url->Password());
+			}
+			else if (authenticate_field->GetScheme() == RtspHeaderWWWAuthenticateField::Scheme::Digest)
 			{
-				// Authorization has been failed
-				if (i == 1)
-				{
-					SetState(State::ERROR);
-					logte("Rtsp server(%s) rejected the describe request : %d(%s) | ID/Password may be incorrect.", _curr_url->ToUrlString().CStr(), reply->GetStatusCode(), reply->GetReasonPhrase().CStr());
-					return false;
-				}
+				_authorization_field = RtspHeaderAuthorizationField::CreateRtspDigestAuthorizationField(_curr_url->Id(), _curr_url->Password(),
+																										describe->GetMethodStr(), describe->GetRequestUri(),
+																										authenticate_field->GetRealm(), authenticate_field->GetNonce());
+			}
+			else
+			{
+				SetState(State::ERROR);
+				logte("Rtsp server(%s) rejected the describe request : %d(%s)", _curr_url->ToUrlString().CStr(), reply->GetStatusCode(), reply->GetReasonPhrase().CStr());
+				return false;
+			}
 
-				auto authenticate_field = reply->GetHeaderFieldAs<RtspHeaderWWWAuthenticateField>(RtspHeaderField::FieldTypeToString(RtspHeaderFieldType::WWWAuthenticate));
-				if (authenticate_field == nullptr)
-				{
-					SetState(State::ERROR);
-					logte("Rtsp server(%s) rejected the describe request : %d(%s)", _curr_url->ToUrlString().CStr(), reply->GetStatusCode(), reply->GetReasonPhrase().CStr());
-					return false;
-				}
+			describe->AddHeaderField(_authorization_field);
 
-				// Add authorization field
-				if (authenticate_field->GetScheme() == RtspHeaderWWWAuthenticateField::Scheme::Basic)
+			// Try to send again
+			auto sent = SendRequestMessage(describe, [this, describe](const std::shared_ptr<RtspMessage> &reply) {
+				if (OnDescribeResponse(describe, reply) == false)
 				{
-					_authorization_field = RtspHeaderAuthorizationField::CreateRtspBasicAuthorizationField(_curr_url->Id(), _curr_url->Password());
-					describe->AddHeaderField(_authorization_field);
-
-					// Try to send again
-					continue;
+					CompleteHandshake(false);
 				}
-				else if (authenticate_field->GetScheme() == RtspHeaderWWWAuthenticateField::Scheme::Digest)
-				{
-					_authorization_field = RtspHeaderAuthorizationField::CreateRtspDigestAuthorizationField(_curr_url->Id(), _curr_url->Password(),
-																											describe->GetMethodStr(), describe->GetRequestUri(),
-																											authenticate_field->GetRealm(), authenticate_field->GetNonce());
-					describe->AddHeaderField(_authorization_field);
+			});
 
-					// Try to send again
-					continue;
-				}
-				else
-				{
-					SetState(State::ERROR);
-					logte("Rtsp server(%s) rejected the describe request : %d(%s)", _curr_url->ToUrlString().CStr(), reply->GetStatusCode(), reply->GetReasonPhrase().CStr());
-					return false;
-				}
-			}
-			else if (reply->GetStatusCode() != 200)
+			if (sent == false)
 			{
 				SetState(State::ERROR);
-				logte("Rtsp server(%s) rejected the describe request : %d(%s)", _curr_url->ToUrlString().CStr(), reply->GetStatusCode(), reply->GetReasonPhrase().CStr());
+				logte("Could not request DESCIBE to RTSP server (%s)", _curr_url->ToUrlString().CStr());
 				return false;
 			}
-			else
-			{
-				// Success
-				break;
-			}
+
+			return true;
+		}
+		else if (reply->GetStatusCode() != 200)
+		{
+			SetState(State::ERROR);
+			logte("Rtsp server(%s) rejected the describe request : %d(%s)", _curr_url->ToUrlString().CStr(), reply->GetStatusCode(), reply->GetReasonPhrase().CStr());
+			return false;
 		}
 
 		logtd("Response Describe : %s", reply->DumpHeader().CStr());
@@ -328,7 +599,7 @@ namespace pvd
 		auto session_field = reply->GetHeaderFieldAs<RtspHeaderSessionField>(RtspHeaderField::FieldTypeToString(RtspHeaderFieldType::Session));
 		if (session_field == nullptr)
 		{
-			_rtsp_session_id = 0;
+			_rtsp_session_id.Clear();
 		}
 		else
 		{
@@ -345,135 +616,47 @@ namespace pvd
 			return false;
 		}
 
-		// Parse SDP to add track information
-		if (_sdp.FromString(reply->GetBody()->ToString()) == false)
-		{
-			SetState(State::ERROR);
-			logte("Parsing of SDP received from rtsp url (%s)failed. ", _curr_url->ToUrlString().CStr());
-			return false;
-		}
-
-		logti("SDP : %s\n", reply->GetBody()->ToString().CStr());
-
-		ov::Node::Start();
-
-		SetState(State::DESCRIBED);
-
-		return true;
-	}
-
-	bool RtspcStream::RequestSetup()
-	{
-		if (GetState() != State::DESCRIBED)
-		{
-			return false;
-		}
-
-		int interleaved_channel = 0;
-
-		_rtp_rtcp = std::make_shared<RtpRtcp>(RtpRtcpInterface::GetSharedPtr());
-
-		auto media_desc_list = _sdp.GetMediaList();
-		for (const auto &media_desc : media_desc_list)
-		{
-			if (media_desc->GetMediaType() == MediaDescription::MediaType::Application || media_desc->GetMediaType() == MediaDescription::MediaType::Unknown)
-			{
-				logtw("Ignored not supported media type : %s", media_desc->GetMediaTypeStr().CStr());
-				continue;
-			}
-
-			auto control = media_desc->GetControl();
-			if (control.IsEmpty())
-			{
-				SetState(State::ERROR);
-				logte("Could not get control attribute in (%s) ", _curr_url->ToUrlString().CStr());
-				return false;
-			}
-
-			auto control_url = GenerateControlUrl(control);
-			if (control_url.IsEmpty())
-			{
-				SetState(State::ERROR);
-				logte("Could not make control url with (%s) ", control.CStr());
-				return false;
-			}
-
-			auto setup = std::make_shared<RtspMessage>(RtspMethod::SETUP, GetNextCSeq(), control_url);
-			if (_authorization_field != nullptr)
-			{
-				// If authorization method is Digest, update the method and uri
-				if (_authorization_field->GetScheme() == RtspHeaderWWWAuthenticateField::Scheme::Digest)
-				{
-					_authorization_field->UpdateDigestAuth(setup->GetMethodStr(), setup->GetRequestUri());
-				}
-
-				setup->AddHeaderField(_authorization_field);
-			}
+		// Parse SDP to add track information
+		if (_sdp.FromString(reply->GetBody()->ToString()) == false)
+		{
+			SetState(State::ERROR);
+			logte("Parsing of SDP received from rtsp url (%s)failed. ", _curr_url->ToUrlString().CStr());
+			return false;
+		}
 
-			// Now RtspcStream only supports RTP/AVP/TCP;unicast/interleaved(rtp+rtcp)
-			// The chennel id can be used for demuxing, but since it is already demuxing in a different way, it is not saved.
-			setup->AddHeaderField(std::make_shared<RtspHeaderField>(RtspHeaderFieldType::Transport,
-																	ov::String::FormatString("RTP/AVP/TCP;unicast;interleaved=%d-%d;ssrc=%X", interleaved_channel, interleaved_channel + 1, ov::Random::GenerateUInt32())));
+		logti("SDP : %s\n", reply->GetBody()->ToString().CStr());
 
-			setup->AddHeaderField(std::make_shared<RtspHeaderField>(RtspHeaderFieldType::Session, _rtsp_session_id));
-			setup->AddHeaderField(std::make_shared<RtspHeaderField>(RtspHeaderFieldType::UserAgent, RTSP_USER_AGENT_NAME));
+		ov::Node::Start();
 
-			if (SendRequestMessage(setup) == false)
-			{
-				SetState(State::ERROR);
-				logte("Could not request setup to RTSP server (%s)", _curr_url->ToUrlString().CStr());
-				return false;
-			}
+		SetState(State::DESCRIBED);
 
-			logtd("Request SETUP : %s", setup->DumpHeader().CStr());
+		return RequestSetup();
+	}
 
-			auto reply = ReceiveResponse(setup->GetCSeq(), 3000);
-			if (reply == nullptr)
-			{
-				SetState(State::ERROR);
-				logte("No response(CSeq : %u) was received from the rtsp server(%s)", setup->GetCSeq(), _curr_url->ToUrlString().CStr());
-				return false;
-			}
-			else if (reply->GetStatusCode() != 200)
-			{
-				SetState(State::ERROR);
-				logte("Rtsp server(%s) rejected the setup request : %d(%s)", _curr_url->ToUrlString().CStr(), reply->GetStatusCode(), reply->GetReasonPhrase().CStr());
-				return false;
-			}
+	bool RtspcStream::RequestSetup()
+	{
+		if (GetState() != State::DESCRIBED)
+		{
+			return false;
+		}
 
-			logtd("Response SETUP : %s", reply->DumpHeader().CStr());
+		uint8_t interleaved_channel = 0;
 
-			// Session
-			auto session_field = reply->GetHeaderFieldAs<RtspHeaderSessionField>(RtspHeaderField::FieldTypeToString(RtspHeaderFieldType::Session));
-			if (session_field == nullptr)
-			{
-				_rtsp_session_id = 0;
-			}
-			else
-			{
-				// Session  = "Session" ":" session-id [ ";" "timeout" "=" delta-seconds ]
-				_rtsp_session_id = session_field->GetSessionId();
-				// timeout
-				[[maybe_unused]] auto timeout_delta_seconds = session_field->GetTimeoutDeltaSeconds();
-			}
+		_rtp_rtcp = std::make_shared<RtpRtcp>(RtpRtcpInterface::GetSharedPtr());
 
-			// Transport
-			auto transport_field = reply->GetHeaderFieldAs<RtspHeaderTransportField>(RtspHeaderField::FieldTypeToString(RtspHeaderFieldType::Transport));
-			if (transport_field == nullptr)
-			{
-				SetState(State::ERROR);
-				logte("There is no Transport header in the response from the RTSP server(%s)", _curr_url->ToUrlString().CStr());
-				return false;
-			}
-			else
+		auto media_desc_list = _sdp.GetMediaList();
+		for (const auto &media_desc : media_desc_list)
+		{
+			if (media_desc->GetMediaType() == MediaDescription::MediaType::Application || media_desc->GetMediaType() == MediaDescription::MediaType::Unknown)
 			{
-				// Some rtsp server ignores this value, so it is unusable
-				// transport_field->GetSsrc();
+				logtw("Ignored not supported media type : %s", media_desc->GetMediaTypeStr().CStr());
+				continue;
 			}
 
 			auto first_payload = media_desc->GetFirstPayload();
 			if (first_payload == nullptr)
 			{
+				SetState(State::ERROR);
 				logte("Failed to get the first Payload type of peer sdp");
 				return false;
 			}
@@ -520,61 +703,164 @@ namespace pvd
 					break;
 
 				default:
+					// The media is not set up, so the server does not send it
 					logte("%s - Unsupported codec  : %s", GetName().CStr(), first_payload->GetCodecParams().CStr());
 					continue;
 			}
 
-			// Add Depacketizer
-			if (AddDepacketizer(interleaved_channel, depacketizer_type) == false)
+			_setup_items.push_back(SetupItem{media_desc, first_payload, depacketizer_type, track, interleaved_channel});
+
+			interleaved_channel += 2;
+		}
+
+		if (_setup_items.empty())
+		{
+			SetState(State::ERROR);
+			logte("There is no media to set up in (%s)", _curr_url->ToUrlString().CStr());
+			return false;
+		}
+
+		// SETUPs are pipelined (sent without waiting for the responses) to save the round trips.
+		// However, if the session id is not given by DESCRIBE, the server assigns it in the response of the first SETUP,
+		// so the others are sent after it is received.
+		size_t count = _rtsp_session_id.IsEmpty() ? 1 : _setup_items.size();
+		for (size_t index = 0; index < count; index++)
+		{
+			if (SendSetup(index) == false)
 			{
-				logte("%s - Could not add depacketizer for channel %u codec  : %s", GetName().CStr(), interleaved_channel, first_payload->GetCodecParams().CStr());
 				return false;
 			}
+		}
+
+		return true;
+	}
+
+	bool RtspcStream::SendSetup(size_t index)
+	{
+		auto &item = _setup_items[index];
+
+		auto control = item.media_desc->GetControl();
+		if (control.IsEmpty())
+		{
+			SetState(State::ERROR);
+			logte("Could not get control attribute in (%s) ", _curr_url->ToUrlString().CStr());
+			return false;
+		}
+
+		auto control_url = GenerateControlUrl(control);
+		if (control_url.IsEmpty())
+		{
+			SetState(State::ERROR);
+			logte("Could not make control url with (%s) ", control.CStr());
+			return false;
+		}
 
-			// Set Parameters
-			if (depacketizer_type == RtpDepacketizingManager::SupportedDepacketizerType::MPEG4_GENERIC_AUDIO)
+		auto setup = std::make_shared<RtspMessage>(RtspMethod::SETUP, GetNextCSeq(), control_url);
+		if (_authorization_field != nullptr)
+		{
+			// If authorization method is Digest, update the method and uri
+			if (_authorization_field->GetScheme() == RtspHeaderWWWAuthenticateField::Scheme::Digest)
 			{
-				RtpDepacketizerMpeg4GenericAudio::Mode mpeg4_mode;
-				if (first_payload->GetMpeg4GenericMode() == PayloadAttr::Mpeg4GenericMode::AAC_lbr)
-				{
-					mpeg4_mode = RtpDepacketizerMpeg4GenericAudio::Mode::AAC_lbr;
-				}
-				else if (first_payload->GetMpeg4GenericMode() == PayloadAttr::Mpeg4GenericMode::AAC_hbr)
-				{
-					mpeg4_mode = RtpDepacketizerMpeg4GenericAudio::Mode::AAC_hbr;
-				}
-				else
-				{
-					logte("%s - It is not supported MPEG4-GENERIC audio mode : %s", GetName().CStr(), first_payload->GetFmtp().CStr());
-					return false;
-				}
+				_authorization_field->UpdateDigestAuth(setup->GetMethodStr(), setup->GetRequestUri());
+			}
 
-				auto mpeg4_size_length = first_payload->GetMpeg4GenericSizeLength();
-				auto mpeg4_index_length = first_payload->GetMpeg4GenericIndexLength();
-				auto mpeg4_index_delta_length = first_payload->GetMpeg4GenericIndexDeltaLength();
-				auto mpeg4_config = first_payload->GetMpeg4GenericConfig();
+			setup->AddHeaderField(_authorization_field);
+		}
 
-				if (mpeg4_config == nullptr)
-				{
-					logte("%s - Could not parse MPEG4-GENERIC audio config : %s", GetName().CStr(), first_payload->GetFmtp().CStr());
-					return false;
-				}
+		// Now RtspcStream only supports RTP/AVP/TCP;unicast/interleaved(rtp+rtcp)
+		// The chennel id can be used for demuxing, but since it is already demuxing in a different way, it is not saved.
+		setup->AddHeaderField(std::make_shared<RtspHeaderField>(RtspHeaderFieldType::Transport,
+																ov::String::FormatString("RTP/AVP/TCP;unicast;interleaved=%d-%d;ssrc=%X", item.interleaved_channel, item.interleaved_channel + 1, ov::Random::GenerateUInt32())));
 
-				auto depacketizer = std::dynamic_pointer_cast<RtpDepacketizerMpeg4GenericAudio>(GetDepacketizer(interleaved_channel));
-				if (depacketizer->SetConfigParams(mpeg4_mode, mpeg4_size_length, mpeg4_index_length, mpeg4_index_delta_length, mpeg4_config) == false)
-				{
-					logte("%s - Could not parse MPEG4-GENERIC audio config : %s", GetName().CStr(), first_payload->GetFmtp().CStr());
-					return false;
-				}
+		setup->AddHeaderField(std::make_shared<RtspHeaderField>(RtspHeaderFieldType::Session, _rtsp_session_id));
+		setup->AddHeaderField(std::make_shared<RtspHeaderField>(RtspHeaderFieldType::UserAgent, RTSP_USER_AGENT_NAME));
+
+		auto sent = SendRequestMessage(setup, [this, index, setup](const std::shared_ptr<RtspMessage> &reply) {
+			if (OnSetupResponse(index, setup, reply) == false)
+			{
+				CompleteHandshake(false);
 			}
+		});
+
+		if (sent == false)
+		{
+			SetState(State::ERROR);
+			logte("Could not request setup to RTSP server (%s)", _curr_url->ToUrlString().CStr());
+			return false;
+		}
 
-			AddTrack(track);
+		_setup_request_count++;
 
-			// Some RTSP servers ignore the ssrc of SETUP, so they use an interleaved channel instead.
-			_rtp_rtcp->AddRtpReceiver(interleaved_channel, track);
-			_lip_sync_clock.RegisterClock(interleaved_channel, track->GetTimeBase().GetExpr());
+		logtd("Request SETUP : %s", setup->DumpHeader().CStr());
 
-			interleaved_channel += 2;
+		return true;
+	}
+
+	bool RtspcStream::OnSetupResponse(size_t index, const std::shared_ptr<RtspMessage> &setup, const std::shared_ptr<RtspMessage> &reply)
+	{
+		if (reply == nullptr)
+		{
+			SetState(State::ERROR);
+			logte("No response(CSeq : %u) was received from the rtsp server(%s)", setup->GetCSeq(), _curr_url->ToUrlString().CStr());
+			return false;
+		}
+		else if (reply->GetStatusCode() != 200)
+		{
+			SetState(State::ERROR);
+			logte("Rtsp server(%s) rejected the setup request : %d(%s)", _curr_url->ToUrlString().CStr(), reply->GetStatusCode(), reply->GetReasonPhrase().CStr());
+			return false;
+		}
+
+		logtd("Response SETUP : %s", reply->DumpHeader().CStr());
+
+		// Session
+		auto session_field = reply->GetHeaderFieldAs<RtspHeaderSessionField>(RtspHeaderField::FieldTypeToString(RtspHeaderFieldType::Session));
+		if (session_field == nullptr)
+		{
+			_rtsp_session_id.Clear();
+		}
+		else
+		{
+			// Session  = "Session" ":" session-id [ ";" "timeout" "=" delta-seconds ]
+			_rtsp_session_id = session_field->GetSessionId();
+			// timeout
+			[[maybe_unused]] auto timeout_delta_seconds = session_field->GetTimeoutDeltaSeconds();
+		}
+
+		// Transport
+		auto transport_field = reply->GetHeaderFieldAs<RtspHeaderTransportField>(RtspHeaderField::FieldTypeToString(RtspHeaderFieldType::Transport));
+		if (transport_field == nullptr)
+		{
+			SetState(State::ERROR);
+			logte("There is no Transport header in the response from the RTSP server(%s)", _curr_url->ToUrlString().CStr());
+			return false;
+		}
+		else
+		{
+			// Some rtsp server ignores this value, so it is unusable
+			// transport_field->GetSsrc();
+		}
+
+		if (SetupTrack(_setup_items[index]) == false)
+		{
+			return false;
+		}
+
+		_setup_response_count++;
+
+		// The session id is known now, so the remaining SETUPs are pipelined
+		while (_setup_request_count < _setup_items.size())
+		{
+			if (SendSetup(_setup_request_count) == false)
+			{
+				return false;
+			}
+		}
+
+		if (_setup_response_count < _setup_items.size())
+		{
+			// Wait for the other responses
+			return true;
 		}
 
 		_rtp_rtcp->RegisterPrevNode(nullptr);
@@ -584,6 +870,65 @@ namespace pvd
 		RegisterPrevNode(_rtp_rtcp);
 		RegisterNextNode(nullptr);
 
+		return RequestPlay();
+	}
+
+	bool RtspcStream::SetupTrack(const SetupItem &item)
+	{
+		auto &track = item.track;
+		auto &first_payload = item.payload;
+		auto interleaved_channel = item.interleaved_channel;
+
+		// Add Depacketizer
+		if (AddDepacketizer(interleaved_channel, item.depacketizer_type) == false)
+		{
+			logte("%s - Could not add depacketizer for channel %u codec  : %s", GetName().CStr(), interleaved_channel, first_payload->GetCodecParams().CStr());
+			return false;
+		}
+
+		// Set Parameters
+		if (item.depacketizer_type == RtpDepacketizingManager::SupportedDepacketizerType::MPEG4_GENERIC_AUDIO)
+		{
+			RtpDepacketizerMpeg4GenericAudio::Mode mpeg4_mode;
+			if (first_payload->GetMpeg4GenericMode() == PayloadAttr::Mpeg4GenericMode::AAC_lbr)
+			{
+				mpeg4_mode = RtpDepacketizerMpeg4GenericAudio::Mode::AAC_lbr;
+			}
+			else if (first_payload->GetMpeg4GenericMode() == PayloadAttr::Mpeg4GenericMode::AAC_hbr)
+			{
+				mpeg4_mode = RtpDepacketizerMpeg4GenericAudio::Mode::AAC_hbr;
+			}
+			else
+			{
+				logte("%s - It is not supported MPEG4-GENERIC audio mode : %s", GetName().CStr(), first_payload->GetFmtp().CStr());
+				return false;
+			}
+
+			auto mpeg4_size_length = first_payload->GetMpeg4GenericSizeLength();
+			auto mpeg4_index_length = first_payload->GetMpeg4GenericIndexLength();
+			auto mpeg4_index_delta_length = first_payload->GetMpeg4GenericIndexDeltaLength();
+			auto mpeg4_config = first_payload->GetMpeg4GenericConfig();
+
+			if (mpeg4_config == nullptr)
+			{
+				logte("%s - Could not parse MPEG4-GENERIC audio config : %s", GetName().CStr(), first_payload->GetFmtp().CStr());
+				return false;
+			}
+
+			auto depacketizer = std::dynamic_pointer_cast<RtpDepacketizerMpeg4GenericAudio>(GetDepacketizer(interleaved_channel));
+			if (depacketizer->SetConfigParams(mpeg4_mode, mpeg4_size_length, mpeg4_index_length, mpeg4_index_delta_length, mpeg4_config) == false)
+			{
+				logte("%s - Could not parse MPEG4-GENERIC audio config : %s", GetName().CStr(), first_payload->GetFmtp().CStr());
+				return false;
+			}
+		}
+
+		AddTrack(track);
+
+		// Some RTSP servers ignore the ssrc of SETUP, so they use an interleaved channel instead.
+		_rtp_rtcp->AddRtpReceiver(interleaved_channel, track);
+		_lip_sync_clock.RegisterClock(interleaved_channel, track->GetTimeBase().GetExpr());
+
 		return true;
 	}
 
@@ -608,7 +953,14 @@ namespace pvd
 		play->AddHeaderField(std::make_shared<RtspHeaderField>(RtspHeaderFieldType::Session, _rtsp_session_id));
 		play->AddHeaderField(std::make_shared<RtspHeaderField>(RtspHeaderFieldType::UserAgent, RTSP_USER_AGENT_NAME));
 
-		if (SendRequestMessage(play) == false)
+		auto sent = SendRequestMessage(play, [this, play](const std::shared_ptr<RtspMessage> &reply) {
+			if (OnPlayResponse(play, reply) == false)
+			{
+				CompleteHandshake(false);
+			}
+		});
+
+		if (sent == false)
 		{
 			SetState(State::ERROR);
 			logte("Could not request DESCIBE to RTSP server (%s)", _curr_url->ToUrlString().CStr());
@@ -617,8 +969,11 @@ namespace pvd
 
 		logtd("Request PLAY : %s", play->DumpHeader().CStr());
 
-		auto reply = ReceiveResponse(play->GetCSeq(), 3000);
+		return true;
+	}
 
+	bool RtspcStream::OnPlayResponse(const std::shared_ptr<RtspMessage> &play, const std::shared_ptr<RtspMessage> &reply)
+	{
 		if (reply == nullptr)
 		{
 			SetState(State::ERROR);
@@ -635,8 +990,20 @@ namespace pvd
 		logtd("Response PLAY : %s", reply->DumpHeader().CStr());
 		_play_request_time.Start();
 
+		_origin_response_time_msec = _handshake_stop_watch.Elapsed();
+
+		// Stream was created completly
+		_stream_metrics = StreamMetrics(*std::static_pointer_cast<info::Stream>(PullStream::GetSharedPtr()));
+		if (_stream_metrics != nullptr)
+		{
+			_stream_metrics->SetOriginConnectionTimeMSec(_origin_request_time_msec);
+			_stream_metrics->SetOriginSubscribeTimeMSec(_origin_response_time_msec);
+		}
+
 		SetState(State::PLAYING);
 
+		CompleteHandshake(true);
+
 		return true;
 	}
 
@@ -668,7 +1035,7 @@ namespace pvd
 			return false;
 		}
 
-		auto reply = ReceiveResponse(teardown->GetCSeq(), 3000);
+		auto reply = ReceiveResponse(teardown->GetCSeq(), RTSPC_RESPONSE_TIMEOUT_MS);
 		if (reply == nullptr)
 		{
 			SetState(State::ERROR);
@@ -690,11 +1057,13 @@ namespace pvd
 		return _cseq++;
 	}
 
-	bool RtspcStream::SubscribeResponse(const std::shared_ptr<RtspMessage> &request_message)
+	std::shared_ptr<RtspcStream::ResponseSubscription> RtspcStream::SubscribeResponse(const std::shared_ptr<RtspMessage> &request_message, ResponseHandler handler)
 	{
+		auto subscription = std::make_shared<ResponseSubscription>(request_message, std::move(handler));
+
 		std::lock_guard<std::mutex> lock(_response_subscriptions_lock);
-		_response_subscriptions.emplace(request_message->GetCSeq(), std::make_shared<ResponseSubscription>(request_message));
-		return true;
+		_response_subscriptions[request_message->GetCSeq()] = subscription;
+		return subscription;
 	}
 
 	std::shared_ptr<RtspcStream::ResponseSubscription> RtspcStream::PopResponseSubscription(uint32_t cseq)
@@ -715,10 +1084,29 @@ namespace pvd
 		return request_response;
 	}
 
-	bool RtspcStream::SendRequestMessage(const std::shared_ptr<RtspMessage> &message)
+	bool RtspcStream::SendRequestMessage(const std::shared_ptr<RtspMessage> &message, ResponseHandler handler)
 	{
 		// Add to RequestedMap to receive reply
-		SubscribeResponse(message);
+		auto subscription = SubscribeResponse(message, handler);
+
+		if (handler != nullptr)
+		{
+			// The handler is called with nullptr if the response is not received in time
+			std::weak_ptr<RtspcStream> stream_weak = std::static_pointer_cast<RtspcStream>(PullStream::GetSharedPtr());
+			auto cseq = message->GetCSeq();
+
+			subscription->SetTimer(GetResponseTimingWheel()->Schedule(
+				[stream_weak, cseq]() -> ov::DelayQueueAction {
+					auto stream = stream_weak.lock();
+					if (stream != nullptr)
+					{
+						stream->OnResponseTimedOut(cseq);
+					}
+
+					return ov::DelayQueueAction::Stop;
+				},
+				RTSPC_RESPONSE_TIMEOUT_MS));
+		}
 
 		// Send
 		return _signalling_socket->Send(message->GetMessage());
@@ -733,99 +1121,40 @@ namespace pvd
 		}
 
 		// When the stream is playing, another thread receives a message and notifies it.
-		if (GetState() == State::PLAYING)
-		{
-			return request_response->WaitForResponse(timeout_ms);
-		}
-		// Otherwise, the response must be received directly from the socket.
-		else
-		{
-			auto reply = ReceiveMessage(timeout_ms);
-			// If the stream is not in the playing state, the client cannot receive unexpected CSeq.
-			if (reply == nullptr)
-			{
-				// timed out
-				return nullptr;
-			}
-			else if (reply->GetCSeq() != cseq)
-			{
-				logte("Unexpected CSeq : %u (expected : %u)", reply->GetCSeq(), cseq);
-				return nullptr;
-			}
-
-			return reply;
-		}
-
-		return nullptr;
-	}
-
-	std::shared_ptr<RtspMessage> RtspcStream::ReceiveMessage(int64_t timeout_msec)
-	{
-		ov::StopWatch stop_watch;
-
-		stop_watch.Start();
-		while (true)
-		{
-			if (ReceivePacket(false, timeout_msec) == false)
-			{
-				return nullptr;
-			}
-
-			if (_rtsp_demuxer.IsAvailableMessage())
-			{
-				return _rtsp_demuxer.PopMessage();
-			}
-
-			if (stop_watch.IsElapsed(timeout_msec))
-			{
-				return nullptr;
-			}
-		}
-
-		return nullptr;
+		return request_response->WaitForResponse(timeout_ms);
 	}
 
-	bool RtspcStream::ReceivePacket(bool non_block, int64_t timeout_msec)
+	bool RtspcStream::ReceivePacket()
 	{
 		uint8_t buffer[65535];
-		size_t read_bytes = 0ULL;
 
-		if (non_block == false && timeout_msec != 0)
+		// The socket pool notifies the readable event once (edge triggered), so read until there is no more data
+		while (true)
 		{
-			struct timeval tv = {timeout_msec / 1000, (timeout_msec % 1000) * 1000};
-			_signalling_socket->SetRecvTimeout(tv);
-		}
+			size_t read_bytes = 0ULL;
 
-		auto error = _signalling_socket->Recv(buffer, 65535, &read_bytes, non_block);
-		if (read_bytes == 0)
-		{
+			auto error = _signalling_socket->Recv(buffer, sizeof(buffer), &read_bytes);
 			if (error != nullptr)
 			{
 				logte("[%s/%s] An error occurred while receiving packet: %s", GetApplicationName(), GetName().CStr(), error->What());
 				SetState(State::ERROR);
 				return false;
 			}
-			else
+
+			if (read_bytes == 0)
 			{
-				if (non_block == true)
-				{
-					// retry later
-					return true;
-				}
-				else
-				{
-					// timeout
-					return false;
-				}
+				// retry later
+				return true;
 			}
-		}
 
-		// Since the response to the Play request and part of the interleaved data can be received at once,
-		// use _rtsp_demuxer to prevent the packet from being missed, regardless of the current state.
-		if (_rtsp_demuxer.AppendPacket(buffer, read_bytes) == false)
-		{
-			logte("[%s/%s] An error occurred while parsing packet: Invalid packet", GetApplicationName(), GetName().CStr());
-			return false;
+			// Since the response to the Play request and part of the interleaved data can be received at once,
+			// use _rtsp_demuxer to prevent the packet from being missed, regardless of the current state.
+			std::lock_guard<std::mutex> lock(_receive_lock);
+			if (_rtsp_demuxer.AppendPacket(buffer, read_bytes) == false)
+			{
+				logte("[%s/%s] An error occurred while parsing packet: Invalid packet", GetApplicationName(), GetName().CStr());
+				return false;
+			}
 		}
 
 		return true;
@@ -839,7 +1168,7 @@ namespace pvd
 	PullStream::ProcessMediaResult RtspcStream::ProcessMediaPacket()
 	{
 		// Receive Packet
-		auto result = ReceivePacket(true);
+		auto result = ReceivePacket();
 		if (result == false)
 		{
 			logte("%s/%s(%u) - Could not receive packet : err(%d)", GetApplicationInfo().GetName().CStr(), GetName().CStr(), GetId(), static_cast<uint8_t>(result));
@@ -849,9 +1178,24 @@ namespace pvd
 
 		while (true)
 		{
-			if (_rtsp_demuxer.IsAvailableMessage())
+			std::shared_ptr<RtspMessage> rtsp_message;
+			std::shared_ptr<RtspData> rtsp_data;
+
+			{
+				std::lock_guard<std::mutex> lock(_receive_lock);
+
+				if (_rtsp_demuxer.IsAvailableMessage())
+				{
+					rtsp_message = _rtsp_demuxer.PopMessage();
+				}
+				else if (_rtsp_demuxer.IsAvaliableData())
+				{
+					rtsp_data = _rtsp_demuxer.PopData();
+				}
+			}
+
+			if (rtsp_message != nullptr)
 			{
-				auto rtsp_message = _rtsp_demuxer.PopMessage();
 				if (rtsp_message->GetMessageType() == RtspMessageType::RESPONSE)
 				{
 					// Find Request
@@ -878,14 +1222,11 @@ namespace pvd
 					return ProcessMediaResult::PROCESS_MEDIA_FAILURE;
 				}
 			}
-			else if (_rtsp_demuxer.IsAvaliableData())
+			else if (rtsp_data != nullptr)
 			{
 				// In an interleaved session, the server sends both messages and data in the same session.
 				// Check if there are available messages and interleaved data
 
-				// RTP or RTCP
-				auto rtsp_data = _rtsp_demuxer.PopData();
-
 				// RtpRtcpInterface(RtspcStream) <--> [RTP_RTCP Node] <--> [*Edge Node(RtspcStream)] ---Send--> {Socket}
 				//							        					     					    <--Recv--- {Socket}
 				SendDataToPrevNode(rtsp_data);
@@ -11,6 +11,7 @@
 
 #include <base/common_types.h>
 #include <base/ovlibrary/url.h>
+#include <base/ovsocket/ovsocket.h>
 
 #include <base/provider/pull_provider/stream.h>
 #include <base/provider/pull_provider/application.h>
@@ -27,6 +28,9 @@
 #include <modules/rtsp/header_fields/rtsp_header_fields.h>
 
 #define RTSP_USER_AGENT_NAME	"OvenMediaEngine"
+
+#define RTSPC_CONNECTION_TIMEOUT_MS	3000
+#define RTSPC_RESPONSE_TIMEOUT_MS	3000
 namespace pvd
 {
 	class RtspcProvider;
@@ -60,15 +64,50 @@ namespace pvd
 	private:
 		std::shared_ptr<pvd::RtspcProvider> GetRtspcProvider();
 
+		// Forwards the events of the signalling socket, the socket does not keep the stream alive
+		class SignallingSocketObserver : public ov::SocketAsyncInterface
+		{
+		public:
+			SignallingSocketObserver(const std::shared_ptr<RtspcStream> &stream, uint32_t generation)
+				: _stream(stream),
+				  _generation(generation)
+			{
+			}
+
+			void OnConnected(const std::shared_ptr<const ov::SocketError> &error) override;
+			void OnReadable() override;
+			void OnClosed() override;
+
+		private:
+			std::weak_ptr<RtspcStream> _stream;
+			// To ignore the events of the previous socket after reconnecting
+			uint32_t _generation;
+		};
+
+		// response is nullptr if timed out
+		using ResponseHandler = std::function<void(const std::shared_ptr<RtspMessage> &response)>;
+		using HandshakeCallback = std::function<void(bool succeeded)>;
+
 		class ResponseSubscription
 		{
 		public:
-			ResponseSubscription(const std::shared_ptr<RtspMessage> &message)
+			ResponseSubscription(const std::shared_ptr<RtspMessage> &message, ResponseHandler handler = nullptr)
 			{
 				_request = message;
+				_handler = std::move(handler);
 				_reqeust_stop_watch.Start();
 			}
 
+			void SetTimer(const ov::TimingWheel::TimerHandle &timer)
+			{
+				_timer = timer;
+			}
+
+			const ov::TimingWheel::TimerHandle &GetTimer() const
+			{
+				return _timer;
+			}
+
 			std::shared_ptr<RtspMessage> WaitForResponse(uint64_t timeout_ms)
 			{
 				// Semaphore Wait
@@ -85,6 +124,12 @@ namespace pvd
 				_response = message;
 				_round_trip_time_ms = _reqeust_stop_watch.Elapsed();
 
+				if (_handler != nullptr)
+				{
+					_handler(message);
+					return;
+				}
+
 				// Notify
 				_event.Notify();
 			}
@@ -97,36 +142,67 @@ namespace pvd
 
 			std::shared_ptr<RtspMessage> _request = nullptr;
 			std::shared_ptr<RtspMessage> _response = nullptr;
+
+			ResponseHandler _handler = nullptr;
+			ov::TimingWheel::TimerHandle _timer = nullptr;
+		};
+
+		// A media to be set up
+		struct SetupItem
+		{
+			std::shared_ptr<const MediaDescription> media_desc;
+			std::shared_ptr<const PayloadAttr> payload;
+			RtpDepacketizingManager::SupportedDepacketizerType depacketizer_type;
+			std::shared_ptr<MediaTrack> track;
+			uint8_t interleaved_channel = 0;
 		};
 
 		bool StartStream(const std::shared_ptr<const ov::Url> &url) override; // Start
 		bool RestartStream(const std::shared_ptr<const ov::Url> &url) override; // Failover
 		bool StopStream() override; // Stop
+		bool RestartStreamAsync(const std::shared_ptr<const ov::Url> &url, std::function<void(bool succeeded)> on_completed) override;
+
+		// The handshake (CONNECT -> DESCRIBE -> SETUP(s) -> PLAY) is driven by the events of the socket pool,
+		// so the caller is not blocked, and the handshakes of many streams can be performed concurrently.
+		// callback is called once when the stream starts playing or the handshake is failed.
+		bool StartHandshake(const std::shared_ptr<const ov::Url> &url, HandshakeCallback callback);
+		void CompleteHandshake(bool succeeded);
+
+		void OnSignallingAddressResolved(uint32_t generation, const ov::SocketAddress &address);
+		void OnSignallingConnected(uint32_t generation, const std::shared_ptr<const ov::SocketError> &error);
+		void OnSignallingReadable(uint32_t generation);
+		void OnSignallingClosed(uint32_t generation);
+		void OnResponseTimedOut(uint32_t cseq);
 
 		bool ConnectTo();
 		bool RequestDescribe();
+		bool OnDescribeResponse(const std::shared_ptr<RtspMessage> &describe, const std::shared_ptr<RtspMessage> &reply);
 		bool RequestSetup();
+		bool SendSetup(size_t index);
+		bool OnSetupResponse(size_t index, const std::shared_ptr<RtspMessage> &setup, const std::shared_ptr<RtspMessage> &reply);
+		bool SetupTrack(const SetupItem &item);
 		bool RequestPlay();
+		bool OnPlayResponse(const std::shared_ptr<RtspMessage> &play, const std::shared_ptr<RtspMessage> &reply);
 		bool RequestStop();
 		void Release();
 
 		int32_t GetNextCSeq();
 
-		bool SendRequestMessage(const std::shared_ptr<RtspMessage> &message);
+		bool SendRequestMessage(const std::shared_ptr<RtspMessage> &message, ResponseHandler handler = nullptr);
+		// It is used in playing state, the response is notified by ProcessMediaPacket()
 		std::shared_ptr<RtspMessage> ReceiveResponse(uint32_t cseq, uint64_t timeout_ms);
 
-		// Blocking, it is used before playing state
-		std::shared_ptr<RtspMessage> ReceiveMessage(int64_t timeout_msec);
-
 		// Receive and append packet to demuxer
-		bool ReceivePacket(bool non_block = false, int64_t timeout_msec = 0);
+		bool ReceivePacket();
+		// Dispatch the responses received before playing state
+		bool DispatchHandshakeMessages();
 
 		bool AddDepacketizer(uint8_t payload_type, RtpDepacketizingManager::SupportedDepacketizerType codec_id);
 		std::shared_ptr<RtpDepacketizingManager> GetDepacketizer(uint8_t payload_type);
 
 		ov::String GenerateControlUrl(ov::String control);
 
-		bool SubscribeResponse(const std::shared_ptr<RtspMessage> &request_message);
+		std::shared_ptr<ResponseSubscription> SubscribeResponse(const std::shared_ptr<RtspMessage> &request_message, ResponseHandler handler);
 		std::shared_ptr<ResponseSubscription> PopResponseSubscription(uint32_t cseq);
 
 		std::vector<std::shared_ptr<const ov::Url>> _url_list;
@@ -134,7 +210,19 @@ namespace pvd
 		std::shared_ptr<RtspHeaderAuthorizationField> _authorization_field = nullptr;
 
 		std::shared_ptr<ov::Socket> _signalling_socket;
-		
+		uint32_t _signalling_generation = 0;
+
+		// Guards the handshake, it is driven by the socket pool and the timer of the response timeout
+		std::recursive_mutex _handshake_lock;
+		HandshakeCallback _handshake_callback = nullptr;
+		std::vector<SetupItem> _setup_items;
+		size_t _setup_request_count = 0;
+		size_t _setup_response_count = 0;
+		ov::StopWatch _handshake_stop_watch;
+
+		// Guards _rtsp_demuxer, it is fed by the socket pool during the handshake and by the StreamMotor after that
+		std::mutex _receive_lock;
+
 		// Values from RTSP
 		int32_t	_cseq = 0;
 
@@ -74,6 +74,8 @@ namespace pvd
 			return false;
 		}
 
+		StartIngestWorkers();
+
 		bool result = true;
 		std::vector<ov::String> address_string_list;
 		std::vector<std::shared_ptr<PhysicalPort>> physical_port_list;
@@ -117,6 +119,8 @@ namespace pvd
 			physical_port_manager->DeletePort(physical_port);
 		}
 
+		StopIngestWorkers();
+
 		return false;
 	}
 
@@ -134,6 +138,8 @@ namespace pvd
 			physical_port_manager->DeletePort(physical_port);
 		}
 
+		StopIngestWorkers();
+
 		return Provider::Stop();
 	}
 
@@ -160,7 +166,7 @@ namespace pvd
 			return nullptr;
 		}
 
-		auto audio_map = application_info.GetConfig().GetProviders().GetSrtProvider().GetAudioMap();
+		auto audio_map = application_info.GetConfig()->GetProviders().GetSrtProvider().GetAudioMap();
 		application->AddAudioMapItems(audio_map);
 
 		return application;
@@ -103,6 +103,7 @@ namespace pvd
 		payload->SetRtpmap(payload_type_num++, "H264", 90000);
 		payload->SetFmtp(ov::String::FormatString("packetization-mode=1;profile-level-id=%x;level-asymmetry-allowed=1",	0x42e01f));
 		payload->EnableRtcpFb(PayloadAttr::RtcpFbType::CcmFir, true);
+		payload->EnableRtcpFb(PayloadAttr::RtcpFbType::Nack, true);
 		payload->EnableRtcpFb(PayloadAttr::RtcpFbType::NackPli, true);
 		payload->EnableRtcpFb(PayloadAttr::RtcpFbType::TransportCc, true);
 		video_media_desc->AddPayload(payload);
@@ -111,6 +112,7 @@ namespace pvd
 		payload = std::make_shared<PayloadAttr>();
 		payload->SetRtpmap(payload_type_num++, "VP8", 90000);
 		payload->EnableRtcpFb(PayloadAttr::RtcpFbType::CcmFir, true);
+		payload->EnableRtcpFb(PayloadAttr::RtcpFbType::Nack, true);
 		payload->EnableRtcpFb(PayloadAttr::RtcpFbType::NackPli, true);
 		
 		if (transport_cc_enabled)
@@ -267,6 +269,12 @@ namespace pvd
 					answer_payload->EnableRtcpFb(PayloadAttr::RtcpFbType::CcmFir, true);
 				}
 
+				// Generic NACK
+				if (offer_payload->IsRtcpFbEnabled(PayloadAttr::RtcpFbType::Nack))
+				{
+					answer_payload->EnableRtcpFb(PayloadAttr::RtcpFbType::Nack, true);
+				}
+
 				// NACK PLI
 				if (offer_payload->IsRtcpFbEnabled(PayloadAttr::RtcpFbType::NackPli))
 				{
@@ -225,7 +225,7 @@ namespace pvd
 
 		if (_whip_server != nullptr)
 		{
-			auto webrtc_cfg = application_info.GetConfig().GetProviders().GetWebrtcProvider();
+			auto webrtc_cfg = application_info.GetConfig()->GetProviders().GetWebrtcProvider();
 			auto cross_domains = webrtc_cfg.GetCrossDomainList();
 			if (cross_domains.empty())
 			{
@@ -369,10 +369,9 @@ namespace pvd
 			ice_candidates->insert(ice_candidates->end(), candidates.cbegin(), candidates.cend());
 		}
 
-		auto session_description = std::make_shared<SessionDescription>(*application->GetOfferSDP());
-		session_description->SetOrigin("OvenMediaEngine", ov::Unique::GenerateUint32(), 2, "IN", 4, "127.0.0.1");
-		session_description->SetIceUfrag(_ice_port->GenerateUfrag());
-		session_description->Update();
+		// Build the offer of this session from the per-application template, only the session id and ufrag differ
+		auto offer_sdp = application->GetOfferSDP();
+		auto session_description = offer_sdp->CreateFromTemplate(ov::Unique::GenerateUint32(), _ice_port->GenerateUfrag(), offer_sdp->GetIcePwd());
 
 		// Passed AccessControl
 		ws_session->AddUserData("authorized", true);
@@ -469,7 +468,7 @@ namespace pvd
 			return false;
 		}
 
-		auto ice_timeout = application->GetConfig().GetProviders().GetWebrtcProvider().GetTimeout();
+		auto ice_timeout = application->GetConfig()->GetProviders().GetWebrtcProvider().GetTimeout();
 		_ice_port->AddSession(IcePortObserver::GetSharedPtr(), stream->GetId(), offer_sdp, peer_sdp, ice_timeout, session_life_time, stream);
 
 		return true;
@@ -636,7 +635,7 @@ namespace pvd
 			return {http::StatusCode::InternalServerError, "Could not publish stream"};
 		}
 
-		auto ice_timeout = application->GetConfig().GetProviders().GetWebrtcProvider().GetTimeout();
+		auto ice_timeout = application->GetConfig()->GetProviders().GetWebrtcProvider().GetTimeout();
 		_ice_port->AddSession(IcePortObserver::GetSharedPtr(), stream->GetId(), answer_sdp, offer_sdp, ice_timeout, session_life_time, stream);
 
 		return {stream->GetSessionKey(), ov::Random::GenerateString(8), answer_sdp, http::StatusCode::Created};
@@ -215,6 +215,12 @@ namespace pvd
 				AddTrack(video_track);
 				_rtp_rtcp->AddRtpReceiver(ssrc, video_track);
 
+				if (first_payload->IsRtcpFbEnabled(PayloadAttr::RtcpFbType::Nack) == true)
+				{
+					// Lost packets are requested again instead of waiting for the next keyframe
+					_rtp_rtcp->EnableNack(ssrc);
+				}
+
 				if (_rtp_rtcp->IsTransportCcFeedbackEnabled() == false && first_payload->IsRtcpFbEnabled(PayloadAttr::RtcpFbType::TransportCc) == true)
 				{
 					// a=extmap:id http://www.ietf.org/id/draft-holmer-rmcat-transport-wide-cc-extensions-01
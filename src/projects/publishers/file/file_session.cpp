@@ -383,13 +383,7 @@ namespace pub
 
 		if (_writer != nullptr)
 		{
-			bool ret = _writer->PutData(
-				session_packet->GetTrackId(),
-				session_packet->GetPts(),
-				session_packet->GetDts(),
-				session_packet->GetFlag(),
-				session_packet->GetBitstreamFormat(),
-				session_packet->GetData());
+			bool ret = _writer->PutData(session_packet);
 
 			if (ret == false)
 			{
@@ -420,7 +414,7 @@ namespace pub
 	ov::String FileSession::GetRootPath()
 	{
 		auto app_config = std::static_pointer_cast<info::Application>(GetApplication())->GetConfig();
-		auto file_config = app_config.GetPublishers().GetFilePublisher();
+		auto file_config = app_config->GetPublishers().GetFilePublisher();
 
 		return file_config.GetRootPath();
 	}
@@ -436,7 +430,7 @@ namespace pub
 	ov::String FileSession::GetOutputFilePath()
 	{
 		auto app_config = std::static_pointer_cast<info::Application>(GetApplication())->GetConfig();
-		auto file_config = app_config.GetPublishers().GetFilePublisher();
+		auto file_config = app_config->GetPublishers().GetFilePublisher();
 
 		ov::String template_path = "";
 		if (GetRecord()->IsFilePathSetByUser() == true)
@@ -462,7 +456,7 @@ namespace pub
 	ov::String FileSession::GetOutputFileInfoPath()
 	{
 		auto app_config = std::static_pointer_cast<info::Application>(GetApplication())->GetConfig();
-		auto file_config = app_config.GetPublishers().GetFilePublisher();
+		auto file_config = app_config->GetPublishers().GetFilePublisher();
 
 		ov::String template_path = "";
 
@@ -531,7 +525,7 @@ namespace pub
 	{
 		auto app = std::static_pointer_cast<info::Application>(GetApplication());
 		auto stream = std::static_pointer_cast<info::Stream>(GetStream());
-		auto pub_config = app->GetConfig().GetPublishers();
+		auto pub_config = app->GetConfig()->GetPublishers();
 		auto host_config = app->GetHostInfo();
 
 		std::string raw_string = src.CStr();
@@ -57,7 +57,7 @@ LLHlsSession::~LLHlsSession()
 
 bool LLHlsSession::Start()
 {
-	auto llhls_conf = GetApplication()->GetConfig().GetPublishers().GetLLHlsPublisher();
+	auto llhls_conf = GetApplication()->GetConfig()->GetPublishers().GetLLHlsPublisher();
 	auto cache_control = llhls_conf.GetCacheControl();
 
 	_master_playlist_max_age = cache_control.GetMasterPlaylistMaxAge();
@@ -138,6 +138,13 @@ void LLHlsSession::SendOutgoingData(const std::any &notification)
 
 void LLHlsSession::OnMessageReceived(const std::any &message)
 {
+	// The stream wakes up only the sessions waiting for the updated part
+	if (message.type() == typeid(std::shared_ptr<LLHlsStream::PlaylistUpdatedEvent>))
+	{
+		SendOutgoingData(message);
+		return;
+	}
+
 	std::shared_ptr<http::svr::HttpExchange> exchange = nullptr;
 	try 
 	{
@@ -442,7 +449,7 @@ void LLHlsSession::ResponsePlaylist(const std::shared_ptr<http::svr::HttpExchang
 	else if (result == LLHlsStream::RequestResult::Accepted)
 	{
 		// llhls.m3u8 is transmitted when more than one segment (any track) is created.
-		AddPendingRequest(exchange, RequestType::Playlist, file_name, 0, 1, 0, false, legacy);
+		AddPendingRequest(exchange, RequestType::Playlist, file_name, LLHLS_ANY_TRACK_ID, 1, 0, false, legacy);
 		return ;
 	}
 	else
@@ -638,8 +645,18 @@ void LLHlsSession::ResponseSegment(const std::shared_ptr<http::svr::HttpExchange
 
 	auto response = exchange->GetResponse();
 
-	// Get the segment
-	auto [result, segment] = llhls_stream->GetSegment(track_id, segment_number);
+	// Segments in the DVR storage are sent from the file directly (sendfile() on plain HTTP)
+	auto segment_file_range = llhls_stream->GetDvrSegmentFileRange(track_id, segment_number);
+
+	auto result = LLHlsStream::RequestResult::Success;
+	std::shared_ptr<ov::Data> segment = nullptr;
+
+	if (segment_file_range == nullptr)
+	{
+		// Get the segment
+		std::tie(result, segment) = llhls_stream->GetSegment(track_id, segment_number);
+	}
+
 	if (result == LLHlsStream::RequestResult::Success)
 	{
 		// Send the segment
@@ -668,7 +685,14 @@ void LLHlsSession::ResponseSegment(const std::shared_ptr<http::svr::HttpExchange
 			response->SetHeader("Cache-Control", cache_control);
 		}
 
-		response->AppendData(segment);
+		if (segment_file_range != nullptr)
+		{
+			response->AppendFileRange(segment_file_range);
+		}
+		else
+		{
+			response->AppendData(segment);
+		}
 	}
 	else
 	{
@@ -751,56 +775,73 @@ void LLHlsSession::ResponseData(const std::shared_ptr<http::svr::HttpExchange> &
 void LLHlsSession::OnPlaylistUpdated(const int32_t &track_id, const int64_t &msn, const int64_t &part)
 {
 	logtd("LLHlsSession::OnPlaylistUpdated track_id: %d, msn: %lld, part: %lld", track_id, msn, part);
-	// Find the pending request
-	auto it = _pending_requests.begin();
-	while (it != _pending_requests.end())
+
+	// Pop the ready requests first, because the response functions may add the request to the pending list again
+	std::vector<PendingRequest> ready_requests;
+	PopPendingRequests(track_id, msn, part, ready_requests);
+	PopPendingRequests(LLHLS_ANY_TRACK_ID, msn, part, ready_requests);
+
+	for (const auto &request : ready_requests)
 	{
-		if ( (it->type == RequestType::Playlist) &&
-			 ((it->segment_number < msn) || (it->segment_number <= msn && it->partial_number <= part)) )
+		// Resume the request
+		switch (request.type)
 		{
-			// Send the playlist
-			auto exchange = it->exchange;
-			ResponsePlaylist(exchange, it->file_name, it->legacy);
-			it = _pending_requests.erase(it);
+		case RequestType::Playlist:
+			ResponsePlaylist(request.exchange, request.file_name, request.legacy);
+			break;
+		case RequestType::Chunklist:
+			ResponseChunklist(request.exchange, request.file_name, request.track_id, request.segment_number, request.partial_number, request.skip, request.legacy);
+			break;
+		case RequestType::PartialSegment:
+			ResponsePartialSegment(request.exchange, request.file_name, request.track_id, request.segment_number, request.partial_number);
+			break;
+		case RequestType::Segment:
+			ResponseSegment(request.exchange, request.file_name, request.track_id, request.segment_number);
+			break;
+		case RequestType::InitializationSegment:
+			// Initialization segment request is not pending 
+		default:
+			// Assertion
+			OV_ASSERT2(false);
+			break;
 		}
-		else if ( (it->track_id == track_id) && 
-			 ((it->segment_number < msn) || (it->segment_number <= msn && it->partial_number <= part)) )
-		{
-			// Resume the request
-			switch (it->type)
-			{
-			case RequestType::Chunklist:
-				ResponseChunklist(it->exchange, it->file_name, it->track_id, it->segment_number, it->partial_number, it->skip, it->legacy);
-				break;
-			case RequestType::PartialSegment:
-				ResponsePartialSegment(it->exchange, it->file_name, it->track_id, it->segment_number, it->partial_number);
-				break;
-			case RequestType::Segment:
-				ResponseSegment(it->exchange, it->file_name, it->track_id, it->segment_number);
-				break;
-			case RequestType::Playlist:
-				// Playlist is processed already above
-			case RequestType::InitializationSegment:
-				// Initialization segment request is not pending 
-			default:
-				// Assertion
-				OV_ASSERT2(false);
-				break;
-			}
+	}
+}
 
-			// Remove the request
-			it = _pending_requests.erase(it);
-		}
-		else
-		{
-			// Next
-			++it;
-		}
+void LLHlsSession::PopPendingRequests(const int32_t &track_id, const int64_t &msn, const int64_t &part, std::vector<PendingRequest> &requests)
+{
+	auto track_it = _pending_requests.find(track_id);
+	if (track_it == _pending_requests.end())
+	{
+		return;
+	}
+
+	auto &track_requests = track_it->second;
+
+	// A request waiting for <segment_number, partial_number> is ready if
+	// (segment_number < msn) || (segment_number == msn && partial_number <= part)
+	auto end_it = track_requests.upper_bound({msn, part});
+	for (auto it = track_requests.begin(); it != end_it; ++it)
+	{
+		requests.push_back(std::move(it->second));
+	}
+	_pending_request_count -= std::distance(track_requests.begin(), end_it);
+	track_requests.erase(track_requests.begin(), end_it);
+
+	if (track_requests.empty())
+	{
+		_pending_requests.erase(track_it);
 	}
 }
 
 bool LLHlsSession::AddPendingRequest(const std::shared_ptr<http::svr::HttpExchange> &exchange, const RequestType &type, const ov::String &file_name, const int32_t &track_id, const int64_t &segment_number, const int64_t &partial_number, const bool &skip, const bool &legacy)
 {
+	auto llhls_stream = std::static_pointer_cast<LLHlsStream>(GetStream());
+	if (llhls_stream == nullptr)
+	{
+		return false;
+	}
+
 	// Add the request to the pending list
 	PendingRequest request;
 	request.type = type;
@@ -812,17 +853,30 @@ bool LLHlsSession::AddPendingRequest(const std::shared_ptr<http::svr::HttpExchan
 	request.legacy = legacy;
 	request.exchange = exchange;
 
+	auto key = std::make_pair(segment_number, partial_number);
+	auto &track_requests = _pending_requests[track_id];
+
+	// The stream wakes up this session once per <track, msn, part>, 
+	// so register only if no other request of this session is waiting for the same part
+	bool need_to_register = (track_requests.find(key) == track_requests.end());
+
 	// Add the request to the pending list
-	_pending_requests.push_back(request);
+	track_requests.emplace(key, std::move(request));
+	_pending_request_count += 1;
 
-	if (_pending_requests.size() > MAX_PENDING_REQUESTS)
+	if (need_to_register)
+	{
+		llhls_stream->AddBlockingRequestWaiter(track_id, segment_number, partial_number, GetId());
+	}
+
+	if (_pending_request_count > MAX_PENDING_REQUESTS)
 	{
 		logtd("[%s/%s/%u] Too many pending requests (%u)", 
 				GetApplication()->GetName().CStr(),
 				GetStream()->GetName().CStr(),
 				GetId(),
-				_pending_requests.size());
+				_pending_request_count);
 	}
 
 	return true;
-}
\ No newline at end of file
+}
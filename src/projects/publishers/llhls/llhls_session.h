@@ -9,7 +9,7 @@
 #pragma once
 
 #include <base/publisher/session.h>
-#include <list>
+#include <map>
 
 #define MAX_PENDING_REQUESTS 10
 
@@ -88,9 +88,14 @@ private:
 	};
 
 	bool AddPendingRequest(const std::shared_ptr<http::svr::HttpExchange> &exchange, const RequestType &type, const ov::String &file_name, const int32_t &track_id, const int64_t &segment_number, const int64_t &partial_number, const bool &skip, const bool &legacy);
+	// Pop all pending requests of the track waiting for a part less than or equal to <msn, part>
+	void PopPendingRequests(const int32_t &track_id, const int64_t &msn, const int64_t &part, std::vector<PendingRequest> &requests);
 
 	// Session runs on a single thread, so it doesn't need mutex
-	std::list<PendingRequest> _pending_requests;
+	// Track ID : <msn, part> : PendingRequest
+	// (Requests waiting for any track are stored with LLHLS_ANY_TRACK_ID)
+	std::map<int32_t, std::multimap<std::pair<int64_t, int64_t>, PendingRequest>> _pending_requests;
+	size_t _pending_request_count = 0;
 
 	// ID list of connections requesting this session
 	// Connection ID : last request time
@@ -42,7 +42,7 @@ bool LLHlsStream::Start()
 	}
 
 	auto config = GetApplication()->GetConfig();
-	auto llhls_config = config.GetPublishers().GetLLHlsPublisher();
+	auto llhls_config = config->GetPublishers().GetLLHlsPublisher();
 	auto dump_config = llhls_config.GetDumps();
 	auto dvr_config = llhls_config.GetDvr();
 
@@ -55,6 +55,7 @@ bool LLHlsStream::Start()
 	_storage_config.dvr_enabled = dvr_config.IsEnabled();
 	_storage_config.dvr_storage_path = dvr_config.GetTempStoragePath();
 	_storage_config.dvr_duration_sec = dvr_config.GetMaxDuration();
+	_storage_config.dvr_volume_size = static_cast<uint64_t>(std::max(dvr_config.GetVolumeSizeMB(), 1)) * 1024 * 1024;
 
 	_configured_part_hold_back = llhls_config.GetPartHoldBack();
 
@@ -583,6 +584,17 @@ std::tuple<LLHlsStream::RequestResult, std::shared_ptr<ov::Data>> LLHlsStream::G
 	return {RequestResult::Success, segment->GetData()};
 }
 
+std::shared_ptr<ov::FileRange> LLHlsStream::GetDvrSegmentFileRange(const int32_t &track_id, const int64_t &segment_number) const
+{
+	auto storage = GetStorage(track_id);
+	if (storage == nullptr)
+	{
+		return nullptr;
+	}
+
+	return storage->GetDvrSegmentFileRange(segment_number);
+}
+
 std::tuple<LLHlsStream::RequestResult, std::shared_ptr<ov::Data>> LLHlsStream::GetChunk(const int32_t &track_id, const int64_t &segment_number, const int64_t &chunk_number) const
 {
 	logtd("LLHlsStream(%s) - GetChunk(%d, %ld, %ld)", GetName().CStr(), track_id, segment_number, chunk_number);
@@ -1049,11 +1061,96 @@ void LLHlsStream::OnMediaSegmentDeleted(const int32_t &track_id, const uint32_t
 
 void LLHlsStream::NotifyPlaylistUpdated(const int32_t &track_id, const int64_t &msn, const int64_t &part)
 {
-	// Make std::any for broadcast
+	BlockingRequestKey updated_key{msn, part};
+	std::vector<session_id_t> waiters;
+
+	std::unique_lock<std::mutex> lock(_blocking_request_index_lock);
+	// A waiter registered after this point is compared against the last notified part (see AddBlockingRequestWaiter())
+	_last_notified_keys[track_id] = updated_key;
+	PopBlockingRequestWaiters(track_id, updated_key, waiters);
+	PopBlockingRequestWaiters(LLHLS_ANY_TRACK_ID, updated_key, waiters);
+	lock.unlock();
+
+	if (waiters.empty())
+	{
+		return;
+	}
+
+	// A session may wait for several parts, but it only needs to be woken up once
+	std::sort(waiters.begin(), waiters.end());
+	waiters.erase(std::unique(waiters.begin(), waiters.end()), waiters.end());
+
 	// I think make_shared is better than copy sizeof(PlaylistUpdatedEvent) to all sessions
 	auto event = std::make_shared<PlaylistUpdatedEvent>(track_id, msn, part);
 	auto notification = std::make_any<std::shared_ptr<PlaylistUpdatedEvent>>(event);
-	BroadcastPacket(notification);
+
+	for (const auto &session_id : waiters)
+	{
+		auto session = GetSession(session_id);
+		if (session == nullptr)
+		{
+			// The session has been disconnected while waiting
+			continue;
+		}
+
+		SendMessage(session, notification);
+	}
+}
+
+void LLHlsStream::PopBlockingRequestWaiters(const int32_t &track_id, const BlockingRequestKey &key, std::vector<session_id_t> &waiters)
+{
+	auto index_it = _blocking_request_index.find(track_id);
+	if (index_it == _blocking_request_index.end())
+	{
+		return;
+	}
+
+	auto &track_waiters = index_it->second;
+
+	// Requests waiting for <msn, part> are satisfied if (msn < updated msn) or (msn == updated msn && part <= updated part),
+	// which is the lexicographical order of <msn, part>.
+	auto end_it = track_waiters.upper_bound(key);
+	for (auto it = track_waiters.begin(); it != end_it; ++it)
+	{
+		waiters.push_back(it->second);
+	}
+	track_waiters.erase(track_waiters.begin(), end_it);
+
+	if (track_waiters.empty())
+	{
+		_blocking_request_index.erase(index_it);
+	}
+}
+
+void LLHlsStream::AddBlockingRequestWaiter(const int32_t &track_id, const int64_t &msn, const int64_t &part, session_id_t session_id)
+{
+	BlockingRequestKey key{msn, part};
+
+	{
+		std::lock_guard<std::mutex> lock(_blocking_request_index_lock);
+
+		// The part may have been updated between the request and the registration, so the session is woken up immediately.
+		// Requests that can be held by another condition (requests for any track, or any request until IsReadyToPlay())
+		// are excluded, since waking them up here would make them spin. They are woken up by the next update.
+		auto last_notified_it = _last_notified_keys.find(track_id);
+		if ((track_id == LLHLS_ANY_TRACK_ID) || (IsReadyToPlay() == false) ||
+			(last_notified_it == _last_notified_keys.end()) || (last_notified_it->second < key))
+		{
+			_blocking_request_index[track_id].emplace(key, session_id);
+			return;
+		}
+
+		key = last_notified_it->second;
+	}
+
+	auto session = GetSession(session_id);
+	if (session == nullptr)
+	{
+		return;
+	}
+
+	auto event = std::make_shared<PlaylistUpdatedEvent>(track_id, key.first, key.second);
+	SendMessage(session, std::make_any<std::shared_ptr<PlaylistUpdatedEvent>>(event));
 }
 
 int64_t LLHlsStream::GetMinimumLastSegmentNumber() const
@@ -21,6 +21,9 @@
 
 #define DEFAULT_PLAYLIST_NAME	"llhls.m3u8"
 
+// Used as a track ID of the blocking request that waits for any track (e.g. llhls.m3u8)
+#define LLHLS_ANY_TRACK_ID		-1
+
 
 // max initial media packet buffer size, for OOM protection
 #define MAX_INITIAL_MEDIA_PACKET_BUFFER_SIZE		10000
@@ -69,8 +72,15 @@ public:
 	std::tuple<RequestResult, std::shared_ptr<const ov::Data>> GetChunklist(const ov::String &chunk_query_string, const int32_t &track_id, int64_t msn, int64_t psn, bool skip, bool gzip, bool legacy) const;
 	std::tuple<RequestResult, std::shared_ptr<ov::Data>> GetInitializationSegment(const int32_t &track_id) const;
 	std::tuple<RequestResult, std::shared_ptr<ov::Data>> GetSegment(const int32_t &track_id, const int64_t &segment_number) const;
+	// Returns the file range of the segment if it has been moved to the DVR storage, so that it can be sent with sendfile()
+	std::shared_ptr<ov::FileRange> GetDvrSegmentFileRange(const int32_t &track_id, const int64_t &segment_number) const;
 	std::tuple<RequestResult, std::shared_ptr<ov::Data>> GetChunk(const int32_t &track_id, const int64_t &segment_number, const int64_t &chunk_number) const;
 
+	// Register a session that has a blocked request waiting for <msn, part> of the track.
+	// Only the registered sessions are woken up when the part is updated.
+	// If the part has already been updated, the session is woken up immediately instead.
+	void AddBlockingRequestWaiter(const int32_t &track_id, const int64_t &msn, const int64_t &part, session_id_t session_id);
+
 	// <result, error message>
 	std::tuple<bool, ov::String> StartDump(const std::shared_ptr<info::Dump> &dump_info);
 	std::tuple<bool, ov::String> StopDump(const std::shared_ptr<info::Dump> &dump_info);
@@ -161,4 +171,16 @@ private:
 
 	std::map<ov::String, std::shared_ptr<mdl::Dump>> _dumps;
 	std::shared_mutex _dumps_lock;
+
+	// Blocking request index
+	// <msn, part>
+	using BlockingRequestKey = std::pair<int64_t, int64_t>;
+	// Pop all session IDs waiting for a part less than or equal to the key
+	void PopBlockingRequestWaiters(const int32_t &track_id, const BlockingRequestKey &key, std::vector<session_id_t> &waiters);
+	// Track ID : <msn, part> : Session ID
+	std::map<int32_t, std::multimap<BlockingRequestKey, session_id_t>> _blocking_request_index;
+	// Track ID : the last <msn, part> passed to NotifyPlaylistUpdated()
+	std::map<int32_t, BlockingRequestKey> _last_notified_keys;
+	// Guards _blocking_request_index and _last_notified_keys
+	std::mutex _blocking_request_index_lock;
 };
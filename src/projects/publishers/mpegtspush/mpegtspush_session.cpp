@@ -160,13 +160,7 @@ void MpegtsPushSession::SendOutgoingData(const std::any &packet)
 
 	if(_writer != nullptr)
     {
-	  	bool ret = _writer->PutData(
-			session_packet->GetTrackId(), 
-			session_packet->GetPts(),
-			session_packet->GetDts(), 
-			session_packet->GetFlag(), 
-			session_packet->GetBitstreamFormat(),
-			session_packet->GetData());
+	  	bool ret = _writer->PutData(session_packet);
 
 		if(ret == false)
 		{
@@ -63,7 +63,8 @@ std::shared_ptr<pub::Application> CmafPublisher::OnCreatePublisherApplication(co
 	}
 
 	auto name = application_info.GetName();
-	auto &lldash_publisher_config = application_info.GetConfig().GetPublishers().GetLlDashPublisher();
+	auto app_config = application_info.GetConfig();
+	auto &lldash_publisher_config = app_config->GetPublishers().GetLlDashPublisher();
 
 	if (lldash_publisher_config.IsParsed() == false)
 	{
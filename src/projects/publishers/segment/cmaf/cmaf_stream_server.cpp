@@ -19,7 +19,9 @@
 
 std::shared_ptr<SegmentStreamInterceptor> CmafStreamServer::CreateInterceptor()
 {
-	return std::make_shared<CmafInterceptor>();
+	_interceptor = std::make_shared<CmafInterceptor>();
+
+	return _interceptor;
 }
 
 bool CmafStreamServer::ProcessSegmentRequest(const std::shared_ptr<http::svr::HttpExchange> &client,
@@ -103,7 +105,7 @@ bool CmafStreamServer::ProcessSegmentRequest(const std::shared_ptr<http::svr::Ht
 				MonitorInstance->IncreaseBytesOut(*stream_info, GetPublisherType(), sent_bytes);
 			}
 
-			chunk_item->second->client_list.push_back(client);
+			chunk_item->second->client_list.push_back({client, _interceptor->HoldPendingExchange(client)});
 
 			return true;
 		}
@@ -141,7 +143,7 @@ void CmafStreamServer::OnCmafChunkDataPush(const ov::String &app_name, const ov:
 
 	while (client_item != chunk_item->second->client_list.end())
 	{
-		auto &client = *client_item;
+		auto &client = client_item->exchange;
 
 		auto response = std::static_pointer_cast<http::svr::h1::Http1Response>(client->GetResponse());
 		if (response == nullptr)
@@ -203,9 +205,9 @@ void CmafStreamServer::OnCmafChunkedComplete(const ov::String &app_name, const o
 		  app_name.CStr(), stream_name.CStr(), StringFromPublisherType(GetPublisherType()).CStr(),
 		  file_name.CStr());
 
-	for (auto client : chunked_data->client_list)
+	for (const auto &client : chunked_data->client_list)
 	{
-		auto response = std::static_pointer_cast<http::svr::h1::Http1Response>(client->GetResponse());
+		auto response = std::static_pointer_cast<http::svr::h1::Http1Response>(client.exchange->GetResponse());
 		if (response == nullptr)
 		{
 			logte("LLDASH only supports HTTP/1.1.");
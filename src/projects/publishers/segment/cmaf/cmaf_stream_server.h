@@ -28,6 +28,13 @@ public:
 protected:
 	std::shared_ptr<SegmentStreamInterceptor> CreateInterceptor() override;
 
+	struct CmafHttpChunkedClient
+	{
+		std::shared_ptr<http::svr::HttpExchange> exchange;
+		// Keeps the exchange pending in the interceptor until the chunked response is completed
+		std::shared_ptr<void> pending_hold;
+	};
+
 	struct CmafHttpChunkedData
 	{
 	public:
@@ -47,7 +54,7 @@ protected:
 		uint32_t sequence_number = 0U;
 		uint64_t duration_in_msec = 0U;
 		std::shared_ptr<ov::Data> chunked_data;
-		std::vector<std::shared_ptr<http::svr::HttpExchange>> client_list;
+		std::vector<CmafHttpChunkedClient> client_list;
 	};
 
 	//--------------------------------------------------------------------
@@ -74,4 +81,6 @@ protected:
 	// Key: [app name]/[stream name]/[file name]
 	std::unordered_map<ov::String, std::shared_ptr<CmafHttpChunkedData>> _http_chunk_list;
 	std::mutex _http_chunk_guard;
+
+	std::shared_ptr<SegmentStreamInterceptor> _interceptor;
 };
@@ -53,7 +53,8 @@ std::shared_ptr<pub::Application> DashPublisher::OnCreatePublisherApplication(co
 	}
 
 	auto name = application_info.GetName();
-	auto &dash_publisher_config = application_info.GetConfig().GetPublishers().GetDashPublisher();
+	auto app_config = application_info.GetConfig();
+	auto &dash_publisher_config = app_config->GetPublishers().GetDashPublisher();
 
 	if (dash_publisher_config.IsParsed() == false)
 	{
@@ -186,9 +186,12 @@ bool DashStreamServer::ProcessSegmentRequest(const std::shared_ptr<http::svr::Ht
 		return false;
 	}
 
+	auto content_type = (segment->type == SegmentDataType::Video) ? "video/mp4" : "audio/mp4";
+
 	// Set HTTP header
-	response->SetHeader("Content-Type", (segment->type == SegmentDataType::Video) ? "video/mp4" : "audio/mp4");
-	response->AppendData(segment->data);
+	response->SetHeader("Content-Type", content_type);
+	// The segment is immutable, so it doesn't need to be copied
+	response->AppendSharedData(segment->data);
 	auto sent_bytes = response->Response();
 
 	auto stream_info = GetStream(client);
@@ -197,5 +200,12 @@ bool DashStreamServer::ProcessSegmentRequest(const std::shared_ptr<http::svr::Ht
 		MonitorInstance->IncreaseBytesOut(*stream_info, GetPublisherType(), sent_bytes);
 	}
 
+	CacheSegment(client, request_info, segment, content_type);
+
 	return true;
 }
+
+bool DashStreamServer::IsCacheableSegment(const ov::String &file_ext) const
+{
+	return file_ext == DASH_SEGMENT_EXT;
+}
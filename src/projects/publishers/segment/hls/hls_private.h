@@ -11,6 +11,7 @@
 #define OV_LOG_TAG						"HLS"
 
 #define HLS_SEGMENT_EXT 				"ts"
+#define HLS_SEGMENT_CONTENT_TYPE		"video/MP2T"
 #define HLS_PLAYLIST_EXT 				"m3u8"
 #define HLS_PLAYLIST_FILE_NAME 			"playlist.m3u8"
 
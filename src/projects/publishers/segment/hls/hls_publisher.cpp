@@ -55,7 +55,8 @@ std::shared_ptr<pub::Application> HlsPublisher::OnCreatePublisherApplication(con
 	}
 
 	auto name = application_info.GetName();
-	auto &hls_publisher_config = application_info.GetConfig().GetPublishers().GetHlsPublisher();
+	auto app_config = application_info.GetConfig();
+	auto &hls_publisher_config = app_config->GetPublishers().GetHlsPublisher();
 
 	if (hls_publisher_config.IsParsed() == false)
 	{
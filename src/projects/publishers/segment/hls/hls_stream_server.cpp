@@ -114,8 +114,9 @@ bool HlsStreamServer::ProcessSegmentRequest(const std::shared_ptr<http::svr::Htt
 	}
 
 	// Set HTTP header
-	response->SetHeader("Content-Type", "video/MP2T");
-	response->AppendData(segment->data);
+	response->SetHeader("Content-Type", HLS_SEGMENT_CONTENT_TYPE);
+	// The segment is immutable, so it doesn't need to be copied
+	response->AppendSharedData(segment->data);
 	auto sent_bytes = response->Response();
 
 	auto stream_info = GetStream(exchange);
@@ -124,7 +125,14 @@ bool HlsStreamServer::ProcessSegmentRequest(const std::shared_ptr<http::svr::Htt
 		MonitorInstance->IncreaseBytesOut(*stream_info, GetPublisherType(), sent_bytes);
 	}
 
+	CacheSegment(exchange, request_info, segment, HLS_SEGMENT_CONTENT_TYPE);
+
 	exchange->Release();
 
 	return true;
 }
+
+bool HlsStreamServer::IsCacheableSegment(const ov::String &file_ext) const
+{
+	return file_ext == HLS_SEGMENT_EXT;
+}
@@ -45,4 +45,6 @@ protected:
 	bool ProcessSegmentRequest(const std::shared_ptr<http::svr::HttpExchange> &client,
 										 const SegmentStreamRequestInfo &request_info,
 										 SegmentType segment_type) override;
+
+	bool IsCacheableSegment(const ov::String &file_ext) const override;
 };
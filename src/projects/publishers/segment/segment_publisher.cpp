@@ -201,13 +201,33 @@ bool SegmentPublisher::OnSegmentRequest(const std::shared_ptr<http::svr::HttpExc
 		return false;
 	}
 
+	OnSegmentServed(client, request_info, stream, segment);
+
+	return true;
+}
+
+bool SegmentPublisher::OnCachedSegmentRequest(const std::shared_ptr<http::svr::HttpExchange> &client,
+											  const SegmentStreamRequestInfo &request_info,
+											  const std::shared_ptr<pub::Stream> &stream,
+											  const std::shared_ptr<const SegmentItem> &segment)
+{
+	OnSegmentServed(client, request_info, stream, segment);
+
+	return true;
+}
+
+void SegmentPublisher::OnSegmentServed(const std::shared_ptr<http::svr::HttpExchange> &client,
+									   const SegmentStreamRequestInfo &request_info,
+									   const std::shared_ptr<pub::Stream> &stream,
+									   const std::shared_ptr<const SegmentItem> &segment)
+{
 	// To manage sessions
 	logti("[%s/%s] Segment requested %s from %s : Segment number : %u Duration : %u",
-		  vhost_app_name.CStr(), stream_name.CStr(), file_name.CStr(),
+		  request_info.vhost_app_name.CStr(), request_info.stream_name.CStr(), request_info.file_name.CStr(),
 		  client->GetRequest()->GetRemote()->GetRemoteAddress()->ToString(false).CStr(),
 		  segment->sequence_number, segment->duration_in_ms / 1000);
 
-	client->SetExtra(std::static_pointer_cast<pub::Stream>(stream));
+	client->SetExtra(stream);
 
 	// The first sequence number 0 means init_video and init_audio in MPEG-DASH.
 	// These are excluded because they confuse statistical calculations.
@@ -221,8 +241,6 @@ bool SegmentPublisher::OnSegmentRequest(const std::shared_ptr<http::svr::HttpExc
 													   segment->duration_in_ms / 1000);
 		UpdateSegmentRequestInfo(segment_request_info);
 	}
-
-	return true;
 }
 
 bool SegmentPublisher::StartSessionTableManager()
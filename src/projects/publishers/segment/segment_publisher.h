@@ -278,9 +278,19 @@ protected:
 						  const SegmentStreamRequestInfo &request_info,
 						  std::shared_ptr<const SegmentItem> &segment) override;
 
+	bool OnCachedSegmentRequest(const std::shared_ptr<http::svr::HttpExchange> &client,
+								const SegmentStreamRequestInfo &request_info,
+								const std::shared_ptr<pub::Stream> &stream,
+								const std::shared_ptr<const SegmentItem> &segment) override;
+
 	std::shared_ptr<SegmentStreamServer> _stream_server = nullptr;
 
 private:
+	// Manages the session of the client that requested the segment
+	void		OnSegmentServed(const std::shared_ptr<http::svr::HttpExchange> &client,
+								const SegmentStreamRequestInfo &request_info,
+								const std::shared_ptr<pub::Stream> &stream,
+								const std::shared_ptr<const SegmentItem> &segment);
 	void		UpdatePlaylistRequestInfo(const std::shared_ptr<PlaylistRequestInfo> &info);
 	void		UpdateWebhooksRequestInfo(const WebhooksRequestInfo &info);
 	bool		StartSessionTableManager();
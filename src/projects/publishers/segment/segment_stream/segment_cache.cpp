@@ -0,0 +1,193 @@
+//==============================================================================
+//
+//  OvenMediaEngine
+//
+//  Created by Getroot
+//  Copyright (c) 2022 AirenSoft. All rights reserved.
+//
+//==============================================================================
+#include "segment_cache.h"
+
+#include <monitoring/monitoring.h>
+
+#include "segment_stream_private.h"
+
+SegmentCache::SegmentCache(PublisherType publisher_type, size_t max_bytes, int64_t ttl_ms)
+	: _publisher_type(publisher_type),
+	  _max_bytes_per_shard(max_bytes / SEGMENT_CACHE_SHARD_COUNT),
+	  _ttl_ms(ttl_ms)
+{
+}
+
+SegmentCache::~SegmentCache()
+{
+	for (auto &shard : _shards)
+	{
+		std::unique_lock<std::shared_mutex> lock(shard.mutex);
+
+		while (shard.entry_map.empty() == false)
+		{
+			RemoveEntry(shard, shard.entry_map.begin(), false);
+		}
+	}
+}
+
+ov::String SegmentCache::MakeKey(const info::VHostAppName &vhost_app_name, const ov::String &stream_name, const ov::String &file_name)
+{
+	return ov::String::FormatString("%s/%s/%s", vhost_app_name.CStr(), stream_name.CStr(), file_name.CStr());
+}
+
+SegmentCache::Shard &SegmentCache::GetShard(const ov::String &key)
+{
+	return _shards[std::hash<ov::String>()(key) % SEGMENT_CACHE_SHARD_COUNT];
+}
+
+bool SegmentCache::IsExpired(const Entry &entry, int64_t now_ms) const
+{
+	return (now_ms >= entry.expire_time_ms) || entry.item.stream.expired();
+}
+
+bool SegmentCache::Get(const ov::String &key, Item *item, std::shared_ptr<pub::Stream> *stream)
+{
+	auto &metrics = MonitorInstance->GetSegmentCacheMetrics();
+	auto &shard = GetShard(key);
+	auto now_ms = ov::Time::GetMonotonicTimestamp();
+
+	std::shared_ptr<Entry> expired_entry;
+
+	{
+		std::shared_lock<std::shared_mutex> lock(shard.mutex);
+
+		auto entry_item = shard.entry_map.find(key);
+		if (entry_item != shard.entry_map.end())
+		{
+			auto &entry = entry_item->second;
+
+			*stream = entry->item.stream.lock();
+
+			if ((now_ms < entry->expire_time_ms) && (*stream != nullptr))
+			{
+				entry->last_access_time_ms = now_ms;
+				*item = entry->item;
+
+				metrics.IncreaseHits(_publisher_type);
+				return true;
+			}
+
+			expired_entry = entry;
+		}
+	}
+
+	if (expired_entry != nullptr)
+	{
+		std::unique_lock<std::shared_mutex> lock(shard.mutex);
+
+		// The entry might have been replaced while the lock is released
+		auto entry_item = shard.entry_map.find(key);
+		if ((entry_item != shard.entry_map.end()) && (entry_item->second == expired_entry))
+		{
+			RemoveEntry(shard, entry_item, true);
+		}
+	}
+
+	stream->reset();
+	metrics.IncreaseMisses(_publisher_type);
+
+	return false;
+}
+
+bool SegmentCache::Put(const ov::String &key, const Item &item)
+{
+	if ((item.segment == nullptr) || (item.segment->data == nullptr))
+	{
+		return false;
+	}
+
+	auto size = item.segment->data->GetLength();
+	if (size > _max_bytes_per_shard)
+	{
+		logtd("The segment is too large to be cached: %s (%zu bytes)", key.CStr(), size);
+		return false;
+	}
+
+	auto &shard = GetShard(key);
+	auto now_ms = ov::Time::GetMonotonicTimestamp();
+
+	auto entry = std::make_shared<Entry>();
+	entry->item = item;
+	entry->size = size;
+	entry->expire_time_ms = now_ms + _ttl_ms;
+	entry->last_access_time_ms = now_ms;
+
+	std::unique_lock<std::shared_mutex> lock(shard.mutex);
+
+	auto entry_item = shard.entry_map.find(key);
+	if (entry_item != shard.entry_map.end())
+	{
+		// Another connection cached the segment first
+		if (entry_item->second->item.segment == item.segment)
+		{
+			return true;
+		}
+
+		RemoveEntry(shard, entry_item, false);
+	}
+
+	Evict(shard, size, now_ms);
+
+	shard.entry_map.emplace(key, entry);
+	shard.bytes += size;
+
+	MonitorInstance->GetSegmentCacheMetrics().OnEntryAdded(_publisher_type, size);
+
+	return true;
+}
+
+void SegmentCache::RemoveEntry(Shard &shard, std::unordered_map<ov::String, std::shared_ptr<Entry>>::iterator iterator, bool is_evicted)
+{
+	auto size = iterator->second->size;
+
+	shard.bytes -= size;
+	shard.entry_map.erase(iterator);
+
+	MonitorInstance->GetSegmentCacheMetrics().OnEntryRemoved(_publisher_type, size, is_evicted);
+}
+
+void SegmentCache::Evict(Shard &shard, size_t required_bytes, int64_t now_ms)
+{
+	// Expired entries first
+	for (auto entry_item = shard.entry_map.begin(); entry_item != shard.entry_map.end();)
+	{
+		auto current = entry_item++;
+
+		if (IsExpired(*(current->second), now_ms))
+		{
+			RemoveEntry(shard, current, true);
+		}
+	}
+
+	// And then the least recently used entries
+	while ((shard.bytes + required_bytes) > _max_bytes_per_shard)
+	{
+		auto oldest_item = shard.entry_map.end();
+		int64_t oldest_access_time_ms = INT64_MAX;
+
+		for (auto entry_item = shard.entry_map.begin(); entry_item != shard.entry_map.end(); ++entry_item)
+		{
+			auto last_access_time_ms = entry_item->second->last_access_time_ms.load();
+
+			if (last_access_time_ms < oldest_access_time_ms)
+			{
+				oldest_access_time_ms = last_access_time_ms;
+				oldest_item = entry_item;
+			}
+		}
+
+		if (oldest_item == shard.entry_map.end())
+		{
+			break;
+		}
+
+		RemoveEntry(shard, oldest_item, true);
+	}
+}
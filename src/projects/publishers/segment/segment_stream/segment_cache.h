@@ -0,0 +1,79 @@
+//==============================================================================
+//
+//  OvenMediaEngine
+//
+//  Created by Getroot
+//  Copyright (c) 2022 AirenSoft. All rights reserved.
+//
+//==============================================================================
+#pragma once
+
+#include <base/common_types.h>
+#include <base/info/vhost_app_name.h>
+#include <base/publisher/stream.h>
+
+#include <shared_mutex>
+
+#include "packetizer/packetizer_define.h"
+
+// Number of the shards of the cache (the lookups of the different shards never contend)
+#define SEGMENT_CACHE_SHARD_COUNT 16
+
+// A cache of the segments served by a segment stream server, shared by all the connections
+//
+// The segments are immutable, so a cached segment is sent by referencing its data without copying it.
+// A lookup only takes the read lock of a shard, and the write lock is taken when a segment is inserted.
+// An entry is evicted when its TTL expires, when its stream is deleted, or when the shard exceeds its part
+// of the memory budget (the least recently used entry first).
+class SegmentCache
+{
+public:
+	struct Item
+	{
+		std::shared_ptr<const SegmentItem> segment;
+		// The cache does not keep the stream alive, and the entry is evicted when the stream is deleted
+		std::weak_ptr<pub::Stream> stream;
+		ov::String content_type;
+	};
+
+	SegmentCache(PublisherType publisher_type, size_t max_bytes, int64_t ttl_ms);
+	~SegmentCache();
+
+	// Makes a key of a segment ("<vhost#app>/<stream>/<file>", the file name identifies the rendition and the segment)
+	static ov::String MakeKey(const info::VHostAppName &vhost_app_name, const ov::String &stream_name, const ov::String &file_name);
+
+	// Returns false if the segment is not cached (the miss is counted)
+	bool Get(const ov::String &key, Item *item, std::shared_ptr<pub::Stream> *stream);
+	bool Put(const ov::String &key, const Item &item);
+
+private:
+	struct Entry
+	{
+		Item item;
+		size_t size = 0;
+		int64_t expire_time_ms = 0;
+		std::atomic<int64_t> last_access_time_ms{0};
+	};
+
+	struct Shard
+	{
+		std::shared_mutex mutex;
+		std::unordered_map<ov::String, std::shared_ptr<Entry>> entry_map;
+		size_t bytes = 0;
+	};
+
+	Shard &GetShard(const ov::String &key);
+
+	bool IsExpired(const Entry &entry, int64_t now_ms) const;
+
+	// Called with the write lock of the shard
+	void RemoveEntry(Shard &shard, std::unordered_map<ov::String, std::shared_ptr<Entry>>::iterator iterator, bool is_evicted);
+	// Evicts the entries until required_bytes can be added to the shard (called with the write lock of the shard)
+	void Evict(Shard &shard, size_t required_bytes, int64_t now_ms);
+
+	PublisherType _publisher_type;
+	size_t _max_bytes_per_shard;
+	int64_t _ttl_ms;
+
+	Shard _shards[SEGMENT_CACHE_SHARD_COUNT];
+};
@@ -8,6 +8,9 @@
 //==============================================================================
 
 #include "segment_stream_interceptor.h"
+
+#include <modules/http/server/http_connection.h>
+
 #include "segment_stream_private.h"
 
 SegmentStreamInterceptor::SegmentStreamInterceptor()
@@ -21,7 +24,37 @@ SegmentStreamInterceptor::~SegmentStreamInterceptor()
 
 bool SegmentStreamInterceptor::Start(int thread_count, const SegmentProcessHandler &process_handler)
 {
-	return _worker_manager.Start(thread_count, process_handler);
+	_process_handler = process_handler;
+
+	return _worker_manager.Start(thread_count, [this](const std::shared_ptr<http::svr::HttpExchange> &exchange) -> bool {
+		auto result = _process_handler(exchange);
+
+		GetPendingExchangeCount(exchange)--;
+
+		return result;
+	});
+}
+
+void SegmentStreamInterceptor::SetCacheHandler(const SegmentProcessHandler &cache_handler)
+{
+	_cache_handler = cache_handler;
+}
+
+std::atomic<uint32_t> &SegmentStreamInterceptor::GetPendingExchangeCount(const std::shared_ptr<http::svr::HttpExchange> &exchange)
+{
+	return _pending_exchange_counts[exchange->GetConnection()->GetId() % SEGMENT_PENDING_EXCHANGE_BUCKET_COUNT];
+}
+
+std::shared_ptr<void> SegmentStreamInterceptor::HoldPendingExchange(const std::shared_ptr<http::svr::HttpExchange> &exchange)
+{
+	auto &pending_exchange_count = GetPendingExchangeCount(exchange);
+
+	pending_exchange_count++;
+
+	// The interceptor is kept alive until the hold is released, since the counter belongs to it
+	return std::shared_ptr<void>(nullptr, [self = shared_from_this(), &pending_exchange_count](void *) {
+		pending_exchange_count--;
+	});
 }
 
 http::svr::InterceptorResult SegmentStreamInterceptor::OnRequestCompleted(const std::shared_ptr<http::svr::HttpExchange> &exchange)
@@ -29,7 +62,26 @@ http::svr::InterceptorResult SegmentStreamInterceptor::OnRequestCompleted(const
 	auto response = exchange->GetResponse();
 
 	response->SetStatusCode(http::StatusCode::OK);
-	_worker_manager.PushConnection(exchange);
+
+	auto &pending_exchange_count = GetPendingExchangeCount(exchange);
+
+	if (_cache_handler != nullptr)
+	{
+		// HTTP/2 can give a response to an exchange(stream) in any order
+		auto is_in_order = (exchange->GetConnection()->GetConnectionType() == http::ConnectionType::Http20) || (pending_exchange_count == 0);
+
+		if (is_in_order && _cache_handler(exchange))
+		{
+			return http::svr::InterceptorResult::Completed;
+		}
+	}
+
+	pending_exchange_count++;
+
+	if (_worker_manager.PushConnection(exchange) == false)
+	{
+		pending_exchange_count--;
+	}
 
 	return http::svr::InterceptorResult::Moved;
 }
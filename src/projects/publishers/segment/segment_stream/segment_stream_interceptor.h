@@ -16,17 +16,36 @@
 
 #include "segment_worker_manager.h"
 
-class SegmentStreamInterceptor : public http::svr::DefaultInterceptor
+// The exchanges being processed by the workers are counted per bucket of the connection IDs
+#define SEGMENT_PENDING_EXCHANGE_BUCKET_COUNT 4096
+
+class SegmentStreamInterceptor : public http::svr::DefaultInterceptor, public std::enable_shared_from_this<SegmentStreamInterceptor>
 {
 public:
 	SegmentStreamInterceptor();
 	~SegmentStreamInterceptor() override;
 
 	bool Start(int thread_count, const SegmentProcessHandler &process_handler);
+	// The handler is called on the thread of the connection before the exchange is handed over to a worker,
+	// and returns true if it has responded (e.g. from the segment cache)
+	void SetCacheHandler(const SegmentProcessHandler &cache_handler);
 
 	http::svr::InterceptorResult OnRequestCompleted(const std::shared_ptr<http::svr::HttpExchange> &exchange) override;
 	bool IsInterceptorForRequest(const std::shared_ptr<const http::svr::HttpExchange> &client) override;
 
+	// Keeps the exchange counted as pending while the returned object is alive, for a response that is
+	// still being sent after the worker has returned (e.g. the chunked transfer of LL-DASH)
+	std::shared_ptr<void> HoldPendingExchange(const std::shared_ptr<http::svr::HttpExchange> &exchange);
+
 protected:
+	std::atomic<uint32_t> &GetPendingExchangeCount(const std::shared_ptr<http::svr::HttpExchange> &exchange);
+
 	SegmentWorkerManager _worker_manager;
+
+	SegmentProcessHandler _process_handler;
+	SegmentProcessHandler _cache_handler;
+
+	// An HTTP/1.x connection is responded from the cache only if none of its previous requests are pending (in the workers or being responded),
+	// since the responses must be sent in the order of the requests (a collision of the buckets only makes it fall back to the workers)
+	std::atomic<uint32_t> _pending_exchange_counts[SEGMENT_PENDING_EXCHANGE_BUCKET_COUNT]{};
 };
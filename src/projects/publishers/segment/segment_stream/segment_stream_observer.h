@@ -31,4 +31,10 @@ public:
 	virtual bool OnSegmentRequest(const std::shared_ptr<http::svr::HttpExchange> &client,
 								  const SegmentStreamRequestInfo &request_info,
 								  std::shared_ptr<const SegmentItem> &segment) = 0;
+
+	// Called when the segment is served from the segment cache (the segment is not looked up from the stream)
+	virtual bool OnCachedSegmentRequest(const std::shared_ptr<http::svr::HttpExchange> &client,
+										const SegmentStreamRequestInfo &request_info,
+										const std::shared_ptr<pub::Stream> &stream,
+										const std::shared_ptr<const SegmentItem> &segment) = 0;
 };
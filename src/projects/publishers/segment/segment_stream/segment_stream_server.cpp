@@ -38,6 +38,18 @@ bool SegmentStreamServer::Start(const cfg::Server &server_config,
 		return false;
 	}
 
+	auto &segment_cache_config = server_config.GetModules().GetSegmentCache();
+	if (segment_cache_config.IsEnabled())
+	{
+		_segment_cache = std::make_shared<SegmentCache>(
+			GetPublisherType(),
+			static_cast<size_t>(std::max(segment_cache_config.GetMaxMemoryMB(), 0)) * 1024 * 1024,
+			static_cast<int64_t>(std::max(segment_cache_config.GetTtlSec(), 0)) * 1000);
+
+		logti("%s serves the segments from the segment cache (max: %d MB, TTL: %d seconds)",
+			  GetPublisherName(), segment_cache_config.GetMaxMemoryMB(), segment_cache_config.GetTtlSec());
+	}
+
 	auto process_handler = std::bind(&SegmentStreamServer::ProcessRequest, this, std::placeholders::_1);
 
 	bool result = true;
@@ -168,6 +180,11 @@ bool SegmentStreamServer::PrepareInterceptors(
 	result = result && ((http_server == nullptr) || http_server->AddInterceptor(segment_stream_interceptor));
 	result = result && ((https_server == nullptr) || https_server->AddInterceptor(segment_stream_interceptor));
 
+	if (_segment_cache != nullptr)
+	{
+		segment_stream_interceptor->SetCacheHandler(std::bind(&SegmentStreamServer::ProcessCachedRequest, this, std::placeholders::_1));
+	}
+
 	result = result && segment_stream_interceptor->Start(thread_count, process_handler);
 
 	return result;
@@ -221,6 +238,95 @@ bool SegmentStreamServer::ProcessRequest(const std::shared_ptr<http::svr::HttpEx
 	return ProcessStreamRequest(client, request_info, file_ext);
 }
 
+bool SegmentStreamServer::ProcessCachedRequest(const std::shared_ptr<http::svr::HttpExchange> &client)
+{
+	auto request = client->GetRequest();
+
+	if (request->GetMethod() != http::Method::Get)
+	{
+		return false;
+	}
+
+	auto url = ov::Url::Parse(request->GetUri());
+	if (url == nullptr)
+	{
+		return false;
+	}
+
+	auto tokens = url->File().Split(".");
+	auto file_ext = (tokens.size() >= 2) ? tokens[1] : "";
+
+	if (IsCacheableSegment(file_ext) == false)
+	{
+		return false;
+	}
+
+	auto host_name = request->GetHost().Split(":")[0];
+	auto vhost_app_name = ocst::Orchestrator::GetInstance()->ResolveApplicationNameFromDomain(host_name, url->App());
+
+	if (vhost_app_name.IsValid() == false)
+	{
+		return false;
+	}
+
+	SegmentCache::Item item;
+	std::shared_ptr<pub::Stream> stream;
+
+	if (_segment_cache->Get(SegmentCache::MakeKey(vhost_app_name, url->Stream(), url->File()), &item, &stream) == false)
+	{
+		return false;
+	}
+
+	SegmentStreamRequestInfo request_info(
+		vhost_app_name,
+		host_name, url->Stream(), url->File());
+
+	auto observer = std::find_if(_observers.begin(), _observers.end(),
+								 [client, request_info, stream, &item](auto &observer) -> bool {
+									 return observer->OnCachedSegmentRequest(client, request_info, stream, item.segment);
+								 });
+
+	if (observer == _observers.end())
+	{
+		return false;
+	}
+
+	auto response = client->GetResponse();
+
+	response->SetHeader("Server", "OvenMediaEngine");
+	_cors_manager.SetupHttpCorsHeader(vhost_app_name, request, response);
+
+	response->SetHeader("Content-Type", item.content_type);
+	response->AppendSharedData(item.segment->data);
+	auto sent_bytes = response->Response();
+
+	MonitorInstance->IncreaseBytesOut(*stream, GetPublisherType(), sent_bytes);
+
+	client->Release();
+
+	return true;
+}
+
+void SegmentStreamServer::CacheSegment(const std::shared_ptr<http::svr::HttpExchange> &client,
+									   const SegmentStreamRequestInfo &request_info,
+									   const std::shared_ptr<const SegmentItem> &segment,
+									   const ov::String &content_type)
+{
+	if (_segment_cache == nullptr)
+	{
+		return;
+	}
+
+	auto stream = GetStream(client);
+	if (stream == nullptr)
+	{
+		return;
+	}
+
+	_segment_cache->Put(SegmentCache::MakeKey(request_info.vhost_app_name, request_info.stream_name, request_info.file_name),
+						{segment, stream, content_type});
+}
+
 void SegmentStreamServer::SetCrossDomains(const info::VHostAppName &vhost_app_name, const std::vector<ov::String> &url_list)
 {
 	_cors_manager.SetCrossDomains(vhost_app_name, url_list);
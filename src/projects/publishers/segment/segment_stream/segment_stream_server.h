@@ -15,6 +15,7 @@
 
 #include <memory>
 
+#include "segment_cache.h"
 #include "segment_stream_interceptor.h"
 #include "segment_stream_observer.h"
 #include "segment_stream_request_info.h"
@@ -58,6 +59,21 @@ protected:
 		int thread_count, const SegmentProcessHandler &process_handler);
 
 	bool ProcessRequest(const std::shared_ptr<http::svr::HttpExchange> &client);
+	// Responds to the request from the segment cache on the thread of the connection,
+	// returns false if the request should be processed by a worker
+	bool ProcessCachedRequest(const std::shared_ptr<http::svr::HttpExchange> &client);
+
+	// Whether the file is a segment that can be cached (playlists are never cached)
+	virtual bool IsCacheableSegment(const ov::String &file_ext) const
+	{
+		return false;
+	}
+
+	// Called after the segment is served by a worker
+	void CacheSegment(const std::shared_ptr<http::svr::HttpExchange> &client,
+					  const SegmentStreamRequestInfo &request_info,
+					  const std::shared_ptr<const SegmentItem> &segment,
+					  const ov::String &content_type);
 
 	// Interfaces
 	virtual bool ProcessStreamRequest(const std::shared_ptr<http::svr::HttpExchange> &client,
@@ -81,4 +97,7 @@ protected:
 	std::vector<std::shared_ptr<SegmentStreamObserver>> _observers;
 
 	http::CorsManager _cors_manager;
+
+	// nullptr if the segment cache is disabled
+	std::shared_ptr<SegmentCache> _segment_cache;
 };
@@ -13,7 +13,7 @@ std::shared_ptr<ThumbnailApplication> ThumbnailApplication::Create(const std::sh
 ThumbnailApplication::ThumbnailApplication(const std::shared_ptr<pub::Publisher> &publisher, const info::Application &application_info)
 	: Application(publisher, application_info)
 {
-	auto thumbnail_config = application_info.GetConfig().GetPublishers().GetThumbnailPublisher();
+	auto thumbnail_config = application_info.GetConfig()->GetPublishers().GetThumbnailPublisher();
 
 	bool is_parsed;
 	const auto &cross_domains = thumbnail_config.GetCrossDomainList(&is_parsed);
@@ -218,7 +218,7 @@ std::shared_ptr<ThumbnailInterceptor> ThumbnailPublisher::CreateInterceptor()
 		}
 
 		auto app_config = app_info->GetConfig();
-		auto thumbnail_config = app_config.GetPublishers().GetThumbnailPublisher();
+		auto thumbnail_config = app_config->GetPublishers().GetThumbnailPublisher();
 		auto response = exchange->GetResponse();
 
 		// Check CORS
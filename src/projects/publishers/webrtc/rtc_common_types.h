@@ -12,6 +12,15 @@
 
 #define MAX_RTP_RECORDS	1500
 
+// Resolution of the timer that wakes up the pacer of the sessions
+#define RTC_PACER_TIMER_TICK_MS	5
+// The pacer sends packets at this multiple of the estimated bandwidth (or the bitrate of the rendition),
+// so a keyframe is spread over a few frame intervals instead of being sent at the line rate
+#define RTC_PACING_FACTOR	2.5
+#define RTC_MIN_PACING_BITRATE	(1000 * 1000)
+// Used until the bandwidth is estimated if the bitrate of the rendition is unknown
+#define RTC_DEFAULT_START_BITRATE	(1000 * 1000)
+
 // https://tools.ietf.org/html/rfc5761#section-4
 // - payload type values in the range 64-95 MUST NOT be used
 // - dynamic RTP payload types SHOULD be chosen in the range 96-127 where possible
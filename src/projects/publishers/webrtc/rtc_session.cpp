@@ -161,6 +161,15 @@ bool RtcSession::Start()
 	_current_rendition = _playlist->GetFirstRendition();
 	RecordAutoSelectedRendition(_current_rendition, true);
 
+	auto start_bitrate = (_current_rendition->GetBitrates() > 0) ? _current_rendition->GetBitrates() : RTC_DEFAULT_START_BITRATE;
+	_bwe = std::make_shared<SendSideBandwidthEstimator>(start_bitrate);
+
+	if (std::static_pointer_cast<RtcStream>(GetStream())->IsPacingEnabled())
+	{
+		_pacer = std::make_shared<RtpPacer>(RTC_MIN_PACING_BITRATE);
+		UpdatePacingBitrate();
+	}
+
 	auto current_video_track = _current_rendition->GetVideoTrack();
 	auto current_audio_track = _current_rendition->GetAudioTrack();
 
@@ -361,6 +370,17 @@ void RtcSession::OnMessageReceived(const std::any &message)
 	//It must not be called during start and stop.
 	std::shared_lock<std::shared_mutex> lock(_start_stop_lock);
 
+	auto message_type = std::any_cast<MessageType>(&message);
+	if (message_type != nullptr)
+	{
+		if ((*message_type == MessageType::ProcessPacer) && (pub::Session::GetState() == SessionState::Started))
+		{
+			ProcessPacer();
+		}
+
+		return;
+	}
+
 	std::shared_ptr<const ov::Data> data = nullptr;
 	try 
 	{
@@ -535,23 +555,110 @@ void RtcSession::SendOutgoingData(const std::any &packet)
 		copy_packet->SetSequenceNumber(_audio_rtp_sequence_number++);
 	}
 
+	if (_pacer != nullptr)
+	{
+		EnqueueToPacer(copy_packet, session_packet->SequenceNumber(), copy_packet->IsVideoPacket() ? RtpPacer::Priority::Video : RtpPacer::Priority::Audio);
+		return;
+	}
+
+	std::lock_guard<std::mutex> pacer_lock(_pacer_lock);
+	SendRtpPacket(copy_packet, session_packet->SequenceNumber(), false);
+}
+
+// This MUST be called while _pacer_lock is locked
+bool RtcSession::SendRtpPacket(const std::shared_ptr<RtpPacket> &rtp_packet, uint16_t origin_sequence_number, bool is_retransmission)
+{
 	// Set transport-wide sequence number
-	SetTransportWideSequenceNumber(copy_packet, _wide_sequence_number);
-	SetAbsSendTime(copy_packet, ov::Clock::NowMSec());
+	SetTransportWideSequenceNumber(rtp_packet, _wide_sequence_number);
+	SetAbsSendTime(rtp_packet, ov::Clock::NowMSec());
 
 	// rtp_rtcp -> srtp -> dtls -> Edge Node(RtcSession)
 
+	bool result = true;
+
 	// Packet loss simulation codes
 	// if (ov::Random::GenerateUInt32(1, 33) != 10)
 	{
-		_rtp_rtcp->SendRtpPacket(copy_packet);
+		result = _rtp_rtcp->SendRtpPacket(rtp_packet);
 	}
 
-	RecordRtpSent(copy_packet, session_packet->SequenceNumber(), _wide_sequence_number);
+	RecordRtpSent(rtp_packet, origin_sequence_number, _wide_sequence_number, is_retransmission);
 
 	_wide_sequence_number ++;
 
-	MonitorInstance->IncreaseBytesOut(*GetStream(), PublisherType::Webrtc, copy_packet->GetData()->GetLength());
+	MonitorInstance->IncreaseBytesOut(*GetStream(), PublisherType::Webrtc, rtp_packet->GetData()->GetLength());
+
+	return result;
+}
+
+void RtcSession::EnqueueToPacer(const std::shared_ptr<RtpPacket> &rtp_packet, uint16_t origin_sequence_number, RtpPacer::Priority priority)
+{
+	{
+		std::lock_guard<std::mutex> pacer_lock(_pacer_lock);
+		_pacer->Enqueue(rtp_packet, origin_sequence_number, priority, ov::Clock::NowMSec());
+	}
+
+	ProcessPacer();
+}
+
+void RtcSession::ProcessPacer()
+{
+	std::lock_guard<std::mutex> pacer_lock(_pacer_lock);
+
+	auto now_ms = ov::Clock::NowMSec();
+	RtpPacer::Item item;
+
+	while (_pacer->Pop(now_ms, &item))
+	{
+		SendRtpPacket(item.packet, item.origin_sequence_number, item.priority == RtpPacer::Priority::Retransmission);
+	}
+
+	auto delay_ms = _pacer->GetNextSendDelayMs(now_ms);
+	if (delay_ms >= 0)
+	{
+		SchedulePacer(delay_ms);
+	}
+}
+
+void RtcSession::SchedulePacer(int64_t delay_ms)
+{
+	if (_is_pacer_scheduled.exchange(true))
+	{
+		// The pacer will be processed soon
+		return;
+	}
+
+	std::weak_ptr<RtcSession> session_weak = pub::Session::GetSharedPtrAs<RtcSession>();
+
+	// The packets are sent in the worker thread of the session (posted as a message),
+	// since the SRTP/DTLS transports are not thread-safe. _pacer_lock only keeps the order of the packets
+	// (transport-wide sequence number) and does not guard the transports.
+	_publisher->GetPacerTimer().Schedule(
+		[session_weak]() -> ov::DelayQueueAction {
+			auto session = session_weak.lock();
+			if (session != nullptr)
+			{
+				session->_is_pacer_scheduled = false;
+				session->GetStream()->SendMessage(session, MessageType::ProcessPacer);
+			}
+
+			return ov::DelayQueueAction::Stop;
+		},
+		std::max<int64_t>(delay_ms, RTC_PACER_TIMER_TICK_MS));
+}
+
+void RtcSession::UpdatePacingBitrate()
+{
+	if (_pacer == nullptr)
+	{
+		return;
+	}
+
+	double bitrate = (_estimated_bitrates > 0) ? _estimated_bitrates : _bwe->GetTargetBitrate();
+	double pacing_bitrate = std::max<double>(bitrate * RTC_PACING_FACTOR, RTC_MIN_PACING_BITRATE);
+
+	std::lock_guard<std::mutex> pacer_lock(_pacer_lock);
+	_pacer->SetPacingBitrate(static_cast<uint32_t>(std::min<double>(pacing_bitrate, UINT32_MAX)));
 }
 
 bool RtcSession::SetTransportWideSequenceNumber(const std::shared_ptr<RtpPacket> &rtp_packet, uint16_t wide_sequence_number)
@@ -585,7 +692,7 @@ bool RtcSession::SetAbsSendTime(const std::shared_ptr<RtpPacket> &rtp_packet, ui
 	return true;
 }
 
-bool RtcSession::RecordRtpSent(const std::shared_ptr<const RtpPacket> &rtp_packet, uint16_t origin_sequence_number, uint16_t wide_sequence_number)
+bool RtcSession::RecordRtpSent(const std::shared_ptr<const RtpPacket> &rtp_packet, uint16_t origin_sequence_number, uint16_t wide_sequence_number, bool is_retransmission)
 {
 	if (rtp_packet == nullptr)
 	{
@@ -610,7 +717,8 @@ bool RtcSession::RecordRtpSent(const std::shared_ptr<const RtpPacket> &rtp_packe
 
 	std::lock_guard<std::shared_mutex> lock(_rtp_record_map_lock);
 
-	if (rtp_packet->IsVideoPacket())
+	// The sequence number of RTX is not in the sequence space of the video
+	if (rtp_packet->IsVideoPacket() && (is_retransmission == false))
 	{
 		_video_rtp_sent_record_map[video_rtp_key] = sent_log;
 	}
@@ -723,6 +831,8 @@ bool RtcSession::ProcessNACK(const std::shared_ptr<RtcpInfo> &rtcp_info)
 		return false;
 	}
 
+	bool is_retransmission_enqueued = false;
+
 	// Retransmission
 	for(size_t i=0; i<nack->GetLostIdCount(); i++)
 	{
@@ -741,10 +851,28 @@ bool RtcSession::ProcessNACK(const std::shared_ptr<RtcpInfo> &rtcp_info)
 			auto copy_rtx_packet = std::make_shared<RtxRtpPacket>(*rtx_packet);
 			copy_rtx_packet->SetSequenceNumber(_rtx_sequence_number++);
 			copy_rtx_packet->SetOriginalSequenceNumber(sent_log->_sequence_number);
-			return _rtp_rtcp->SendRtpPacket(copy_rtx_packet);
+
+			// Retransmissions are sent before the queued video packets
+			if (_pacer != nullptr)
+			{
+				std::lock_guard<std::mutex> pacer_lock(_pacer_lock);
+				_pacer->Enqueue(copy_rtx_packet, sent_log->_origin_sequence_number, RtpPacer::Priority::Retransmission, ov::Clock::NowMSec());
+				is_retransmission_enqueued = true;
+			}
+			else
+			{
+				std::lock_guard<std::mutex> pacer_lock(_pacer_lock);
+				SendRtpPacket(copy_rtx_packet, sent_log->_origin_sequence_number, true);
+			}
 		}
 	}
 
+	if (is_retransmission_enqueued)
+	{
+		// This is called in the thread that receives RTCP, so the pacer is processed in the worker thread of the session
+		stream->SendMessage(pub::Session::GetSharedPtrAs<RtcSession>(), MessageType::ProcessPacer);
+	}
+
 	return true;
 }
 
@@ -758,76 +886,62 @@ bool RtcSession::ProcessTransportCc(const std::shared_ptr<RtcpInfo> &rtcp_info)
 		return false;
 	}
 
-	uint64_t sent_bytes = 0;
-	int64_t sent_duration = 0;
-
-	// For debug
-	// logtd("TransportCC - SenderSsrc(%u) MediaSsrc(%u) PacketStatusCount(%u)", transport_cc->GetSenderSsrc(), transport_cc->GetMediaSsrc(), transport_cc->GetPacketStatusCount());
-
-	// for (size_t i = 0; i < transport_cc->GetPacketStatusCount(); i++)
-	// {
-	// 	auto packet_status = transport_cc->GetPacketFeedbackInfo(i);
-	// 	auto sent_log = TraceRtpSentByWideSeqNo(packet_status->_wide_sequence_number);
-	// 	if (sent_log == nullptr)
-	// 	{
-	// 		logte("TransportCC - No sent log found for seqno(%u)", packet_status->_wide_sequence_number);
-	// 		continue;
-	// 	}
-
-	// 	logtd("%s", sent_log->ToString().CStr());
-	// }
+	std::vector<SendSideBandwidthEstimator::PacketResult> results;
+	results.reserve(transport_cc->GetPacketStatusCount());
 
-	// return true;
+	// The reference time is in multiples of 64ms, and the receive delta is in multiples of 250us from the previous received packet
+	int64_t receive_time_us = static_cast<int64_t>(transport_cc->GetReferenceTime()) * 64000;
 
-	for (size_t i = 1; i < transport_cc->GetPacketStatusCount(); i++)
+	for (size_t i = 0; i < transport_cc->GetPacketStatusCount(); i++)
 	{
 		auto packet_status = transport_cc->GetPacketFeedbackInfo(i);
-		auto sent_log = TraceRtpSentByWideSeqNo(packet_status->_wide_sequence_number);
-		if (sent_log == nullptr)
+		if (packet_status->_received)
 		{
-			logte("TransportCC - No sent log found for seqno(%u)", packet_status->_wide_sequence_number);
-			continue;
+			receive_time_us += static_cast<int64_t>(packet_status->_received_delta) * 250;
 		}
-		auto prev_sent_log = TraceRtpSentByWideSeqNo(packet_status->_wide_sequence_number - 1);
-		if (prev_sent_log == nullptr)
+
+		// Skip the packets already reported by the previous feedback
+		if (_is_feedback_received && (static_cast<int16_t>(packet_status->_wide_sequence_number - _last_feedback_wide_sequence_number) <= 0))
 		{
-			logtd("TransportCC - No prev sent log found for seqno(%u)", packet_status->_wide_sequence_number - 1);
 			continue;
 		}
 
-		// Calc delta of sent_log and prev_sent_log
-		int32_t sent_delta_time = (std::chrono::duration_cast<std::chrono::microseconds>(sent_log->_sent_time - prev_sent_log->_sent_time).count()) / 250; 
-
-		auto duration = packet_status->_received_delta - sent_delta_time;
-		if (duration <= 0)
+		auto sent_log = TraceRtpSentByWideSeqNo(packet_status->_wide_sequence_number);
+		if ((sent_log == nullptr) || (sent_log->_wide_sequence_number != packet_status->_wide_sequence_number))
 		{
-			//duration = 1;
+			logtd("TransportCC - No sent log found for seqno(%u)", packet_status->_wide_sequence_number);
+			continue;
 		}
 
-		sent_bytes += sent_log->_sent_bytes;
-		sent_duration += duration;
+		SendSideBandwidthEstimator::PacketResult result;
+		result.send_time_us = std::chrono::duration_cast<std::chrono::microseconds>(sent_log->_sent_time.time_since_epoch()).count();
+		result.receive_time_us = packet_status->_received ? receive_time_us : -1;
+		result.size = sent_log->_sent_bytes;
 
-		logtd("WideSeqNo(%u) Refer(%u) RecvDelta(%u) SentDelta(%u) SentBytes(%u) Duration(%d)", packet_status->_wide_sequence_number, transport_cc->GetReferenceTime(), packet_status->_received_delta, sent_delta_time, sent_log->_sent_bytes, duration);
+		results.push_back(result);
+
+		_last_feedback_wide_sequence_number = packet_status->_wide_sequence_number;
+		_is_feedback_received = true;
 	}
 
-	if (sent_bytes > 0)
+	if (results.empty())
 	{
-		double sent_seconds = static_cast<double>(sent_duration) / 4000.0;
+		return true;
+	}
 
-		_total_sent_seconds += sent_seconds;
-		_total_sent_bytes += sent_bytes;
-		_estimated_bitrates = static_cast<double>((_total_sent_bytes * 8)) / _total_sent_seconds;
+	_bwe->OnTransportFeedback(results, ov::Clock::NowMSec());
 
-		if (_bitrate_estimate_watch.IsElapsed(1000) == true)
-		{
-			_bitrate_estimate_watch.Update();
-			ChangeRenditionIfNeeded();
+	_previous_estimated_bitrate = _estimated_bitrates;
+	_estimated_bitrates = _bwe->GetTargetBitrate();
 
-			logtd("Estimated Bandwidth(%f) TotalSentBytes(%u) TotalSentSeconds(%f)", static_cast<double>(_total_sent_bytes * 8) / _total_sent_seconds, _total_sent_bytes, _total_sent_seconds);
+	UpdatePacingBitrate();
 
-			_total_sent_seconds = 0;
-			_total_sent_bytes = 0;
-		}
+	if (_bitrate_estimate_watch.IsElapsed(1000) == true)
+	{
+		_bitrate_estimate_watch.Update();
+		ChangeRenditionIfNeeded();
+
+		logtd("TransportCC Estimated Bandwidth - %s", _bwe->ToString().CStr());
 	}
 
 	return true;
@@ -839,8 +953,13 @@ bool RtcSession::ProcessRemb(const std::shared_ptr<RtcpInfo> &rtcp_info)
 
 	logtd("REMB Estimated Bandwidth(%lld)", remb->GetBitrateBps());
 
+	// If transport-cc is also used, REMB is the upper limit of the estimate
+	_bwe->OnRemb(remb->GetBitrateBps());
+
 	_previous_estimated_bitrate = _estimated_bitrates;
-	_estimated_bitrates = remb->GetBitrateBps();
+	_estimated_bitrates = _is_feedback_received ? _bwe->GetTargetBitrate() : remb->GetBitrateBps();
+
+	UpdatePacingBitrate();
 
 	if (_bitrate_estimate_watch.IsElapsed(1000) == true)
 	{
@@ -17,6 +17,8 @@
 #include "modules/ice/ice_port.h"
 #include "modules/rtp_rtcp/rtp_rtcp.h"
 #include "modules/rtp_rtcp/rtp_packetizer_interface.h"
+#include "modules/rtp_rtcp/rtp_pacer.h"
+#include "modules/rtp_rtcp/send_side_bandwidth_estimator.h"
 #include "modules/dtls_srtp/dtls_transport.h"
 
 #include "rtc_playlist.h"
@@ -38,6 +40,12 @@ class RtcStream;
 class RtcSession : public pub::Session, public RtpRtcpInterface, public ov::Node
 {
 public:
+	// Messages posted to the session through pub::Stream::SendMessage()
+	enum class MessageType : uint8_t
+	{
+		ProcessPacer
+	};
+
 	static std::shared_ptr<RtcSession> Create(const std::shared_ptr<WebRtcPublisher> &publisher,
 											  const std::shared_ptr<pub::Application> &application,
 	                                          const std::shared_ptr<pub::Stream> &stream,
@@ -167,7 +175,7 @@ private:
 		}
 	};
 
-	bool RecordRtpSent(const std::shared_ptr<const RtpPacket> &rtp_packet, uint16_t origin_sequence_number, uint16_t wide_sequence_number);
+	bool RecordRtpSent(const std::shared_ptr<const RtpPacket> &rtp_packet, uint16_t origin_sequence_number, uint16_t wide_sequence_number, bool is_retransmission);
 
 	std::shared_mutex _rtp_record_map_lock;
 	// For NACK
@@ -183,9 +191,28 @@ private:
 	bool SetTransportWideSequenceNumber(const std::shared_ptr<RtpPacket> &rtp_packet, uint16_t wide_sequence_number);
 	bool SetAbsSendTime(const std::shared_ptr<RtpPacket> &rtp_packet, uint64_t time_ms);
 
+	// Assigns the transport-wide sequence number and sends the packet now
+	bool SendRtpPacket(const std::shared_ptr<RtpPacket> &rtp_packet, uint16_t origin_sequence_number, bool is_retransmission);
+
+	// Pacing
+	// Sends the packets that are due, so it must be called in the worker thread of the session
+	void EnqueueToPacer(const std::shared_ptr<RtpPacket> &rtp_packet, uint16_t origin_sequence_number, RtpPacer::Priority priority);
+	void ProcessPacer();
+	void SchedulePacer(int64_t delay_ms);
+	void UpdatePacingBitrate();
+
+	std::shared_ptr<RtpPacer> _pacer;
+	// Guards _pacer and the sending order of the packets (transport-wide sequence number)
+	std::mutex _pacer_lock;
+	std::atomic<bool> _is_pacer_scheduled{false};
+
+	// Send-side bandwidth estimation (transport-cc)
+	std::shared_ptr<SendSideBandwidthEstimator> _bwe;
+	// The last transport-wide sequence number passed to the estimator, to skip the duplicated feedback
+	uint16_t _last_feedback_wide_sequence_number = 0;
+	bool _is_feedback_received = false;
+
 	// For Estimated bitrate
-	double _total_sent_seconds = 0;
-	uint64_t _total_sent_bytes = 0;
 	double _estimated_bitrates = 0;
 	ov::StopWatch _bitrate_estimate_watch;
 
@@ -117,11 +117,12 @@ bool RtcStream::Start()
 		return false;
 	}
 
-	auto webrtc_config = GetApplicationInfo().GetConfig().GetPublishers().GetWebrtcPublisher();
+	auto webrtc_config = GetApplicationInfo().GetConfig()->GetPublishers().GetWebrtcPublisher();
 
 	_rtx_enabled = webrtc_config.IsRtxEnabled();
 	_ulpfec_enabled = webrtc_config.IsUlpfecEnalbed();
 	_jitter_buffer_enabled = webrtc_config.IsJitterBufferEnabled();
+	_pacing_enabled = webrtc_config.IsPacingEnabled();
 
 	auto playoutDelay = webrtc_config.GetPlayoutDelay(&_playout_delay_enabled);
 	_playout_delay_min = playoutDelay.GetMin();
@@ -911,6 +912,11 @@ std::shared_ptr<RtpHistory> RtcStream::GetHistory(uint32_t track_id, uint8_t ori
 	return _rtp_history_map[key];
 }
 
+bool RtcStream::IsPacingEnabled() const
+{
+	return _pacing_enabled;
+}
+
 std::shared_ptr<RtxRtpPacket> RtcStream::GetRtxRtpPacket(uint32_t track_id, uint8_t origin_payload_type, uint16_t origin_sequence_number)
 {
 	if(GetState() != State::STARTED)
@@ -40,6 +40,8 @@ public:
 	void SendAudioFrame(const std::shared_ptr<MediaPacket> &media_packet) override;
 	void SendDataFrame(const std::shared_ptr<MediaPacket> &media_packet) override {} // Not supported
 
+	bool IsPacingEnabled() const;
+
 	std::shared_ptr<RtxRtpPacket> GetRtxRtpPacket(uint32_t track_id, uint8_t origin_payload_type, uint16_t origin_sequence_number);
 
 	// RtpRtcpPacketizerInterface Implementation
@@ -111,6 +113,7 @@ private:
 
 	bool _transport_cc_enabled = false;
 	bool _remb_enabled = false;
+	bool _pacing_enabled = true;
 
 	uint32_t _worker_count = 0;
 
@@ -125,4 +128,4 @@ private:
 	// Playlist File Name : RtcPlaylist
 	std::map<ov::String, std::shared_ptr<const RtcMasterPlaylist>> _rtc_master_playlist_map;
 	std::shared_mutex _rtc_master_playlist_map_lock;
-};
\ No newline at end of file
+};
\ No newline at end of file
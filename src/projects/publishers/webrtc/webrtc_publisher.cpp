@@ -109,6 +109,8 @@ bool WebRtcPublisher::Start()
 	if (StartSignallingServer(server_config, webrtc_bind_config) &&
 		StartICEPorts(server_config, webrtc_bind_config))
 	{
+		_pacer_timer.Start();
+
 		return Publisher::Start();
 	}
 
@@ -131,9 +133,16 @@ bool WebRtcPublisher::Stop()
 		_signalling_server->Stop();
 	}
 
+	_pacer_timer.Stop();
+
 	return Publisher::Stop();
 }
 
+ov::TimingWheel &WebRtcPublisher::GetPacerTimer()
+{
+	return _pacer_timer;
+}
+
 bool WebRtcPublisher::DisconnectSessionInternal(const std::shared_ptr<RtcSession> &session)
 {
 	auto stream = std::dynamic_pointer_cast<RtcStream>(session->GetStream());
@@ -346,12 +355,8 @@ std::shared_ptr<const SessionDescription> WebRtcPublisher::OnRequestOffer(const
 		ice_candidates->insert(ice_candidates->end(), candidates.cbegin(), candidates.cend());
 	}
 
-	// Copy SDP
-	auto session_description = std::make_shared<SessionDescription>(*file_sdp);
-
-	session_description->SetOrigin("OvenMediaEngine", ov::Unique::GenerateUint32(), 2, "IN", 4, "127.0.0.1");
-	session_description->SetIceUfrag(_ice_port->GenerateUfrag());
-	session_description->Update();
+	// Build the offer of this session from the per-stream template, only the session id and ufrag differ
+	auto session_description = file_sdp->CreateFromTemplate(ov::Unique::GenerateUint32(), _ice_port->GenerateUfrag(), file_sdp->GetIcePwd());
 
 	// Passed AccessControl
 	ws_session->AddUserData("authorized", true);
@@ -430,7 +435,7 @@ bool WebRtcPublisher::OnAddRemoteDescription(const std::shared_ptr<http::svr::ws
 		stream->AddSession(session);
 		MonitorInstance->OnSessionConnected(*stream, PublisherType::Webrtc);
 
-		auto ice_timeout = application->GetConfig().GetPublishers().GetWebrtcPublisher().GetTimeout();
+		auto ice_timeout = application->GetConfig()->GetPublishers().GetWebrtcPublisher().GetTimeout();
 		_ice_port->AddSession(IcePortObserver::GetSharedPtr(), session->GetId(), offer_sdp, peer_sdp, ice_timeout, session_life_time, session);
 	}
 	else
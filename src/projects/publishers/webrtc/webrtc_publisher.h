@@ -16,6 +16,7 @@
 #include "base/ovlibrary/message_thread.h"
 #include "base/publisher/publisher.h"
 #include "rtc_application.h"
+#include "rtc_common_types.h"
 
 class WebRtcPublisher : public pub::Publisher,
 						public IcePortObserver,
@@ -29,6 +30,9 @@ public:
 
 	bool Stop() override;
 
+	// Drives the pacers of the sessions
+	ov::TimingWheel &GetPacerTimer();
+
 	// IcePortObserver Implementation
 	void OnStateChanged(IcePort &port, uint32_t session_id, IcePortConnectionState state, std::any user_data) override;
 	void OnDataReceived(IcePort &port, uint32_t session_id, std::shared_ptr<const ov::Data> data, std::any user_data) override;
@@ -104,6 +108,8 @@ private:
 	std::shared_ptr<IcePort> _ice_port;
 	std::shared_ptr<RtcSignallingServer> _signalling_server;
 
+	ov::TimingWheel _pacer_timer{"RtcPacer", RTC_PACER_TIMER_TICK_MS};
+
 	// for special purpose log - Deprecated
 	// ov::DelayQueue _timer;
 };
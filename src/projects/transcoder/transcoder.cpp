@@ -88,6 +88,17 @@ bool Transcoder::OnCreateApplication(const info::Application &app_info)
 	return true;
 }
 
+bool Transcoder::OnUpdateOutputProfiles(const info::Application &app_info, std::vector<ov::String> *affected_stream_list)
+{
+	auto application = GetApplicationById(app_info.GetId());
+	if (application == nullptr)
+	{
+		return false;
+	}
+
+	return application->UpdateOutputProfiles(app_info, affected_stream_list);
+}
+
 // Delete Application
 bool Transcoder::OnDeleteApplication(const info::Application &app_info)
 {
@@ -43,6 +43,11 @@ public:
 	bool OnCreateApplication(const info::Application &app_info) override;
 	bool OnDeleteApplication(const info::Application &app_info) override;
 
+	//--------------------------------------------------------------------
+	// Implementation of TranscoderModuleInterface
+	//--------------------------------------------------------------------
+	bool OnUpdateOutputProfiles(const info::Application &app_info, std::vector<ov::String> *affected_stream_list) override;
+
 private:
 	// Application Name으로 RouteApplication을 찾음
 	std::shared_ptr<TranscodeApplication> GetApplicationById(info::application_id_t application_id);
@@ -38,15 +38,20 @@ TranscodeApplication::~TranscodeApplication()
 
 bool TranscodeApplication::Start()
 {
-	if(_application_info.GetConfig().GetOutputProfiles().IsHardwareAcceleration() == true)
+	InitializeHardwareAccelerator();
+
+	return true;
+}
+
+void TranscodeApplication::InitializeHardwareAccelerator()
+{
+	if(_application_info.GetConfig()->GetOutputProfiles().IsHardwareAcceleration() == true)
 	{
 		if (TranscodeGPU::GetInstance()->Initialze() == false)
 		{
 			logtw("There is no supported hardware accelerator");
 		}
 	}
-
-	return true;
 }
 
 bool TranscodeApplication::Stop()
@@ -63,6 +68,47 @@ bool TranscodeApplication::Stop()
 	return true;
 }
 
+bool TranscodeApplication::UpdateOutputProfiles(const info::Application &application_info, std::vector<ov::String> *affected_stream_list)
+{
+	std::unique_lock<std::mutex> lock(_mutex);
+
+	_application_info = application_info;
+
+	InitializeHardwareAccelerator();
+
+	bool succeeded = true;
+
+	for (auto &[stream_id, stream] : _streams)
+	{
+		auto input_stream = stream->GetInputStream();
+		auto is_prepared = stream->IsPrepared();
+
+		// The output streams of the previous profiles are deleted from MediaRouter
+		stream->Stop();
+
+		stream = std::make_shared<TranscoderStream>(_application_info, input_stream, this);
+		stream->Start();
+
+		// If the input stream is not prepared yet, the new stream is prepared by OnStreamPrepared()
+		if (is_prepared && (stream->Prepare(input_stream) == false))
+		{
+			logte("Could not prepare the transcoder stream with the new output profiles. app(%s) stream(%s)",
+				  _application_info.GetName().CStr(), input_stream->GetName().CStr());
+			succeeded = false;
+		}
+
+		if (affected_stream_list != nullptr)
+		{
+			affected_stream_list->push_back(input_stream->GetName());
+		}
+	}
+
+	logti("Transcoder streams have been recreated with the new output profiles. app(%s) streams(%zu)",
+		  _application_info.GetName().CStr(), _streams.size());
+
+	return succeeded;
+}
+
 bool TranscodeApplication::OnStreamCreated(const std::shared_ptr<info::Stream> &stream_info)
 {
 	std::unique_lock<std::mutex> lock(_mutex);
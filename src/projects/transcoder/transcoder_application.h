@@ -34,6 +34,10 @@ public:
 	bool Start();
 	bool Stop();
 
+	// Recreates the transcoder streams with the new output profiles of application_info.
+	// The input streams keep running, and only their output streams are deleted and created again.
+	bool UpdateOutputProfiles(const info::Application &application_info, std::vector<ov::String> *affected_stream_list);
+
 	MediaRouteApplicationObserver::ObserverType GetObserverType() override
 	{
 		return MediaRouteApplicationObserver::ObserverType::Transcoder;
@@ -55,7 +59,10 @@ public:
 	bool OnSendFrame(const std::shared_ptr<info::Stream> &stream, const std::shared_ptr<MediaPacket> &packet) override;
 
 private:
-	const info::Application _application_info;
+	void InitializeHardwareAccelerator();
+
+	// Replaced by UpdateOutputProfiles()
+	info::Application _application_info;
 
 private:
 	std::map<int32_t, std::shared_ptr<TranscoderStream>> _streams;
@@ -56,6 +56,16 @@ info::stream_id_t TranscoderStream::GetStreamId()
 	return 0;
 }
 
+const std::shared_ptr<info::Stream> &TranscoderStream::GetInputStream() const
+{
+	return _input_stream;
+}
+
+bool TranscoderStream::IsPrepared() const
+{
+	return (_output_streams.empty() == false);
+}
+
 bool TranscoderStream::Start()
 {
 	logti("%s Transcoder stream has been started", _log_prefix.CStr());
@@ -289,7 +299,8 @@ int32_t TranscoderStream::CreateOutputStreams()
 	int32_t created_count = 0;
 
 	// Get [application->Streams] list of application configuration.
-	auto &cfg_output_profile_list = _application_info.GetConfig().GetOutputProfileList();
+	auto app_config = _application_info.GetConfig();
+	auto &cfg_output_profile_list = app_config->GetOutputProfileList();
 
 	// Get the output  to make the output stream
 	for (const auto &cfg_output_profile : cfg_output_profile_list)
@@ -593,13 +604,13 @@ int32_t TranscoderStream::CreateDecoders()
 		auto &track = track_item->second;
 
 		// Get hardware acceleration is enabled
-		auto use_hwaccel = _application_info.GetConfig().GetOutputProfiles().IsHardwareAcceleration();
+		auto use_hwaccel = _application_info.GetConfig()->GetOutputProfiles().IsHardwareAcceleration();
 		track->SetHardwareAccel(use_hwaccel);
 
 		// Deprecated
 		// Set the number of b frames for compatibility with specific encoders.
 		// Default is 16. refer to .../config/.../applications/decodes.h
-		[[maybe_unused]] auto h264_has_bframes = _application_info.GetConfig().GetDecodes().GetH264hasBFrames();
+		[[maybe_unused]] auto h264_has_bframes = _application_info.GetConfig()->GetDecodes().GetH264hasBFrames();
 		// transcode_context->SetH264hasBframes(h264_has_bframes);
 
 		if (CreateDecoder(decoder_id, track) == false)
@@ -668,7 +679,7 @@ int32_t TranscoderStream::CreateEncoders(MediaFrame *buffer)
 			logtd("[%s/%s(%u)] ITrack(%d) > Encoder(%d) > StreamName(%s) > OTrack(%d)", _application_info.GetName().CStr(), _input_stream->GetName().CStr(), _input_stream->GetId(),
 				  track_id, encoder_id, output_stream->GetName().CStr(), output_track->GetId());
 
-			auto use_hwaccel = _application_info.GetConfig().GetOutputProfiles().IsHardwareAcceleration();
+			auto use_hwaccel = _application_info.GetConfig()->GetOutputProfiles().IsHardwareAcceleration();
 			output_track->SetHardwareAccel(use_hwaccel);
 
 			if (CreateEncoder(encoder_id, output_track) == false)
@@ -82,6 +82,9 @@ public:
 	~TranscoderStream();
 
 	info::stream_id_t GetStreamId();
+	const std::shared_ptr<info::Stream> &GetInputStream() const;
+	// Whether the output streams have been created by Prepare()
+	bool IsPrepared() const;
 
 	bool Start();
 	bool Stop();